@@ -94,6 +94,8 @@ if (NOT PHASAR_BUILD_UNITTESTS)
   set(OPTION_DOXYGEN_DISABLED "SKIP_DOXYGEN")
 endif()
 
+option(PHASAR_BUILD_BENCHMARKS "Build the phasar-benchmark executable; requires PHASAR_BUILD_UNITTESTS for the IR files (default is OFF)" OFF)
+
 
 
 option(PHASAR_ENABLE_CLANG_TIDY_DURING_BUILD "Run clang-tidy during build (default is OFF)" OFF) # should be fine
@@ -12,8 +12,11 @@
 
 #include "phasar/AnalysisStrategy/AnalysisSetup.h"
 #include "phasar/AnalysisStrategy/DemandDrivenAnalysis.h"
+#include "phasar/AnalysisStrategy/ForwardingTabulationProblem.h"
+#include "phasar/AnalysisStrategy/FunctionSummaries.h"
 #include "phasar/AnalysisStrategy/IncrementalUpdateAnalysis.h"
 #include "phasar/AnalysisStrategy/ModuleWiseAnalysis.h"
+#include "phasar/AnalysisStrategy/PersistedSummaryStore.h"
 #include "phasar/AnalysisStrategy/Strategies.h"
 #include "phasar/AnalysisStrategy/VariationalAnalysis.h"
 
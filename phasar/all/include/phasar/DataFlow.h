@@ -20,14 +20,17 @@
 #include "phasar/DataFlow/IfdsIde/IDETabulationProblem.h"
 #include "phasar/DataFlow/IfdsIde/IFDSTabulationProblem.h"
 #include "phasar/DataFlow/IfdsIde/InitialSeeds.h"
+#include "phasar/DataFlow/IfdsIde/Solver/BitVectorIFDSSolver.h"
 #include "phasar/DataFlow/IfdsIde/Solver/FlowEdgeFunctionCache.h"
 #include "phasar/DataFlow/IfdsIde/Solver/IDESolver.h"
+#include "phasar/DataFlow/IfdsIde/Solver/IDEWorkList.h"
 #include "phasar/DataFlow/IfdsIde/Solver/IFDSSolver.h"
 #include "phasar/DataFlow/IfdsIde/Solver/JumpFunctions.h"
 #include "phasar/DataFlow/IfdsIde/Solver/PathEdge.h"
 #include "phasar/DataFlow/IfdsIde/SolverResults.h"
 #include "phasar/DataFlow/IfdsIde/SpecialSummaries.h"
 #include "phasar/DataFlow/Mono/Contexts/CallStringCTX.h"
+#include "phasar/DataFlow/Mono/Contexts/CallStringContextTree.h"
 #include "phasar/DataFlow/Mono/InterMonoProblem.h"
 #include "phasar/DataFlow/Mono/IntraMonoProblem.h"
 #include "phasar/DataFlow/Mono/Solver/InterMonoSolver.h"
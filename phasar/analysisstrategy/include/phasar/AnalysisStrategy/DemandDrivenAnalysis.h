@@ -10,9 +10,434 @@
 #ifndef PHASAR_ANALYSISSTRATEGY_DEMANDDRIVENANALYSIS_H
 #define PHASAR_ANALYSISSTRATEGY_DEMANDDRIVENANALYSIS_H
 
+#include "phasar/AnalysisStrategy/ForwardingTabulationProblem.h"
+#include "phasar/DataFlow/IfdsIde/EdgeFunction.h"
+#include "phasar/DataFlow/IfdsIde/FlowFunctions.h"
+#include "phasar/DataFlow/IfdsIde/IDETabulationProblem.h"
+#include "phasar/DataFlow/IfdsIde/InitialSeeds.h"
+#include "phasar/DataFlow/IfdsIde/Solver/IDESolver.h"
+#include "phasar/DataFlow/IfdsIde/Solver/JumpFunctions.h"
+#include "phasar/DataFlow/IfdsIde/Solver/SummaryProvider.h"
+#include "phasar/DataFlow/IfdsIde/SolverResults.h"
+#include "phasar/Utils/ByRef.h"
+#include "phasar/Utils/Logger.h"
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <iterator>
+#include <memory>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 namespace psr {
 
-class DemandDrivenAnalysis {};
+namespace detail {
+
+/// Restricts an IDETabulationProblem to a set of statements, the slice. All
+/// flows into statements outside of the slice are killed, including the
+/// tautological zero fact.
+///
+/// The solver results of the restricted problem are identical to the results
+/// of the original problem at all statements whose predecessors on realizable
+/// paths are part of the slice.
+template <typename AnalysisDomainTy, typename Container>
+class SlicedTabulationProblem
+    : public ForwardingTabulationProblem<AnalysisDomainTy, Container> {
+  using forwarding_t = ForwardingTabulationProblem<AnalysisDomainTy, Container>;
+  using typename forwarding_t::base_t;
+
+public:
+  using typename forwarding_t::container_type;
+  using typename forwarding_t::d_t;
+  using typename forwarding_t::f_t;
+  using typename forwarding_t::FlowFunctionPtrType;
+  using typename forwarding_t::i_t;
+  using typename forwarding_t::l_t;
+  using typename forwarding_t::n_t;
+
+  SlicedTabulationProblem(base_t &Inner, const i_t *ICF,
+                          const std::unordered_set<n_t> &Slice)
+      : forwarding_t(Inner), ICF(ICF), Slice(Slice),
+        AutoAddZero(Inner.getIFDSIDESolverConfig().autoAddZero()) {
+    // The zero fact must not leave the slice, so we add it ourselves
+    this->getIFDSIDESolverConfig().setAutoAddZero(false);
+  }
+
+  FlowFunctionPtrType getNormalFlowFunction(n_t Curr, n_t Succ) override {
+    if (!inSlice(Succ)) {
+      return killAll();
+    }
+    return zeroed(forwarding_t::getNormalFlowFunction(Curr, Succ));
+  }
+
+  FlowFunctionPtrType getCallFlowFunction(n_t CallInst,
+                                          f_t CalleeFun) override {
+    if (llvm::none_of(ICF->getStartPointsOf(CalleeFun),
+                      [this](n_t SP) { return inSlice(SP); })) {
+      return killAll();
+    }
+    return zeroed(forwarding_t::getCallFlowFunction(CallInst, CalleeFun));
+  }
+
+  FlowFunctionPtrType getRetFlowFunction(n_t CallSite, f_t CalleeFun,
+                                         n_t ExitInst, n_t RetSite) override {
+    if (!inSlice(RetSite)) {
+      return killAll();
+    }
+    return zeroed(forwarding_t::getRetFlowFunction(CallSite, CalleeFun,
+                                                   ExitInst, RetSite));
+  }
+
+  FlowFunctionPtrType
+  getCallToRetFlowFunction(n_t CallSite, n_t RetSite,
+                           llvm::ArrayRef<f_t> Callees) override {
+    if (!inSlice(RetSite)) {
+      return killAll();
+    }
+    return zeroed(
+        forwarding_t::getCallToRetFlowFunction(CallSite, RetSite, Callees));
+  }
+
+  [[nodiscard]] InitialSeeds<n_t, d_t, l_t> initialSeeds() override {
+    InitialSeeds<n_t, d_t, l_t> Seeds;
+    for (const auto &[Node, Facts] : this->Inner.initialSeeds().getSeeds()) {
+      if (!inSlice(Node)) {
+        continue;
+      }
+      for (const auto &[Fact, Value] : Facts) {
+        Seeds.addSeed(Node, Fact, Value);
+      }
+    }
+    return Seeds;
+  }
+
+private:
+  [[nodiscard]] bool inSlice(ByConstRef<n_t> Stmt) const {
+    return Slice.count(Stmt);
+  }
+
+  [[nodiscard]] FlowFunctionPtrType zeroed(FlowFunctionPtrType FF) const {
+    if (!AutoAddZero) {
+      return FF;
+    }
+    return std::make_shared<ZeroedFlowFunction<d_t, Container>>(
+        std::move(FF), this->getZeroValue());
+  }
+
+  [[nodiscard]] static FlowFunctionPtrType killAll() {
+    struct KillAllFF final : public FlowFunction<d_t, Container> {
+      container_type computeTargets(d_t /*Source*/) override { return {}; }
+    };
+    static auto TheKillAllFlow = std::make_shared<KillAllFF>();
+    return TheKillAllFlow;
+  }
+
+  const i_t *ICF;
+  const std::unordered_set<n_t> &Slice;
+  bool AutoAddZero;
+};
+
+} // namespace detail
+
+/// Answers data-flow queries of the form "which facts hold at statement n?"
+/// on demand.
+///
+/// For each query, the analysis first collects the backward slice of the
+/// queried statement in the ICFG and then solves the given IFDS/IDE problem
+/// restricted to that slice. The slice only follows realizable paths: From the
+/// queried statement, it ascends into all callers of the enclosing functions
+/// and descends into the callees whose calls precede a slice statement, but it
+/// never ascends out of such a callee into its other callers. The results are
+/// exact at all statements that have been reached without descending, so they
+/// are memoized and reused for all later queries at these statements.
+///
+/// Additionally, the jump functions of all functions that are completely
+/// contained in a slice, together with their transitive callees, are kept.
+/// Later solver runs reuse them through the SummaryProvider interface instead
+/// of analyzing these functions again.
+///
+/// The problem and the ICFG must outlive the DemandDrivenAnalysis.
+template <typename AnalysisDomainTy,
+          typename Container = std::set<typename AnalysisDomainTy::d_t>>
+class DemandDrivenAnalysis : private SummaryProvider<AnalysisDomainTy> {
+public:
+  using ProblemTy = IDETabulationProblem<AnalysisDomainTy, Container>;
+  using n_t = typename AnalysisDomainTy::n_t;
+  using d_t = typename AnalysisDomainTy::d_t;
+  using f_t = typename AnalysisDomainTy::f_t;
+  using l_t = typename AnalysisDomainTy::l_t;
+  using i_t = typename AnalysisDomainTy::i_t;
+
+  DemandDrivenAnalysis(ProblemTy &Problem, const i_t *ICF)
+      : Problem(Problem), ICF(ICF) {
+    assert(ICF != nullptr);
+    for (const auto &Fun : ICF->getAllFunctions()) {
+      auto &&Insts = ICF->getAllInstructionsOf(Fun);
+      ProgramSize += std::distance(Insts.begin(), Insts.end());
+    }
+  }
+
+  /// Returns the solver results of a slice that contains Stmt. Only the
+  /// results at statements for which isMemoized() returns true are valid.
+  [[nodiscard]] SolverResults<n_t, d_t, l_t> getResultsFor(n_t Stmt) {
+    return Results[getOrComputeSliceId(std::move(Stmt))]->get();
+  }
+
+  /// Returns all facts that hold at Stmt together with their values.
+  [[nodiscard]] const std::unordered_map<d_t, l_t> &resultsAt(n_t Stmt) {
+    return Results[getOrComputeSliceId(Stmt)]->resultsAt(Stmt);
+  }
+
+  /// Returns the value of Fact at Stmt.
+  [[nodiscard]] l_t resultAt(n_t Stmt, d_t Fact) {
+    return Results[getOrComputeSliceId(Stmt)]->resultAt(Stmt, Fact);
+  }
+
+  /// Checks whether Fact is reachable at Stmt, i.e., whether the exploded
+  /// super-graph node <Stmt, Fact> is reachable from a seed.
+  [[nodiscard]] bool holdsAt(n_t Stmt, d_t Fact) {
+    return resultsAt(std::move(Stmt)).count(Fact);
+  }
+
+  /// Whether the results at Stmt have already been computed.
+  [[nodiscard]] bool isMemoized(ByConstRef<n_t> Stmt) const {
+    return SliceOf.count(Stmt);
+  }
+
+  /// The number of (restricted) solver runs that were needed so far.
+  [[nodiscard]] size_t getNumSolverRuns() const noexcept {
+    return Results.size();
+  }
+
+  /// The number of statements whose results are memoized.
+  [[nodiscard]] size_t getNumMemoizedStatements() const noexcept {
+    return SliceOf.size();
+  }
+
+  /// The number of statements in each slice that has been solved so far, in
+  /// the order of the solver runs.
+  [[nodiscard]] llvm::ArrayRef<size_t> getSliceSizes() const noexcept {
+    return SliceSizes;
+  }
+
+  /// The number of statements in all functions of the ICFG, i.e., the size
+  /// of the slice that a whole-program analysis would solve.
+  [[nodiscard]] size_t getProgramSize() const noexcept { return ProgramSize; }
+
+  /// The number of <start point, fact> pairs, for which a solver run could
+  /// reuse the jump functions of a previous run.
+  [[nodiscard]] size_t getNumReusedSummaries() const noexcept {
+    return NumReusedSummaries;
+  }
+
+private:
+  using JumpFunctionsFrom =
+      std::unordered_map<d_t,
+                         std::vector<std::tuple<n_t, d_t, EdgeFunction<l_t>>>>;
+
+  size_t getOrComputeSliceId(ByConstRef<n_t> Stmt) {
+    if (auto It = SliceOf.find(Stmt); It != SliceOf.end()) {
+      return It->second;
+    }
+
+    llvm::SmallVector<n_t> Exact;
+    auto Slice = computeBackwardSlice(Stmt, Exact);
+    PHASAR_LOG_LEVEL(INFO, "Solve demand-driven query at "
+                               << Problem.NtoString(Stmt) << " on a slice of "
+                               << Slice.size() << " of " << ProgramSize
+                               << " statements");
+
+    detail::SlicedTabulationProblem<AnalysisDomainTy, Container> Sliced(
+        Problem, ICF, Slice);
+    IDESolver<AnalysisDomainTy, Container> Solver(Sliced, ICF);
+    Solver.setSummaryProvider(this);
+    Solver.solve();
+    collectCompleteJumpFunctions(Solver.getJumpFunctions(), Slice);
+
+    auto SliceId = Results.size();
+    SliceSizes.push_back(Slice.size());
+    Results.push_back(std::make_unique<OwningSolverResults<n_t, d_t, l_t>>(
+        Solver.consumeSolverResults()));
+
+    for (const auto &Inst : Exact) {
+      SliceOf.try_emplace(Inst, SliceId);
+    }
+    return SliceId;
+  }
+
+  /// Collects all statements from which Stmt is reachable on a realizable
+  /// path. The statements that are reachable without descending into a
+  /// callee are additionally added to Exact; their predecessors on all
+  /// realizable paths are part of the slice.
+  [[nodiscard]] std::unordered_set<n_t>
+  computeBackwardSlice(ByConstRef<n_t> Stmt,
+                       llvm::SmallVectorImpl<n_t> &Exact) const {
+    std::unordered_set<n_t> Slice;
+    llvm::SmallVector<n_t> WorkList;
+    llvm::SmallVector<n_t> CalleeWorkList;
+
+    auto Add = [&Slice, &Exact, &WorkList](n_t Inst) {
+      if (!Slice.insert(Inst).second) {
+        return false;
+      }
+      Exact.push_back(Inst);
+      WorkList.push_back(std::move(Inst));
+      return true;
+    };
+    auto Descend = [this, &CalleeWorkList](ByConstRef<n_t> CallSite) {
+      // Flows into a return-site can also come from the callees
+      for (const auto &Callee : ICF->getCalleesOfCallAt(CallSite)) {
+        for (const auto &ExitInst : ICF->getExitPointsOf(Callee)) {
+          CalleeWorkList.push_back(ExitInst);
+        }
+      }
+    };
+
+    // Phase 1: Ascend into the callers
+    Add(Stmt);
+    while (!WorkList.empty()) {
+      auto Curr = WorkList.pop_back_val();
+
+      if (ICF->isStartPoint(Curr)) {
+        // Flows into a function come from its call-sites
+        for (const auto &CallSite :
+             ICF->getCallersOf(ICF->getFunctionOf(Curr))) {
+          Add(CallSite);
+        }
+      }
+
+      for (const auto &Pred : ICF->getPredsOf(Curr)) {
+        if (Add(Pred) && ICF->isCallSite(Pred)) {
+          Descend(Pred);
+        }
+      }
+    }
+
+    // Phase 2: Descend into the callees. Their start points are only entered
+    // from call-sites that precede the respective return-site, which are
+    // already part of the slice.
+    while (!CalleeWorkList.empty()) {
+      auto Curr = CalleeWorkList.pop_back_val();
+      if (!Slice.insert(Curr).second) {
+        continue;
+      }
+      for (const auto &Pred : ICF->getPredsOf(Curr)) {
+        if (Slice.count(Pred)) {
+          continue;
+        }
+        CalleeWorkList.push_back(Pred);
+        if (ICF->isCallSite(Pred)) {
+          Descend(Pred);
+        }
+      }
+    }
+
+    return Slice;
+  }
+
+  /// Keeps the jump functions of all functions whose statements, including
+  /// the ones of their transitive callees, are all part of the Slice. Within
+  /// these functions, the restricted problem did not kill any flows, so their
+  /// jump functions equal the ones of the unrestricted problem.
+  void collectCompleteJumpFunctions(
+      const JumpFunctions<AnalysisDomainTy, Container> &JumpFn,
+      const std::unordered_set<n_t> &Slice) {
+    std::unordered_set<f_t> Complete;
+    for (const auto &Inst : Slice) {
+      auto Fun = ICF->getFunctionOf(Inst);
+      if (Complete.count(Fun)) {
+        continue;
+      }
+      if (llvm::all_of(ICF->getAllInstructionsOf(Fun),
+                       [&Slice](n_t Curr) { return Slice.count(Curr); })) {
+        Complete.insert(Fun);
+      }
+    }
+
+    auto IsComplete = [this, &Complete](ByConstRef<f_t> Fun) {
+      // Declarations do not have jump functions
+      return Complete.count(Fun) || ICF->getStartPointsOf(Fun).empty();
+    };
+    for (bool Changed = true; Changed;) {
+      llvm::SmallVector<f_t> Incomplete;
+      for (const auto &Fun : Complete) {
+        for (const auto &CallSite : ICF->getCallsFromWithin(Fun)) {
+          if (!llvm::all_of(ICF->getCalleesOfCallAt(CallSite), IsComplete)) {
+            Incomplete.push_back(Fun);
+            break;
+          }
+        }
+      }
+      for (const auto &Fun : Incomplete) {
+        Complete.erase(Fun);
+      }
+      Changed = !Incomplete.empty();
+    }
+
+    for (const auto &Fun : Complete) {
+      auto &Known = KnownJumpFunctions[Fun];
+      // Jump functions for source facts that are already known have been
+      // provided to the solver; don't record them twice
+      JumpFunctionsFrom New;
+      for (const auto &Inst : ICF->getAllInstructionsOf(Fun)) {
+        JumpFn.lookupByTarget(
+            Inst, [&Known, &New, &Inst](ByConstRef<d_t> SourceVal,
+                                        ByConstRef<d_t> TargetVal,
+                                        const EdgeFunction<l_t> &EF) {
+              if (!Known.count(SourceVal)) {
+                New[SourceVal].emplace_back(Inst, TargetVal, EF);
+              }
+            });
+      }
+      Known.merge(New);
+    }
+  }
+
+  bool provideJumpFunctions(
+      ByConstRef<n_t> StartPoint, ByConstRef<d_t> SourceVal,
+      typename SummaryProvider<AnalysisDomainTy>::JumpFunctionHandler Handler)
+      override {
+    auto FunIt = KnownJumpFunctions.find(ICF->getFunctionOf(StartPoint));
+    if (FunIt == KnownJumpFunctions.end()) {
+      return false;
+    }
+    // An earlier solver run that has reached <StartPoint, SourceVal> has at
+    // least recorded the self-loop
+    auto It = FunIt->second.find(SourceVal);
+    if (It == FunIt->second.end()) {
+      return false;
+    }
+
+    ++NumReusedSummaries;
+    for (const auto &[Target, TargetVal, EF] : It->second) {
+      Handler(Target, TargetVal, EF);
+    }
+    return true;
+  }
+
+  ProblemTy &Problem;
+  const i_t *ICF;
+
+  std::vector<std::unique_ptr<OwningSolverResults<n_t, d_t, l_t>>> Results;
+  std::unordered_map<n_t, size_t> SliceOf;
+  llvm::SmallVector<size_t, 0> SliceSizes;
+  size_t ProgramSize = 0;
+
+  std::unordered_map<f_t, JumpFunctionsFrom> KnownJumpFunctions;
+  size_t NumReusedSummaries = 0;
+};
+
+template <typename AnalysisDomainTy, typename Container>
+DemandDrivenAnalysis(IDETabulationProblem<AnalysisDomainTy, Container> &,
+                     const typename AnalysisDomainTy::i_t *)
+    -> DemandDrivenAnalysis<AnalysisDomainTy, Container>;
 
 } // namespace psr
 
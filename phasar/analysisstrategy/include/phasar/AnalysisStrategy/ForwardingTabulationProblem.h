@@ -0,0 +1,163 @@
+/******************************************************************************
+ * Copyright (c) 2023 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_ANALYSISSTRATEGY_FORWARDINGTABULATIONPROBLEM_H
+#define PHASAR_ANALYSISSTRATEGY_FORWARDINGTABULATIONPROBLEM_H
+
+#include "phasar/DataFlow/IfdsIde/EdgeFunction.h"
+#include "phasar/DataFlow/IfdsIde/IDETabulationProblem.h"
+#include "phasar/DataFlow/IfdsIde/InitialSeeds.h"
+#include "phasar/DataFlow/IfdsIde/SolverResults.h"
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <utility>
+
+namespace psr::detail {
+
+/// Base class for analysis strategies that alter some aspects of a given
+/// IDETabulationProblem. Forwards all flow- and edge functions, the lattice
+/// operations, the seeds and the printers to the wrapped problem; subclasses
+/// override the parts they want to change.
+///
+/// The solver configuration is copied from the wrapped problem. The wrapped
+/// problem must outlive the ForwardingTabulationProblem.
+template <typename AnalysisDomainTy, typename Container>
+class ForwardingTabulationProblem
+    : public IDETabulationProblem<AnalysisDomainTy, Container> {
+protected:
+  using base_t = IDETabulationProblem<AnalysisDomainTy, Container>;
+
+public:
+  using typename base_t::container_type;
+  using typename base_t::d_t;
+  using typename base_t::f_t;
+  using typename base_t::FlowFunctionPtrType;
+  using typename base_t::i_t;
+  using typename base_t::l_t;
+  using typename base_t::n_t;
+
+  explicit ForwardingTabulationProblem(base_t &Inner)
+      : base_t(Inner.getProjectIRDB(), Inner.getEntryPoints(),
+               Inner.getZeroValue()),
+        Inner(Inner) {
+    this->setIFDSIDESolverConfig(Inner.getIFDSIDESolverConfig());
+  }
+
+  FlowFunctionPtrType getNormalFlowFunction(n_t Curr, n_t Succ) override {
+    return Inner.getNormalFlowFunction(Curr, Succ);
+  }
+
+  FlowFunctionPtrType getCallFlowFunction(n_t CallInst,
+                                          f_t CalleeFun) override {
+    return Inner.getCallFlowFunction(CallInst, CalleeFun);
+  }
+
+  FlowFunctionPtrType getRetFlowFunction(n_t CallSite, f_t CalleeFun,
+                                         n_t ExitInst, n_t RetSite) override {
+    return Inner.getRetFlowFunction(CallSite, CalleeFun, ExitInst, RetSite);
+  }
+
+  FlowFunctionPtrType
+  getCallToRetFlowFunction(n_t CallSite, n_t RetSite,
+                           llvm::ArrayRef<f_t> Callees) override {
+    return Inner.getCallToRetFlowFunction(CallSite, RetSite, Callees);
+  }
+
+  FlowFunctionPtrType getSummaryFlowFunction(n_t Curr,
+                                             f_t CalleeFun) override {
+    return Inner.getSummaryFlowFunction(Curr, CalleeFun);
+  }
+
+  EdgeFunction<l_t> getNormalEdgeFunction(n_t Curr, d_t CurrNode, n_t Succ,
+                                          d_t SuccNode) override {
+    return Inner.getNormalEdgeFunction(Curr, CurrNode, Succ, SuccNode);
+  }
+
+  EdgeFunction<l_t> getCallEdgeFunction(n_t CallInst, d_t SrcNode,
+                                        f_t CalleeFun, d_t DestNode) override {
+    return Inner.getCallEdgeFunction(CallInst, SrcNode, CalleeFun, DestNode);
+  }
+
+  EdgeFunction<l_t> getReturnEdgeFunction(n_t CallSite, f_t CalleeFun,
+                                          n_t ExitInst, d_t ExitNode,
+                                          n_t RetSite, d_t RetNode) override {
+    return Inner.getReturnEdgeFunction(CallSite, CalleeFun, ExitInst, ExitNode,
+                                       RetSite, RetNode);
+  }
+
+  EdgeFunction<l_t>
+  getCallToRetEdgeFunction(n_t CallSite, d_t CallNode, n_t RetSite,
+                           d_t RetSiteNode,
+                           llvm::ArrayRef<f_t> Callees) override {
+    return Inner.getCallToRetEdgeFunction(CallSite, CallNode, RetSite,
+                                          RetSiteNode, Callees);
+  }
+
+  EdgeFunction<l_t> getSummaryEdgeFunction(n_t Curr, d_t CurrNode, n_t Succ,
+                                           d_t SuccNode) override {
+    return Inner.getSummaryEdgeFunction(Curr, CurrNode, Succ, SuccNode);
+  }
+
+  EdgeFunction<l_t> allTopFunction() override {
+    return Inner.allTopFunction();
+  }
+
+  l_t topElement() override { return Inner.topElement(); }
+  l_t bottomElement() override { return Inner.bottomElement(); }
+  l_t join(l_t Lhs, l_t Rhs) override {
+    return Inner.join(std::move(Lhs), std::move(Rhs));
+  }
+
+  [[nodiscard]] bool isZeroValue(d_t Fact) const override {
+    return Inner.isZeroValue(std::move(Fact));
+  }
+
+  [[nodiscard]] bool supportsParallelSolving() const noexcept override {
+    return Inner.supportsParallelSolving();
+  }
+
+  [[nodiscard]] bool supportsFunctionSummaries() const noexcept override {
+    return Inner.supportsFunctionSummaries();
+  }
+
+  [[nodiscard]] InitialSeeds<n_t, d_t, l_t> initialSeeds() override {
+    return Inner.initialSeeds();
+  }
+
+  void emitTextReport(const SolverResults<n_t, d_t, l_t> &Results,
+                      llvm::raw_ostream &OS = llvm::outs()) override {
+    Inner.emitTextReport(Results, OS);
+  }
+  void emitGraphicalReport(const SolverResults<n_t, d_t, l_t> &Results,
+                           llvm::raw_ostream &OS = llvm::outs()) override {
+    Inner.emitGraphicalReport(Results, OS);
+  }
+
+  void printNode(llvm::raw_ostream &OS, n_t Stmt) const override {
+    Inner.printNode(OS, Stmt);
+  }
+  void printDataFlowFact(llvm::raw_ostream &OS, d_t Fact) const override {
+    Inner.printDataFlowFact(OS, Fact);
+  }
+  void printFunction(llvm::raw_ostream &OS, f_t Func) const override {
+    Inner.printFunction(OS, Func);
+  }
+  void printEdgeFact(llvm::raw_ostream &OS, l_t Val) const override {
+    Inner.printEdgeFact(OS, Val);
+  }
+
+protected:
+  base_t &Inner;
+};
+
+} // namespace psr::detail
+
+#endif // PHASAR_ANALYSISSTRATEGY_FORWARDINGTABULATIONPROBLEM_H
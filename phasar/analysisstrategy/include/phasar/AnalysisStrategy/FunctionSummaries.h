@@ -0,0 +1,482 @@
+/******************************************************************************
+ * Copyright (c) 2023 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_ANALYSISSTRATEGY_FUNCTIONSUMMARIES_H
+#define PHASAR_ANALYSISSTRATEGY_FUNCTIONSUMMARIES_H
+
+#include "phasar/AnalysisStrategy/ForwardingTabulationProblem.h"
+#include "phasar/DataFlow/IfdsIde/EdgeFunction.h"
+#include "phasar/DataFlow/IfdsIde/EdgeFunctionUtils.h"
+#include "phasar/DataFlow/IfdsIde/FlowFunctions.h"
+#include "phasar/DataFlow/IfdsIde/IDETabulationProblem.h"
+#include "phasar/DataFlow/IfdsIde/InitialSeeds.h"
+#include "phasar/DataFlow/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/Utils/LLVMFunctionHash.h"
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/IR/Argument.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/InstrTypes.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace psr {
+
+/// A data-flow fact at the interface of a function that does not depend on
+/// the llvm::Module that contains the function: the tautological zero fact,
+/// a formal parameter, an externally visible global variable, or the return
+/// value.
+///
+/// Facts of callers and callees are related by the usual parameter-passing
+/// convention, i.e., the fact Param(I) of the callee corresponds to the I-th
+/// actual argument of the call-site.
+struct SummaryFact {
+  enum class Kind : uint8_t { Zero, Param, Global, Return };
+
+  Kind K = Kind::Zero;
+  uint32_t ParamIndex = 0;
+  std::string GlobalName{};
+
+  [[nodiscard]] static SummaryFact zero() { return {}; }
+  [[nodiscard]] static SummaryFact param(uint32_t Idx) {
+    return {Kind::Param, Idx, {}};
+  }
+  [[nodiscard]] static SummaryFact global(llvm::StringRef Name) {
+    return {Kind::Global, 0, Name.str()};
+  }
+  [[nodiscard]] static SummaryFact ret() { return {Kind::Return, 0, {}}; }
+
+  friend bool operator==(const SummaryFact &Lhs, const SummaryFact &Rhs) {
+    return std::tie(Lhs.K, Lhs.ParamIndex, Lhs.GlobalName) ==
+           std::tie(Rhs.K, Rhs.ParamIndex, Rhs.GlobalName);
+  }
+  friend bool operator!=(const SummaryFact &Lhs, const SummaryFact &Rhs) {
+    return !(Lhs == Rhs);
+  }
+  friend bool operator<(const SummaryFact &Lhs, const SummaryFact &Rhs) {
+    return std::tie(Lhs.K, Lhs.ParamIndex, Lhs.GlobalName) <
+           std::tie(Rhs.K, Rhs.ParamIndex, Rhs.GlobalName);
+  }
+
+  friend llvm::raw_ostream &operator<<(llvm::raw_ostream &OS,
+                                       const SummaryFact &Fact) {
+    switch (Fact.K) {
+    case Kind::Zero:
+      return OS << "<zero>";
+    case Kind::Param:
+      return OS << "<param #" << Fact.ParamIndex << '>';
+    case Kind::Global:
+      return OS << '@' << Fact.GlobalName;
+    case Kind::Return:
+      return OS << "<return>";
+    }
+    return OS;
+  }
+};
+
+/// Function summaries are expressed in terms of the function's parameters,
+/// globals and return value, so they require LLVM values as data-flow facts.
+template <typename AnalysisDomainTy>
+static constexpr bool SupportsFunctionSummaries =
+    std::is_same_v<typename AnalysisDomainTy::d_t, const llvm::Value *>;
+
+/// Returns true if the edge function EF does not refer to values of the
+/// llvm::Module it was computed on. This holds for the generic edge functions
+/// that do not store any IR.
+template <typename L>
+[[nodiscard]] bool isModuleIndependent(const EdgeFunction<L> &EF) {
+  return llvm::isa<EdgeIdentity<L>>(EF) || llvm::isa<AllBottom<L>>(EF) ||
+         llvm::isa<AllTop<L>>(EF) || llvm::isa<ConstantEdgeFunction<L>>(EF);
+}
+
+/// The end summary of a function: the edge functions from the interface facts
+/// at the function's start point to the interface facts at its exits.
+template <typename L> struct FunctionSummary {
+  struct Entry {
+    SummaryFact From;
+    SummaryFact To;
+    EdgeFunction<L> EF;
+  };
+
+  /// The computeFunctionHash() of the summarized function
+  uint64_t FunctionHash = 0;
+  std::vector<Entry> Entries;
+
+  /// Whether all edge functions can be applied outside of the llvm::Module
+  /// that the summary was computed on, see isModuleIndependent().
+  [[nodiscard]] bool isModuleIndependent() const {
+    return llvm::all_of(Entries, [](const Entry &E) {
+      return psr::isModuleIndependent(E.EF);
+    });
+  }
+};
+
+/// A collection of function summaries, identified by the (linkage) names of
+/// the summarized functions.
+template <typename L> class FunctionSummaries {
+public:
+  using iterator =
+      typename llvm::StringMap<FunctionSummary<L>>::const_iterator;
+
+  /// Returns the summary of the function with the given name, or nullptr if
+  /// there is none.
+  [[nodiscard]] const FunctionSummary<L> *
+  getSummary(llvm::StringRef FunName) const {
+    auto It = Summaries.find(FunName);
+    return It != Summaries.end() ? &It->second : nullptr;
+  }
+
+  [[nodiscard]] bool hasSummary(llvm::StringRef FunName) const {
+    return Summaries.count(FunName);
+  }
+
+  /// Adds the summary of the function FunName, replacing an existing one.
+  void insert(llvm::StringRef FunName, FunctionSummary<L> Summary) {
+    Summaries.insert_or_assign(FunName, std::move(Summary));
+  }
+
+  /// Moves all summaries from Other into this collection. Summaries from
+  /// Other replace existing ones with the same name.
+  void merge(FunctionSummaries &&Other) {
+    for (auto &Entry : Other.Summaries) {
+      insert(Entry.getKey(), std::move(Entry.getValue()));
+    }
+    Other.Summaries.clear();
+  }
+
+  [[nodiscard]] size_t size() const noexcept { return Summaries.size(); }
+  [[nodiscard]] bool empty() const noexcept { return Summaries.empty(); }
+
+  [[nodiscard]] iterator begin() const { return Summaries.begin(); }
+  [[nodiscard]] iterator end() const { return Summaries.end(); }
+
+private:
+  llvm::StringMap<FunctionSummary<L>> Summaries;
+};
+
+/// Returns the interface facts of Fun that Fact corresponds to at the start
+/// point of Fun (ExitInst == nullptr), or at the exit ExitInst.
+[[nodiscard]] inline llvm::SmallVector<SummaryFact, 1>
+toSummaryFacts(const llvm::Value *Fact, bool IsZero, const llvm::Function *Fun,
+               const llvm::Instruction *ExitInst = nullptr) {
+  llvm::SmallVector<SummaryFact, 1> Ret;
+  if (IsZero) {
+    Ret.push_back(SummaryFact::zero());
+    return Ret;
+  }
+  if (const auto *Arg = llvm::dyn_cast<llvm::Argument>(Fact)) {
+    if (Arg->getParent() == Fun) {
+      Ret.push_back(SummaryFact::param(Arg->getArgNo()));
+    }
+  } else if (const auto *Glob = llvm::dyn_cast<llvm::GlobalVariable>(Fact)) {
+    if (Glob->hasName() && !Glob->hasLocalLinkage()) {
+      Ret.push_back(SummaryFact::global(Glob->getName()));
+    }
+  }
+  if (const auto *RetInst = llvm::dyn_cast_or_null<llvm::ReturnInst>(ExitInst);
+      RetInst && RetInst->getReturnValue() == Fact) {
+    Ret.push_back(SummaryFact::ret());
+  }
+  return Ret;
+}
+
+/// Returns the interface facts of the callee that the caller's fact Fact
+/// corresponds to at the call-site CS.
+[[nodiscard]] inline llvm::SmallVector<SummaryFact, 1>
+toCalleeSummaryFacts(const llvm::Value *Fact, bool IsZero,
+                     const llvm::CallBase *CS) {
+  llvm::SmallVector<SummaryFact, 1> Ret;
+  if (IsZero) {
+    Ret.push_back(SummaryFact::zero());
+    return Ret;
+  }
+  if (const auto *Glob = llvm::dyn_cast<llvm::GlobalVariable>(Fact);
+      Glob && Glob->hasName() && !Glob->hasLocalLinkage()) {
+    Ret.push_back(SummaryFact::global(Glob->getName()));
+  }
+  for (unsigned I = 0, End = CS->arg_size(); I != End; ++I) {
+    if (CS->getArgOperand(I) == Fact) {
+      Ret.push_back(SummaryFact::param(I));
+    }
+  }
+  return Ret;
+}
+
+/// Returns the fact of the caller that the callee's interface fact Fact
+/// corresponds to at the return-site of CS, or nullptr if there is none.
+[[nodiscard]] inline const llvm::Value *
+fromCalleeSummaryFact(const SummaryFact &Fact, const llvm::CallBase *CS,
+                      const llvm::Value *ZeroValue) {
+  switch (Fact.K) {
+  case SummaryFact::Kind::Zero:
+    return ZeroValue;
+  case SummaryFact::Kind::Param: {
+    if (Fact.ParamIndex >= CS->arg_size()) {
+      return nullptr;
+    }
+    const auto *Actual = CS->getArgOperand(Fact.ParamIndex);
+    // Constants are no data-flow facts
+    if (llvm::isa<llvm::Constant>(Actual) &&
+        !llvm::isa<llvm::GlobalValue>(Actual)) {
+      return nullptr;
+    }
+    return Actual;
+  }
+  case SummaryFact::Kind::Global:
+    return CS->getModule()->getNamedGlobal(Fact.GlobalName);
+  case SummaryFact::Kind::Return:
+    return CS->getType()->isVoidTy() ? nullptr : CS;
+  }
+  return nullptr;
+}
+
+/// Collects the facts of Fun that make up its interface at the start point:
+/// the zero fact, the formal parameters, and the externally visible global
+/// variables that Fun or one of its transitive callees in ICF accesses.
+[[nodiscard]] inline std::vector<const llvm::Value *>
+collectInterfaceFacts(const llvm::Function *Fun, const LLVMBasedICFG &ICF,
+                      const llvm::Value *ZeroValue) {
+  std::vector<const llvm::Value *> Facts = {ZeroValue};
+  for (const auto &Arg : Fun->args()) {
+    Facts.push_back(&Arg);
+  }
+
+  llvm::DenseSet<const llvm::Function *> Visited;
+  llvm::DenseSet<const llvm::GlobalVariable *> Globals;
+  llvm::SmallVector<const llvm::Function *> WorkList = {Fun};
+  while (!WorkList.empty()) {
+    const auto *Curr = WorkList.pop_back_val();
+    if (Curr->isDeclaration() || !Visited.insert(Curr).second) {
+      continue;
+    }
+    for (const auto &Inst : llvm::instructions(Curr)) {
+      for (const auto &Op : Inst.operands()) {
+        const auto *Glob = llvm::dyn_cast<llvm::GlobalVariable>(
+            Op.get()->stripPointerCasts());
+        if (Glob && Glob->hasName() && !Glob->hasLocalLinkage() &&
+            Globals.insert(Glob).second) {
+          Facts.push_back(Glob);
+        }
+      }
+      if (llvm::isa<llvm::CallBase>(Inst)) {
+        for (const auto *Callee : ICF.getCalleesOfCallAt(&Inst)) {
+          WorkList.push_back(Callee);
+        }
+      }
+    }
+  }
+  return Facts;
+}
+
+/// Extracts the end summary of Fun from the jump functions that Solver has
+/// computed for the start point facts EntryFacts (see
+/// collectInterfaceFacts()). Jump functions from or to facts that are not
+/// part of the interface are ignored; multiple jump functions between the
+/// same interface facts, e.g. to different exits, are joined.
+template <typename AnalysisDomainTy, typename Container>
+[[nodiscard]] FunctionSummary<typename AnalysisDomainTy::l_t>
+computeFunctionSummary(const IDESolver<AnalysisDomainTy, Container> &Solver,
+                       const IDETabulationProblem<AnalysisDomainTy, Container>
+                           &Problem,
+                       const LLVMBasedICFG &ICF, const llvm::Function *Fun,
+                       llvm::ArrayRef<const llvm::Value *> EntryFacts) {
+  using l_t = typename AnalysisDomainTy::l_t;
+  static_assert(SupportsFunctionSummaries<AnalysisDomainTy>,
+                "Function summaries require data-flow facts that are LLVM "
+                "values");
+
+  std::map<std::pair<SummaryFact, SummaryFact>, EdgeFunction<l_t>> Edges;
+  const auto &JumpFn = Solver.getJumpFunctions();
+  for (const auto *EntryFact : EntryFacts) {
+    auto Froms = toSummaryFacts(EntryFact, Problem.isZeroValue(EntryFact), Fun);
+    if (Froms.empty()) {
+      continue;
+    }
+    for (const auto *ExitInst : ICF.getExitPointsOf(Fun)) {
+      JumpFn.forwardLookup(
+          EntryFact, ExitInst,
+          [&](const llvm::Value *ExitFact, const EdgeFunction<l_t> &EF) {
+            for (auto &To : toSummaryFacts(
+                     ExitFact, Problem.isZeroValue(ExitFact), Fun, ExitInst)) {
+              for (const auto &From : Froms) {
+                auto [It, Inserted] = Edges.try_emplace({From, To}, EF);
+                if (!Inserted) {
+                  It->second = It->second.joinWith(EF);
+                }
+              }
+            }
+          });
+    }
+  }
+
+  FunctionSummary<l_t> Summary;
+  Summary.FunctionHash = computeFunctionHash(*Fun);
+  Summary.Entries.reserve(Edges.size());
+  for (auto &[FromTo, EF] : Edges) {
+    Summary.Entries.push_back({FromTo.first, FromTo.second, std::move(EF)});
+  }
+  return Summary;
+}
+
+namespace detail {
+
+/// Applies end summaries at direct calls instead of analyzing the callees.
+/// The summary of a callee is obtained from a lookup function that returns
+/// nullptr if there is none. Additionally seeds the interface facts of the
+/// given exported functions, such that their summaries can be extracted from
+/// the jump functions after solving, see computeFunctionSummary().
+///
+/// The interface seeds carry the value topElement(), so they do not add
+/// information to the values of the facts that are reachable from the seeds
+/// of the wrapped problem.
+template <typename AnalysisDomainTy, typename Container>
+class SummaryImportingProblem
+    : public ForwardingTabulationProblem<AnalysisDomainTy, Container> {
+  using forwarding_t = ForwardingTabulationProblem<AnalysisDomainTy, Container>;
+  using typename forwarding_t::base_t;
+
+public:
+  using typename forwarding_t::container_type;
+  using typename forwarding_t::d_t;
+  using typename forwarding_t::f_t;
+  using typename forwarding_t::FlowFunctionPtrType;
+  using typename forwarding_t::l_t;
+  using typename forwarding_t::n_t;
+
+  using InterfaceSeeds = std::vector<std::pair<n_t, std::vector<d_t>>>;
+  using SummaryLookup =
+      std::function<const FunctionSummary<l_t> *(const llvm::Function *)>;
+
+  SummaryImportingProblem(base_t &Inner, SummaryLookup Lookup,
+                          InterfaceSeeds Exported = {})
+      : forwarding_t(Inner), Lookup(std::move(Lookup)),
+        Exported(std::move(Exported)) {}
+
+  FlowFunctionPtrType getSummaryFlowFunction(n_t Curr,
+                                             f_t CalleeFun) override {
+    const auto *Summary = getImportedSummary(Curr, CalleeFun);
+    if (!Summary) {
+      return forwarding_t::getSummaryFlowFunction(Curr, CalleeFun);
+    }
+    {
+      // The solver asks for the summary flow function once per incoming fact
+      std::lock_guard Lock(LookupMtx);
+      AppliedAt.insert(Curr);
+    }
+
+    const auto *CS = llvm::cast<llvm::CallBase>(Curr);
+    return lambdaFlow<d_t>([this, CS, Summary](d_t Source) {
+      container_type Ret;
+      for (const auto &From :
+           toCalleeSummaryFacts(Source, this->isZeroValue(Source), CS)) {
+        for (const auto &Entry : Summary->Entries) {
+          if (Entry.From != From) {
+            continue;
+          }
+          if (const auto *Target = fromCalleeSummaryFact(
+                  Entry.To, CS, this->getZeroValue())) {
+            Ret.insert(Target);
+          }
+        }
+      }
+      return Ret;
+    });
+  }
+
+  EdgeFunction<l_t> getSummaryEdgeFunction(n_t Curr, d_t CurrNode, n_t Succ,
+                                           d_t SuccNode) override {
+    const auto *CS = llvm::dyn_cast<llvm::CallBase>(Curr);
+    const auto *Summary =
+        CS ? getImportedSummary(Curr, CS->getCalledFunction()) : nullptr;
+    if (!Summary) {
+      return forwarding_t::getSummaryEdgeFunction(Curr, CurrNode, Succ,
+                                                  SuccNode);
+    }
+
+    std::optional<EdgeFunction<l_t>> Ret;
+    for (const auto &From :
+         toCalleeSummaryFacts(CurrNode, this->isZeroValue(CurrNode), CS)) {
+      for (const auto &Entry : Summary->Entries) {
+        if (Entry.From != From ||
+            fromCalleeSummaryFact(Entry.To, CS, this->getZeroValue()) !=
+                SuccNode) {
+          continue;
+        }
+        Ret = Ret ? Ret->joinWith(Entry.EF) : Entry.EF;
+      }
+    }
+    return Ret ? std::move(*Ret) : EdgeIdentity<l_t>{};
+  }
+
+  [[nodiscard]] InitialSeeds<n_t, d_t, l_t> initialSeeds() override {
+    auto Seeds = this->Inner.initialSeeds();
+    for (const auto &[StartPoint, Facts] : Exported) {
+      for (const auto &Fact : Facts) {
+        Seeds.addSeed(StartPoint, Fact, this->topElement());
+      }
+    }
+    return Seeds;
+  }
+
+  /// The number of call-sites at which an imported summary has been applied.
+  /// Must not be called while solving.
+  [[nodiscard]] size_t getNumAppliedSummaries() const noexcept {
+    return AppliedAt.size();
+  }
+
+private:
+  [[nodiscard]] const FunctionSummary<l_t> *getImportedSummary(n_t Curr,
+                                                              f_t CalleeFun) {
+    // Only direct calls are unambiguous for getSummaryEdgeFunction()
+    const auto *CS = llvm::dyn_cast<llvm::CallBase>(Curr);
+    if (!CalleeFun || !CS || CS->getCalledFunction() != CalleeFun) {
+      return nullptr;
+    }
+    // The solver may query the summaries from multiple threads
+    std::lock_guard Lock(LookupMtx);
+    auto [It, Inserted] = LookupCache.try_emplace(CalleeFun, nullptr);
+    if (Inserted) {
+      It->second = Lookup(CalleeFun);
+    }
+    return It->second;
+  }
+
+  SummaryLookup Lookup;
+  llvm::DenseMap<const llvm::Function *, const FunctionSummary<l_t> *>
+      LookupCache;
+  std::mutex LookupMtx;
+  llvm::DenseSet<n_t> AppliedAt;
+  InterfaceSeeds Exported;
+};
+
+} // namespace detail
+
+} // namespace psr
+
+#endif // PHASAR_ANALYSISSTRATEGY_FUNCTIONSUMMARIES_H
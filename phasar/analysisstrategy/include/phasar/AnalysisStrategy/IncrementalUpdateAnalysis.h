@@ -10,9 +10,274 @@
 #ifndef PHASAR_ANALYSISSTRATEGY_INCREMENTALUPDATEANALYSIS_H
 #define PHASAR_ANALYSISSTRATEGY_INCREMENTALUPDATEANALYSIS_H
 
+#include "phasar/DataFlow/IfdsIde/EdgeFunction.h"
+#include "phasar/DataFlow/IfdsIde/IDETabulationProblem.h"
+#include "phasar/DataFlow/IfdsIde/Solver/IDESolver.h"
+#include "phasar/DataFlow/IfdsIde/Solver/SummaryProvider.h"
+#include "phasar/DataFlow/IfdsIde/SolverResults.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
+#include "phasar/PhasarLLVM/Utils/LLVMFunctionHash.h"
+#include "phasar/Utils/ByRef.h"
+#include "phasar/Utils/Logger.h"
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instruction.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/Value.h"
+
+#include <algorithm>
+#include <set>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
 namespace psr {
 
-class IncrementalUpdateAnalysis {};
+/// Re-solves an IFDS/IDE problem on a new version of the target program,
+/// reusing the jump functions that a previous IDESolver has computed on the
+/// old version for all functions that are not affected by the changes.
+///
+/// A function is changed if it is new, its body differs from the old version
+/// (see computeFunctionHash()), or one of its call-sites resolves to different
+/// callees. Since the jump functions of a function include the effects of all
+/// its (transitive) callees, the summaries of the changed functions and of all
+/// their transitive callers in the new call-graph are invalidated. All other
+/// functions are not analyzed again; instead, their jump functions are
+/// translated into the new program and handed to the IDESolver through the
+/// SummaryProvider interface. The results equal the ones of a from-scratch
+/// solve.
+///
+/// Reuse requires the flow- and edge functions of a function to only depend on
+/// the function's body. If an analysis uses whole-program information, such as
+/// alias information, call invalidate() for the functions where it changed.
+///
+/// Only data-flow facts of type const llvm::Value * are supported, as these
+/// can be mapped between the program versions. The previous solver and its
+/// LLVMProjectIRDB must stay alive until solve() has returned.
+template <typename AnalysisDomainTy,
+          typename Container = std::set<typename AnalysisDomainTy::d_t>>
+class IncrementalUpdateAnalysis
+    : private SummaryProvider<AnalysisDomainTy> {
+public:
+  using n_t = typename AnalysisDomainTy::n_t;
+  using d_t = typename AnalysisDomainTy::d_t;
+  using f_t = typename AnalysisDomainTy::f_t;
+  using l_t = typename AnalysisDomainTy::l_t;
+
+  using ProblemTy = IDETabulationProblem<AnalysisDomainTy, Container>;
+  using SolverTy = IDESolver<AnalysisDomainTy, Container>;
+
+  static_assert(std::is_same_v<n_t, const llvm::Instruction *>);
+  static_assert(std::is_same_v<f_t, const llvm::Function *>);
+  static_assert(std::is_same_v<d_t, const llvm::Value *>,
+                "The IncrementalUpdateAnalysis can only map data-flow facts "
+                "that are LLVM values between the program versions");
+
+  /// Compares the program of PrevICF, on which PrevSolver has solved an
+  /// instance of the same analysis, with the program of ICF, on which Problem
+  /// is defined.
+  IncrementalUpdateAnalysis(const SolverTy &PrevSolver,
+                            const LLVMBasedICFG &PrevICF, ProblemTy &Problem,
+                            const LLVMBasedICFG &ICF)
+      : PrevJumpFn(PrevSolver.getJumpFunctions()), ICF(ICF),
+        Solver(Problem, &ICF) {
+    mapUnchangedFunctions(*PrevICF.getIRDB()->getModule(),
+                          *ICF.getIRDB()->getModule(), PrevICF);
+    mapGlobals(*PrevICF.getIRDB()->getModule(), *ICF.getIRDB()->getModule());
+    OldToNew.try_emplace(Problem.getZeroValue(), Problem.getZeroValue());
+    NewToOld.try_emplace(Problem.getZeroValue(), Problem.getZeroValue());
+
+    for (const auto *Fun : ChangedFunctions) {
+      invalidate(Fun);
+    }
+
+    PHASAR_LOG_LEVEL_CAT(INFO, "IncrementalUpdateAnalysis",
+                         ChangedFunctions.size()
+                             << " functions changed, invalidate the summaries "
+                                "of "
+                             << InvalidatedFunctions.size() << " functions");
+  }
+
+  /// Invalidates the summaries of Fun and all its transitive callers, such
+  /// that they are recomputed by solve().
+  void invalidate(const llvm::Function *Fun) {
+    llvm::SmallVector<const llvm::Function *> WorkList = {Fun};
+    while (!WorkList.empty()) {
+      const auto *Curr = WorkList.pop_back_val();
+      if (!InvalidatedFunctions.insert(Curr).second) {
+        continue;
+      }
+      for (const auto *CallSite : ICF.getCallersOf(Curr)) {
+        WorkList.push_back(CallSite->getFunction());
+      }
+    }
+  }
+
+  /// Solves the problem on the new program version. The solver stays
+  /// available through getSolver(), so it can serve as previous solver for
+  /// the next update.
+  SolverResults<n_t, d_t, l_t> solve() {
+    Solver.setSummaryProvider(this);
+    auto Results = Solver.solve();
+    Solver.setSummaryProvider(nullptr);
+    return Results;
+  }
+
+  [[nodiscard]] SolverTy &getSolver() noexcept { return Solver; }
+  [[nodiscard]] const SolverTy &getSolver() const noexcept { return Solver; }
+
+  /// The functions of the new program version that are new or differ from
+  /// the previous version.
+  [[nodiscard]] const llvm::DenseSet<const llvm::Function *> &
+  getChangedFunctions() const noexcept {
+    return ChangedFunctions;
+  }
+
+  /// The functions of the new program version that are analyzed again.
+  [[nodiscard]] const llvm::DenseSet<const llvm::Function *> &
+  getInvalidatedFunctions() const noexcept {
+    return InvalidatedFunctions;
+  }
+
+  /// The number of <start point, fact> pairs, for which the solver could
+  /// reuse the previously computed jump functions.
+  [[nodiscard]] size_t getNumReusedSummaries() const noexcept {
+    return NumReusedSummaries;
+  }
+
+private:
+  void mapUnchangedFunctions(const llvm::Module &OldMod,
+                             const llvm::Module &NewMod,
+                             const LLVMBasedICFG &PrevICF) {
+    for (const auto &NewFun : NewMod) {
+      if (NewFun.isDeclaration()) {
+        continue;
+      }
+      const auto *OldFun = OldMod.getFunction(NewFun.getName());
+      if (!OldFun || OldFun->isDeclaration() ||
+          computeFunctionHash(*OldFun) != computeFunctionHash(NewFun)) {
+        ChangedFunctions.insert(&NewFun);
+        continue;
+      }
+
+      OldToNew.try_emplace(OldFun, &NewFun);
+      NewToOld.try_emplace(&NewFun, OldFun);
+      for (const auto &[OldArg, NewArg] :
+           llvm::zip(OldFun->args(), NewFun.args())) {
+        OldToNew.try_emplace(&OldArg, &NewArg);
+        NewToOld.try_emplace(&NewArg, &OldArg);
+      }
+
+      bool SameCallees = true;
+      for (const auto &[OldInst, NewInst] :
+           llvm::zip(llvm::instructions(OldFun), llvm::instructions(NewFun))) {
+        OldToNew.try_emplace(&OldInst, &NewInst);
+        NewToOld.try_emplace(&NewInst, &OldInst);
+        if (SameCallees && ICF.isCallSite(&NewInst)) {
+          SameCallees = getCalleeNames(PrevICF, &OldInst) ==
+                        getCalleeNames(ICF, &NewInst);
+        }
+      }
+      if (!SameCallees) {
+        ChangedFunctions.insert(&NewFun);
+      }
+    }
+  }
+
+  void mapGlobals(const llvm::Module &OldMod, const llvm::Module &NewMod) {
+    for (const auto &NewGlob : NewMod.global_values()) {
+      if (!NewGlob.hasName() || llvm::isa<llvm::Function>(NewGlob)) {
+        continue;
+      }
+      if (const auto *OldGlob = OldMod.getNamedValue(NewGlob.getName())) {
+        OldToNew.try_emplace(OldGlob, &NewGlob);
+        NewToOld.try_emplace(&NewGlob, OldGlob);
+      }
+    }
+  }
+
+  [[nodiscard]] static std::vector<llvm::StringRef>
+  getCalleeNames(const LLVMBasedICFG &CG, const llvm::Instruction *CallSite) {
+    std::vector<llvm::StringRef> Names;
+    for (const auto *Callee : CG.getCalleesOfCallAt(CallSite)) {
+      Names.push_back(Callee->getName());
+    }
+    std::sort(Names.begin(), Names.end());
+    return Names;
+  }
+
+  bool provideJumpFunctions(
+      ByConstRef<n_t> StartPoint, ByConstRef<d_t> SourceVal,
+      typename SummaryProvider<AnalysisDomainTy>::JumpFunctionHandler Handler)
+      override {
+    const auto *Fun = StartPoint->getFunction();
+    if (InvalidatedFunctions.count(Fun)) {
+      return false;
+    }
+    const auto *OldFun =
+        llvm::cast_or_null<llvm::Function>(NewToOld.lookup(Fun));
+    const auto *OldSourceVal = NewToOld.lookup(SourceVal);
+    if (!OldFun || !OldSourceVal) {
+      return false;
+    }
+
+    // Either all jump functions can be mapped to the new program or none
+    llvm::SmallVector<std::tuple<n_t, d_t, EdgeFunction<l_t>>> JumpFunctions;
+    bool Complete = true;
+    for (const auto &OldInst : llvm::instructions(OldFun)) {
+      PrevJumpFn.forwardLookup(
+          OldSourceVal, &OldInst,
+          [&](const llvm::Value *OldTargetVal, EdgeFunction<l_t> EF) {
+            const auto *TargetVal = OldToNew.lookup(OldTargetVal);
+            if (!TargetVal) {
+              Complete = false;
+              return;
+            }
+            JumpFunctions.emplace_back(
+                llvm::cast<llvm::Instruction>(OldToNew.lookup(&OldInst)),
+                TargetVal, std::move(EF));
+          });
+      if (!Complete) {
+        return false;
+      }
+    }
+    if (JumpFunctions.empty()) {
+      // The previous solver never reached <StartPoint, SourceVal>
+      return false;
+    }
+
+    ++NumReusedSummaries;
+    for (const auto &[Target, TargetVal, EF] : JumpFunctions) {
+      Handler(Target, TargetVal, EF);
+    }
+    return true;
+  }
+
+  const JumpFunctions<AnalysisDomainTy, Container> &PrevJumpFn;
+  const LLVMBasedICFG &ICF;
+
+  llvm::DenseMap<const llvm::Value *, const llvm::Value *> OldToNew;
+  llvm::DenseMap<const llvm::Value *, const llvm::Value *> NewToOld;
+  llvm::DenseSet<const llvm::Function *> ChangedFunctions;
+  llvm::DenseSet<const llvm::Function *> InvalidatedFunctions;
+  size_t NumReusedSummaries = 0;
+
+  SolverTy Solver;
+};
+
+template <typename AnalysisDomainTy, typename Container>
+IncrementalUpdateAnalysis(const IDESolver<AnalysisDomainTy, Container> &,
+                          const LLVMBasedICFG &,
+                          IDETabulationProblem<AnalysisDomainTy, Container> &,
+                          const LLVMBasedICFG &)
+    -> IncrementalUpdateAnalysis<AnalysisDomainTy, Container>;
 
 } // namespace psr
 
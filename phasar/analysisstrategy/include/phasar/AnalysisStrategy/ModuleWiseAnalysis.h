@@ -10,9 +10,363 @@
 #ifndef PHASAR_ANALYSISSTRATEGY_MODULEWISEANALYSIS_H
 #define PHASAR_ANALYSISSTRATEGY_MODULEWISEANALYSIS_H
 
+#include "phasar/AnalysisStrategy/FunctionSummaries.h"
+#include "phasar/DataFlow/IfdsIde/IDETabulationProblem.h"
+#include "phasar/DataFlow/IfdsIde/Solver/IDESolver.h"
+#include "phasar/DataFlow/IfdsIde/SolverResults.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
+#include "phasar/PhasarLLVM/HelperAnalyses.h"
+#include "phasar/PhasarLLVM/HelperAnalysisConfig.h"
+#include "phasar/Utils/Logger.h"
+#include "phasar/Utils/WorkStealingScheduler.h"
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Support/SourceMgr.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 namespace psr {
 
-class ModuleWiseAnalysis {};
+/// Analyzes a program that consists of multiple LLVM IR modules, e.g., one per
+/// translation unit, one module at a time instead of linking them into a
+/// single whole-program module.
+///
+/// The modules are processed bottom-up in the dependency order of their
+/// call-graph: a module is analyzed after all modules that define functions
+/// it calls. After solving a module, the end summaries of its externally
+/// visible functions that other modules call are extracted (see
+/// computeFunctionSummary()) and applied at the call-sites to these
+/// functions in the modules that are analyzed later, instead of analyzing
+/// the callees again. Modules that do not depend on each other are analyzed
+/// in parallel; modules in a dependency cycle are analyzed side-by-side
+/// without each other's summaries.
+///
+/// Only one module per worker thread is loaded at a time, so the peak memory
+/// consumption is bounded by the largest modules instead of the whole program.
+/// Summaries whose edge functions refer to the IR of their module (see
+/// FunctionSummary::isModuleIndependent()) keep that module alive until the
+/// ModuleWiseAnalysis is destroyed.
+///
+/// The summaries relate the facts at a function's interface, see SummaryFact,
+/// and are computed for all interface facts at once, independent of the
+/// calling contexts. Hence, the results inside summarized functions are not
+/// specialized to their callers in other modules. Data-flows that are not
+/// expressed through the interface facts, e.g., from constant arguments, are
+/// not covered by the summaries.
+template <typename AnalysisDomainTy,
+          typename Container = std::set<typename AnalysisDomainTy::d_t>>
+class ModuleWiseAnalysis {
+public:
+  using n_t = typename AnalysisDomainTy::n_t;
+  using d_t = typename AnalysisDomainTy::d_t;
+  using f_t = typename AnalysisDomainTy::f_t;
+  using l_t = typename AnalysisDomainTy::l_t;
+
+  using ProblemTy = IDETabulationProblem<AnalysisDomainTy, Container>;
+  using SolverTy = IDESolver<AnalysisDomainTy, Container>;
+
+  static_assert(std::is_same_v<n_t, const llvm::Instruction *>);
+  static_assert(std::is_same_v<f_t, const llvm::Function *>);
+  static_assert(std::is_same_v<d_t, const llvm::Value *>,
+                "The ModuleWiseAnalysis can only transfer data-flow facts "
+                "that are LLVM values between modules");
+
+  /// Prepares the analysis of the program that consists of the modules in
+  /// IRFiles. The EntryPoints refer to functions in any of the modules. Up to
+  /// NumThreads modules are analyzed in parallel.
+  explicit ModuleWiseAnalysis(std::vector<std::string> IRFiles,
+                              std::vector<std::string> EntryPoints = {"main"},
+                              HelperAnalysisConfig Config = {},
+                              unsigned NumThreads = 1)
+      : IRFiles(std::move(IRFiles)), EntryPoints(std::move(EntryPoints)),
+        Config(std::move(Config)), NumThreads(NumThreads ? NumThreads : 1) {
+    scanModules();
+    computeSchedule();
+  }
+
+  /// Analyzes all modules.
+  ///
+  /// For each module, calls Factory(HelperAnalyses &, std::vector<std::string>
+  /// EntryPoints) to create the analysis problem on that module, solves it and
+  /// calls Handler(HelperAnalyses &, Problem &, const SolverResults &) while
+  /// the module is still loaded. If the analysis runs on multiple threads,
+  /// Handler may be invoked concurrently for different modules.
+  template <typename ProblemFactory, typename ResultHandler>
+  void run(ProblemFactory Factory, ResultHandler Handler) {
+    for (const auto &Level : Schedule) {
+      // All modules of a level only read the summaries of the previous levels
+      std::vector<FunctionSummaries<l_t>> Exported(Level.size());
+      WorkStealingScheduler<size_t> Scheduler(
+          std::min<size_t>(NumThreads, Level.size()));
+      for (size_t I = 0, End = Level.size(); I != End; ++I) {
+        Scheduler.push(I);
+      }
+      Scheduler.run([&](size_t I) {
+        Exported[I] = analyzeModule(Level[I], Factory, Handler);
+      });
+      for (auto &Summaries : Exported) {
+        this->Summaries.merge(std::move(Summaries));
+      }
+    }
+  }
+
+  /// The summaries of all functions that are called across modules
+  [[nodiscard]] const FunctionSummaries<l_t> &getSummaries() const noexcept {
+    return Summaries;
+  }
+
+  /// The indices of the modules in IRFiles grouped by the order of their
+  /// analysis; the modules in one group are analyzed in parallel.
+  [[nodiscard]] const std::vector<std::vector<size_t>> &
+  getSchedule() const noexcept {
+    return Schedule;
+  }
+
+  /// The number of call-sites in all modules at which a summary from another
+  /// module has been applied.
+  [[nodiscard]] size_t getNumAppliedSummaries() const noexcept {
+    return NumAppliedSummaries;
+  }
+
+private:
+  struct ModuleInterface {
+    /// The externally visible functions that the module defines
+    llvm::StringSet<> Defined;
+    /// The functions that the module declares and calls
+    llvm::StringSet<> Declared;
+    /// The defined functions that other modules call
+    std::vector<std::string> Exported;
+    /// The modules that define functions in Declared
+    llvm::SmallVector<size_t> Dependencies;
+  };
+
+  /// Owns a loaded module together with the analysis problem on it
+  template <typename ConcreteProblemTy> struct ModuleState {
+    HelperAnalyses HA;
+    ConcreteProblemTy Problem;
+
+    template <typename ProblemFactory>
+    ModuleState(const std::string &IRFile, HelperAnalysisConfig Config,
+                std::vector<std::string> EntryPoints, ProblemFactory &Factory)
+        : HA(IRFile, {"__ALL__"}, std::move(Config)),
+          Problem(std::invoke(Factory, HA, std::move(EntryPoints))) {}
+  };
+
+  void scanModules() {
+    Interfaces.resize(IRFiles.size());
+    llvm::StringMap<size_t> DefinedIn;
+    for (size_t ModId = 0, End = IRFiles.size(); ModId != End; ++ModId) {
+      llvm::LLVMContext Ctx;
+      llvm::SMDiagnostic Diag;
+      auto Mod = llvm::parseIRFile(IRFiles[ModId], Diag, Ctx);
+      if (!Mod) {
+        PHASAR_LOG_LEVEL_CAT(ERROR, "ModuleWiseAnalysis",
+                             "Cannot parse " << IRFiles[ModId] << ": "
+                                             << Diag.getMessage());
+        continue;
+      }
+      auto &Interface = Interfaces[ModId];
+      for (const auto &Fun : *Mod) {
+        if (Fun.isIntrinsic() || Fun.hasLocalLinkage()) {
+          continue;
+        }
+        if (Fun.isDeclaration()) {
+          if (!Fun.use_empty()) {
+            Interface.Declared.insert(Fun.getName());
+          }
+        } else {
+          Interface.Defined.insert(Fun.getName());
+          DefinedIn.try_emplace(Fun.getName(), ModId);
+        }
+      }
+    }
+
+    llvm::StringSet<> ExportedNames;
+    for (size_t ModId = 0, End = IRFiles.size(); ModId != End; ++ModId) {
+      auto &Interface = Interfaces[ModId];
+      for (const auto &Entry : Interface.Declared) {
+        auto It = DefinedIn.find(Entry.getKey());
+        if (It == DefinedIn.end() || It->second == ModId) {
+          continue;
+        }
+        if (!llvm::is_contained(Interface.Dependencies, It->second)) {
+          Interface.Dependencies.push_back(It->second);
+        }
+        if (ExportedNames.insert(Entry.getKey()).second) {
+          Interfaces[It->second].Exported.push_back(Entry.getKey().str());
+        }
+      }
+    }
+  }
+
+  /// Groups the modules into levels, such that every module only depends on
+  /// modules in lower levels or in its own strongly connected component.
+  void computeSchedule() {
+    // Tarjan's algorithm emits the SCCs in reverse topological order, i.e.,
+    // all dependencies of an SCC are emitted before the SCC itself
+    std::vector<size_t> Index(IRFiles.size(), SIZE_MAX);
+    std::vector<size_t> LowLink(IRFiles.size());
+    std::vector<bool> OnStack(IRFiles.size());
+    std::vector<size_t> Stack;
+    std::vector<size_t> LevelOf(IRFiles.size());
+    size_t NextIndex = 0;
+
+    std::function<void(size_t)> StrongConnect = [&](size_t ModId) {
+      Index[ModId] = LowLink[ModId] = NextIndex++;
+      Stack.push_back(ModId);
+      OnStack[ModId] = true;
+      for (auto Dep : Interfaces[ModId].Dependencies) {
+        if (Index[Dep] == SIZE_MAX) {
+          StrongConnect(Dep);
+          LowLink[ModId] = std::min(LowLink[ModId], LowLink[Dep]);
+        } else if (OnStack[Dep]) {
+          LowLink[ModId] = std::min(LowLink[ModId], Index[Dep]);
+        }
+      }
+      if (LowLink[ModId] != Index[ModId]) {
+        return;
+      }
+
+      auto SCCBegin = std::find(Stack.begin(), Stack.end(), ModId);
+      size_t Level = 0;
+      for (auto It = SCCBegin; It != Stack.end(); ++It) {
+        for (auto Dep : Interfaces[*It].Dependencies) {
+          if (!OnStack[Dep]) {
+            Level = std::max(Level, LevelOf[Dep] + 1);
+          }
+        }
+      }
+      if (Schedule.size() <= Level) {
+        Schedule.resize(Level + 1);
+      }
+      for (auto It = SCCBegin; It != Stack.end(); ++It) {
+        OnStack[*It] = false;
+        LevelOf[*It] = Level;
+        Schedule[Level].push_back(*It);
+      }
+      Stack.erase(SCCBegin, Stack.end());
+    };
+
+    for (size_t ModId = 0, End = IRFiles.size(); ModId != End; ++ModId) {
+      if (Index[ModId] == SIZE_MAX) {
+        StrongConnect(ModId);
+      }
+    }
+  }
+
+  [[nodiscard]] std::vector<std::string>
+  getEntryPointsOf(size_t ModId) const {
+    if (llvm::is_contained(EntryPoints, "__ALL__")) {
+      return {"__ALL__"};
+    }
+    std::vector<std::string> Ret;
+    for (const auto &EntryPoint : EntryPoints) {
+      if (Interfaces[ModId].Defined.count(EntryPoint)) {
+        Ret.push_back(EntryPoint);
+      }
+    }
+    return Ret;
+  }
+
+  template <typename ProblemFactory, typename ResultHandler>
+  FunctionSummaries<l_t> analyzeModule(size_t ModId, ProblemFactory &Factory,
+                                       ResultHandler &Handler) {
+    using ConcreteProblemTy = std::decay_t<std::invoke_result_t<
+        ProblemFactory &, HelperAnalyses &, std::vector<std::string>>>;
+    static_assert(std::is_base_of_v<ProblemTy, ConcreteProblemTy>,
+                  "The ProblemFactory must create an IDETabulationProblem of "
+                  "the ModuleWiseAnalysis' AnalysisDomainTy");
+
+    PHASAR_LOG_LEVEL_CAT(INFO, "ModuleWiseAnalysis",
+                         "Analyze module " << IRFiles[ModId]);
+    auto State = std::make_unique<ModuleState<ConcreteProblemTy>>(
+        IRFiles[ModId], Config, getEntryPointsOf(ModId), Factory);
+    auto &IRDB = State->HA.getProjectIRDB();
+    const auto &ICF = State->HA.getICFG();
+    const auto *ZeroValue = State->Problem.getZeroValue();
+
+    std::vector<std::pair<const llvm::Function *,
+                          std::vector<const llvm::Value *>>>
+        ExportedFunctions;
+    typename detail::SummaryImportingProblem<
+        AnalysisDomainTy, Container>::InterfaceSeeds InterfaceSeeds;
+    for (const auto &Name : Interfaces[ModId].Exported) {
+      const auto *Fun = IRDB.getFunctionDefinition(Name);
+      if (!Fun) {
+        continue;
+      }
+      auto Facts = collectInterfaceFacts(Fun, ICF, ZeroValue);
+      for (const auto *StartPoint : ICF.getStartPointsOf(Fun)) {
+        InterfaceSeeds.emplace_back(StartPoint, Facts);
+      }
+      ExportedFunctions.emplace_back(Fun, std::move(Facts));
+    }
+
+    // Summaries are only transferred to calls of declarations
+    detail::SummaryImportingProblem<AnalysisDomainTy, Container> Problem(
+        State->Problem,
+        [this](const llvm::Function *Callee) {
+          return Callee->isDeclaration()
+                     ? Summaries.getSummary(Callee->getName())
+                     : nullptr;
+        },
+        std::move(InterfaceSeeds));
+    SolverTy Solver(Problem, &ICF);
+    auto Results = Solver.solve();
+    std::invoke(Handler, State->HA, State->Problem, Results);
+
+    FunctionSummaries<l_t> Exported;
+    bool ModuleIndependent = true;
+    for (const auto &[Fun, Facts] : ExportedFunctions) {
+      auto Summary = computeFunctionSummary(Solver, Problem, ICF, Fun, Facts);
+      ModuleIndependent &= Summary.isModuleIndependent();
+      Exported.insert(Fun->getName(), std::move(Summary));
+    }
+
+    std::lock_guard Lock(Mtx);
+    NumAppliedSummaries += Problem.getNumAppliedSummaries();
+    if (!ModuleIndependent) {
+      RetainedModules.push_back(std::move(State));
+    }
+    return Exported;
+  }
+
+  std::vector<std::string> IRFiles;
+  std::vector<std::string> EntryPoints;
+  HelperAnalysisConfig Config;
+  unsigned NumThreads;
+
+  std::vector<ModuleInterface> Interfaces;
+  std::vector<std::vector<size_t>> Schedule;
+  FunctionSummaries<l_t> Summaries;
+  size_t NumAppliedSummaries = 0;
+
+  std::mutex Mtx;
+  /// Modules that are referenced by module-dependent summaries
+  std::vector<std::shared_ptr<void>> RetainedModules;
+};
+
+/// The ModuleWiseAnalysis that fits the IFDS/IDE problem type Problem.
+template <typename Problem>
+using ModuleWiseAnalysis_P =
+    ModuleWiseAnalysis<typename Problem::ProblemAnalysisDomain,
+                       typename Problem::container_type>;
 
 } // namespace psr
 
@@ -0,0 +1,640 @@
+/******************************************************************************
+ * Copyright (c) 2023 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_ANALYSISSTRATEGY_PERSISTEDSUMMARYSTORE_H
+#define PHASAR_ANALYSISSTRATEGY_PERSISTEDSUMMARYSTORE_H
+
+#include "phasar/AnalysisStrategy/FunctionSummaries.h"
+#include "phasar/DataFlow/IfdsIde/EdgeFunction.h"
+#include "phasar/DataFlow/IfdsIde/EdgeFunctionUtils.h"
+#include "phasar/DataFlow/IfdsIde/IDETabulationProblem.h"
+#include "phasar/DataFlow/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/Utils/LLVMFunctionHash.h"
+#include "phasar/Utils/IO.h"
+#include "phasar/Utils/JoinLattice.h"
+#include "phasar/Utils/Logger.h"
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/IR/Function.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace psr {
+
+/// Computes the keys under which the summaries of functions are persisted.
+///
+/// The key of a function combines the computeFunctionHash() of the function
+/// with the hashes of all functions that it transitively calls according to
+/// the ICFG and with the names of the declarations that these functions call,
+/// such that a summary is only reused if neither the function nor one of its
+/// callees has changed.
+class FunctionSummaryKeys {
+public:
+  explicit FunctionSummaryKeys(const LLVMBasedICFG &ICF) noexcept : ICF(ICF) {}
+
+  [[nodiscard]] uint64_t getKey(const llvm::Function *Fun) {
+    if (auto It = Keys.find(Fun); It != Keys.end()) {
+      return It->second;
+    }
+
+    llvm::SmallVector<uint64_t> CalleeHashes;
+    llvm::DenseSet<const llvm::Function *> Visited = {Fun};
+    llvm::SmallVector<const llvm::Function *> WorkList = {Fun};
+    while (!WorkList.empty()) {
+      const auto *Curr = WorkList.pop_back_val();
+      for (const auto *CallSite : ICF.getCallsFromWithin(Curr)) {
+        for (const auto *Callee : ICF.getCalleesOfCallAt(CallSite)) {
+          if (!Visited.insert(Callee).second) {
+            continue;
+          }
+          // The bodies of declarations are unknown, but the analysis may
+          // still treat them specially based on their names
+          if (Callee->isDeclaration()) {
+            CalleeHashes.push_back(llvm::xxHash64(Callee->getName()));
+          } else {
+            CalleeHashes.push_back(getHash(Callee));
+            WorkList.push_back(Callee);
+          }
+        }
+      }
+    }
+    std::sort(CalleeHashes.begin(), CalleeHashes.end());
+    CalleeHashes.insert(CalleeHashes.begin(), getHash(Fun));
+
+    auto Key = llvm::xxHash64(llvm::StringRef(
+        reinterpret_cast<const char *>(CalleeHashes.data()),
+        CalleeHashes.size() * sizeof(uint64_t)));
+    Keys[Fun] = Key;
+    return Key;
+  }
+
+private:
+  [[nodiscard]] uint64_t getHash(const llvm::Function *Fun) {
+    auto [It, Inserted] = Hashes.try_emplace(Fun, 0);
+    if (Inserted) {
+      It->second = computeFunctionHash(*Fun);
+    }
+    return It->second;
+  }
+
+  const LLVMBasedICFG &ICF;
+  llvm::DenseMap<const llvm::Function *, uint64_t> Hashes;
+  llvm::DenseMap<const llvm::Function *, uint64_t> Keys;
+};
+
+/// A compact binary file of function summaries, see FunctionSummary, that
+/// persists the summaries across runs of an analysis.
+///
+/// Summaries are identified by a key (see FunctionSummaryKeys); the name of
+/// the summarized function is only stored to replace outdated summaries of
+/// the same function. The file is memory-mapped on load and the summaries are
+/// only decoded when they are looked up. Only summaries that consist of the
+/// generic edge functions EdgeIdentity, AllTop, AllBottom and
+/// ConstantEdgeFunction with integral or enum values can be persisted. For the
+/// other functions, the store only records that they cannot be summarized, so
+/// that they are not analyzed for a summary again.
+///
+/// Layout (all integers are little-endian):
+///   Header    { char Magic[8]; u32 Version; u32 Reserved; u64 AnalysisId;
+///               u64 NumFunctions; u64 NumEntries; u64 StringTableSize; }
+///   Functions { u64 Key; u32 NameOffset; u32 NameSize; u32 FirstEntry;
+///               u32 NumEntries; }[NumFunctions], by Key
+///   Entries   { u8 FromKind; u8 ToKind; u8 EFKind; u8 Reserved;
+///               u32 From; u32 To; u32 Reserved; u64 Value; }[NumEntries]
+///   Strings   NUL-terminated function and global names
+/// From/To are parameter indices or string-table offsets of global names.
+/// FirstEntry is 0xffffffff for functions without a persistable summary.
+///
+/// A file of another version or analysis is ignored on load and replaced on
+/// the next write().
+template <typename L> class PersistedSummaryStore {
+public:
+  static constexpr uint32_t Version = 2;
+
+  /// AnalysisId identifies the analysis and its configuration; summaries
+  /// that have been stored with a different id are never loaded.
+  explicit PersistedSummaryStore(llvm::StringRef AnalysisId)
+      : AnalysisId(llvm::xxHash64(AnalysisId)) {}
+
+  /// Loads the store at Path. Returns false, if there is no valid store of
+  /// this analysis; in this case the PersistedSummaryStore stays empty.
+  bool load(const llvm::Twine &Path) {
+    Buffer = readFileOrNull(Path);
+    if (!Buffer) {
+      return false;
+    }
+    if (!parseBuffer()) {
+      PHASAR_LOG_LEVEL_CAT(WARNING, "PersistedSummaryStore",
+                           "Ignore incompatible summary store "
+                               << Path.str());
+      Buffer.reset();
+      NumFunctions = 0;
+      return false;
+    }
+    PHASAR_LOG_LEVEL_CAT(INFO, "PersistedSummaryStore",
+                         "Loaded " << NumFunctions << " summaries from "
+                                   << Path.str());
+    return true;
+  }
+
+  /// Returns the summary that has been stored with Key, or nullptr.
+  [[nodiscard]] const FunctionSummary<L> *getSummaryByKey(uint64_t Key) {
+    if (auto It = Added.find(Key); It != Added.end()) {
+      return It->second.Summary ? &*It->second.Summary : nullptr;
+    }
+    auto Idx = find(Key);
+    return Idx ? decode(*Idx) : nullptr;
+  }
+
+  /// Whether the function with the given Key has already been summarized,
+  /// even if its summary could not be persisted.
+  [[nodiscard]] bool containsKey(uint64_t Key) {
+    return Added.count(Key) || find(Key).has_value();
+  }
+
+  /// Adds the summary of the function Name under Key. It replaces all
+  /// summaries with the same key or name on the next write(). Returns false,
+  /// if the summary cannot be persisted; then, only the key is recorded.
+  bool insert(uint64_t Key, llvm::StringRef Name, FunctionSummary<L> Summary) {
+    std::optional<FunctionSummary<L>> Stored;
+    if (isPersistable(Summary)) {
+      Stored = std::move(Summary);
+    }
+    bool Persistable = Stored.has_value();
+    if (auto It = AddedByName.find(Name); It != AddedByName.end()) {
+      Added.erase(It->second);
+    }
+    AddedByName[Name] = Key;
+    Added.insert_or_assign(Key, AddedSummary{Name.str(), std::move(Stored)});
+    return Persistable;
+  }
+
+  /// The number of summarized functions in the store, including the added
+  /// ones and the ones without a persistable summary
+  [[nodiscard]] size_t size() const {
+    size_t Ret = Added.size();
+    for (size_t Idx = 0; Idx != NumFunctions; ++Idx) {
+      Ret += !isReplaced(Idx);
+    }
+    return Ret;
+  }
+
+  /// Writes all loaded and added summaries to Path. The file is replaced
+  /// atomically, so a concurrently mapped previous version stays intact.
+  bool write(const llvm::Twine &Path) {
+    std::vector<std::pair<uint64_t, AddedSummary>> All;
+    for (size_t Idx = 0; Idx != NumFunctions; ++Idx) {
+      if (isReplaced(Idx)) {
+        continue;
+      }
+      std::optional<FunctionSummary<L>> Summary;
+      if (!isUnpersistable(Idx)) {
+        const auto *Decoded = decode(Idx);
+        if (!Decoded) {
+          // Drop corrupted summaries, such that they are computed again
+          continue;
+        }
+        Summary = *Decoded;
+      }
+      All.emplace_back(readKey(Idx),
+                       AddedSummary{readName(Idx).str(), std::move(Summary)});
+    }
+    for (const auto &[Key, Sum] : Added) {
+      All.emplace_back(Key, Sum);
+    }
+    std::sort(All.begin(), All.end(), [](const auto &Lhs, const auto &Rhs) {
+      return Lhs.first < Rhs.first;
+    });
+
+    std::string Strings;
+    llvm::StringMap<uint32_t> StringOffsets;
+    auto InternString = [&](llvm::StringRef Str) {
+      auto [It, Inserted] = StringOffsets.try_emplace(Str, Strings.size());
+      if (Inserted) {
+        Strings.append(Str.begin(), Str.end());
+        Strings.push_back('\0');
+      }
+      return It->second;
+    };
+
+    std::string FunctionTable;
+    std::string EntryTable;
+    uint32_t NumEntries = 0;
+    for (const auto &[Key, Sum] : All) {
+      appendInt<uint64_t>(FunctionTable, Key);
+      appendInt<uint32_t>(FunctionTable, InternString(Sum.Name));
+      appendInt<uint32_t>(FunctionTable, Sum.Name.size());
+      if (!Sum.Summary) {
+        appendInt<uint32_t>(FunctionTable, NoSummary);
+        appendInt<uint32_t>(FunctionTable, 0);
+        continue;
+      }
+      appendInt<uint32_t>(FunctionTable, NumEntries);
+      appendInt<uint32_t>(FunctionTable, Sum.Summary->Entries.size());
+      for (const auto &Entry : Sum.Summary->Entries) {
+        auto EncodeFact = [&](const SummaryFact &Fact) -> uint32_t {
+          return Fact.K == SummaryFact::Kind::Global
+                     ? InternString(Fact.GlobalName)
+                     : Fact.ParamIndex;
+        };
+        auto [EFKind, Value] = *encodeEdgeFunction(Entry.EF);
+        EntryTable.push_back(char(Entry.From.K));
+        EntryTable.push_back(char(Entry.To.K));
+        EntryTable.push_back(char(EFKind));
+        EntryTable.push_back('\0');
+        appendInt<uint32_t>(EntryTable, EncodeFact(Entry.From));
+        appendInt<uint32_t>(EntryTable, EncodeFact(Entry.To));
+        appendInt<uint32_t>(EntryTable, 0);
+        appendInt<uint64_t>(EntryTable, Value);
+        ++NumEntries;
+      }
+    }
+
+    std::string Header(Magic, sizeof(Magic));
+    appendInt<uint32_t>(Header, Version);
+    appendInt<uint32_t>(Header, 0);
+    appendInt<uint64_t>(Header, AnalysisId);
+    appendInt<uint64_t>(Header, All.size());
+    appendInt<uint64_t>(Header, NumEntries);
+    appendInt<uint64_t>(Header, Strings.size());
+
+    llvm::SmallString<256> TmpPath;
+    Path.toVector(TmpPath);
+    TmpPath += ".tmp";
+    {
+      std::error_code EC;
+      llvm::raw_fd_ostream OS(TmpPath, EC);
+      if (EC) {
+        PHASAR_LOG_LEVEL_CAT(ERROR, "PersistedSummaryStore",
+                             "Cannot write summary store " << TmpPath << ": "
+                                                           << EC.message());
+        return false;
+      }
+      OS << Header << FunctionTable << EntryTable << Strings;
+    }
+    if (auto EC = llvm::sys::fs::rename(TmpPath, Path)) {
+      PHASAR_LOG_LEVEL_CAT(ERROR, "PersistedSummaryStore",
+                           "Cannot write summary store "
+                               << Path.str() << ": " << EC.message());
+      return false;
+    }
+    return true;
+  }
+
+  /// Whether all edge functions of Summary can be written to the store
+  [[nodiscard]] static bool isPersistable(const FunctionSummary<L> &Summary) {
+    return llvm::all_of(Summary.Entries, [](const auto &Entry) {
+      return encodeEdgeFunction(Entry.EF).has_value();
+    });
+  }
+
+private:
+  enum class EFKind : uint8_t { Identity, AllTop, AllBottom, Constant };
+
+  struct AddedSummary {
+    std::string Name;
+    /// std::nullopt, if the summary cannot be persisted
+    std::optional<FunctionSummary<L>> Summary;
+  };
+
+  static constexpr char Magic[8] = {'P', 'S', 'R', 'S', 'U', 'M', 'M', '\0'};
+  static constexpr size_t HeaderSize = 48;
+  static constexpr size_t FunctionRecordSize = 24;
+  static constexpr uint32_t NoSummary = UINT32_MAX;
+  static constexpr size_t EntryRecordSize = 24;
+
+  template <typename T>
+  static constexpr bool IsPersistableValue =
+      (std::is_integral_v<T> || std::is_enum_v<T>) &&
+      sizeof(T) <= sizeof(uint64_t);
+
+  template <typename T> [[nodiscard]] static uint64_t encodeValue(T Value) {
+    if constexpr (std::is_enum_v<T>) {
+      return uint64_t(std::underlying_type_t<T>(Value));
+    } else {
+      return uint64_t(Value);
+    }
+  }
+  template <typename T> [[nodiscard]] static T decodeValue(uint64_t Value) {
+    if constexpr (std::is_enum_v<T>) {
+      return T(std::underlying_type_t<T>(Value));
+    } else {
+      return T(Value);
+    }
+  }
+
+  [[nodiscard]] static std::optional<std::pair<EFKind, uint64_t>>
+  encodeEdgeFunction(const EdgeFunction<L> &EF) {
+    if (llvm::isa<EdgeIdentity<L>>(EF)) {
+      return {{EFKind::Identity, 0}};
+    }
+    if ([[maybe_unused]] const auto *Top = llvm::dyn_cast<AllTop<L>>(EF)) {
+      if constexpr (HasJoinLatticeTraits<L>) {
+        return {{EFKind::AllTop, 0}};
+      } else if constexpr (IsPersistableValue<L>) {
+        return {{EFKind::AllTop, encodeValue(Top->TopValue)}};
+      }
+    }
+    if ([[maybe_unused]] const auto *Bot = llvm::dyn_cast<AllBottom<L>>(EF)) {
+      if constexpr (HasJoinLatticeTraits<L>) {
+        return {{EFKind::AllBottom, 0}};
+      } else if constexpr (IsPersistableValue<L>) {
+        return {{EFKind::AllBottom, encodeValue(Bot->BottomValue)}};
+      }
+    }
+    using value_type = typename ConstantEdgeFunction<L>::value_type;
+    if constexpr (HasJoinLatticeTraits<L> && IsPersistableValue<value_type>) {
+      if (const auto *Const = llvm::dyn_cast<ConstantEdgeFunction<L>>(EF)) {
+        return {{EFKind::Constant, encodeValue(Const->Value)}};
+      }
+    }
+    return std::nullopt;
+  }
+
+  [[nodiscard]] static std::optional<EdgeFunction<L>>
+  decodeEdgeFunction(uint8_t Kind, uint64_t Value) {
+    switch (EFKind(Kind)) {
+    case EFKind::Identity:
+      return EdgeIdentity<L>{};
+    case EFKind::AllTop:
+      if constexpr (HasJoinLatticeTraits<L>) {
+        return AllTop<L>{};
+      } else if constexpr (IsPersistableValue<L>) {
+        return AllTop<L>{decodeValue<L>(Value)};
+      }
+      break;
+    case EFKind::AllBottom:
+      if constexpr (HasJoinLatticeTraits<L>) {
+        return AllBottom<L>{};
+      } else if constexpr (IsPersistableValue<L>) {
+        return AllBottom<L>{decodeValue<L>(Value)};
+      }
+      break;
+    case EFKind::Constant: {
+      using value_type = typename ConstantEdgeFunction<L>::value_type;
+      if constexpr (HasJoinLatticeTraits<L> &&
+                    IsPersistableValue<value_type>) {
+        return ConstantEdgeFunction<L>{decodeValue<value_type>(Value)};
+      }
+      break;
+    }
+    }
+    return std::nullopt;
+  }
+
+  template <typename T> static void appendInt(std::string &Out, T Value) {
+    char Buf[sizeof(T)];
+    llvm::support::endian::write<T, llvm::support::little,
+                                 llvm::support::unaligned>(Buf, Value);
+    Out.append(Buf, sizeof(T));
+  }
+  template <typename T>
+  [[nodiscard]] static T readInt(const char *Data, size_t Offset) {
+    return llvm::support::endian::read<T, llvm::support::little,
+                                       llvm::support::unaligned>(Data +
+                                                                 Offset);
+  }
+
+  template <typename LessFn>
+  [[nodiscard]] static size_t lowerBound(size_t Size, LessFn Less) {
+    size_t Lo = 0;
+    size_t Hi = Size;
+    while (Lo < Hi) {
+      auto Mid = Lo + (Hi - Lo) / 2;
+      if (Less(Mid)) {
+        Lo = Mid + 1;
+      } else {
+        Hi = Mid;
+      }
+    }
+    return Lo;
+  }
+
+  bool parseBuffer() {
+    const char *Data = Buffer->getBufferStart();
+    size_t Size = Buffer->getBufferSize();
+    if (Size < HeaderSize || std::memcmp(Data, Magic, sizeof(Magic)) != 0 ||
+        readInt<uint32_t>(Data, 8) != Version ||
+        readInt<uint64_t>(Data, 16) != AnalysisId) {
+      return false;
+    }
+    auto NumFuns = readInt<uint64_t>(Data, 24);
+    auto NumEnts = readInt<uint64_t>(Data, 32);
+    auto NumStringBytes = readInt<uint64_t>(Data, 40);
+    if (NumFuns > UINT32_MAX || NumEnts > UINT32_MAX ||
+        NumStringBytes > UINT32_MAX) {
+      return false;
+    }
+    size_t FunctionsOffset = HeaderSize;
+    size_t EntriesOffset = FunctionsOffset + NumFuns * FunctionRecordSize;
+    size_t StringsOffset = EntriesOffset + NumEnts * EntryRecordSize;
+    if (StringsOffset + NumStringBytes != Size) {
+      return false;
+    }
+    Functions = Data + FunctionsOffset;
+    Entries = Data + EntriesOffset;
+    Strings = Data + StringsOffset;
+    NumFunctions = NumFuns;
+    NumEntries = NumEnts;
+    StringTableSize = NumStringBytes;
+    return true;
+  }
+
+  [[nodiscard]] uint64_t readKey(size_t Idx) const {
+    return readInt<uint64_t>(Functions, Idx * FunctionRecordSize);
+  }
+  [[nodiscard]] llvm::StringRef readName(size_t Idx) const {
+    auto Offset = readInt<uint32_t>(Functions, Idx * FunctionRecordSize + 8);
+    auto Length = readInt<uint32_t>(Functions, Idx * FunctionRecordSize + 12);
+    if (size_t(Offset) + Length > StringTableSize) {
+      return {};
+    }
+    return {Strings + Offset, Length};
+  }
+  [[nodiscard]] llvm::StringRef readString(uint32_t Offset) const {
+    if (Offset >= StringTableSize) {
+      return {};
+    }
+    return {Strings + Offset, strnlen(Strings + Offset,
+                                      StringTableSize - Offset)};
+  }
+
+  [[nodiscard]] uint32_t readFirstEntry(size_t Idx) const {
+    return readInt<uint32_t>(Functions, Idx * FunctionRecordSize + 16);
+  }
+  [[nodiscard]] uint32_t readNumEntries(size_t Idx) const {
+    return readInt<uint32_t>(Functions, Idx * FunctionRecordSize + 20);
+  }
+
+  /// Loaded summaries are replaced by added summaries of the same function
+  [[nodiscard]] bool isReplaced(size_t Idx) const {
+    return Added.count(readKey(Idx)) || AddedByName.count(readName(Idx));
+  }
+  [[nodiscard]] bool isUnpersistable(size_t Idx) const {
+    return readFirstEntry(Idx) == NoSummary;
+  }
+
+  /// The index of the loaded function with the given Key that has not been
+  /// replaced
+  [[nodiscard]] std::optional<size_t> find(uint64_t Key) const {
+    auto Idx = lowerBound(NumFunctions, [this, Key](size_t I) {
+      return readKey(I) < Key;
+    });
+    if (Idx == NumFunctions || readKey(Idx) != Key || isReplaced(Idx)) {
+      return std::nullopt;
+    }
+    return Idx;
+  }
+
+  [[nodiscard]] const FunctionSummary<L> *decode(size_t Idx) {
+    if (auto It = Decoded.find(Idx); It != Decoded.end()) {
+      return &It->second;
+    }
+
+    auto FirstEntry = readFirstEntry(Idx);
+    auto NumEnts = readNumEntries(Idx);
+    if (FirstEntry == NoSummary || size_t(FirstEntry) + NumEnts > NumEntries) {
+      return nullptr;
+    }
+
+    FunctionSummary<L> Summary;
+    Summary.Entries.reserve(NumEnts);
+    for (size_t I = FirstEntry, End = FirstEntry + NumEnts; I != End; ++I) {
+      const char *Record = Entries + I * EntryRecordSize;
+      auto DecodeFact = [this](uint8_t Kind, uint32_t Val) {
+        SummaryFact Fact;
+        Fact.K = SummaryFact::Kind(Kind);
+        if (Fact.K == SummaryFact::Kind::Global) {
+          Fact.GlobalName = readString(Val).str();
+        } else {
+          Fact.ParamIndex = Val;
+        }
+        return Fact;
+      };
+      auto EF = decodeEdgeFunction(uint8_t(Record[2]),
+                                   readInt<uint64_t>(Record, 16));
+      if (uint8_t(Record[0]) > uint8_t(SummaryFact::Kind::Return) ||
+          uint8_t(Record[1]) > uint8_t(SummaryFact::Kind::Return) || !EF) {
+        return nullptr;
+      }
+      Summary.Entries.push_back(
+          {DecodeFact(Record[0], readInt<uint32_t>(Record, 4)),
+           DecodeFact(Record[1], readInt<uint32_t>(Record, 8)),
+           std::move(*EF)});
+    }
+    return &Decoded.try_emplace(Idx, std::move(Summary)).first->second;
+  }
+
+  uint64_t AnalysisId;
+
+  std::unique_ptr<llvm::MemoryBuffer> Buffer;
+  const char *Functions = nullptr;
+  const char *Entries = nullptr;
+  const char *Strings = nullptr;
+  size_t NumFunctions = 0;
+  size_t NumEntries = 0;
+  size_t StringTableSize = 0;
+  std::unordered_map<size_t, FunctionSummary<L>> Decoded;
+
+  std::map<uint64_t, AddedSummary> Added;
+  llvm::StringMap<uint64_t> AddedByName;
+};
+
+/// Creates a summary lookup for detail::SummaryImportingProblem that finds the
+/// summaries of defined functions in Store by their key. Declarations are
+/// never summarized, as their bodies, and thus their keys, are unknown.
+template <typename L>
+[[nodiscard]] auto makePersistedSummaryLookup(PersistedSummaryStore<L> &Store,
+                                              FunctionSummaryKeys &Keys) {
+  return [&Store,
+          &Keys](const llvm::Function *Callee) -> const FunctionSummary<L> * {
+    if (Callee->isDeclaration()) {
+      return nullptr;
+    }
+    return Store.getSummaryByKey(Keys.getKey(Callee));
+  };
+}
+
+/// Computes the summaries of all functions in ICF that are not yet contained
+/// in Store and adds them to the Store. Functions without a persistable
+/// summary are recorded as well, so they are not analyzed again on the next
+/// call with the same Store.
+///
+/// For that, Problem is solved once with the interface facts of all these
+/// functions as seeds, applying the summaries that are already in the Store.
+/// As flow functions may have side effects for these seeds, Problem should
+/// be a fresh instance that is only used for summary computation. Returns the
+/// number of summarized functions.
+template <typename AnalysisDomainTy, typename Container>
+size_t computePersistedSummaries(
+    IDETabulationProblem<AnalysisDomainTy, Container> &Problem,
+    const LLVMBasedICFG &ICF,
+    PersistedSummaryStore<typename AnalysisDomainTy::l_t> &Store,
+    FunctionSummaryKeys &Keys) {
+  std::vector<std::pair<const llvm::Function *,
+                        std::vector<const llvm::Value *>>>
+      Summarized;
+  typename detail::SummaryImportingProblem<AnalysisDomainTy,
+                                           Container>::InterfaceSeeds Seeds;
+  for (const auto *Fun : ICF.getAllFunctions()) {
+    if (Fun->isDeclaration() || Store.containsKey(Keys.getKey(Fun))) {
+      continue;
+    }
+    auto Facts = collectInterfaceFacts(Fun, ICF, Problem.getZeroValue());
+    for (const auto *StartPoint : ICF.getStartPointsOf(Fun)) {
+      Seeds.emplace_back(StartPoint, Facts);
+    }
+    Summarized.emplace_back(Fun, std::move(Facts));
+  }
+  if (Summarized.empty()) {
+    return 0;
+  }
+
+  detail::SummaryImportingProblem<AnalysisDomainTy, Container> Importing(
+      Problem, makePersistedSummaryLookup(Store, Keys), std::move(Seeds));
+  // Summaries only need the jump functions
+  Importing.getIFDSIDESolverConfig().setComputeValues(false);
+  IDESolver<AnalysisDomainTy, Container> Solver(Importing, &ICF);
+  Solver.solve();
+
+  size_t NumAdded = 0;
+  for (const auto &[Fun, Facts] : Summarized) {
+    NumAdded += Store.insert(
+        Keys.getKey(Fun), Fun->getName(),
+        computeFunctionSummary(Solver, Importing, ICF, Fun, Facts));
+  }
+  PHASAR_LOG_LEVEL_CAT(INFO, "PersistedSummaryStore",
+                       "Computed " << Summarized.size() << " summaries, "
+                                   << NumAdded << " of them are persistable");
+  return Summarized.size();
+}
+
+} // namespace psr
+
+#endif // PHASAR_ANALYSISSTRATEGY_PERSISTEDSUMMARYSTORE_H
@@ -0,0 +1,55 @@
+#ifndef PHASAR_BENCHMARK_BENCHMARKUTILS_H
+#define PHASAR_BENCHMARK_BENCHMARKUTILS_H
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/Twine.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+namespace psr::benchmark {
+
+/// The directory of the unit tests in the build tree, which contains the
+/// generated llvm_test_code/
+static constexpr llvm::StringLiteral PathToTestDir =
+    PHASAR_BENCHMARK_TEST_DIR;
+
+using Clock = std::chrono::steady_clock;
+
+/// The duration D in (fractional) milliseconds
+[[nodiscard]] inline double millis(Clock::duration D) noexcept {
+  return std::chrono::duration<double, std::milli>(D).count();
+}
+
+/// Runs Fn and returns the wall-clock time it took
+template <typename FnT> [[nodiscard]] Clock::duration measure(FnT &&Fn) {
+  auto Start = Clock::now();
+  std::forward<FnT>(Fn)();
+  return Clock::now() - Start;
+}
+
+/// The input file to benchmark: The value of the environment variable EnvVar,
+/// if set, else the unit-test file Default (e.g.
+/// PHASAR_BUILD_SUBFOLDER("linear_constant/call_01.ll")) in the build tree
+[[nodiscard]] inline std::string getInputFile(const char *EnvVar,
+                                              llvm::StringRef Default) {
+  if (const char *Path = std::getenv(EnvVar)) {
+    return Path;
+  }
+  return (llvm::Twine(PathToTestDir) + Default).str();
+}
+
+/// A numeric benchmark parameter: The value of the environment variable
+/// EnvVar, if set, else Default
+[[nodiscard]] inline size_t getSizeParam(const char *EnvVar, size_t Default) {
+  if (const char *Val = std::getenv(EnvVar)) {
+    return std::stoull(Val);
+  }
+  return Default;
+}
+
+} // namespace psr::benchmark
+
+#endif // PHASAR_BENCHMARK_BENCHMARKUTILS_H
@@ -0,0 +1,10 @@
+#include "phasar/Utils/Logger.h"
+
+#include "gtest/gtest.h"
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  // Logging would dominate the measured running times
+  psr::Logger::disable();
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,58 @@
+#include "phasar/DataFlow/IfdsIde/Solver/BitVectorIFDSSolver.h"
+#include "phasar/DataFlow/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/IFDSUninitializedVariables.h"
+#include "phasar/PhasarLLVM/HelperAnalyses.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMAliasSet.h"
+#include "phasar/PhasarLLVM/SimpleAnalysisConstructor.h"
+
+#include "llvm/IR/InstIterator.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "BenchmarkUtils.h"
+#include "TestConfig.h"
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+using namespace psr;
+using namespace psr::benchmark;
+
+/// Compares the running times of the IFDSSolver and the BitVectorIFDSSolver
+/// for the uninitialized-variables analysis. Set PHASAR_IFDS_BENCH_IR to the
+/// IR file to measure.
+TEST(BitVectorIFDSSolverBenchmark, CompareWithIFDSSolver) {
+  const std::vector<std::string> EntryPoints = {"main"};
+  auto Path = getInputFile(
+      "PHASAR_IFDS_BENCH_IR",
+      PHASAR_BUILD_SUBFOLDER("uninitialized_variables/growing_example.dbg.ll"));
+
+  HelperAnalyses HA(Path, EntryPoints);
+  auto Expected =
+      createAnalysisProblem<IFDSUninitializedVariables>(HA, EntryPoints);
+  auto Actual =
+      createAnalysisProblem<IFDSUninitializedVariables>(HA, EntryPoints);
+
+  IFDSSolver Reference(Expected, &HA.getICFG());
+  auto ReferenceTime = measure([&] { Reference.solve(); });
+
+  BitVectorIFDSSolver Solver(Actual, &HA.getICFG());
+  auto SolverTime = measure([&] { Solver.solve(); });
+
+  size_t NumResults = 0;
+  for (const auto *F : HA.getProjectIRDB().getAllFunctions()) {
+    for (const auto &Inst : llvm::instructions(F)) {
+      auto Facts = Reference.ifdsResultsAt(&Inst);
+      NumResults += Facts.size();
+      EXPECT_EQ(Facts, Solver.ifdsResultsAt(&Inst));
+    }
+  }
+
+  llvm::outs() << Path << ": " << NumResults << " results, "
+               << Solver.getNumPathEdges() << " path edges over "
+               << Solver.getNumFacts() << " facts\n"
+               << "  IFDSSolver:          " << millis(ReferenceTime) << "ms\n"
+               << "  BitVectorIFDSSolver: " << millis(SolverTime) << "ms\n";
+}
@@ -0,0 +1,143 @@
+#include "phasar/Utils/BitVectorSet.h"
+
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "BenchmarkUtils.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+using namespace psr;
+using namespace psr::benchmark;
+
+namespace {
+
+/// The previous implementation of BitVectorSet: A process-wide hash map from
+/// elements to bit positions and a copy of the bits in every iterator
+template <typename T> class LegacyBitVectorSet {
+public:
+  void insert(const T &Data) {
+    auto [It, Inserted] = Position.try_emplace(Data, Values.size());
+    if (Inserted) {
+      Values.push_back(Data);
+    }
+    if (Bits.size() <= It->second) {
+      Bits.resize(It->second + 1);
+    }
+    Bits.set(It->second);
+  }
+
+  [[nodiscard]] size_t count(const T &Data) const {
+    auto It = Position.find(Data);
+    return It != Position.end() && It->second < Bits.size() &&
+           Bits[It->second];
+  }
+
+  void setUnionWith(const LegacyBitVectorSet &Other) { Bits |= Other.Bits; }
+
+  void setIntersectWith(const LegacyBitVectorSet &Other) {
+    Bits &= Other.Bits;
+  }
+
+  template <typename HandlerFn> void forEach(HandlerFn Handler) const {
+    auto BitsCopy = Bits;
+    for (auto Idx : BitsCopy.set_bits()) {
+      Handler(Values[Idx]);
+    }
+  }
+
+private:
+  inline static std::unordered_map<T, size_t> Position;
+  inline static std::vector<T> Values;
+  llvm::BitVector Bits;
+};
+
+} // namespace
+
+/// Compares BitVectorSet against std::set and the previous implementation on
+/// sets of 16 out of 4096 elements and on sets of 2048 out of 4096 elements,
+/// both with the default (synchronized) and with an unsynchronized domain.
+TEST(BitVectorSetBenchmark, InsertUnionIntersectIterate) {
+  constexpr int NumElems = 4096;
+  constexpr int NumSets = 256;
+  constexpr int NumRounds = 20;
+  BitVectorSetDomain<int> UnsyncDomain;
+
+  auto Measure = [&](llvm::StringRef Name, int ElemsPerSet, auto MakeSet,
+                     auto Insert, auto UnionWith, auto IntersectWith,
+                     auto ForEach) {
+    std::mt19937 Rng(42); // NOLINT
+    std::uniform_int_distribution<int> Dist(0, NumElems - 1);
+
+    auto Start = Clock::now();
+    size_t CheckSum = 0;
+    for (int Round = 0; Round < NumRounds; ++Round) {
+      std::vector<decltype(MakeSet())> Sets;
+      Sets.reserve(NumSets);
+      for (int S = 0; S < NumSets; ++S) {
+        auto &Set = Sets.emplace_back(MakeSet());
+        for (int I = 0; I < ElemsPerSet; ++I) {
+          Insert(Set, Dist(Rng));
+        }
+      }
+      for (int S = 1; S < NumSets; ++S) {
+        auto Union = Sets[S - 1];
+        UnionWith(Union, Sets[S]);
+        IntersectWith(Union, Sets[(S * 7) % NumSets]);
+        ForEach(Union, [&CheckSum](int Elem) { CheckSum += Elem; });
+      }
+    }
+    llvm::outs() << "  " << Name << ": " << millis(Clock::now() - Start)
+                 << "ms (checksum " << CheckSum << ")\n";
+  };
+
+  for (int ElemsPerSet : {16, NumElems / 2}) {
+    llvm::outs() << ElemsPerSet << " out of " << NumElems
+                 << " elements per set:\n";
+    Measure(
+        "std::set          ", ElemsPerSet, [] { return std::set<int>(); },
+        [](auto &Set, int Elem) { Set.insert(Elem); },
+        [](auto &Set, const auto &Other) {
+          Set.insert(Other.begin(), Other.end());
+        },
+        [](auto &Set, const auto &Other) {
+          for (auto It = Set.begin(); It != Set.end();) {
+            It = Other.count(*It) ? std::next(It) : Set.erase(It);
+          }
+        },
+        [](const auto &Set, auto Handler) {
+          std::for_each(Set.begin(), Set.end(), Handler);
+        });
+    Measure(
+        "legacy BitVectorSet", ElemsPerSet,
+        [] { return LegacyBitVectorSet<int>(); },
+        [](auto &Set, int Elem) { Set.insert(Elem); },
+        [](auto &Set, const auto &Other) { Set.setUnionWith(Other); },
+        [](auto &Set, const auto &Other) { Set.setIntersectWith(Other); },
+        [](const auto &Set, auto Handler) { Set.forEach(Handler); });
+    Measure(
+        "BitVectorSet      ", ElemsPerSet, [] { return BitVectorSet<int>(); },
+        [](auto &Set, int Elem) { Set.insert(Elem); },
+        [](auto &Set, const auto &Other) { Set.setUnionWith(Other); },
+        [](auto &Set, const auto &Other) { Set.setIntersectWith(Other); },
+        [](const auto &Set, auto Handler) {
+          std::for_each(Set.begin(), Set.end(), Handler);
+        });
+    Measure(
+        "unsynchronized    ", ElemsPerSet,
+        [&UnsyncDomain] { return BitVectorSet<int>(UnsyncDomain); },
+        [](auto &Set, int Elem) { Set.insert(Elem); },
+        [](auto &Set, const auto &Other) { Set.setUnionWith(Other); },
+        [](auto &Set, const auto &Other) { Set.setIntersectWith(Other); },
+        [](const auto &Set, auto Handler) {
+          std::for_each(Set.begin(), Set.end(), Handler);
+        });
+  }
+}
@@ -0,0 +1,76 @@
+#include "phasar/DataFlow/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/IDEExtendedTaintAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/IDEInstInteractionAnalysis.h"
+#include "phasar/PhasarLLVM/HelperAnalyses.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMAliasSet.h"
+#include "phasar/PhasarLLVM/SimpleAnalysisConstructor.h"
+#include "phasar/PhasarLLVM/TaintConfig/LLVMTaintConfig.h"
+
+#include "llvm/Support/raw_ostream.h"
+
+#include "BenchmarkUtils.h"
+#include "TestConfig.h"
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+using namespace psr;
+using namespace psr::benchmark;
+
+/// Compares the running times of the IDEInstInteractionAnalysis and the
+/// IDEExtendedTaintAnalysis with and without the EdgeFunctionMemoCache and
+/// reports its hit rates. The IR files can be overridden with
+/// PHASAR_IIA_BENCH_IR and PHASAR_XTAINT_BENCH_IR, the size of the memo cache
+/// with PHASAR_EF_MEMO_BENCH_SIZE.
+TEST(EdgeFunctionMemoCacheBenchmark, WithAndWithoutMemoCache) {
+  const std::vector<std::string> EntryPoints = {"main"};
+  auto IIAPath =
+      getInputFile("PHASAR_IIA_BENCH_IR",
+                   PHASAR_BUILD_SUBFOLDER("inst_interaction/heap_01.ll"));
+  auto XTaintPath = getInputFile("PHASAR_XTAINT_BENCH_IR",
+                                 PHASAR_BUILD_SUBFOLDER("xtaint/xtaint21.ll"));
+  auto MemoSize = getSizeParam("PHASAR_EF_MEMO_BENCH_SIZE", 65536);
+
+  auto Solve = [MemoSize](auto &Problem, const auto &ICF, bool UseMemo) {
+    Problem.getIFDSIDESolverConfig().setEdgeFunctionMemoCacheSize(
+        UseMemo ? MemoSize : 0);
+    IDESolver Solver(Problem, &ICF);
+    auto Time = measure([&] { Solver.solve(); });
+    if (auto Stats = Solver.getEdgeFunctionMemoStats()) {
+      llvm::outs() << "  " << *Stats << '\n';
+    }
+    return millis(Time);
+  };
+
+  {
+    ValueAnnotationPass::resetValueID();
+    HelperAnalyses HA(IIAPath, EntryPoints);
+    auto &ICF = HA.getICFG();
+    auto Problem =
+        createAnalysisProblem<IDEInstInteractionAnalysisT<std::string>>(
+            HA, EntryPoints);
+    llvm::outs() << IIAPath << ":\n";
+    auto Without = Solve(Problem, ICF, false);
+    auto With = Solve(Problem, ICF, true);
+    llvm::outs() << "  without memo cache: " << Without << "ms\n"
+                 << "  with memo cache:    " << With << "ms\n";
+  }
+
+  {
+    ValueAnnotationPass::resetValueID();
+    HelperAnalyses HA(XTaintPath, EntryPoints);
+    auto &ICF = HA.getICFG();
+    LLVMTaintConfig TC(HA.getProjectIRDB());
+    auto Problem = createAnalysisProblem<IDEExtendedTaintAnalysis<>>(
+        HA, TC, EntryPoints);
+    llvm::outs() << XTaintPath << ":\n";
+    auto Without = Solve(Problem, ICF, false);
+    auto With = Solve(Problem, ICF, true);
+    llvm::outs() << "  without memo cache: " << Without << "ms\n"
+                 << "  with memo cache:    " << With << "ms\n";
+  }
+}
@@ -0,0 +1,242 @@
+#include "phasar/DataFlow/IfdsIde/EdgeFunction.h"
+#include "phasar/DataFlow/IfdsIde/Solver/FlowEdgeFunctionCache.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/Utils/Logger.h"
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "BenchmarkUtils.h"
+#include "RecordingTaintAnalysis.h"
+#include "TestConfig.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cassert>
+#include <map>
+#include <random>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+using namespace psr;
+using namespace psr::benchmark;
+using namespace psr::unittest;
+
+namespace {
+
+using n_t = RecordingTaintAnalysis::n_t;
+using d_t = RecordingTaintAnalysis::d_t;
+using f_t = RecordingTaintAnalysis::f_t;
+using l_t = RecordingTaintAnalysis::l_t;
+using FlowFunctionPtrType = RecordingTaintAnalysis::FlowFunctionPtrType;
+
+/// The layout of the inter-procedural caches of the FlowEdgeFunctionCache
+/// before they were changed to hash tables over compressed keys.
+struct LegacyFlowEdgeFunctionCache {
+  std::map<std::tuple<n_t, f_t>, FlowFunctionPtrType> CallFlowFunctionCache;
+  std::map<std::tuple<n_t, f_t, n_t, n_t>, FlowFunctionPtrType>
+      ReturnFlowFunctionCache;
+  std::map<std::tuple<n_t, n_t>, FlowFunctionPtrType>
+      CallToRetFlowFunctionCache;
+  std::map<std::tuple<n_t, d_t, f_t, d_t>, EdgeFunction<l_t>>
+      CallEdgeFunctionCache;
+  std::map<std::tuple<n_t, f_t, n_t, d_t, n_t, d_t>, EdgeFunction<l_t>>
+      ReturnEdgeFunctionCache;
+
+  /// The cache hit path of the previous FlowEdgeFunctionCache, including its
+  /// logging checks
+  template <typename MapT, typename... ArgTys>
+  static auto lookup(const MapT &Cache, const ArgTys &...Args) {
+    IF_LOG_ENABLED(PHASAR_LOG_LEVEL(DEBUG, "Legacy cache lookup"));
+    auto Key = std::tie(Args...);
+    auto It = Cache.find(Key);
+    assert(It != Cache.end());
+    PHASAR_LOG_LEVEL(DEBUG, "Fetched from cache");
+    return It->second;
+  }
+};
+
+
+} // namespace
+
+/// Compares the time of cache hits in the inter-procedural caches of the
+/// FlowEdgeFunctionCache with the previous layout of std::maps that are keyed
+/// by the uncompressed instructions, functions and facts. All keys that the
+/// IFDSTaintAnalysis queries while solving are looked up repeatedly. The IR
+/// file can be overridden with PHASAR_TAINT_BENCH_IR, the number of rounds
+/// with PHASAR_FEFC_BENCH_ROUNDS.
+TEST(FlowEdgeFunctionCacheBenchmark, CacheHits) {
+  auto Path = getInputFile(
+      "PHASAR_TAINT_BENCH_IR",
+      PHASAR_BUILD_SUBFOLDER(
+          "taint_analysis/dummy_source_sink/taint_exception_04.dbg.ll"));
+  size_t Rounds = getSizeParam("PHASAR_FEFC_BENCH_ROUNDS", 10000);
+
+  ValueAnnotationPass::resetValueID();
+  RecordedTaintSolve Solve(Path, {"main"});
+  auto *TaintProblem = &Solve.TaintProblem;
+  const auto Queries = TaintProblem->Queries;
+
+  // Populate both layouts with the same flow and edge functions
+  FlowEdgeFunctionCache<RecordingTaintAnalysis::ProblemAnalysisDomain> Cache(
+      *TaintProblem);
+  LegacyFlowEdgeFunctionCache Legacy;
+  for (const auto &[CallSite, DestFun] : Queries.CallFF) {
+    Legacy.CallFlowFunctionCache[{CallSite, DestFun}] =
+        Cache.getCallFlowFunction(CallSite, DestFun);
+  }
+  for (const auto &[CallSite, CalleeFun, ExitInst, RetSite] : Queries.RetFF) {
+    Legacy.ReturnFlowFunctionCache[{CallSite, CalleeFun, ExitInst, RetSite}] =
+        Cache.getRetFlowFunction(CallSite, CalleeFun, ExitInst, RetSite);
+  }
+  for (const auto &[CallSite, RetSite, Callees] : Queries.CallToRetFF) {
+    Legacy.CallToRetFlowFunctionCache[{CallSite, RetSite}] =
+        Cache.getCallToRetFlowFunction(CallSite, RetSite, Callees);
+  }
+  for (const auto &[CallSite, Src, DestFun, Dest] : Queries.CallEF) {
+    Legacy.CallEdgeFunctionCache[{CallSite, Src, DestFun, Dest}] =
+        Cache.getCallEdgeFunction(CallSite, Src, DestFun, Dest);
+  }
+  for (const auto &[CallSite, CalleeFun, ExitInst, ExitNode, RetSite,
+                    RetNode] : Queries.RetEF) {
+    Legacy.ReturnEdgeFunctionCache[{CallSite, CalleeFun, ExitInst, ExitNode,
+                                    RetSite, RetNode}] =
+        Cache.getReturnEdgeFunction(CallSite, CalleeFun, ExitInst, ExitNode,
+                                    RetSite, RetNode);
+  }
+  auto NumConstructed = TaintProblem->NumConstructed;
+
+  // Look the keys up in random order, such that the std::maps do not profit
+  // from the sorted order of the recorded keys
+  std::mt19937 RNG(42); // NOLINT
+  auto Shuffled = [&RNG](const auto &Keys) {
+    std::vector<typename std::decay_t<decltype(Keys)>::value_type> Ret(
+        Keys.begin(), Keys.end());
+    std::shuffle(Ret.begin(), Ret.end(), RNG);
+    return Ret;
+  };
+  auto CallFFKeys = Shuffled(Queries.CallFF);
+  auto RetFFKeys = Shuffled(Queries.RetFF);
+  auto CallToRetFFKeys = Shuffled(Queries.CallToRetFF);
+  auto CallEFKeys = Shuffled(Queries.CallEF);
+  auto RetEFKeys = Shuffled(Queries.RetEF);
+
+  size_t NumFound = 0;
+  auto Measure = [Rounds, &NumFound](llvm::StringRef Name, size_t NumKeys,
+                                     auto LookupLegacy, auto LookupNew) {
+    auto Time = [Rounds, &NumFound](auto Lookup) {
+      return millis(measure([&] {
+        for (size_t Round = 0; Round != Rounds; ++Round) {
+          NumFound += Lookup();
+        }
+      }));
+    };
+    auto LegacyTime = Time(LookupLegacy);
+    auto NewTime = Time(LookupNew);
+    llvm::outs() << "  " << Name << " (" << NumKeys << " keys):\n"
+                 << "    std::map:   " << LegacyTime << "ms\n"
+                 << "    hash table: " << NewTime << "ms\n";
+  };
+
+  llvm::outs() << Path << ", " << Rounds << " rounds:\n";
+  Measure(
+      "Call-FF", Queries.CallFF.size(),
+      [&] {
+        size_t N = 0;
+        for (const auto &[CallSite, DestFun] : CallFFKeys) {
+          N += bool(LegacyFlowEdgeFunctionCache::lookup(
+              Legacy.CallFlowFunctionCache, CallSite, DestFun));
+        }
+        return N;
+      },
+      [&] {
+        size_t N = 0;
+        for (const auto &[CallSite, DestFun] : CallFFKeys) {
+          N += bool(Cache.getCallFlowFunction(CallSite, DestFun));
+        }
+        return N;
+      });
+  Measure(
+      "Return-FF", Queries.RetFF.size(),
+      [&] {
+        size_t N = 0;
+        for (const auto &[CallSite, CalleeFun, ExitInst, RetSite] :
+             RetFFKeys) {
+          N += bool(LegacyFlowEdgeFunctionCache::lookup(
+              Legacy.ReturnFlowFunctionCache, CallSite, CalleeFun, ExitInst,
+              RetSite));
+        }
+        return N;
+      },
+      [&] {
+        size_t N = 0;
+        for (const auto &[CallSite, CalleeFun, ExitInst, RetSite] :
+             RetFFKeys) {
+          N += bool(
+              Cache.getRetFlowFunction(CallSite, CalleeFun, ExitInst, RetSite));
+        }
+        return N;
+      });
+  Measure(
+      "CallToRet-FF", Queries.CallToRetFF.size(),
+      [&] {
+        size_t N = 0;
+        for (const auto &[CallSite, RetSite, Callees] : CallToRetFFKeys) {
+          N += bool(LegacyFlowEdgeFunctionCache::lookup(
+              Legacy.CallToRetFlowFunctionCache, CallSite, RetSite));
+        }
+        return N;
+      },
+      [&] {
+        size_t N = 0;
+        for (const auto &[CallSite, RetSite, Callees] : CallToRetFFKeys) {
+          N += bool(
+              Cache.getCallToRetFlowFunction(CallSite, RetSite, Callees));
+        }
+        return N;
+      });
+  Measure(
+      "Call-EF", Queries.CallEF.size(),
+      [&] {
+        size_t N = 0;
+        for (const auto &[CallSite, Src, DestFun, Dest] : CallEFKeys) {
+          N += bool(LegacyFlowEdgeFunctionCache::lookup(
+              Legacy.CallEdgeFunctionCache, CallSite, Src, DestFun, Dest));
+        }
+        return N;
+      },
+      [&] {
+        size_t N = 0;
+        for (const auto &[CallSite, Src, DestFun, Dest] : CallEFKeys) {
+          N += bool(Cache.getCallEdgeFunction(CallSite, Src, DestFun, Dest));
+        }
+        return N;
+      });
+  Measure(
+      "Return-EF", Queries.RetEF.size(),
+      [&] {
+        size_t N = 0;
+        for (const auto &[CallSite, CalleeFun, ExitInst, ExitNode, RetSite,
+                          RetNode] : RetEFKeys) {
+          N += bool(LegacyFlowEdgeFunctionCache::lookup(
+              Legacy.ReturnEdgeFunctionCache, CallSite, CalleeFun, ExitInst,
+              ExitNode, RetSite, RetNode));
+        }
+        return N;
+      },
+      [&] {
+        size_t N = 0;
+        for (const auto &[CallSite, CalleeFun, ExitInst, ExitNode, RetSite,
+                          RetNode] : RetEFKeys) {
+          N += bool(Cache.getReturnEdgeFunction(CallSite, CalleeFun, ExitInst,
+                                                ExitNode, RetSite, RetNode));
+        }
+        return N;
+      });
+
+  // All lookups must have been cache hits
+  EXPECT_EQ(NumConstructed, TaintProblem->NumConstructed);
+  EXPECT_GT(NumFound, 0);
+}
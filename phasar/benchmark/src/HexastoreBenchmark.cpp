@@ -0,0 +1,50 @@
+#include "phasar/DB/Hexastore.h"
+
+#include "llvm/Support/raw_ostream.h"
+
+#include "BenchmarkUtils.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+using namespace psr;
+using namespace psr::benchmark;
+
+/// Loads a synthetic call graph into a Hexastore. Set
+/// PHASAR_HEXASTORE_BENCH_TRIPLES to change the number of triples.
+TEST(HexastoreBenchmark, BulkLoad) {
+  const size_t NumTriples =
+      getSizeParam("PHASAR_HEXASTORE_BENCH_TRIPLES", 10'000'000);
+  const size_t NumFunctions = std::max<size_t>(NumTriples / 8, 1);
+
+  Hexastore H("");
+  std::mt19937_64 Rng(42); // NOLINT
+  std::uniform_int_distribution<size_t> Dist(0, NumFunctions - 1);
+
+  auto LoadTime = measure([&] {
+    Hexastore::Transaction Trans(H);
+    for (size_t I = 0; I < NumTriples; ++I) {
+      H.put("f" + std::to_string(I % NumFunctions), "calls",
+            "f" + std::to_string(Dist(Rng)));
+    }
+    Trans.commit();
+  });
+
+  size_t NumResults = 0;
+  auto QueryTime = measure([&] {
+    for (size_t I = 0; I < 10000; ++I) {
+      auto Cursor =
+          H.query({{"f" + std::to_string(Dist(Rng)), "calls", "?"}});
+      while (Cursor.next()) {
+        ++NumResults;
+      }
+    }
+  });
+
+  llvm::outs() << "Loaded " << NumTriples << " triples in " << millis(LoadTime)
+               << "ms\n";
+  llvm::outs() << "10000 queries for the callees of a function yielded "
+               << NumResults << " results in " << millis(QueryTime) << "ms\n";
+}
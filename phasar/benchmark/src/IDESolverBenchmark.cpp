@@ -0,0 +1,150 @@
+#include "phasar/DataFlow/IfdsIde/EdgeFunction.h"
+#include "phasar/DataFlow/IfdsIde/Solver/IDESolver.h"
+#include "phasar/DataFlow/IfdsIde/Solver/JumpFunctions.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/HelperAnalyses.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMAliasSet.h"
+#include "phasar/PhasarLLVM/SimpleAnalysisConstructor.h"
+#include "phasar/Utils/Table.h"
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "BenchmarkUtils.h"
+#include "TestConfig.h"
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <set>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace psr;
+using namespace psr::benchmark;
+
+namespace {
+
+using domain_t = IDELinearConstantAnalysisDomain;
+using l_t = domain_t::l_t;
+using d_t = domain_t::d_t;
+using n_t = domain_t::n_t;
+
+/// The linear constant analysis is measured on this IR file, unless
+/// PHASAR_LCA_BENCH_IR is set
+std::string getLCAInputFile() {
+  return getInputFile("PHASAR_LCA_BENCH_IR",
+                      PHASAR_BUILD_SUBFOLDER("linear_constant/call_06.dbg.ll"));
+}
+
+/// The layout of the JumpFunctions before facts and statements were interned:
+/// every jump function is stored three times in nested hash maps.
+struct LegacyJumpFunctions {
+  Table<n_t, d_t, llvm::SmallVector<std::pair<d_t, EdgeFunction<l_t>>, 1>>
+      NonEmptyReverseLookup;
+  Table<d_t, n_t, llvm::SmallVector<std::pair<d_t, EdgeFunction<l_t>>, 1>>
+      NonEmptyForwardLookup;
+  std::unordered_map<n_t, Table<d_t, d_t, EdgeFunction<l_t>>>
+      NonEmptyLookupByTargetNode;
+
+  void addFunction(d_t SourceVal, n_t Target, d_t TargetVal,
+                   const EdgeFunction<l_t> &EdgeFunc) {
+    NonEmptyReverseLookup.get(Target, TargetVal)
+        .emplace_back(SourceVal, EdgeFunc);
+    NonEmptyForwardLookup.get(SourceVal, Target)
+        .emplace_back(TargetVal, EdgeFunc);
+    NonEmptyLookupByTargetNode[Target].insert(SourceVal, TargetVal, EdgeFunc);
+  }
+};
+
+} // namespace
+
+/// Measures the running time of the linear constant analysis with 1, 2, 4 and
+/// 8 solver threads.
+TEST(IDESolverBenchmark, ParallelSolving) {
+  const std::vector<std::string> EntryPoints = {"main"};
+  auto Path = getLCAInputFile();
+
+  ValueAnnotationPass::resetValueID();
+  HelperAnalyses HA(Path, EntryPoints);
+  auto &ICFG = HA.getICFG();
+  // Precompute the alias information as AnalysisController does, such that
+  // it is not part of the measurement
+  HA.prepareForConcurrentAccess();
+  auto LCAProblem =
+      createAnalysisProblem<IDELinearConstantAnalysis>(HA, EntryPoints);
+
+  llvm::outs() << Path << ":\n";
+  size_t NumSequentialResults = 0;
+  for (unsigned NumThreads : {1, 2, 4, 8}) {
+    LCAProblem.getIFDSIDESolverConfig().setNumThreads(NumThreads);
+    auto Start = Clock::now();
+    auto Results = IDESolver(LCAProblem, &ICFG).solve();
+    auto Time = Clock::now() - Start;
+
+    auto NumResults = Results.getAllResultEntries().size();
+    if (NumThreads == 1) {
+      NumSequentialResults = NumResults;
+    }
+    EXPECT_EQ(NumSequentialResults, NumResults);
+    llvm::outs() << "  " << NumThreads << " threads: " << millis(Time)
+                 << "ms\n";
+  }
+}
+
+/// Compares the heap memory that the jump functions computed by the
+/// IDELinearConstantAnalysis occupy in the interned layout of the
+/// JumpFunctions against the previous layout of three nested hash tables.
+TEST(IDESolverBenchmark, JumpFunctionsMemory) {
+  const std::vector<std::string> EntryPoints = {"main"};
+  auto Path = getLCAInputFile();
+
+  ValueAnnotationPass::resetValueID();
+  HelperAnalyses HA(Path, EntryPoints);
+  auto Problem = createAnalysisProblem<IDELinearConstantAnalysis>(HA,
+                                                                  EntryPoints);
+  IDESolver Solver(Problem, &HA.getICFG());
+  Solver.solve();
+  const auto &Solved = Solver.getJumpFunctions();
+
+  std::vector<std::tuple<d_t, n_t, d_t, EdgeFunction<l_t>>> Records;
+  for (const auto *F : HA.getProjectIRDB().getAllFunctions()) {
+    for (const auto &Inst : llvm::instructions(F)) {
+      Solved.lookupByTarget(
+          &Inst, [&Records, &Inst](d_t Source, d_t TargetVal,
+                                   const EdgeFunction<l_t> &EF) {
+            Records.emplace_back(Source, &Inst, TargetVal, EF);
+          });
+    }
+  }
+
+  // The edge functions are shared between both layouts, so the differences
+  // only account for the containers themselves
+  auto Before = llvm::sys::Process::GetMallocUsage();
+  auto Legacy = std::make_unique<LegacyJumpFunctions>();
+  for (const auto &[Source, Target, TargetVal, EF] : Records) {
+    Legacy->addFunction(Source, Target, TargetVal, EF);
+  }
+  auto LegacyBytes = llvm::sys::Process::GetMallocUsage() - Before;
+  Legacy.reset();
+
+  Before = llvm::sys::Process::GetMallocUsage();
+  auto Interned =
+      std::make_unique<JumpFunctions<domain_t, std::set<d_t>>>(Problem);
+  for (const auto &[Source, Target, TargetVal, EF] : Records) {
+    Interned->addFunction(Source, Target, TargetVal, EF);
+  }
+  auto InternedBytes = llvm::sys::Process::GetMallocUsage() - Before;
+  ASSERT_EQ(Records.size(), Interned->size());
+
+  llvm::outs() << Path << ": " << Records.size() << " jump functions\n"
+               << "  three hash tables: " << LegacyBytes << " bytes\n"
+               << "  interned:          " << InternedBytes << " bytes\n";
+}
@@ -0,0 +1,93 @@
+#include "phasar/ControlFlow/CallGraphAnalysisType.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMAliasSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "phasar/PhasarLLVM/Utils/LLVMBinarySerialization.h"
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "BenchmarkUtils.h"
+#include "TestConfig.h"
+#include "gtest/gtest.h"
+#include "nlohmann/json.hpp"
+
+#include <memory>
+#include <string>
+
+using namespace psr;
+using namespace psr::benchmark;
+
+/// Compares loading the helper analyses from JSON against loading them from
+/// the binary format. Set PHASAR_BINARY_SERIALIZATION_BENCH_IR to the IR file
+/// to measure.
+TEST(LLVMBinarySerializationBenchmark, LoadJsonVsBinary) {
+  auto Path = getInputFile("PHASAR_BINARY_SERIALIZATION_BENCH_IR",
+                           PHASAR_BUILD_SUBFOLDER("call_graphs/"
+                                                  "virtual_call_9.ll"));
+
+  LLVMProjectIRDB IRDB(Path);
+  ASSERT_TRUE(IRDB.isValid()) << Path;
+
+  LLVMAliasSet PTS(&IRDB, false);
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMBasedICFG ICF(&IRDB, CallGraphAnalysisType::OTF, {"main"}, &TH, &PTS);
+
+  auto Measure = [&](llvm::StringRef Name, auto WriteJson, auto LoadJson,
+                     auto WriteBinary, auto LoadBinary) {
+    auto Json = WriteJson().dump();
+    std::string Bin;
+    llvm::raw_string_ostream OS(Bin);
+    WriteBinary(OS);
+
+    // Keep the loaded analyses alive, such that their destruction is not
+    // measured
+    auto Start = Clock::now();
+    auto FromJson = LoadJson(nlohmann::json::parse(Json));
+    auto JsonTime = Clock::now() - Start;
+
+    Start = Clock::now();
+    auto FromBinary = LoadBinary(llvm::MemoryBufferRef(OS.str(), Name));
+    auto BinaryTime = Clock::now() - Start;
+    EXPECT_NE(nullptr, FromBinary) << Name.str();
+
+    llvm::outs() << Name << ":\n";
+    llvm::outs() << "  json:   " << (Json.size() >> 10) << "KiB, "
+                 << millis(JsonTime) << "ms\n";
+    llvm::outs() << "  binary: " << (OS.str().size() >> 10) << "KiB, "
+                 << millis(BinaryTime) << "ms\n";
+  };
+
+  llvm::outs() << "Loading the helper analyses of " << Path << '\n';
+  Measure(
+      "alias sets", [&] { return PTS.getAsJson(); },
+      [&](const nlohmann::json &J) {
+        return std::make_unique<LLVMAliasSet>(&IRDB, J);
+      },
+      [&](llvm::raw_ostream &OS) { PTS.writeBinary(OS); },
+      [&](llvm::MemoryBufferRef Buf) {
+        return LLVMAliasSet::loadBinary(&IRDB, Buf);
+      });
+  Measure(
+      "call-graph", [&] { return ICF.getAsJson(); },
+      [&](const nlohmann::json &J) {
+        return std::make_unique<LLVMBasedICFG>(&IRDB, J);
+      },
+      [&](llvm::raw_ostream &OS) { ICF.writeBinary(OS); },
+      [&](llvm::MemoryBufferRef Buf) {
+        return LLVMBasedICFG::loadBinary(&IRDB, Buf);
+      });
+  // There is no way to load the type hierarchy from JSON; compare against
+  // recomputing it instead
+  Measure(
+      "type hierarchy", [&] { return TH.getAsJson(); },
+      [&](const nlohmann::json & /*J*/) {
+        return std::make_unique<LLVMTypeHierarchy>(IRDB);
+      },
+      [&](llvm::raw_ostream &OS) { TH.writeBinary(IRDB, OS); },
+      [&](llvm::MemoryBufferRef Buf) {
+        return LLVMTypeHierarchy::loadBinary(IRDB, Buf);
+      });
+}
@@ -0,0 +1,74 @@
+#include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "BenchmarkUtils.h"
+#include "TestConfig.h"
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+using namespace psr;
+using namespace psr::benchmark;
+
+/// Measures the subtype queries on the type hierarchy of the IR file in
+/// PHASAR_TYPE_HIERARCHY_BENCH_IR; ideally, the linked IR of a large C++
+/// codebase.
+TEST(LLVMTypeHierarchyBenchmark, SubTypeQueries) {
+  auto Path = getInputFile(
+      "PHASAR_TYPE_HIERARCHY_BENCH_IR",
+      PHASAR_BUILD_SUBFOLDER("type_hierarchies/type_hierarchy_11.ll"));
+
+  LLVMProjectIRDB IRDB(Path);
+  ASSERT_TRUE(IRDB.isValid()) << Path;
+
+  auto Start = Clock::now();
+  LLVMTypeHierarchy TH(IRDB);
+  auto ConstructionTime = Clock::now() - Start;
+
+  auto AllTypes = TH.getAllTypes();
+  std::vector<const llvm::StructType *> Types(AllTypes.begin(),
+                                              AllTypes.end());
+
+  Start = Clock::now();
+  size_t NumSubTypePairs = 0;
+  for (const auto *Type : Types) {
+    for (const auto *Other : Types) {
+      NumSubTypePairs += TH.isSubType(Type, Other);
+    }
+  }
+  auto IsSubTypeTime = Clock::now() - Start;
+
+  Start = Clock::now();
+  size_t NumVisited = 0;
+  for (const auto *Type : Types) {
+    TH.forEachSubType(Type, [&NumVisited](const auto * /*SubType*/) {
+      ++NumVisited;
+    });
+  }
+  auto ForEachTime = Clock::now() - Start;
+
+  Start = Clock::now();
+  size_t NumInSets = 0;
+  for (const auto *Type : Types) {
+    NumInSets += TH.getSubTypes(Type).size();
+  }
+  auto GetSubTypesTime = Clock::now() - Start;
+
+  EXPECT_EQ(NumSubTypePairs, NumVisited);
+  EXPECT_EQ(NumSubTypePairs, NumInSets);
+
+  llvm::outs() << "Type hierarchy of " << Path << " with " << Types.size()
+               << " types and " << NumSubTypePairs << " subtype pairs:\n";
+  llvm::outs() << "  construction:           " << millis(ConstructionTime)
+               << "ms\n";
+  llvm::outs() << "  isSubType (all pairs):  " << millis(IsSubTypeTime)
+               << "ms\n";
+  llvm::outs() << "  forEachSubType:         " << millis(ForEachTime)
+               << "ms\n";
+  llvm::outs() << "  getSubTypes (std::set): " << millis(GetSubTypesTime)
+               << "ms\n";
+}
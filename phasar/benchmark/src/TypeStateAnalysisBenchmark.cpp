@@ -0,0 +1,121 @@
+#include "phasar/DataFlow/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/IDETypeStateAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/TypeStateDescriptions/CSTDFILEIOTypeStateDescription.h"
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/TypeStateDescriptions/OpenSSLSecureMemoryDescription.h"
+#include "phasar/PhasarLLVM/HelperAnalyses.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/SimpleAnalysisConstructor.h"
+
+#include "llvm/IR/InstIterator.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "BenchmarkUtils.h"
+#include "TestConfig.h"
+#include "gtest/gtest.h"
+
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace psr;
+using namespace psr::benchmark;
+
+namespace {
+
+/// Hides the token ids of a description, such that the IDETypeStateAnalysis
+/// falls back to computing the transitions by function name
+struct NameBasedDescription : TypeStateDescription {
+  const TypeStateDescription &Desc;
+
+  explicit NameBasedDescription(const TypeStateDescription &Desc) noexcept
+      : Desc(Desc) {}
+
+  bool isFactoryFunction(const std::string &F) const override {
+    return Desc.isFactoryFunction(F);
+  }
+  bool isConsumingFunction(const std::string &F) const override {
+    return Desc.isConsumingFunction(F);
+  }
+  bool isAPIFunction(const std::string &F) const override {
+    return Desc.isAPIFunction(F);
+  }
+  State getNextState(std::string Tok, State S) const override {
+    return Desc.getNextState(std::move(Tok), S);
+  }
+  std::string getTypeNameOfInterest() const override {
+    return Desc.getTypeNameOfInterest();
+  }
+  std::set<int> getConsumerParamIdx(const std::string &F) const override {
+    return Desc.getConsumerParamIdx(F);
+  }
+  std::set<int> getFactoryParamIdx(const std::string &F) const override {
+    return Desc.getFactoryParamIdx(F);
+  }
+  std::string stateToString(State S) const override {
+    return Desc.stateToString(S);
+  }
+  State bottom() const override { return Desc.bottom(); }
+  State top() const override { return Desc.top(); }
+  State uninit() const override { return Desc.uninit(); }
+  State start() const override { return Desc.start(); }
+  State error() const override { return Desc.error(); }
+};
+
+} // namespace
+
+/// Compares the running times of the IDETypeStateAnalysis with token-based
+/// and name-based state transitions for the CSTDIO and the OpenSSL
+/// secure-memory automata. The IR files can be overridden with PHASAR_TYPESTATE_BENCH_IR and
+/// PHASAR_OPENSSL_TYPESTATE_BENCH_IR.
+TEST(TypeStateAnalysisBenchmark, TokenVsNameBasedTransitions) {
+  const std::vector<std::string> EntryPoints = {"main"};
+  auto FileIOPath = getInputFile(
+      "PHASAR_TYPESTATE_BENCH_IR",
+      PHASAR_BUILD_SUBFOLDER("typestate_analysis_fileio/typestate_19.ll"));
+  auto OpenSSLPath =
+      getInputFile("PHASAR_OPENSSL_TYPESTATE_BENCH_IR",
+                   PHASAR_BUILD_SUBFOLDER("openssl/secure_memory/memory5.ll"));
+
+  auto Solve = [&EntryPoints](const std::string &Path,
+                              const TypeStateDescription &Desc) {
+    ValueAnnotationPass::resetValueID();
+    HelperAnalyses HA(Path, EntryPoints);
+    // Build the ICFG and alias information outside of the measurement
+    auto &ICF = HA.getICFG();
+    auto Problem =
+        createAnalysisProblem<IDETypeStateAnalysis>(HA, &Desc, EntryPoints);
+    IDESolver Solver(Problem, &ICF);
+    auto Time = measure([&] { Solver.solve(); });
+
+    size_t NumResults = 0;
+    for (const auto *F : HA.getProjectIRDB().getAllFunctions()) {
+      for (const auto &Inst : llvm::instructions(F)) {
+        NumResults += Solver.resultsAt(&Inst, true).size();
+      }
+    }
+    return std::make_pair(millis(Time), NumResults);
+  };
+
+  CSTDFILEIOTypeStateDescription FileIODesc;
+  NameBasedDescription NameBasedFileIODesc(FileIODesc);
+  auto [TokenTime, TokenResults] = Solve(FileIOPath, FileIODesc);
+  auto [NameTime, NameResults] = Solve(FileIOPath, NameBasedFileIODesc);
+  EXPECT_EQ(TokenResults, NameResults);
+
+  OpenSSLSecureMemoryDescription OpenSSLDesc;
+  NameBasedDescription NameBasedOpenSSLDesc(OpenSSLDesc);
+  auto [OpenSSLTime, OpenSSLResults] = Solve(OpenSSLPath, OpenSSLDesc);
+  auto [OpenSSLNameTime, OpenSSLNameResults] =
+      Solve(OpenSSLPath, NameBasedOpenSSLDesc);
+  EXPECT_EQ(OpenSSLResults, OpenSSLNameResults);
+
+  llvm::outs() << FileIOPath << ": " << TokenResults << " results\n"
+               << "  token-based transitions: " << TokenTime << "ms\n"
+               << "  name-based transitions:  " << NameTime << "ms\n"
+               << OpenSSLPath << ": " << OpenSSLResults << " results\n"
+               << "  token-based transitions: " << OpenSSLTime << "ms\n"
+               << "  name-based transitions:  " << OpenSSLNameTime << "ms\n";
+}
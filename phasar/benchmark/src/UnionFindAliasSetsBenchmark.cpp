@@ -0,0 +1,150 @@
+#include "phasar/Pointer/AliasSetOwner.h"
+#include "phasar/Pointer/UnionFindAliasSets.h"
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "BenchmarkUtils.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace psr;
+using namespace psr::benchmark;
+
+namespace {
+
+using SetTy = llvm::DenseSet<const int *>;
+
+/// The merge strategy that LLVMAliasSet used before the union-find: Every
+/// value owns a materialized alias set and merging copies the smaller set into
+/// the larger one.
+class EagerAliasSets {
+public:
+  explicit EagerAliasSets(AliasSetOwner<SetTy> &Owner) noexcept
+      : Owner(Owner) {}
+
+  void insert(const int *V) {
+    auto [It, Inserted] = AliasSets.try_emplace(V, nullptr);
+    if (Inserted) {
+      It->second = Owner.acquire();
+      It->second->insert(V);
+      Live += It->second->getMemorySize();
+      PeakMemory = std::max(PeakMemory, Live);
+    }
+  }
+
+  void merge(const int *V1, const int *V2) {
+    auto PTS1 = AliasSets[V1];
+    auto PTS2 = AliasSets[V2];
+    if (PTS1.get() == PTS2.get()) {
+      return;
+    }
+    if (PTS1->size() > PTS2->size()) {
+      std::swap(PTS1, PTS2);
+    }
+
+    Live -= PTS2->getMemorySize() + PTS1->getMemorySize();
+    PTS2->insert(PTS1->begin(), PTS1->end());
+    auto *ToDelete = PTS1.get();
+    for (const auto *V : *PTS1) {
+      if (auto PTS = AliasSets[V]; PTS.get() == ToDelete) {
+        *PTS.value() = PTS2.get();
+      }
+    }
+    Live += PTS2->getMemorySize();
+    PeakMemory = std::max(PeakMemory, Live + ToDelete->getMemorySize());
+    Owner.release(ToDelete);
+  }
+
+  [[nodiscard]] const SetTy &getAliasSet(const int *V) {
+    return *AliasSets[V];
+  }
+
+  [[nodiscard]] size_t getPeakMemory() const noexcept {
+    return PeakMemory + AliasSets.getMemorySize();
+  }
+
+private:
+  AliasSetOwner<SetTy> &Owner;
+  llvm::DenseMap<const int *, BoxedPtr<SetTy>> AliasSets;
+  size_t Live = 0;
+  size_t PeakMemory = 0;
+};
+
+} // namespace
+
+/// Compares the union-find against the previous strategy of eagerly merging
+/// the materialized alias sets.
+TEST(UnionFindAliasSetsBenchmark, MergeTimeAndPeakMemory) {
+  constexpr size_t NumValues = 1 << 18;
+  constexpr size_t NumMerges = NumValues - 64;
+
+  std::vector<int> Values(NumValues);
+  std::vector<std::pair<size_t, size_t>> Merges;
+  Merges.reserve(NumMerges);
+  std::mt19937 Rng(42); // NOLINT
+  std::uniform_int_distribution<size_t> Dist(0, NumValues - 1);
+  for (size_t I = 0; I < NumMerges; ++I) {
+    Merges.emplace_back(Dist(Rng), Dist(Rng));
+  }
+
+  size_t EagerPeak = 0;
+  Clock::duration EagerTime{};
+  size_t EagerCheckSum = 0;
+  {
+    AliasSetOwner<SetTy>::memory_resource_type MRes;
+    AliasSetOwner<SetTy> Owner{&MRes};
+    EagerAliasSets Eager(Owner);
+
+    auto Start = Clock::now();
+    for (const auto &V : Values) {
+      Eager.insert(&V);
+    }
+    for (auto [Lhs, Rhs] : Merges) {
+      Eager.merge(&Values[Lhs], &Values[Rhs]);
+    }
+    EagerTime = Clock::now() - Start;
+    EagerPeak = Eager.getPeakMemory();
+    EagerCheckSum = Eager.getAliasSet(&Values[0]).size();
+  }
+
+  size_t UFPeak = 0;
+  Clock::duration UFTime{};
+  size_t UFCheckSum = 0;
+  {
+    AliasSetOwner<SetTy>::memory_resource_type MRes;
+    AliasSetOwner<SetTy> Owner{&MRes};
+    UnionFindAliasSets<SetTy> AliasSets(Owner);
+    AliasSets.reserve(NumValues);
+
+    auto Start = Clock::now();
+    for (const auto &V : Values) {
+      AliasSets.insert(&V);
+    }
+    for (auto [Lhs, Rhs] : Merges) {
+      AliasSets.merge(&Values[Lhs], &Values[Rhs]);
+    }
+    UFTime = Clock::now() - Start;
+    // The union-find itself: Ids, Values, Parent, Size, Next and Sets
+    UFPeak = NumValues * (sizeof(void *) + 3 * sizeof(uint32_t) +
+                          sizeof(BoxedPtr<SetTy>)) +
+             NumValues * 2 * (sizeof(void *) + sizeof(uint32_t));
+    auto Root = AliasSets.find(*AliasSets.lookup(&Values[0]));
+    UFCheckSum = AliasSets.getAliasSet(Root)->size();
+    UFPeak += AliasSets.getAliasSet(Root)->getMemorySize();
+  }
+
+  EXPECT_EQ(EagerCheckSum, UFCheckSum);
+
+  llvm::outs() << "Merging " << NumMerges << " times over " << NumValues
+               << " values:\n";
+  llvm::outs() << "  eager alias sets: " << millis(EagerTime) << "ms, peak "
+               << (EagerPeak >> 10) << "KiB\n";
+  llvm::outs() << "  union-find:       " << millis(UFTime) << "ms, peak "
+               << (UFPeak >> 10) << "KiB (incl. one materialized set)\n";
+}
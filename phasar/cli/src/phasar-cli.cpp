@@ -12,8 +12,10 @@
 #include "phasar/ControlFlow/CallGraphAnalysisType.h"
 #include "phasar/Controller/AnalysisController.h"
 #include "phasar/Controller/AnalysisControllerEmitterOptions.h"
+#include "phasar/DataFlow/IfdsIde/IFDSIDESolverConfig.h"
 #include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
 #include "phasar/PhasarLLVM/HelperAnalyses.h"
+#include "phasar/PhasarLLVM/HelperAnalysisConfig.h"
 #include "phasar/PhasarLLVM/Passes/GeneralStatisticsAnalysis.h"
 #include "phasar/PhasarLLVM/Utils/DataFlowAnalysisType.h"
 #include "phasar/Pointer/AliasAnalysisType.h"
@@ -92,6 +94,13 @@ cl::opt<AnalysisStrategy>
                 cl::init(AnalysisStrategy::WholeProgram), cl::cat(PsrCat),
                 cl::Hidden);
 
+cl::list<std::string> ModuleWiseModulesOpt(
+    "mwa-module",
+    cl::desc("Further LLVM IR module of the program that the module-wise "
+             "analysis (--analysis-strategy=MWA) analyzes together with "
+             "--module"),
+    cl::cat(PsrCat), cl::Hidden);
+
 cl::opt<std::string> AnalysisConfigOpt(
     "analysis-config",
     cl::desc("Set the analysis's configuration (if required)"),
@@ -112,6 +121,17 @@ cl::alias AliasTypeAlias("P", cl::aliasopt(AliasTypeOpt),
                          cl::desc("Alias for --alias-analysis"),
                          cl::cat(PsrCat));
 
+cl::opt<unsigned> PTAThreadsOpt(
+    "pta-threads",
+    cl::desc("The number of threads used to compute the alias sets of all "
+             "functions upfront"),
+    cl::init(1), cl::cat(PsrCat), cl::Hidden);
+
+cl::opt<unsigned> CGThreadsOpt(
+    "cg-threads",
+    cl::desc("The number of threads used to construct the call-graph"),
+    cl::init(1), cl::cat(PsrCat), cl::Hidden);
+
 cl::opt<CallGraphAnalysisType> CGTypeOpt(
     "call-graph-analysis", cl::desc("Set the call-graph algorithm to be used"),
     cl::values(
@@ -191,18 +211,24 @@ PSR_OPTION_FLAG(EmitTHAsDotOpt, "emit-th-as-dot",
                 "Emit the type hierarchy as DOT graph");
 PSR_OPTION_FLAG(EmitTHAsJsonOpt, "emit-th-as-json",
                 "Emit the type hierarchy as JSON");
+PSR_OPTION_FLAG(EmitTHAsBinaryOpt, "emit-th-as-binary",
+                "Emit the type hierarchy in a compact binary format");
 PSR_OPTION_FLAG(EmitCGAsTextOpt, "emit-cg-as-text",
                 "Emit the call graph as text");
 PSR_OPTION_FLAG(EmitCGAsDotOpt, "emit-cg-as-dot",
                 "Emit the call graph as DOT graph");
 PSR_OPTION_FLAG(EmitCGAsJsonOpt, "emit-cg-as-json",
                 "Emit the call graph as json");
+PSR_OPTION_FLAG(EmitCGAsBinaryOpt, "emit-cg-as-binary",
+                "Emit the call graph in a compact binary format");
 PSR_OPTION_FLAG(EmitPTAAsTextOpt, "emit-pta-as-text",
                 "Emit the points-to information as text");
 PSR_OPTION_FLAG(EmitPTAAsDotOpt, "emit-pta-as-dot",
                 "Emit the points-to information as DOT graph");
 PSR_OPTION_FLAG(EmitPTAAsJsonOpt, "emit-pta-as-json",
                 "Emit the points-to information as json");
+PSR_OPTION_FLAG(EmitPTAAsBinaryOpt, "emit-pta-as-binary",
+                "Emit the points-to information in a compact binary format");
 PSR_OPTION_FLAG(EmitStatsAsJsonOpt, "emit-statistics-as-json",
                 "Emit the statistics information as json");
 PSR_OPTION_FLAG(FollowReturnPastSeedsOpt, "follow-return-past-seeds",
@@ -222,9 +248,42 @@ PSR_OPTION_FLAG(
     "problem. This can have massive performance impact",
     cl::Hidden);
 PSR_OPTION_FLAG(PersistedSummariesOpt, "persisted-summaries",
-                "Let the IFDS/IDE Solver compute persisted procedure summaries "
-                "(Currently not supported)",
-                cl::Hidden);
+                "Reuse the IFDS/IDE procedure summaries persisted by previous "
+                "runs with the same output directory and analysis config and "
+                "persist the ones of all newly analyzed functions. Only "
+                "supported by analyses that do not report findings from "
+                "within their flow functions, e.g., ide-lca");
+cl::opt<unsigned> SolverThreadsOpt(
+    "solver-threads",
+    cl::desc("The number of threads the IFDS/IDE Solver uses to construct the "
+             "ESG. Analyses whose flow and edge functions are not "
+             "thread-safe are solved sequentially"),
+    cl::init(1), cl::cat(PsrCat), cl::Hidden);
+
+cl::opt<size_t> EFMemoCacheSizeOpt(
+    "ef-memo-cache-size",
+    cl::desc("The maximum number of compose and join results of edge "
+             "functions that the IDE Solver memoizes (0 = no memoization)"),
+    cl::init(0), cl::cat(PsrCat), cl::Hidden);
+
+cl::opt<unsigned> ConcurrentAnalysesOpt(
+    "concurrent-analyses",
+    cl::desc("The maximum number of data-flow analyses that run at the same "
+             "time. Each of them writes its results to its own sub-directory "
+             "of the output directory"),
+    cl::init(1), cl::cat(PsrCat), cl::Hidden);
+
+cl::opt<WorkListPolicy> WorkListPolicyOpt(
+    "worklist-policy",
+    cl::desc("The order in which the sequential IFDS/IDE Solver processes the "
+             "path edges"),
+    cl::values(
+#define WORKLIST_POLICY(NAME, CMDFLAG, DESC)                                   \
+  clEnumValN(WorkListPolicy::NAME, CMDFLAG, DESC),
+#include "phasar/DataFlow/IfdsIde/WorkListPolicy.def"
+        clEnumValN(WorkListPolicy::DepthFirst, "default",
+                   "Same as 'dfs'")),
+    cl::init(WorkListPolicy::DepthFirst), cl::cat(PsrCat), cl::Hidden);
 
 cl::opt<std::string>
     LoadPTAFromJsonOpt("load-pta-from-json",
@@ -238,6 +297,24 @@ cl::opt<std::string> LoadCGFromJsonOpt(
              "emit-cg-as-json from the given file"),
     cl::cat(PsrCat));
 
+cl::opt<std::string> LoadPTAFromBinaryOpt(
+    "load-pta-from-binary",
+    cl::desc("Load the points-to info previously exported via "
+             "emit-pta-as-binary from the given file"),
+    cl::cat(PsrCat));
+
+cl::opt<std::string> LoadCGFromBinaryOpt(
+    "load-cg-from-binary",
+    cl::desc("Load the call-graph previously exported via emit-cg-as-binary "
+             "from the given file"),
+    cl::cat(PsrCat));
+
+cl::opt<std::string> LoadTHFromBinaryOpt(
+    "load-th-from-binary",
+    cl::desc("Load the type hierarchy previously exported via "
+             "emit-th-as-binary from the given file"),
+    cl::cat(PsrCat));
+
 PSR_SHORTLONG_OPTION(PammOutOpt, std::string, "A", "pamm-out",
                      "Filename for PAMM's gathered data",
                      cl::init("PAMM_data.json"), cl::cat(PsrCat), cl::Hidden);
@@ -266,6 +343,20 @@ void validateParamModule() {
   }
 }
 
+void validateParamModuleWise() {
+  if (StrategyOpt != AnalysisStrategy::ModuleWise) {
+    return;
+  }
+  for (const auto &Module : ModuleWiseModulesOpt) {
+    if (!std::filesystem::exists(Module) ||
+        std::filesystem::is_directory(Module)) {
+      llvm::errs() << "LLVM module '" << std::filesystem::absolute(Module)
+                   << "' does not exist!\n";
+      exit(1);
+    }
+  }
+}
+
 void validateParamOutput() {
   if (!OutDirOpt.empty() &&
       !std::filesystem::is_directory(OutDirOpt.getValue())) {
@@ -359,6 +450,7 @@ int main(int Argc, const char **Argv) {
   }
 
   validateParamModule();
+  validateParamModuleWise();
   validateParamOutput();
   validateParamPointerAnalysis();
   validateParamCallGraphAnalysis();
@@ -396,12 +488,18 @@ int main(int Argc, const char **Argv) {
   if (EmitTHAsJsonOpt) {
     EmitterOptions |= AnalysisControllerEmitterOptions::EmitTHAsJson;
   }
+  if (EmitTHAsBinaryOpt) {
+    EmitterOptions |= AnalysisControllerEmitterOptions::EmitTHAsBinary;
+  }
   if (EmitCGAsDotOpt) {
     EmitterOptions |= AnalysisControllerEmitterOptions::EmitCGAsDot;
   }
   if (EmitCGAsJsonOpt) {
     EmitterOptions |= AnalysisControllerEmitterOptions::EmitCGAsJson;
   }
+  if (EmitCGAsBinaryOpt) {
+    EmitterOptions |= AnalysisControllerEmitterOptions::EmitCGAsBinary;
+  }
   if (EmitCGAsTextOpt) {
     llvm::errs()
         << "ERROR: emit-cg-as-text is currently not supported. Did you mean "
@@ -417,6 +515,9 @@ int main(int Argc, const char **Argv) {
   if (EmitPTAAsJsonOpt) {
     EmitterOptions |= AnalysisControllerEmitterOptions::EmitPTAAsJson;
   }
+  if (EmitPTAAsBinaryOpt) {
+    EmitterOptions |= AnalysisControllerEmitterOptions::EmitPTAAsBinary;
+  }
   if (StatisticsOpt) {
     EmitterOptions |= AnalysisControllerEmitterOptions::EmitStatisticsAsText;
   }
@@ -430,6 +531,9 @@ int main(int Argc, const char **Argv) {
   SolverConfig.setRecordEdges(RecordEdgesOpt || EmitESGAsDotOpt);
   SolverConfig.setComputePersistedSummaries(PersistedSummariesOpt);
   SolverConfig.setEmitESG(EmitESGAsDotOpt);
+  SolverConfig.setNumThreads(SolverThreadsOpt);
+  SolverConfig.setWorkListPolicy(WorkListPolicyOpt);
+  SolverConfig.setEdgeFunctionMemoCacheSize(EFMemoCacheSizeOpt);
 
   std::optional<nlohmann::json> PrecomputedAliasSet;
   if (!LoadPTAFromJsonOpt.empty()) {
@@ -447,15 +551,34 @@ int main(int Argc, const char **Argv) {
     EntryOpt.push_back("main");
   }
 
+  HelperAnalysisConfig HAConfig;
+  HAConfig.PrecomputedPTS = std::move(PrecomputedAliasSet);
+  HAConfig.PrecomputedCG = std::move(PrecomputedCallGraph);
+  HAConfig.PrecomputedPTSBinaryFile = LoadPTAFromBinaryOpt.getValue();
+  HAConfig.PrecomputedCGBinaryFile = LoadCGFromBinaryOpt.getValue();
+  HAConfig.PrecomputedTHBinaryFile = LoadTHFromBinaryOpt.getValue();
+  HAConfig.PTATy = AliasTypeOpt;
+  HAConfig.CGTy = CGTypeOpt;
+  HAConfig.SoundnessLevel = SoundnessOpt;
+  HAConfig.AutoGlobalSupport = AutoGlobalsOpt;
+  HAConfig.AllowLazyPTS = !AnalysisController::needsToEmitPTA(EmitterOptions);
+  HAConfig.NumPTAThreads = PTAThreadsOpt;
+  HAConfig.NumCGThreads = CGThreadsOpt;
+
+  std::vector<std::string> ModuleFiles;
+  if (StrategyOpt == AnalysisStrategy::ModuleWise) {
+    ModuleFiles.push_back(ModuleOpt.getValue());
+    ModuleFiles.insert(ModuleFiles.end(), ModuleWiseModulesOpt.begin(),
+                       ModuleWiseModulesOpt.end());
+  }
+
   // setup IRDB as source code manager
-  HelperAnalyses HA(std::move(ModuleOpt.getValue()),
-                    std::move(PrecomputedAliasSet), AliasTypeOpt,
-                    !AnalysisController::needsToEmitPTA(EmitterOptions),
-                    EntryOpt, std::move(PrecomputedCallGraph), CGTypeOpt,
-                    SoundnessOpt, AutoGlobalsOpt);
+  HelperAnalyses HA(std::move(ModuleOpt.getValue()), EntryOpt,
+                    std::move(HAConfig));
 
   AnalysisController Controller(
       HA, DataFlowAnalysisOpt, {AnalysisConfigOpt.getValue()}, EntryOpt,
-      StrategyOpt, EmitterOptions, SolverConfig, ProjectIdOpt, OutDirOpt);
+      StrategyOpt, EmitterOptions, SolverConfig, ProjectIdOpt, OutDirOpt,
+      ConcurrentAnalysesOpt, std::move(ModuleFiles));
   return 0;
 }
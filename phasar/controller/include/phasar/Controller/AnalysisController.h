@@ -10,6 +10,9 @@
 #ifndef PHASAR_CONTROLLER_ANALYSISCONTROLLER_H
 #define PHASAR_CONTROLLER_ANALYSISCONTROLLER_H
 
+#include "phasar/AnalysisStrategy/FunctionSummaries.h"
+#include "phasar/AnalysisStrategy/ModuleWiseAnalysis.h"
+#include "phasar/AnalysisStrategy/PersistedSummaryStore.h"
 #include "phasar/AnalysisStrategy/Strategies.h"
 #include "phasar/Controller/AnalysisControllerEmitterOptions.h"
 #include "phasar/DataFlow/IfdsIde/IFDSIDESolverConfig.h"
@@ -28,10 +31,19 @@
 #include "phasar/PhasarLLVM/Utils/DataFlowAnalysisType.h"
 #include "phasar/Utils/EnumFlags.h"
 #include "phasar/Utils/IO.h"
+#include "phasar/Utils/Logger.h"
 #include "phasar/Utils/Soundness.h"
 
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/TypeName.h"
+
+#include <filesystem>
+#include <mutex>
 #include <set>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace psr {
@@ -42,12 +54,25 @@ private:
   std::vector<DataFlowAnalysisType> DataFlowAnalyses;
   std::vector<std::string> AnalysisConfigs;
   std::vector<std::string> EntryPoints;
-  [[maybe_unused]] AnalysisStrategy Strategy;
+  AnalysisStrategy Strategy;
   AnalysisControllerEmitterOptions EmitterOptions =
       AnalysisControllerEmitterOptions::None;
   std::string ProjectID;
   std::filesystem::path ResultDirectory;
   IFDSIDESolverConfig SolverConfig;
+  unsigned NumConcurrentAnalyses = 1;
+  /// The LLVM IR modules that make up the program, if it is analyzed
+  /// module-wise
+  std::vector<std::string> ModuleFiles;
+
+  /// Serializes the results that are written to stdout
+  std::mutex OutputMtx;
+
+  /// The directory, the data-flow analysis that currently runs on this thread
+  /// writes its results to. Equals ResultDirectory, unless the data-flow
+  /// analyses run concurrently, where each of them gets its own
+  /// sub-directory.
+  static thread_local std::filesystem::path DataFlowResultDirectory;
 
   ///
   /// \brief The maximum length of the CallStrings used in the InterMonoSolver
@@ -64,6 +89,11 @@ private:
 
   void executeWholeProgram();
 
+  /// Runs the DataFlowAnalyses on up to NumConcurrentAnalyses threads
+  void executeWholeProgramConcurrently();
+
+  void executeDataFlowAnalysis(DataFlowAnalysisType DataFlowAnalysis);
+
   void emitRequestedHelperAnalysisResults();
 
   void executeIFDSUninitVar();
@@ -85,6 +115,10 @@ private:
 
   template <typename SolverTy, typename ProblemTy, typename... ArgTys>
   void executeMonoAnalysis(ArgTys &&...Args) {
+    if (Strategy == AnalysisStrategy::ModuleWise) {
+      llvm::report_fatal_error(llvm::getTypeName<ProblemTy>() +
+                               " does not support the module-wise analysis");
+    }
     auto Problem =
         createAnalysisProblem<ProblemTy>(HA, std::forward<ArgTys>(Args)...);
     SolverTy Solver(Problem);
@@ -104,15 +138,152 @@ private:
         std::forward<ArgTys>(Args)...);
   }
 
+  /// Applies the requested SolverConfig to a Problem that has been created on
+  /// TargetHA
+  template <typename ProblemTy>
+  void applySolverConfig(ProblemTy &Problem, HelperAnalyses &TargetHA) {
+    Problem.getIFDSIDESolverConfig().setNumThreads(SolverConfig.numThreads());
+    if (SolverConfig.numThreads() > 1 && Problem.supportsParallelSolving()) {
+      // The solver threads query the alias information concurrently
+      TargetHA.prepareForConcurrentAccess();
+    }
+    Problem.getIFDSIDESolverConfig().setWorkListPolicy(
+        SolverConfig.workListPolicy());
+    Problem.getIFDSIDESolverConfig().setEdgeFunctionMemoCacheSize(
+        SolverConfig.edgeFunctionMemoCacheSize());
+  }
+
   template <typename SolverTy, typename ProblemTy, typename... ArgTys>
   void executeIfdsIdeAnalysis(ArgTys &&...Args) {
-    auto Problem =
-        createAnalysisProblem<ProblemTy>(HA, std::forward<ArgTys>(Args)...);
+    if (Strategy == AnalysisStrategy::ModuleWise) {
+      executeModuleWiseAnalysis<ProblemTy>();
+      return;
+    }
+
+    auto Problem = createAnalysisProblem<ProblemTy>(HA, Args...);
+    applySolverConfig(Problem, HA);
+
+    if (SolverConfig.computePersistedSummaries()) {
+      if constexpr (SupportsFunctionSummaries<
+                        typename ProblemTy::ProblemAnalysisDomain>) {
+        if (Problem.supportsFunctionSummaries()) {
+          executeWithPersistedSummaries<ProblemTy>(Problem, Args...);
+          return;
+        }
+      }
+      // The findings inside summarized callees would silently get lost
+      llvm::report_fatal_error(llvm::getTypeName<ProblemTy>() +
+                               " does not support persisted summaries");
+    }
+
     SolverTy Solver(Problem, &HA.getICFG());
     Solver.solve();
     emitRequestedDataFlowResults(Solver);
   }
 
+  /// Solves the problem reusing the summaries of the persisted summary store
+  /// of this analysis and configuration, then adds the summaries of all
+  /// functions that are not yet in the store. Calls to summarized functions
+  /// are not analyzed again, so there are no results inside these functions.
+  template <typename ProblemTy, typename... ArgTys>
+  void executeWithPersistedSummaries(ProblemTy &Problem,
+                                     const ArgTys &...Args) {
+    using l_t = typename ProblemTy::l_t;
+    auto AnalysisId = getPersistedSummaryId(llvm::getTypeName<ProblemTy>());
+    auto StoreFile = getPersistedSummaryFile(AnalysisId);
+    PersistedSummaryStore<l_t> Store(AnalysisId);
+    Store.load(StoreFile);
+    FunctionSummaryKeys Keys(HA.getICFG());
+
+    detail::SummaryImportingProblem<typename ProblemTy::ProblemAnalysisDomain,
+                                    typename ProblemTy::container_type>
+        Importing(Problem, makePersistedSummaryLookup(Store, Keys));
+    IDESolver_P<ProblemTy> Solver(Importing, &HA.getICFG());
+    Solver.solve();
+    emitRequestedDataFlowResults(Solver);
+
+    // Keep the state of Problem intact for the emitted results
+    auto SummaryProblem = createAnalysisProblem<ProblemTy>(HA, Args...);
+    if (computePersistedSummaries(SummaryProblem, HA.getICFG(), Store, Keys)) {
+      Store.write(StoreFile);
+    }
+  }
+
+  /// Analyzes the ModuleFiles one at a time, see ModuleWiseAnalysis. The
+  /// problem is created on each module from the entry points that the module
+  /// defines, so only problems that do not require further arguments are
+  /// supported. The results of each module are written to a sub-directory of
+  /// the result directory that is named after the module.
+  template <typename ProblemTy> void executeModuleWiseAnalysis() {
+    using DomainTy = typename ProblemTy::ProblemAnalysisDomain;
+    if constexpr (SupportsFunctionSummaries<DomainTy> &&
+                  std::is_constructible_v<ProblemTy, const LLVMProjectIRDB *,
+                                          const LLVMBasedICFG *,
+                                          std::vector<std::string>> &&
+                  std::is_move_constructible_v<ProblemTy>) {
+      auto Factory = [this](HelperAnalyses &ModHA,
+                            std::vector<std::string> ModEntryPoints) {
+        auto Problem =
+            createAnalysisProblem<ProblemTy>(ModHA, std::move(ModEntryPoints));
+        if (!Problem.supportsFunctionSummaries()) {
+          llvm::report_fatal_error(llvm::getTypeName<ProblemTy>() +
+                                   " does not support function summaries");
+        }
+        applySolverConfig(Problem, ModHA);
+        return Problem;
+      };
+      auto Handler = [this](HelperAnalyses &ModHA, ProblemTy &Problem,
+                            const auto &Results) {
+        DataFlowResultDirectory.clear();
+        if (!ResultDirectory.empty()) {
+          auto ModuleName = ModHA.getProjectIRDB().getModule()->getName();
+          DataFlowResultDirectory =
+              ResultDirectory /
+              std::filesystem::path(ModuleName.str()).stem();
+          std::filesystem::create_directory(DataFlowResultDirectory);
+        }
+        ModuleResults<ProblemTy, std::decay_t<decltype(Results)>> Solver{
+            Problem, ModHA.getICFG(), Results};
+        emitRequestedDataFlowResults(Solver);
+      };
+
+      ModuleWiseAnalysis<DomainTy, typename ProblemTy::container_type> MWA(
+          ModuleFiles, EntryPoints, {}, NumConcurrentAnalyses);
+      MWA.run(Factory, Handler);
+      DataFlowResultDirectory = ResultDirectory;
+    } else {
+      llvm::report_fatal_error(llvm::getTypeName<ProblemTy>() +
+                               " does not support the module-wise analysis");
+    }
+  }
+
+  /// Presents the results of one module of the module-wise analysis like a
+  /// solver to emitRequestedDataFlowResults()
+  template <typename ProblemTy, typename ResultsTy> struct ModuleResults {
+    ProblemTy &Problem;
+    const LLVMBasedICFG &ICF;
+    const ResultsTy &Results;
+
+    void emitTextReport(llvm::raw_ostream &OS) {
+      Problem.emitTextReport(Results, OS);
+    }
+    void emitGraphicalReport(llvm::raw_ostream &OS) {
+      Problem.emitGraphicalReport(Results, OS);
+    }
+    void dumpResults(llvm::raw_ostream &OS) {
+      Results.dumpResults(ICF, Problem, OS);
+    }
+  };
+
+  /// Identifies the persisted summaries of the analysis AnalysisName together
+  /// with the contents of the AnalysisConfigs, such that summaries are never
+  /// reused across different configurations.
+  [[nodiscard]] std::string
+  getPersistedSummaryId(llvm::StringRef AnalysisName) const;
+
+  [[nodiscard]] std::string
+  getPersistedSummaryFile(llvm::StringRef AnalysisId) const;
+
   template <typename ProblemTy, typename... ArgTys>
   void executeIFDSAnalysis(ArgTys &&...Args) {
     executeIfdsIdeAnalysis<IFDSSolver_P<ProblemTy>, ProblemTy>(
@@ -128,44 +299,49 @@ private:
   LLVMTaintConfig makeTaintConfig();
 
   template <typename T> void emitRequestedDataFlowResults(T &Solver) {
-    if (EmitterOptions & AnalysisControllerEmitterOptions::EmitTextReport) {
-      if (!ResultDirectory.empty()) {
-        if (auto OFS =
-                openFileStream(ResultDirectory.string() + "/psr-report.txt")) {
-          Solver.emitTextReport(*OFS);
+    auto WithResultFileOrStdout = [this](const char *FileName, auto Callback) {
+      if (!DataFlowResultDirectory.empty()) {
+        if (auto OFS = openFileStream(
+                (DataFlowResultDirectory / FileName).string())) {
+          Callback(*OFS);
         }
       } else {
-        Solver.emitTextReport(llvm::outs());
+        std::lock_guard Lck(OutputMtx);
+        Callback(llvm::outs());
       }
+    };
+
+    if (EmitterOptions & AnalysisControllerEmitterOptions::EmitTextReport) {
+      WithResultFileOrStdout("psr-report.txt",
+                             [&Solver](auto &OS) { Solver.emitTextReport(OS); });
     }
     if (EmitterOptions &
         AnalysisControllerEmitterOptions::EmitGraphicalReport) {
-      if (!ResultDirectory.empty()) {
-        if (auto OFS =
-                openFileStream(ResultDirectory.string() + "/psr-report.html")) {
-          Solver.emitGraphicalReport(*OFS);
-        }
-      } else {
-        Solver.emitGraphicalReport(llvm::outs());
-      }
+      WithResultFileOrStdout("psr-report.html", [&Solver](auto &OS) {
+        Solver.emitGraphicalReport(OS);
+      });
     }
     if (EmitterOptions & AnalysisControllerEmitterOptions::EmitRawResults) {
-      if (!ResultDirectory.empty()) {
-        if (auto OFS = openFileStream(ResultDirectory.string() +
-                                      "/psr-raw-results.txt")) {
-          Solver.dumpResults(*OFS);
-        }
-      } else {
-        Solver.dumpResults(llvm::outs());
-      }
+      WithResultFileOrStdout("psr-raw-results.txt",
+                             [&Solver](auto &OS) { Solver.dumpResults(OS); });
     }
     if (EmitterOptions & AnalysisControllerEmitterOptions::EmitESGAsDot) {
+      std::lock_guard Lck(OutputMtx);
       llvm::outs()
           << "Front-end support for 'EmitESGAsDot' to be implemented\n";
     }
   }
 
 public:
+  /// Runs the requested analyses on the given helper analyses.
+  ///
+  /// If NumConcurrentAnalyses is greater than one, the whole-program
+  /// data-flow analyses run on up to NumConcurrentAnalyses threads at the same
+  /// time and write their results to one sub-directory of the result
+  /// directory each. The analyses then share the helper analyses read-only.
+  ///
+  /// The module-wise analysis strategy analyzes the ModuleFiles instead of the
+  /// module of the helper analyses; they must contain that module, too.
   explicit AnalysisController(
       HelperAnalyses &HA, std::vector<DataFlowAnalysisType> DataFlowAnalyses,
       std::vector<std::string> AnalysisConfigs,
@@ -173,7 +349,8 @@ public:
       AnalysisControllerEmitterOptions EmitterOptions,
       IFDSIDESolverConfig SolverConfig,
       std::string ProjectID = "default-phasar-project",
-      std::string OutDirectory = "");
+      std::string OutDirectory = "", unsigned NumConcurrentAnalyses = 1,
+      std::vector<std::string> ModuleFiles = {});
 
   ~AnalysisController() = default;
 
@@ -188,6 +365,8 @@ public:
   needsToEmitPTA(AnalysisControllerEmitterOptions EmitterOptions) {
     return (EmitterOptions & AnalysisControllerEmitterOptions::EmitPTAAsDot) ||
            (EmitterOptions & AnalysisControllerEmitterOptions::EmitPTAAsJson) ||
+           (EmitterOptions &
+            AnalysisControllerEmitterOptions::EmitPTAAsBinary) ||
            (EmitterOptions & AnalysisControllerEmitterOptions::EmitPTAAsText);
   }
 };
@@ -29,6 +29,9 @@ enum class AnalysisControllerEmitterOptions {
   EmitPTAAsJson = (1 << 13),
   EmitStatisticsAsText = (1 << 14),
   EmitStatisticsAsJson = (1 << 15),
+  EmitTHAsBinary = (1 << 16),
+  EmitCGAsBinary = (1 << 17),
+  EmitPTAAsBinary = (1 << 18),
 };
 } // namespace psr
 
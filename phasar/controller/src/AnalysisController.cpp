@@ -16,32 +16,43 @@
 #include "phasar/PhasarLLVM/HelperAnalyses.h"
 #include "phasar/PhasarLLVM/Passes/GeneralStatisticsAnalysis.h"
 #include "phasar/PhasarLLVM/Utils/DataFlowAnalysisType.h"
+#include "phasar/Utils/IO.h"
 #include "phasar/Utils/NlohmannLogging.h"
 #include "phasar/Utils/Utilities.h"
 
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/xxhash.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <filesystem>
 #include <functional>
 #include <set>
+#include <thread>
 #include <utility>
 
 namespace psr {
 
+thread_local std::filesystem::path AnalysisController::DataFlowResultDirectory;
+
 AnalysisController::AnalysisController(
     HelperAnalyses &HA, std::vector<DataFlowAnalysisType> DataFlowAnalyses,
     std::vector<std::string> AnalysisConfigs,
     std::vector<std::string> EntryPoints, AnalysisStrategy Strategy,
     AnalysisControllerEmitterOptions EmitterOptions,
     IFDSIDESolverConfig SolverConfig, std::string ProjectID,
-    std::string OutDirectory)
+    std::string OutDirectory, unsigned NumConcurrentAnalyses,
+    std::vector<std::string> ModuleFiles)
     : HA(HA), DataFlowAnalyses(std::move(DataFlowAnalyses)),
       AnalysisConfigs(std::move(AnalysisConfigs)),
       EntryPoints(std::move(EntryPoints)), Strategy(Strategy),
       EmitterOptions(EmitterOptions), ProjectID(std::move(ProjectID)),
-      ResultDirectory(std::move(OutDirectory)), SolverConfig(SolverConfig) {
+      ResultDirectory(std::move(OutDirectory)), SolverConfig(SolverConfig),
+      NumConcurrentAnalyses(std::max(NumConcurrentAnalyses, 1U)),
+      ModuleFiles(std::move(ModuleFiles)) {
   if (!ResultDirectory.empty()) {
     // create directory for results
     ResultDirectory /= this->ProjectID + "-" + createTimeStamp();
@@ -52,15 +63,18 @@ AnalysisController::AnalysisController(
 }
 
 void AnalysisController::executeAs(AnalysisStrategy Strategy) {
+  this->Strategy = Strategy;
   switch (Strategy) {
   case AnalysisStrategy::None:
     return;
   case AnalysisStrategy::DemandDriven:
   case AnalysisStrategy::Incremental:
-  case AnalysisStrategy::ModuleWise:
   case AnalysisStrategy::Variational:
     llvm::report_fatal_error("AnalysisStrategy not supported, yet!");
     return;
+  case AnalysisStrategy::ModuleWise:
+    executeModuleWise();
+    return;
   case AnalysisStrategy::WholeProgram:
     executeWholeProgram();
     return;
@@ -69,72 +83,164 @@ void AnalysisController::executeAs(AnalysisStrategy Strategy) {
       "All AnalysisStrategy variants should be handled in the switch above!");
 }
 
+std::string
+AnalysisController::getPersistedSummaryId(llvm::StringRef AnalysisName) const {
+  std::string Id = AnalysisName.str();
+  for (const auto &ConfigFile : AnalysisConfigs) {
+    // Changing the contents of a config file must invalidate the summaries
+    // as well, so hash the contents instead of the path
+    Id += '\n';
+    if (auto Buf = readFileOrNull(ConfigFile)) {
+      Id += llvm::utohexstr(llvm::xxHash64(Buf->getBuffer()));
+    } else {
+      Id += ConfigFile;
+    }
+  }
+  return Id;
+}
+
+std::string
+AnalysisController::getPersistedSummaryFile(llvm::StringRef AnalysisId) const {
+  // The summaries are shared by all runs with the same output directory
+  auto Dir = ResultDirectory.empty() ? std::filesystem::current_path()
+                                     : ResultDirectory.parent_path();
+  auto FileName =
+      "psr-summaries-" + llvm::utohexstr(llvm::xxHash64(AnalysisId)) + ".bin";
+  return (Dir / FileName).string();
+}
+
 void AnalysisController::executeDemandDriven() {}
 
 void AnalysisController::executeIncremental() {}
 
-void AnalysisController::executeModuleWise() {}
+void AnalysisController::executeModuleWise() {
+  if (ModuleFiles.empty()) {
+    llvm::report_fatal_error(
+        "The module-wise analysis requires the modules of the program");
+  }
+
+  // The data-flow analyses are created per module in
+  // executeModuleWiseAnalysis()
+  DataFlowResultDirectory = ResultDirectory;
+  for (auto DataFlowAnalysis : DataFlowAnalyses) {
+    executeDataFlowAnalysis(DataFlowAnalysis);
+  }
+}
 
 void AnalysisController::executeVariational() {}
 
 void AnalysisController::executeWholeProgram() {
+  if (NumConcurrentAnalyses > 1 && DataFlowAnalyses.size() > 1) {
+    executeWholeProgramConcurrently();
+    return;
+  }
+
+  DataFlowResultDirectory = ResultDirectory;
   for (auto DataFlowAnalysis : DataFlowAnalyses) {
-    switch (DataFlowAnalysis) {
-    case DataFlowAnalysisType::None:
-      continue;
-    case DataFlowAnalysisType::IFDSUninitializedVariables:
-      executeIFDSUninitVar();
-      continue;
-    case DataFlowAnalysisType::IFDSConstAnalysis:
-      executeIFDSConst();
-      continue;
-    case DataFlowAnalysisType::IFDSTaintAnalysis:
-      executeIFDSTaint();
-      continue;
-    case DataFlowAnalysisType::IDEExtendedTaintAnalysis:
-      executeIDEXTaint();
-      continue;
-    case DataFlowAnalysisType::IDEOpenSSLTypeStateAnalysis:
-      executeIDEOpenSSLTS();
-      continue;
-    case DataFlowAnalysisType::IDECSTDIOTypeStateAnalysis:
-      executeIDECSTDIOTS();
-      continue;
-    case DataFlowAnalysisType::IFDSTypeAnalysis:
-      executeIFDSType();
-      continue;
-    case DataFlowAnalysisType::IFDSSolverTest:
-      executeIFDSSolverTest();
-      continue;
-    case DataFlowAnalysisType::IFDSFieldSensTaintAnalysis:
-      executeIFDSFieldSensTaint();
-      continue;
-    case DataFlowAnalysisType::IDELinearConstantAnalysis:
-      executeIDELinearConst();
-      continue;
-    case DataFlowAnalysisType::IDESolverTest:
-      executeIDESolverTest();
-      continue;
-    case DataFlowAnalysisType::IDEInstInteractionAnalysis:
-      executeIDEIIA();
-      continue;
-    case DataFlowAnalysisType::IntraMonoFullConstantPropagation:
-      executeIntraMonoFullConstant();
-      continue;
-    case DataFlowAnalysisType::IntraMonoSolverTest:
-      executeIntraMonoSolverTest();
-      continue;
-    case DataFlowAnalysisType::InterMonoSolverTest:
-      executeInterMonoSolverTest();
-      continue;
-    case DataFlowAnalysisType::InterMonoTaintAnalysis:
-      executeInterMonoTaint();
-      continue;
+    executeDataFlowAnalysis(DataFlowAnalysis);
+  }
+}
+
+void AnalysisController::executeWholeProgramConcurrently() {
+  // Construct all helper analyses upfront, such that the data-flow analyses
+  // only read them
+  HA.prepareForConcurrentAccess();
+
+  // Each analysis writes its results into its own sub-directory
+  std::vector<std::filesystem::path> ResultDirs(DataFlowAnalyses.size());
+  if (!ResultDirectory.empty()) {
+    for (size_t Idx = 0, End = DataFlowAnalyses.size(); Idx != End; ++Idx) {
+      auto Dir = ResultDirectory / toString(DataFlowAnalyses[Idx]);
+      if (!std::filesystem::create_directory(Dir)) {
+        // The same analysis is requested multiple times
+        Dir += "-" + std::to_string(Idx);
+        std::filesystem::create_directory(Dir);
+      }
+      ResultDirs[Idx] = std::move(Dir);
+    }
+  }
+
+  std::atomic_size_t NextAnalysis = 0;
+  auto RunAnalyses = [this, &ResultDirs, &NextAnalysis] {
+    for (size_t Idx = NextAnalysis++; Idx < DataFlowAnalyses.size();
+         Idx = NextAnalysis++) {
+      PHASAR_LOG_LEVEL(INFO, "Start data-flow analysis "
+                                 << DataFlowAnalyses[Idx]);
+      DataFlowResultDirectory = ResultDirs[Idx];
+      executeDataFlowAnalysis(DataFlowAnalyses[Idx]);
     }
+  };
 
-    llvm_unreachable("All possible DataFlowAnalysisType variants should be "
-                     "handled in the switch above!");
+  auto NumThreads =
+      std::min(size_t(NumConcurrentAnalyses), DataFlowAnalyses.size());
+  std::vector<std::thread> Threads;
+  Threads.reserve(NumThreads - 1);
+  for (size_t I = 1; I < NumThreads; ++I) {
+    Threads.emplace_back(RunAnalyses);
+  }
+  RunAnalyses();
+  for (auto &Thread : Threads) {
+    Thread.join();
+  }
+}
+
+void AnalysisController::executeDataFlowAnalysis(
+    DataFlowAnalysisType DataFlowAnalysis) {
+  switch (DataFlowAnalysis) {
+  case DataFlowAnalysisType::None:
+    return;
+  case DataFlowAnalysisType::IFDSUninitializedVariables:
+    executeIFDSUninitVar();
+    return;
+  case DataFlowAnalysisType::IFDSConstAnalysis:
+    executeIFDSConst();
+    return;
+  case DataFlowAnalysisType::IFDSTaintAnalysis:
+    executeIFDSTaint();
+    return;
+  case DataFlowAnalysisType::IDEExtendedTaintAnalysis:
+    executeIDEXTaint();
+    return;
+  case DataFlowAnalysisType::IDEOpenSSLTypeStateAnalysis:
+    executeIDEOpenSSLTS();
+    return;
+  case DataFlowAnalysisType::IDECSTDIOTypeStateAnalysis:
+    executeIDECSTDIOTS();
+    return;
+  case DataFlowAnalysisType::IFDSTypeAnalysis:
+    executeIFDSType();
+    return;
+  case DataFlowAnalysisType::IFDSSolverTest:
+    executeIFDSSolverTest();
+    return;
+  case DataFlowAnalysisType::IFDSFieldSensTaintAnalysis:
+    executeIFDSFieldSensTaint();
+    return;
+  case DataFlowAnalysisType::IDELinearConstantAnalysis:
+    executeIDELinearConst();
+    return;
+  case DataFlowAnalysisType::IDESolverTest:
+    executeIDESolverTest();
+    return;
+  case DataFlowAnalysisType::IDEInstInteractionAnalysis:
+    executeIDEIIA();
+    return;
+  case DataFlowAnalysisType::IntraMonoFullConstantPropagation:
+    executeIntraMonoFullConstant();
+    return;
+  case DataFlowAnalysisType::IntraMonoSolverTest:
+    executeIntraMonoSolverTest();
+    return;
+  case DataFlowAnalysisType::InterMonoSolverTest:
+    executeInterMonoSolverTest();
+    return;
+  case DataFlowAnalysisType::InterMonoTaintAnalysis:
+    executeInterMonoTaint();
+    return;
   }
+
+  llvm_unreachable("All possible DataFlowAnalysisType variants should be "
+                   "handled in the switch above!");
 }
 
 void AnalysisController::emitRequestedHelperAnalysisResults() {
@@ -167,6 +273,11 @@ void AnalysisController::emitRequestedHelperAnalysisResults() {
       HA.getTypeHierarchy().printAsJson(OS);
     });
   }
+  if (EmitterOptions & AnalysisControllerEmitterOptions::EmitTHAsBinary) {
+    WithResultFileOrStdout("/psr-th.bin", [this](auto &OS) {
+      HA.getTypeHierarchy().writeBinary(HA.getProjectIRDB(), OS);
+    });
+  }
   if (EmitterOptions & AnalysisControllerEmitterOptions::EmitPTAAsText) {
     WithResultFileOrStdout("/psr-pta.txt",
                            [this](auto &OS) { HA.getAliasInfo().print(OS); });
@@ -180,6 +291,11 @@ void AnalysisController::emitRequestedHelperAnalysisResults() {
       HA.getAliasInfo().printAsJson(OS);
     });
   }
+  if (EmitterOptions & AnalysisControllerEmitterOptions::EmitPTAAsBinary) {
+    WithResultFileOrStdout("/psr-pta.bin", [this](auto &OS) {
+      HA.getAliasInfo().writeBinary(OS);
+    });
+  }
 
   if (EmitterOptions & AnalysisControllerEmitterOptions::EmitCGAsDot) {
     WithResultFileOrStdout("/psr-cg.txt",
@@ -189,6 +305,10 @@ void AnalysisController::emitRequestedHelperAnalysisResults() {
     WithResultFileOrStdout(
         "/psr-cg.json", [this](auto &OS) { OS << HA.getICFG().getAsJson(); });
   }
+  if (EmitterOptions & AnalysisControllerEmitterOptions::EmitCGAsBinary) {
+    WithResultFileOrStdout("/psr-cg.bin",
+                           [this](auto &OS) { HA.getICFG().writeBinary(OS); });
+  }
 
   if (EmitterOptions &
       (AnalysisControllerEmitterOptions::EmitStatisticsAsJson |
@@ -613,6 +613,13 @@ public:
   /// comparisons of object-identity. Do not dereference!
   [[nodiscard]] const void *getOpaqueValue() const noexcept { return EF; }
 
+  /// True, iff this and Other hold the very same edge function object, i.e.,
+  /// one is a copy of the other. Implies *this == Other, but is much cheaper
+  /// to check.
+  [[nodiscard]] bool referenceEquals(const EdgeFunction &Other) const noexcept {
+    return EF == Other.EF && VTAndHeapAlloc == Other.VTAndHeapAlloc;
+  }
+
   /// Gets the cache where this edge function is being cached in. If this edge
   /// function is not cached (i.e., isCached() returns false), returns nullptr.
   /// Assumes that the held edge function is *exactly* of type ConcreteEF. In
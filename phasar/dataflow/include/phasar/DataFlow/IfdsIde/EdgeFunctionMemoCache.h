@@ -0,0 +1,194 @@
+/******************************************************************************
+ * Copyright (c) 2023 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_DATAFLOW_IFDSIDE_EDGEFUNCTIONMEMOCACHE_H
+#define PHASAR_DATAFLOW_IFDSIDE_EDGEFUNCTIONMEMOCACHE_H
+
+#include "phasar/DataFlow/IfdsIde/EdgeFunction.h"
+
+#include "llvm/Support/Format.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace psr {
+
+/// The number of lookups into an EdgeFunctionMemoCache that were answered
+/// from the cache (hits) and that had to call compose()/join() (misses).
+struct EdgeFunctionMemoStats {
+  size_t ComposeHits = 0;
+  size_t ComposeMisses = 0;
+  size_t JoinHits = 0;
+  size_t JoinMisses = 0;
+
+  [[nodiscard]] static double hitRate(size_t Hits, size_t Misses) noexcept {
+    return Hits + Misses ? double(Hits) / double(Hits + Misses) : 0.0;
+  }
+  [[nodiscard]] double composeHitRate() const noexcept {
+    return hitRate(ComposeHits, ComposeMisses);
+  }
+  [[nodiscard]] double joinHitRate() const noexcept {
+    return hitRate(JoinHits, JoinMisses);
+  }
+
+  EdgeFunctionMemoStats &operator+=(const EdgeFunctionMemoStats &Other) {
+    ComposeHits += Other.ComposeHits;
+    ComposeMisses += Other.ComposeMisses;
+    JoinHits += Other.JoinHits;
+    JoinMisses += Other.JoinMisses;
+    return *this;
+  }
+
+  friend llvm::raw_ostream &operator<<(llvm::raw_ostream &OS,
+                                       const EdgeFunctionMemoStats &Stats) {
+    return OS << "compose: " << Stats.ComposeHits << " hits, "
+              << Stats.ComposeMisses << " misses ("
+              << llvm::format("%.1f%%", Stats.composeHitRate() * 100)
+              << "); join: " << Stats.JoinHits << " hits, " << Stats.JoinMisses
+              << " misses ("
+              << llvm::format("%.1f%%", Stats.joinHitRate() * 100) << ")";
+  }
+};
+
+/// A bounded memo table for the results of EdgeFunction::compose() and
+/// EdgeFunction::join(), keyed by the identity of the two operands (see
+/// EdgeFunction::referenceEquals()).
+///
+/// The table is direct-mapped: Each pair of operands has exactly one slot and
+/// a new result simply replaces the one that occupied the slot before. So,
+/// the cache never holds more than its capacity of results, and a lookup
+/// costs one hash and at most two identity comparisons. Since a hit returns
+/// the very same edge-function object as before, chains of compositions over
+/// memoized results keep hitting the cache as well.
+///
+/// The cache keeps the memoized operands and results alive until they are
+/// evicted or the cache is destroyed. If Synchronized is set, the cache may
+/// be used concurrently; the slots are then guarded by a fixed number of
+/// locks.
+template <typename L> class EdgeFunctionMemoCache {
+public:
+  using l_t = L;
+
+  explicit EdgeFunctionMemoCache(size_t Capacity, bool Synchronized = false)
+      : Synchronized(Synchronized) {
+    Capacity = llvm::PowerOf2Ceil(std::max(Capacity, NumShards));
+    SlotsPerShard = Capacity / NumShards;
+    Shards = std::make_unique<Shard[]>(NumShards);
+    for (size_t I = 0; I != NumShards; ++I) {
+      Shards[I].Slots.resize(SlotsPerShard);
+    }
+  }
+
+  /// Returns FirstEF.composeWith(SecondEF), from the cache if possible
+  [[nodiscard]] EdgeFunction<l_t> compose(const EdgeFunction<l_t> &FirstEF,
+                                          const EdgeFunction<l_t> &SecondEF) {
+    return lookupOrCompute(FirstEF, SecondEF, Operation::Compose);
+  }
+
+  /// Returns FirstEF.joinWith(SecondEF), from the cache if possible
+  [[nodiscard]] EdgeFunction<l_t> join(const EdgeFunction<l_t> &FirstEF,
+                                       const EdgeFunction<l_t> &SecondEF) {
+    return lookupOrCompute(FirstEF, SecondEF, Operation::Join);
+  }
+
+  [[nodiscard]] EdgeFunctionMemoStats getStats() const {
+    EdgeFunctionMemoStats Ret;
+    for (size_t I = 0; I != NumShards; ++I) {
+      auto Lock = lock(Shards[I]);
+      Ret += Shards[I].Stats;
+    }
+    return Ret;
+  }
+
+  [[nodiscard]] size_t capacity() const noexcept {
+    return SlotsPerShard * NumShards;
+  }
+
+  /// Releases all memoized edge functions. Keeps the statistics.
+  void clear() {
+    for (size_t I = 0; I != NumShards; ++I) {
+      auto Lock = lock(Shards[I]);
+      std::vector<Slot>(SlotsPerShard).swap(Shards[I].Slots);
+    }
+  }
+
+private:
+  enum class Operation : uint8_t { Compose, Join };
+
+  struct Slot {
+    EdgeFunction<l_t> First{};
+    EdgeFunction<l_t> Second{};
+    EdgeFunction<l_t> Result{};
+    Operation Op{};
+  };
+
+  struct alignas(64) Shard {
+    mutable std::mutex Mtx;
+    std::vector<Slot> Slots;
+    EdgeFunctionMemoStats Stats;
+  };
+
+  static constexpr size_t NumShards = 64;
+
+  [[nodiscard]] std::unique_lock<std::mutex> lock(const Shard &S) const {
+    return Synchronized ? std::unique_lock(S.Mtx)
+                        : std::unique_lock<std::mutex>();
+  }
+
+  EdgeFunction<l_t> lookupOrCompute(const EdgeFunction<l_t> &FirstEF,
+                                    const EdgeFunction<l_t> &SecondEF,
+                                    Operation Op) {
+    auto Key = uint64_t(uintptr_t(FirstEF.getOpaqueValue())) * 31 +
+               uint64_t(uintptr_t(SecondEF.getOpaqueValue()));
+    // Fibonacci hashing to also distribute pointers with aligned addresses
+    auto Hash = (Key * 2 + uint64_t(Op)) * 0x9E3779B97F4A7C15ULL;
+    auto &S = Shards[(Hash >> 58) & (NumShards - 1)];
+    auto SlotIdx = size_t(Hash >> 16) & (SlotsPerShard - 1);
+
+    {
+      auto Lock = lock(S);
+      const auto &Entry = S.Slots[SlotIdx];
+      if (Entry.Op == Op && Entry.First.referenceEquals(FirstEF) &&
+          Entry.Second.referenceEquals(SecondEF) && Entry.Result) {
+        (Op == Operation::Compose ? S.Stats.ComposeHits : S.Stats.JoinHits)++;
+        return Entry.Result;
+      }
+    }
+
+    // Compute outside of the lock; compose() and join() may be expensive
+    auto Result = Op == Operation::Compose ? FirstEF.composeWith(SecondEF)
+                                           : FirstEF.joinWith(SecondEF);
+
+    // Destroying the evicted edge functions may be expensive, so do it
+    // outside of the lock as well
+    Slot Evicted;
+    {
+      auto Lock = lock(S);
+      (Op == Operation::Compose ? S.Stats.ComposeMisses : S.Stats.JoinMisses)++;
+      Evicted = std::exchange(S.Slots[SlotIdx],
+                              Slot{FirstEF, SecondEF, Result, Op});
+    }
+    return Result;
+  }
+
+  std::unique_ptr<Shard[]> Shards;
+  size_t SlotsPerShard = 0;
+  bool Synchronized = false;
+};
+
+} // namespace psr
+
+#endif // PHASAR_DATAFLOW_IFDSIDE_EDGEFUNCTIONMEMOCACHE_H
@@ -20,7 +20,10 @@
 #include "phasar/Utils/TypeTraits.h"
 
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
 
+#include <algorithm>
 #include <functional>
 #include <initializer_list>
 #include <iterator>
@@ -64,6 +67,23 @@ public:
   // details.
   //
   virtual container_type computeTargets(D Source) = 0;
+
+  //
+  // Same as computeTargets(), but appends the target facts to Targets instead
+  // of returning a fresh container. Targets is not cleared beforehand, so the
+  // solver can reuse one buffer for all edges it draws. Implementations must
+  // not append the same fact twice.
+  //
+  // The default implementation forwards to computeTargets(); the flow
+  // function factories below override it to avoid the intermediate
+  // container.
+  //
+  virtual void computeTargetsInto(D Source,
+                                  llvm::SmallVectorImpl<D> &Targets) {
+    auto Ret = computeTargets(std::move(Source));
+    Targets.append(std::make_move_iterator(Ret.begin()),
+                   std::make_move_iterator(Ret.end()));
+  }
 };
 
 /// Helper template to check at compile-time whether a type implements the
@@ -113,6 +133,10 @@ using FlowFunctionPtrType = FlowFunctionPtrTypeOf<FlowFunction<D, Container>>;
 template <typename D, typename Container = std::set<D>> auto identityFlow() {
   struct IdFF final : public FlowFunction<D, Container> {
     Container computeTargets(D Source) override { return {std::move(Source)}; }
+    void computeTargetsInto(D Source,
+                            llvm::SmallVectorImpl<D> &Targets) override {
+      Targets.push_back(std::move(Source));
+    }
   };
   static auto TheIdentity = std::make_shared<IdFF>();
 
@@ -185,6 +209,14 @@ auto generateFlow(psr::type_identity_t<D> FactToGenerate, D From) {
       }
       return {std::move(Source)};
     }
+    void computeTargetsInto(D Source,
+                            llvm::SmallVectorImpl<D> &Targets) override {
+      bool Gen = Source == FromValue && Source != GenValue;
+      Targets.push_back(std::move(Source));
+      if (Gen) {
+        Targets.push_back(GenValue);
+      }
+    }
 
     D GenValue;
     D FromValue;
@@ -217,6 +249,14 @@ auto generateFlowIf(D FactToGenerate, Fn Predicate) {
       }
       return {std::move(Source)};
     }
+    void computeTargetsInto(D Source,
+                            llvm::SmallVectorImpl<D> &Targets) override {
+      bool Gen = Source != GenValue && std::invoke(Predicate, Source);
+      Targets.push_back(std::move(Source));
+      if (Gen) {
+        Targets.push_back(GenValue);
+      }
+    }
 
     D GenValue;
     [[no_unique_address]] std::decay_t<Fn> Predicate;
@@ -258,6 +298,17 @@ auto generateManyFlows(Range &&FactsToGenerate, D From) {
       }
       return {std::move(Source)};
     }
+    void computeTargetsInto(D Source,
+                            llvm::SmallVectorImpl<D> &Targets) override {
+      if (Source == FromValue) {
+        for (const auto &Fact : GenValues) {
+          if (Fact != Source) {
+            Targets.push_back(Fact);
+          }
+        }
+      }
+      Targets.push_back(std::move(Source));
+    }
 
     Container GenValues;
     D FromValue;
@@ -306,6 +357,12 @@ auto killFlow(D FactToKill) {
       }
       return {std::move(Source)};
     }
+    void computeTargetsInto(D Source,
+                            llvm::SmallVectorImpl<D> &Targets) override {
+      if (Source != KillValue) {
+        Targets.push_back(std::move(Source));
+      }
+    }
     D KillValue;
   };
 
@@ -332,6 +389,12 @@ auto killFlowIf(Fn Predicate) {
       }
       return {std::move(Source)};
     }
+    void computeTargetsInto(D Source,
+                            llvm::SmallVectorImpl<D> &Targets) override {
+      if (!std::invoke(Predicate, Source)) {
+        Targets.push_back(std::move(Source));
+      }
+    }
 
     [[no_unique_address]] std::decay_t<Fn> Predicate;
   };
@@ -371,6 +434,12 @@ auto killManyFlows(Range &&FactsToKill) {
       }
       return {std::move(Source)};
     }
+    void computeTargetsInto(D Source,
+                            llvm::SmallVectorImpl<D> &Targets) override {
+      if (!KillValues.count(Source)) {
+        Targets.push_back(std::move(Source));
+      }
+    }
 
     Container KillValues;
   };
@@ -441,6 +510,16 @@ auto generateFlowAndKillAllOthers(psr::type_identity_t<D> FactToGenerate,
       }
       return {};
     }
+    void computeTargetsInto(D Source,
+                            llvm::SmallVectorImpl<D> &Targets) override {
+      if (Source == FromValue) {
+        bool Gen = Source != GenValue;
+        Targets.push_back(std::move(Source));
+        if (Gen) {
+          Targets.push_back(GenValue);
+        }
+      }
+    }
 
     D GenValue;
     D FromValue;
@@ -483,6 +562,17 @@ auto generateManyFlowsAndKillAllOthers(Range &&FactsToGenerate, D From) {
       }
       return {};
     }
+    void computeTargetsInto(D Source,
+                            llvm::SmallVectorImpl<D> &Targets) override {
+      if (Source == FromValue) {
+        for (const auto &Fact : GenValues) {
+          if (Fact != Source) {
+            Targets.push_back(Fact);
+          }
+        }
+        Targets.push_back(std::move(Source));
+      }
+    }
 
     Container GenValues;
     D FromValue;
@@ -544,6 +634,18 @@ auto transferFlow(psr::type_identity_t<D> FactToGenerate, D From) {
       }
       return {std::move(Source)};
     }
+    void computeTargetsInto(D Source,
+                            llvm::SmallVectorImpl<D> &Targets) override {
+      if (Source == FromValue) {
+        bool Gen = Source != GenValue;
+        Targets.push_back(std::move(Source));
+        if (Gen) {
+          Targets.push_back(GenValue);
+        }
+      } else if (Source != GenValue) {
+        Targets.push_back(std::move(Source));
+      }
+    }
 
     D GenValue;
     D FromValue;
@@ -584,6 +686,21 @@ auto unionFlows(FlowFunctionPtrTypeOf<F1> OneFF,
                     std::make_move_iterator(OtherRet.end()));
       return OneRet;
     }
+    void computeTargetsInto(D Source,
+                            llvm::SmallVectorImpl<D> &Targets) override {
+      auto Begin = Targets.size();
+      OneFF->computeTargetsInto(Source, Targets);
+      auto Mid = Targets.size();
+      OtherFF->computeTargetsInto(std::move(Source), Targets);
+
+      // Drop the facts of OtherFF that OneFF has already produced
+      auto OneRange = llvm::makeArrayRef(Targets).slice(Begin, Mid - Begin);
+      auto End = std::remove_if(Targets.begin() + Mid, Targets.end(),
+                                [OneRange](const D &Fact) {
+                                  return llvm::is_contained(OneRange, Fact);
+                                });
+      Targets.erase(End, Targets.end());
+    }
 
     FlowFunctionPtrTypeOf<F1> OneFF;
     FlowFunctionPtrTypeOf<F2> OtherFF;
@@ -611,6 +728,18 @@ public:
     }
     return Delegate->computeTargets(Source);
   }
+  void computeTargetsInto(D Source,
+                          llvm::SmallVectorImpl<D> &Targets) override {
+    auto Begin = Targets.size();
+    bool IsZero = Source == ZeroValue;
+    Delegate->computeTargetsInto(std::move(Source), Targets);
+    if (IsZero) {
+      auto Produced = llvm::makeArrayRef(Targets).drop_front(Begin);
+      if (!llvm::is_contained(Produced, ZeroValue)) {
+        Targets.push_back(ZeroValue);
+      }
+    }
+  }
 
 private:
   FlowFunctionPtrType Delegate;
@@ -78,6 +78,25 @@ public:
     return FlowFact == *ZeroValue;
   }
 
+  /// Whether the flow- and edge-function factories and the lattice operations
+  /// of this problem may be invoked concurrently, such that the IDESolver can
+  /// use multiple threads (IFDSIDESolverConfig::numThreads()). Problems that
+  /// mutate shared state from within their flow functions, e.g., to collect
+  /// leaks or to cache edge functions, must not return true.
+  [[nodiscard]] virtual bool supportsParallelSolving() const noexcept {
+    return false;
+  }
+
+  /// Whether the outcome of this problem is fully described by the computed
+  /// jump functions and values, such that calls may be replaced by the end
+  /// summaries of the callees (see IFDSIDESolverConfig::
+  /// computePersistedSummaries()). Problems that report findings, e.g., leaks,
+  /// from within their flow or edge functions must not return true, as the
+  /// findings inside summarized callees would get lost.
+  [[nodiscard]] virtual bool supportsFunctionSummaries() const noexcept {
+    return false;
+  }
+
   /// Returns initial seeds to be used for the analysis. This is a mapping of
   /// statements to initial analysis facts.
   [[nodiscard]] virtual InitialSeeds<n_t, d_t, l_t> initialSeeds() = 0;
@@ -103,6 +122,14 @@ public:
     return SolverConfig;
   }
 
+  [[nodiscard]] const std::vector<std::string> &getEntryPoints() const {
+    return EntryPoints;
+  }
+
+  [[nodiscard]] const ProjectIRDBBase<db_t> *getProjectIRDB() const {
+    return IRDB;
+  }
+
   /// Generates a text report of the results that is written to the specified
   /// output stream.
   virtual void
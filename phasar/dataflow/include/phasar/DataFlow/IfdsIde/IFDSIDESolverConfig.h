@@ -19,7 +19,11 @@
 
 #include "phasar/Utils/EnumFlags.h"
 
+#include "llvm/ADT/StringRef.h"
+
+#include <cstddef>
 #include <cstdint>
+#include <string>
 
 namespace llvm {
 class raw_ostream;
@@ -39,6 +43,21 @@ enum class SolverConfigOptions : uint32_t {
   All = ~0U
 };
 
+/// The order in which the sequential IDESolver processes the pending path
+/// edges of Phase I
+enum class WorkListPolicy : uint8_t {
+#define WORKLIST_POLICY(NAME, CMDFLAG, DESC) NAME,
+#include "phasar/DataFlow/IfdsIde/WorkListPolicy.def"
+};
+
+std::string toString(WorkListPolicy Policy);
+
+/// Parses a WorkListPolicy from its name or its command-line flag. Returns
+/// WorkListPolicy::DepthFirst if S names no policy.
+WorkListPolicy toWorkListPolicy(llvm::StringRef S);
+
+llvm::raw_ostream &operator<<(llvm::raw_ostream &OS, WorkListPolicy Policy);
+
 struct IFDSIDESolverConfig {
   IFDSIDESolverConfig() noexcept = default;
   IFDSIDESolverConfig(SolverConfigOptions Options) noexcept;
@@ -49,6 +68,17 @@ struct IFDSIDESolverConfig {
   [[nodiscard]] bool recordEdges() const;
   [[nodiscard]] bool emitESG() const;
   [[nodiscard]] bool computePersistedSummaries() const;
+  /// The number of worker threads that the IDESolver uses in Phase I. A value
+  /// of 0 or 1 selects the sequential solver. Only used for problems that
+  /// support parallel solving (IDETabulationProblem::supportsParallelSolving).
+  [[nodiscard]] unsigned numThreads() const;
+  /// The order of the worklist of the sequential Phase I. The parallel
+  /// Phase I uses work stealing instead.
+  [[nodiscard]] WorkListPolicy workListPolicy() const;
+  /// The maximum number of compose() and join() results of edge functions
+  /// that the IDESolver memoizes, see EdgeFunctionMemoCache. A value of 0
+  /// disables memoization.
+  [[nodiscard]] size_t edgeFunctionMemoCacheSize() const;
 
   void setFollowReturnsPastSeeds(bool Set = true);
   void setAutoAddZero(bool Set = true);
@@ -56,6 +86,9 @@ struct IFDSIDESolverConfig {
   void setRecordEdges(bool Set = true);
   void setEmitESG(bool Set = true);
   void setComputePersistedSummaries(bool Set = true);
+  void setNumThreads(unsigned NumThreads);
+  void setWorkListPolicy(WorkListPolicy Policy);
+  void setEdgeFunctionMemoCacheSize(size_t Size);
 
   void setConfig(SolverConfigOptions Opt);
 
@@ -65,6 +98,9 @@ struct IFDSIDESolverConfig {
 private:
   SolverConfigOptions Options =
       SolverConfigOptions::AutoAddZero | SolverConfigOptions::ComputeValues;
+  unsigned NumThreads = 1;
+  WorkListPolicy Policy = WorkListPolicy::DepthFirst;
+  size_t EFMemoCacheSize = 0;
 };
 
 } // namespace psr
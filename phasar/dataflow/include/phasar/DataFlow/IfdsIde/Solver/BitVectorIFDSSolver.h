@@ -0,0 +1,562 @@
+/******************************************************************************
+ * Copyright (c) 2023 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_DATAFLOW_IFDSIDE_SOLVER_BITVECTORIFDSSOLVER_H
+#define PHASAR_DATAFLOW_IFDSIDE_SOLVER_BITVECTORIFDSSOLVER_H
+
+#include "phasar/DataFlow/IfdsIde/FlowFunctions.h"
+#include "phasar/DataFlow/IfdsIde/IDETabulationProblem.h"
+#include "phasar/DataFlow/IfdsIde/IFDSIDESolverConfig.h"
+#include "phasar/DataFlow/IfdsIde/IFDSTabulationProblem.h"
+#include "phasar/DataFlow/IfdsIde/InitialSeeds.h"
+#include "phasar/DataFlow/IfdsIde/Solver/FlowEdgeFunctionCache.h"
+#include "phasar/DataFlow/IfdsIde/SolverResults.h"
+#include "phasar/Domain/AnalysisDomain.h"
+#include "phasar/Domain/BinaryDomain.h"
+#include "phasar/Utils/Compressor.h"
+#include "phasar/Utils/Logger.h"
+#include "phasar/Utils/Table.h"
+
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallVector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace psr {
+
+/// A tabulation solver for pure IFDS problems that does not go through the
+/// IDE machinery.
+///
+/// The IFDSSolver is an IDESolver over the BinaryDomain, so it builds an edge
+/// function and a jump function for every path edge and runs the value
+/// computation (Phase II) afterwards, although the only information an IFDS
+/// analysis needs is which path edges exist. This solver instead interns all
+/// data-flow facts to dense ids and represents the path edges <d1, n, d2>
+/// that share their node n and source fact d1 as one llvm::BitVector over d2.
+/// The worklist holds such (n, d1) pairs together with the bits that have not
+/// been processed yet, so the facts that reach a node together are
+/// propagated together: merging the targets into an existing set, finding
+/// the new ones and the summary lookups at exit nodes are word-level bit
+/// operations.
+///
+/// The solver accepts the same problems as the IFDSSolver and honours the
+/// autoAddZero and followReturnsPastSeeds options of the problem's
+/// IFDSIDESolverConfig. Which facts hold at a statement is decided like in
+/// the IFDSSolver's value computation, which is a pure reachability problem
+/// for the BinaryDomain: The facts at start points and call sites are
+/// propagated from the initial seeds, all other statements take the targets
+/// of the path edges whose source holds at their function's start point. So,
+/// both solvers report the same facts, also for the callers that are only
+/// reached by unbalanced returns. Every fact that holds has the value
+/// BinaryDomain::BOTTOM in the solver results. The solver does not record
+/// the exploded supergraph, does not consult a SummaryProvider and always
+/// runs single-threaded.
+template <typename AnalysisDomainTy,
+          typename Container = std::set<typename AnalysisDomainTy::d_t>>
+class BitVectorIFDSSolver {
+public:
+  using ProblemTy =
+      IDETabulationProblem<WithBinaryValueDomain<AnalysisDomainTy>, Container>;
+  using FlowFunctionPtrType = typename ProblemTy::FlowFunctionPtrType;
+
+  using d_t = typename AnalysisDomainTy::d_t;
+  using n_t = typename AnalysisDomainTy::n_t;
+  using f_t = typename AnalysisDomainTy::f_t;
+  using i_t = typename AnalysisDomainTy::i_t;
+  using l_t = BinaryDomain;
+
+  BitVectorIFDSSolver(ProblemTy &Problem, const i_t *ICF)
+      : Problem(Problem), ICF(ICF),
+        SolverConfig(Problem.getIFDSIDESolverConfig()),
+        CachedFlowFunctions(Problem), ZeroValue(Problem.getZeroValue()) {
+    assert(ICF != nullptr);
+  }
+
+  /// Computes all path edges that are reachable from the initial seeds of the
+  /// problem.
+  void solve() {
+    submitInitialSeeds();
+    while (!WorkList.empty()) {
+      auto SetId = WorkList.back();
+      WorkList.pop_back();
+      process(SetId);
+    }
+    PHASAR_LOG_LEVEL(INFO, "BitVectorIFDSSolver: " << NumPathEdges
+                                                   << " path edges over "
+                                                   << Facts.size() << " facts");
+    propagateHoldingFacts();
+    computeHoldingFacts();
+    materializeResults();
+  }
+
+  /// Returns the data-flow facts that hold at the given statement.
+  [[nodiscard]] std::set<d_t> ifdsResultsAt(n_t Inst) const {
+    std::set<d_t> Ret;
+    if (auto NodeId = Nodes.getOrNull(Inst); NodeId && *NodeId < Holds.size()) {
+      for (auto FactId : Holds[*NodeId].set_bits()) {
+        Ret.insert(Facts[FactId]);
+      }
+    }
+    return Ret;
+  }
+
+  /// Returns a view into the computed solver-results. Its lifetime is bound to
+  /// the lifetime of this solver.
+  [[nodiscard]] SolverResults<n_t, d_t, l_t> getSolverResults() noexcept {
+    return SolverResults<n_t, d_t, l_t>(ValTab, ZeroValue);
+  }
+
+  /// Moves the computed solver-results out of this solver. Do not call any
+  /// function on this solver instance after that.
+  [[nodiscard]] OwningSolverResults<n_t, d_t, l_t>
+  consumeSolverResults() noexcept(std::is_nothrow_move_constructible_v<d_t>) {
+    return OwningSolverResults<n_t, d_t, l_t>(std::move(ValTab),
+                                              std::move(ZeroValue));
+  }
+
+  /// The number of distinct path edges <d1, n, d2> that have been computed
+  [[nodiscard]] size_t getNumPathEdges() const noexcept {
+    return NumPathEdges;
+  }
+
+  /// The number of distinct data-flow facts that have been generated
+  [[nodiscard]] size_t getNumFacts() const noexcept { return Facts.size(); }
+
+private:
+  using fact_id_t = typename Compressor<d_t>::id_type;
+  using node_id_t = typename Compressor<n_t>::id_type;
+
+  /// All path edges <Source, Node, d2>, represented as a set of d2
+  struct PathEdgeSet {
+    node_id_t Node{};
+    fact_id_t Source{};
+    llvm::BitVector Reached;
+    /// The facts in Reached that still need to be processed
+    llvm::BitVector Pending;
+    bool Queued = false;
+  };
+
+  /// The summary information of a callee's start point SP for a fact d1,
+  /// keyed by the path-edge set of <d1, SP>
+  struct Summary {
+    /// For each call site, the caller-side facts d2 that enter <SP, d1>
+    llvm::DenseMap<node_id_t, llvm::BitVector> Incoming;
+    /// For each exit node eP, the facts d2 such that <d1, eP, d2> holds
+    llvm::DenseMap<node_id_t, llvm::BitVector> EndSummaries;
+  };
+
+  static void setBit(llvm::BitVector &Bits, unsigned Idx) {
+    if (Idx >= Bits.size()) {
+      Bits.resize(Idx + 1);
+    }
+    Bits.set(Idx);
+  }
+
+  [[nodiscard]] uint32_t getOrCreateEdgeSet(node_id_t Node, fact_id_t Source) {
+    auto Key = (uint64_t(Node) << 32) | Source;
+    auto [It, Inserted] =
+        EdgeSetIds.try_emplace(Key, uint32_t(EdgeSets.size()));
+    if (Inserted) {
+      auto &Set = EdgeSets.emplace_back();
+      Set.Node = Node;
+      Set.Source = Source;
+      if (Node >= SetsAtNode.size()) {
+        SetsAtNode.resize(Node + 1);
+      }
+      SetsAtNode[Node].push_back(It->second);
+    }
+    return It->second;
+  }
+
+  [[nodiscard]] node_id_t getNodeId(n_t Node) {
+    return Nodes.getOrInsert(Node);
+  }
+
+  /// Adds the path edges <Source, Node, d2> for all d2 in Targets
+  void propagate(fact_id_t Source, node_id_t Node,
+                 const llvm::BitVector &Targets) {
+    auto SetId = getOrCreateEdgeSet(Node, Source);
+    auto &Set = EdgeSets[SetId];
+    NewBits = Targets;
+    NewBits.reset(Set.Reached);
+    if (NewBits.none()) {
+      return;
+    }
+    NumPathEdges += NewBits.count();
+    Set.Reached |= NewBits;
+    Set.Pending |= NewBits;
+    enqueue(SetId);
+  }
+
+  /// Adds the single path edge <Source, Node, Target>
+  void propagate(fact_id_t Source, node_id_t Node, fact_id_t Target) {
+    auto SetId = getOrCreateEdgeSet(Node, Source);
+    auto &Set = EdgeSets[SetId];
+    if (Target < Set.Reached.size() && Set.Reached.test(Target)) {
+      return;
+    }
+    ++NumPathEdges;
+    setBit(Set.Reached, Target);
+    setBit(Set.Pending, Target);
+    enqueue(SetId);
+  }
+
+  void enqueue(uint32_t SetId) {
+    auto &Set = EdgeSets[SetId];
+    if (!Set.Queued) {
+      Set.Queued = true;
+      WorkList.push_back(SetId);
+    }
+  }
+
+  /// Adds the targets of FF for all facts in Sources to Into
+  void applyFlowFunction(const FlowFunctionPtrType &FF,
+                         const llvm::BitVector &Sources,
+                         llvm::BitVector &Into) {
+    for (auto FactId : Sources.set_bits()) {
+      FlowTargets.clear();
+      FF->computeTargetsInto(Facts[FactId], FlowTargets);
+      for (const auto &Target : FlowTargets) {
+        setBit(Into, Facts.getOrInsert(Target));
+      }
+    }
+  }
+
+  void submitInitialSeeds() {
+    Seeds = Problem.initialSeeds();
+    for (const auto &[StartPoint, SeedFacts] : Seeds.getSeeds()) {
+      auto NodeId = getNodeId(StartPoint);
+      auto ZeroId = Facts.getOrInsert(ZeroValue);
+      propagate(ZeroId, NodeId, ZeroId);
+      for (const auto &[Fact, Value] : SeedFacts) {
+        auto FactId = Facts.getOrInsert(Fact);
+        propagate(FactId, NodeId, FactId);
+      }
+    }
+  }
+
+  void process(uint32_t SetId) {
+    auto &Set = EdgeSets[SetId];
+    Set.Queued = false;
+    // Recycle the buffer of the previously processed delta
+    llvm::BitVector Delta;
+    std::swap(Delta, DeltaBuffer);
+    std::swap(Delta, Set.Pending);
+    Set.Pending.reset();
+
+    auto Node = Nodes[Set.Node];
+    if (ICF->isCallSite(Node)) {
+      processCall(Set.Source, Set.Node, Delta);
+    } else {
+      if (ICF->isExitInst(Node)) {
+        processExit(Set.Source, Set.Node, Delta);
+      }
+      processNormalFlow(Set.Source, Set.Node, Delta);
+    }
+    std::swap(Delta, DeltaBuffer);
+  }
+
+  void processNormalFlow(fact_id_t Source, node_id_t NodeId,
+                         const llvm::BitVector &Delta) {
+    auto Node = Nodes[NodeId];
+    for (const auto &Succ : ICF->getSuccsOf(Node)) {
+      auto FF = CachedFlowFunctions.getNormalFlowFunction(Node, Succ);
+      Targets.reset();
+      applyFlowFunction(FF, Delta, Targets);
+      propagate(Source, getNodeId(Succ), Targets);
+    }
+  }
+
+  void processCall(fact_id_t Source, node_id_t NodeId,
+                   const llvm::BitVector &Delta) {
+    auto CallSite = Nodes[NodeId];
+    const auto &ReturnSites = ICF->getReturnSitesOfCallAt(CallSite);
+    const auto &Callees = ICF->getCalleesOfCallAt(CallSite);
+
+    for (const auto &Callee : Callees) {
+      if (auto SpecialSum =
+              CachedFlowFunctions.getSummaryFlowFunction(CallSite, Callee)) {
+        Targets.reset();
+        applyFlowFunction(SpecialSum, Delta, Targets);
+        for (const auto &RetSite : ReturnSites) {
+          propagate(Source, getNodeId(RetSite), Targets);
+        }
+        continue;
+      }
+
+      auto CallFF = CachedFlowFunctions.getCallFlowFunction(CallSite, Callee);
+      AppliedSummaries.clear();
+      for (auto FactId : Delta.set_bits()) {
+        CalleeFacts.clear();
+        CallFF->computeTargetsInto(Facts[FactId], CalleeFacts);
+        for (const auto &StartPoint : ICF->getStartPointsOf(Callee)) {
+          auto SPId = getNodeId(StartPoint);
+          for (const auto &CalleeFact : CalleeFacts) {
+            auto CalleeFactId = Facts.getOrInsert(CalleeFact);
+            // Initial self-loop in the callee
+            propagate(CalleeFactId, SPId, CalleeFactId);
+
+            auto SummId = getOrCreateEdgeSet(SPId, CalleeFactId);
+            auto &Summ = Summaries[SummId];
+            setBit(Summ.Incoming[NodeId], FactId);
+            // Apply the end summaries that are already known, once per
+            // callee fact
+            if (!AppliedSummaries.insert(SummId).second) {
+              continue;
+            }
+            for (const auto &[ExitId, ExitFacts] : Summ.EndSummaries) {
+              for (const auto &RetSite : ReturnSites) {
+                auto RetFF = CachedFlowFunctions.getRetFlowFunction(
+                    CallSite, Callee, Nodes[ExitId], RetSite);
+                Targets.reset();
+                applyFlowFunction(RetFF, ExitFacts, Targets);
+                propagate(Source, getNodeId(RetSite), Targets);
+              }
+            }
+          }
+        }
+      }
+    }
+
+    for (const auto &RetSite : ReturnSites) {
+      auto CallToRetFF = CachedFlowFunctions.getCallToRetFlowFunction(
+          CallSite, RetSite, Callees);
+      Targets.reset();
+      applyFlowFunction(CallToRetFF, Delta, Targets);
+      propagate(Source, getNodeId(RetSite), Targets);
+    }
+  }
+
+  void processExit(fact_id_t Source, node_id_t NodeId,
+                   const llvm::BitVector &Delta) {
+    auto Exit = Nodes[NodeId];
+    auto Callee = ICF->getFunctionOf(Exit);
+    bool HasIncoming = false;
+
+    for (const auto &StartPoint : ICF->getStartPointsOf(Callee)) {
+      auto &Summ =
+          Summaries[getOrCreateEdgeSet(getNodeId(StartPoint), Source)];
+      Summ.EndSummaries[NodeId] |= Delta;
+
+      for (const auto &[CallSiteId, CallerFacts] : Summ.Incoming) {
+        HasIncoming = true;
+        auto CallSite = Nodes[CallSiteId];
+        for (const auto &RetSite : ICF->getReturnSitesOfCallAt(CallSite)) {
+          auto RetFF = CachedFlowFunctions.getRetFlowFunction(CallSite, Callee,
+                                                              Exit, RetSite);
+          Targets.reset();
+          applyFlowFunction(RetFF, Delta, Targets);
+          if (Targets.none()) {
+            continue;
+          }
+          auto RetSiteId = getNodeId(RetSite);
+          // Propagate to all caller-side sources that reach the call site
+          // with one of the incoming facts
+          CallerSources.clear();
+          for (auto CallerSetId : SetsAtNode[CallSiteId]) {
+            const auto &CallerSet = EdgeSets[CallerSetId];
+            if (CallerSet.Reached.anyCommon(CallerFacts)) {
+              CallerSources.push_back(CallerSet.Source);
+            }
+          }
+          for (auto CallerSource : CallerSources) {
+            propagate(CallerSource, RetSiteId, Targets);
+          }
+        }
+      }
+    }
+
+    // Handling for unbalanced problems, where we return out of a function
+    // for which we have not seen a call
+    if (SolverConfig.followReturnsPastSeeds() && !HasIncoming &&
+        Problem.isZeroValue(Facts[Source])) {
+      const auto &Callers = ICF->getCallersOf(Callee);
+      for (const auto &Caller : Callers) {
+        for (const auto &RetSite : ICF->getReturnSitesOfCallAt(Caller)) {
+          auto RetFF = CachedFlowFunctions.getRetFlowFunction(Caller, Callee,
+                                                              Exit, RetSite);
+          Targets.reset();
+          applyFlowFunction(RetFF, Delta, Targets);
+          if (Targets.none()) {
+            continue;
+          }
+          auto RetSiteId = getNodeId(RetSite);
+          UnbalancedRetSites.insert(RetSiteId);
+          propagate(Facts.getOrInsert(ZeroValue), RetSiteId, Targets);
+        }
+      }
+      // The return flow function may have side effects, so call it even if
+      // there are no callers
+      if (Callers.empty()) {
+        auto RetFF = CachedFlowFunctions.getRetFlowFunction(nullptr, Callee,
+                                                            Exit, nullptr);
+        Targets.reset();
+        applyFlowFunction(RetFF, Delta, Targets);
+      }
+    }
+  }
+
+  /// Marks Fact as holding at Node during propagateHoldingFacts()
+  void addHoldingFact(node_id_t NodeId, fact_id_t FactId) {
+    if (NodeId >= Holds.size()) {
+      Holds.resize(NodeId + 1);
+    }
+    auto &Bits = Holds[NodeId];
+    if (FactId < Bits.size() && Bits.test(FactId)) {
+      return;
+    }
+    setBit(Bits, FactId);
+    HoldsWorkList.emplace_back(NodeId, FactId);
+  }
+
+  /// Computes the facts that hold at start points and call sites. Mirrors
+  /// Phase II(i) of the IDESolver: The seeds hold, the facts holding at a
+  /// start point (or seed or unbalanced return site) reach the call sites of
+  /// its function along the path edges and the facts holding at a call site
+  /// enter the start points of its callees.
+  void propagateHoldingFacts() {
+    for (const auto &[SeedNode, SeedFacts] : Seeds.getSeeds()) {
+      auto NodeId = getNodeId(SeedNode);
+      SeedNodes.insert(NodeId);
+      for (const auto &[Fact, Value] : SeedFacts) {
+        if (Value != BinaryDomain::TOP) {
+          addHoldingFact(NodeId, Facts.getOrInsert(Fact));
+        }
+      }
+    }
+
+    while (!HoldsWorkList.empty()) {
+      auto [NodeId, FactId] = HoldsWorkList.back();
+      HoldsWorkList.pop_back();
+      auto Node = Nodes[NodeId];
+
+      if (ICF->isStartPoint(Node) || SeedNodes.count(NodeId) ||
+          UnbalancedRetSites.count(NodeId)) {
+        for (const auto &CallSite :
+             ICF->getCallsFromWithin(ICF->getFunctionOf(Node))) {
+          auto CSId = Nodes.getOrNull(CallSite);
+          if (!CSId) {
+            continue;
+          }
+          auto It = EdgeSetIds.find((uint64_t(*CSId) << 32) | FactId);
+          if (It == EdgeSetIds.end()) {
+            continue;
+          }
+          for (auto Target : EdgeSets[It->second].Reached.set_bits()) {
+            addHoldingFact(*CSId, Target);
+          }
+        }
+      }
+
+      if (ICF->isCallSite(Node)) {
+        for (const auto &Callee : ICF->getCalleesOfCallAt(Node)) {
+          auto CallFF = CachedFlowFunctions.getCallFlowFunction(Node, Callee);
+          CalleeFacts.clear();
+          CallFF->computeTargetsInto(Facts[FactId], CalleeFacts);
+          for (const auto &StartPoint : ICF->getStartPointsOf(Callee)) {
+            auto SPId = getNodeId(StartPoint);
+            for (const auto &CalleeFact : CalleeFacts) {
+              addHoldingFact(SPId, Facts.getOrInsert(CalleeFact));
+            }
+          }
+        }
+      }
+    }
+  }
+
+  /// Computes the facts that hold at all other statements. Mirrors Phase
+  /// II(ii) of the IDESolver: A path edge <d1, n, d2> makes d2 hold at n if
+  /// d1 holds at a start point of n's function.
+  void computeHoldingFacts() {
+    Holds.resize(std::max(Holds.size(), SetsAtNode.size()));
+    for (node_id_t NodeId = 0, End = SetsAtNode.size(); NodeId != End;
+         ++NodeId) {
+      auto Node = Nodes[NodeId];
+      if (ICF->isCallSite(Node) || ICF->isStartPoint(Node)) {
+        continue;
+      }
+      for (const auto &StartPoint :
+           ICF->getStartPointsOf(ICF->getFunctionOf(Node))) {
+        auto SPId = Nodes.getOrNull(StartPoint);
+        if (!SPId || *SPId >= Holds.size()) {
+          continue;
+        }
+        const auto &AtStart = Holds[*SPId];
+        for (auto SetId : SetsAtNode[NodeId]) {
+          const auto &Set = EdgeSets[SetId];
+          if (Set.Source < AtStart.size() && AtStart.test(Set.Source)) {
+            Holds[NodeId] |= Set.Reached;
+          }
+        }
+      }
+    }
+  }
+
+  void materializeResults() {
+    for (node_id_t NodeId = 0, End = Holds.size(); NodeId != End; ++NodeId) {
+      for (auto FactId : Holds[NodeId].set_bits()) {
+        ValTab.insert(Nodes[NodeId], Facts[FactId], BinaryDomain::BOTTOM);
+      }
+    }
+  }
+
+  ProblemTy &Problem;
+  const i_t *ICF;
+  IFDSIDESolverConfig &SolverConfig;
+  FlowEdgeFunctionCache<WithBinaryValueDomain<AnalysisDomainTy>, Container>
+      CachedFlowFunctions;
+  d_t ZeroValue;
+
+  Compressor<d_t> Facts;
+  Compressor<n_t> Nodes;
+  InitialSeeds<n_t, d_t, l_t> Seeds;
+
+  /// Stable, as the sets are referenced while new ones are created
+  std::deque<PathEdgeSet> EdgeSets;
+  llvm::DenseMap<uint64_t, uint32_t> EdgeSetIds;
+  std::vector<llvm::SmallVector<uint32_t, 2>> SetsAtNode;
+  llvm::DenseMap<uint32_t, Summary> Summaries;
+  std::vector<uint32_t> WorkList;
+  size_t NumPathEdges = 0;
+  /// The return sites in callers that are reached by unbalanced returns
+  llvm::DenseSet<node_id_t> UnbalancedRetSites;
+
+  /// For each node, the facts that hold there
+  std::vector<llvm::BitVector> Holds;
+  std::vector<std::pair<node_id_t, fact_id_t>> HoldsWorkList;
+  llvm::DenseSet<node_id_t> SeedNodes;
+
+  // Scratch buffers that are reused across all work items
+  llvm::BitVector Targets;
+  llvm::BitVector NewBits;
+  llvm::BitVector DeltaBuffer;
+  llvm::SmallVector<d_t, 8> FlowTargets;
+  llvm::SmallVector<d_t, 8> CalleeFacts;
+  llvm::SmallVector<fact_id_t, 8> CallerSources;
+  llvm::SmallDenseSet<uint32_t, 8> AppliedSummaries;
+
+  Table<n_t, d_t, l_t> ValTab;
+};
+
+template <typename Problem, typename ICF>
+BitVectorIFDSSolver(Problem &, ICF *)
+    -> BitVectorIFDSSolver<typename Problem::ProblemAnalysisDomain,
+                           typename Problem::container_type>;
+
+} // namespace psr
+
+#endif // PHASAR_DATAFLOW_IFDSIDE_SOLVER_BITVECTORIFDSSOLVER_H
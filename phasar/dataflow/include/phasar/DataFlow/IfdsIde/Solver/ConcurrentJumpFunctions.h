@@ -0,0 +1,151 @@
+/******************************************************************************
+ * Copyright (c) 2023 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_DATAFLOW_IFDSIDE_SOLVER_CONCURRENTJUMPFUNCTIONS_H
+#define PHASAR_DATAFLOW_IFDSIDE_SOLVER_CONCURRENTJUMPFUNCTIONS_H
+
+#include "phasar/DataFlow/IfdsIde/EdgeFunction.h"
+#include "phasar/DataFlow/IfdsIde/EdgeFunctionMemoCache.h"
+#include "phasar/DataFlow/IfdsIde/Solver/JumpFunctions.h"
+#include "phasar/Utils/ByRef.h"
+#include "phasar/Utils/Table.h"
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/MathExtras.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace psr {
+
+/// Thread-safe storage for the jump functions that the IDESolver computes in
+/// its parallel Phase I.
+///
+/// All jump functions ending in the same target statement live in the same
+/// shard, such that the read-join-write sequence in IDESolver::propagate only
+/// needs to lock a single shard. Only the reverse mapping
+/// (Target, TargetVal) -> [(SourceVal, EdgeFunction)] is maintained while
+/// solving; the full JumpFunctions are reconstructed by moveInto() once the
+/// parallel phase is over.
+template <typename AnalysisDomainTy> class ConcurrentJumpFunctions {
+public:
+  using l_t = typename AnalysisDomainTy::l_t;
+  using d_t = typename AnalysisDomainTy::d_t;
+  using n_t = typename AnalysisDomainTy::n_t;
+
+  using SourceValsAndFunctions =
+      llvm::SmallVector<std::pair<d_t, EdgeFunction<l_t>>, 1>;
+
+  explicit ConcurrentJumpFunctions(size_t MinNumShards)
+      : ShardMask(llvm::PowerOf2Ceil(std::max<size_t>(MinNumShards, 1)) - 1) {
+    Shards.reserve(ShardMask + 1);
+    for (size_t I = 0; I <= ShardMask; ++I) {
+      Shards.push_back(std::make_unique<Shard>());
+    }
+  }
+
+  /// Returns the jump function from SourceVal to (Target, TargetVal), or
+  /// Default if there is none.
+  [[nodiscard]] EdgeFunction<l_t> lookup(ByConstRef<d_t> SourceVal,
+                                         ByConstRef<n_t> Target,
+                                         ByConstRef<d_t> TargetVal,
+                                         const EdgeFunction<l_t> &Default) {
+    auto &S = getShard(Target);
+    std::lock_guard Lock(S.Mtx);
+    const auto &SourceValToFunc =
+        std::as_const(S.ReverseLookup).get(Target, TargetVal);
+    auto It = std::find_if(
+        SourceValToFunc.begin(), SourceValToFunc.end(),
+        [&SourceVal](const auto &Entry) { return Entry.first == SourceVal; });
+    return It != SourceValToFunc.end() ? It->second : Default;
+  }
+
+  /// Atomically joins EdgeFunc into the jump function from SourceVal to
+  /// (Target, TargetVal), where a missing jump function counts as AllTopFn.
+  /// If Memo is set, the join is looked up in and recorded to it.
+  ///
+  /// \returns The pair of the previous and the joined jump function. The
+  /// joined jump function has been stored iff it differs from the previous
+  /// one.
+  [[nodiscard]] std::pair<EdgeFunction<l_t>, EdgeFunction<l_t>>
+  join(d_t SourceVal, n_t Target, d_t TargetVal,
+       const EdgeFunction<l_t> &EdgeFunc, const EdgeFunction<l_t> &AllTopFn,
+       EdgeFunctionMemoCache<l_t> *Memo = nullptr) {
+    auto &S = getShard(Target);
+    std::lock_guard Lock(S.Mtx);
+    auto &SourceValToFunc =
+        S.ReverseLookup.get(std::move(Target), std::move(TargetVal));
+    auto It = std::find_if(
+        SourceValToFunc.begin(), SourceValToFunc.end(),
+        [&SourceVal](const auto &Entry) { return Entry.first == SourceVal; });
+
+    EdgeFunction<l_t> Prev =
+        It != SourceValToFunc.end() ? It->second : AllTopFn;
+    EdgeFunction<l_t> Joined =
+        Memo ? Memo->join(Prev, EdgeFunc) : Prev.joinWith(EdgeFunc);
+    if (Joined != Prev && !llvm::isa<AllTop<l_t>>(Joined)) {
+      if (It != SourceValToFunc.end()) {
+        It->second = Joined;
+      } else {
+        SourceValToFunc.emplace_back(std::move(SourceVal), Joined);
+      }
+    }
+    return {std::move(Prev), std::move(Joined)};
+  }
+
+  /// Returns a snapshot of all source values and associated jump functions
+  /// that end in (Target, TargetVal).
+  [[nodiscard]] SourceValsAndFunctions
+  reverseLookup(ByConstRef<n_t> Target, ByConstRef<d_t> TargetVal) {
+    auto &S = getShard(Target);
+    std::lock_guard Lock(S.Mtx);
+    return std::as_const(S.ReverseLookup).get(Target, TargetVal);
+  }
+
+  /// Transfers all jump functions into JF and clears this table. Must not be
+  /// called concurrently to any other operation on this table.
+  template <typename Container>
+  void moveInto(JumpFunctions<AnalysisDomainTy, Container> &JF) {
+    for (auto &S : Shards) {
+      S->ReverseLookup.foreachCell([&JF](const n_t &Target,
+                                         const d_t &TargetVal,
+                                         const auto &SourceValToFunc) {
+        for (const auto &[SourceVal, EdgeFunc] : SourceValToFunc) {
+          JF.addFunction(SourceVal, Target, TargetVal, EdgeFunc);
+        }
+      });
+      S->ReverseLookup.clear();
+    }
+  }
+
+private:
+  struct alignas(64) Shard {
+    std::mutex Mtx;
+    Table<n_t, d_t, SourceValsAndFunctions> ReverseLookup;
+  };
+
+  [[nodiscard]] Shard &getShard(ByConstRef<n_t> Target) noexcept {
+    // Fibonacci hashing to also distribute pointers with aligned addresses
+    auto Hash = uint64_t(std::hash<n_t>{}(Target)) * 0x9E3779B97F4A7C15ULL;
+    return *Shards[(Hash >> 32) & ShardMask];
+  }
+
+  size_t ShardMask;
+  std::vector<std::unique_ptr<Shard>> Shards;
+};
+
+} // namespace psr
+
+#endif // PHASAR_DATAFLOW_IFDSIDE_SOLVER_CONCURRENTJUMPFUNCTIONS_H
@@ -0,0 +1,126 @@
+/******************************************************************************
+ * Copyright (c) 2023 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_DATAFLOW_IFDSIDE_SOLVER_CONCURRENTSUMMARYTABLES_H
+#define PHASAR_DATAFLOW_IFDSIDE_SOLVER_CONCURRENTSUMMARYTABLES_H
+
+#include "phasar/DataFlow/IfdsIde/EdgeFunction.h"
+#include "phasar/Utils/ByRef.h"
+#include "phasar/Utils/Table.h"
+
+#include "llvm/Support/MathExtras.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace psr {
+
+/// Thread-safe counterpart of the EndsummaryTab and IncomingTab of the
+/// IDESolver (see CC 2010 paper by Naeem, Lhotak and Rodriguez), used during
+/// the parallel Phase I.
+///
+/// Both tables are sharded by the start point of the callee. Registering an
+/// incoming edge and reading the end summaries (and vice versa) happens under
+/// the same lock, so for each pair of a call edge and an end summary at least
+/// one of the two involved threads observes the other one's entry. This is
+/// what guarantees that no return flow gets lost.
+template <typename AnalysisDomainTy, typename Container>
+class ConcurrentSummaryTables {
+public:
+  using l_t = typename AnalysisDomainTy::l_t;
+  using d_t = typename AnalysisDomainTy::d_t;
+  using n_t = typename AnalysisDomainTy::n_t;
+
+  using EndSummaryTableTy = Table<n_t, d_t, Table<n_t, d_t, EdgeFunction<l_t>>>;
+  using IncomingTableTy = Table<n_t, d_t, std::map<n_t, Container>>;
+  using EndSummaryCell = typename Table<n_t, d_t, EdgeFunction<l_t>>::Cell;
+
+  explicit ConcurrentSummaryTables(size_t MinNumShards)
+      : ShardMask(llvm::PowerOf2Ceil(std::max<size_t>(MinNumShards, 1)) - 1) {
+    Shards.reserve(ShardMask + 1);
+    for (size_t I = 0; I <= ShardMask; ++I) {
+      Shards.push_back(std::make_unique<Shard>());
+    }
+  }
+
+  /// Registers that <SP, D3> has an incoming edge from <CallSite, D2> and
+  /// returns a snapshot of all end summaries that are already known for
+  /// <SP, D3>.
+  [[nodiscard]] std::vector<EndSummaryCell>
+  addIncomingAndGetEndSummaries(n_t SP, d_t D3, n_t CallSite, d_t D2) {
+    auto &S = getShard(SP);
+    std::lock_guard Lock(S.Mtx);
+    S.Incoming.get(SP, D3)[std::move(CallSite)].insert(std::move(D2));
+    return std::as_const(S.EndSummary).get(SP, D3).cellVec();
+  }
+
+  /// Registers the end summary <SP, D1> --EF--> <EP, D2> and returns a
+  /// snapshot of all incoming edges that are already known for <SP, D1>.
+  [[nodiscard]] std::map<n_t, Container>
+  addEndSummaryAndGetIncoming(n_t SP, d_t D1, n_t EP, d_t D2,
+                              EdgeFunction<l_t> EF) {
+    auto &S = getShard(SP);
+    std::lock_guard Lock(S.Mtx);
+    S.EndSummary.get(SP, D1).insert(std::move(EP), std::move(D2),
+                                    std::move(EF));
+    return std::as_const(S.Incoming).get(SP, D1);
+  }
+
+  /// Transfers all entries into the given sequential tables and clears this
+  /// object. Must not be called concurrently to any other operation.
+  void moveInto(EndSummaryTableTy &EndSummaryTab,
+                IncomingTableTy &IncomingTab) {
+    for (auto &S : Shards) {
+      S->EndSummary.foreachCell([&EndSummaryTab](const n_t &SP, const d_t &D1,
+                                                 auto &Summaries) {
+        auto &Dest = EndSummaryTab.get(SP, D1);
+        Summaries.foreachCell(
+            [&Dest](const n_t &EP, const d_t &D2, EdgeFunction<l_t> &EF) {
+              Dest.insert(EP, D2, std::move(EF));
+            });
+      });
+      S->Incoming.foreachCell(
+          [&IncomingTab](const n_t &SP, const d_t &D3, auto &CallSites) {
+            auto &Dest = IncomingTab.get(SP, D3);
+            for (auto &[CallSite, Facts] : CallSites) {
+              Dest[CallSite].insert(Facts.begin(), Facts.end());
+            }
+          });
+      S->EndSummary.clear();
+      S->Incoming.clear();
+    }
+  }
+
+private:
+  struct alignas(64) Shard {
+    std::mutex Mtx;
+    EndSummaryTableTy EndSummary;
+    IncomingTableTy Incoming;
+  };
+
+  [[nodiscard]] Shard &getShard(ByConstRef<n_t> SP) noexcept {
+    // Fibonacci hashing to also distribute pointers with aligned addresses
+    auto Hash = uint64_t(std::hash<n_t>{}(SP)) * 0x9E3779B97F4A7C15ULL;
+    return *Shards[(Hash >> 32) & ShardMask];
+  }
+
+  size_t ShardMask;
+  std::vector<std::unique_ptr<Shard>> Shards;
+};
+
+} // namespace psr
+
+#endif // PHASAR_DATAFLOW_IFDSIDE_SOLVER_CONCURRENTSUMMARYTABLES_H
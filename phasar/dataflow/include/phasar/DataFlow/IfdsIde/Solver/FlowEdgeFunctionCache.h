@@ -17,13 +17,16 @@
 #include "phasar/Utils/PAMMMacros.h"
 
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Hashing.h"
 
 #include <algorithm>
-#include <map>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <set>
 #include <tuple>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 
 namespace llvm {
@@ -61,6 +64,35 @@ private:
   llvm::DenseMap<KeyType, CompressedType> Map{};
 };
 
+namespace detail {
+struct FlowEdgeFunctionCacheKeyHash {
+  template <typename... Ts>
+  size_t operator()(const std::tuple<Ts...> &Key) const {
+    return std::apply(
+        [](const auto &...Vals) {
+          return size_t(llvm::hash_combine(
+              std::hash<std::decay_t<decltype(Vals)>>{}(Vals)...));
+        },
+        Key);
+  }
+};
+
+template <typename KeyT> struct IsDenseMapCacheKey : std::false_type {};
+template <typename... Ts>
+struct IsDenseMapCacheKey<std::tuple<Ts...>>
+    : std::bool_constant<(std::is_pointer_v<Ts> && ...)> {};
+
+/// The map type used by the FlowEdgeFunctionCache. Keys that entirely consist
+/// of pointers are stored in an open-addressing llvm::DenseMap; all other keys
+/// fall back to a std::unordered_map. Like in the Compressor, integers do not
+/// use the DenseMap, since its reserved empty and tombstone keys are valid
+/// facts of generic data-flow domains.
+template <typename KeyT, typename ValueT>
+using FlowEdgeFunctionCacheMap = std::conditional_t<
+    IsDenseMapCacheKey<KeyT>::value, llvm::DenseMap<KeyT, ValueT>,
+    std::unordered_map<KeyT, ValueT, FlowEdgeFunctionCacheKeyHash>>;
+} // namespace detail
+
 /**
  * This class caches flow and edge functions to avoid their reconstruction.
  * When a flow or edge function must be applied to multiple times, a cached
@@ -116,24 +148,33 @@ private:
     InnerEdgeFunctionMapType EdgeFunctionMap;
   };
 
+  // The tuple caches are keyed by the plain instructions, functions and
+  // facts. Compressing them first would cost one additional hash lookup per
+  // component.
+  using CallFFKeyType = std::tuple<n_t, f_t>;
+  using ReturnFFKeyType = std::tuple<n_t, f_t, n_t, n_t>;
+  using CallToRetFFKeyType = std::tuple<n_t, n_t>;
+  using CallEFKeyType = std::tuple<n_t, d_t, f_t, d_t>;
+  using ReturnEFKeyType = std::tuple<n_t, f_t, n_t, d_t, n_t, d_t>;
+  using SummaryEFKeyType = std::tuple<n_t, d_t, n_t, d_t>;
+
+  template <typename KeyT, typename ValueT>
+  using CacheMapType = detail::FlowEdgeFunctionCacheMap<KeyT, ValueT>;
+
   // Caches for the flow/edge functions
-  std::map<EdgeFuncInstKey, NormalEdgeFlowData> NormalFunctionCache;
+  llvm::DenseMap<EdgeFuncInstKey, NormalEdgeFlowData> NormalFunctionCache;
 
   // Caches for the flow functions
-  std::map<std::tuple<n_t, f_t>, FlowFunctionPtrType> CallFlowFunctionCache;
-  std::map<std::tuple<n_t, f_t, n_t, n_t>, FlowFunctionPtrType>
-      ReturnFlowFunctionCache;
-  std::map<std::tuple<n_t, n_t>, FlowFunctionPtrType>
+  CacheMapType<CallFFKeyType, FlowFunctionPtrType> CallFlowFunctionCache;
+  CacheMapType<ReturnFFKeyType, FlowFunctionPtrType> ReturnFlowFunctionCache;
+  CacheMapType<CallToRetFFKeyType, FlowFunctionPtrType>
       CallToRetFlowFunctionCache;
   // Caches for the edge functions
-  std::map<std::tuple<n_t, d_t, f_t, d_t>, EdgeFunction<l_t>>
-      CallEdgeFunctionCache;
-  std::map<std::tuple<n_t, f_t, n_t, d_t, n_t, d_t>, EdgeFunction<l_t>>
-      ReturnEdgeFunctionCache;
-  std::map<EdgeFuncInstKey, InnerEdgeFunctionMapType>
+  CacheMapType<CallEFKeyType, EdgeFunction<l_t>> CallEdgeFunctionCache;
+  CacheMapType<ReturnEFKeyType, EdgeFunction<l_t>> ReturnEdgeFunctionCache;
+  llvm::DenseMap<EdgeFuncInstKey, InnerEdgeFunctionMapType>
       CallToRetEdgeFunctionCache;
-  std::map<std::tuple<n_t, d_t, n_t, d_t>, EdgeFunction<l_t>>
-      SummaryEdgeFunctionCache;
+  CacheMapType<SummaryEFKeyType, EdgeFunction<l_t>> SummaryEdgeFunctionCache;
 
 public:
   // Ctor allows access to the IDEProblem in order to get access to flow and
@@ -223,7 +264,7 @@ public:
                                                << Problem.NtoString(CallSite));
                    PHASAR_LOG_LEVEL(
                        DEBUG, "(F) Dest Fun : " << Problem.FtoString(DestFun)));
-    auto Key = std::tie(CallSite, DestFun);
+    auto Key = CallFFKeyType(CallSite, DestFun);
     auto SearchCallFlowFunction = CallFlowFunctionCache.find(Key);
     if (SearchCallFlowFunction != CallFlowFunctionCache.end()) {
       PHASAR_LOG_LEVEL(DEBUG, "Flow function fetched from cache");
@@ -253,7 +294,7 @@ public:
                          "(N) Exit Stmt : " << Problem.NtoString(ExitInst));
         PHASAR_LOG_LEVEL(DEBUG,
                          "(N) Ret Site  : " << Problem.NtoString(RetSite)));
-    auto Key = std::tie(CallSite, CalleeFun, ExitInst, RetSite);
+    auto Key = ReturnFFKeyType(CallSite, CalleeFun, ExitInst, RetSite);
     auto SearchReturnFlowFunction = ReturnFlowFunctionCache.find(Key);
     if (SearchReturnFlowFunction != ReturnFlowFunctionCache.end()) {
       PHASAR_LOG_LEVEL(DEBUG, "Flow function fetched from cache");
@@ -287,7 +328,7 @@ public:
                                                           : Callees) {
           PHASAR_LOG_LEVEL(DEBUG, "  " << Problem.FtoString(callee));
         };);
-    auto Key = std::tie(CallSite, RetSite);
+    auto Key = CallToRetFFKeyType(CallSite, RetSite);
     auto SearchCallToRetFlowFunction = CallToRetFlowFunctionCache.find(Key);
     if (SearchCallToRetFlowFunction != CallToRetFlowFunctionCache.end()) {
       PHASAR_LOG_LEVEL(DEBUG, "Flow function fetched from cache");
@@ -380,7 +421,7 @@ public:
             DEBUG, "(F) Dest Fun : " << Problem.FtoString(DestinationFunction));
         PHASAR_LOG_LEVEL(DEBUG,
                          "(D) Dest Node : " << Problem.DtoString(DestNode)));
-    auto Key = std::tie(CallSite, SrcNode, DestinationFunction, DestNode);
+    auto Key = CallEFKeyType(CallSite, SrcNode, DestinationFunction, DestNode);
     auto SearchCallEdgeFunction = CallEdgeFunctionCache.find(Key);
     if (SearchCallEdgeFunction != CallEdgeFunctionCache.end()) {
       INC_COUNTER("Call-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
@@ -416,8 +457,8 @@ public:
                          "(N) Ret Site  : " << Problem.NtoString(RetSite));
         PHASAR_LOG_LEVEL(DEBUG,
                          "(D) Ret Node  : " << Problem.DtoString(RetNode)));
-    auto Key = std::tie(CallSite, CalleeFunction, ExitInst, ExitNode, RetSite,
-                        RetNode);
+    auto Key = ReturnEFKeyType(CallSite, CalleeFunction, ExitInst, ExitNode,
+                               RetSite, RetNode);
     auto SearchReturnEdgeFunction = ReturnEdgeFunctionCache.find(Key);
     if (SearchReturnEdgeFunction != ReturnEdgeFunctionCache.end()) {
       INC_COUNTER("Return-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
@@ -484,7 +525,7 @@ public:
     auto EF = Problem.getCallToRetEdgeFunction(CallSite, CallNode, RetSite,
                                                RetSiteNode, Callees);
 
-    CallToRetEdgeFunctionCache.emplace(
+    CallToRetEdgeFunctionCache.try_emplace(
         OuterMapKey,
         InnerEdgeFunctionMapType{std::make_pair(
             createEdgeFunctionNodeKey(CallNode, RetSiteNode), EF)});
@@ -507,7 +548,7 @@ public:
         PHASAR_LOG_LEVEL(DEBUG,
                          "(D) Ret Node  : " << Problem.DtoString(RetSiteNode));
         PHASAR_LOG_LEVEL(DEBUG, ' '));
-    auto Key = std::tie(CallSite, CallNode, RetSite, RetSiteNode);
+    auto Key = SummaryEFKeyType(CallSite, CallNode, RetSite, RetSiteNode);
     auto SearchSummaryEdgeFunction = SummaryEdgeFunctionCache.find(Key);
     if (SearchSummaryEdgeFunction != SummaryEdgeFunctionCache.end()) {
       INC_COUNTER("Summary-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
@@ -20,44 +20,84 @@
 #include "phasar/Config/Configuration.h"
 #include "phasar/DB/ProjectIRDBBase.h"
 #include "phasar/DataFlow/IfdsIde/EdgeFunction.h"
+#include "phasar/DataFlow/IfdsIde/EdgeFunctionMemoCache.h"
 #include "phasar/DataFlow/IfdsIde/EdgeFunctionUtils.h"
 #include "phasar/DataFlow/IfdsIde/EdgeFunctions.h"
 #include "phasar/DataFlow/IfdsIde/FlowFunctions.h"
 #include "phasar/DataFlow/IfdsIde/IDETabulationProblem.h"
 #include "phasar/DataFlow/IfdsIde/IFDSTabulationProblem.h"
 #include "phasar/DataFlow/IfdsIde/InitialSeeds.h"
+#include "phasar/DataFlow/IfdsIde/Solver/ConcurrentJumpFunctions.h"
+#include "phasar/DataFlow/IfdsIde/Solver/ConcurrentSummaryTables.h"
 #include "phasar/DataFlow/IfdsIde/Solver/FlowEdgeFunctionCache.h"
 #include "phasar/DataFlow/IfdsIde/Solver/IDESolverAPIMixin.h"
+#include "phasar/DataFlow/IfdsIde/Solver/IDEWorkList.h"
 #include "phasar/DataFlow/IfdsIde/Solver/JumpFunctions.h"
 #include "phasar/DataFlow/IfdsIde/Solver/PathEdge.h"
+#include "phasar/DataFlow/IfdsIde/Solver/SummaryProvider.h"
 #include "phasar/DataFlow/IfdsIde/SolverResults.h"
 #include "phasar/Domain/AnalysisDomain.h"
+#include "phasar/Utils/ByRef.h"
 #include "phasar/Utils/DOTGraph.h"
 #include "phasar/Utils/JoinLattice.h"
 #include "phasar/Utils/Logger.h"
 #include "phasar/Utils/PAMMMacros.h"
 #include "phasar/Utils/Table.h"
 #include "phasar/Utils/Utilities.h"
+#include "phasar/Utils/WorkStealingScheduler.h"
 
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/ScopeExit.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include "nlohmann/json.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <string>
 #include <tuple>
 #include <type_traits>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 namespace psr {
 
 /// Solves the given IDETabulationProblem as described in the 1996 paper by
 /// Sagiv, Horwitz and Reps. To solve the problem, call solve(). Results
 /// can then be queried by using resultAt() and resultsAt().
+///
+/// If IFDSIDESolverConfig::numThreads() is greater than one and the problem
+/// opts in via IDETabulationProblem::supportsParallelSolving(), Phase I is
+/// computed by a pool of work-stealing worker threads. The computed results
+/// are the same as for the sequential solver. This requires the flow- and
+/// edge-function factories of the problem as well as the analysis-specific
+/// helpers that they use (e.g., alias information or edge-function caches) to
+/// be thread-safe. Lazily computed alias information should be precomputed
+/// before solving, e.g., using LLVMAliasSet::computeAllAliasSets().
+///
+/// The first call to next() computes the whole parallel Phase I. Only
+/// solveWithAsyncCancellation() and continueWithAsyncCancellation() can
+/// interrupt it: the workers stop as soon as the flag is set and a
+/// subsequent continuation solves the remaining work sequentially. The
+/// predicates of solveUntil() and solveWithTimeout() are only checked after
+/// the parallel Phase I has completed. Recording the path edges
+/// (IFDSIDESolverConfig::recordEdges()) and emitting the exploded super-graph
+/// are not supported by the parallel Phase I; the solver falls back to the
+/// sequential algorithm in these cases.
+///
+/// With more than one thread, the values at the non-call, non-start nodes
+/// (Phase II(ii)) are computed in parallel as well. This requires the
+/// lattice operations of the problem and computeTarget() of its edge
+/// functions to be thread-safe.
 template <typename AnalysisDomainTy,
           typename Container = std::set<typename AnalysisDomainTy::d_t>>
 class IDESolver
@@ -77,11 +117,17 @@ public:
   using t_t = typename AnalysisDomainTy::t_t;
   using v_t = typename AnalysisDomainTy::v_t;
 
+  /// Receives the targets of a single flow-function application. The
+  /// process* functions keep these on the stack of the calling worker, such
+  /// that drawing the edges of a small fan-out does not allocate.
+  using flow_targets_t = llvm::SmallVector<d_t, 8>;
+
   IDESolver(IDETabulationProblem<AnalysisDomainTy, Container> &Problem,
             const i_t *ICF)
       : IDEProblem(Problem), ZeroValue(Problem.getZeroValue()), ICF(ICF),
         SolverConfig(Problem.getIFDSIDESolverConfig()),
-        CachedFlowEdgeFunctions(Problem), AllTop(Problem.allTopFunction()),
+        WorkList(ICF), CachedFlowEdgeFunctions(Problem),
+        AllTop(Problem.allTopFunction()),
         JumpFn(std::make_shared<JumpFunctions<AnalysisDomainTy, Container>>(
             IDEProblem)),
         Seeds(Problem.initialSeeds()) {
@@ -261,6 +307,52 @@ public:
                                               std::move(ZeroValue));
   }
 
+  /// Converts the computed solver-results into a compact, immutable
+  /// FrozenSolverResults and releases the solver's result table together with
+  /// the jump functions and summaries of Phase I.
+  /// Do not call any function (including getSolverResults()) on this IDESolver
+  /// instance after that.
+  [[nodiscard]] FrozenSolverResults<n_t, d_t, l_t> freezeSolverResults() {
+    FrozenSolverResults<n_t, d_t, l_t> Frozen(ValTab, ZeroValue);
+    ValTab = {};
+    JumpFn = std::make_shared<JumpFunctions<AnalysisDomainTy, Container>>(
+        IDEProblem);
+    EndsummaryTab = {};
+    IncomingTab = {};
+    IntermediateEdgeFunctions.clear();
+    FSummaryReuse.clear();
+    return Frozen;
+  }
+
+  /// Returns the jump functions that have been computed in Phase I.
+  [[nodiscard]] const JumpFunctions<AnalysisDomainTy, Container> &
+  getJumpFunctions() const noexcept {
+    return *JumpFn;
+  }
+
+  /// Lets the solver reuse the jump functions that Provider knows instead of
+  /// analyzing the respective functions again; see SummaryProvider. Must be
+  /// called before solving. The Provider must outlive the solving.
+  ///
+  /// Provided summaries are only used by the sequential Phase I and are
+  /// ignored if IFDSIDESolverConfig::followReturnsPastSeeds() is set. The path
+  /// edges inside provided summaries are not recorded.
+  void setSummaryProvider(SummaryProvider<AnalysisDomainTy> *Provider) noexcept {
+    SummaryProv = Provider;
+  }
+
+  /// Returns how many compositions and joins of edge functions have been
+  /// answered by the memo cache; see
+  /// IFDSIDESolverConfig::edgeFunctionMemoCacheSize(). Returns std::nullopt
+  /// if the memo cache is disabled.
+  [[nodiscard]] std::optional<EdgeFunctionMemoStats>
+  getEdgeFunctionMemoStats() const {
+    if (!EFMemo) {
+      return std::nullopt;
+    }
+    return EFMemo->getStats();
+  }
+
 protected:
   /// Lines 13-20 of the algorithm; processing a call site in the caller's
   /// context.
@@ -302,17 +394,19 @@ protected:
           PHASAR_LOG_LEVEL(DEBUG, "  " << IDEProblem.NtoString(ret));
         });
 
+    flow_targets_t Res;
+    flow_targets_t ReturnedFacts;
     // for each possible callee
     for (f_t SCalledProcN : Callees) { // still line 14
       // check if a special summary for the called procedure exists
       FlowFunctionPtrType SpecialSum =
-          CachedFlowEdgeFunctions.getSummaryFlowFunction(n, SCalledProcN);
+          cachedFlowEdgeFunctions().getSummaryFlowFunction(n, SCalledProcN);
       // if a special summary is available, treat this as a normal flow
       // and use the summary flow and edge functions
       if (SpecialSum) {
         PHASAR_LOG_LEVEL(DEBUG, "Found and process special summary");
         for (n_t ReturnSiteN : ReturnSiteNs) {
-          container_type Res = computeSummaryFlowFunction(SpecialSum, d1, d2);
+          computeSummaryFlowFunction(SpecialSum, d1, d2, Res);
           INC_COUNTER("SpecialSummary-FF Application", 1,
                       PAMM_SEVERITY_LEVEL::Full);
           ADD_TO_HISTOGRAM("Data-flow facts", res.size(), 1,
@@ -320,8 +414,8 @@ protected:
           saveEdges(n, ReturnSiteN, d2, Res, false);
           for (d_t d3 : Res) {
             EdgeFunction<l_t> SumEdgFnE =
-                CachedFlowEdgeFunctions.getSummaryEdgeFunction(n, d2,
-                                                               ReturnSiteN, d3);
+                cachedFlowEdgeFunctions().getSummaryEdgeFunction(
+                    n, d2, ReturnSiteN, d3);
             INC_COUNTER("SpecialSummary-EF Queries", 1,
                         PAMM_SEVERITY_LEVEL::Full);
             IF_LOG_ENABLED(
@@ -329,16 +423,16 @@ protected:
                     DEBUG, "Queried Summary Edge Function: " << SumEdgFnE);
                 PHASAR_LOG_LEVEL(DEBUG, "Compose: " << SumEdgFnE << " * " << f
                                                     << '\n'));
-            WorkList.emplace_back(PathEdge(d1, ReturnSiteN, std::move(d3)),
-                                  f.composeWith(SumEdgFnE));
+            addWorkListItem(PathEdge(d1, ReturnSiteN, std::move(d3)),
+                            composeEFs(f, SumEdgFnE));
           }
         }
       } else {
         // compute the call-flow function
         FlowFunctionPtrType Function =
-            CachedFlowEdgeFunctions.getCallFlowFunction(n, SCalledProcN);
+            cachedFlowEdgeFunctions().getCallFlowFunction(n, SCalledProcN);
         INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-        container_type Res = computeCallFlowFunction(Function, d1, d2);
+        computeCallFlowFunction(Function, d1, d2, Res);
         ADD_TO_HISTOGRAM("Data-flow facts", res.size(), 1,
                          PAMM_SEVERITY_LEVEL::Full);
         // for each callee's start point(s)
@@ -357,11 +451,10 @@ protected:
             // create initial self-loop
             PHASAR_LOG_LEVEL(DEBUG, "Create initial self-loop with D: "
                                         << IDEProblem.DtoString(d3));
-            WorkList.emplace_back(PathEdge(d3, SP, d3),
-                                  EdgeIdentity<l_t>{}); // line 15
+            addWorkListItem(PathEdge(d3, SP, d3),
+                            EdgeIdentity<l_t>{}); // line 15
             //  register the fact that <sp,d3> has an incoming edge from <n,d2>
             //  line 15.1 of Naeem/Lhotak/Rodriguez
-            addIncoming(SP, d3, n, d2);
             // line 15.2, copy to avoid concurrent modification exceptions by
             // other threads
             // const std::set<TableCell> endSumm(endSummary(sP, d3));
@@ -376,7 +469,8 @@ protected:
             // <sP,d3>, create new caller-side jump functions to the return
             // sites because we have observed a potentially new incoming
             // edge into <sP,d3>
-            for (const TableCell &Entry : endSummary(SP, d3)) {
+            for (const TableCell &Entry :
+                 addIncomingAndGetEndSummaries(SP, d3, n, d2)) {
               n_t eP = Entry.getRowKey();
               d_t d4 = Entry.getColumnKey();
               EdgeFunction<l_t> fCalleeSummary = Entry.getValue();
@@ -384,11 +478,11 @@ protected:
               for (n_t RetSiteN : ReturnSiteNs) {
                 // compute return-flow function
                 FlowFunctionPtrType RetFunction =
-                    CachedFlowEdgeFunctions.getRetFlowFunction(n, SCalledProcN,
-                                                               eP, RetSiteN);
+                    cachedFlowEdgeFunctions().getRetFlowFunction(
+                        n, SCalledProcN, eP, RetSiteN);
                 INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-                const container_type ReturnedFacts = computeReturnFlowFunction(
-                    RetFunction, d3, d4, n, Container{d2});
+                computeReturnFlowFunction(RetFunction, d3, d4, n,
+                                          ReturnedFacts);
                 ADD_TO_HISTOGRAM("Data-flow facts", returnedFacts.size(), 1,
                                  PAMM_SEVERITY_LEVEL::Full);
                 saveEdges(eP, RetSiteN, d4, ReturnedFacts, true);
@@ -397,12 +491,12 @@ protected:
                   // update the caller-side summary function
                   // get call edge function
                   EdgeFunction<l_t> f4 =
-                      CachedFlowEdgeFunctions.getCallEdgeFunction(
+                      cachedFlowEdgeFunctions().getCallEdgeFunction(
                           n, d2, SCalledProcN, d3);
                   PHASAR_LOG_LEVEL(DEBUG, "Queried Call Edge Function: " << f4);
                   // get return edge function
                   EdgeFunction<l_t> f5 =
-                      CachedFlowEdgeFunctions.getReturnEdgeFunction(
+                      cachedFlowEdgeFunctions().getReturnEdgeFunction(
                           n, SCalledProcN, eP, d4, RetSiteN, d5);
                   PHASAR_LOG_LEVEL(DEBUG,
                                    "Queried Return Edge Function: " << f5);
@@ -423,14 +517,14 @@ protected:
                   PHASAR_LOG_LEVEL(DEBUG,
                                    "         (return * calleeSummary * call)");
                   EdgeFunction<l_t> fPrime =
-                      f4.composeWith(fCalleeSummary).composeWith(f5);
+                      composeEFs(composeEFs(f4, fCalleeSummary), f5);
                   PHASAR_LOG_LEVEL(DEBUG, "       = " << fPrime);
                   d_t d5_restoredCtx = restoreContextOnReturnedFact(n, d2, d5);
                   // propagte the effects of the entire call
                   PHASAR_LOG_LEVEL(DEBUG, "Compose: " << fPrime << " * " << f);
-                  WorkList.emplace_back(
+                  addWorkListItem(
                       PathEdge(d1, RetSiteN, std::move(d5_restoredCtx)),
-                      f.composeWith(fPrime));
+                      composeEFs(f, fPrime));
                 }
               }
             }
@@ -442,18 +536,17 @@ protected:
     // process intra-procedural flows along call-to-return flow functions
     for (n_t ReturnSiteN : ReturnSiteNs) {
       FlowFunctionPtrType CallToReturnFF =
-          CachedFlowEdgeFunctions.getCallToRetFlowFunction(n, ReturnSiteN,
-                                                           Callees);
+          cachedFlowEdgeFunctions().getCallToRetFlowFunction(n, ReturnSiteN,
+                                                             Callees);
       INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-      container_type ReturnFacts =
-          computeCallToReturnFlowFunction(CallToReturnFF, d1, d2);
-      ADD_TO_HISTOGRAM("Data-flow facts", returnFacts.size(), 1,
+      computeCallToReturnFlowFunction(CallToReturnFF, d1, d2, Res);
+      ADD_TO_HISTOGRAM("Data-flow facts", res.size(), 1,
                        PAMM_SEVERITY_LEVEL::Full);
-      saveEdges(n, ReturnSiteN, d2, ReturnFacts, false);
-      for (d_t d3 : ReturnFacts) {
+      saveEdges(n, ReturnSiteN, d2, Res, false);
+      for (d_t d3 : Res) {
         EdgeFunction<l_t> EdgeFnE =
-            CachedFlowEdgeFunctions.getCallToRetEdgeFunction(n, d2, ReturnSiteN,
-                                                             d3, Callees);
+            cachedFlowEdgeFunctions().getCallToRetEdgeFunction(
+                n, d2, ReturnSiteN, d3, Callees);
         PHASAR_LOG_LEVEL(DEBUG,
                          "Queried Call-to-Return Edge Function: " << EdgeFnE);
         if (SolverConfig.emitESG()) {
@@ -461,11 +554,11 @@ protected:
               .push_back(EdgeFnE);
         }
         INC_COUNTER("EF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-        auto fPrime = f.composeWith(EdgeFnE);
+        auto fPrime = composeEFs(f, EdgeFnE);
         PHASAR_LOG_LEVEL(DEBUG, "Compose: " << EdgeFnE << " * " << f << " = "
                                             << fPrime);
-        WorkList.emplace_back(PathEdge(d1, ReturnSiteN, std::move(d3)),
-                              std::move(fPrime));
+        addWorkListItem(PathEdge(d1, ReturnSiteN, std::move(d3)),
+                        std::move(fPrime));
       }
     }
   }
@@ -482,19 +575,20 @@ protected:
     EdgeFunction<l_t> f = jumpFunction(Edge);
     auto [d1, n, d2] = Edge.consume();
 
+    flow_targets_t Res;
     for (const auto nPrime : ICF->getSuccsOf(n)) {
       FlowFunctionPtrType FlowFunc =
-          CachedFlowEdgeFunctions.getNormalFlowFunction(n, nPrime);
+          cachedFlowEdgeFunctions().getNormalFlowFunction(n, nPrime);
       INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-      const container_type Res = computeNormalFlowFunction(FlowFunc, d1, d2);
+      computeNormalFlowFunction(FlowFunc, d1, d2, Res);
       ADD_TO_HISTOGRAM("Data-flow facts", res.size(), 1,
                        PAMM_SEVERITY_LEVEL::Full);
       saveEdges(n, nPrime, d2, Res, false);
       for (d_t d3 : Res) {
         EdgeFunction<l_t> g =
-            CachedFlowEdgeFunctions.getNormalEdgeFunction(n, d2, nPrime, d3);
+            cachedFlowEdgeFunctions().getNormalEdgeFunction(n, d2, nPrime, d3);
         PHASAR_LOG_LEVEL(DEBUG, "Queried Normal Edge Function: " << g);
-        EdgeFunction<l_t> fPrime = f.composeWith(g);
+        EdgeFunction<l_t> fPrime = composeEFs(f, g);
         if (SolverConfig.emitESG()) {
           IntermediateEdgeFunctions[std::make_tuple(n, d2, nPrime, d3)]
               .push_back(g);
@@ -502,8 +596,8 @@ protected:
         PHASAR_LOG_LEVEL(DEBUG,
                          "Compose: " << g << " * " << f << " = " << fPrime);
         INC_COUNTER("EF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-        WorkList.emplace_back(PathEdge(d1, nPrime, std::move(d3)),
-                              std::move(fPrime));
+        addWorkListItem(PathEdge(d1, nPrime, std::move(d3)),
+                        std::move(fPrime));
       }
     }
   }
@@ -513,32 +607,30 @@ protected:
     d_t Fact = NAndD.second;
     f_t Func = ICF->getFunctionOf(Stmt);
     for (const n_t CallSite : ICF->getCallsFromWithin(Func)) {
-      auto LookupResults = JumpFn->forwardLookup(Fact, CallSite);
-      if (!LookupResults) {
-        continue;
-      }
-      for (size_t I = 0; I < LookupResults->get().size(); ++I) {
-        auto Entry = LookupResults->get()[I];
-        d_t dPrime = Entry.first;
-        auto fPrime = Entry.second;
-        n_t SP = Stmt;
-        l_t Val = val(SP, Fact);
-        INC_COUNTER("Value Propagation", 1, PAMM_SEVERITY_LEVEL::Full);
-        propagateValue(CallSite, dPrime, fPrime.computeTarget(Val));
-      }
+      JumpFn->forwardLookup(
+          Fact, CallSite, [&](d_t dPrime, EdgeFunction<l_t> fPrime) {
+            n_t SP = Stmt;
+            l_t Val = val(SP, Fact);
+            INC_COUNTER("Value Propagation", 1, PAMM_SEVERITY_LEVEL::Full);
+            propagateValue(CallSite, dPrime, fPrime.computeTarget(Val));
+          });
     }
   }
 
   void propagateValueAtCall(const std::pair<n_t, d_t> NAndD, n_t Stmt) {
     PAMM_GET_INSTANCE;
     d_t Fact = NAndD.second;
+    flow_targets_t Targets;
     for (const f_t Callee : ICF->getCalleesOfCallAt(Stmt)) {
       FlowFunctionPtrType CallFlowFunction =
-          CachedFlowEdgeFunctions.getCallFlowFunction(Stmt, Callee);
+          cachedFlowEdgeFunctions().getCallFlowFunction(Stmt, Callee);
       INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-      for (const d_t dPrime : CallFlowFunction->computeTargets(Fact)) {
-        EdgeFunction<l_t> EdgeFn = CachedFlowEdgeFunctions.getCallEdgeFunction(
-            Stmt, Fact, Callee, dPrime);
+      Targets.clear();
+      CallFlowFunction->computeTargetsInto(Fact, Targets);
+      for (const d_t dPrime : Targets) {
+        EdgeFunction<l_t> EdgeFn =
+            cachedFlowEdgeFunctions().getCallEdgeFunction(Stmt, Fact, Callee,
+                                                          dPrime);
         PHASAR_LOG_LEVEL(DEBUG, "Queried Call Edge Function: " << EdgeFn);
         if (SolverConfig.emitESG()) {
           for (const auto SP : ICF->getStartPointsOf(Callee)) {
@@ -565,9 +657,12 @@ protected:
     }
   }
 
-  l_t val(n_t NHashN, d_t NHashD) {
-    if (ValTab.contains(NHashN, NHashD)) {
-      return ValTab.get(NHashN, NHashD);
+  /// Only uses the const interface of ValTab, so the parallel Phase II(ii)
+  /// may call this concurrently as long as nobody writes to ValTab.
+  [[nodiscard]] l_t val(ByConstRef<n_t> NHashN, ByConstRef<d_t> NHashD) const {
+    const auto &ConstValTab = ValTab;
+    if (ConstValTab.contains(NHashN, NHashD)) {
+      return ConstValTab.get(NHashN, NHashD);
     }
     // implicitly initialized to top; see line [1] of Fig. 7 in SRH96 paper
     return IDEProblem.topElement();
@@ -601,22 +696,18 @@ protected:
         PHASAR_LOG_LEVEL(DEBUG, "   Target D: " << IDEProblem.DtoString(
                                     Edge.factAtTarget())));
 
-    auto FwdLookupRes =
-        JumpFn->forwardLookup(Edge.factAtSource(), Edge.getTarget());
-    if (FwdLookupRes) {
-      auto &Ref = FwdLookupRes->get();
-      if (auto Find = std::find_if(Ref.begin(), Ref.end(),
-                                   [Edge](const auto &Pair) {
-                                     return Edge.factAtTarget() == Pair.first;
-                                   });
-          Find != Ref.end()) {
-        PHASAR_LOG_LEVEL(DEBUG, "  => EdgeFn: " << Find->second);
-        return Find->second;
-      }
+    if (ConcurrentJumpFn) {
+      auto EF = ConcurrentJumpFn->lookup(Edge.factAtSource(), Edge.getTarget(),
+                                         Edge.factAtTarget(), AllTop);
+      PHASAR_LOG_LEVEL(DEBUG, "  => EdgeFn: " << EF);
+      return EF;
     }
-    PHASAR_LOG_LEVEL(DEBUG, "  => EdgeFn: " << AllTop);
+
     // JumpFn initialized to all-top, see line [2] in SRH96 paper
-    return AllTop;
+    auto EF = JumpFn->lookup(Edge.factAtSource(), Edge.getTarget(),
+                             Edge.factAtTarget(), AllTop);
+    PHASAR_LOG_LEVEL(DEBUG, "  => EdgeFn: " << EF);
+    return EF;
   }
 
   void addEndSummary(n_t SP, d_t d1, n_t eP, d_t d2, EdgeFunction<l_t> f) {
@@ -684,26 +775,20 @@ protected:
     PAMM_GET_INSTANCE;
     for (n_t n : Values) {
       for (n_t SP : ICF->getStartPointsOf(ICF->getFunctionOf(n))) {
-        using TableCell = typename Table<d_t, d_t, EdgeFunction<l_t>>::Cell;
-        Table<d_t, d_t, EdgeFunction<l_t>> &LookupByTarget =
-            JumpFn->lookupByTarget(n);
-        for (const TableCell &SourceValTargetValAndFunction :
-             LookupByTarget.cellSet()) {
-          d_t dPrime = SourceValTargetValAndFunction.getRowKey();
-          d_t d = SourceValTargetValAndFunction.getColumnKey();
-          EdgeFunction<l_t> fPrime = SourceValTargetValAndFunction.getValue();
+        JumpFn->lookupByTarget(n, [&](d_t dPrime, d_t d,
+                                      const EdgeFunction<l_t> &fPrime) {
           l_t TargetVal = val(SP, dPrime);
           setVal(n, d,
                  IDEProblem.join(val(n, d),
                                  fPrime.computeTarget(std::move(TargetVal))));
           INC_COUNTER("Value Computation", 1, PAMM_SEVERITY_LEVEL::Full);
-        }
+        });
       }
     }
   }
 
   virtual void saveEdges(n_t SourceNode, n_t SinkStmt, d_t SourceVal,
-                         const container_type &DestVals, bool InterP) {
+                         llvm::ArrayRef<d_t> DestVals, bool InterP) {
     if (!SolverConfig.recordEdges()) {
       return;
     }
@@ -713,6 +798,17 @@ protected:
                                                        DestVals.end());
   }
 
+  /// Kept for one release; see BreakingChanges.md. It is final, such that
+  /// derived solvers that still override this signature fail to compile
+  /// instead of being silently ignored.
+  [[deprecated("saveEdges() now takes the DestVals as llvm::ArrayRef<d_t>")]]
+  virtual void saveEdges(n_t SourceNode, n_t SinkStmt, d_t SourceVal,
+                         const container_type &DestVals, bool InterP) final {
+    llvm::SmallVector<d_t> Dest(DestVals.begin(), DestVals.end());
+    saveEdges(std::move(SourceNode), std::move(SinkStmt), std::move(SourceVal),
+              Dest, InterP);
+  }
+
   void submitInitialValues() {
     std::map<n_t, std::map<d_t, l_t>> AllSeeds = Seeds.getSeeds();
     for (n_t UnbalancedRetSite : UnbalancedRetSites) {
@@ -752,7 +848,96 @@ protected:
     // we create an array of all nodes and then dispatch fractions of this
     // array to multiple threads
     const auto AllNonCallStartNodes = ICF->allNonCallStartNodes();
-    valueComputationTask(AllNonCallStartNodes);
+    auto NumPhaseIIWorkers = getNumPhaseIIWorkers(AllNonCallStartNodes.size());
+    if (NumPhaseIIWorkers > 1) {
+      computeValuesInParallel(AllNonCallStartNodes, NumPhaseIIWorkers);
+    } else {
+      valueComputationTask(AllNonCallStartNodes);
+    }
+  }
+
+  [[nodiscard]] unsigned getNumPhaseIIWorkers(size_t NumNodes) const {
+    if (SolverConfig.numThreads() <= 1 ||
+        !IDEProblem.supportsParallelSolving()) {
+      return 1;
+    }
+    auto NumChunks = (NumNodes + ValueComputationChunkSize - 1) /
+                     ValueComputationChunkSize;
+    return unsigned(std::min(size_t(SolverConfig.numThreads()), NumChunks));
+  }
+
+  /// Joins the values at node n into Row, which holds the values of the facts
+  /// at n that have been computed so far. Only reads from ValTab. Returns the
+  /// number of applied jump functions.
+  size_t computeValuesAt(n_t n, std::unordered_map<d_t, l_t> &Row) {
+    size_t NumComputations = 0;
+    for (n_t SP : ICF->getStartPointsOf(ICF->getFunctionOf(n))) {
+      JumpFn->lookupByTarget(
+          n, [&](d_t dPrime, d_t d, const EdgeFunction<l_t> &fPrime) {
+            auto It = Row.find(d);
+            if (It == Row.end()) {
+              It = Row.emplace(d, val(n, d)).first;
+            }
+            It->second =
+                IDEProblem.join(std::move(It->second),
+                                fPrime.computeTarget(val(SP, dPrime)));
+            ++NumComputations;
+          });
+    }
+    return NumComputations;
+  }
+
+  /// Computes Phase II(ii) on NumWorkers threads.
+  ///
+  /// The values at a node only depend on the values at the start points of
+  /// its function, which are final after Phase II(i). So, the nodes are
+  /// processed independently in chunks, each writing into its own slots of a
+  /// dense store that is indexed by the node's position in Nodes. ValTab is
+  /// only read while the workers run; the rows are moved into it afterwards.
+  void computeValuesInParallel(const std::vector<n_t> &Nodes,
+                               unsigned NumWorkers) {
+    PAMM_GET_INSTANCE;
+    START_TIMER("DFA Phase II (parallel)", PAMM_SEVERITY_LEVEL::Core);
+    PHASAR_LOG_LEVEL(INFO, "Compute values of Phase II with " << NumWorkers
+                                                              << " threads");
+
+    std::vector<std::unordered_map<d_t, l_t>> Rows(Nodes.size());
+    std::atomic_size_t NumComputations{0};
+
+    WorkStealingScheduler<std::pair<size_t, size_t>> ChunkScheduler(
+        NumWorkers);
+    for (size_t Begin = 0; Begin < Nodes.size();
+         Begin += ValueComputationChunkSize) {
+      ChunkScheduler.push(
+          {Begin, std::min(Nodes.size(), Begin + ValueComputationChunkSize)});
+    }
+    ChunkScheduler.run([&](std::pair<size_t, size_t> Chunk) {
+      size_t LocalComputations = 0;
+      for (size_t Idx = Chunk.first; Idx != Chunk.second; ++Idx) {
+        LocalComputations += computeValuesAt(Nodes[Idx], Rows[Idx]);
+      }
+      NumComputations.fetch_add(LocalComputations, std::memory_order_relaxed);
+    });
+
+    ValTab.reserve(ValTab.size() + Nodes.size());
+    for (size_t Idx = 0, End = Nodes.size(); Idx != End; ++Idx) {
+      if (Rows[Idx].empty()) {
+        continue;
+      }
+      // The row is only non-empty if there are initial seeds at this node
+      auto &Row = ValTab.row(Nodes[Idx]);
+      if (Row.empty()) {
+        Row = std::move(Rows[Idx]);
+        continue;
+      }
+      for (auto &[Fact, Value] : Rows[Idx]) {
+        Row.insert_or_assign(Fact, std::move(Value));
+      }
+    }
+
+    INC_COUNTER("Value Computation", NumComputations.load(),
+                PAMM_SEVERITY_LEVEL::Full);
+    STOP_TIMER("DFA Phase II (parallel)", PAMM_SEVERITY_LEVEL::Core);
   }
 
   /// Schedules the processing of initial seeds, initiating the analysis.
@@ -795,8 +980,7 @@ protected:
         if (!IDEProblem.isZeroValue(Fact)) {
           INC_COUNTER("Gen facts", 1, PAMM_SEVERITY_LEVEL::Core);
         }
-        WorkList.emplace_back(PathEdge(Fact, StartPoint, Fact),
-                              EdgeIdentity<l_t>{});
+        addWorkListItem(PathEdge(Fact, StartPoint, Fact), EdgeIdentity<l_t>{});
       }
     }
   }
@@ -825,11 +1009,11 @@ protected:
     for (n_t SP : StartPointsOf) {
       // line 21.1 of Naeem/Lhotak/Rodriguez
       // register end-summary
-      addEndSummary(SP, d1, n, d2, f);
-      for (const auto &Entry : incoming(d1, SP)) {
-        Inc[Entry.first] = Container{Entry.second};
+      for (auto &Entry : addEndSummaryAndGetIncoming(SP, d1, n, d2, f)) {
+        Inc[Entry.first] = std::move(Entry.second);
       }
     }
+    flow_targets_t Targets;
     printEndSummaryTab();
     printIncomingTab();
     // for each incoming call edge already processed
@@ -841,27 +1025,29 @@ protected:
       for (n_t RetSiteC : ICF->getReturnSitesOfCallAt(c)) {
         // compute return-flow function
         FlowFunctionPtrType RetFunction =
-            CachedFlowEdgeFunctions.getRetFlowFunction(
+            cachedFlowEdgeFunctions().getRetFlowFunction(
                 c, FunctionThatNeedsSummary, n, RetSiteC);
         INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
+        // The return flow does not depend on the incoming-call value, so
+        // compute it only once
+        computeReturnFlowFunction(RetFunction, d1, d2, c, Targets);
+        ADD_TO_HISTOGRAM("Data-flow facts", targets.size(), 1,
+                         PAMM_SEVERITY_LEVEL::Full);
+        saveEdges(n, RetSiteC, d2, Targets, true);
         // for each incoming-call value
         for (d_t d4 : Entry.second) {
-          const container_type Targets =
-              computeReturnFlowFunction(RetFunction, d1, d2, c, Entry.second);
-          ADD_TO_HISTOGRAM("Data-flow facts", targets.size(), 1,
-                           PAMM_SEVERITY_LEVEL::Full);
-          saveEdges(n, RetSiteC, d2, Targets, true);
           // for each target value at the return site
           // line 23
           for (d_t d5 : Targets) {
             // compute composed function
             // get call edge function
-            EdgeFunction<l_t> f4 = CachedFlowEdgeFunctions.getCallEdgeFunction(
-                c, d4, ICF->getFunctionOf(n), d1);
+            EdgeFunction<l_t> f4 =
+                cachedFlowEdgeFunctions().getCallEdgeFunction(
+                    c, d4, ICF->getFunctionOf(n), d1);
             PHASAR_LOG_LEVEL(DEBUG, "Queried Call Edge Function: " << f4);
             // get return edge function
             EdgeFunction<l_t> f5 =
-                CachedFlowEdgeFunctions.getReturnEdgeFunction(
+                cachedFlowEdgeFunctions().getReturnEdgeFunction(
                     c, ICF->getFunctionOf(n), n, d2, RetSiteC, d5);
             PHASAR_LOG_LEVEL(DEBUG, "Queried Return Edge Function: " << f5);
             if (SolverConfig.emitESG()) {
@@ -877,25 +1063,19 @@ protected:
             PHASAR_LOG_LEVEL(DEBUG,
                              "Compose: " << f5 << " * " << f << " * " << f4);
             PHASAR_LOG_LEVEL(DEBUG, "         (return * function * call)");
-            EdgeFunction<l_t> fPrime = f4.composeWith(f).composeWith(f5);
+            EdgeFunction<l_t> fPrime = composeEFs(composeEFs(f4, f), f5);
             PHASAR_LOG_LEVEL(DEBUG, "       = " << fPrime);
             // for each jump function coming into the call, propagate to
             // return site using the composed function
-            auto RevLookupResult = JumpFn->reverseLookup(c, d4);
-            if (RevLookupResult) {
-              for (size_t I = 0; I < RevLookupResult->get().size(); ++I) {
-                auto ValAndFunc = RevLookupResult->get()[I];
-                EdgeFunction<l_t> f3 = ValAndFunc.second;
-                if (f3 != AllTop) {
-                  d_t d3 = ValAndFunc.first;
-                  d_t d5_restoredCtx = restoreContextOnReturnedFact(c, d4, d5);
-                  PHASAR_LOG_LEVEL(DEBUG, "Compose: " << fPrime << " * " << f3);
-                  WorkList.emplace_back(PathEdge(std::move(d3), RetSiteC,
-                                                 std::move(d5_restoredCtx)),
-                                        f3.composeWith(fPrime));
-                }
+            foreachJumpFunctionInto(c, d4, [&](d_t d3, EdgeFunction<l_t> f3) {
+              if (f3 != AllTop) {
+                d_t d5_restoredCtx = restoreContextOnReturnedFact(c, d4, d5);
+                PHASAR_LOG_LEVEL(DEBUG, "Compose: " << fPrime << " * " << f3);
+                addWorkListItem(PathEdge(std::move(d3), RetSiteC,
+                                         std::move(d5_restoredCtx)),
+                                composeEFs(f3, fPrime));
               }
-            }
+            });
           }
         }
       }
@@ -912,17 +1092,16 @@ protected:
       for (n_t Caller : Callers) {
         for (n_t RetSiteC : ICF->getReturnSitesOfCallAt(Caller)) {
           FlowFunctionPtrType RetFunction =
-              CachedFlowEdgeFunctions.getRetFlowFunction(
+              cachedFlowEdgeFunctions().getRetFlowFunction(
                   Caller, FunctionThatNeedsSummary, n, RetSiteC);
           INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-          const container_type Targets = computeReturnFlowFunction(
-              RetFunction, d1, d2, Caller, Container{ZeroValue});
+          computeReturnFlowFunction(RetFunction, d1, d2, Caller, Targets);
           ADD_TO_HISTOGRAM("Data-flow facts", targets.size(), 1,
                            PAMM_SEVERITY_LEVEL::Full);
           saveEdges(n, RetSiteC, d2, Targets, true);
           for (d_t d5 : Targets) {
             EdgeFunction<l_t> f5 =
-                CachedFlowEdgeFunctions.getReturnEdgeFunction(
+                cachedFlowEdgeFunctions().getReturnEdgeFunction(
                     Caller, ICF->getFunctionOf(n), n, d2, RetSiteC, d5);
             PHASAR_LOG_LEVEL(DEBUG, "Queried Return Edge Function: " << f5);
             if (SolverConfig.emitESG()) {
@@ -931,9 +1110,10 @@ protected:
             }
             INC_COUNTER("EF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
             PHASAR_LOG_LEVEL(DEBUG, "Compose: " << f5 << " * " << f);
-            propagteUnbalancedReturnFlow(RetSiteC, d5, f.composeWith(f5),
+            propagteUnbalancedReturnFlow(RetSiteC, d5, composeEFs(f, f5),
                                          Caller);
             // register for value processing (2nd IDE phase)
+            std::lock_guard Lock(SolverStateMtx);
             UnbalancedRetSites.insert(RetSiteC);
           }
         }
@@ -944,7 +1124,7 @@ protected:
       // instead we thus call the return flow function will a null caller
       if (Callers.empty()) {
         FlowFunctionPtrType RetFunction =
-            CachedFlowEdgeFunctions.getRetFlowFunction(
+            cachedFlowEdgeFunctions().getRetFlowFunction(
                 nullptr, FunctionThatNeedsSummary, n, nullptr);
         INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
         RetFunction->computeTargets(d2);
@@ -955,7 +1135,7 @@ protected:
   void propagteUnbalancedReturnFlow(n_t RetSiteC, d_t TargetVal,
                                     EdgeFunction<l_t> EdgeFunc,
                                     n_t /*RelatedCallSite*/) {
-    WorkList.emplace_back(
+    addWorkListItem(
         PathEdge(ZeroValue, std::move(RetSiteC), std::move(TargetVal)),
         std::move(EdgeFunc));
   }
@@ -989,29 +1169,35 @@ protected:
   /// @param flowFunction The normal flow function to compute
   /// @param d1 The abstraction at the method's start node
   /// @param d2 The abstraction at the current node
-  /// @return The set of abstractions at the successor node
+  /// @param Targets Receives the set of abstractions at the successor node
   ///
-  container_type computeNormalFlowFunction(const FlowFunctionPtrType &FlowFunc,
-                                           d_t /*d1*/, d_t d2) {
-    return FlowFunc->computeTargets(d2);
+  void computeNormalFlowFunction(const FlowFunctionPtrType &FlowFunc,
+                                 d_t /*d1*/, d_t d2,
+                                 llvm::SmallVectorImpl<d_t> &Targets) {
+    Targets.clear();
+    FlowFunc->computeTargetsInto(std::move(d2), Targets);
   }
 
-  container_type
+  void
   computeSummaryFlowFunction(const FlowFunctionPtrType &SummaryFlowFunction,
-                             d_t /*d1*/, d_t d2) {
-    return SummaryFlowFunction->computeTargets(d2);
+                             d_t /*d1*/, d_t d2,
+                             llvm::SmallVectorImpl<d_t> &Targets) {
+    Targets.clear();
+    SummaryFlowFunction->computeTargetsInto(std::move(d2), Targets);
   }
 
   /// Computes the call flow function for the given call-site abstraction
   /// @param callFlowFunction The call flow function to compute
   /// @param d1 The abstraction at the current method's start node.
   /// @param d2 The abstraction at the call site
-  /// @return The set of caller-side abstractions at the callee's start node
+  /// @param Targets Receives the set of caller-side abstractions at the
+  /// callee's start node
   ///
-  container_type
-  computeCallFlowFunction(const FlowFunctionPtrType &CallFlowFunction,
-                          d_t /*d1*/, d_t d2) {
-    return CallFlowFunction->computeTargets(d2);
+  void computeCallFlowFunction(const FlowFunctionPtrType &CallFlowFunction,
+                               d_t /*d1*/, d_t d2,
+                               llvm::SmallVectorImpl<d_t> &Targets) {
+    Targets.clear();
+    CallFlowFunction->computeTargetsInto(std::move(d2), Targets);
   }
 
   /// Computes the call-to-return flow function for the given call-site
@@ -1020,11 +1206,14 @@ protected:
   /// compute
   /// @param d1 The abstraction at the current method's start node.
   /// @param d2 The abstraction at the call site
-  /// @return The set of caller-side abstractions at the return site
+  /// @param Targets Receives the set of caller-side abstractions at the
+  /// return site
   ///
-  container_type computeCallToReturnFlowFunction(
-      const FlowFunctionPtrType &CallToReturnFlowFunction, d_t /*d1*/, d_t d2) {
-    return CallToReturnFlowFunction->computeTargets(d2);
+  void computeCallToReturnFlowFunction(
+      const FlowFunctionPtrType &CallToReturnFlowFunction, d_t /*d1*/, d_t d2,
+      llvm::SmallVectorImpl<d_t> &Targets) {
+    Targets.clear();
+    CallToReturnFlowFunction->computeTargetsInto(std::move(d2), Targets);
   }
 
   /// Computes the return flow function for the given set of caller-side
@@ -1033,14 +1222,27 @@ protected:
   /// @param d1 The abstraction at the beginning of the callee
   /// @param d2 The abstraction at the exit node in the callee
   /// @param callSite The call site
-  /// @param callerSideDs The abstractions at the call site
-  /// @return The set of caller-side abstractions at the return site
+  /// @param Targets Receives the set of caller-side abstractions at the
+  /// return site
   ///
-  container_type
-  computeReturnFlowFunction(const FlowFunctionPtrType &RetFlowFunction,
-                            d_t /*d1*/, d_t d2, n_t /*CallSite*/,
-                            const Container & /*CallerSideDs*/) {
-    return RetFlowFunction->computeTargets(d2);
+  void computeReturnFlowFunction(const FlowFunctionPtrType &RetFlowFunction,
+                                 d_t /*d1*/, d_t d2, n_t /*CallSite*/,
+                                 llvm::SmallVectorImpl<d_t> &Targets) {
+    Targets.clear();
+    RetFlowFunction->computeTargetsInto(std::move(d2), Targets);
+  }
+
+  /// Returns f.composeWith(g), memoized if the EdgeFunctionMemoCache is
+  /// enabled
+  [[nodiscard]] EdgeFunction<l_t> composeEFs(const EdgeFunction<l_t> &f,
+                                             const EdgeFunction<l_t> &g) {
+    return EFMemo ? EFMemo->compose(f, g) : f.composeWith(g);
+  }
+
+  /// Returns f.joinWith(g), memoized if the EdgeFunctionMemoCache is enabled
+  [[nodiscard]] EdgeFunction<l_t> joinEFs(const EdgeFunction<l_t> &f,
+                                          const EdgeFunction<l_t> &g) {
+    return EFMemo ? EFMemo->join(f, g) : f.joinWith(g);
   }
 
   /// Propagates the flow further down the exploded super graph, merging any
@@ -1070,22 +1272,24 @@ protected:
     PHASAR_LOG_LEVEL(
         DEBUG, "Edge function : " << f << " (result of previous compose)");
 
-    EdgeFunction<l_t> JumpFnE = [&]() {
-      const auto RevLookupResult = JumpFn->reverseLookup(Target, TargetVal);
-      if (RevLookupResult) {
-        const auto &JumpFnContainer = RevLookupResult->get();
-        const auto Find = std::find_if(
-            JumpFnContainer.begin(), JumpFnContainer.end(),
-            [SourceVal](auto &KVpair) { return KVpair.first == SourceVal; });
-        if (Find != JumpFnContainer.end()) {
-          return Find->second;
-        }
+    if (ConcurrentJumpFn) {
+      auto [JumpFnE, fPrime] =
+          ConcurrentJumpFn->join(SourceVal, Target, TargetVal, f, AllTop,
+                                 EFMemo.get());
+      if (fPrime != JumpFnE) {
+        ++WorkerStats[*WorkListScheduler::currentWorker()].PathEdgeCount;
+        pathEdgeProcessingTask(
+            PathEdge(std::move(SourceVal), std::move(Target),
+                     std::move(TargetVal)));
       }
-      // jump function is initialized to all-top if no entry
-      // was found
-      return AllTop;
-    }();
-    EdgeFunction<l_t> fPrime = JumpFnE.joinWith(f);
+      return;
+    }
+
+    // jump function is initialized to all-top if no entry
+    // was found
+    EdgeFunction<l_t> JumpFnE =
+        JumpFn->lookup(SourceVal, Target, TargetVal, AllTop);
+    EdgeFunction<l_t> fPrime = joinEFs(JumpFnE, f);
     bool NewFunction = fPrime != JumpFnE;
 
     IF_LOG_ENABLED(
@@ -1098,8 +1302,12 @@ protected:
         PHASAR_LOG_LEVEL(DEBUG, ' '));
     if (NewFunction) {
       JumpFn->addFunction(SourceVal, Target, TargetVal, fPrime);
-      PathEdge Edge(SourceVal, Target, TargetVal);
       PathEdgeCount++;
+      if (SummaryProv && SourceVal == TargetVal && ICF->isStartPoint(Target) &&
+          applyProvidedSummary(Target, SourceVal)) {
+        return;
+      }
+      PathEdge Edge(SourceVal, Target, TargetVal);
       pathEdgeProcessingTask(std::move(Edge));
 
       IF_LOG_ENABLED(if (!IDEProblem.isZeroValue(TargetVal)) {
@@ -1118,6 +1326,66 @@ protected:
     }
   }
 
+  /// Installs the jump functions that the SummaryProvider knows for the
+  /// freshly reached start node <SP,d1> instead of processing the function
+  /// body. Returns false if the provider has no summary for <SP,d1>.
+  bool applyProvidedSummary(n_t SP, d_t d1) {
+    PAMM_GET_INSTANCE;
+    // The self-loop at the start point is already in JumpFn
+    llvm::SmallVector<PathEdge<n_t, d_t>> Edges = {PathEdge(d1, SP, d1)};
+    bool Provided = SummaryProv->provideJumpFunctions(
+        SP, d1,
+        [this, &SP, &d1, &Edges](ByConstRef<n_t> Target,
+                                 ByConstRef<d_t> TargetVal,
+                                 const EdgeFunction<l_t> &EF) {
+          if (Target == SP && TargetVal == d1) {
+            return;
+          }
+          JumpFn->addFunction(d1, Target, TargetVal, EF);
+          Edges.push_back(PathEdge(d1, Target, TargetVal));
+        });
+    if (!Provided) {
+      return false;
+    }
+
+    PHASAR_LOG_LEVEL(DEBUG, "Apply provided summary for <"
+                                << IDEProblem.NtoString(SP) << ", "
+                                << IDEProblem.DtoString(d1) << '>');
+    INC_COUNTER("Provided Summaries", 1, PAMM_SEVERITY_LEVEL::Core);
+    for (auto &Edge : Edges) {
+      if (ICF->isCallSite(Edge.getTarget())) {
+        enterCalleesOfProvidedSummary(Edge);
+      } else if (ICF->isExitInst(Edge.getTarget())) {
+        // Makes the end summary available to the callers
+        processExit(Edge);
+      }
+    }
+    return true;
+  }
+
+  /// Enters the callees at the call-site of a provided jump function, such
+  /// that Phase II can compute the values inside the callees. The effects of
+  /// the call are already part of the provided jump functions, so in contrast
+  /// to processCall() no incoming edge is registered.
+  void enterCalleesOfProvidedSummary(const PathEdge<n_t, d_t> &Edge) {
+    n_t n = Edge.getTarget();
+    for (f_t Callee : ICF->getCalleesOfCallAt(n)) {
+      if (cachedFlowEdgeFunctions().getSummaryFlowFunction(n, Callee)) {
+        continue;
+      }
+      FlowFunctionPtrType Function =
+          cachedFlowEdgeFunctions().getCallFlowFunction(n, Callee);
+      flow_targets_t Res;
+      computeCallFlowFunction(Function, Edge.factAtSource(),
+                              Edge.factAtTarget(), Res);
+      for (n_t SP : ICF->getStartPointsOf(Callee)) {
+        for (d_t d3 : Res) {
+          addWorkListItem(PathEdge(d3, SP, d3), EdgeIdentity<l_t>{});
+        }
+      }
+    }
+  }
+
   l_t joinValueAt(n_t /*Unit*/, d_t /*Fact*/, l_t Curr, l_t NewVal) {
     return IDEProblem.join(std::move(Curr), std::move(NewVal));
   }
@@ -1144,6 +1412,75 @@ protected:
     IncomingTab.get(SP, d3)[n].insert(d2);
   }
 
+  /// Registers the incoming edge <n,d2> -> <SP,d3> and returns all end
+  /// summaries that are already known for <SP,d3>. In the parallel Phase I,
+  /// both happens atomically.
+  auto addIncomingAndGetEndSummaries(n_t SP, d_t d3, n_t n, d_t d2) {
+    using TableCell = typename Table<n_t, d_t, EdgeFunction<l_t>>::Cell;
+    if (!ConcurrentSummaries) {
+      addIncoming(SP, d3, n, d2);
+      auto Summaries = endSummary(SP, d3);
+      return std::vector<TableCell>(Summaries.begin(), Summaries.end());
+    }
+
+    if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Core) {
+      std::lock_guard Lock(SolverStateMtx);
+      ++FSummaryReuse[std::make_pair(SP, d3)];
+    }
+    return ConcurrentSummaries->addIncomingAndGetEndSummaries(
+        std::move(SP), std::move(d3), std::move(n), std::move(d2));
+  }
+
+  /// Registers the end summary <SP,d1> -> <eP,d2> and returns all incoming
+  /// edges that are already known for <SP,d1>. In the parallel Phase I, both
+  /// happens atomically.
+  std::map<n_t, container_type>
+  addEndSummaryAndGetIncoming(n_t SP, d_t d1, n_t eP, d_t d2,
+                              EdgeFunction<l_t> f) {
+    if (!ConcurrentSummaries) {
+      addEndSummary(SP, d1, std::move(eP), std::move(d2), std::move(f));
+      return incoming(std::move(d1), std::move(SP));
+    }
+    return ConcurrentSummaries->addEndSummaryAndGetIncoming(
+        std::move(SP), std::move(d1), std::move(eP), std::move(d2),
+        std::move(f));
+  }
+
+  /// Invokes Handler on each source fact and jump function that lead to
+  /// <Target,TargetVal>.
+  template <typename HandlerFn>
+  void foreachJumpFunctionInto(ByConstRef<n_t> Target,
+                               ByConstRef<d_t> TargetVal, HandlerFn Handler) {
+    if (ConcurrentJumpFn) {
+      for (auto &[SourceVal, EF] :
+           ConcurrentJumpFn->reverseLookup(Target, TargetVal)) {
+        std::invoke(Handler, std::move(SourceVal), std::move(EF));
+      }
+      return;
+    }
+
+    JumpFn->reverseLookup(Target, TargetVal, std::move(Handler));
+  }
+
+  void addWorkListItem(PathEdge<n_t, d_t> Edge, EdgeFunction<l_t> EF) {
+    if (Scheduler) {
+      Scheduler->push({std::move(Edge), std::move(EF)});
+    } else {
+      WorkList.push(std::move(Edge), std::move(EF));
+    }
+  }
+
+  /// The flow- and edge-function cache of the calling worker thread.
+  FlowEdgeFunctionCache<AnalysisDomainTy, Container> &
+  cachedFlowEdgeFunctions() {
+    if (!WorkerFlowEdgeFunctions.empty()) {
+      if (auto Worker = WorkListScheduler::currentWorker()) {
+        return WorkerFlowEdgeFunctions[*Worker];
+      }
+    }
+    return CachedFlowEdgeFunctions;
+  }
+
   void printIncomingTab() const {
     IF_LOG_ENABLED(
         PHASAR_LOG_LEVEL(DEBUG, "Start of incomingtab entry");
@@ -1391,6 +1728,8 @@ protected:
                 PAMM_SEVERITY_LEVEL::Core);
     INC_COUNTER("Inter Path Edges", NumInterPathEdges,
                 PAMM_SEVERITY_LEVEL::Core);
+    INC_COUNTER("WorkList Items", NumWorkListItems, PAMM_SEVERITY_LEVEL::Core);
+    INC_COUNTER("JumpFn Updates", PathEdgeCount, PAMM_SEVERITY_LEVEL::Core);
 
     PHASAR_LOG_LEVEL(INFO, "----------------------------------------------");
     PHASAR_LOG_LEVEL(INFO, "=== Solver Statistics ===");
@@ -1402,6 +1741,24 @@ protected:
                      "#Intra Path Edges: " << GET_COUNTER("Intra Path Edges"));
     PHASAR_LOG_LEVEL(INFO,
                      "#Inter Path Edges: " << GET_COUNTER("Inter Path Edges"));
+    PHASAR_LOG_LEVEL(INFO, "WorkList Policy  : "
+                               << SolverConfig.workListPolicy());
+    PHASAR_LOG_LEVEL(INFO,
+                     "#WorkList Items  : " << GET_COUNTER("WorkList Items"));
+    PHASAR_LOG_LEVEL(INFO,
+                     "#JumpFn Updates  : " << GET_COUNTER("JumpFn Updates"));
+    if (EFMemo) {
+      auto MemoStats = EFMemo->getStats();
+      INC_COUNTER("EF Compose Memo Hits", MemoStats.ComposeHits,
+                  PAMM_SEVERITY_LEVEL::Core);
+      INC_COUNTER("EF Compose Memo Misses", MemoStats.ComposeMisses,
+                  PAMM_SEVERITY_LEVEL::Core);
+      INC_COUNTER("EF Join Memo Hits", MemoStats.JoinHits,
+                  PAMM_SEVERITY_LEVEL::Core);
+      INC_COUNTER("EF Join Memo Misses", MemoStats.JoinMisses,
+                  PAMM_SEVERITY_LEVEL::Core);
+      PHASAR_LOG_LEVEL(INFO, "EF Memo Cache    : " << MemoStats);
+    }
     if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Full) {
       PHASAR_LOG_LEVEL(
           INFO, "Flow function query count: " << GET_COUNTER("FF Queries"));
@@ -1670,10 +2027,15 @@ private:
     REG_COUNTER("SpecialSummary-FF Application", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("SpecialSummary-EF Queries", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("JumpFn Construction", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Provided Summaries", 0, PAMM_SEVERITY_LEVEL::Core);
     REG_COUNTER("Process Call", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Process Normal", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Process Exit", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("[Calls] getAliasSet", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("WorkList Items", 0, PAMM_SEVERITY_LEVEL::Core);
+    REG_COUNTER("JumpFn Updates", 0, PAMM_SEVERITY_LEVEL::Core);
+    REG_COUNTER("WorkList Policy: " + toString(SolverConfig.workListPolicy()),
+                1, PAMM_SEVERITY_LEVEL::Core);
     REG_HISTOGRAM("Data-flow facts", PAMM_SEVERITY_LEVEL::Full);
     REG_HISTOGRAM("Points-to", PAMM_SEVERITY_LEVEL::Full);
 
@@ -1683,15 +2045,130 @@ private:
     // computations starting here
     START_TIMER("DFA Phase I", PAMM_SEVERITY_LEVEL::Full);
 
+    if (SummaryProv && SolverConfig.followReturnsPastSeeds()) {
+      PHASAR_LOG_LEVEL(WARNING, "Provided summaries cannot be combined with "
+                                "following returns past seeds; ignore them");
+      SummaryProv = nullptr;
+    }
+
+    WorkList.setPolicy(SolverConfig.workListPolicy());
+    PHASAR_LOG_LEVEL(INFO, "Use the " << WorkList.getPolicy()
+                                      << " worklist policy");
+
     // We start our analysis and construct exploded supergraph
     submitInitialSeeds();
+    NumWorkers = getNumPhaseIWorkers();
+    if (auto MemoSize = SolverConfig.edgeFunctionMemoCacheSize()) {
+      EFMemo = std::make_unique<EdgeFunctionMemoCache<l_t>>(MemoSize,
+                                                            NumWorkers > 1);
+    }
     return !WorkList.empty();
   }
 
+  [[nodiscard]] unsigned getNumPhaseIWorkers() const {
+    if (SolverConfig.numThreads() <= 1) {
+      return 1;
+    }
+    if (!IDEProblem.supportsParallelSolving()) {
+      PHASAR_LOG_LEVEL(WARNING, "The analysis problem does not support "
+                                "parallel solving; solve sequentially");
+      return 1;
+    }
+    if (SolverConfig.recordEdges() || SolverConfig.emitESG()) {
+      PHASAR_LOG_LEVEL(WARNING, "Recording path edges is not supported by the "
+                                "parallel IDESolver; solve sequentially");
+      return 1;
+    }
+    if (SummaryProv) {
+      PHASAR_LOG_LEVEL(WARNING, "Provided summaries are not supported by the "
+                                "parallel IDESolver; solve sequentially");
+      return 1;
+    }
+    return SolverConfig.numThreads();
+  }
+
+  /// Computes Phase I on NumWorkers threads until it is done or the
+  /// AsyncCancellation flag is set. In the latter case, the remaining work
+  /// items are put back into the WorkList to be processed sequentially.
+  ///
+  /// \returns True, iff the whole Phase I has been computed.
+  bool solveInParallel() {
+    PAMM_GET_INSTANCE;
+    START_TIMER("DFA Phase I (parallel)", PAMM_SEVERITY_LEVEL::Core);
+    PHASAR_LOG_LEVEL(INFO, "Solve Phase I with " << NumWorkers << " threads");
+
+    Scheduler = std::make_unique<WorkListScheduler>(NumWorkers);
+    ConcurrentJumpFn =
+        std::make_unique<ConcurrentJumpFunctions<AnalysisDomainTy>>(
+            size_t(NumWorkers) * 16);
+    ConcurrentSummaries = std::make_unique<
+        ConcurrentSummaryTables<AnalysisDomainTy, Container>>(
+        size_t(NumWorkers) * 16);
+    WorkerFlowEdgeFunctions.reserve(NumWorkers);
+    for (unsigned I = 0; I != NumWorkers; ++I) {
+      WorkerFlowEdgeFunctions.push_back(CachedFlowEdgeFunctions);
+    }
+    WorkerStats.resize(NumWorkers);
+
+    WorkList.drain([this](auto &&Item) { Scheduler->push(std::move(Item)); });
+
+    auto ResetParallelState = llvm::make_scope_exit([this] {
+      Scheduler.reset();
+      ConcurrentJumpFn.reset();
+      ConcurrentSummaries.reset();
+      WorkerFlowEdgeFunctions.clear();
+      WorkerStats.clear();
+    });
+
+    bool Completed = Scheduler->runUntil(
+        [this](std::pair<PathEdge<n_t, d_t>, EdgeFunction<l_t>> Item) {
+          ++WorkerStats[*WorkListScheduler::currentWorker()].NumWorkListItems;
+          auto &[Edge, EF] = Item;
+          auto [SourceVal, Target, TargetVal] = Edge.consume();
+          propagate(std::move(SourceVal), std::move(Target),
+                    std::move(TargetVal), std::move(EF));
+        },
+        [this] { return AsyncCancellation && AsyncCancellation->load(); });
+
+    for (const auto &Stats : WorkerStats) {
+      NumWorkListItems += Stats.NumWorkListItems;
+      PathEdgeCount += Stats.PathEdgeCount;
+    }
+
+    // Hand over the results to the sequential data structures that are used
+    // by Phase II, the result accessors and a sequential continuation
+    ConcurrentJumpFn->moveInto(*JumpFn);
+    ConcurrentSummaries->moveInto(EndsummaryTab, IncomingTab);
+
+    if (!Completed) {
+      PHASAR_LOG_LEVEL(INFO, "Parallel Phase I cancelled with "
+                                 << Scheduler->getNumPendingItems()
+                                 << " pending items; continue sequentially");
+      Scheduler->drain(
+          [this](std::pair<PathEdge<n_t, d_t>, EdgeFunction<l_t>> Item) {
+            WorkList.push(std::move(Item.first), std::move(Item.second));
+          });
+      // A new parallel run would not see the jump functions that have been
+      // computed so far
+      NumWorkers = 1;
+    }
+
+    STOP_TIMER("DFA Phase I (parallel)", PAMM_SEVERITY_LEVEL::Core);
+    return Completed;
+  }
+
+  void doSetAsyncCancellation(const std::atomic_bool *Flag) noexcept {
+    AsyncCancellation = Flag;
+  }
+
   bool doNext() {
     assert(!WorkList.empty());
-    auto [Edge, EF] = std::move(WorkList.back());
-    WorkList.pop_back();
+    if (NumWorkers > 1) {
+      return !solveInParallel() && !WorkList.empty();
+    }
+
+    auto [Edge, EF] = WorkList.pop();
+    ++NumWorkListItems;
 
     auto [SourceVal, Target, TargetVal] = Edge.consume();
     propagate(std::move(SourceVal), std::move(Target), std::move(TargetVal),
@@ -1702,6 +2179,10 @@ private:
 
   void finalizeInternal() {
     STOP_TIMER("DFA Phase I", PAMM_SEVERITY_LEVEL::Full);
+    if (EFMemo) {
+      // Phase II does not compose or join edge functions anymore
+      EFMemo->clear();
+    }
     if (SolverConfig.computeValues()) {
       START_TIMER("DFA Phase II", PAMM_SEVERITY_LEVEL::Full);
       // Computing the final values for the edge functions
@@ -1736,13 +2217,43 @@ private:
   const i_t *ICF;
   IFDSIDESolverConfig &SolverConfig;
 
-  std::vector<std::pair<PathEdge<n_t, d_t>, EdgeFunction<l_t>>> WorkList;
+  IDEWorkList<AnalysisDomainTy> WorkList;
+  size_t NumWorkListItems = 0;
+  /// Set while solving with async cancellation
+  const std::atomic_bool *AsyncCancellation = nullptr;
   std::vector<std::pair<n_t, d_t>> ValuePropWL;
 
+  /// The number of nodes per work item of the parallel Phase II(ii)
+  static constexpr size_t ValueComputationChunkSize = 32;
+
   size_t PathEdgeCount = 0;
 
   FlowEdgeFunctionCache<AnalysisDomainTy, Container> CachedFlowEdgeFunctions;
 
+  /// -- State of the parallel Phase I; only set while solveInParallel() runs
+
+  using WorkListScheduler = WorkStealingScheduler<
+      std::pair<PathEdge<n_t, d_t>, EdgeFunction<l_t>>>;
+
+  unsigned NumWorkers = 1;
+  std::unique_ptr<WorkListScheduler> Scheduler;
+  std::unique_ptr<ConcurrentJumpFunctions<AnalysisDomainTy>> ConcurrentJumpFn;
+  std::unique_ptr<ConcurrentSummaryTables<AnalysisDomainTy, Container>>
+      ConcurrentSummaries;
+  std::vector<FlowEdgeFunctionCache<AnalysisDomainTy, Container>>
+      WorkerFlowEdgeFunctions;
+
+  /// The statistics of a single worker, which are added to NumWorkListItems
+  /// and PathEdgeCount when the parallel Phase I ends. Aligned to a cache
+  /// line, such that the workers do not contend for it.
+  struct alignas(64) WorkerStatistics {
+    size_t NumWorkListItems = 0;
+    size_t PathEdgeCount = 0;
+  };
+  std::vector<WorkerStatistics> WorkerStats;
+  /// Protects UnbalancedRetSites and FSummaryReuse
+  std::mutex SolverStateMtx;
+
   Table<n_t, n_t, std::map<d_t, Container>> ComputedIntraPathEdges;
 
   Table<n_t, n_t, std::map<d_t, Container>> ComputedInterPathEdges;
@@ -1751,6 +2262,11 @@ private:
 
   std::shared_ptr<JumpFunctions<AnalysisDomainTy, Container>> JumpFn;
 
+  /// Only set if IFDSIDESolverConfig::edgeFunctionMemoCacheSize() is non-zero
+  std::unique_ptr<EdgeFunctionMemoCache<l_t>> EFMemo;
+
+  SummaryProvider<AnalysisDomainTy> *SummaryProv = nullptr;
+
   std::map<std::tuple<n_t, d_t, n_t, d_t>, std::vector<EdgeFunction<l_t>>>
       IntermediateEdgeFunctions;
 
@@ -12,6 +12,7 @@
 
 #include "phasar/Utils/Logger.h"
 
+#include "llvm/ADT/ScopeExit.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/raw_ostream.h"
 
@@ -513,6 +514,12 @@ private:
 
   [[nodiscard]] bool
   continueWithAsyncCancellationImpl(std::atomic_bool &IsCancelled) {
+    // Allow the solver to check IsCancelled from within a single call to
+    // next() that does not return early, e.g., when solving in parallel
+    self().doSetAsyncCancellation(&IsCancelled);
+    auto ResetCancellation = llvm::make_scope_exit(
+        [this] { self().doSetAsyncCancellation(nullptr); });
+
     while (next()) {
       if (IsCancelled.load()) {
         return false;
@@ -0,0 +1,288 @@
+/******************************************************************************
+ * Copyright (c) 2023 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_DATAFLOW_IFDSIDE_SOLVER_IDEWORKLIST_H
+#define PHASAR_DATAFLOW_IFDSIDE_SOLVER_IDEWORKLIST_H
+
+#include "phasar/DataFlow/IfdsIde/EdgeFunction.h"
+#include "phasar/DataFlow/IfdsIde/IFDSIDESolverConfig.h"
+#include "phasar/DataFlow/IfdsIde/Solver/PathEdge.h"
+#include "phasar/Utils/ByRef.h"
+
+#include "llvm/Support/ErrorHandling.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace psr {
+
+/// The worklist of the sequential Phase I of the IDESolver. Hands out the
+/// pending path edges in the order that is selected by a WorkListPolicy.
+///
+/// The priorities of the ReversePostOrder and CallGraphSCC policies are
+/// computed lazily per function when the first path edge into the function
+/// is pushed. Path edges with equal priority are processed in FIFO order.
+template <typename AnalysisDomainTy> class IDEWorkList {
+public:
+  using n_t = typename AnalysisDomainTy::n_t;
+  using d_t = typename AnalysisDomainTy::d_t;
+  using f_t = typename AnalysisDomainTy::f_t;
+  using i_t = typename AnalysisDomainTy::i_t;
+  using l_t = typename AnalysisDomainTy::l_t;
+  using value_type = std::pair<PathEdge<n_t, d_t>, EdgeFunction<l_t>>;
+
+  explicit IDEWorkList(const i_t *ICF) noexcept : ICF(ICF) {
+    assert(ICF != nullptr);
+  }
+
+  [[nodiscard]] WorkListPolicy getPolicy() const noexcept { return Policy; }
+
+  /// Changes the policy. Must only be called while the worklist is empty.
+  void setPolicy(WorkListPolicy NewPolicy) {
+    assert(empty() && "Cannot change the policy of a non-empty worklist");
+    Policy = NewPolicy;
+    if (Policy == WorkListPolicy::CallGraphSCC && SCCRank.empty()) {
+      computeSCCRanks();
+    }
+  }
+
+  void push(PathEdge<n_t, d_t> Edge, EdgeFunction<l_t> EF) {
+    switch (Policy) {
+    case WorkListPolicy::DepthFirst:
+      Stack.emplace_back(std::move(Edge), std::move(EF));
+      return;
+    case WorkListPolicy::BreadthFirst:
+      Queue.emplace_back(std::move(Edge), std::move(EF));
+      return;
+    case WorkListPolicy::ReversePostOrder:
+    case WorkListPolicy::CallGraphSCC: {
+      auto Prio = getPriority(Edge.getTarget());
+      Heap.push_back({Prio, NextSequenceNumber++,
+                      value_type(std::move(Edge), std::move(EF))});
+      std::push_heap(Heap.begin(), Heap.end(), std::greater<>{});
+      return;
+    }
+    }
+  }
+
+  [[nodiscard]] value_type pop() {
+    assert(!empty());
+    switch (Policy) {
+    case WorkListPolicy::DepthFirst: {
+      auto Ret = std::move(Stack.back());
+      Stack.pop_back();
+      return Ret;
+    }
+    case WorkListPolicy::BreadthFirst: {
+      auto Ret = std::move(Queue.front());
+      Queue.pop_front();
+      return Ret;
+    }
+    case WorkListPolicy::ReversePostOrder:
+    case WorkListPolicy::CallGraphSCC: {
+      std::pop_heap(Heap.begin(), Heap.end(), std::greater<>{});
+      auto Ret = std::move(Heap.back().Item);
+      Heap.pop_back();
+      return Ret;
+    }
+    }
+    llvm_unreachable("All WorkListPolicies should be handled in the switch");
+  }
+
+  /// Moves all pending items into Handler, regardless of their order.
+  template <typename HandlerFn> void drain(HandlerFn Handler) {
+    for (auto &Item : Stack) {
+      std::invoke(Handler, std::move(Item));
+    }
+    for (auto &Item : Queue) {
+      std::invoke(Handler, std::move(Item));
+    }
+    for (auto &Entry : Heap) {
+      std::invoke(Handler, std::move(Entry.Item));
+    }
+    clear();
+  }
+
+  [[nodiscard]] bool empty() const noexcept {
+    return Stack.empty() && Queue.empty() && Heap.empty();
+  }
+
+  [[nodiscard]] size_t size() const noexcept {
+    return Stack.size() + Queue.size() + Heap.size();
+  }
+
+  void clear() noexcept {
+    Stack.clear();
+    Queue.clear();
+    Heap.clear();
+  }
+
+private:
+  struct PrioritizedItem {
+    uint64_t Priority{};
+    uint64_t SequenceNumber{};
+    value_type Item;
+
+    friend bool operator>(const PrioritizedItem &Lhs,
+                          const PrioritizedItem &Rhs) noexcept {
+      return std::tie(Lhs.Priority, Lhs.SequenceNumber) >
+             std::tie(Rhs.Priority, Rhs.SequenceNumber);
+    }
+  };
+
+  [[nodiscard]] uint64_t getPriority(ByConstRef<n_t> Target) {
+    auto It = RPOIndex.find(Target);
+    if (It == RPOIndex.end()) {
+      computeReversePostOrder(ICF->getFunctionOf(Target));
+      // Statements that are unreachable from the start points are ordered
+      // last
+      It = RPOIndex.try_emplace(Target, std::numeric_limits<uint32_t>::max())
+               .first;
+    }
+    uint64_t Prio = It->second;
+    if (Policy == WorkListPolicy::CallGraphSCC) {
+      auto RankIt = SCCRank.find(ICF->getFunctionOf(Target));
+      uint64_t Rank = RankIt != SCCRank.end()
+                          ? RankIt->second
+                          : std::numeric_limits<uint32_t>::max();
+      Prio |= Rank << 32;
+    }
+    return Prio;
+  }
+
+  /// Numbers the statements of Fun in reverse postorder of an iterative
+  /// depth-first search from the function's start points.
+  void computeReversePostOrder(ByConstRef<f_t> Fun) {
+    std::vector<n_t> PostOrder;
+    std::unordered_map<n_t, bool> Visited;
+    std::vector<std::pair<n_t, size_t>> DFSStack;
+
+    for (const auto &SP : ICF->getStartPointsOf(Fun)) {
+      if (!Visited.try_emplace(SP, true).second) {
+        continue;
+      }
+      DFSStack.emplace_back(SP, 0);
+      while (!DFSStack.empty()) {
+        auto &[Curr, NextSucc] = DFSStack.back();
+        const auto &Succs = ICF->getSuccsOf(Curr);
+        if (NextSucc == Succs.size()) {
+          PostOrder.push_back(Curr);
+          DFSStack.pop_back();
+          continue;
+        }
+        auto Succ = Succs[NextSucc++];
+        if (Visited.try_emplace(Succ, true).second) {
+          DFSStack.emplace_back(std::move(Succ), 0);
+        }
+      }
+    }
+
+    for (uint32_t Idx = 0, End = PostOrder.size(); Idx != End; ++Idx) {
+      RPOIndex.try_emplace(PostOrder[End - Idx - 1], Idx);
+    }
+  }
+
+  /// Ranks the functions by an iterative version of Tarjan's algorithm on the
+  /// call graph. Tarjan's algorithm emits the SCCs in reverse topological
+  /// order, so callees are ranked before their callers.
+  void computeSCCRanks() {
+    struct NodeInfo {
+      uint32_t Index{};
+      uint32_t LowLink{};
+      bool OnStack = false;
+    };
+    std::unordered_map<f_t, NodeInfo> Info;
+    std::vector<f_t> SCCStack;
+    // (function, its callees, position of the next callee to visit)
+    std::vector<std::tuple<f_t, std::vector<f_t>, size_t>> DFSStack;
+    uint32_t NextIndex = 0;
+    uint32_t NextRank = 0;
+
+    auto GetCallees = [this](ByConstRef<f_t> Fun) {
+      std::vector<f_t> Callees;
+      for (const auto &CS : ICF->getCallsFromWithin(Fun)) {
+        for (const auto &Callee : ICF->getCalleesOfCallAt(CS)) {
+          Callees.push_back(Callee);
+        }
+      }
+      return Callees;
+    };
+    auto Visit = [&](ByConstRef<f_t> Fun) {
+      Info[Fun] = {NextIndex, NextIndex, true};
+      ++NextIndex;
+      SCCStack.push_back(Fun);
+      DFSStack.emplace_back(Fun, GetCallees(Fun), 0);
+    };
+
+    for (const auto &Root : ICF->getAllFunctions()) {
+      if (Info.count(Root)) {
+        continue;
+      }
+      Visit(Root);
+      while (!DFSStack.empty()) {
+        auto &[Fun, Callees, NextCallee] = DFSStack.back();
+        if (NextCallee != Callees.size()) {
+          auto Callee = Callees[NextCallee++];
+          auto It = Info.find(Callee);
+          if (It == Info.end()) {
+            // Invalidates the references into DFSStack
+            Visit(Callee);
+          } else if (It->second.OnStack) {
+            auto &FunInfo = Info[Fun];
+            FunInfo.LowLink = std::min(FunInfo.LowLink, It->second.Index);
+          }
+          continue;
+        }
+
+        auto Finished = Fun;
+        DFSStack.pop_back();
+        const auto &FinishedInfo = Info[Finished];
+        if (!DFSStack.empty()) {
+          auto &CallerInfo = Info[std::get<0>(DFSStack.back())];
+          CallerInfo.LowLink =
+              std::min(CallerInfo.LowLink, FinishedInfo.LowLink);
+        }
+        if (FinishedInfo.LowLink != FinishedInfo.Index) {
+          continue;
+        }
+        f_t Member;
+        do {
+          Member = SCCStack.back();
+          SCCStack.pop_back();
+          Info[Member].OnStack = false;
+          SCCRank[Member] = NextRank;
+        } while (Member != Finished);
+        ++NextRank;
+      }
+    }
+  }
+
+  const i_t *ICF{};
+  WorkListPolicy Policy = WorkListPolicy::DepthFirst;
+
+  std::vector<value_type> Stack;
+  std::deque<value_type> Queue;
+  std::vector<PrioritizedItem> Heap;
+  uint64_t NextSequenceNumber = 0;
+
+  std::unordered_map<n_t, uint32_t> RPOIndex;
+  std::unordered_map<f_t, uint32_t> SCCRank;
+};
+
+} // namespace psr
+
+#endif // PHASAR_DATAFLOW_IFDSIDE_SOLVER_IDEWORKLIST_H
@@ -18,17 +18,21 @@
 #define PHASAR_DATAFLOW_IFDSIDE_SOLVER_JUMPFUNCTIONS_H
 
 #include "phasar/DataFlow/IfdsIde/EdgeFunction.h"
+#include "phasar/DataFlow/IfdsIde/EdgeFunctionUtils.h"
+#include "phasar/Utils/ByRef.h"
+#include "phasar/Utils/Compressor.h"
 #include "phasar/Utils/Logger.h"
-#include "phasar/Utils/Table.h"
 
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/raw_ostream.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <functional>
-#include <memory>
-#include <optional>
-#include <ostream>
-#include <unordered_map>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace psr {
 
@@ -37,6 +41,14 @@ namespace psr {
 template <typename AnalysisDomainTy, typename Container>
 class IDETabulationProblem;
 
+/// Stores the jump functions computed by the IDESolver.
+///
+/// Statements and data-flow facts are interned into dense 32 bit IDs. All jump
+/// functions that end in the same target statement are stored exactly once in
+/// a per-statement vector; the reverse (by target fact) and forward (by source
+/// fact) lookups only hold indices into that vector. Both lookups are single
+/// maps keyed by (target statement, fact), so statements with few jump
+/// functions do not pay for hash tables of their own.
 template <typename AnalysisDomainTy, typename Container> class JumpFunctions {
 public:
   using l_t = typename AnalysisDomainTy::l_t;
@@ -44,24 +56,52 @@ public:
   using n_t = typename AnalysisDomainTy::n_t;
 
 private:
+  using IdT = uint32_t;
+
+  struct JumpFunctionEntry {
+    IdT SourceVal{};
+    IdT TargetVal{};
+    EdgeFunction<l_t> EdgeFunc{};
+  };
+
+  // (target statement, fact) -> indices into NodeJumpFunctions[statement]
+  using IndexMap =
+      llvm::DenseMap<std::pair<IdT, IdT>, llvm::SmallVector<IdT, 1>>;
+
   const IDETabulationProblem<AnalysisDomainTy, Container> &Problem;
 
-protected:
-  // mapping from target node and value to a list of all source values and
-  // associated functions where the list is implemented as a mapping from
-  // the source value to the function we exclude empty default functions
-  Table<n_t, d_t, llvm::SmallVector<std::pair<d_t, EdgeFunction<l_t>>, 1>>
-      NonEmptyReverseLookup;
-  // mapping from source value and target node to a list of all target values
-  // and associated functions where the list is implemented as a mapping from
-  // the source value to the function we exclude empty default functions
-  Table<d_t, n_t, llvm::SmallVector<std::pair<d_t, EdgeFunction<l_t>>, 1>>
-      NonEmptyForwardLookup;
-  // a mapping from target node to a list of triples consisting of source value,
-  // target value and associated function; the triple is implemented by a table
-  // we exclude empty default functions
-  std::unordered_map<n_t, Table<d_t, d_t, EdgeFunction<l_t>>>
-      NonEmptyLookupByTargetNode;
+  Compressor<n_t> Nodes;
+  Compressor<d_t> Facts;
+  // Indexed by the Id of the target statement
+  std::vector<llvm::SmallVector<JumpFunctionEntry, 0>> NodeJumpFunctions;
+  // Keyed by the target statement and target value
+  IndexMap ByTargetVal;
+  // Keyed by the target statement and source value
+  IndexMap BySourceVal;
+
+  [[nodiscard]] static llvm::SmallVector<IdT, 4>
+  getIndices(const IndexMap &Map, IdT TargetId, IdT Val) {
+    if (auto It = Map.find({TargetId, Val}); It != Map.end()) {
+      return {It->second.begin(), It->second.end()};
+    }
+    return {};
+  }
+
+  template <typename EntriesT>
+  [[nodiscard]] static auto find(EntriesT &Entries, const IndexMap &ByTarget,
+                                 IdT TargetId, IdT SourceVal, IdT TargetVal)
+      -> decltype(Entries.data()) {
+    auto It = ByTarget.find({TargetId, TargetVal});
+    if (It == ByTarget.end()) {
+      return nullptr;
+    }
+    for (auto Idx : It->second) {
+      if (Entries[Idx].SourceVal == SourceVal) {
+        return &Entries[Idx];
+      }
+    }
+    return nullptr;
+  }
 
 public:
   JumpFunctions(
@@ -93,177 +133,195 @@ public:
       return;
     }
 
-    auto &SourceValToFunc = NonEmptyReverseLookup.get(Target, TargetVal);
-    if (auto Find = std::find_if(
-            SourceValToFunc.begin(), SourceValToFunc.end(),
-            [SourceVal](const std::pair<d_t, EdgeFunction<l_t>> &Entry) {
-              return SourceVal == Entry.first;
-            });
-        Find != SourceValToFunc.end()) {
-      // it is important that existing values in JumpFunctions
-      // are overwritten
-      Find->second = EdgeFunc;
-    } else {
-      SourceValToFunc.emplace_back(SourceVal, EdgeFunc);
+    auto TargetId = Nodes.getOrInsert(Target);
+    if (TargetId >= NodeJumpFunctions.size()) {
+      NodeJumpFunctions.resize(TargetId + 1);
     }
+    auto &Entries = NodeJumpFunctions[TargetId];
+    auto SourceValId = Facts.getOrInsert(SourceVal);
+    auto TargetValId = Facts.getOrInsert(TargetVal);
 
-    auto &TargetValToFunc = NonEmptyForwardLookup.get(SourceVal, Target);
-    if (auto Find = std::find_if(
-            TargetValToFunc.begin(), TargetValToFunc.end(),
-            [TargetVal](const std::pair<d_t, EdgeFunction<l_t>> &Entry) {
-              return TargetVal == Entry.first;
-            });
-        Find != TargetValToFunc.end()) {
+    if (auto *Entry = find(Entries, ByTargetVal, TargetId, SourceValId,
+                           TargetValId)) {
       // it is important that existing values in JumpFunctions
       // are overwritten
-      Find->second = EdgeFunc;
+      Entry->EdgeFunc = std::move(EdgeFunc);
     } else {
-      TargetValToFunc.emplace_back(TargetVal, EdgeFunc);
+      auto Idx = IdT(Entries.size());
+      Entries.push_back({SourceValId, TargetValId, std::move(EdgeFunc)});
+      ByTargetVal[{TargetId, TargetValId}].push_back(Idx);
+      BySourceVal[{TargetId, SourceValId}].push_back(Idx);
     }
-
-    // V Table::insert(R r, C c, V v) always overrides (see
-    // comments above)
-    NonEmptyLookupByTargetNode[Target].insert(SourceVal, TargetVal, EdgeFunc);
     PHASAR_LOG_LEVEL(DEBUG, "End adding new jump function");
   }
 
   /**
-   * Returns, for a given target statement and value all associated
-   * source values, and for each the associated edge function.
-   * The return value is a mapping from source value to function.
+   * Returns the jump function from SourceVal to (Target, TargetVal), or
+   * Default if there is none.
    */
-  std::optional<std::reference_wrapper<
-      llvm::SmallVectorImpl<std::pair<d_t, EdgeFunction<l_t>>>>>
-  reverseLookup(n_t Target, d_t TargetVal) {
-    if (!NonEmptyReverseLookup.contains(Target, TargetVal)) {
-      return std::nullopt;
+  [[nodiscard]] EdgeFunction<l_t>
+  lookup(ByConstRef<d_t> SourceVal, ByConstRef<n_t> Target,
+         ByConstRef<d_t> TargetVal, const EdgeFunction<l_t> &Default) const {
+    auto TargetId = Nodes.getOrNull(Target);
+    auto SourceValId = Facts.getOrNull(SourceVal);
+    auto TargetValId = Facts.getOrNull(TargetVal);
+    if (!TargetId || !SourceValId || !TargetValId) {
+      return Default;
     }
-    return {NonEmptyReverseLookup.get(Target, TargetVal)};
+    if (const auto *Entry = find(NodeJumpFunctions[*TargetId], ByTargetVal,
+                                 *TargetId, *SourceValId, *TargetValId)) {
+      return Entry->EdgeFunc;
+    }
+    return Default;
   }
 
   /**
-   * Returns, for a given source value and target statement all
-   * associated target values, and for each the associated edge function.
-   * The return value is a mapping from target value to function.
+   * Invokes Handler(SourceVal, EdgeFunction) for each jump function ending in
+   * the given target statement and value.
+   *
+   * Handler may add new jump functions; these are not visited by this call,
+   * but updates to the visited jump functions are.
    */
-  std::optional<std::reference_wrapper<
-      llvm::SmallVectorImpl<std::pair<d_t, EdgeFunction<l_t>>>>>
-  forwardLookup(d_t SourceVal, n_t Target) {
-    if (!NonEmptyForwardLookup.contains(SourceVal, Target)) {
-      return std::nullopt;
+  template <typename HandlerFn>
+  void reverseLookup(ByConstRef<n_t> Target, ByConstRef<d_t> TargetVal,
+                     HandlerFn Handler) const {
+    auto TargetId = Nodes.getOrNull(Target);
+    auto TargetValId = Facts.getOrNull(TargetVal);
+    if (!TargetId || !TargetValId) {
+      return;
+    }
+    for (auto Idx : getIndices(ByTargetVal, *TargetId, *TargetValId)) {
+      auto Entry = NodeJumpFunctions[*TargetId][Idx];
+      std::invoke(Handler, Facts[Entry.SourceVal], std::move(Entry.EdgeFunc));
     }
-    return {NonEmptyForwardLookup.get(SourceVal, Target)};
   }
 
   /**
-   * Returns for a given target statement all jump function records with this
-   * target.
-   * The return value is a set of records of the form
-   * (sourceVal,targetVal,edgeFunction).
+   * Invokes Handler(TargetVal, EdgeFunction) for each jump function starting
+   * at the given source value and ending in the given target statement.
+   *
+   * Handler may add new jump functions; these are not visited by this call,
+   * but updates to the visited jump functions are.
    */
-  Table<d_t, d_t, EdgeFunction<l_t>> &lookupByTarget(n_t Target) {
-    return NonEmptyLookupByTargetNode[Target];
+  template <typename HandlerFn>
+  void forwardLookup(ByConstRef<d_t> SourceVal, ByConstRef<n_t> Target,
+                     HandlerFn Handler) const {
+    auto TargetId = Nodes.getOrNull(Target);
+    auto SourceValId = Facts.getOrNull(SourceVal);
+    if (!TargetId || !SourceValId) {
+      return;
+    }
+    for (auto Idx : getIndices(BySourceVal, *TargetId, *SourceValId)) {
+      auto Entry = NodeJumpFunctions[*TargetId][Idx];
+      std::invoke(Handler, Facts[Entry.TargetVal], std::move(Entry.EdgeFunc));
+    }
+  }
+
+  /**
+   * Invokes Handler(SourceVal, TargetVal, EdgeFunction) for all jump function
+   * records with the given target statement.
+   */
+  template <typename HandlerFn>
+  void lookupByTarget(ByConstRef<n_t> Target, HandlerFn Handler) const {
+    auto TargetId = Nodes.getOrNull(Target);
+    if (!TargetId) {
+      return;
+    }
+    for (const auto &Entry : NodeJumpFunctions[*TargetId]) {
+      std::invoke(Handler, Facts[Entry.SourceVal], Facts[Entry.TargetVal],
+                  Entry.EdgeFunc);
+    }
   }
 
   /**
    * Removes a jump function. The source statement is implicit.
+   * Must not be called while iterating over the jump functions.
    * @see PathEdge
    * @return True if the function has actually been removed. False if it was not
    * there anyway.
    */
-  bool removeFunction(d_t SourceVal, n_t Target, d_t TargetVal) {
-    auto &SourceValToFunc = NonEmptyReverseLookup.get(Target, TargetVal);
-    if (auto Find = std::find_if(
-            SourceValToFunc.begin(), SourceValToFunc.end(),
-            [SourceVal](const std::pair<d_t, EdgeFunction<l_t>> &Entry) {
-              return SourceVal == Entry.first;
-            });
-        Find != SourceValToFunc.end()) {
-      SourceValToFunc.erase(Find);
+  bool removeFunction(ByConstRef<d_t> SourceVal, ByConstRef<n_t> Target,
+                      ByConstRef<d_t> TargetVal) {
+    auto TargetId = Nodes.getOrNull(Target);
+    auto SourceValId = Facts.getOrNull(SourceVal);
+    auto TargetValId = Facts.getOrNull(TargetVal);
+    if (!TargetId || !SourceValId || !TargetValId) {
+      return false;
+    }
+    auto &Entries = NodeJumpFunctions[*TargetId];
+    auto *Entry =
+        find(Entries, ByTargetVal, *TargetId, *SourceValId, *TargetValId);
+    if (!Entry) {
+      return false;
     }
-    auto &TargetValToFunc = NonEmptyForwardLookup.get(SourceVal, Target);
-    if (auto Find = std::find_if(
-            TargetValToFunc.begin(), TargetValToFunc.end(),
-            [TargetVal](const std::pair<d_t, EdgeFunction<l_t>> &Entry) {
-              return TargetVal == Entry.first;
-            });
-        Find != TargetValToFunc.end()) {
-      TargetValToFunc.erase(Find);
+
+    auto eraseIndex = [TargetId = *TargetId](IndexMap &Map, IdT Val,
+                                             IdT Idx) {
+      auto It = Map.find({TargetId, Val});
+      auto &Indices = It->second;
+      Indices.erase(std::find(Indices.begin(), Indices.end(), Idx));
+      if (Indices.empty()) {
+        Map.erase(It);
+      }
+    };
+    auto replaceIndex = [TargetId = *TargetId](IndexMap &Map, IdT Val,
+                                               IdT From, IdT To) {
+      auto &Indices = Map.find({TargetId, Val})->second;
+      *std::find(Indices.begin(), Indices.end(), From) = To;
+    };
+
+    // Swap the entry with the last one and fix up the indices of the latter
+    auto Idx = IdT(Entry - Entries.data());
+    auto LastIdx = IdT(Entries.size() - 1);
+    eraseIndex(ByTargetVal, *TargetValId, Idx);
+    eraseIndex(BySourceVal, *SourceValId, Idx);
+    if (Idx != LastIdx) {
+      auto &Last = Entries[LastIdx];
+      replaceIndex(ByTargetVal, Last.TargetVal, LastIdx, Idx);
+      replaceIndex(BySourceVal, Last.SourceVal, LastIdx, Idx);
+      *Entry = std::move(Last);
     }
-    return NonEmptyLookupByTargetNode.erase(Target);
+    Entries.pop_back();
+    return true;
   }
 
   /**
    * Removes all jump functions
    */
   void clear() {
-    NonEmptyReverseLookup.clear();
-    NonEmptyForwardLookup.clear();
-    NonEmptyLookupByTargetNode.clear();
+    Nodes.clear();
+    Facts.clear();
+    NodeJumpFunctions.clear();
+    ByTargetVal.clear();
+    BySourceVal.clear();
+  }
+
+  /// The total number of stored jump functions
+  [[nodiscard]] size_t size() const noexcept {
+    size_t Ret = 0;
+    for (const auto &Entries : NodeJumpFunctions) {
+      Ret += Entries.size();
+    }
+    return Ret;
   }
 
-  void printJumpFunctions(llvm::raw_ostream &OS) {
+  void printJumpFunctions(llvm::raw_ostream &OS) const {
     OS << "\n******************************************************";
     OS << "\n*              Print all Jump Functions              *";
     OS << "\n******************************************************\n";
-    for (auto &Entry : NonEmptyLookupByTargetNode) {
-      std::string NLabel = Problem.NtoString(Entry.first);
+    for (size_t TargetId = 0; TargetId < NodeJumpFunctions.size();
+         ++TargetId) {
+      std::string NLabel = Problem.NtoString(Nodes[TargetId]);
       OS << "\nN: " << NLabel << "\n---" << std::string(NLabel.size(), '-')
          << '\n';
-      for (auto Cell : Entry.second.cellSet()) {
-        OS << "D1: " << Problem.DtoString(Cell.r) << '\n'
-           << "\tD2: " << Problem.DtoString(Cell.c) << '\n'
-           << "\tEF: " << Cell.v << "\n\n";
-      }
-    }
-  }
-
-  void printNonEmptyReverseLookup(llvm::raw_ostream &OS) {
-    OS << "DUMP nonEmptyReverseLookup\nTable<N, D, std::unordered_map<D, "
-          "EdgeFunctionPtrType>>\n";
-    auto CellVec = NonEmptyReverseLookup.cellVec();
-    for (auto Cell : CellVec) {
-      OS << "N : " << Problem.NtoString(Cell.r)
-         << "\nD1: " << Problem.DtoString(Cell.c) << '\n';
-      for (auto D2ToEF : Cell.v) {
-        OS << "D2: " << Problem.DtoString(D2ToEF.first)
-           << "\nEF: " << D2ToEF.second << '\n';
-      }
-      OS << '\n';
-    }
-  }
-
-  void printNonEmptyForwardLookup(llvm::raw_ostream &OS) {
-    OS << "DUMP nonEmptyForwardLookup\nTable<D, N, std::unordered_map<D, "
-          "EdgeFunctionPtrType>>\n";
-    auto CellVec = NonEmptyForwardLookup.cellVec();
-    for (auto Cell : CellVec) {
-      OS << "D1: " << Problem.DtoString(Cell.r)
-         << "\nN : " << Problem.NtoString(Cell.c) << '\n';
-      for (auto D2ToEF : Cell.v) {
-        OS << "D2: " << Problem.DtoString(D2ToEF.first)
-           << "\nEF: " << D2ToEF.second << '\n';
-      }
-      OS << '\n';
-    }
-  }
-
-  void printNonEmptyLookupByTargetNode(llvm::raw_ostream &OS) {
-    OS << "DUMP nonEmptyLookupByTargetNode\nstd::unordered_map<N, Table<D, D, "
-          "EdgeFunctionPtrType>>\n";
-    for (auto Node : NonEmptyLookupByTargetNode) {
-      OS << "\nN : " << Problem.NtoString(Node.first) << '\n';
-      auto Table = NonEmptyLookupByTargetNode[Node.first];
-      auto CellVec = Table.cellVec();
-      for (auto Cell : CellVec) {
-        OS << "D1: " << Problem.DtoString(Cell.r)
-           << "\nD2: " << Problem.DtoString(Cell.c) << "\nEF: " << Cell.v
-           << '\n';
+      for (const auto &Entry : NodeJumpFunctions[TargetId]) {
+        OS << "D1: " << Problem.DtoString(Facts[Entry.SourceVal]) << '\n'
+           << "\tD2: " << Problem.DtoString(Facts[Entry.TargetVal]) << '\n'
+           << "\tEF: " << Entry.EdgeFunc << "\n\n";
       }
-      OS << '\n';
     }
   }
-}; // namespace psr
+};
 
 } // namespace psr
 
@@ -0,0 +1,54 @@
+/******************************************************************************
+ * Copyright (c) 2023 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_DATAFLOW_IFDSIDE_SOLVER_SUMMARYPROVIDER_H
+#define PHASAR_DATAFLOW_IFDSIDE_SOLVER_SUMMARYPROVIDER_H
+
+#include "phasar/DataFlow/IfdsIde/EdgeFunction.h"
+#include "phasar/Utils/ByRef.h"
+
+#include "llvm/ADT/STLFunctionalExtras.h"
+
+namespace psr {
+
+/// Supplies the IDESolver with jump functions that have been computed ahead of
+/// time, e.g., by a previous run of the solver on an older version of the
+/// target program.
+///
+/// Whenever the solver enters a function at <StartPoint, SourceVal> for the
+/// first time, it asks the provider for the jump functions starting in that
+/// exploded super-graph node. If the provider knows them, the solver installs
+/// them as they are instead of analyzing the function body. The provided jump
+/// functions must be complete, i.e., they must already contain the effects of
+/// all callees; the solver only enters the callees again to have their jump
+/// functions available for the value computation (Phase II).
+template <typename AnalysisDomainTy> class SummaryProvider {
+public:
+  using n_t = typename AnalysisDomainTy::n_t;
+  using d_t = typename AnalysisDomainTy::d_t;
+  using l_t = typename AnalysisDomainTy::l_t;
+
+  using JumpFunctionHandler = llvm::function_ref<void(
+      ByConstRef<n_t> /*Target*/, ByConstRef<d_t> /*TargetVal*/,
+      const EdgeFunction<l_t> & /*EF*/)>;
+
+  virtual ~SummaryProvider() = default;
+
+  /// Invokes Handler on all jump functions <StartPoint, SourceVal> -> <Target,
+  /// TargetVal> that are known for the given source node. Returns false
+  /// without calling the Handler, if no summary is available, in which case
+  /// the solver analyzes the function as usual.
+  virtual bool provideJumpFunctions(ByConstRef<n_t> StartPoint,
+                                    ByConstRef<d_t> SourceVal,
+                                    JumpFunctionHandler Handler) = 0;
+};
+
+} // namespace psr
+
+#endif // PHASAR_DATAFLOW_IFDSIDE_SOLVER_SUMMARYPROVIDER_H
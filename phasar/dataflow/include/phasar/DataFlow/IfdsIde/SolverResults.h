@@ -19,14 +19,24 @@
 
 #include "phasar/Domain/BinaryDomain.h"
 #include "phasar/Utils/ByRef.h"
+#include "phasar/Utils/Compressor.h"
+#include "phasar/Utils/DefaultValue.h"
 #include "phasar/Utils/PAMMMacros.h"
 #include "phasar/Utils/Printer.h"
 #include "phasar/Utils/Table.h"
 #include "phasar/Utils/Utilities.h"
 
+#include "llvm/ADT/ArrayRef.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <limits>
 #include <set>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace llvm {
@@ -247,6 +257,157 @@ private:
   D ZV;
 };
 
+/// An immutable, compact snapshot of the results of an IDESolver.
+///
+/// The results are stored in compressed-sparse-row format: each statement
+/// that has results is assigned a dense ID that indexes into an offset array,
+/// which delimits the statement's facts and values in two contiguous arrays.
+/// So, the results at a statement are found with a single hash lookup and
+/// returned as views without copying.
+///
+/// Create it with IDESolver::freezeSolverResults() to release the solver's
+/// mutable tables, or from any result table via the constructor.
+template <typename N, typename D, typename L> class FrozenSolverResults {
+public:
+  using n_t = N;
+  using d_t = D;
+  using l_t = L;
+
+  FrozenSolverResults(const Table<n_t, d_t, l_t> &ResTab, d_t ZV)
+      : ZV(std::move(ZV)) {
+    size_t NumCells = 0;
+    for (const auto &[Stmt, Row] : ResTab.rowMap()) {
+      NumCells += Row.size();
+    }
+    NodeIds.reserve(ResTab.size());
+    Offsets.reserve(ResTab.size() + 1);
+    Facts.reserve(NumCells);
+    Values.reserve(NumCells);
+
+    Offsets.push_back(0);
+    for (const auto &[Stmt, Row] : ResTab.rowMap()) {
+      if (Row.empty()) {
+        continue;
+      }
+      NodeIds.getOrInsert(Stmt);
+      appendRow(Row);
+    }
+  }
+
+  [[nodiscard]] bool containsNode(ByConstRef<n_t> Stmt) const {
+    return NodeIds.getOrNull(Stmt).has_value();
+  }
+
+  /// The data-flow facts that hold at Stmt, including the zero value
+  [[nodiscard]] llvm::ArrayRef<d_t> factsAt(ByConstRef<n_t> Stmt) const {
+    auto [Begin, End] = getRange(Stmt);
+    return llvm::ArrayRef<d_t>(Facts).slice(Begin, End - Begin);
+  }
+
+  /// The values of the facts that hold at Stmt; parallel to factsAt(Stmt)
+  [[nodiscard]] llvm::ArrayRef<l_t> valuesAt(ByConstRef<n_t> Stmt) const {
+    auto [Begin, End] = getRange(Stmt);
+    return llvm::ArrayRef<l_t>(Values).slice(Begin, End - Begin);
+  }
+
+  /// Returns the value of Fact at Stmt, or a default-constructed l_t if Fact
+  /// does not hold at Stmt.
+  [[nodiscard]] ByConstRef<l_t> resultAt(ByConstRef<n_t> Stmt,
+                                         ByConstRef<d_t> Fact) const {
+    auto [Begin, End] = getRange(Stmt);
+    auto FactsBegin = Facts.begin() + Begin;
+    auto FactsEnd = Facts.begin() + End;
+    typename std::vector<d_t>::const_iterator It;
+    if constexpr (std::is_pointer_v<d_t>) {
+      It = std::lower_bound(FactsBegin, FactsEnd, Fact, std::less<d_t>{});
+      if (It != FactsEnd && *It != Fact) {
+        It = FactsEnd;
+      }
+    } else {
+      It = std::find(FactsBegin, FactsEnd, Fact);
+    }
+    if (It == FactsEnd) {
+      return getDefaultValue<l_t>();
+    }
+    return Values[std::distance(Facts.begin(), It)];
+  }
+
+  [[nodiscard]] std::unordered_map<d_t, l_t> resultsAt(ByConstRef<n_t> Stmt,
+                                                       bool StripZero) const {
+    auto [Begin, End] = getRange(Stmt);
+    std::unordered_map<d_t, l_t> Result;
+    Result.reserve(End - Begin);
+    for (auto Idx = Begin; Idx != End; ++Idx) {
+      if (StripZero && Facts[Idx] == ZV) {
+        continue;
+      }
+      Result.try_emplace(Facts[Idx], Values[Idx]);
+    }
+    return Result;
+  }
+
+  // this function only exists for IFDS problems which use BinaryDomain as their
+  // value domain L
+  template <typename ValueDomain = l_t,
+            typename = typename std::enable_if_t<
+                std::is_same_v<ValueDomain, BinaryDomain>>>
+  [[nodiscard]] llvm::ArrayRef<d_t> ifdsResultsAt(ByConstRef<n_t> Stmt) const {
+    return factsAt(Stmt);
+  }
+
+  [[nodiscard]] std::vector<typename Table<n_t, d_t, l_t>::Cell>
+  getAllResultEntries() const {
+    std::vector<typename Table<n_t, d_t, l_t>::Cell> Result;
+    Result.reserve(Facts.size());
+    for (uint32_t Id = 0, End = NodeIds.size(); Id != End; ++Id) {
+      for (auto Idx = Offsets[Id]; Idx != Offsets[Id + 1]; ++Idx) {
+        Result.emplace_back(NodeIds[Id], Facts[Idx], Values[Idx]);
+      }
+    }
+    return Result;
+  }
+
+  /// The number of statements that have results
+  [[nodiscard]] size_t getNumNodes() const noexcept { return NodeIds.size(); }
+  /// The total number of (statement, fact, value) triples
+  [[nodiscard]] size_t size() const noexcept { return Facts.size(); }
+  [[nodiscard]] bool empty() const noexcept { return Facts.empty(); }
+
+  [[nodiscard]] ByConstRef<d_t> getZeroValue() const noexcept { return ZV; }
+
+private:
+  void appendRow(const std::unordered_map<d_t, l_t> &Row) {
+    auto RowBegin = Facts.size();
+    for (const auto &[Fact, Value] : Row) {
+      Facts.push_back(Fact);
+    }
+    if constexpr (std::is_pointer_v<d_t>) {
+      // Allows binary search in resultAt()
+      std::sort(Facts.begin() + RowBegin, Facts.end(), std::less<d_t>{});
+    }
+    for (auto Idx = RowBegin, End = Facts.size(); Idx != End; ++Idx) {
+      Values.push_back(Row.at(Facts[Idx]));
+    }
+    assert(Facts.size() <= std::numeric_limits<uint32_t>::max() &&
+           "Too many results for 32 bit offsets");
+    Offsets.push_back(uint32_t(Facts.size()));
+  }
+
+  [[nodiscard]] std::pair<uint32_t, uint32_t>
+  getRange(ByConstRef<n_t> Stmt) const {
+    if (auto Id = NodeIds.getOrNull(Stmt)) {
+      return {Offsets[*Id], Offsets[*Id + 1]};
+    }
+    return {0, 0};
+  }
+
+  Compressor<n_t> NodeIds;
+  std::vector<uint32_t> Offsets;
+  std::vector<d_t> Facts;
+  std::vector<l_t> Values;
+  d_t ZV;
+};
+
 } // namespace psr
 
 #endif
@@ -0,0 +1,148 @@
+/******************************************************************************
+ * Copyright (c) 2023 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_DATAFLOW_MONO_CONTEXTS_CALLSTRINGCONTEXTTREE_H
+#define PHASAR_DATAFLOW_MONO_CONTEXTS_CALLSTRINGCONTEXTTREE_H
+
+#include "phasar/DataFlow/Mono/Contexts/CallStringCTX.h"
+#include "phasar/Utils/Printer.h"
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace psr {
+
+/// Interns the call strings of length at most K into a trie of call sites,
+/// such that a calling context is represented by a single integer id.
+///
+/// Each node of the trie is a call string; its parent is the call string
+/// without the most recent call site. Pushing and popping a call site, as
+/// well as comparing and hashing contexts, therefore are constant-time
+/// operations. Once the call string has reached length K, pushing another
+/// call site drops the oldest one, like CallStringCTX::push_back() does; to
+/// keep this a table lookup, every node additionally caches the id of its
+/// call string without the oldest call site.
+///
+/// The ids are only meaningful with respect to the tree that created them.
+template <typename N, unsigned K> class CallStringContextTree {
+public:
+  using ctx_id_t = uint32_t;
+
+  /// The id of the empty call string
+  static constexpr ctx_id_t EmptyContext = 0;
+
+  CallStringContextTree() { Nodes.push_back({}); }
+
+  /// The context that results from calling CallSite in context Ctx
+  [[nodiscard]] ctx_id_t push(ctx_id_t Ctx, N CallSite) {
+    if (KLimit == 0) {
+      return EmptyContext;
+    }
+    if (Nodes[Ctx].Length == KLimit) {
+      Ctx = Nodes[Ctx].DropOldest;
+    }
+    return getOrCreate(Ctx, CallSite);
+  }
+
+  /// The context that results from returning from the most recent call site
+  /// of Ctx, together with that call site. Popping from the empty context
+  /// yields the empty context and a default-constructed N.
+  [[nodiscard]] std::pair<ctx_id_t, N> pop(ctx_id_t Ctx) const {
+    const auto &Node = Nodes[Ctx];
+    return {Node.Parent, Node.CallSite};
+  }
+
+  [[nodiscard]] bool empty(ctx_id_t Ctx) const noexcept {
+    return Ctx == EmptyContext;
+  }
+
+  [[nodiscard]] unsigned length(ctx_id_t Ctx) const noexcept {
+    return Nodes[Ctx].Length;
+  }
+
+  /// The call sites of Ctx, the oldest first
+  [[nodiscard]] llvm::SmallVector<N, K> getCallString(ctx_id_t Ctx) const {
+    llvm::SmallVector<N, K> CallString(Nodes[Ctx].Length);
+    for (auto Idx = CallString.size(); Idx; --Idx) {
+      CallString[Idx - 1] = Nodes[Ctx].CallSite;
+      Ctx = Nodes[Ctx].Parent;
+    }
+    return CallString;
+  }
+
+  /// Materializes Ctx as CallStringCTX
+  [[nodiscard]] CallStringCTX<N, K> getCallStringCTX(ctx_id_t Ctx) const {
+    CallStringCTX<N, K> Ret;
+    for (auto CallSite : getCallString(Ctx)) {
+      Ret.push_back(CallSite);
+    }
+    return Ret;
+  }
+
+  /// The number of interned contexts, including the empty one
+  [[nodiscard]] size_t size() const noexcept { return Nodes.size(); }
+
+  llvm::raw_ostream &print(llvm::raw_ostream &OS, ctx_id_t Ctx,
+                           const NodePrinterBase<N> &NP) const {
+    OS << "Call string: [ ";
+    auto CallString = getCallString(Ctx);
+    for (size_t Idx = 0, End = CallString.size(); Idx != End; ++Idx) {
+      if (Idx) {
+        OS << " * ";
+      }
+      NP.printNode(OS, CallString[Idx]);
+    }
+    return OS << " ]";
+  }
+
+private:
+  static constexpr unsigned KLimit = K;
+
+  struct Node {
+    N CallSite{};
+    ctx_id_t Parent = EmptyContext;
+    /// The id of this call string without its oldest call site
+    ctx_id_t DropOldest = EmptyContext;
+    unsigned Length = 0;
+  };
+
+  [[nodiscard]] ctx_id_t getOrCreate(ctx_id_t Parent, N CallSite) {
+    auto [It, Inserted] =
+        Children.try_emplace(std::make_pair(Parent, CallSite), 0);
+    if (!Inserted) {
+      return It->second;
+    }
+
+    // Compute the suffix before creating the node, as it may create further
+    // nodes itself
+    auto ParentLength = Nodes[Parent].Length;
+    auto DropOldest =
+        ParentLength == 0
+            ? EmptyContext
+            : getOrCreate(Nodes[Parent].DropOldest, CallSite);
+
+    auto Id = ctx_id_t(Nodes.size());
+    Nodes.push_back({CallSite, Parent, DropOldest, ParentLength + 1});
+    // The recursion may have grown Children, so look up the entry again
+    Children[std::make_pair(Parent, CallSite)] = Id;
+    return Id;
+  }
+
+  std::vector<Node> Nodes;
+  llvm::DenseMap<std::pair<ctx_id_t, N>, ctx_id_t> Children;
+};
+
+} // namespace psr
+
+#endif
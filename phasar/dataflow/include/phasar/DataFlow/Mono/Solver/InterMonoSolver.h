@@ -18,6 +18,7 @@
 #define PHASAR_DATAFLOW_MONO_SOLVER_INTERMONOSOLVER_H
 
 #include "phasar/DataFlow/Mono/Contexts/CallStringCTX.h"
+#include "phasar/DataFlow/Mono/Contexts/CallStringContextTree.h"
 #include "phasar/DataFlow/Mono/InterMonoProblem.h"
 
 #include <deque>
@@ -38,12 +39,16 @@ public:
   using v_t = typename AnalysisDomainTy::v_t;
   using i_t = typename AnalysisDomainTy::i_t;
   using mono_container_t = typename AnalysisDomainTy::mono_container_t;
+  using context_tree_t = CallStringContextTree<n_t, K>;
+  using ctx_id_t = typename context_tree_t::ctx_id_t;
 
 protected:
   ProblemTy &IMProblem;
   std::deque<std::pair<n_t, n_t>> Worklist;
-  std::unordered_map<
-      n_t, std::unordered_map<CallStringCTX<n_t, K>, mono_container_t>>
+  // The calling contexts are interned into Contexts, such that they can be
+  // pushed, popped, hashed and compared without copying the call strings
+  context_tree_t Contexts;
+  std::unordered_map<n_t, std::unordered_map<ctx_id_t, mono_container_t>>
       Analysis;
   std::unordered_set<f_t> AddedFunctions;
   const i_t *ICF;
@@ -57,15 +62,15 @@ protected:
       // Initialize with empty context and empty data-flow set such that the
       // flow functions are at least called once per instruction
       for (auto &[Src, Dst] : ControlFlowEdges) {
-        Analysis[Src][CallStringCTX<n_t, K>()] = IMProblem.allTop();
+        Analysis[Src][context_tree_t::EmptyContext] = IMProblem.allTop();
       }
       // Initialize last
       if (!ControlFlowEdges.empty()) {
-        Analysis[ControlFlowEdges.back().second][CallStringCTX<n_t, K>()] =
+        Analysis[ControlFlowEdges.back().second][context_tree_t::EmptyContext] =
             IMProblem.allTop();
       }
       // Additionally, insert the initial seeds
-      Analysis[Node][CallStringCTX<n_t, K>()].insert(FlowFacts.begin(),
+      Analysis[Node][context_tree_t::EmptyContext].insert(FlowFacts.begin(),
                                                      FlowFacts.end());
     }
   }
@@ -110,11 +115,11 @@ protected:
       // Initialize with empty context and empty data-flow set such that the
       // flow functions are at least called once per instruction
       for (auto &[Src, Dst] : Edges) {
-        Analysis[Src][CallStringCTX<n_t, K>()] = IMProblem.allTop();
+        Analysis[Src][context_tree_t::EmptyContext] = IMProblem.allTop();
       }
       // Initialize last
       if (!Edges.empty()) {
-        Analysis[Edges.back().second][CallStringCTX<n_t, K>()] =
+        Analysis[Edges.back().second][context_tree_t::EmptyContext] =
             IMProblem.allTop();
       }
       // Add return Edge(s)
@@ -171,7 +176,20 @@ public:
   std::unordered_map<
       n_t, std::unordered_map<CallStringCTX<n_t, K>, mono_container_t>>
   getAnalysis() {
-    return Analysis;
+    std::unordered_map<
+        n_t, std::unordered_map<CallStringCTX<n_t, K>, mono_container_t>>
+        Ret;
+    for (const auto &[Node, ContextMap] : Analysis) {
+      auto &RetContextMap = Ret[Node];
+      for (const auto &[Ctx, Facts] : ContextMap) {
+        RetContextMap[Contexts.getCallStringCTX(Ctx)] = Facts;
+      }
+    }
+    return Ret;
+  }
+
+  [[nodiscard]] const context_tree_t &getContextTree() const noexcept {
+    return Contexts;
   }
 
   void processNormal(std::pair<n_t, n_t> Edge) {
@@ -180,7 +198,7 @@ public:
     auto Dst = Edge.second;
     llvm::outs() << "Src: " << IMProblem.NtoString(Src) << '\n';
     llvm::outs() << "Dst: " << IMProblem.NtoString(Dst) << '\n';
-    std::unordered_map<CallStringCTX<n_t, K>, mono_container_t> Out;
+    std::unordered_map<ctx_id_t, mono_container_t> Out;
     for (auto &[Ctx, Facts] : Analysis[Src]) {
       Out[Ctx] = IMProblem.normalFlow(Src, Analysis[Src][Ctx]);
       // need to merge if Dst is a branch target
@@ -221,14 +239,13 @@ public:
   void processCall(std::pair<n_t, n_t> Edge) {
     auto Src = Edge.first;
     auto Dst = Edge.second;
-    std::unordered_map<CallStringCTX<n_t, K>, mono_container_t> Out;
+    std::unordered_map<ctx_id_t, mono_container_t> Out;
     if (!isIntraEdge(Edge)) {
       llvm::outs() << "Handle call flow\n";
       llvm::outs() << "Src: " << IMProblem.NtoString(Src) << '\n';
       llvm::outs() << "Dst: " << IMProblem.NtoString(Dst) << '\n';
       for (auto &[Ctx, Facts] : Analysis[Src]) {
-        auto CTXAdd(Ctx);
-        CTXAdd.push_back(Src);
+        auto CTXAdd = Contexts.push(Ctx, Src);
         Out[CTXAdd] = IMProblem.callFlow(Src, ICF->getFunctionOf(Dst),
                                          Analysis[Src][Ctx]);
         bool FlowFactStabilized =
@@ -285,24 +302,26 @@ public:
   void processExit(std::pair<n_t, n_t> Edge) {
     auto Src = Edge.first;
     auto Dst = Edge.second;
-    std::unordered_map<CallStringCTX<n_t, K>, mono_container_t> Out;
+    std::unordered_map<ctx_id_t, mono_container_t> Out;
     llvm::outs() << "\nHandle ret flow in: "
                  << ICF->getFunctionName(ICF->getFunctionOf(Src)) << '\n';
     llvm::outs() << "Src: " << IMProblem.NtoString(Src) << '\n';
     llvm::outs() << "Dst: " << IMProblem.NtoString(Dst) << '\n';
     for (auto &[Ctx, Facts] : Analysis[Src]) {
-      auto CTXRm(Ctx);
-      CTXRm.print(llvm::outs() << "CTXRm: ", IMProblem) << '\n';
+      auto CTXRm = Ctx;
+      Contexts.print(llvm::outs() << "CTXRm: ", CTXRm, IMProblem) << '\n';
       // we need to use several call- and retsites if the context is empty
       llvm::SmallVector<n_t> CallSites;
 
       // handle empty context
-      if (Ctx.empty()) {
+      if (Contexts.empty(Ctx)) {
         const auto &Callers = ICF->getCallersOf(ICF->getFunctionOf(Src));
         CallSites.append(Callers.begin(), Callers.end());
       } else {
         // handle context containing at least one element
-        CallSites.push_back(CTXRm.pop_back());
+        auto [Caller, CallSite] = Contexts.pop(Ctx);
+        CTXRm = Caller;
+        CallSites.push_back(CallSite);
       }
 
       std::set<n_t> RetSites;
@@ -408,7 +427,7 @@ public:
         OS << "\tEMPTY\n";
       } else {
         for (auto &[Context, FlowFacts] : ContextMap) {
-          Context.print(OS, IMProblem) << '\n';
+          Contexts.print(OS, Context, IMProblem) << '\n';
           if (FlowFacts.empty()) {
             OS << "\tEMPTY\n";
           } else {
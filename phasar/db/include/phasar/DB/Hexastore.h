@@ -12,12 +12,16 @@
 
 #include "phasar/DB/Queries.h"
 
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
 #include "llvm/Support/raw_ostream.h"
 
-#include "boost/format.hpp"
 #include "sqlite3.h"
 
 #include <array>
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -51,6 +55,56 @@ struct HSResult {
            LHS.Object == RHS.Object;
   }
 };
+class Hexastore;
+
+/**
+ * Iterates over the results of a query to the Hexastore without copying them.
+ *
+ * The cursor is positioned before the first result; call next() to advance
+ * it. The names returned by subject(), predicate() and object() are only
+ * valid until the next call to next(). A cursor must not outlive the
+ * Hexastore that created it.
+ *
+ * @brief Streams the results of a query to the Hexastore.
+ */
+class HSCursor {
+public:
+  HSCursor(HSCursor &&Other) noexcept
+      : HS(Other.HS), Stmt(Other.Stmt), Slot(Other.Slot) {
+    Other.Stmt = nullptr;
+  }
+  HSCursor(const HSCursor &) = delete;
+  HSCursor &operator=(const HSCursor &) = delete;
+  HSCursor &operator=(HSCursor &&) = delete;
+  ~HSCursor();
+
+  /// Advances to the next result. Returns false once there are no more
+  /// results.
+  [[nodiscard]] bool next();
+
+  [[nodiscard]] llvm::StringRef subject() const { return column(0); }
+  [[nodiscard]] llvm::StringRef predicate() const { return column(1); }
+  [[nodiscard]] llvm::StringRef object() const { return column(2); }
+
+  /// Copies the current result
+  [[nodiscard]] HSResult toResult() const {
+    return {subject().str(), predicate().str(), object().str()};
+  }
+
+private:
+  friend class Hexastore;
+
+  HSCursor(Hexastore *HS, sqlite3_stmt *Stmt, unsigned Slot) noexcept
+      : HS(HS), Stmt(Stmt), Slot(Slot) {}
+
+  [[nodiscard]] llvm::StringRef column(int Col) const;
+
+  Hexastore *HS;
+  /// nullptr if the query cannot have any results
+  sqlite3_stmt *Stmt;
+  unsigned Slot;
+};
+
 /**
  * A Hexastore is an efficient approach to store large graphs.
  * This approach is based on the paper "Database-Backed Program Analysis
@@ -67,16 +121,65 @@ struct HSResult {
  * look-up. In general, given one or two fixed elements of a (source, edge,
  * destination) tuple, Hexastore can quickly access the related information.
  *
+ * Every label is stored once and assigned an integer id; the indices are
+ * built over the triples of ids. Since every query fixes a prefix of one of
+ * the orderings (source, edge, destination), (edge, destination, source) and
+ * (destination, source, edge), three of the six permutations suffice to
+ * answer all queries with one look-up. All SQL statements are prepared once.
+ * Inserting many tuples is considerably faster within a Transaction.
+ *
  * @brief Efficient data structure for holding graphs in databases.
  */
 class Hexastore {
 private:
+  /// One search statement for every combination of fixed elements
+  static constexpr unsigned NumSearches = 8;
+
   sqlite3 *HSInternalDB{};
+  sqlite3_stmt *TermInsertStmt{};
+  sqlite3_stmt *TermSearchStmt{};
+  sqlite3_stmt *TripleInsertStmt{};
+  /// Search statements that are currently not used by an HSCursor
+  std::array<sqlite3_stmt *, NumSearches> SearchStmts{};
+  /// Caches the ids of the labels that have been looked up or inserted
+  llvm::StringMap<int64_t> TermIds;
+  bool InTransaction = false;
+
   static int callback(void * /*NotUsed*/, int Argc, char **Argv,
                       char **AzColName);
-  void doPut(const std::string &Query, std::array<std::string, 3> Edge);
+  sqlite3_stmt *prepare(const std::string &Query);
+  void exec(const char *Query);
+  std::optional<int64_t> findTerm(llvm::StringRef Name);
+  int64_t getOrInsertTerm(llvm::StringRef Name);
+
+  friend class HSCursor;
+  void releaseSearch(unsigned Slot, sqlite3_stmt *Stmt);
 
 public:
+  /**
+   * Groups all insertions into the Hexastore until commit() into a single
+   * database transaction. If the Transaction is destroyed without being
+   * committed, the insertions are rolled back. Transactions do not nest;
+   * while a Transaction is active, creating another one has no effect.
+   *
+   * @brief Scoped database transaction.
+   */
+  class Transaction {
+  public:
+    explicit Transaction(Hexastore &HS);
+    Transaction(const Transaction &) = delete;
+    Transaction &operator=(const Transaction &) = delete;
+    ~Transaction();
+
+    /// Makes the insertions since the construction persistent
+    void commit();
+
+  private:
+    Hexastore *HS;
+    /// Whether this is the outermost Transaction
+    bool Active;
+  };
+
   /**
    * If the given filename matches an already created Hexastore, no
    * new Hexastore will be created. Instead the already created Hexastore
@@ -107,6 +210,18 @@ public:
    */
   void put(const std::array<std::string, 3> &Edge);
 
+  /// @brief Creates a new entry in the Hexastore.
+  void put(llvm::StringRef Subject, llvm::StringRef Predicate,
+           llvm::StringRef Object);
+
+  /**
+   * Adds all given tuples within a single transaction; see put().
+   *
+   * @brief Creates new entries in the Hexastore.
+   * @param Edges New entries in the form of 3-tuples.
+   */
+  void putAll(llvm::ArrayRef<std::array<std::string, 3>> Edges);
+
   /**
    * A query is always in the form of a 3-tuple (source, edge, destination)
    * where
@@ -124,6 +239,16 @@ public:
    */
   std::vector<HSResult> get(std::array<std::string, 3> EdgeQuery,
                             size_t ResultSizeHint = 0);
+
+  /**
+   * Same as get(), but streams the results instead of copying all of them
+   * into a vector.
+   *
+   * @brief Query information from the Hexastore.
+   * @param EdgeQuery Query in the form of a 3-tuple.
+   * @return A cursor over the queried information.
+   */
+  [[nodiscard]] HSCursor query(const std::array<std::string, 3> &EdgeQuery);
 };
 
 } // namespace psr
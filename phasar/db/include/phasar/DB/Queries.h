@@ -14,17 +14,22 @@
 
 namespace psr {
 
-extern const std::string SPOInsert;
-
-extern const std::string SOPInsert;
+/// Creates the tables of the Hexastore, if they do not exist yet
+extern const std::string INIT;
 
-extern const std::string PSOInsert;
+/// Interns a name; parameter 1 is the name
+extern const std::string TermInsert;
 
-extern const std::string POSInsert;
+/// Looks up the id of a name; parameter 1 is the name
+extern const std::string TermSearch;
 
-extern const std::string OSPInsert;
+/// Inserts a triple; parameters 1-3 are the ids of subject, predicate and
+/// object
+extern const std::string TripleInsert;
 
-extern const std::string OPSInsert;
+// The searches take the ids of subject, predicate and object as parameters
+// 1-3; an 'X' marks a wildcard. Each of them yields the names of subject,
+// predicate and object, ordered by the index that answers the search.
 
 extern const std::string SearchSPO;
 
@@ -42,8 +47,6 @@ extern const std::string SearchXXO;
 
 extern const std::string SearchXXX;
 
-extern const std::string INIT;
-
 } // namespace psr
 
 #endif
@@ -9,8 +9,23 @@
 
 #include "phasar/DB/Hexastore.h"
 
+#include <cassert>
+#include <utility>
+
 namespace psr {
 
+namespace {
+/// The search for the given fixed elements: subject = 4, predicate = 2,
+/// object = 1
+const std::string &getSearch(unsigned Fixed) {
+  static const std::array<const std::string *, 8> Searches = {
+      &SearchXXX, &SearchXXO, &SearchXPX, &SearchXPO,
+      &SearchSXX, &SearchSXO, &SearchSPX, &SearchSPO,
+  };
+  return *Searches[Fixed];
+}
+} // namespace
+
 Hexastore::Hexastore(const std::string &Filename) {
   sqlite3_open(Filename.c_str(), &HSInternalDB);
   const std::string Query = INIT;
@@ -18,10 +33,26 @@ Hexastore::Hexastore(const std::string &Filename) {
   sqlite3_exec(HSInternalDB, Query.c_str(), callback, nullptr, &Err);
   if (Err != nullptr) {
     llvm::outs() << Err << "\n\n";
+    sqlite3_free(Err);
+  }
+
+  TermInsertStmt = prepare(TermInsert);
+  TermSearchStmt = prepare(TermSearch);
+  TripleInsertStmt = prepare(TripleInsert);
+  for (unsigned Idx = 0; Idx != NumSearches; ++Idx) {
+    SearchStmts[Idx] = prepare(getSearch(Idx));
   }
 }
 
-Hexastore::~Hexastore() { sqlite3_close(HSInternalDB); }
+Hexastore::~Hexastore() {
+  for (auto *Stmt : SearchStmts) {
+    sqlite3_finalize(Stmt);
+  }
+  sqlite3_finalize(TermInsertStmt);
+  sqlite3_finalize(TermSearchStmt);
+  sqlite3_finalize(TripleInsertStmt);
+  sqlite3_close(HSInternalDB);
+}
 
 int Hexastore::callback(void * /*NotUsed*/, int Argc, char **Argv,
                         char **AzColName) {
@@ -32,23 +63,114 @@ int Hexastore::callback(void * /*NotUsed*/, int Argc, char **Argv,
   return 0;
 }
 
-void Hexastore::put(const std::array<std::string, 3> &Edge) {
-  doPut(SPOInsert, Edge);
-  doPut(SOPInsert, Edge);
-  doPut(PSOInsert, Edge);
-  doPut(POSInsert, Edge);
-  doPut(OSPInsert, Edge);
-  doPut(OPSInsert, Edge);
-}
-
-void Hexastore::doPut(const std::string &Query,
-                      std::array<std::string, 3> Edge) {
-  std::string CompiledQuery =
-      str(boost::format(Query) % Edge[0] % Edge[1] % Edge[2]);
+sqlite3_stmt *Hexastore::prepare(const std::string &Query) {
+  sqlite3_stmt *Stmt = nullptr;
+  if (sqlite3_prepare_v2(HSInternalDB, Query.c_str(), int(Query.size() + 1),
+                         &Stmt, nullptr) != SQLITE_OK) {
+    llvm::outs() << sqlite3_errmsg(HSInternalDB) << '\n';
+  }
+  return Stmt;
+}
+
+void Hexastore::exec(const char *Query) {
   char *Err;
-  sqlite3_exec(HSInternalDB, CompiledQuery.c_str(), callback, nullptr, &Err);
+  sqlite3_exec(HSInternalDB, Query, callback, nullptr, &Err);
   if (Err != nullptr) {
-    llvm::outs() << Err;
+    llvm::outs() << Err << '\n';
+    sqlite3_free(Err);
+  }
+}
+
+std::optional<int64_t> Hexastore::findTerm(llvm::StringRef Name) {
+  if (auto It = TermIds.find(Name); It != TermIds.end()) {
+    return It->second;
+  }
+
+  sqlite3_bind_text(TermSearchStmt, 1, Name.data(), int(Name.size()),
+                    SQLITE_STATIC);
+  std::optional<int64_t> Id;
+  if (sqlite3_step(TermSearchStmt) == SQLITE_ROW) {
+    Id = sqlite3_column_int64(TermSearchStmt, 0);
+    TermIds[Name] = *Id;
+  }
+  sqlite3_reset(TermSearchStmt);
+  return Id;
+}
+
+int64_t Hexastore::getOrInsertTerm(llvm::StringRef Name) {
+  if (auto Id = findTerm(Name)) {
+    return *Id;
+  }
+
+  sqlite3_bind_text(TermInsertStmt, 1, Name.data(), int(Name.size()),
+                    SQLITE_STATIC);
+  if (sqlite3_step(TermInsertStmt) != SQLITE_DONE) {
+    llvm::outs() << sqlite3_errmsg(HSInternalDB) << '\n';
+  }
+  sqlite3_reset(TermInsertStmt);
+  auto Id = sqlite3_last_insert_rowid(HSInternalDB);
+  TermIds[Name] = Id;
+  return Id;
+}
+
+void Hexastore::put(const std::array<std::string, 3> &Edge) {
+  put(Edge[0], Edge[1], Edge[2]);
+}
+
+void Hexastore::put(llvm::StringRef Subject, llvm::StringRef Predicate,
+                    llvm::StringRef Object) {
+  sqlite3_bind_int64(TripleInsertStmt, 1, getOrInsertTerm(Subject));
+  sqlite3_bind_int64(TripleInsertStmt, 2, getOrInsertTerm(Predicate));
+  sqlite3_bind_int64(TripleInsertStmt, 3, getOrInsertTerm(Object));
+  if (sqlite3_step(TripleInsertStmt) != SQLITE_DONE) {
+    llvm::outs() << sqlite3_errmsg(HSInternalDB) << '\n';
+  }
+  sqlite3_reset(TripleInsertStmt);
+}
+
+void Hexastore::putAll(llvm::ArrayRef<std::array<std::string, 3>> Edges) {
+  Transaction Trans(*this);
+  for (const auto &Edge : Edges) {
+    put(Edge);
+  }
+  Trans.commit();
+}
+
+HSCursor Hexastore::query(const std::array<std::string, 3> &EdgeQuery) {
+  unsigned Slot = 0;
+  std::array<int64_t, 3> Ids{};
+  for (unsigned Idx = 0; Idx != 3; ++Idx) {
+    Slot <<= 1;
+    if (EdgeQuery[Idx] == "?") {
+      continue;
+    }
+    auto Id = findTerm(EdgeQuery[Idx]);
+    if (!Id) {
+      // An unknown label cannot be part of any entry
+      return {this, nullptr, 0};
+    }
+    Ids[Idx] = *Id;
+    Slot |= 1;
+  }
+
+  // Another cursor may still use the cached statement
+  auto *Stmt = std::exchange(SearchStmts[Slot], nullptr);
+  if (!Stmt) {
+    Stmt = prepare(getSearch(Slot));
+  }
+  for (int Idx = 1, End = sqlite3_bind_parameter_count(Stmt); Idx <= End;
+       ++Idx) {
+    sqlite3_bind_int64(Stmt, Idx, Ids[Idx - 1]);
+  }
+  return {this, Stmt, Slot};
+}
+
+void Hexastore::releaseSearch(unsigned Slot, sqlite3_stmt *Stmt) {
+  sqlite3_reset(Stmt);
+  if (!SearchStmts[Slot]) {
+    SearchStmts[Slot] = Stmt;
+  } else {
+    sqlite3_finalize(Stmt);
   }
 }
 
@@ -56,53 +178,61 @@ std::vector<HSResult> Hexastore::get(std::array<std::string, 3> EdgeQuery,
                                      size_t ResultSizeHint) {
   std::vector<HSResult> Result;
   Result.reserve(ResultSizeHint);
-  std::string QueryString;
-  if (EdgeQuery[0] == "?") {
-    if (EdgeQuery[1] == "?") {
-      if (EdgeQuery[2] == "?") {
-        QueryString = SearchXXX;
-      } else {
-        QueryString = SearchXXO;
-      }
-    } else {
-      if (EdgeQuery[2] == "?") {
-        QueryString = SearchXPX;
-      } else {
-        QueryString = SearchXPO;
-      }
-    }
-  } else {
-    if (EdgeQuery[1] == "?") {
-      if (EdgeQuery[2] == "?") {
-        QueryString = SearchSXX;
-      } else {
-        QueryString = SearchSXO;
-      }
-    } else {
-      if (EdgeQuery[2] == "?") {
-        QueryString = SearchSPX;
-      } else {
-        QueryString = SearchSPO;
-      }
-    }
-  }
-  std::string CompiledQuery = str(boost::format(QueryString) % EdgeQuery[0] %
-                                  EdgeQuery[1] % EdgeQuery[2]);
-  // this lambda will collect all of our results, since it is called on every
-  // row of the result set
-  auto SqliteCBResultCollector = [](void *CB, int /*Argc*/, char **Argv,
-                                    char ** /*AzColName*/) {
-    auto *Res = static_cast<std::vector<HSResult> *>(CB);
-    Res->emplace_back(Argv[0], Argv[1], Argv[2]);
-    return 0;
-  };
-  char *Err;
-  sqlite3_exec(HSInternalDB, CompiledQuery.c_str(), SqliteCBResultCollector,
-               &Result, &Err);
-  if (Err != nullptr) {
-    llvm::outs() << Err;
+  auto Cursor = query(EdgeQuery);
+  while (Cursor.next()) {
+    Result.push_back(Cursor.toResult());
   }
   return Result;
 }
 
+Hexastore::Transaction::Transaction(Hexastore &HS)
+    : HS(&HS), Active(!HS.InTransaction) {
+  if (Active) {
+    HS.exec("begin transaction;");
+    HS.InTransaction = true;
+  }
+}
+
+Hexastore::Transaction::~Transaction() {
+  if (Active) {
+    HS->exec("rollback transaction;");
+    HS->InTransaction = false;
+    // The cache may hold ids of labels whose insertion has been rolled back
+    HS->TermIds.clear();
+  }
+}
+
+void Hexastore::Transaction::commit() {
+  if (Active) {
+    HS->exec("commit transaction;");
+    HS->InTransaction = false;
+    Active = false;
+  }
+}
+
+HSCursor::~HSCursor() {
+  if (Stmt) {
+    HS->releaseSearch(Slot, Stmt);
+  }
+}
+
+bool HSCursor::next() {
+  if (!Stmt) {
+    return false;
+  }
+  if (sqlite3_step(Stmt) == SQLITE_ROW) {
+    return true;
+  }
+  HS->releaseSearch(Slot, Stmt);
+  Stmt = nullptr;
+  return false;
+}
+
+llvm::StringRef HSCursor::column(int Col) const {
+  assert(Stmt && "No current result");
+  const auto *Text =
+      reinterpret_cast<const char *>(sqlite3_column_text(Stmt, Col));
+  return {Text, size_t(sqlite3_column_bytes(Stmt, Col))};
+}
+
 } // namespace psr
@@ -6,6 +6,9 @@
 #include "gtest/gtest.h"
 
 #include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
 
 using namespace psr;
 using namespace std;
@@ -96,6 +99,63 @@ TEST(HexastoreTest, AllQueryTypes) {
   ASSERT_EQ(Result, GroundTruth);
 }
 
+TEST(HexastoreTest, BulkLoadAndCursor) {
+  Hexastore H("");
+  std::vector<std::array<std::string, 3>> Edges = {
+      {"main", "calls", "foo"},
+      {"main", "calls", "bar"},
+      {"foo", "calls", "bar"},
+      {"main", "calls", "foo"},
+  };
+  H.putAll(Edges);
+
+  // Duplicates are ignored
+  EXPECT_EQ(H.get({{"?", "?", "?"}}).size(), 3U);
+
+  auto Cursor = H.query({{"main", "calls", "?"}});
+  ASSERT_TRUE(Cursor.next());
+  EXPECT_EQ(Cursor.subject(), "main");
+  EXPECT_EQ(Cursor.predicate(), "calls");
+  EXPECT_EQ(Cursor.object(), "foo");
+  // A second cursor of the same kind while the first one is still in use
+  auto Callers = H.query({{"?", "calls", "bar"}});
+  ASSERT_TRUE(Cursor.next());
+  EXPECT_EQ(Cursor.toResult(), HSResult("main", "calls", "bar"));
+  EXPECT_FALSE(Cursor.next());
+  EXPECT_FALSE(Cursor.next());
+
+  std::vector<std::string> CallerNames;
+  while (Callers.next()) {
+    CallerNames.push_back(Callers.subject().str());
+  }
+  EXPECT_EQ(CallerNames, std::vector<std::string>({"main", "foo"}));
+
+  // Unknown labels yield no results
+  EXPECT_FALSE(H.query({{"baz", "?", "?"}}).next());
+  EXPECT_TRUE(H.get({{"main", "?", "baz"}}).empty());
+}
+
+TEST(HexastoreTest, Transactions) {
+  Hexastore H("");
+  H.put("a", "b", "c");
+  {
+    Hexastore::Transaction Trans(H);
+    H.put("d", "e", "f");
+    // Not committed, so rolled back
+  }
+  EXPECT_EQ(H.get({{"?", "?", "?"}}),
+            std::vector<HSResult>({HSResult("a", "b", "c")}));
+  EXPECT_TRUE(H.get({{"d", "?", "?"}}).empty());
+
+  {
+    Hexastore::Transaction Trans(H);
+    H.put("d", "e", "f");
+    Trans.commit();
+  }
+  EXPECT_EQ(H.get({{"d", "?", "?"}}),
+            std::vector<HSResult>({HSResult("d", "e", "f")}));
+}
+
 TEST(HexastoreTest, StoreGraphNoEdgeLabels) {
   struct Vertex {
     string Name;
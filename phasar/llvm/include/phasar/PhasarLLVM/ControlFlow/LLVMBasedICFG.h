@@ -33,6 +33,7 @@
 #include "llvm/IR/Function.h"
 #include "llvm/IR/Instruction.h"
 #include "llvm/IR/Value.h"
+#include "llvm/Support/MemoryBufferRef.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include "nlohmann/json.hpp"
@@ -72,12 +73,16 @@ public:
   /// \param IncludeGlobals Properly include global constructors/destructors
   /// into the ICFG, if true. Requires to generate artificial functions into the
   /// IRDB. True by default
+  /// \param NumThreads The number of threads to scan the functions and to
+  /// resolve the indirect calls with. The indirect calls are only resolved
+  /// concurrently if the resolver supports it, see
+  /// Resolver::supportsConcurrentResolution(). 1 by default
   explicit LLVMBasedICFG(LLVMProjectIRDB *IRDB, CallGraphAnalysisType CGType,
                          llvm::ArrayRef<std::string> EntryPoints = {},
                          LLVMTypeHierarchy *TH = nullptr,
                          LLVMAliasInfoRef PT = nullptr,
                          Soundness S = Soundness::Soundy,
-                         bool IncludeGlobals = true);
+                         bool IncludeGlobals = true, unsigned NumThreads = 1);
 
   /// Creates an ICFG with an already given call-graph
   explicit LLVMBasedICFG(CallGraph<n_t, f_t> CG, LLVMProjectIRDB *IRDB,
@@ -87,6 +92,13 @@ public:
                          const nlohmann::json &SerializedCG,
                          LLVMTypeHierarchy *TH = nullptr);
 
+  /// Loads the call-graph that has been written by writeBinary() on the same
+  /// module. Returns nullptr, if Buf does not contain a valid call-graph for
+  /// the module of IRDB.
+  [[nodiscard]] static std::unique_ptr<LLVMBasedICFG>
+  loadBinary(LLVMProjectIRDB *IRDB, llvm::MemoryBufferRef Buf,
+             LLVMTypeHierarchy *TH = nullptr);
+
   ~LLVMBasedICFG();
 
   LLVMBasedICFG(const LLVMBasedICFG &) = delete;
@@ -106,6 +118,10 @@ public:
   [[nodiscard]] nlohmann::json
   exportICFGAsJson(bool WithSourceCodeInfo = true) const;
 
+  /// Writes the call-graph in a compact binary format that is much faster to
+  /// load than the JSON of getAsJson(). Use loadBinary() for deserialization.
+  void writeBinary(llvm::raw_ostream &OS) const;
+
   [[nodiscard]] size_t getNumVertexFunctions() const noexcept {
     return CG.getNumVertexFunctions();
   }
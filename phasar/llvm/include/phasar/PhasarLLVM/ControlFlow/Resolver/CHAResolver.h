@@ -33,6 +33,9 @@ public:
 
   FunctionSetTy resolveVirtualCall(const llvm::CallBase *CallSite) override;
 
+  /// The resolution only reads the type hierarchy
+  [[nodiscard]] bool supportsConcurrentResolution() const noexcept override;
+
   [[nodiscard]] std::string str() const override;
 };
 } // namespace psr
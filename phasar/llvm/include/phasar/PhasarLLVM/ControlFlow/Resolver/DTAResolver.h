@@ -39,6 +39,8 @@ public:
 
 protected:
   TypeGraph_t TypeGraph;
+  /// The number of links that have been added to the TypeGraph so far
+  size_t NumAddedLinks = 0;
 
   /**
    * An heuristic that return true if the bitcast instruction is interesting to
@@ -63,6 +65,13 @@ public:
 
   void otherInst(const llvm::Instruction *Inst) override;
 
+  /// Querying the TypeGraph may update its cache
+  [[nodiscard]] bool supportsConcurrentResolution() const noexcept override;
+
+  /// The resolution only changes if the TypeGraph has changed
+  [[nodiscard]] size_t
+  getResolutionEpoch(const llvm::CallBase *CallSite) override;
+
   [[nodiscard]] std::string str() const override;
 };
 } // namespace psr
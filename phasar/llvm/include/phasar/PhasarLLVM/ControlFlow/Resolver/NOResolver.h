@@ -45,6 +45,8 @@ public:
 
   void otherInst(const llvm::Instruction *Inst) override;
 
+  [[nodiscard]] bool supportsConcurrentResolution() const noexcept override;
+
   [[nodiscard]] std::string str() const override;
 };
 } // namespace psr
@@ -60,6 +60,15 @@ public:
 
   FunctionSetTy resolveFunctionPointer(const llvm::CallBase *CallSite) override;
 
+  /// Only an LLVMAliasSet, whose alias sets have all been computed, can be
+  /// queried concurrently
+  [[nodiscard]] bool supportsConcurrentResolution() const noexcept override;
+
+  /// The alias sets only grow during call-graph construction, so their size
+  /// tells whether the alias set of the called operand has changed
+  [[nodiscard]] size_t
+  getResolutionEpoch(const llvm::CallBase *CallSite) override;
+
   static std::set<const llvm::Type *>
   getReachableTypes(const LLVMAliasInfo::AliasSetTy &Values);
 
@@ -81,6 +81,21 @@ public:
 
   virtual void otherInst(const llvm::Instruction *Inst);
 
+  /// Whether resolveVirtualCall() and resolveFunctionPointer() may be called
+  /// concurrently from multiple threads. All other member functions always
+  /// require exclusive access to the resolver.
+  [[nodiscard]] virtual bool supportsConcurrentResolution() const noexcept;
+
+  /// A version number of the information that resolving CallSite depends on.
+  /// If it did not change since CallSite has been resolved the last time,
+  /// resolving CallSite again does not yield new targets. The call-graph
+  /// builder uses this to skip resolving unchanged indirect call-sites.
+  ///
+  /// The default implementation assumes that the resolution does not depend
+  /// on any information that changes during call-graph construction.
+  [[nodiscard]] virtual size_t
+  getResolutionEpoch(const llvm::CallBase *CallSite);
+
   [[nodiscard]] virtual std::string str() const = 0;
 
   static std::unique_ptr<Resolver>
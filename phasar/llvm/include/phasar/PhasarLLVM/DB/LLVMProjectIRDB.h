@@ -26,6 +26,7 @@
 #include "llvm/Support/raw_ostream.h"
 
 #include <memory>
+#include <optional>
 
 namespace psr {
 class LLVMProjectIRDB;
@@ -88,6 +89,19 @@ public:
   [[nodiscard]] const llvm::Value *getValueFromId(size_t Id) const noexcept {
     return Id < IdToInst.size() ? IdToInst[Id] : nullptr;
   }
+  /// The inverse of getValueFromId(). Returns std::nullopt for values that are
+  /// neither global variables nor instructions
+  [[nodiscard]] std::optional<size_t>
+  getValueId(const llvm::Value *V) const noexcept {
+    if (auto It = InstToId.find(V); It != InstToId.end()) {
+      return It->second;
+    }
+    return std::nullopt;
+  }
+  /// The number of ids that can be passed to getValueFromId()
+  [[nodiscard]] size_t getNumValueIds() const noexcept {
+    return IdToInst.size();
+  }
 
   void emitPreprocessedIR(llvm::raw_ostream &OS) const;
 
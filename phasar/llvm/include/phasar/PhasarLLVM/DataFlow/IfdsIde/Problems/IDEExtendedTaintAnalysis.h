@@ -19,6 +19,7 @@
 #include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/ExtendedTaintAnalysis/EdgeDomain.h"
 #include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/ExtendedTaintAnalysis/Helpers.h"
 #include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/ExtendedTaintAnalysis/XTaintAnalysisBase.h"
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/TaintLeakReporting.h"
 #include "phasar/PhasarLLVM/Domain/LLVMAnalysisDomain.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMAliasInfo.h"
 #include "phasar/PhasarLLVM/TaintConfig/LLVMTaintConfig.h"
@@ -165,6 +166,7 @@ private:
   void reportLeakIfNecessary(const llvm::Instruction *Inst,
                              const llvm::Value *SinkCandidate,
                              const llvm::Value *LeakCandidate);
+  void reportLeak(const llvm::Instruction *Inst, const llvm::Value *Leak);
 
   FlowFunctionPtrType handleConfig(const llvm::Instruction *Inst,
                                    SourceConfigTy &&SourceConfig,
@@ -278,6 +280,7 @@ private:
   /// Save all leaks here that were found using the IFDS part if the analysis.
   /// Hence, this map may contain sanitized facts.
   XTaint::LeakMap_t Leaks;
+  LeakCallbackTy OnLeak;
 
   // Used for determining whether a dataflow fact is still tained or already
   // sanitized
@@ -320,6 +323,18 @@ public:
   /// This function does NOT involve a post-processing step.
   LeakMap_t &getAllLeaks() { return Leaks; }
 
+  /// Registers a callback that is invoked once for each leak.
+  ///
+  /// If strong updates are disabled, the callback is invoked as soon as the
+  /// IFDS part of the analysis finds the leak. Otherwise, the leaks of the
+  /// IFDS part may still be sanitized, so the callback is only invoked for the
+  /// leaks that remain after the post-processing in getAllLeaks(SR) or
+  /// emitTextReport(). In that case, a TaintLeakStopCondition cannot stop the
+  /// solver early.
+  ///
+  /// \see TaintLeakStopCondition on how to stop the solver early.
+  void setLeakCallback(LeakCallbackTy CB) { OnLeak = std::move(CB); }
+
   [[nodiscard]] inline size_t getNumDataflowFacts() const {
     return FactFactory.size();
   }
@@ -96,6 +96,18 @@ public:
 
   [[nodiscard]] bool isZeroValue(d_t Fact) const override;
 
+  /// The flow and edge functions of the linear constant analysis do not
+  /// have side effects, so it can be solved in parallel.
+  [[nodiscard]] bool supportsParallelSolving() const noexcept override {
+    return true;
+  }
+
+  /// All results of the linear constant analysis are values of the solver,
+  /// so calls can be replaced by function summaries.
+  [[nodiscard]] bool supportsFunctionSummaries() const noexcept override {
+    return true;
+  }
+
   // in addition provide specifications for the IDE parts
 
   EdgeFunction<l_t> getNormalEdgeFunction(n_t Curr, d_t CurrNode, n_t Succ,
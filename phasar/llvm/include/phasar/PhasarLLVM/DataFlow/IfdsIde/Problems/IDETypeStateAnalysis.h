@@ -11,14 +11,17 @@
 #define PHASAR_PHASARLLVM_DATAFLOW_IFDSIDE_PROBLEMS_IDETYPESTATEANALYSIS_H
 
 #include "phasar/DataFlow/IfdsIde/IDETabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/TypeStateDescriptions/TypeStateDescription.h"
 #include "phasar/PhasarLLVM/Domain/LLVMAnalysisDomain.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMAliasInfo.h"
 
 #include "llvm/IR/InstrTypes.h"
 
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 
 namespace llvm {
@@ -32,7 +35,6 @@ namespace psr {
 
 class LLVMBasedICFG;
 class LLVMTypeHierarchy;
-struct TypeStateDescription;
 
 struct IDETypeStateAnalysisDomain : public LLVMAnalysisDomainDefault {
   using l_t = int;
@@ -52,6 +54,20 @@ public:
 
   using ConfigurationTy = TypeStateDescription;
 
+  /// What the analysis needs to know about a callee with respect to the type
+  /// state description. It is computed only once per function, such that
+  /// flow and edge functions neither demangle the callee's name nor look it
+  /// up in the type state description again.
+  struct APIFunctionInfo {
+    std::string DemangledName;
+    /// The token of the function if the description provides token ids
+    std::optional<TypeStateDescription::TokenId> Token;
+    std::set<int> ConsumerParamIdx;
+    bool IsAPIFunction = false;
+    bool IsFactoryFunction = false;
+    bool IsConsumingFunction = false;
+  };
+
   IDETypeStateAnalysis(const LLVMProjectIRDB *IRDB, LLVMAliasInfoRef PT,
                        const TypeStateDescription *TSD,
                        std::vector<std::string> EntryPoints = {"main"});
@@ -135,6 +151,13 @@ private:
   LLVMAliasInfoRef PT{};
   std::map<const llvm::Value *, std::set<const llvm::Value *>>
       RelevantAllocaCache;
+  // Node-based, since edge functions refer to the entries
+  std::unordered_map<const llvm::Function *, APIFunctionInfo> APIFunctionCache;
+
+  /**
+   * @brief Returns the API-related information about the function F.
+   */
+  const APIFunctionInfo &getAPIFunctionInfo(f_t F);
 
   /**
    * @brief Returns all alloca's that are (indirect) aliases of V.
@@ -11,6 +11,7 @@
 #define PHASAR_PHASARLLVM_DATAFLOW_IFDSIDE_PROBLEMS_IFDSTAINTANALYSIS_H
 
 #include "phasar/DataFlow/IfdsIde/IFDSTabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/TaintLeakReporting.h"
 #include "phasar/PhasarLLVM/Domain/LLVMAnalysisDomain.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMAliasInfo.h"
 
@@ -59,6 +60,12 @@ public:
 
   ~IFDSTaintAnalysis() override = default;
 
+  /// Registers a callback that is invoked for each new leak as soon as the
+  /// analysis finds it, in addition to recording it in Leaks.
+  ///
+  /// \see TaintLeakStopCondition on how to stop the solver early.
+  void setLeakCallback(LeakCallbackTy CB) { OnLeak = std::move(CB); }
+
   FlowFunctionPtrType getNormalFlowFunction(n_t Curr, n_t Succ) override;
 
   FlowFunctionPtrType getCallFlowFunction(n_t CallSite, f_t DestFun) override;
@@ -91,6 +98,9 @@ public:
 private:
   const LLVMTaintConfig *Config{};
   LLVMAliasInfoRef PT{};
+  LeakCallbackTy OnLeak;
+
+  void reportLeak(n_t CallSite, d_t Leak);
 
   bool isSourceCall(const llvm::CallBase *CB,
                     const llvm::Function *Callee) const;
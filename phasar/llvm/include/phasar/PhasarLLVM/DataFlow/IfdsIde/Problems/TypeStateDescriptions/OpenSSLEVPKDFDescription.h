@@ -10,14 +10,16 @@
 #ifndef PHASAR_PHASARLLVM_DATAFLOW_IFDSIDE_PROBLEMS_TYPESTATEDESCRIPTIONS_OPENSSLEVPKDFDESCRIPTION_H
 #define PHASAR_PHASARLLVM_DATAFLOW_IFDSIDE_PROBLEMS_TYPESTATEDESCRIPTIONS_OPENSSLEVPKDFDESCRIPTION_H
 
-#include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/TypeStateDescriptions/TypeStateDescription.h"
-
-#include <map>
-#include <set>
-#include <string>
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/TypeStateDescriptions/TypeStateAutomaton.h"
 
 namespace psr {
-class OpenSSLEVPKDFDescription : public TypeStateDescription {
+
+/**
+ * A type state description for the EVP_KDF objects of OpenSSL. The finite
+ * state machine is encoded by a TypeStateAutomaton with rows as function
+ * tokens and columns as states.
+ */
+class OpenSSLEVPKDFDescription : public TypeStateAutomaton {
 public:
   /**
    * We use the following lattice
@@ -35,52 +37,10 @@ public:
     BOT = 3
   };
 
-  /**
-   * The STAR token represents all functions besides EVP_KDF_fetch(),
-   * EVP_KDF_fetch()  and EVP_KDF_CTX_free().
-   */
-  enum class OpenSSLEVTKDFToken {
-    EVP_KDF_FETCH = 0,
-    EVP_KDF_FREE = 1,
-    STAR = 2
-  };
+  OpenSSLEVPKDFDescription();
 
 private:
-  static const std::map<std::string, std::set<int>> OpenSSLEVPKDFFuncs;
-  // delta matrix to implement the state machine's delta function
-  static const OpenSSLEVPKDFState Delta[3][4];
-  static OpenSSLEVTKDFToken funcNameToToken(const std::string &F);
-
-public:
-  [[nodiscard]] bool isFactoryFunction(const std::string &F) const override;
-
-  [[nodiscard]] bool isConsumingFunction(const std::string &F) const override;
-
-  [[nodiscard]] bool isAPIFunction(const std::string &F) const override;
-
-  [[nodiscard]] TypeStateDescription::State
-  getNextState(std::string Tok, TypeStateDescription::State S) const override;
-
-  [[nodiscard]] std::string getTypeNameOfInterest() const override;
-
-  [[nodiscard]] std::set<int>
-  getConsumerParamIdx(const std::string &F) const override;
-
-  [[nodiscard]] std::set<int>
-  getFactoryParamIdx(const std::string &F) const override;
-
-  [[nodiscard]] std::string
-  stateToString(TypeStateDescription::State S) const override;
-
-  [[nodiscard]] TypeStateDescription::State bottom() const override;
-
-  [[nodiscard]] TypeStateDescription::State top() const override;
-
-  [[nodiscard]] TypeStateDescription::State uninit() const override;
-
-  [[nodiscard]] TypeStateDescription::State start() const override;
-
-  [[nodiscard]] TypeStateDescription::State error() const override;
+  static TypeStateAutomaton buildAutomaton();
 };
 
 } // namespace psr
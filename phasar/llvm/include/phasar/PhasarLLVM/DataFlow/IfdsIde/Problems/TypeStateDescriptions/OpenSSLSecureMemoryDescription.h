@@ -10,15 +10,16 @@
 #ifndef PHASAR_PHASARLLVM_DATAFLOW_IFDSIDE_PROBLEMS_TYPESTATEDESCRIPTIONS_OPENSSLSECUREMEMORYDESCRIPTION_H
 #define PHASAR_PHASARLLVM_DATAFLOW_IFDSIDE_PROBLEMS_TYPESTATEDESCRIPTIONS_OPENSSLSECUREMEMORYDESCRIPTION_H
 
-#include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/TypeStateDescriptions/TypeStateDescription.h"
-
-#include <map>
-#include <set>
-#include <string>
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/TypeStateDescriptions/TypeStateAutomaton.h"
 
 namespace psr {
 
-class OpenSSLSecureMemoryDescription : public TypeStateDescription {
+/**
+ * A type state description for memory that OpenSSL allocates, zeroes and
+ * frees. The finite state machine is encoded by a TypeStateAutomaton with
+ * rows as function tokens and columns as states.
+ */
+class OpenSSLSecureMemoryDescription : public TypeStateAutomaton {
 private:
   enum OpenSSLSecureMemoryState {
     TOP = 42,
@@ -29,37 +30,10 @@ private:
     ALLOCATED = 4
   };
 
-  enum class OpenSSLSecureMemoryToken {
-    CRYPTO_MALLOC = 0,
-    CRYPTO_ZALLOC = 1,
-    CRYPTO_FREE = 2,
-    OPENSSL_CLEANSE = 3,
-    STAR = 4
-  };
-
-  static const std::map<std::string, std::set<int>> OpenSSLSecureMemoryFuncs;
-  // Delta matrix to implement the state machine's Delta function
-  static const OpenSSLSecureMemoryState Delta[6][7];
-  static OpenSSLSecureMemoryToken funcNameToToken(const std::string &F);
+  static TypeStateAutomaton buildAutomaton();
 
 public:
-  [[nodiscard]] bool isFactoryFunction(const std::string &F) const override;
-  [[nodiscard]] bool isConsumingFunction(const std::string &F) const override;
-  [[nodiscard]] bool isAPIFunction(const std::string &F) const override;
-  [[nodiscard]] TypeStateDescription::State
-  getNextState(std::string Tok, TypeStateDescription::State S) const override;
-  [[nodiscard]] std::string getTypeNameOfInterest() const override;
-  [[nodiscard]] std::set<int>
-  getConsumerParamIdx(const std::string &F) const override;
-  [[nodiscard]] std::set<int>
-  getFactoryParamIdx(const std::string &F) const override;
-  [[nodiscard]] std::string
-  stateToString(TypeStateDescription::State S) const override;
-  [[nodiscard]] TypeStateDescription::State bottom() const override;
-  [[nodiscard]] TypeStateDescription::State top() const override;
-  [[nodiscard]] TypeStateDescription::State uninit() const override;
-  [[nodiscard]] TypeStateDescription::State start() const override;
-  [[nodiscard]] TypeStateDescription::State error() const override;
+  OpenSSLSecureMemoryDescription();
 };
 
 } // namespace psr
@@ -0,0 +1,199 @@
+/******************************************************************************
+ * Copyright (c) 2023 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_DATAFLOW_IFDSIDE_PROBLEMS_TYPESTATEDESCRIPTIONS_TYPESTATEAUTOMATON_H
+#define PHASAR_PHASARLLVM_DATAFLOW_IFDSIDE_PROBLEMS_TYPESTATEDESCRIPTIONS_TYPESTATEAUTOMATON_H
+
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/TypeStateDescriptions/TypeStateDescription.h"
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/Twine.h"
+
+#include "nlohmann/json.hpp"
+
+#include <initializer_list>
+#include <optional>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace llvm {
+class raw_ostream;
+} // namespace llvm
+
+namespace psr {
+
+/**
+ * A type state description that is given by data instead of code: The finite
+ * state machine is stored as a dense transition table with one row per token
+ * and one column per state, and each API function is mapped to its token
+ * once, when the automaton is built. The IDETypeStateAnalysis resolves the
+ * token of each callee via getTokenId(), so computing a state transition is a
+ * single table lookup.
+ *
+ * Automata are declared either in C++ using a Builder,
+ *
+ *   TypeStateAutomaton::Builder B("struct._IO_FILE");
+ *   B.addState("UNINIT", 0).addState("OPENED", 1)...;
+ *   B.setUninit(0).setStart(1)...;
+ *   auto Open = B.addToken("OPEN", {{"fopen", {-1}}});
+ *   B.addTransition(Open, 0, 1); // UNINIT -> OPENED
+ *   TypeStateAutomaton Automaton = std::move(B).build();
+ *
+ * or in JSON, see fromJson(). As in CSTDFILEIOTypeStateDescription, a
+ * parameter index of -1 denotes the return value, i.e. marks a factory
+ * function. Transitions that are not declared explicitly lead to the error
+ * state.
+ */
+class TypeStateAutomaton : public TypeStateDescription {
+public:
+  class Builder {
+  public:
+    explicit Builder(std::string TypeNameOfInterest) noexcept;
+
+    /// Adds a state with the given name. The value is the number that
+    /// represents the state in the analysis results.
+    Builder &addState(llvm::StringRef Name, State Value);
+
+    Builder &setTop(State S) noexcept;
+    Builder &setBottom(State S) noexcept;
+    Builder &setUninit(State S) noexcept;
+    Builder &setStart(State S) noexcept;
+    Builder &setError(State S) noexcept;
+
+    /// Adds a token that is triggered by the given API functions, each
+    /// together with its relevant parameter indices
+    TokenId
+    addToken(llvm::StringRef Name,
+             std::initializer_list<std::pair<llvm::StringRef, std::set<int>>>
+                 Functions = {});
+
+    /// Adds F as another API function that triggers the token Tok
+    Builder &addFunction(llvm::StringRef F, TokenId Tok,
+                         std::set<int> ParamIdx);
+
+    Builder &addTransition(TokenId Tok, State From, State To);
+
+    /// Adds one transition for each pair of source and target state
+    Builder &addTransitions(TokenId Tok,
+                            std::initializer_list<std::pair<State, State>>
+                                FromTo);
+
+    /// Lays out the transition table. Reports a fatal error if the automaton
+    /// is inconsistent, e.g. if a transition refers to an unknown state.
+    [[nodiscard]] TypeStateAutomaton build() &&;
+
+  private:
+    friend class TypeStateAutomaton;
+
+    [[nodiscard]] std::optional<TypeStateAutomaton>
+    buildOrNull(llvm::raw_ostream &Err) &&;
+
+    std::string TypeNameOfInterest;
+    std::vector<std::pair<std::string, State>> States;
+    std::vector<std::string> Tokens;
+    std::vector<std::pair<std::string, std::pair<TokenId, std::set<int>>>>
+        Functions;
+    std::vector<std::pair<TokenId, std::pair<State, State>>> Transitions;
+    std::optional<State> Top;
+    std::optional<State> Bottom;
+    std::optional<State> Uninit;
+    std::optional<State> Start;
+    std::optional<State> Error;
+  };
+
+  /**
+   * Reads an automaton of the form
+   *
+   *   {
+   *     "type": "struct._IO_FILE",
+   *     "states": {"TOP": 42, "UNINIT": 0, "OPENED": 1, ...},
+   *     "top": "TOP", "bottom": "BOT", "uninit": "UNINIT",
+   *     "start": "OPENED", "error": "ERROR",
+   *     "tokens": {
+   *       "FOPEN": {"fopen": [-1], "fdopen": [-1]},
+   *       ...
+   *     },
+   *     "transitions": {
+   *       "FOPEN": {"UNINIT": "OPENED", ...},
+   *       ...
+   *     }
+   *   }
+   *
+   * Returns std::nullopt and logs the reason if the JSON is malformed.
+   */
+  [[nodiscard]] static std::optional<TypeStateAutomaton>
+  fromJson(const nlohmann::json &J);
+
+  /// Reads an automaton from the JSON file at Path, see fromJson()
+  [[nodiscard]] static std::optional<TypeStateAutomaton>
+  loadFromFile(const llvm::Twine &Path);
+
+  [[nodiscard]] bool isFactoryFunction(const std::string &F) const override;
+  [[nodiscard]] bool isConsumingFunction(const std::string &F) const override;
+  [[nodiscard]] bool isAPIFunction(const std::string &F) const override;
+  [[nodiscard]] State getNextState(std::string Tok, State S) const override;
+  [[nodiscard]] std::optional<TokenId>
+  getTokenId(llvm::StringRef F) const override;
+  [[nodiscard]] State
+  getNextStateById(TokenId Tok, State S,
+                   const llvm::CallBase *CallSite) const override;
+  [[nodiscard]] std::string getTypeNameOfInterest() const override;
+  [[nodiscard]] std::set<int>
+  getConsumerParamIdx(const std::string &F) const override;
+  [[nodiscard]] std::set<int>
+  getFactoryParamIdx(const std::string &F) const override;
+  [[nodiscard]] std::string stateToString(State S) const override;
+  [[nodiscard]] State bottom() const override;
+  [[nodiscard]] State top() const override;
+  [[nodiscard]] State uninit() const override;
+  [[nodiscard]] State start() const override;
+  [[nodiscard]] State error() const override;
+
+  [[nodiscard]] size_t getNumStates() const noexcept {
+    return StateValues.size();
+  }
+  [[nodiscard]] size_t getNumTokens() const noexcept {
+    return TokenNames.size();
+  }
+  [[nodiscard]] llvm::StringRef tokenToString(TokenId Tok) const {
+    return TokenNames[Tok];
+  }
+
+private:
+  struct APIFunction {
+    TokenId Token{};
+    std::set<int> ParamIdx;
+  };
+
+  TypeStateAutomaton() = default;
+
+  [[nodiscard]] const APIFunction *getAPIFunction(llvm::StringRef F) const;
+
+  std::string TypeNameOfInterest;
+  std::vector<State> StateValues;
+  std::vector<std::string> StateNames;
+  llvm::DenseMap<State, uint32_t> StateColumns;
+  std::vector<std::string> TokenNames;
+  llvm::StringMap<APIFunction> APIFunctions;
+  // Delta[Tok * getNumStates() + Column of S] = next state
+  std::vector<State> Delta;
+  State Top{};
+  State Bottom{};
+  State Uninit{};
+  State Start{};
+  State Error{};
+};
+
+} // namespace psr
+
+#endif
@@ -10,8 +10,12 @@
 #ifndef PHASAR_PHASARLLVM_DATAFLOW_IFDSIDE_PROBLEMS_TYPESTATEDESCRIPTIONS_TYPESTATEDESCRIPTION_H
 #define PHASAR_PHASARLLVM_DATAFLOW_IFDSIDE_PROBLEMS_TYPESTATEDESCRIPTIONS_TYPESTATEDESCRIPTION_H
 
+#include "llvm/ADT/StringRef.h"
 #include "llvm/IR/InstrTypes.h"
+#include "llvm/Support/ErrorHandling.h"
 
+#include <cstdint>
+#include <optional>
 #include <set>
 #include <string>
 
@@ -34,6 +38,8 @@ namespace psr {
 struct TypeStateDescription {
   /// Type for states of the finite state machine
   using State = int;
+  /// Dense identifier of a function token of the finite state machine
+  using TokenId = uint32_t;
   virtual ~TypeStateDescription() = default;
   [[nodiscard]] virtual bool isFactoryFunction(const std::string &F) const = 0;
   [[nodiscard]] virtual bool
@@ -50,6 +56,32 @@ struct TypeStateDescription {
                const llvm::CallBase * /*CallSite*/) const {
     return getNextState(Tok, S);
   }
+
+  /**
+   * @brief Maps the API function F to a token of the finite state machine.
+   *
+   * The IDETypeStateAnalysis resolves each callee only once. If this returns a
+   * token, the analysis computes the state transitions of the callee with
+   * getNextStateById() instead of passing the function name to getNextState()
+   * over and over again. The default implementation does not assign tokens.
+   *
+   * @see TypeStateAutomaton for a description that provides tokens.
+   */
+  [[nodiscard]] virtual std::optional<TokenId>
+  getTokenId(llvm::StringRef /*F*/) const {
+    return std::nullopt;
+  }
+
+  /**
+   * @brief For a given token, as returned by getTokenId(), and a state, this
+   * function returns the next state.
+   */
+  [[nodiscard]] virtual State
+  getNextStateById(TokenId /*Tok*/, State /*S*/,
+                   const llvm::CallBase * /*CallSite*/) const {
+    llvm_unreachable("getNextStateById() requires an implementation of "
+                     "getTokenId()");
+  }
   [[nodiscard]] virtual std::string getTypeNameOfInterest() const = 0;
   [[nodiscard]] virtual std::set<int>
   getConsumerParamIdx(const std::string &F) const = 0;
@@ -0,0 +1,98 @@
+/******************************************************************************
+ * Copyright (c) 2023 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_DATAFLOW_IFDSIDE_TAINTLEAKREPORTING_H
+#define PHASAR_PHASARLLVM_DATAFLOW_IFDSIDE_TAINTLEAKREPORTING_H
+
+#include "llvm/ADT/DenseSet.h"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+
+namespace llvm {
+class Instruction;
+class Value;
+} // namespace llvm
+
+namespace psr {
+class LLVMBasedICFG;
+class LLVMTaintConfig;
+
+/// Receives the leaks of a taint analysis while the solver is still running.
+/// It is invoked once for each new pair of a sink instruction and a leaking
+/// value, right when the analysis records the leak.
+using LeakCallbackTy = std::function<void(const llvm::Instruction *Sink,
+                                          const llvm::Value *Leak)>;
+
+/// A termination hook for the taint analyses: Counts the leaks that are
+/// reported through its callback and raises a cancellation flag as soon as
+/// enough leaks have been found. Pass the flag to the solver's
+/// solveWithAsyncCancellation(), which then stops right after the flow
+/// function that reported the deciding leak:
+///
+///   TaintLeakStopCondition Stop(/*MaxLeaks*/ 1);
+///   TaintProblem.setLeakCallback(Stop.makeCallback());
+///   IFDSSolver Solver(TaintProblem, &ICF);
+///   bool Completed =
+///       Solver.solveWithAsyncCancellation(Stop.getCancellationFlag())
+///           .has_value();
+///
+/// The leaks found so far remain accessible through the analysis. Like the
+/// analyses' leak maps, the counting is not synchronized, so use it with the
+/// sequential solver only.
+///
+/// IDEExtendedTaintAnalysis only streams its leaks while solving if strong
+/// updates are disabled, since a sanitizer may still remove them otherwise.
+/// With strong updates, the condition is only decided after the solver has
+/// finished.
+class TaintLeakStopCondition {
+public:
+  /// Stops once MaxLeaks distinct (sink, leak) pairs have been reported
+  explicit TaintLeakStopCondition(size_t MaxLeaks) noexcept;
+
+  /// Stops once each of the given sink instructions has leaked at least one
+  /// value. Use collectSinkCallSites() to wait for all configured sinks.
+  explicit TaintLeakStopCondition(
+      llvm::DenseSet<const llvm::Instruction *> Sinks) noexcept;
+
+  /// Creates a leak callback that updates this stop condition and forwards
+  /// each leak to Next, if given. The callback refers to this object, so it
+  /// must not outlive it.
+  [[nodiscard]] LeakCallbackTy makeCallback(LeakCallbackTy Next = nullptr);
+
+  void onLeak(const llvm::Instruction *Sink, const llvm::Value *Leak);
+
+  [[nodiscard]] std::atomic_bool &getCancellationFlag() noexcept {
+    return StopRequested;
+  }
+
+  [[nodiscard]] bool isStopRequested() const noexcept {
+    return StopRequested.load();
+  }
+
+  /// The number of leaks reported so far
+  [[nodiscard]] size_t getNumLeaks() const noexcept { return NumLeaks; }
+
+private:
+  size_t MaxLeaks = 0;
+  size_t NumLeaks = 0;
+  llvm::DenseSet<const llvm::Instruction *> PendingSinks;
+  bool WaitForSinks = false;
+  std::atomic_bool StopRequested = false;
+};
+
+/// Collects all call sites in the program at which Config may leak values,
+/// considering every possible callee according to ICF.
+[[nodiscard]] llvm::DenseSet<const llvm::Instruction *>
+collectSinkCallSites(const LLVMBasedICFG &ICF, const LLVMTaintConfig &Config);
+
+} // namespace psr
+
+#endif // PHASAR_PHASARLLVM_DATAFLOW_IFDSIDE_TAINTLEAKREPORTING_H
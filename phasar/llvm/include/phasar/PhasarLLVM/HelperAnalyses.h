@@ -16,6 +16,7 @@
 #include "nlohmann/json.hpp"
 
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <vector>
@@ -27,6 +28,9 @@ class LLVMBasedICFG;
 class LLVMBasedCFG;
 class LLVMAliasSet;
 
+/// Constructs the helper analyses lazily on first request. Each helper
+/// analysis is constructed exactly once, even if it is requested from multiple
+/// threads at the same time.
 class HelperAnalyses { // NOLINT(cppcoreguidelines-special-member-functions)
 public:
   explicit HelperAnalyses(std::string IRFile,
@@ -35,7 +39,8 @@ public:
                           std::vector<std::string> EntryPoints,
                           std::optional<nlohmann::json> PrecomputedCG,
                           CallGraphAnalysisType CGTy, Soundness SoundnessLevel,
-                          bool AutoGlobalSupport) noexcept;
+                          bool AutoGlobalSupport,
+                          unsigned NumPTAThreads = 1) noexcept;
 
   explicit HelperAnalyses(std::string IRFile,
                           std::vector<std::string> EntryPoints,
@@ -54,6 +59,11 @@ public:
   [[nodiscard]] LLVMBasedICFG &getICFG();
   [[nodiscard]] LLVMBasedCFG &getCFG();
 
+  /// Constructs all helper analyses and completes the lazily computed alias
+  /// sets, such that all helper analyses can afterwards be queried by multiple
+  /// data-flow analyses concurrently.
+  void prepareForConcurrentAccess();
+
 private:
   std::unique_ptr<LLVMProjectIRDB> IRDB;
   std::unique_ptr<LLVMAliasSet> PT;
@@ -61,20 +71,33 @@ private:
   std::unique_ptr<LLVMBasedICFG> ICF;
   std::unique_ptr<LLVMBasedCFG> CFG;
 
+  std::once_flag IRDBOnce;
+  std::once_flag PTOnce;
+  std::once_flag THOnce;
+  std::once_flag ICFOnce;
+  std::once_flag CFGOnce;
+
   // IRDB
   std::string IRFile;
 
   // PTS
   std::optional<nlohmann::json> PrecomputedPTS;
+  std::string PrecomputedPTSBinaryFile;
   AliasAnalysisType PTATy{};
   bool AllowLazyPTS{};
+  unsigned NumPTAThreads = 1;
+
+  // TH
+  std::string PrecomputedTHBinaryFile;
 
   // ICF
   std::optional<nlohmann::json> PrecomputedCG;
+  std::string PrecomputedCGBinaryFile;
   std::vector<std::string> EntryPoints;
   CallGraphAnalysisType CGTy{};
   Soundness SoundnessLevel{};
   bool AutoGlobalSupport{};
+  unsigned NumCGThreads = 1;
 };
 } // namespace psr
 
@@ -17,16 +17,31 @@
 #include "nlohmann/json.hpp"
 
 #include <optional>
+#include <string>
 
 namespace psr {
 struct HelperAnalysisConfig {
   std::optional<nlohmann::json> PrecomputedPTS = std::nullopt;
   std::optional<nlohmann::json> PrecomputedCG = std::nullopt;
+  /// Files written by the writeBinary() functions of the respective helper
+  /// analyses. If set, they take precedence over the JSON results. A file that
+  /// cannot be loaded, e.g. because it belongs to a different module, is
+  /// ignored and the helper analysis is recomputed.
+  std::string PrecomputedPTSBinaryFile{};
+  std::string PrecomputedCGBinaryFile{};
+  std::string PrecomputedTHBinaryFile{};
   AliasAnalysisType PTATy = AliasAnalysisType::CFLAnders;
   CallGraphAnalysisType CGTy = CallGraphAnalysisType::OTF;
   Soundness SoundnessLevel = Soundness::Soundy;
   bool AutoGlobalSupport = true;
   bool AllowLazyPTS = true;
+  /// The number of threads used to compute the alias sets, if they are not
+  /// computed lazily
+  unsigned NumPTAThreads = 1;
+  /// The number of threads used to construct the call-graph. For OTF, the
+  /// alias sets are computed upfront, such that they can be queried
+  /// concurrently
+  unsigned NumCGThreads = 1;
 
   HelperAnalysisConfig &&withCGType(CallGraphAnalysisType CGTy) &&noexcept {
     this->CGTy = CGTy;
@@ -15,15 +15,20 @@
 #include "phasar/Pointer/AliasInfoTraits.h"
 #include "phasar/Pointer/AliasResult.h"
 #include "phasar/Pointer/AliasSetOwner.h"
+#include "phasar/Pointer/UnionFindAliasSets.h"
 #include "phasar/Utils/AnalysisProperties.h"
 #include "phasar/Utils/StableVector.h"
 
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/MemoryBufferRef.h"
 
 #include "nlohmann/json.hpp"
 
+#include <memory>
 #include <utility>
+#include <vector>
 
 namespace llvm {
 class Value;
@@ -56,14 +61,23 @@ public:
   /**
    * Creates points-to set(s) for all functions in the IRDB. If
    * UseLazyEvaluation is true, computes points-to-sets for functions that do
-   * not use global variables on the fly
+   * not use global variables on the fly. Otherwise, computes the points-to
+   * sets of all functions upfront using NumThreads threads (see
+   * computeAllAliasSets()).
    */
   explicit LLVMAliasSet(LLVMProjectIRDB *IRDB, bool UseLazyEvaluation = true,
-                        AliasAnalysisType PATy = AliasAnalysisType::CFLAnders);
+                        AliasAnalysisType PATy = AliasAnalysisType::CFLAnders,
+                        unsigned NumThreads = 1);
 
   explicit LLVMAliasSet(LLVMProjectIRDB *IRDB,
                         const nlohmann::json &SerializedPTS);
 
+  /// Loads the points-to info that has been written by writeBinary() on the
+  /// same module. Returns nullptr, if Buf does not contain valid points-to
+  /// info for the module of IRDB.
+  [[nodiscard]] static std::unique_ptr<LLVMAliasSet>
+  loadBinary(LLVMProjectIRDB *IRDB, llvm::MemoryBufferRef Buf);
+
   [[nodiscard]] inline bool isInterProcedural() const noexcept {
     return false;
   };
@@ -87,6 +101,28 @@ public:
       const llvm::Value *V, const llvm::Value *PotentialValue,
       bool IntraProcOnly = false, const llvm::Instruction *I = nullptr);
 
+  /// Computes the alias sets of all functions that have not been analyzed,
+  /// yet.
+  ///
+  /// With NumThreads > 1, the alias queries of the functions run in parallel.
+  /// Running the LLVM alias analyses on a function and discarding their
+  /// results registers value handles in the shared LLVMContext, so this part
+  /// is serialized. The function-local alias classes are merged into the
+  /// alias sets afterwards, which yields the same alias sets as the sequential
+  /// computation.
+  ///
+  /// Afterwards, the alias queries (alias(), getAliasSet(),
+  /// getReachableAllocationSites() and isInReachableAllocationSites()) do not
+  /// modify this LLVMAliasSet anymore and may be issued concurrently.
+  ///
+  /// Merging further alias information using mergeWith() or introduceAlias()
+  /// still requires exclusive access.
+  void computeAllAliasSets(unsigned NumThreads = 1);
+
+  /// True, iff computeAllAliasSets() has been called (or the LLVMAliasSet has
+  /// been constructed eagerly), such that the alias queries are read-only.
+  [[nodiscard]] bool isComplete() const noexcept { return Complete; }
+
   void mergeWith(const LLVMAliasSet &OtherPTI);
 
   void introduceAlias(const llvm::Value *V1, const llvm::Value *V2,
@@ -99,6 +135,11 @@ public:
 
   void printAsJson(llvm::raw_ostream &OS = llvm::outs()) const;
 
+  /// Writes the points-to info in a compact binary format that refers to the
+  /// values by their ids in the IRDB instead of by their metadata-ids. Use
+  /// loadBinary() for deserialization.
+  void writeBinary(llvm::raw_ostream &OS) const;
+
   [[nodiscard]] AnalysisProperties getAnalysisProperties() const noexcept {
     return AnalysisProperties::None;
   }
@@ -124,16 +165,46 @@ public:
   [[nodiscard]] inline bool empty() const { return AnalyzedFunctions.empty(); }
 
 private:
+  struct EmptyTag {};
+  /// Creates an LLVMAliasSet without any alias sets
+  LLVMAliasSet(LLVMProjectIRDB *IRDB, EmptyTag /*unused*/);
+
   void computeValuesAliasSet(const llvm::Value *V);
 
   void computeFunctionsAliasSet(llvm::Function *F);
 
+  /// The pointers of a function, partitioned into the classes that may alias
+  /// according to the function-local LLVM alias analysis results
+  using FunctionAliasClasses =
+      std::vector<llvm::SmallVector<const llvm::Value *, 2>>;
+
+  /// Does not access any state of the LLVMAliasSet, so it may be called for
+  /// different functions concurrently
+  [[nodiscard]] static FunctionAliasClasses
+  computeFunctionAliasClasses(llvm::Function &F, llvm::AAResults &AA);
+
+  void addFunctionAliasClasses(const FunctionAliasClasses &Classes);
+
+  /// Computes V's alias set unless the alias sets are already complete
+  void ensureAliasSet(const llvm::Value *V) {
+    if (!Complete) {
+      computeValuesAliasSet(V);
+    }
+  }
+
+  /// V's alias set, or the empty set if V has none. Does not insert into
+  /// AliasSets; materializes V's alias set if necessary.
+  [[nodiscard]] BoxedPtr<AliasSetTy> lookupAliasSet(const llvm::Value *V);
+
+  /// Whether V1 and V2 are in the same alias class. Does not materialize the
+  /// alias sets.
+  [[nodiscard]] bool inSameAliasSet(const llvm::Value *V1,
+                                    const llvm::Value *V2);
+
   void addSingletonAliasSet(const llvm::Value *V);
 
   void mergeAliasSets(const llvm::Value *V1, const llvm::Value *V2);
 
-  void mergeAliasSets(BoxedPtr<AliasSetTy> PTS1, BoxedPtr<AliasSetTy> PTS2);
-
   bool interIsReachableAllocationSiteTy(const llvm::Value *V,
                                         const llvm::Value *P) const;
 
@@ -142,19 +213,19 @@ private:
                                         const llvm::Function *VFun,
                                         const llvm::GlobalObject *VG) const;
 
-  /// Utility function used by computeFunctionsAliasSet(...)
-  void addPointer(llvm::AAResults &AA, const llvm::DataLayout &DL,
-                  const llvm::Value *V, std::vector<const llvm::Value *> &Reps);
-
   [[nodiscard]] static BoxedPtr<AliasSetTy> getEmptyAliasSet();
 
+  LLVMProjectIRDB *IRDB{};
   LLVMBasedAliasAnalysis PTA;
   llvm::DenseSet<const llvm::Function *> AnalyzedFunctions;
 
   AliasSetOwner<AliasSetTy>::memory_resource_type MRes;
   AliasSetOwner<AliasSetTy> Owner{&MRes};
 
-  AliasSetMap AliasSets;
+  /// The alias sets are only materialized on request, such that merging them
+  /// does not need to copy
+  UnionFindAliasSets<AliasSetTy> AliasSets{Owner};
+  bool Complete = false;
 };
 
 static_assert(IsAliasInfo<LLVMAliasSet>);
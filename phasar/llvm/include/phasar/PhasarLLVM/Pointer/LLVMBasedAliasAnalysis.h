@@ -48,6 +48,19 @@ public:
     return AAInfos.lookup(F);
   };
 
+  /// Like getAAResults(), but additionally computes all state that the
+  /// returned AAResults would otherwise create lazily when answering the
+  /// first queries, such as the summaries of the CFL analyses and the
+  /// assumption cache of BasicAA. Creating this state registers value
+  /// handles in the LLVMContext; afterwards, the alias queries on F only read
+  /// the IR and their own results.
+  ///
+  /// Neither this function nor erase() are thread-safe, but the returned
+  /// AAResults may be queried concurrently to calls of them for other
+  /// functions.
+  [[nodiscard]] llvm::AAResults *
+  getAAResultsForConcurrentQueries(llvm::Function *F);
+
   void erase(llvm::Function *F) noexcept;
 
   void clear() noexcept;
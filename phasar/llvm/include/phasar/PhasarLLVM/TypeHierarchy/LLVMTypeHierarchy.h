@@ -20,17 +20,23 @@
 #include "phasar/PhasarLLVM/TypeHierarchy/LLVMVFTable.h"
 #include "phasar/TypeHierarchy/TypeHierarchy.h"
 
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/MemoryBufferRef.h"
 
-#include "boost/graph/adjacency_list.hpp"
-#include "boost/graph/graph_traits.hpp"
 #include "nlohmann/json.hpp"
 
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <optional>
 #include <set>
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #ifndef FRIEND_TEST
@@ -53,40 +59,18 @@ class LLVMProjectIRDB;
  * 	This class is responsible for constructing a inter-modular class
  * 	hierarchy graph based on the data from the %ProjectIRCompiledDB
  * 	and reconstructing the virtual method tables.
+ *
+ * 	Once constructed, the hierarchy is immutable: Each type has a dense
+ * 	type-id, the direct subtypes are stored as compressed sparse rows and the
+ * 	reflexive-transitive closure of the subtype relation as one bitset per
+ * 	type, such that isSubType() is a constant-time lookup. The types that take
+ * 	part in any subtype relation get the lowest ids, so the closure only covers
+ * 	those; all other types are only subtypes of themselves.
  */
 class LLVMTypeHierarchy
     : public TypeHierarchy<const llvm::StructType *, const llvm::Function *> {
 public:
-  struct VertexProperties {
-    VertexProperties() = default;
-    VertexProperties(const llvm::StructType *Type);
-
-    [[nodiscard]] std::string getTypeName() const;
-
-    const llvm::StructType *Type = nullptr;
-    std::optional<LLVMVFTable> VFT = std::nullopt;
-    std::set<const llvm::StructType *> ReachableTypes;
-  };
-
-  /// Edges in the class hierarchy graph doesn't hold any additional
-  /// information.
-  struct EdgeProperties {
-    EdgeProperties() = default;
-  };
-
-  /// Data structure holding the class hierarchy graph.
-  using bidigraph_t =
-      boost::adjacency_list<boost::setS, boost::vecS, boost::bidirectionalS,
-                            VertexProperties, EdgeProperties>;
-
-  /// The type for vertex representative objects.
-  using vertex_t = boost::graph_traits<bidigraph_t>::vertex_descriptor;
-  /// The type for edge representative objects.
-  using edge_t = boost::graph_traits<bidigraph_t>::edge_descriptor;
-  // Let us have some further handy typedefs.
-  using vertex_iterator = boost::graph_traits<bidigraph_t>::vertex_iterator;
-  using out_edge_iterator = boost::graph_traits<bidigraph_t>::out_edge_iterator;
-  using in_edge_iterator = boost::graph_traits<bidigraph_t>::in_edge_iterator;
+  using type_id_t = uint32_t;
 
   static inline constexpr llvm::StringLiteral StructPrefix = "struct.";
   static inline constexpr llvm::StringLiteral ClassPrefix = "class.";
@@ -100,18 +84,26 @@ public:
       "__cxa_pure_virtual";
 
 private:
-  bidigraph_t TypeGraph;
-  std::unordered_map<const llvm::StructType *, vertex_t> TypeVertexMap;
-  // maps type names to the corresponding vtable
-  std::unordered_map<const llvm::StructType *, LLVMVFTable> TypeVFTMap;
+  struct ClearNameMaps;
+
+  /// All types, indexed by their type-id
+  std::vector<const llvm::StructType *> Types;
+  llvm::DenseMap<const llvm::StructType *, type_id_t> TypeIds;
+  /// The virtual function tables, indexed by type-id
+  std::vector<LLVMVFTable> VFTs;
+  /// The direct subtypes of the type with id T are
+  /// DirectSubTypes[SubTypeOffsets[T]..SubTypeOffsets[T+1]]
+  std::vector<type_id_t> SubTypeOffsets;
+  std::vector<type_id_t> DirectSubTypes;
+  /// The number of types that take part in any subtype relation; these are
+  /// the types with the ids [0, NumHierarchyTypes)
+  size_t NumHierarchyTypes = 0;
+  /// The reflexive-transitive closure of the subtype relation; one row of
+  /// WordsPerRow words for each of the first NumHierarchyTypes types
+  std::vector<uint64_t> Closure;
+  size_t WordsPerRow = 0;
   // holds all modules that are included in the type hierarchy
-  std::unordered_set<const llvm::Module *> VisitedModules;
-  // helper map from clearname to type*
-  std::unordered_map<std::string, const llvm::StructType *> ClearNameTypeMap;
-  // map from clearname to type info variable
-  std::unordered_map<std::string, const llvm::GlobalVariable *> ClearNameTIMap;
-  // map from clearname to vtable variable
-  std::unordered_map<std::string, const llvm::GlobalVariable *> ClearNameTVMap;
+  llvm::SmallVector<const llvm::Module *, 1> VisitedModules;
 
   static std::string removeStructOrClassPrefix(const llvm::StructType &T);
 
@@ -129,11 +121,39 @@ private:
 
   static bool isStruct(llvm::StringRef TypeName);
 
-  std::vector<const llvm::StructType *>
-  getSubTypes(const llvm::Module &M, const llvm::StructType &Type);
+  static std::vector<const llvm::StructType *>
+  getSubTypes(const ClearNameMaps &Names, const llvm::StructType &Type);
+
+  static std::vector<const llvm::Function *>
+  getVirtualFunctions(const ClearNameMaps &Names,
+                      const llvm::StructType &Type);
+
+  /// Assigns the type-ids and computes the compressed representation from
+  /// AllTypes, their virtual function tables and the (type, direct subtype)
+  /// pairs in Edges that refer to the indices of AllTypes
+  void freeze(llvm::ArrayRef<const llvm::StructType *> AllTypes,
+              std::vector<LLVMVFTable> AllVFTs,
+              llvm::ArrayRef<std::pair<type_id_t, type_id_t>> Edges);
+
+  void computeClosure();
+
+  [[nodiscard]] std::optional<type_id_t>
+  getTypeId(const llvm::StructType *Type) const {
+    if (auto It = TypeIds.find(Type); It != TypeIds.end()) {
+      return It->second;
+    }
+    return std::nullopt;
+  }
+
+  [[nodiscard]] llvm::ArrayRef<type_id_t>
+  getDirectSubTypeIds(type_id_t Id) const noexcept {
+    return llvm::ArrayRef<type_id_t>(DirectSubTypes)
+        .slice(SubTypeOffsets[Id], SubTypeOffsets[Id + 1] - SubTypeOffsets[Id]);
+  }
 
-  std::vector<const llvm::Function *>
-  getVirtualFunctions(const llvm::Module &M, const llvm::StructType &Type);
+  [[nodiscard]] const uint64_t *getClosureRow(type_id_t Id) const noexcept {
+    return &Closure[Id * WordsPerRow];
+  }
 
   FRIEND_TEST(LTHTest, GraphConstruction);
   FRIEND_TEST(LTHTest, HandleLoadAndPrintOfNonEmptyGraph);
@@ -141,6 +161,9 @@ private:
 protected:
   void buildLLVMTypeHierarchy(const llvm::Module &M);
 
+  /// Creates an empty type hierarchy; used by loadBinary()
+  LLVMTypeHierarchy() = default;
+
 public:
   /**
    *  @brief Creates a LLVMStructTypeHierarchy based on the
@@ -156,32 +179,70 @@ public:
    */
   LLVMTypeHierarchy(const llvm::Module &M);
 
+  /// Loads the type hierarchy that has been written by writeBinary() on the
+  /// same module. Returns nullptr, if Buf does not contain a valid type
+  /// hierarchy for the module of IRDB.
+  [[nodiscard]] static std::unique_ptr<LLVMTypeHierarchy>
+  loadBinary(const LLVMProjectIRDB &IRDB, llvm::MemoryBufferRef Buf);
+
   ~LLVMTypeHierarchy() override = default;
 
   /**
    * @brief Constructs the actual class hierarchy graph.
    * @param M LLVM module
    *
-   * Extracts new information from the given module and adds new vertices
-   * and edges accordingly to the type hierarchy graph.
+   * Extracts new information from the given module and rebuilds the type
+   * hierarchy of all modules analyzed so far.
    */
   void constructHierarchy(const llvm::Module &M);
 
   [[nodiscard]] inline bool
   hasType(const llvm::StructType *Type) const override {
-    return TypeVertexMap.count(Type);
+    return TypeIds.count(Type);
   }
 
+  /// Constant time
   [[nodiscard]] inline bool
   isSubType(const llvm::StructType *Type,
             const llvm::StructType *SubType) override {
-    auto ReachableTypes = getSubTypes(Type);
-    return ReachableTypes.count(SubType);
+    auto Id = getTypeId(Type);
+    auto SubId = getTypeId(SubType);
+    if (!Id || !SubId) {
+      return false;
+    }
+    if (*Id == *SubId) {
+      return true;
+    }
+    if (*Id >= NumHierarchyTypes || *SubId >= NumHierarchyTypes) {
+      return false;
+    }
+    return (getClosureRow(*Id)[*SubId / 64] >> (*SubId % 64)) & 1;
   }
 
+  /// Prefer forEachSubType(), which does not need to build a std::set
   std::set<const llvm::StructType *>
   getSubTypes(const llvm::StructType *Type) override;
 
+  /// Calls Handler with Type and all its transitive subtypes, ordered by
+  /// their type-ids
+  template <typename HandlerFn>
+  void forEachSubType(const llvm::StructType *Type, HandlerFn Handler) const {
+    auto Id = getTypeId(Type);
+    if (!Id) {
+      return;
+    }
+    if (*Id >= NumHierarchyTypes) {
+      std::invoke(Handler, Type);
+      return;
+    }
+    const auto *Row = getClosureRow(*Id);
+    for (size_t Word = 0; Word != WordsPerRow; ++Word) {
+      for (auto Bits = Row[Word]; Bits; Bits &= Bits - 1) {
+        std::invoke(Handler, Types[Word * 64 + llvm::countTrailingZeros(Bits)]);
+      }
+    }
+  }
+
   [[nodiscard]] inline bool
   isSuperType(const llvm::StructType *Type,
               const llvm::StructType *SuperType) override {
@@ -204,9 +265,7 @@ public:
   [[nodiscard]] const LLVMVFTable *
   getVFTable(const llvm::StructType *Type) const override;
 
-  [[nodiscard]] inline size_t size() const override {
-    return boost::num_vertices(TypeGraph);
-  };
+  [[nodiscard]] inline size_t size() const override { return Types.size(); };
 
   [[nodiscard]] inline bool empty() const override { return size() == 0; };
 
@@ -233,6 +292,14 @@ public:
    */
   void printAsJson(llvm::raw_ostream &OS = llvm::outs()) const;
 
+  /// Writes the type hierarchy including the virtual function tables in a
+  /// compact binary format, such that it does not need to be reconstructed
+  /// from the module. Use loadBinary() for deserialization.
+  ///
+  /// \param IRDB The IRDB whose module the type hierarchy has been
+  /// constructed on
+  void writeBinary(const LLVMProjectIRDB &IRDB, llvm::raw_ostream &OS) const;
+
   // void printGraphAsDot(llvm::raw_ostream &out);
 
   // static bidigraph_t loadGraphFormDot(std::istream &in);
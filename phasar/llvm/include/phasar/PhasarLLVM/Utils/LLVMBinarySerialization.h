@@ -0,0 +1,170 @@
+/******************************************************************************
+ * Copyright (c) 2023 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_UTILS_LLVMBINARYSERIALIZATION_H
+#define PHASAR_PHASARLLVM_UTILS_LLVMBINARYSERIALIZATION_H
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/MemoryBufferRef.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace llvm {
+class Value;
+class Function;
+class raw_ostream;
+} // namespace llvm
+
+namespace psr {
+class LLVMProjectIRDB;
+
+/// The helper analyses that can be persisted in the binary format of
+/// BinaryHelperAnalysisWriter
+enum class BinaryHelperAnalysisKind : uint32_t {
+  AliasSet = 1,
+  CallGraph = 2,
+  TypeHierarchy = 3,
+};
+
+/// Assigns dense 32-bit ids to all values of an LLVMProjectIRDB that the
+/// helper analyses refer to:
+///   - the ids of the LLVMProjectIRDB (global variables and instructions),
+///   - followed by one id per function,
+///   - followed by one id per formal argument,
+/// all in module order. Building the mapping is linear in the number of
+/// functions and global variables; it does not touch the instructions.
+///
+/// The mapping also computes a fingerprint of the module, such that persisted
+/// data is only loaded into the module that it has been computed on.
+class LLVMValueIds {
+public:
+  static constexpr uint32_t InvalidId = UINT32_MAX;
+
+  explicit LLVMValueIds(const LLVMProjectIRDB &IRDB);
+
+  /// The id of V, or InvalidId if V has no id
+  [[nodiscard]] uint32_t getId(const llvm::Value *V) const;
+  /// The value with the given id, or nullptr if Id is out of range
+  [[nodiscard]] const llvm::Value *getValue(uint32_t Id) const noexcept;
+
+  /// The index of F within its module, or InvalidId if F is not part of the
+  /// module
+  [[nodiscard]] uint32_t getFunctionId(const llvm::Function *F) const;
+  /// The function with the given index, or nullptr if FunId is out of range
+  [[nodiscard]] const llvm::Function *
+  getFunction(uint32_t FunId) const noexcept {
+    return FunId < Functions.size() ? Functions[FunId] : nullptr;
+  }
+
+  [[nodiscard]] size_t size() const noexcept {
+    return ArgBase + ArgBegin.back();
+  }
+
+  [[nodiscard]] uint64_t getModuleFingerprint() const noexcept {
+    return Fingerprint;
+  }
+
+private:
+  const LLVMProjectIRDB *IRDB{};
+  std::vector<const llvm::Function *> Functions;
+  llvm::DenseMap<const llvm::Function *, uint32_t> FunIds;
+  /// The index of the first argument of each function; the last element is
+  /// the total number of arguments
+  std::vector<uint32_t> ArgBegin;
+  uint32_t FunBase = 0;
+  uint32_t ArgBase = 0;
+  uint64_t Fingerprint = 0;
+};
+
+/// Builds the binary representation of a helper analysis.
+///
+/// Layout (all integers are little-endian):
+///   Header  { char Magic[8]; u32 Version; u32 Kind; u64 ModuleFingerprint;
+///             u64 PayloadSize; }
+///   Payload a sequence of u32 words; arrays are prefixed by their length and
+///           strings by their size in bytes and padded to a multiple of 4
+/// Except for the header, the layout of the payload is determined by the
+/// serialized helper analysis.
+///
+/// Since there is no alignment requirement, the loader can directly operate
+/// on a memory-mapped file.
+class BinaryHelperAnalysisWriter {
+public:
+  static constexpr uint32_t Version = 2;
+
+  BinaryHelperAnalysisWriter(BinaryHelperAnalysisKind Kind,
+                             const LLVMValueIds &Ids) noexcept
+      : Kind(Kind), Fingerprint(Ids.getModuleFingerprint()) {}
+
+  void writeU32(uint32_t Value);
+  void writeU32Array(llvm::ArrayRef<uint32_t> Values);
+  void writeString(llvm::StringRef Str);
+
+  /// Writes the header followed by the payload to OS
+  void emit(llvm::raw_ostream &OS) const;
+
+private:
+  BinaryHelperAnalysisKind Kind{};
+  uint64_t Fingerprint{};
+  std::string Payload;
+};
+
+/// Reads the binary representation of a helper analysis that has been written
+/// by a BinaryHelperAnalysisWriter.
+///
+/// All reads are bounds-checked and never copy the underlying buffer. The first
+/// failing read invalidates the reader and all subsequent reads return empty
+/// values, so a loader only needs to check isValid() once before it commits
+/// the loaded data.
+class BinaryHelperAnalysisReader {
+public:
+  using u32_array_t = llvm::ArrayRef<llvm::support::ulittle32_t>;
+
+  /// Validates the header of Buf against Kind and the module of Ids
+  BinaryHelperAnalysisReader(llvm::MemoryBufferRef Buf,
+                             BinaryHelperAnalysisKind Kind,
+                             const LLVMValueIds &Ids);
+
+  [[nodiscard]] bool isValid() const noexcept { return Valid; }
+  [[nodiscard]] explicit operator bool() const noexcept { return Valid; }
+
+  /// Whether the complete payload has been read
+  [[nodiscard]] bool atEnd() const noexcept { return Pos == Size; }
+
+  [[nodiscard]] uint32_t readU32();
+  [[nodiscard]] u32_array_t readU32Array();
+  [[nodiscard]] llvm::StringRef readString();
+
+  /// Reads an array of N+1 monotonic offsets into an array of size
+  /// NumElements, as used by compressed sparse rows
+  [[nodiscard]] u32_array_t readOffsets(size_t N, size_t NumElements);
+
+  /// Invalidates the reader, e.g. because the payload refers to a value that
+  /// does not exist
+  void fail(const llvm::Twine &Reason);
+
+private:
+  [[nodiscard]] const char *consume(size_t NumBytes);
+
+  const char *Data{};
+  size_t Size = 0;
+  size_t Pos = 0;
+  llvm::StringRef BufferId;
+  bool Valid = false;
+};
+
+} // namespace psr
+
+#endif // PHASAR_PHASARLLVM_UTILS_LLVMBINARYSERIALIZATION_H
@@ -0,0 +1,37 @@
+/******************************************************************************
+ * Copyright (c) 2023 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_UTILS_LLVMFUNCTIONHASH_H
+#define PHASAR_PHASARLLVM_UTILS_LLVMFUNCTIONHASH_H
+
+#include <cstdint>
+
+namespace llvm {
+class Function;
+} // namespace llvm
+
+namespace psr {
+
+/// Computes a structural hash of the given function that covers its name,
+/// signature and all instructions together with their operands.
+///
+/// The hash does not depend on the llvm::Module or llvm::LLVMContext that
+/// contains F, nor on debug metadata, the names of local values or the
+/// process that computes it. Hence, it can be used to find functions that did
+/// not change between two versions of a program, or to identify functions in
+/// data that is persisted across program runs. Two functions with the same hash
+/// have the same number of instructions in the same order.
+///
+/// Global values that F refers to are identified by their names, so a change
+/// of a callee's body does not change the hash of F.
+[[nodiscard]] uint64_t computeFunctionHash(const llvm::Function &F);
+
+} // namespace psr
+
+#endif // PHASAR_PHASARLLVM_UTILS_LLVMFUNCTIONHASH_H
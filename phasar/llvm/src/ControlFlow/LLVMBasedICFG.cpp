@@ -19,6 +19,7 @@
 #include "phasar/PhasarLLVM/Pointer/LLVMAliasSet.h"
 #include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
 #include "phasar/PhasarLLVM/Utils/LLVMBasedContainerConfig.h"
+#include "phasar/PhasarLLVM/Utils/LLVMBinarySerialization.h"
 #include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
 #include "phasar/Utils/Logger.h"
 #include "phasar/Utils/MaybeUniquePtr.h"
@@ -26,6 +27,7 @@
 #include "phasar/Utils/Soundness.h"
 #include "phasar/Utils/TypeTraits.h"
 #include "phasar/Utils/Utilities.h"
+#include "phasar/Utils/WorkStealingScheduler.h"
 
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallVector.h"
@@ -33,14 +35,28 @@
 #include "llvm/IR/Instruction.h"
 #include "llvm/Support/ErrorHandling.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <functional>
 #include <utility>
+#include <vector>
 
 namespace psr {
 struct LLVMBasedICFG::Builder {
+  /// A call-site found by scanning a function, before it is added to the
+  /// call-graph
+  struct ScannedCallSite {
+    const llvm::CallBase *CS{};
+    /// The statically known callee, or nullptr if CS must be resolved
+    /// dynamically
+    const llvm::Function *Callee{};
+    bool IsInlineAsm = false;
+  };
+
   LLVMProjectIRDB *IRDB = nullptr;
   LLVMAliasInfoRef PT{};
   LLVMTypeHierarchy *TH{};
+  LLVMBasedICFG *ICF{};
   CallGraphBuilder<const llvm::Instruction *, const llvm::Function *>
       CGBuilder{};
   std::unique_ptr<Resolver> Res = nullptr;
@@ -58,17 +74,42 @@ struct LLVMBasedICFG::Builder {
   // Map indirect calls to the number of possible targets found for it. Fixpoint
   // is not reached when more targets are found.
   llvm::DenseMap<const llvm::Instruction *, unsigned> IndirectCalls{};
+  // The resolution epoch (see Resolver::getResolutionEpoch()) at which each
+  // indirect call has been resolved the last time
+  llvm::DenseMap<const llvm::Instruction *, size_t> ResolvedAt{};
+  // The indirect calls that have been found since the last round; only used
+  // for Soundness::Unsound
+  llvm::SmallVector<const llvm::CallBase *, 0> UnsoundIndirectCalls{};
+
+  unsigned NumThreads = 1;
 
   void initEntryPoints(llvm::ArrayRef<std::string> EntryPoints);
   void initGlobalsAndWorkList(LLVMBasedICFG *ICFG, bool IncludeGlobals);
   [[nodiscard]] CallGraph<const llvm::Instruction *, const llvm::Function *>
   buildCallGraph(Soundness S);
 
-  /// \returns FixPointReached
-  bool processFunction(/*bidigraph_t &Callgraph,*/ const llvm::Function *F,
-                       Soundness S);
+  /// Scans all functions in the worklist and adds their call-sites to the
+  /// call-graph
+  void processFunctions(Soundness S);
+  /// Finds the call-sites of F. Does not touch the builder, so it may be called
+  /// concurrently.
+  [[nodiscard]] static llvm::SmallVector<ScannedCallSite, 0>
+  scanCallSites(const llvm::Function *F, const LLVMProjectIRDB &IRDB);
+  /// Adds the call-sites of F, as found by scanCallSites(), to the call-graph
+  void addCallSites(const llvm::Function *F,
+                    llvm::ArrayRef<ScannedCallSite> CallSites, Soundness S);
+
+  /// Resolves all indirect calls whose resolution may have changed since they
+  /// have been resolved the last time.
   /// \returns FoundNewTargets
-  bool constructDynamicCall(const llvm::Instruction *CS);
+  bool resolveIndirectCalls(Soundness S);
+  /// Queries the resolver for the possible targets of CS. Does not touch the
+  /// builder, so it may be called concurrently, if the resolver supports it.
+  [[nodiscard]] Resolver::FunctionSetTy
+  resolveDynamicCall(const llvm::CallBase *CS) const;
+  /// \returns FoundNewTargets
+  bool addDynamicCallTargets(const llvm::CallBase *CS,
+                             Resolver::FunctionSetTy PossibleTargets);
 };
 
 void LLVMBasedICFG::Builder::initEntryPoints(
@@ -116,7 +157,28 @@ void LLVMBasedICFG::Builder::initGlobalsAndWorkList(LLVMBasedICFG *ICFG,
   CGBuilder.reserve(IRDB->getNumFunctions());
 }
 
-auto LLVMBasedICFG::Builder::buildCallGraph(Soundness /*S*/)
+/// Calls Fn(Idx) for all Idx in [0, N). Runs on NumThreads threads, if there
+/// are enough items to make this worthwhile.
+template <typename FnT>
+static void forEachIndex(size_t N, unsigned NumThreads, FnT Fn) {
+  static constexpr size_t MinItemsPerThread = 16;
+
+  NumThreads = unsigned(std::min(size_t(NumThreads), N / MinItemsPerThread));
+  if (NumThreads <= 1) {
+    for (size_t Idx = 0; Idx != N; ++Idx) {
+      std::invoke(Fn, Idx);
+    }
+    return;
+  }
+
+  WorkStealingScheduler<size_t> Scheduler(NumThreads);
+  for (size_t Idx = 0; Idx != N; ++Idx) {
+    Scheduler.push(Idx);
+  }
+  Scheduler.run(std::ref(Fn));
+}
+
+auto LLVMBasedICFG::Builder::buildCallGraph(Soundness S)
     -> CallGraph<n_t, f_t> {
   PHASAR_LOG_LEVEL_CAT(INFO, "LLVMBasedICFG",
                        "Starting CallGraphAnalysisType: " << Res->str());
@@ -125,33 +187,15 @@ auto LLVMBasedICFG::Builder::buildCallGraph(Soundness /*S*/)
   bool FixpointReached;
 
   do {
-    FixpointReached = true;
     while (!FunctionWL.empty()) {
-      const llvm::Function *F = FunctionWL.pop_back_val();
-      FixpointReached &= processFunction(F, S);
+      processFunctions(S);
     }
 
-    /// XXX This can probably be done more efficiently.
-    /// However, we cannot just work on the IndirectCalls-delta as we are
-    /// mutating the points-to-info on the fly
-    // for (auto [CS, _] : IndirectCalls) {
-    //   FixpointReached &= !constructDynamicCall(CS);
-    // }
-
-    if (S != Soundness::Unsound) {
-      for (auto [CS, _] : IndirectCalls) {
-        FixpointReached &= !constructDynamicCall(CS);
-      }
-    } else {
-      for (auto &CS : UnsoundIndirectCalls) {
-        FixpointReached &= !constructDynamicCall(CS);
-      }
-      UnsoundCallSites.insert(UnsoundIndirectCalls.begin(),
-                              UnsoundIndirectCalls.end());
-      UnsoundIndirectCalls.clear();
-    }
+    // Only re-resolve the indirect calls whose points-to information (or
+    // whatever else the resolver depends on) has changed
+    FixpointReached = !resolveIndirectCalls(S);
+  } while (!FixpointReached || !FunctionWL.empty());
 
-  } while (!FixpointReached);
   for (const auto &[IndirectCall, Targets] : IndirectCalls) {
     if (Targets == 0) {
       PHASAR_LOG_LEVEL(WARNING, "No callees found for callsite "
@@ -166,92 +210,127 @@ auto LLVMBasedICFG::Builder::buildCallGraph(Soundness /*S*/)
   return CGBuilder.consumeCallGraph();
 }
 
-bool LLVMBasedICFG::Builder::processFunction(const llvm::Function *F,
-                                             Soundness S) {
-  PHASAR_LOG_LEVEL_CAT(DEBUG, "LLVMBasedICFG",
-                       "Walking in function: " << F->getName());
-  if (F->isDeclaration() || !VisitedFunctions.insert(F).second) {
-    PHASAR_LOG_LEVEL_CAT(
-        DEBUG, "LLVMBasedICFG",
-        "Function already visited or only declaration: " << F->getName());
-    return true;
+void LLVMBasedICFG::Builder::processFunctions(Soundness S) {
+  // Take the whole worklist as one batch; the functions that are discovered
+  // while adding the batch to the call-graph form the next batch
+  llvm::SmallVector<const llvm::Function *, 0> Batch;
+  Batch.reserve(FunctionWL.size());
+  while (!FunctionWL.empty()) {
+    const llvm::Function *F = FunctionWL.pop_back_val();
+    PHASAR_LOG_LEVEL_CAT(DEBUG, "LLVMBasedICFG",
+                         "Walking in function: " << F->getName());
+    if (F->isDeclaration() || !VisitedFunctions.insert(F).second) {
+      PHASAR_LOG_LEVEL_CAT(
+          DEBUG, "LLVMBasedICFG",
+          "Function already visited or only declaration: " << F->getName());
+      continue;
+    }
+    Batch.push_back(F);
   }
 
+  // Scanning the functions is independent of each other, whereas adding them
+  // to the call-graph and notifying the resolver is sequential. Go in batch
+  // order to keep the result independent of the number of threads
+  std::vector<llvm::SmallVector<ScannedCallSite, 0>> CallSites(Batch.size());
+  forEachIndex(Batch.size(), NumThreads, [&](size_t Idx) {
+    CallSites[Idx] = scanCallSites(Batch[Idx], *IRDB);
+  });
+
+  for (size_t Idx = 0, End = Batch.size(); Idx != End; ++Idx) {
+    addCallSites(Batch[Idx], CallSites[Idx], S);
+    llvm::SmallVector<ScannedCallSite, 0>().swap(CallSites[Idx]);
+  }
+}
+
+auto LLVMBasedICFG::Builder::scanCallSites(const llvm::Function *F,
+                                           const LLVMProjectIRDB &IRDB)
+    -> llvm::SmallVector<ScannedCallSite, 0> {
+  llvm::SmallVector<ScannedCallSite, 0> Ret;
+  for (const auto &I : llvm::instructions(F)) {
+    const auto *CS = llvm::dyn_cast<llvm::CallBase>(&I);
+    if (!CS) {
+      continue;
+    }
+
+    // check if function call can be resolved statically
+    if (const auto *Callee = CS->getCalledFunction()) {
+      Ret.push_back({CS, Callee});
+      continue;
+    }
+
+    // still try to resolve the called function statically
+    const llvm::Value *SV = CS->getCalledOperand()->stripPointerCasts();
+    const llvm::Function *ValueFunction =
+        !SV->hasName() ? nullptr : IRDB.getFunction(SV->getName());
+    Ret.push_back({CS, ValueFunction,
+                   !ValueFunction && llvm::isa<llvm::InlineAsm>(SV)});
+  }
+  return Ret;
+}
+
+void LLVMBasedICFG::Builder::addCallSites(
+    const llvm::Function *F, llvm::ArrayRef<ScannedCallSite> CallSites,
+    Soundness S) {
   assert(Res != nullptr);
 
   // add a node for function F to the call graph (if not present already)
   std::ignore = CGBuilder.addFunctionVertex(F);
 
-  bool FixpointReached = true;
-
   // iterate all instructions of the current function
+  const auto *NextCallSite = CallSites.begin();
   Resolver::FunctionSetTy PossibleTargets;
   for (const auto &I : llvm::instructions(F)) {
-    if (const auto *CS = llvm::dyn_cast<llvm::CallBase>(&I)) {
-      Res->preCall(&I);
-
-      // check if function call can be resolved statically
-      if (CS->getCalledFunction() != nullptr) {
-        PossibleTargets.insert(CS->getCalledFunction());
-
-        PHASAR_LOG_LEVEL_CAT(DEBUG, "LLVMBasedICFG",
-                             "Found static call-site: "
-                                 << "  " << llvmIRToString(CS));
-      } else {
-        // still try to resolve the called function statically
-        const llvm::Value *SV = CS->getCalledOperand()->stripPointerCasts();
-        const llvm::Function *ValueFunction =
-            !SV->hasName() ? nullptr : IRDB->getFunction(SV->getName());
-        if (ValueFunction) {
-          PossibleTargets.insert(ValueFunction);
-          PHASAR_LOG_LEVEL_CAT(
-              DEBUG, "LLVMBasedICFG",
-              "Found static call-site: " << llvmIRToString(CS));
-        } else {
-          if (llvm::isa<llvm::InlineAsm>(SV)) {
-            continue;
-          }
-          // the function call must be resolved dynamically
-          PHASAR_LOG_LEVEL_CAT(DEBUG, "LLVMBasedICFG",
-                               "Found dynamic call-site: "
-                                   << "  " << llvmIRToString(CS));
-          IndirectCalls[CS] = 0;
-          std::ignore = CGBuilder.addInstructionVertex(CS);
-
-          if (S != Soundness::Unsound) {
-            FixpointReached = false;
-          } else {
-            UnsoundIndirectCalls.push_back(CS);
-          }
-
-          continue;
-        }
-      }
+    if (NextCallSite == CallSites.end() || NextCallSite->CS != &I) {
+      Res->otherInst(&I);
+      continue;
+    }
+
+    const auto &[CS, Callee, IsInlineAsm] = *NextCallSite++;
+    Res->preCall(CS);
 
+    if (IsInlineAsm) {
+      continue;
+    }
+
+    if (!Callee) {
+      // the function call must be resolved dynamically
       PHASAR_LOG_LEVEL_CAT(DEBUG, "LLVMBasedICFG",
-                           "Found " << PossibleTargets.size()
-                                    << " possible target(s)");
+                           "Found dynamic call-site: "
+                               << "  " << llvmIRToString(CS));
+      IndirectCalls[CS] = 0;
+      std::ignore = CGBuilder.addInstructionVertex(CS);
 
-      Res->handlePossibleTargets(CS, PossibleTargets);
+      if (S == Soundness::Unsound) {
+        UnsoundIndirectCalls.push_back(CS);
+      }
+      continue;
+    }
 
-      auto *CallSiteId = CGBuilder.addInstructionVertex(CS);
+    PHASAR_LOG_LEVEL_CAT(DEBUG, "LLVMBasedICFG",
+                         "Found static call-site: "
+                             << "  " << llvmIRToString(CS));
+    PossibleTargets.insert(Callee);
 
-      // Insert possible target inside the graph and add the link with
-      // the current function
-      for (const auto *PossibleTarget : PossibleTargets) {
-        CGBuilder.addCallEdge(CS, CallSiteId, PossibleTarget);
+    PHASAR_LOG_LEVEL_CAT(DEBUG, "LLVMBasedICFG",
+                         "Found " << PossibleTargets.size()
+                                  << " possible target(s)");
 
-        FunctionWL.push_back(PossibleTarget);
-      }
+    Res->handlePossibleTargets(CS, PossibleTargets);
 
-      Res->postCall(&I);
-    } else {
-      Res->otherInst(&I);
+    auto *CallSiteId = CGBuilder.addInstructionVertex(CS);
+
+    // Insert possible target inside the graph and add the link with
+    // the current function
+    for (const auto *PossibleTarget : PossibleTargets) {
+      CGBuilder.addCallEdge(CS, CallSiteId, PossibleTarget);
+
+      FunctionWL.push_back(PossibleTarget);
     }
+
+    Res->postCall(CS);
     PossibleTargets.clear();
   }
-
-  return FixpointReached;
+  assert(NextCallSite == CallSites.end());
 }
 
 static bool internalIsVirtualFunctionCall(const llvm::Instruction *Inst,
@@ -275,73 +354,111 @@ static bool internalIsVirtualFunctionCall(const llvm::Instruction *Inst,
   return getVFTIndex(CallSite) >= 0;
 }
 
-bool LLVMBasedICFG::Builder::constructDynamicCall(const llvm::Instruction *CS) {
-  bool NewTargetsFound = false;
-  // Find vertex of calling function.
+bool LLVMBasedICFG::Builder::resolveIndirectCalls(Soundness S) {
+  llvm::SmallVector<const llvm::CallBase *, 0> DirtyCalls;
+  if (S != Soundness::Unsound) {
+    DirtyCalls.reserve(IndirectCalls.size());
+    for (auto [Inst, _] : IndirectCalls) {
+      const auto *CS = llvm::cast<llvm::CallBase>(Inst);
+      auto Epoch = Res->getResolutionEpoch(CS);
+      auto [It, Inserted] = ResolvedAt.try_emplace(CS, Epoch);
+      if (Inserted || It->second != Epoch) {
+        It->second = Epoch;
+        DirtyCalls.push_back(CS);
+      }
+    }
+  } else {
+    DirtyCalls = std::move(UnsoundIndirectCalls);
+    UnsoundIndirectCalls.clear();
+    ICF->UnsoundCallSites.insert(DirtyCalls.begin(), DirtyCalls.end());
+  }
+
+  bool FoundNewTargets = false;
+  if (!Res->supportsConcurrentResolution() || NumThreads <= 1) {
+    for (const auto *CS : DirtyCalls) {
+      // Resolving one call-site may change the resolution of the others, so
+      // resolve and add them one by one
+      FoundNewTargets |= addDynamicCallTargets(CS, resolveDynamicCall(CS));
+    }
+    return FoundNewTargets;
+  }
 
+  std::vector<Resolver::FunctionSetTy> PossibleTargets(DirtyCalls.size());
+  forEachIndex(DirtyCalls.size(), NumThreads, [&](size_t Idx) {
+    PossibleTargets[Idx] = resolveDynamicCall(DirtyCalls[Idx]);
+  });
+
+  for (size_t Idx = 0, End = DirtyCalls.size(); Idx != End; ++Idx) {
+    FoundNewTargets |= addDynamicCallTargets(DirtyCalls[Idx],
+                                             std::move(PossibleTargets[Idx]));
+  }
+  return FoundNewTargets;
+}
+
+auto LLVMBasedICFG::Builder::resolveDynamicCall(
+    const llvm::CallBase *CS) const -> Resolver::FunctionSetTy {
+  // the function call must be resolved dynamically
+  PHASAR_LOG_LEVEL_CAT(DEBUG, "LLVMBasedICFG",
+                       "Looking into dynamic call-site: ");
+  PHASAR_LOG_LEVEL_CAT(DEBUG, "LLVMBasedICFG", "  " << llvmIRToString(CS));
+  // call the resolve routine
+
+  assert(TH != nullptr);
+  return internalIsVirtualFunctionCall(CS, *TH)
+             ? Res->resolveVirtualCall(CS)
+             : Res->resolveFunctionPointer(CS);
+}
+
+bool LLVMBasedICFG::Builder::addDynamicCallTargets(
+    const llvm::CallBase *CS, Resolver::FunctionSetTy PossibleTargets) {
+  // Find vertex of calling function.
   auto *Callees = CGBuilder.getInstVertexOrNull(CS);
 
   if (!Callees) {
     llvm::report_fatal_error(
-        "constructDynamicCall: Did not find vertex of calling function " +
+        "addDynamicCallTargets: Did not find vertex of calling function " +
         CS->getFunction()->getName() + " at callsite " + llvmIRToString(CS));
   }
 
-  if (const auto *CallSite = llvm::dyn_cast<llvm::CallBase>(CS)) {
-    Res->preCall(CallSite);
-
-    // the function call must be resolved dynamically
-    PHASAR_LOG_LEVEL_CAT(DEBUG, "LLVMBasedICFG",
-                         "Looking into dynamic call-site: ");
-    PHASAR_LOG_LEVEL_CAT(DEBUG, "LLVMBasedICFG", "  " << llvmIRToString(CS));
-    // call the resolve routine
-
-    assert(TH != nullptr);
-    auto PossibleTargets = internalIsVirtualFunctionCall(CallSite, *TH)
-                               ? Res->resolveVirtualCall(CallSite)
-                               : Res->resolveFunctionPointer(CallSite);
+  assert(IndirectCalls.count(CS));
 
-    assert(IndirectCalls.count(CallSite));
+  auto &NumIndCalls = IndirectCalls[CS];
 
-    auto &NumIndCalls = IndirectCalls[CallSite];
+  if (NumIndCalls >= PossibleTargets.size()) {
+    return false;
+  }
 
-    if (NumIndCalls < PossibleTargets.size()) {
-      PHASAR_LOG_LEVEL_CAT(DEBUG, "LLVMBasedICFG",
-                           "Found " << PossibleTargets.size() - NumIndCalls
-                                    << " new possible target(s)");
-      NumIndCalls = PossibleTargets.size();
-      NewTargetsFound = true;
-    }
-    if (!NewTargetsFound) {
-      return NewTargetsFound;
-    }
+  PHASAR_LOG_LEVEL_CAT(DEBUG, "LLVMBasedICFG",
+                       "Found " << PossibleTargets.size() - NumIndCalls
+                                << " new possible target(s)");
+  NumIndCalls = PossibleTargets.size();
 
-    // Throw out already found targets
-    for (const auto *Tgt : *Callees) {
-      PossibleTargets.erase(Tgt);
-    }
+  Res->preCall(CS);
 
-    Res->handlePossibleTargets(CallSite, PossibleTargets);
-    // Insert possible target inside the graph and add the link with
-    // the current function
-    for (const auto *PossibleTarget : PossibleTargets) {
-      CGBuilder.addCallEdge(CallSite, Callees, PossibleTarget);
-      FunctionWL.push_back(PossibleTarget);
-    }
+  // Throw out already found targets
+  for (const auto *Tgt : *Callees) {
+    PossibleTargets.erase(Tgt);
+  }
 
-    Res->postCall(CallSite);
-  } else {
-    Res->otherInst(CS);
+  Res->handlePossibleTargets(CS, PossibleTargets);
+  // Insert possible target inside the graph and add the link with
+  // the current function
+  for (const auto *PossibleTarget : PossibleTargets) {
+    CGBuilder.addCallEdge(CS, Callees, PossibleTarget);
+    FunctionWL.push_back(PossibleTarget);
   }
 
-  return NewTargetsFound;
+  Res->postCall(CS);
+
+  return true;
 }
 
 LLVMBasedICFG::LLVMBasedICFG(LLVMProjectIRDB *IRDB,
                              CallGraphAnalysisType CGType,
                              llvm::ArrayRef<std::string> EntryPoints,
                              LLVMTypeHierarchy *TH, LLVMAliasInfoRef PT,
-                             Soundness S, bool IncludeGlobals)
+                             Soundness S, bool IncludeGlobals,
+                             unsigned NumThreads)
     : IRDB(IRDB), TH(TH) {
   assert(IRDB != nullptr);
 
@@ -349,11 +466,17 @@ LLVMBasedICFG::LLVMBasedICFG(LLVMProjectIRDB *IRDB,
     this->TH = std::make_unique<LLVMTypeHierarchy>(*IRDB);
   }
 
-  Builder B{IRDB, PT, this->TH.get()};
+  Builder B{IRDB, PT, this->TH.get(), this};
+  B.NumThreads = NumThreads;
   LLVMAliasInfo PTOwn;
 
   if (!PT && CGType == CallGraphAnalysisType::OTF) {
-    PTOwn = std::make_unique<LLVMAliasSet>(IRDB);
+    auto AS = std::make_unique<LLVMAliasSet>(IRDB);
+    if (NumThreads > 1) {
+      // Allows the OTFResolver to resolve the indirect calls concurrently
+      AS->computeAllAliasSets(NumThreads);
+    }
+    PTOwn = std::move(AS);
     B.PT = PTOwn.asRef();
   }
 
@@ -395,6 +518,52 @@ LLVMBasedICFG::LLVMBasedICFG(LLVMProjectIRDB *IRDB,
   }
 }
 
+std::unique_ptr<LLVMBasedICFG>
+LLVMBasedICFG::loadBinary(LLVMProjectIRDB *IRDB, llvm::MemoryBufferRef Buf,
+                          LLVMTypeHierarchy *TH) {
+  assert(IRDB != nullptr);
+
+  LLVMValueIds Ids(*IRDB);
+  BinaryHelperAnalysisReader Reader(Buf, BinaryHelperAnalysisKind::CallGraph,
+                                    Ids);
+  auto Funs = Reader.readU32Array();
+  auto Callers = Reader.readU32Array();
+  auto Offsets = Reader.readOffsets(Funs.size(), Callers.size());
+  if (!Reader) {
+    return nullptr;
+  }
+
+  CallGraphBuilder<n_t, f_t> CGBuilder;
+  CGBuilder.reserve(Funs.size());
+  for (size_t Idx = 0; Idx != Funs.size(); ++Idx) {
+    const auto *Fun = Ids.getFunction(Funs[Idx]);
+    if (!Fun) {
+      Reader.fail("Invalid function-id " + llvm::Twine(Funs[Idx]));
+      return nullptr;
+    }
+
+    auto *CEdges = CGBuilder.addFunctionVertex(Fun);
+    CEdges->reserve(Offsets[Idx + 1] - Offsets[Idx]);
+    for (uint32_t Id :
+         Callers.slice(Offsets[Idx], Offsets[Idx + 1] - Offsets[Idx])) {
+      const auto *CS =
+          llvm::dyn_cast_or_null<llvm::Instruction>(Ids.getValue(Id));
+      if (!CS) {
+        Reader.fail("Invalid call-site id " + llvm::Twine(Id));
+        return nullptr;
+      }
+      CGBuilder.addCallEdge(CS, Fun, CEdges);
+    }
+  }
+
+  if (!Reader.atEnd()) {
+    Reader.fail("Unexpected trailing data");
+    return nullptr;
+  }
+  return std::make_unique<LLVMBasedICFG>(CGBuilder.consumeCallGraph(), IRDB,
+                                         TH);
+}
+
 LLVMBasedICFG::~LLVMBasedICFG() = default;
 
 [[nodiscard]] FunctionRange LLVMBasedICFG::getAllFunctionsImpl() const {
@@ -460,6 +629,37 @@ void LLVMBasedICFG::printImpl(llvm::raw_ostream &OS) const {
       [this](n_t Inst) { return IRDB->getInstructionId(Inst); });
 }
 
+void LLVMBasedICFG::writeBinary(llvm::raw_ostream &OS) const {
+  LLVMValueIds Ids(*IRDB);
+
+  // Sort the functions to keep the output deterministic
+  std::vector<std::pair<uint32_t, f_t>> Funs;
+  Funs.reserve(CG.getNumVertexFunctions());
+  for (const auto *Fun : CG.getAllVertexFunctions()) {
+    Funs.emplace_back(Ids.getFunctionId(Fun), Fun);
+  }
+  std::sort(Funs.begin(), Funs.end());
+
+  std::vector<uint32_t> FunIds;
+  std::vector<uint32_t> Callers;
+  std::vector<uint32_t> Offsets = {0};
+  FunIds.reserve(Funs.size());
+  Offsets.reserve(Funs.size() + 1);
+  for (const auto &[FunId, Fun] : Funs) {
+    FunIds.push_back(FunId);
+    for (const auto *CS : CG.getCallersOf(Fun)) {
+      Callers.push_back(Ids.getId(CS));
+    }
+    Offsets.push_back(Callers.size());
+  }
+
+  BinaryHelperAnalysisWriter Writer(BinaryHelperAnalysisKind::CallGraph, Ids);
+  Writer.writeU32Array(FunIds);
+  Writer.writeU32Array(Callers);
+  Writer.writeU32Array(Offsets);
+  Writer.emit(OS);
+}
+
 bool LLVMBasedICFG::addEdgeToICFG(const llvm::Instruction *CallSite,
                                   const llvm::Function *CallTarget) {
   auto *InstVtx = addInstructionVertex(CallSite);
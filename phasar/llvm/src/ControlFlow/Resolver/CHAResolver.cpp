@@ -57,19 +57,22 @@ auto CHAResolver::resolveVirtualCall(const llvm::CallBase *CallSite)
 
   const auto *ReceiverTy = getReceiverType(CallSite);
 
-  // also insert all possible subtypes vtable entries
-  auto FallbackTys = Resolver::TH->getSubTypes(ReceiverTy);
-
   FunctionSetTy PossibleCallees;
 
-  for (const auto &FallbackTy : FallbackTys) {
-    const auto *Target =
-        getNonPureVirtualVFTEntry(FallbackTy, VtableIndex, CallSite);
-    if (Target) {
-      PossibleCallees.insert(Target);
-    }
-  }
+  // also insert all possible subtypes vtable entries
+  Resolver::TH->forEachSubType(
+      ReceiverTy, [&](const llvm::StructType *FallbackTy) {
+        const auto *Target =
+            getNonPureVirtualVFTEntry(FallbackTy, VtableIndex, CallSite);
+        if (Target) {
+          PossibleCallees.insert(Target);
+        }
+      });
   return PossibleCallees;
 }
 
+bool CHAResolver::supportsConcurrentResolution() const noexcept {
+  return true;
+}
+
 std::string CHAResolver::str() const { return "CHA"; }
@@ -150,7 +150,9 @@ void DTAResolver::otherInst(const llvm::Instruction *Inst) {
 
     if (SrcStructType && DestStructType &&
         heuristicAntiConstructorVtablePos(BitCast)) {
-      TypeGraph.addLink(DestStructType, SrcStructType);
+      if (TypeGraph.addLink(DestStructType, SrcStructType)) {
+        ++NumAddedLinks;
+      }
     }
   }
 }
@@ -210,4 +212,12 @@ auto DTAResolver::resolveVirtualCall(const llvm::CallBase *CallSite)
   return PossibleCallTargets;
 }
 
+bool DTAResolver::supportsConcurrentResolution() const noexcept {
+  return false;
+}
+
+size_t DTAResolver::getResolutionEpoch(const llvm::CallBase * /*CallSite*/) {
+  return NumAddedLinks;
+}
+
 std::string DTAResolver::str() const { return "DTA"; }
@@ -43,6 +43,10 @@ auto NOResolver::resolveFunctionPointer(const llvm::CallBase * /*CallSite*/)
 
 void NOResolver::otherInst(const llvm::Instruction *Inst) {}
 
+bool NOResolver::supportsConcurrentResolution() const noexcept {
+  return true;
+}
+
 std::string NOResolver::str() const { return "NOResolver"; }
 
 } // namespace psr
@@ -11,6 +11,7 @@
 
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
 #include "phasar/PhasarLLVM/ControlFlow/Resolver/Resolver.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMAliasSet.h"
 #include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
 #include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
 #include "phasar/Utils/Logger.h"
@@ -304,4 +305,16 @@ OTFResolver::getActualFormalPointerPairs(const llvm::CallBase *CallSite,
   return Pairs;
 }
 
+bool OTFResolver::supportsConcurrentResolution() const noexcept {
+  const auto *AS = PT.dyn_cast<LLVMAliasSet>();
+  return AS && AS->isComplete();
+}
+
+size_t OTFResolver::getResolutionEpoch(const llvm::CallBase *CallSite) {
+  if (!CallSite->getCalledOperand()) {
+    return 0;
+  }
+  return PT.getAliasSet(CallSite->getCalledOperand(), CallSite)->size();
+}
+
 std::string OTFResolver::str() const { return "OTF"; }
@@ -79,15 +79,10 @@ auto RTAResolver::resolveVirtualCall(const llvm::CallBase *CallSite)
   const auto *ReceiverType = getReceiverType(CallSite);
 
   // also insert all possible subtypes vtable entries
-  auto ReachableTypes = Resolver::TH->getSubTypes(ReceiverType);
-
-  // also insert all possible subtypes vtable entries
-
-  auto EndIt = ReachableTypes.end();
   for (const auto *PossibleType : AllocatedStructTypes) {
     if (const auto *PossibleTypeStruct =
             llvm::dyn_cast<llvm::StructType>(PossibleType)) {
-      if (ReachableTypes.find(PossibleTypeStruct) != EndIt) {
+      if (Resolver::TH->isSubType(ReceiverType, PossibleTypeStruct)) {
         const auto *Target = getNonPureVirtualVFTEntry(PossibleTypeStruct,
                                                        VtableIndex, CallSite);
         if (Target) {
@@ -159,6 +159,12 @@ auto Resolver::resolveFunctionPointer(const llvm::CallBase *CallSite)
 
 void Resolver::otherInst(const llvm::Instruction *Inst) {}
 
+bool Resolver::supportsConcurrentResolution() const noexcept { return false; }
+
+size_t Resolver::getResolutionEpoch(const llvm::CallBase * /*CallSite*/) {
+  return 0;
+}
+
 std::unique_ptr<Resolver> Resolver::create(CallGraphAnalysisType Ty,
                                            LLVMProjectIRDB *IRDB,
                                            LLVMTypeHierarchy *TH,
@@ -9,6 +9,10 @@
 
 #include "phasar/DataFlow/IfdsIde/IFDSIDESolverConfig.h"
 
+#include "llvm/ADT/StringSwitch.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/raw_ostream.h"
+
 #include <ostream>
 
 using namespace std;
@@ -16,6 +20,28 @@ using namespace psr;
 
 namespace psr {
 
+std::string toString(WorkListPolicy Policy) {
+  switch (Policy) {
+#define WORKLIST_POLICY(NAME, CMDFLAG, DESC)                                   \
+  case WorkListPolicy::NAME:                                                   \
+    return #NAME;
+#include "phasar/DataFlow/IfdsIde/WorkListPolicy.def"
+  }
+  llvm_unreachable("All WorkListPolicies should be handled in the switch");
+}
+
+WorkListPolicy toWorkListPolicy(llvm::StringRef S) {
+  return llvm::StringSwitch<WorkListPolicy>(S)
+#define WORKLIST_POLICY(NAME, CMDFLAG, DESC)                                   \
+  .Cases(#NAME, CMDFLAG, WorkListPolicy::NAME)
+#include "phasar/DataFlow/IfdsIde/WorkListPolicy.def"
+      .Default(WorkListPolicy::DepthFirst);
+}
+
+llvm::raw_ostream &operator<<(llvm::raw_ostream &OS, WorkListPolicy Policy) {
+  return OS << toString(Policy);
+}
+
 IFDSIDESolverConfig::IFDSIDESolverConfig(SolverConfigOptions Options) noexcept
     : Options(Options) {}
 
@@ -37,6 +63,11 @@ bool IFDSIDESolverConfig::emitESG() const {
 bool IFDSIDESolverConfig::computePersistedSummaries() const {
   return hasFlag(Options, SolverConfigOptions::ComputePersistedSummaries);
 }
+unsigned IFDSIDESolverConfig::numThreads() const { return NumThreads; }
+WorkListPolicy IFDSIDESolverConfig::workListPolicy() const { return Policy; }
+size_t IFDSIDESolverConfig::edgeFunctionMemoCacheSize() const {
+  return EFMemoCacheSize;
+}
 
 void IFDSIDESolverConfig::setFollowReturnsPastSeeds(bool Set) {
   setFlag(Options, SolverConfigOptions::FollowReturnsPastSeeds, Set);
@@ -56,6 +87,15 @@ void IFDSIDESolverConfig::setEmitESG(bool Set) {
 void IFDSIDESolverConfig::setComputePersistedSummaries(bool Set) {
   setFlag(Options, SolverConfigOptions::ComputePersistedSummaries, Set);
 }
+void IFDSIDESolverConfig::setNumThreads(unsigned NumThreads) {
+  this->NumThreads = NumThreads;
+}
+void IFDSIDESolverConfig::setWorkListPolicy(WorkListPolicy Policy) {
+  this->Policy = Policy;
+}
+void IFDSIDESolverConfig::setEdgeFunctionMemoCacheSize(size_t Size) {
+  EFMemoCacheSize = Size;
+}
 
 void IFDSIDESolverConfig::setConfig(SolverConfigOptions Opt) { Options = Opt; }
 
@@ -68,7 +108,11 @@ ostream &operator<<(ostream &OS, const IFDSIDESolverConfig &SC) {
             << "\trecordEdges: " << SC.recordEdges() << "\n"
             << "\tcomputePersistedSummaries: " << SC.computePersistedSummaries()
             << "\n"
-            << "\temitESG: " << SC.emitESG();
+            << "\temitESG: " << SC.emitESG() << "\n"
+            << "\tnumThreads: " << SC.numThreads() << "\n"
+            << "\tworkListPolicy: " << toString(SC.workListPolicy()) << "\n"
+            << "\tedgeFunctionMemoCacheSize: "
+            << SC.edgeFunctionMemoCacheSize();
 }
 
 } // namespace psr
@@ -230,7 +230,16 @@ void IDEExtendedTaintAnalysis::reportLeakIfNecessary(
     const llvm::Instruction *Inst, const llvm::Value *SinkCandidate,
     const llvm::Value *LeakCandidate) {
   if (isSink(SinkCandidate, Inst)) {
-    Leaks[Inst].insert(LeakCandidate);
+    reportLeak(Inst, LeakCandidate);
+  }
+}
+
+void IDEExtendedTaintAnalysis::reportLeak(const llvm::Instruction *Inst,
+                                          const llvm::Value *Leak) {
+  // With strong updates, the leak may still be sanitized. It is then reported
+  // by doPostProcessing(), if it survives
+  if (Leaks[Inst].insert(Leak).second && OnLeak && DisableStrongUpdates) {
+    OnLeak(Inst, Leak);
   }
 }
 
@@ -284,7 +293,7 @@ auto IDEExtendedTaintAnalysis::handleConfig(const llvm::Instruction *Inst,
       for (const auto *Snk : SinkConfig) {
         if (equivalent(Source, makeFlowFact(Snk))) {
           PHASAR_LOG_LEVEL(DEBUG, "Leaking: " << llvmIRToString(Snk));
-          Leaks[Inst].insert(Snk);
+          reportLeak(Inst, Snk);
         }
       }
     }
@@ -925,6 +934,14 @@ void IDEExtendedTaintAnalysis::doPostProcessing(
   for (const auto *Inst : RemInst) {
     Leaks.erase(Inst);
   }
+
+  if (OnLeak) {
+    for (const auto &[Inst, ConfirmedLeaks] : Leaks) {
+      for (const auto *L : ConfirmedLeaks) {
+        OnLeak(Inst, L);
+      }
+    }
+  }
 }
 
 const LeakMap_t &IDEExtendedTaintAnalysis::getAllLeaks(
@@ -60,11 +60,20 @@ struct TSEdgeFunctionComposer
   }
 };
 
+static IDETypeStateAnalysisDomain::l_t
+getNextState(const TypeStateDescription *TSD,
+             const IDETypeStateAnalysis::APIFunctionInfo &Callee,
+             IDETypeStateAnalysisDomain::l_t S,
+             const llvm::CallBase *CallSite) {
+  if (Callee.Token) {
+    return TSD->getNextStateById(*Callee.Token, S, CallSite);
+  }
+  return TSD->getNextState(Callee.DemangledName, S, CallSite);
+}
+
 struct TSEdgeFunction {
   const TypeStateDescription *TSD;
-  // XXX: Do we really need a string here? Can't we just use an integer or sth
-  // else that is cheap?
-  std::string Token;
+  const IDETypeStateAnalysis::APIFunctionInfo *Callee;
   const llvm::CallBase *CallSite;
 
   using l_t = IDETypeStateAnalysisDomain ::l_t;
@@ -73,11 +82,13 @@ struct TSEdgeFunction {
 
     // assert((Source != TSD->top()) && "Error: call computeTarget with TOP\n");
 
-    auto CurrentState = TSD->getNextState(
-        Token, Source == TSD->top() ? TSD->uninit() : Source, CallSite);
+    auto CurrentState =
+        getNextState(TSD, *Callee,
+                     Source == TSD->top() ? TSD->uninit() : Source, CallSite);
     PHASAR_LOG_LEVEL(DEBUG, "State machine transition: ("
-                                << Token << " , " << TSD->stateToString(Source)
-                                << ") -> " << TSD->stateToString(CurrentState));
+                                << Callee->DemangledName << " , "
+                                << TSD->stateToString(Source) << ") -> "
+                                << TSD->stateToString(CurrentState));
     return CurrentState;
   }
 
@@ -100,12 +111,12 @@ struct TSEdgeFunction {
   }
 
   bool operator==(const TSEdgeFunction &Other) const {
-    return CallSite == Other.CallSite && Token == Other.Token;
+    return CallSite == Other.CallSite && Callee == Other.Callee;
   }
 
   friend llvm::raw_ostream &print(llvm::raw_ostream &OS,
                                   const TSEdgeFunction &TSE) {
-    return OS << "TSEF(" << TSE.Token << " at "
+    return OS << "TSEF(" << TSE.Callee->DemangledName << " at "
               << llvmIRToShortString(TSE.CallSite) << ")";
   }
 };
@@ -265,7 +276,7 @@ IDETypeStateAnalysis::getCallFlowFunction(IDETypeStateAnalysis::n_t CallSite,
                                           IDETypeStateAnalysis::f_t DestFun) {
   // Kill all data-flow facts if we hit a function of the target API.
   // Those functions are modled within Call-To-Return.
-  if (TSD->isAPIFunction(llvm::demangle(DestFun->getName().str()))) {
+  if (getAPIFunctionInfo(DestFun).IsAPIFunction) {
     return killAllFlows<d_t>();
   }
   // Otherwise, if we have an ordinary function call, we can just use the
@@ -374,9 +385,9 @@ IDETypeStateAnalysis::getCallToRetFlowFunction(
     llvm::ArrayRef<f_t> Callees) {
   const auto *CS = llvm::cast<llvm::CallBase>(CallSite);
   for (const auto *Callee : Callees) {
-    std::string DemangledFname = llvm::demangle(Callee->getName().str());
+    const auto &Info = getAPIFunctionInfo(Callee);
     // Generate the return value of factory functions from zero value
-    if (TSD->isFactoryFunction(DemangledFname)) {
+    if (Info.IsFactoryFunction) {
       struct TSFlowFunction : FlowFunction<IDETypeStateAnalysis::d_t> {
         IDETypeStateAnalysis::d_t CS, ZeroValue;
 
@@ -408,7 +419,7 @@ IDETypeStateAnalysis::getCallToRetFlowFunction(
     // not be killed during call-to-return, since it is not safe to assume
     // that the return value will be used afterwards, i.e. is stored to memory
     // pointed to by related alloca's.
-    if (!TSD->isAPIFunction(DemangledFname) && !Callee->isDeclaration()) {
+    if (!Info.IsAPIFunction && !Callee->isDeclaration()) {
       for (const auto &Arg : CS->args()) {
         if (hasMatchingType(Arg)) {
           return killManyFlows<d_t>(getWMAliasesAndAllocas(Arg.get()));
@@ -496,29 +507,28 @@ auto IDETypeStateAnalysis::getCallToRetEdgeFunction(
     -> EdgeFunction<l_t> {
   const auto *CS = llvm::cast<llvm::CallBase>(CallSite);
   for (const auto *Callee : Callees) {
-    std::string DemangledFname = llvm::demangle(Callee->getName().str());
+    const auto &Info = getAPIFunctionInfo(Callee);
 
     // For now we assume that we can only generate from the return value.
     // We apply the same edge function for the return value, i.e. callsite.
-    if (TSD->isFactoryFunction(DemangledFname)) {
+    if (Info.IsFactoryFunction) {
       PHASAR_LOG_LEVEL(DEBUG, "Processing factory function");
       if (isZeroValue(CallNode) && RetSiteNode == CS) {
-        return TSConstant{
-            {TSD->getNextState(DemangledFname, TSD->uninit(), CS)}, TSD};
+        return TSConstant{{getNextState(TSD, Info, TSD->uninit(), CS)}, TSD};
       }
     }
 
     // For every consuming parameter and all its aliases and relevant alloca's
     // we apply the same edge function.
-    if (TSD->isConsumingFunction(DemangledFname)) {
+    if (Info.IsConsumingFunction) {
       PHASAR_LOG_LEVEL(DEBUG, "Processing consuming function");
-      for (auto Idx : TSD->getConsumerParamIdx(DemangledFname)) {
+      for (auto Idx : Info.ConsumerParamIdx) {
         std::set<IDETypeStateAnalysis::d_t> AliasAndAllocas =
             getWMAliasesAndAllocas(CS->getArgOperand(Idx));
 
         if (CallNode == RetSiteNode &&
             AliasAndAllocas.find(CallNode) != AliasAndAllocas.end()) {
-          return TSEdgeFunction{TSD, DemangledFname, CS};
+          return TSEdgeFunction{TSD, &Info, CS};
         }
       }
     }
@@ -580,6 +590,23 @@ void IDETypeStateAnalysis::printEdgeFact(llvm::raw_ostream &OS,
   OS << TSD->stateToString(L);
 }
 
+auto IDETypeStateAnalysis::getAPIFunctionInfo(IDETypeStateAnalysis::f_t F)
+    -> const APIFunctionInfo & {
+  auto [It, Inserted] = APIFunctionCache.try_emplace(F);
+  auto &Info = It->second;
+  if (Inserted) {
+    Info.DemangledName = llvm::demangle(F->getName().str());
+    Info.Token = TSD->getTokenId(Info.DemangledName);
+    Info.IsAPIFunction = TSD->isAPIFunction(Info.DemangledName);
+    Info.IsFactoryFunction = TSD->isFactoryFunction(Info.DemangledName);
+    Info.IsConsumingFunction = TSD->isConsumingFunction(Info.DemangledName);
+    if (Info.IsConsumingFunction) {
+      Info.ConsumerParamIdx = TSD->getConsumerParamIdx(Info.DemangledName);
+    }
+  }
+  return Info;
+}
+
 std::set<IDETypeStateAnalysis::d_t>
 IDETypeStateAnalysis::getRelevantAllocas(IDETypeStateAnalysis::d_t V) {
   if (RelevantAllocaCache.find(V) != RelevantAllocaCache.end()) {
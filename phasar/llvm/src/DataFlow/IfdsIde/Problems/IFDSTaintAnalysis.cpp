@@ -105,6 +105,12 @@ bool IFDSTaintAnalysis::isSanitizerCall(const llvm::CallBase * /*CB*/,
       [this](const auto &Arg) { return Config->isSanitizer(&Arg); });
 }
 
+void IFDSTaintAnalysis::reportLeak(n_t CallSite, d_t Leak) {
+  if (Leaks[CallSite].insert(Leak).second && OnLeak) {
+    OnLeak(CallSite, Leak);
+  }
+}
+
 void IFDSTaintAnalysis::populateWithMayAliases(std::set<d_t> &Facts) const {
   std::set<d_t> Tmp = Facts;
   for (const auto *Fact : Facts) {
@@ -235,7 +241,7 @@ IFDSTaintAnalysis::getCallToRetFlowFunction(
     return lambdaFlow<d_t>([Leak{std::move(Leak)}, Kill{std::move(Kill)}, this,
                             CallSite](d_t Source) -> std::set<d_t> {
       if (Leak.count(Source)) {
-        Leaks[CallSite].insert(Source);
+        reportLeak(CallSite, Source);
       }
 
       if (Kill.count(Source)) {
@@ -253,7 +259,7 @@ IFDSTaintAnalysis::getCallToRetFlowFunction(
       }
 
       if (Leak.count(Source)) {
-        Leaks[CallSite].insert(Source);
+        reportLeak(CallSite, Source);
       }
 
       return {Source};
@@ -267,7 +273,7 @@ IFDSTaintAnalysis::getCallToRetFlowFunction(
     }
 
     if (Leak.count(Source)) {
-      Leaks[CallSite].insert(Source);
+      reportLeak(CallSite, Source);
     }
 
     if (Kill.count(Source)) {
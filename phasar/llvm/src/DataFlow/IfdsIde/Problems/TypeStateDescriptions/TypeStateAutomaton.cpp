@@ -0,0 +1,349 @@
+/******************************************************************************
+ * Copyright (c) 2023 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/TypeStateDescriptions/TypeStateAutomaton.h"
+
+#include "phasar/Utils/IO.h"
+#include "phasar/Utils/Logger.h"
+
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace psr;
+
+using State = TypeStateAutomaton::State;
+using TokenId = TypeStateAutomaton::TokenId;
+
+TypeStateAutomaton::Builder::Builder(std::string TypeNameOfInterest) noexcept
+    : TypeNameOfInterest(std::move(TypeNameOfInterest)) {}
+
+auto TypeStateAutomaton::Builder::addState(llvm::StringRef Name, State Value)
+    -> Builder & {
+  States.emplace_back(Name.str(), Value);
+  return *this;
+}
+
+auto TypeStateAutomaton::Builder::setTop(State S) noexcept -> Builder & {
+  Top = S;
+  return *this;
+}
+
+auto TypeStateAutomaton::Builder::setBottom(State S) noexcept -> Builder & {
+  Bottom = S;
+  return *this;
+}
+
+auto TypeStateAutomaton::Builder::setUninit(State S) noexcept -> Builder & {
+  Uninit = S;
+  return *this;
+}
+
+auto TypeStateAutomaton::Builder::setStart(State S) noexcept -> Builder & {
+  Start = S;
+  return *this;
+}
+
+auto TypeStateAutomaton::Builder::setError(State S) noexcept -> Builder & {
+  Error = S;
+  return *this;
+}
+
+TokenId TypeStateAutomaton::Builder::addToken(
+    llvm::StringRef Name,
+    std::initializer_list<std::pair<llvm::StringRef, std::set<int>>>
+        Functions) {
+  auto Tok = TokenId(Tokens.size());
+  Tokens.push_back(Name.str());
+  for (const auto &[F, ParamIdx] : Functions) {
+    addFunction(F, Tok, ParamIdx);
+  }
+  return Tok;
+}
+
+auto TypeStateAutomaton::Builder::addFunction(llvm::StringRef F, TokenId Tok,
+                                              std::set<int> ParamIdx)
+    -> Builder & {
+  Functions.emplace_back(F.str(), std::make_pair(Tok, std::move(ParamIdx)));
+  return *this;
+}
+
+auto TypeStateAutomaton::Builder::addTransition(TokenId Tok, State From,
+                                                State To) -> Builder & {
+  Transitions.emplace_back(Tok, std::make_pair(From, To));
+  return *this;
+}
+
+auto TypeStateAutomaton::Builder::addTransitions(
+    TokenId Tok, std::initializer_list<std::pair<State, State>> FromTo)
+    -> Builder & {
+  for (auto [From, To] : FromTo) {
+    addTransition(Tok, From, To);
+  }
+  return *this;
+}
+
+std::optional<TypeStateAutomaton>
+TypeStateAutomaton::Builder::buildOrNull(llvm::raw_ostream &Err) && {
+  TypeStateAutomaton Ret;
+  Ret.TypeNameOfInterest = std::move(TypeNameOfInterest);
+
+  for (auto &[Name, Value] : States) {
+    if (Value == llvm::DenseMapInfo<State>::getEmptyKey() ||
+        Value == llvm::DenseMapInfo<State>::getTombstoneKey()) {
+      Err << "The value of state '" << Name << "' is reserved";
+      return std::nullopt;
+    }
+    auto Column = uint32_t(Ret.StateValues.size());
+    if (!Ret.StateColumns.try_emplace(Value, Column).second) {
+      Err << "Duplicate state value " << Value << " of state '" << Name
+          << "'";
+      return std::nullopt;
+    }
+    Ret.StateValues.push_back(Value);
+    Ret.StateNames.push_back(std::move(Name));
+  }
+
+  auto SetRole = [&Ret, &Err](llvm::StringRef Role, std::optional<State> S,
+                              State &Into) {
+    if (!S) {
+      Err << "No " << Role << " state";
+      return false;
+    }
+    if (!Ret.StateColumns.count(*S)) {
+      Err << "The " << Role << " state " << *S << " is unknown";
+      return false;
+    }
+    Into = *S;
+    return true;
+  };
+  if (!SetRole("top", Top, Ret.Top) ||
+      !SetRole("bottom", Bottom, Ret.Bottom) ||
+      !SetRole("uninit", Uninit, Ret.Uninit) ||
+      !SetRole("start", Start, Ret.Start) ||
+      !SetRole("error", Error, Ret.Error)) {
+    return std::nullopt;
+  }
+
+  Ret.TokenNames = std::move(Tokens);
+  auto NumStates = Ret.StateValues.size();
+  Ret.Delta.assign(Ret.TokenNames.size() * NumStates, Ret.Error);
+
+  for (auto &[F, Info] : Functions) {
+    auto &[Tok, ParamIdx] = Info;
+    if (Tok >= Ret.TokenNames.size()) {
+      Err << "API function '" << F << "' refers to unknown token " << Tok;
+      return std::nullopt;
+    }
+    if (!Ret.APIFunctions.try_emplace(F, APIFunction{Tok, std::move(ParamIdx)})
+             .second) {
+      Err << "Duplicate API function '" << F << "'";
+      return std::nullopt;
+    }
+  }
+
+  for (auto [Tok, FromTo] : Transitions) {
+    auto [From, To] = FromTo;
+    if (Tok >= Ret.TokenNames.size()) {
+      Err << "Transition refers to unknown token " << Tok;
+      return std::nullopt;
+    }
+    auto FromIt = Ret.StateColumns.find(From);
+    if (FromIt == Ret.StateColumns.end() || !Ret.StateColumns.count(To)) {
+      Err << "Transition of token '" << Ret.TokenNames[Tok]
+          << "' refers to unknown state";
+      return std::nullopt;
+    }
+    Ret.Delta[Tok * NumStates + FromIt->second] = To;
+  }
+
+  return Ret;
+}
+
+TypeStateAutomaton TypeStateAutomaton::Builder::build() && {
+  std::string Msg;
+  llvm::raw_string_ostream Err(Msg);
+  auto Ret = std::move(*this).buildOrNull(Err);
+  if (!Ret) {
+    llvm::report_fatal_error("Invalid type state automaton: " +
+                             llvm::Twine(Err.str()));
+  }
+  return std::move(*Ret);
+}
+
+std::optional<TypeStateAutomaton>
+TypeStateAutomaton::fromJson(const nlohmann::json &J) {
+  std::string Msg;
+  llvm::raw_string_ostream Err(Msg);
+
+  auto Parse = [&J, &Err]() -> std::optional<TypeStateAutomaton> {
+    Builder B(J.at("type").get<std::string>());
+
+    llvm::StringMap<State> States;
+    for (const auto &El : J.at("states").items()) {
+      auto S = El.value().get<State>();
+      States[El.key()] = S;
+      B.addState(El.key(), S);
+    }
+    auto GetState = [&States, &Err](const std::string &Name) {
+      auto It = States.find(Name);
+      if (It == States.end()) {
+        Err << "Unknown state '" << Name << "'";
+        return std::optional<State>{};
+      }
+      return std::optional<State>{It->second};
+    };
+
+    auto Top = GetState(J.at("top").get<std::string>());
+    auto Bottom = GetState(J.at("bottom").get<std::string>());
+    auto Uninit = GetState(J.at("uninit").get<std::string>());
+    auto Start = GetState(J.at("start").get<std::string>());
+    auto Error = GetState(J.at("error").get<std::string>());
+    if (!Top || !Bottom || !Uninit || !Start || !Error) {
+      return std::nullopt;
+    }
+    B.setTop(*Top)
+        .setBottom(*Bottom)
+        .setUninit(*Uninit)
+        .setStart(*Start)
+        .setError(*Error);
+
+    llvm::StringMap<TokenId> Tokens;
+    for (const auto &TokEl : J.at("tokens").items()) {
+      auto Tok = B.addToken(TokEl.key());
+      Tokens[TokEl.key()] = Tok;
+      for (const auto &FunEl : TokEl.value().items()) {
+        B.addFunction(FunEl.key(), Tok, FunEl.value().get<std::set<int>>());
+      }
+    }
+
+    if (J.contains("transitions")) {
+      for (const auto &TokEl : J["transitions"].items()) {
+        auto TokIt = Tokens.find(TokEl.key());
+        if (TokIt == Tokens.end()) {
+          Err << "Unknown token '" << TokEl.key() << "'";
+          return std::nullopt;
+        }
+        for (const auto &DeltaEl : TokEl.value().items()) {
+          auto FromState = GetState(DeltaEl.key());
+          auto ToState = GetState(DeltaEl.value().get<std::string>());
+          if (!FromState || !ToState) {
+            return std::nullopt;
+          }
+          B.addTransition(TokIt->second, *FromState, *ToState);
+        }
+      }
+    }
+
+    return std::move(B).buildOrNull(Err);
+  };
+
+  std::optional<TypeStateAutomaton> Ret;
+  try {
+    Ret = Parse();
+  } catch (const nlohmann::json::exception &E) {
+    Err << E.what();
+  }
+  if (!Ret) {
+    PHASAR_LOG_LEVEL_CAT(ERROR, "TypeStateAutomaton",
+                         "Invalid type state automaton: " << Err.str());
+  }
+  return Ret;
+}
+
+std::optional<TypeStateAutomaton>
+TypeStateAutomaton::loadFromFile(const llvm::Twine &Path) {
+  return fromJson(readJsonFile(Path));
+}
+
+auto TypeStateAutomaton::getAPIFunction(llvm::StringRef F) const
+    -> const APIFunction * {
+  auto It = APIFunctions.find(F);
+  if (It == APIFunctions.end()) {
+    return nullptr;
+  }
+  return &It->second;
+}
+
+bool TypeStateAutomaton::isFactoryFunction(const std::string &F) const {
+  const auto *Fun = getAPIFunction(F);
+  return Fun && Fun->ParamIdx.count(-1);
+}
+
+bool TypeStateAutomaton::isConsumingFunction(const std::string &F) const {
+  const auto *Fun = getAPIFunction(F);
+  return Fun && !Fun->ParamIdx.count(-1);
+}
+
+bool TypeStateAutomaton::isAPIFunction(const std::string &F) const {
+  return getAPIFunction(F) != nullptr;
+}
+
+State TypeStateAutomaton::getNextState(std::string Tok, State S) const {
+  if (auto Id = getTokenId(Tok)) {
+    return getNextStateById(*Id, S, nullptr);
+  }
+  return Bottom;
+}
+
+std::optional<TokenId> TypeStateAutomaton::getTokenId(llvm::StringRef F) const {
+  if (const auto *Fun = getAPIFunction(F)) {
+    return Fun->Token;
+  }
+  return std::nullopt;
+}
+
+State TypeStateAutomaton::getNextStateById(
+    TokenId Tok, State S, const llvm::CallBase * /*CallSite*/) const {
+  assert(Tok < TokenNames.size() && "Invalid token");
+  auto It = StateColumns.find(S);
+  if (It == StateColumns.end()) {
+    return Bottom;
+  }
+  return Delta[Tok * StateValues.size() + It->second];
+}
+
+std::string TypeStateAutomaton::getTypeNameOfInterest() const {
+  return TypeNameOfInterest;
+}
+
+std::set<int>
+TypeStateAutomaton::getConsumerParamIdx(const std::string &F) const {
+  const auto *Fun = getAPIFunction(F);
+  if (Fun && !Fun->ParamIdx.count(-1)) {
+    return Fun->ParamIdx;
+  }
+  return {};
+}
+
+std::set<int>
+TypeStateAutomaton::getFactoryParamIdx(const std::string &F) const {
+  if (isFactoryFunction(F)) {
+    // We only generate via the return value
+    return {-1};
+  }
+  return {};
+}
+
+std::string TypeStateAutomaton::stateToString(State S) const {
+  auto It = StateColumns.find(S);
+  if (It == StateColumns.end()) {
+    llvm::report_fatal_error("received unknown state!");
+  }
+  return StateNames[It->second];
+}
+
+State TypeStateAutomaton::bottom() const { return Bottom; }
+
+State TypeStateAutomaton::top() const { return Top; }
+
+State TypeStateAutomaton::uninit() const { return Uninit; }
+
+State TypeStateAutomaton::start() const { return Start; }
+
+State TypeStateAutomaton::error() const { return Error; }
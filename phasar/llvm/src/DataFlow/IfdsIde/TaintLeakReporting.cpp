@@ -0,0 +1,73 @@
+/******************************************************************************
+ * Copyright (c) 2023 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/TaintLeakReporting.h"
+
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
+#include "phasar/PhasarLLVM/TaintConfig/LLVMTaintConfig.h"
+
+#include "llvm/IR/InstrTypes.h"
+
+using namespace psr;
+
+TaintLeakStopCondition::TaintLeakStopCondition(size_t MaxLeaks) noexcept
+    : MaxLeaks(MaxLeaks), StopRequested(MaxLeaks == 0) {}
+
+TaintLeakStopCondition::TaintLeakStopCondition(
+    llvm::DenseSet<const llvm::Instruction *> Sinks) noexcept
+    : PendingSinks(std::move(Sinks)), WaitForSinks(true),
+      // Without any sink, there is nothing to wait for
+      StopRequested(PendingSinks.empty()) {}
+
+LeakCallbackTy TaintLeakStopCondition::makeCallback(LeakCallbackTy Next) {
+  return [this, Next{std::move(Next)}](const llvm::Instruction *Sink,
+                                       const llvm::Value *Leak) {
+    onLeak(Sink, Leak);
+    if (Next) {
+      Next(Sink, Leak);
+    }
+  };
+}
+
+void TaintLeakStopCondition::onLeak(const llvm::Instruction *Sink,
+                                    const llvm::Value * /*Leak*/) {
+  ++NumLeaks;
+  if (WaitForSinks) {
+    PendingSinks.erase(Sink);
+    if (PendingSinks.empty()) {
+      StopRequested = true;
+    }
+  } else if (NumLeaks >= MaxLeaks) {
+    StopRequested = true;
+  }
+}
+
+llvm::DenseSet<const llvm::Instruction *>
+psr::collectSinkCallSites(const LLVMBasedICFG &ICF,
+                          const LLVMTaintConfig &Config) {
+  llvm::DenseSet<const llvm::Instruction *> Sinks;
+  for (const auto *Inst : ICF.getIRDB()->getAllInstructions()) {
+    if (!llvm::isa<llvm::CallBase>(Inst)) {
+      continue;
+    }
+    // The sink callback does not depend on the callee
+    if (Config.mayLeakValuesAt(Inst, nullptr)) {
+      Sinks.insert(Inst);
+      continue;
+    }
+    for (const auto *Callee : ICF.getCalleesOfCallAt(Inst)) {
+      if (Config.mayLeakValuesAt(Inst, Callee)) {
+        Sinks.insert(Inst);
+        break;
+      }
+    }
+  }
+  return Sinks;
+}
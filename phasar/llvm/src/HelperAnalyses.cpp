@@ -4,11 +4,43 @@
 #include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMAliasSet.h"
 #include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "phasar/Utils/IO.h"
+#include "phasar/Utils/Logger.h"
+
+#include "llvm/Support/MemoryBuffer.h"
 
 #include <memory>
+#include <mutex>
 #include <string>
+#include <type_traits>
 
 namespace psr {
+
+/// Loads a helper analysis from the binary file at Path; returns nullptr if
+/// there is no such file or it cannot be loaded into the current module
+template <typename LoaderFn>
+static std::invoke_result_t<LoaderFn, llvm::MemoryBufferRef>
+loadBinaryOrNull(const std::string &Path, llvm::StringRef What,
+                 LoaderFn Loader) {
+  if (Path.empty()) {
+    return nullptr;
+  }
+  auto Buf = readFileOrNull(Path);
+  if (!Buf) {
+    PHASAR_LOG_LEVEL(WARNING, "Cannot read the precomputed " << What
+                                                             << " from '"
+                                                             << Path << "'");
+    return nullptr;
+  }
+  auto Ret = Loader(Buf->getMemBufferRef());
+  if (!Ret) {
+    PHASAR_LOG_LEVEL(WARNING, "Cannot load the precomputed "
+                                  << What << " from '" << Path
+                                  << "'; recompute it instead");
+  }
+  return Ret;
+}
+
 HelperAnalyses::HelperAnalyses(std::string IRFile,
                                std::optional<nlohmann::json> PrecomputedPTS,
                                AliasAnalysisType PTATy, bool AllowLazyPTS,
@@ -16,9 +48,10 @@ HelperAnalyses::HelperAnalyses(std::string IRFile,
                                std::optional<nlohmann::json> PrecomputedCG,
                                CallGraphAnalysisType CGTy,
                                Soundness SoundnessLevel,
-                               bool AutoGlobalSupport) noexcept
+                               bool AutoGlobalSupport,
+                               unsigned NumPTAThreads) noexcept
     : IRFile(std::move(IRFile)), PrecomputedPTS(std::move(PrecomputedPTS)),
-      PTATy(PTATy), AllowLazyPTS(AllowLazyPTS),
+      PTATy(PTATy), AllowLazyPTS(AllowLazyPTS), NumPTAThreads(NumPTAThreads),
       PrecomputedCG(std::move(PrecomputedCG)),
       EntryPoints(std::move(EntryPoints)), CGTy(CGTy),
       SoundnessLevel(SoundnessLevel), AutoGlobalSupport(AutoGlobalSupport) {}
@@ -27,12 +60,17 @@ HelperAnalyses::HelperAnalyses(std::string IRFile,
                                std::vector<std::string> EntryPoints,
                                HelperAnalysisConfig Config) noexcept
     : IRFile(std::move(IRFile)),
-      PrecomputedPTS(std::move(Config.PrecomputedPTS)), PTATy(Config.PTATy),
-      AllowLazyPTS(Config.AllowLazyPTS),
+      PrecomputedPTS(std::move(Config.PrecomputedPTS)),
+      PrecomputedPTSBinaryFile(std::move(Config.PrecomputedPTSBinaryFile)),
+      PTATy(Config.PTATy), AllowLazyPTS(Config.AllowLazyPTS),
+      NumPTAThreads(Config.NumPTAThreads),
+      PrecomputedTHBinaryFile(std::move(Config.PrecomputedTHBinaryFile)),
       PrecomputedCG(std::move(Config.PrecomputedCG)),
+      PrecomputedCGBinaryFile(std::move(Config.PrecomputedCGBinaryFile)),
       EntryPoints(std::move(EntryPoints)), CGTy(Config.CGTy),
       SoundnessLevel(Config.SoundnessLevel),
-      AutoGlobalSupport(Config.AutoGlobalSupport) {}
+      AutoGlobalSupport(Config.AutoGlobalSupport),
+      NumCGThreads(Config.NumCGThreads) {}
 
 HelperAnalyses::HelperAnalyses(const llvm::Twine &IRFile,
                                std::vector<std::string> EntryPoints,
@@ -47,54 +85,91 @@ HelperAnalyses::HelperAnalyses(const char *IRFile,
 HelperAnalyses::~HelperAnalyses() noexcept = default;
 
 LLVMProjectIRDB &HelperAnalyses::getProjectIRDB() {
-  if (!IRDB) {
-    IRDB = std::make_unique<LLVMProjectIRDB>(IRFile);
-  }
+  std::call_once(IRDBOnce,
+                 [this] { IRDB = std::make_unique<LLVMProjectIRDB>(IRFile); });
   return *IRDB;
 }
 
 LLVMAliasSet &HelperAnalyses::getAliasInfo() {
-  if (!PT) {
+  std::call_once(PTOnce, [this] {
+    PT = loadBinaryOrNull(PrecomputedPTSBinaryFile, "alias sets",
+                          [this](llvm::MemoryBufferRef Buf) {
+                            return LLVMAliasSet::loadBinary(&getProjectIRDB(),
+                                                            Buf);
+                          });
+    if (PT) {
+      return;
+    }
     if (PrecomputedPTS.has_value()) {
       PT = std::make_unique<LLVMAliasSet>(&getProjectIRDB(), *PrecomputedPTS);
     } else {
       PT = std::make_unique<LLVMAliasSet>(&getProjectIRDB(), AllowLazyPTS,
-                                          PTATy);
+                                          PTATy, NumPTAThreads);
     }
-  }
+  });
   return *PT;
 }
 
 LLVMTypeHierarchy &HelperAnalyses::getTypeHierarchy() {
-  if (!TH) {
-    TH = std::make_unique<LLVMTypeHierarchy>(getProjectIRDB());
-  }
+  std::call_once(THOnce, [this] {
+    TH = loadBinaryOrNull(PrecomputedTHBinaryFile, "type hierarchy",
+                          [this](llvm::MemoryBufferRef Buf) {
+                            return LLVMTypeHierarchy::loadBinary(
+                                getProjectIRDB(), Buf);
+                          });
+    if (!TH) {
+      TH = std::make_unique<LLVMTypeHierarchy>(getProjectIRDB());
+    }
+  });
   return *TH;
 }
 
 LLVMBasedICFG &HelperAnalyses::getICFG() {
-  if (!ICF) {
+  std::call_once(ICFOnce, [this] {
+    ICF = loadBinaryOrNull(PrecomputedCGBinaryFile, "call-graph",
+                           [this](llvm::MemoryBufferRef Buf) {
+                             return LLVMBasedICFG::loadBinary(
+                                 &getProjectIRDB(), Buf, &getTypeHierarchy());
+                           });
+    if (ICF) {
+      return;
+    }
     if (PrecomputedCG.has_value()) {
       ICF = std::make_unique<LLVMBasedICFG>(&getProjectIRDB(), *PrecomputedCG);
     } else {
+      if (CGTy == CallGraphAnalysisType::OTF && NumCGThreads > 1) {
+        // Only complete alias sets can be queried concurrently
+        getAliasInfo().computeAllAliasSets(NumPTAThreads);
+      }
       ICF = std::make_unique<LLVMBasedICFG>(
           &getProjectIRDB(), CGTy, std::move(EntryPoints), &getTypeHierarchy(),
           CGTy == CallGraphAnalysisType::OTF ? &getAliasInfo() : nullptr,
-          SoundnessLevel, AutoGlobalSupport);
+          SoundnessLevel, AutoGlobalSupport, NumCGThreads);
     }
-  }
+  });
 
   return *ICF;
 }
 
 LLVMBasedCFG &HelperAnalyses::getCFG() {
-  if (!CFG) {
-    if (ICF) {
-      return *ICF;
+  std::call_once(CFGOnce, [this] {
+    if (!ICF) {
+      CFG = std::make_unique<LLVMBasedCFG>();
     }
-    CFG = std::make_unique<LLVMBasedCFG>();
+  });
+  if (CFG) {
+    return *CFG;
   }
-  return *CFG;
+  return *ICF;
+}
+
+void HelperAnalyses::prepareForConcurrentAccess() {
+  // The ICFG may introduce aliases while resolving indirect calls, so
+  // construct it before completing the alias sets
+  (void)getTypeHierarchy();
+  (void)getICFG();
+  getAliasInfo().computeAllAliasSets(NumPTAThreads);
+  (void)getCFG();
 }
 
 } // namespace psr
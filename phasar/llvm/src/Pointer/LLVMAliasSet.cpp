@@ -12,11 +12,13 @@
 #include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMAliasInfo.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToUtils.h"
+#include "phasar/PhasarLLVM/Utils/LLVMBinarySerialization.h"
 #include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
 #include "phasar/Pointer/AliasAnalysisType.h"
 #include "phasar/Utils/BoxedPointer.h"
 #include "phasar/Utils/Logger.h"
 #include "phasar/Utils/NlohmannLogging.h"
+#include "phasar/Utils/WorkStealingScheduler.h"
 
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseSet.h"
@@ -46,6 +48,8 @@
 #include <iomanip>
 #include <iterator>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <type_traits>
 #include <utility>
 
@@ -54,10 +58,11 @@ namespace psr {
 template class BoxedPtr<LLVMAliasInfo::AliasSetTy>;
 template class BoxedConstPtr<LLVMAliasInfo::AliasSetTy>;
 template class AliasSetOwner<LLVMAliasInfo::AliasSetTy>;
+template class UnionFindAliasSets<LLVMAliasInfo::AliasSetTy>;
 
 LLVMAliasSet::LLVMAliasSet(LLVMProjectIRDB *IRDB, bool UseLazyEvaluation,
-                           AliasAnalysisType PATy)
-    : PTA(*IRDB, UseLazyEvaluation, PATy) {
+                           AliasAnalysisType PATy, unsigned NumThreads)
+    : IRDB(IRDB), PTA(*IRDB, /*UseLazyEvaluation=*/true, PATy) {
   assert(IRDB != nullptr);
 
   auto NumGlobals = IRDB->getNumGlobals();
@@ -70,22 +75,17 @@ LLVMAliasSet::LLVMAliasSet(LLVMProjectIRDB *IRDB, bool UseLazyEvaluation,
           << std::chrono::steady_clock::now().time_since_epoch().count());
   auto *M = IRDB->getModule();
 
-  // compute points-to information for all globals
-
-  for (const auto &G : M->globals()) {
-    computeValuesAliasSet(&G);
-  }
-
-  for (const auto &F : M->functions()) {
-    computeValuesAliasSet(&F);
-  }
-
   if (!UseLazyEvaluation) {
     // compute points-to information for all functions
-    for (auto &F : *M) {
-      if (!F.isDeclaration()) {
-        computeFunctionsAliasSet(&F);
-      }
+    computeAllAliasSets(NumThreads);
+  } else {
+    // compute points-to information for all globals
+    for (const auto &G : M->globals()) {
+      computeValuesAliasSet(&G);
+    }
+
+    for (const auto &F : M->functions()) {
+      computeValuesAliasSet(&F);
     }
   }
 
@@ -97,7 +97,7 @@ LLVMAliasSet::LLVMAliasSet(LLVMProjectIRDB *IRDB, bool UseLazyEvaluation,
 
 LLVMAliasSet::LLVMAliasSet(LLVMProjectIRDB *IRDB,
                            const nlohmann::json &SerializedPTS)
-    : PTA(*IRDB, true) {
+    : IRDB(IRDB), PTA(*IRDB, true) {
   assert(IRDB != nullptr);
   // Assume, we already have validated the json schema
 
@@ -112,10 +112,9 @@ LLVMAliasSet::LLVMAliasSet(LLVMProjectIRDB *IRDB,
   /// Deserialize the AliasSets - an array of arrays (both are to be
   /// interpreted as sets of metadata-ids)
 
-  Owner.reserve(Sets.size());
   for (const auto &PtsJson : Sets) {
     assert(PtsJson.is_array());
-    auto PTS = Owner.acquire();
+    const llvm::Value *First = nullptr;
     for (const auto &Alias : PtsJson) {
       const auto AliasStr = Alias.get<std::string>();
       const auto *Inst = fromMetaDataId(*IRDB, AliasStr);
@@ -124,8 +123,12 @@ LLVMAliasSet::LLVMAliasSet(LLVMProjectIRDB *IRDB,
         continue;
       }
 
-      AliasSets[Inst] = PTS;
-      PTS->insert(Inst);
+      if (First) {
+        AliasSets.merge(First, Inst);
+      } else {
+        First = Inst;
+        AliasSets.insert(Inst);
+      }
     }
   }
 
@@ -150,6 +153,69 @@ LLVMAliasSet::LLVMAliasSet(LLVMProjectIRDB *IRDB,
   }
 }
 
+LLVMAliasSet::LLVMAliasSet(LLVMProjectIRDB *IRDB, EmptyTag /*unused*/)
+    : IRDB(IRDB), PTA(*IRDB, true) {
+  assert(IRDB != nullptr);
+}
+
+std::unique_ptr<LLVMAliasSet>
+LLVMAliasSet::loadBinary(LLVMProjectIRDB *IRDB, llvm::MemoryBufferRef Buf) {
+  assert(IRDB != nullptr);
+  PHASAR_LOG_LEVEL_CAT(DEBUG, "LLVMAliasSet",
+                       "Load precomputed points-to info from binary");
+
+  LLVMValueIds Ids(*IRDB);
+  BinaryHelperAnalysisReader Reader(Buf, BinaryHelperAnalysisKind::AliasSet,
+                                    Ids);
+  auto NumClasses = Reader.readU32();
+  auto Members = Reader.readU32Array();
+  auto Offsets = Reader.readOffsets(NumClasses, Members.size());
+  auto Fns = Reader.readU32Array();
+  if (!Reader) {
+    return nullptr;
+  }
+
+  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory) -- private ctor
+  std::unique_ptr<LLVMAliasSet> Ret(new LLVMAliasSet(IRDB, EmptyTag{}));
+  auto &AliasSets = Ret->AliasSets;
+  AliasSets.reserve(Members.size());
+
+  for (size_t Class = 0; Class != NumClasses; ++Class) {
+    std::optional<uint32_t> Rep;
+    for (uint32_t Id : Members.slice(Offsets[Class],
+                                     Offsets[Class + 1] - Offsets[Class])) {
+      const auto *V = Ids.getValue(Id);
+      if (!V) {
+        Reader.fail("Invalid value-id " + llvm::Twine(Id));
+        return nullptr;
+      }
+
+      auto VId = AliasSets.insert(V);
+      if (Rep) {
+        AliasSets.merge(*Rep, VId);
+      } else {
+        Rep = VId;
+      }
+    }
+  }
+
+  Ret->AnalyzedFunctions.reserve(Fns.size());
+  for (uint32_t FunId : Fns) {
+    const auto *F = Ids.getFunction(FunId);
+    if (!F) {
+      Reader.fail("Invalid function-id " + llvm::Twine(FunId));
+      return nullptr;
+    }
+    Ret->AnalyzedFunctions.insert(F);
+  }
+
+  if (!Reader.atEnd()) {
+    Reader.fail("Unexpected trailing data");
+    return nullptr;
+  }
+  return Ret;
+}
+
 void LLVMAliasSet::computeValuesAliasSet(const llvm::Value *V) {
   if (!isInterestingPointer(V)) {
     // don't need to do anything
@@ -195,70 +261,125 @@ void LLVMAliasSet::computeValuesAliasSet(const llvm::Value *V) {
   }
 }
 
-void LLVMAliasSet::addSingletonAliasSet(const llvm::Value *V) {
-  auto [It, Inserted] = AliasSets.try_emplace(V, nullptr);
-
-  if (!Inserted) {
-    assert(It->second->count(V));
+void LLVMAliasSet::computeAllAliasSets(unsigned NumThreads) {
+  if (Complete) {
     return;
   }
 
-  auto PTS = Owner.acquire();
-  PTS->insert(V);
-  It->second = PTS;
-}
-
-void LLVMAliasSet::mergeAliasSets(const llvm::Value *V1,
-                                  const llvm::Value *V2) {
-  if (V1 == V2) {
-    return;
+  auto *M = IRDB->getModule();
+  std::vector<llvm::Function *> Pending;
+  for (auto &F : *M) {
+    if (F.isDeclaration()) {
+      AnalyzedFunctions.insert(&F);
+      // The queries must not insert singleton-sets later on
+      for (const auto &Arg : F.args()) {
+        if (isInterestingPointer(&Arg)) {
+          addSingletonAliasSet(&Arg);
+        }
+      }
+    } else if (!AnalyzedFunctions.count(&F)) {
+      Pending.push_back(&F);
+    }
   }
 
-  auto SearchV1 = AliasSets.find(V1);
-  assert(SearchV1 != AliasSets.end());
-
-  auto SearchV2 = AliasSets.find(V2);
-  assert(SearchV2 != AliasSets.end());
+  if (NumThreads <= 1 || Pending.size() <= 1) {
+    for (auto *F : Pending) {
+      computeFunctionsAliasSet(F);
+    }
+  } else {
+    PHASAR_LOG_LEVEL_CAT(INFO, "LLVMAliasSet",
+                         "Analyze " << Pending.size() << " functions on "
+                                    << NumThreads << " threads");
+    NumThreads = std::min(NumThreads, unsigned(Pending.size()));
+
+    // Computing and erasing the AAResults of a function creates and removes
+    // value handles, which live in the LLVMContext that all workers share.
+    // Hence, only the alias queries themselves run concurrently.
+    std::mutex PTAMtx;
+    std::vector<FunctionAliasClasses> Classes(Pending.size());
+    WorkStealingScheduler<size_t> Scheduler(NumThreads);
+    for (size_t Idx = 0, End = Pending.size(); Idx != End; ++Idx) {
+      Scheduler.push(Idx);
+    }
+    Scheduler.run([&](size_t Idx) {
+      auto *F = Pending[Idx];
+      llvm::AAResults *AAR = nullptr;
+      {
+        std::lock_guard Lck(PTAMtx);
+        AAR = PTA.getAAResultsForConcurrentQueries(F);
+      }
+      Classes[Idx] = computeFunctionAliasClasses(*F, *AAR);
+      // we no longer need the LLVM representation
+      std::lock_guard Lck(PTAMtx);
+      PTA.erase(F);
+    });
 
-  mergeAliasSets(SearchV1->second, SearchV2->second);
-}
+    // Merging into the shared alias sets is sequential; go in module order to
+    // keep the result deterministic
+    for (size_t Idx = 0, End = Pending.size(); Idx != End; ++Idx) {
+      AnalyzedFunctions.insert(Pending[Idx]);
+      addFunctionAliasClasses(Classes[Idx]);
+      FunctionAliasClasses().swap(Classes[Idx]);
+    }
+  }
 
-void LLVMAliasSet::mergeAliasSets(BoxedPtr<AliasSetTy> PTS1,
-                                  BoxedPtr<AliasSetTy> PTS2) {
-  if (PTS1 == PTS2 || PTS1.get() == PTS2.get()) {
-    return;
+  // The globals may have been used in functions that were not analyzed before
+  for (const auto &G : M->globals()) {
+    computeValuesAliasSet(&G);
+  }
+  for (const auto &F : *M) {
+    computeValuesAliasSet(&F);
   }
 
-  assert(PTS1 && PTS1.get());
-  assert(PTS2 && PTS2.get());
+  // The queries must not materialize alias sets later on
+  AliasSets.materializeAll();
+  Complete = true;
+}
 
-  auto [SmallerSet, LargerSet] = [&]() {
-    if (PTS1->size() > PTS2->size()) {
-      return std::make_pair(PTS2, PTS1);
+auto LLVMAliasSet::lookupAliasSet(const llvm::Value *V)
+    -> BoxedPtr<AliasSetTy> {
+  auto Id = AliasSets.lookup(V);
+  if (!Id) {
+    return getEmptyAliasSet();
+  }
+  if (Complete) {
+    // Read-only, such that the queries can run concurrently
+    if (auto PTS = AliasSets.getMaterializedAliasSet(AliasSets.findRoot(*Id))) {
+      return PTS;
     }
-    return std::make_pair(PTS1, PTS2);
-  }();
-
-  // reindex the contents of the smaller set
-  // for (const auto *Ptr : *SmallerSet) {
-  //   AliasSets[Ptr] = LargerSet;
-  // }
+  }
+  return AliasSets.getAliasSet(AliasSets.find(*Id));
+}
 
-  // add smaller set to larger one and get rid of the smaller set
-  LargerSet->reserve(LargerSet->size() + SmallerSet->size());
-  LargerSet->insert(SmallerSet->begin(), SmallerSet->end());
+bool LLVMAliasSet::inSameAliasSet(const llvm::Value *V1,
+                                  const llvm::Value *V2) {
+  auto Id1 = AliasSets.lookup(V1);
+  auto Id2 = AliasSets.lookup(V2);
+  if (!Id1 || !Id2) {
+    return false;
+  }
+  if (Complete) {
+    return AliasSets.findRoot(*Id1) == AliasSets.findRoot(*Id2);
+  }
+  return AliasSets.find(*Id1) == AliasSets.find(*Id2);
+}
 
-  // *SmallerSet.value() = LargerSet.get();
-  auto *ToDelete = SmallerSet.get();
-  for (const auto *Vals : *SmallerSet) {
-    auto PTS = AliasSets[Vals];
-    if (PTS.get() == ToDelete) {
+void LLVMAliasSet::addSingletonAliasSet(const llvm::Value *V) {
+  AliasSets.insert(V);
+}
 
-      *PTS.value() = LargerSet.get();
-    }
+void LLVMAliasSet::mergeAliasSets(const llvm::Value *V1,
+                                  const llvm::Value *V2) {
+  if (V1 == V2) {
+    return;
   }
 
-  Owner.release(ToDelete);
+  auto Id1 = AliasSets.lookup(V1);
+  assert(Id1.has_value());
+  auto Id2 = AliasSets.lookup(V2);
+  assert(Id2.has_value());
+
+  AliasSets.merge(*Id1, *Id2);
 }
 
 bool LLVMAliasSet::interIsReachableAllocationSiteTy(
@@ -336,9 +457,60 @@ static bool mayAlias(llvm::AAResults &AA, const llvm::DataLayout &DL,
   return false;
 }
 
-void LLVMAliasSet::addPointer(llvm::AAResults &AA, const llvm::DataLayout &DL,
-                              const llvm::Value *V,
-                              std::vector<const llvm::Value *> &Reps) {
+namespace {
+/// Union-find over the pointers of a single function
+class LocalAliasClasses {
+public:
+  unsigned getOrInsert(const llvm::Value *V) {
+    auto [It, Inserted] = Ids.try_emplace(V, Values.size());
+    if (Inserted) {
+      Values.push_back(V);
+      Parents.push_back(It->second);
+    }
+    return It->second;
+  }
+
+  void merge(const llvm::Value *V1, const llvm::Value *V2) {
+    auto Root1 = find(getOrInsert(V1));
+    auto Root2 = find(getOrInsert(V2));
+    if (Root1 != Root2) {
+      Parents[Root2] = Root1;
+    }
+  }
+
+  [[nodiscard]] auto takeClasses() {
+    llvm::SmallVector<unsigned> ClassOfRoot(Values.size(), ~0U);
+    std::vector<llvm::SmallVector<const llvm::Value *, 2>> Classes;
+    for (unsigned Id = 0, End = Values.size(); Id != End; ++Id) {
+      auto &Cls = ClassOfRoot[find(Id)];
+      if (Cls == ~0U) {
+        Cls = Classes.size();
+        Classes.emplace_back();
+      }
+      Classes[Cls].push_back(Values[Id]);
+    }
+    return Classes;
+  }
+
+private:
+  unsigned find(unsigned Id) {
+    while (Parents[Id] != Id) {
+      Parents[Id] = Parents[Parents[Id]];
+      Id = Parents[Id];
+    }
+    return Id;
+  }
+
+  llvm::DenseMap<const llvm::Value *, unsigned> Ids;
+  std::vector<const llvm::Value *> Values;
+  std::vector<unsigned> Parents;
+};
+} // namespace
+
+static void addPointer(llvm::AAResults &AA, const llvm::DataLayout &DL,
+                       const llvm::Value *V,
+                       std::vector<const llvm::Value *> &Reps,
+                       LocalAliasClasses &Classes) {
   llvm::SmallVector<unsigned> ToMerge;
 
   for (unsigned It = 0, End = Reps.size(); It < End; ++It) {
@@ -356,45 +528,30 @@ void LLVMAliasSet::addPointer(llvm::AAResults &AA, const llvm::DataLayout &DL,
   // still remove a representant, if we have another rep of the same type
   // within the same alias set.
 
+  Classes.getOrInsert(V);
   if (ToMerge.empty()) {
     Reps.push_back(V);
-    addSingletonAliasSet(V);
   } else if (ToMerge.size() == 1) {
-    auto PTS = AliasSets[Reps[ToMerge[0]]];
-    assert(PTS && "Only added to Reps together with a "
-                  "\"addSingletonAliasSet\" call");
-
-    if (auto VPTS = AliasSets.find(V); VPTS != AliasSets.end()) {
-      mergeAliasSets(PTS, VPTS->second);
-    } else {
-      AliasSets[V] = PTS;
-      PTS->insert(V);
-    }
+    Classes.merge(Reps[ToMerge[0]], V);
 
     if (V->getType() != Reps[ToMerge[0]]->getType()) {
       Reps.push_back(V);
     }
 
   } else {
-    auto PTS = AliasSets[Reps[ToMerge[0]]];
-    llvm::SmallPtrSet<const llvm::Type *, 6> OccurringTypes{
-        Reps[ToMerge[0]]->getType()};
+    const auto *Rep = Reps[ToMerge[0]];
+    llvm::SmallPtrSet<const llvm::Type *, 6> OccurringTypes{Rep->getType()};
     llvm::SmallVector<unsigned> ToRemove;
 
     for (auto Idx : llvm::makeArrayRef(ToMerge).slice(1)) {
-      mergeAliasSets(PTS, AliasSets[Reps[Idx]]);
+      Classes.merge(Rep, Reps[Idx]);
       if (auto [Unused, Inserted] = OccurringTypes.insert(Reps[Idx]->getType());
           !Inserted) {
         ToRemove.push_back(Idx);
       }
     }
 
-    if (auto VPTS = AliasSets.find(V); VPTS != AliasSets.end()) {
-      mergeAliasSets(PTS, VPTS->second);
-    } else {
-      AliasSets[V] = PTS;
-      PTS->insert(V);
-    }
+    Classes.merge(Rep, V);
 
     Reps.erase(remove_by_index(Reps, ToRemove.begin(), ToRemove.end()),
                Reps.end());
@@ -449,14 +606,25 @@ void LLVMAliasSet::computeFunctionsAliasSet(llvm::Function *F) {
   PHASAR_LOG_LEVEL_CAT(DEBUG, "LLVMAliasSet",
                        "Analyzing function: " << F->getName());
 
-  llvm::AAResults &AA = *PTA.getAAResults(F);
+  addFunctionAliasClasses(
+      computeFunctionAliasClasses(*F, *PTA.getAAResults(F)));
+
+  // we no longer need the LLVM representation
+  PTA.erase(F);
+}
+
+auto LLVMAliasSet::computeFunctionAliasClasses(llvm::Function &F,
+                                               llvm::AAResults &AA)
+    -> FunctionAliasClasses {
   bool EvalAAMD = true;
 
-  const llvm::DataLayout &DL = F->getParent()->getDataLayout();
+  const llvm::DataLayout &DL = F.getParent()->getDataLayout();
 
-  auto addPointer = [this, &AA, &DL](const llvm::Value *V, // NOLINT
-                                     std::vector<const llvm::Value *> &Reps) {
-    return this->addPointer(AA, DL, V, Reps);
+  LocalAliasClasses Classes;
+  auto addPointer = [&AA, &DL, &Classes]( // NOLINT
+                        const llvm::Value *V,
+                        std::vector<const llvm::Value *> &Reps) {
+    return psr::addPointer(AA, DL, V, Reps, Classes);
   };
 
   std::vector<const llvm::Value *> Pointers;
@@ -476,22 +644,18 @@ void LLVMAliasSet::computeFunctionsAliasSet(llvm::Function *F) {
       if (SVO->getType()->isPointerTy()) {
 
         if (llvm::isa<llvm::Function>(SVO)) {
-          addSingletonAliasSet(SVO);
-          addSingletonAliasSet(SPO);
-          mergeAliasSets(SVO, SPO);
+          Classes.merge(SVO, SPO);
         }
         if (auto *SVOCE = llvm::dyn_cast<llvm::ConstantExpr>(SVO)) {
           if (SVOCE->isCast()) {
             auto *RHS = SVOCE->getOperand(0);
 
-            addSingletonAliasSet(SPO);
+            Classes.getOrInsert(SPO);
             if (RHS->getType()->isPointerTy()) {
-              addSingletonAliasSet(RHS);
-              mergeAliasSets(RHS, SPO);
+              Classes.merge(RHS, SPO);
             }
 
-            addSingletonAliasSet(SVOCE);
-            mergeAliasSets(SVOCE, SPO);
+            Classes.merge(SVOCE, SPO);
           }
         }
       }
@@ -527,7 +691,7 @@ void LLVMAliasSet::computeFunctionsAliasSet(llvm::Function *F) {
     }
   }
 
-  for (auto &I : F->args()) {
+  for (auto &I : F.args()) {
     if (I.getType()->isPointerTy()) {
       // Add all pointer arguments.
       addPointer(&I, Pointers);
@@ -541,8 +705,18 @@ void LLVMAliasSet::computeFunctionsAliasSet(llvm::Function *F) {
     addPointer(Glob, Pointers);
   }
 
-  // we no longer need the LLVM representation
-  PTA.erase(F);
+  return Classes.takeClasses();
+}
+
+void LLVMAliasSet::addFunctionAliasClasses(
+    const FunctionAliasClasses &Classes) {
+  for (const auto &Class : Classes) {
+    assert(!Class.empty());
+    auto Rep = AliasSets.insert(Class.front());
+    for (const auto *V : llvm::makeArrayRef(Class).drop_front()) {
+      AliasSets.merge(Rep, AliasSets.insert(V));
+    }
+  }
 }
 
 AliasResult LLVMAliasSet::alias(const llvm::Value *V1, const llvm::Value *V2,
@@ -551,10 +725,9 @@ AliasResult LLVMAliasSet::alias(const llvm::Value *V1, const llvm::Value *V2,
   if (!isInterestingPointer(V1) || !isInterestingPointer(V2)) {
     return AliasResult::NoAlias;
   }
-  computeValuesAliasSet(V1);
-  computeValuesAliasSet(V2);
-  return AliasSets[V1]->count(V2) ? AliasResult::MayAlias
-                                  : AliasResult::NoAlias;
+  ensureAliasSet(V1);
+  ensureAliasSet(V2);
+  return inSameAliasSet(V1, V2) ? AliasResult::MayAlias : AliasResult::NoAlias;
 }
 
 auto LLVMAliasSet::getEmptyAliasSet() -> BoxedPtr<AliasSetTy> {
@@ -572,12 +745,9 @@ auto LLVMAliasSet::getAliasSet(const llvm::Value *V,
     return getEmptyAliasSet();
   }
   // compute V's points-to set
-  computeValuesAliasSet(V);
-  if (auto It = AliasSets.find(V); It != AliasSets.end()) {
-    return It->second;
-  }
+  ensureAliasSet(V);
   // if we still can't find its value return an empty set
-  return getEmptyAliasSet();
+  return lookupAliasSet(V);
 }
 
 auto LLVMAliasSet::getReachableAllocationSites(
@@ -590,9 +760,9 @@ auto LLVMAliasSet::getReachableAllocationSites(
   if (!isInterestingPointer(V)) {
     return AllocSites;
   }
-  computeValuesAliasSet(V);
+  ensureAliasSet(V);
 
-  const auto PTS = AliasSets[V];
+  const auto PTS = lookupAliasSet(V);
   // consider the full inter-procedural points-to/alias information
   if (!IntraProcOnly) {
     for (const auto *P : *PTS) {
@@ -624,7 +794,7 @@ bool LLVMAliasSet::isInReachableAllocationSites(
   if (!isInterestingPointer(V)) {
     return false;
   }
-  computeValuesAliasSet(V);
+  ensureAliasSet(V);
 
   bool PVIsReachableAllocationSiteType = false;
   if (IntraProcOnly) {
@@ -638,8 +808,7 @@ bool LLVMAliasSet::isInReachableAllocationSites(
   }
 
   if (PVIsReachableAllocationSiteType) {
-    const auto PTS = AliasSets[V];
-    return PTS->count(PotentialValue);
+    return inSameAliasSet(V, PotentialValue);
   }
 
   return false;
@@ -651,29 +820,16 @@ void LLVMAliasSet::mergeWith(const LLVMAliasSet &OtherPTI) {
   AnalyzedFunctions.insert(OtherPTI.AnalyzedFunctions.begin(),
                            OtherPTI.AnalyzedFunctions.end());
   // merge points-to sets
-  for (const auto &[KeyPtr, Set] : OtherPTI.AliasSets) {
-    bool FoundElemPtr = false;
-    for (const auto *ElemPtr : *Set) {
-      // check if a pointer of other is already present in this
-
-      if (auto Search = AliasSets.find(ElemPtr); Search != AliasSets.end()) {
-        // if so, copy its elements
-        FoundElemPtr = true;
-        Search->second->insert(Set->begin(), Set->end());
-        // and reindex its elements
-        for (const auto *ElemPtr : *Set) {
-          AliasSets.insert({ElemPtr, Search->second});
-        }
-        break;
-      }
-    }
-    // if none of the pointers of a set of other is known in this, we need to
-    // perform a copy
-    if (!FoundElemPtr) {
-      auto PTS = Owner.acquire();
-      *PTS = *Set;
-      AliasSets.try_emplace(KeyPtr, PTS);
-    }
+  const auto &Other = OtherPTI.AliasSets;
+  Other.forEachClass([this, &Other](auto Root) {
+    auto Rep = AliasSets.insert(Other.values()[Root]);
+    Other.forEachMember(Root, [this, Rep](const llvm::Value *V) {
+      AliasSets.merge(Rep, AliasSets.insert(V));
+    });
+  });
+
+  if (Complete) {
+    AliasSets.materializeAll();
   }
 }
 
@@ -689,6 +845,11 @@ void LLVMAliasSet::introduceAlias(const llvm::Value *V1, const llvm::Value *V2,
   computeValuesAliasSet(V1);
   computeValuesAliasSet(V2);
   mergeAliasSets(V1, V2);
+  if (Complete) {
+    // Keep the queries read-only
+    (void)lookupAliasSet(V1);
+    (void)lookupAliasSet(V2);
+  }
 }
 
 nlohmann::json LLVMAliasSet::getAsJson() const {
@@ -697,18 +858,18 @@ nlohmann::json LLVMAliasSet::getAsJson() const {
   /// Serialize the AliasSets
   auto &Sets = J["AliasSets"];
 
-  for (const AliasSetTy *PTS : Owner.getAllAliasSets()) {
+  AliasSets.forEachClass([this, &Sets](auto Root) {
     auto PtsJson = nlohmann::json::array();
-    for (const auto *Alias : *PTS) {
+    AliasSets.forEachMember(Root, [&PtsJson](const llvm::Value *Alias) {
       auto Id = getMetaDataID(Alias);
       if (Id != "-1") {
         PtsJson.push_back(std::move(Id));
       }
-    }
+    });
     if (!PtsJson.empty()) {
       Sets.push_back(std::move(PtsJson));
     }
-  }
+  });
 
   /// Serialize the AnalyzedFunctions
   auto &Fns = J["AnalyzedFunctions"];
@@ -722,12 +883,48 @@ void LLVMAliasSet::printAsJson(llvm::raw_ostream &OS) const {
   OS << getAsJson();
 }
 
+void LLVMAliasSet::writeBinary(llvm::raw_ostream &OS) const {
+  LLVMValueIds Ids(*IRDB);
+
+  std::vector<uint32_t> Members;
+  std::vector<uint32_t> Offsets = {0};
+  Members.reserve(AliasSets.size());
+  Offsets.reserve(AliasSets.getNumClasses() + 1);
+  AliasSets.forEachClass([&](auto Root) {
+    AliasSets.forEachMember(Root, [&](const llvm::Value *V) {
+      // Values without id cannot be serialized, same as in getAsJson()
+      if (auto Id = Ids.getId(V); Id != LLVMValueIds::InvalidId) {
+        Members.push_back(Id);
+      }
+    });
+    if (Members.size() != Offsets.back()) {
+      Offsets.push_back(Members.size());
+    }
+  });
+
+  std::vector<uint32_t> Fns;
+  Fns.reserve(AnalyzedFunctions.size());
+  for (const auto *F : AnalyzedFunctions) {
+    Fns.push_back(Ids.getFunctionId(F));
+  }
+  // Keep the output deterministic
+  std::sort(Fns.begin(), Fns.end());
+
+  BinaryHelperAnalysisWriter Writer(BinaryHelperAnalysisKind::AliasSet, Ids);
+  Writer.writeU32(Offsets.size() - 1);
+  Writer.writeU32Array(Members);
+  Writer.writeU32Array(Offsets);
+  Writer.writeU32Array(Fns);
+  Writer.emit(OS);
+}
+
 void LLVMAliasSet::print(llvm::raw_ostream &OS) const {
-  for (const auto &[V, PTS] : AliasSets) {
+  for (const auto *V : AliasSets.values()) {
     OS << "V: " << llvmIRToString(V) << '\n';
-    for (const auto &Ptr : *PTS) {
+    auto Root = AliasSets.findRoot(*AliasSets.lookup(V));
+    AliasSets.forEachMember(Root, [&OS](const llvm::Value *Ptr) {
       OS << "\tpoints to -> " << llvmIRToString(Ptr) << '\n';
-    }
+    });
   }
 }
 
@@ -754,16 +951,19 @@ void LLVMAliasSet::peakIntoAliasSet(const AliasSetMap::value_type &ValueSetPair,
 void LLVMAliasSet::drawAliasSetsDistribution(int Peak) const {
   std::vector<std::pair<size_t, unsigned>> SizeAmountPairs;
 
-  for (const auto &ValueSetPair : AliasSets) {
-    auto Search =
-        std::find_if(SizeAmountPairs.begin(), SizeAmountPairs.end(),
-                     [&ValueSetPair](const auto &Entry) {
-                       return Entry.first == ValueSetPair.second->size();
-                     });
+  auto SizeOf = [this](const llvm::Value *V) {
+    return AliasSets.getClassSize(AliasSets.findRoot(*AliasSets.lookup(V)));
+  };
+
+  for (const auto *V : AliasSets.values()) {
+    auto Size = SizeOf(V);
+    auto Search = std::find_if(
+        SizeAmountPairs.begin(), SizeAmountPairs.end(),
+        [Size](const auto &Entry) { return Entry.first == Size; });
     if (Search != SizeAmountPairs.end()) {
       Search->second++;
     } else {
-      SizeAmountPairs.emplace_back(ValueSetPair.second->size(), 1);
+      SizeAmountPairs.emplace_back(Size, 1);
     }
   }
 
@@ -788,10 +988,16 @@ void LLVMAliasSet::drawAliasSetsDistribution(int Peak) const {
   llvm::outs() << "\n";
 
   if (Peak) {
-    for (const auto &ValueSetPair : AliasSets) {
-      if (ValueSetPair.second->size() == SizeAmountPairs.back().first) {
+    for (const auto *V : AliasSets.values()) {
+      if (SizeOf(V) == SizeAmountPairs.back().first) {
         llvm::outs() << "Peak into one of the biggest points sets.\n";
-        peakIntoAliasSet(ValueSetPair, Peak);
+        AliasSetTy PTS;
+        AliasSets.forEachMember(AliasSets.findRoot(*AliasSets.lookup(V)),
+                                [&PTS](const llvm::Value *Alias) {
+                                  PTS.insert(Alias);
+                                });
+        auto *PTSPtr = &PTS;
+        peakIntoAliasSet({V, &PTSPtr}, Peak);
         return;
       }
     }
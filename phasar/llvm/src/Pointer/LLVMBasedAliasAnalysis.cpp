@@ -17,6 +17,7 @@
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/Analysis/AssumptionCache.h"
 #include "llvm/Analysis/BasicAliasAnalysis.h"
 #include "llvm/Analysis/CFLAndersAliasAnalysis.h"
 #include "llvm/Analysis/CFLSteensAliasAnalysis.h"
@@ -26,6 +27,7 @@
 #include "llvm/IR/BasicBlock.h"
 #include "llvm/IR/DataLayout.h"
 #include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
 #include "llvm/IR/Instruction.h"
 #include "llvm/IR/PassManager.h"
 #include "llvm/IR/Value.h"
@@ -103,6 +105,27 @@ void LLVMBasedAliasAnalysis::computeAliasInfo(llvm::Function &Fun) {
   AAInfos.insert(std::make_pair(&Fun, &AAR));
 }
 
+llvm::AAResults *
+LLVMBasedAliasAnalysis::getAAResultsForConcurrentQueries(llvm::Function *F) {
+  auto *AAR = getAAResults(F);
+  // BasicAA scans the function for assumptions when it first needs them
+  PImpl->FAM.getResult<llvm::AssumptionAnalysis>(*F).assumptions();
+  // The CFL analyses summarize the function on the first query that involves
+  // two different values of it
+  llvm::SmallVector<const llvm::Value *, 2> Ptrs;
+  auto AddPtr = [&Ptrs](const llvm::Value &V) {
+    if (Ptrs.size() < 2 && V.getType()->isPointerTy()) {
+      Ptrs.push_back(&V);
+    }
+  };
+  llvm::for_each(F->args(), AddPtr);
+  llvm::for_each(llvm::instructions(F), AddPtr);
+  if (Ptrs.size() == 2) {
+    AAR->alias(Ptrs[0], Ptrs[1]);
+  }
+  return AAR;
+}
+
 void LLVMBasedAliasAnalysis::erase(llvm::Function *F) noexcept {
   // after we clear all stuff, we need to set it up for the next function-wise
   // analysis
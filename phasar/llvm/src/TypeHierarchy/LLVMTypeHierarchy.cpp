@@ -18,12 +18,14 @@
 
 #include "phasar/Config/Configuration.h"
 #include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
+#include "phasar/PhasarLLVM/Utils/LLVMBinarySerialization.h"
 #include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
 #include "phasar/Utils/Logger.h"
 #include "phasar/Utils/NlohmannLogging.h"
 #include "phasar/Utils/PAMMMacros.h"
 #include "phasar/Utils/Utilities.h"
 
+#include "llvm/ADT/BitVector.h"
 #include "llvm/Demangle/Demangle.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/Function.h"
@@ -34,40 +36,32 @@
 #include "llvm/IR/Operator.h"
 #include "llvm/Support/Format.h"
 
-#include "boost/graph/graphviz.hpp"
-#include "boost/graph/transitive_closure.hpp"
-
 #include <algorithm>
 #include <cassert>
 #include <memory>
 #include <ostream>
+#include <unordered_map>
 
 using namespace std;
 
 namespace psr {
 
-// provide a VertexPropertyWrite to tell boost how to write a vertex
-class TypeHierarchyVertexWriter {
-public:
-  TypeHierarchyVertexWriter(const LLVMTypeHierarchy::bidigraph_t &TyGraph)
-      : TyGraph(TyGraph) {}
-  template <class VertexOrEdge>
-  void operator()(std::ostream &Out, const VertexOrEdge &V) const {
-    Out << "[label=\"" << TyGraph[V].getTypeName() << "\"]";
+struct LLVMTypeHierarchy::ClearNameMaps {
+  // helper map from clearname to type*
+  std::unordered_map<std::string, const llvm::StructType *> ClearNameTypeMap;
+  // map from clearname to type info variable
+  std::unordered_map<std::string, const llvm::GlobalVariable *> ClearNameTIMap;
+  // map from clearname to vtable variable
+  std::unordered_map<std::string, const llvm::GlobalVariable *> ClearNameTVMap;
+
+  template <typename MapTy>
+  [[nodiscard]] static typename MapTy::mapped_type
+  lookup(const MapTy &Map, const std::string &Key) {
+    auto It = Map.find(Key);
+    return It != Map.end() ? It->second : nullptr;
   }
-
-private:
-  const LLVMTypeHierarchy::bidigraph_t &TyGraph;
 };
 
-LLVMTypeHierarchy::VertexProperties::VertexProperties(
-    const llvm::StructType *Type)
-    : Type(Type), ReachableTypes({Type}) {}
-
-std::string LLVMTypeHierarchy::VertexProperties::getTypeName() const {
-  return Type->getStructName().str();
-}
-
 LLVMTypeHierarchy::LLVMTypeHierarchy(LLVMProjectIRDB &IRDB) {
   PHASAR_LOG_LEVEL(INFO, "Construct type hierarchy");
 
@@ -140,24 +134,15 @@ bool LLVMTypeHierarchy::isStruct(llvm::StringRef TypeName) {
 void LLVMTypeHierarchy::buildLLVMTypeHierarchy(const llvm::Module &M) {
   // build the hierarchy for the module
   constructHierarchy(M);
-  // cache the reachable types
-  bidigraph_t TC;
-  boost::transitive_closure(TypeGraph, TC);
-  for (auto V : boost::make_iterator_range(boost::vertices(TypeGraph))) {
-    for (auto OE : boost::make_iterator_range(boost::out_edges(V, TC))) {
-      auto Target = boost::target(OE, TC);
-      TypeGraph[V].ReachableTypes.insert(TypeGraph[Target].Type);
-    }
-  }
 }
 
 std::vector<const llvm::StructType *>
-LLVMTypeHierarchy::getSubTypes(const llvm::Module & /*M*/,
+LLVMTypeHierarchy::getSubTypes(const ClearNameMaps &Names,
                                const llvm::StructType &Type) {
   // find corresponding type info variable
   std::vector<const llvm::StructType *> SubTypes;
   std::string ClearName = removeStructOrClassPrefix(Type);
-  if (const auto *TI = ClearNameTIMap[ClearName]) {
+  if (const auto *TI = Names.lookup(Names.ClearNameTIMap, ClearName)) {
     if (!TI->hasInitializer()) {
       PHASAR_LOG_LEVEL_CAT(DEBUG, "LLVMTypeHierarchy",
                            ClearName << " does not have initializer");
@@ -173,7 +158,8 @@ LLVMTypeHierarchy::getSubTypes(const llvm::Module & /*M*/,
               if (Name.find(TypeInfoPrefix) != llvm::StringRef::npos) {
                 auto ClearName =
                     removeTypeInfoPrefix(llvm::demangle(Name.str()));
-                if (const auto *Type = ClearNameTypeMap[ClearName]) {
+                if (const auto *Type =
+                        Names.lookup(Names.ClearNameTypeMap, ClearName)) {
                   SubTypes.push_back(Type);
                 }
               }
@@ -187,11 +173,11 @@ LLVMTypeHierarchy::getSubTypes(const llvm::Module & /*M*/,
 }
 
 std::vector<const llvm::Function *>
-LLVMTypeHierarchy::getVirtualFunctions(const llvm::Module &M,
+LLVMTypeHierarchy::getVirtualFunctions(const ClearNameMaps &Names,
                                        const llvm::StructType &Type) {
   auto ClearName = removeStructOrClassPrefix(Type.getName().str());
   std::vector<const llvm::Function *> VFS;
-  if (const auto *TV = ClearNameTVMap[ClearName]) {
+  if (const auto *TV = Names.lookup(Names.ClearNameTVMap, ClearName)) {
     if (const auto *TI = llvm::dyn_cast<llvm::GlobalVariable>(TV)) {
       if (!TI->hasInitializer()) {
         PHASAR_LOG_LEVEL_CAT(DEBUG, "LLVMTypeHierarchy",
@@ -211,52 +197,194 @@ void LLVMTypeHierarchy::constructHierarchy(const llvm::Module &M) {
   PHASAR_LOG_LEVEL_CAT(DEBUG, "LLVMTypeHierarchy",
                        "Analyze types in module: " << M.getModuleIdentifier());
   // store analyzed module
-  VisitedModules.insert(&M);
-  auto StructTypes = M.getIdentifiedStructTypes();
-  // build helper maps
-  for (auto *StructType : StructTypes) {
-    ClearNameTypeMap[removeStructOrClassPrefix(*StructType)] = StructType;
-  }
-  for (const auto &Global : M.globals()) {
-    if (Global.hasName()) {
-      if (isTypeInfo(Global.getName().str())) {
-        auto Demang = llvm::demangle(Global.getName().str());
-        auto ClearName = removeTypeInfoPrefix(Demang);
-        ClearNameTIMap[ClearName] = &Global;
+  if (!llvm::is_contained(VisitedModules, &M)) {
+    VisitedModules.push_back(&M);
+  }
+
+  // The name maps are only needed for the construction; rebuild them for all
+  // modules, such that types can refer to types of previously analyzed modules
+  ClearNameMaps Names;
+  std::vector<const llvm::StructType *> AllTypes;
+  llvm::DenseMap<const llvm::StructType *, type_id_t> Indices;
+  for (const auto *Mod : VisitedModules) {
+    for (auto *StructType : Mod->getIdentifiedStructTypes()) {
+      Names.ClearNameTypeMap[removeStructOrClassPrefix(*StructType)] =
+          StructType;
+      if (Indices.try_emplace(StructType, AllTypes.size()).second) {
+        AllTypes.push_back(StructType);
       }
-      if (isVTable(Global.getName().str())) {
-        auto Demang = llvm::demangle(Global.getName().str());
-        auto ClearName = removeVTablePrefix(Demang);
-        ClearNameTVMap[ClearName] = &Global;
+    }
+    for (const auto &Global : Mod->globals()) {
+      if (Global.hasName()) {
+        if (isTypeInfo(Global.getName().str())) {
+          auto Demang = llvm::demangle(Global.getName().str());
+          auto ClearName = removeTypeInfoPrefix(Demang);
+          Names.ClearNameTIMap[ClearName] = &Global;
+        }
+        if (isVTable(Global.getName().str())) {
+          auto Demang = llvm::demangle(Global.getName().str());
+          auto ClearName = removeVTablePrefix(Demang);
+          Names.ClearNameTVMap[ClearName] = &Global;
+        }
       }
     }
   }
-  // iterate struct types and add vertices
-  for (auto *StructType : StructTypes) {
-    if (!TypeVertexMap.count(StructType)) {
-      auto Vertex = boost::add_vertex(TypeGraph);
-      TypeVertexMap[StructType] = Vertex;
-      TypeGraph[Vertex] = VertexProperties(StructType);
-      TypeVFTMap[StructType] = getVirtualFunctions(M, *StructType);
-    }
+
+  std::vector<LLVMVFTable> AllVFTs;
+  AllVFTs.reserve(AllTypes.size());
+  for (const auto *StructType : AllTypes) {
+    AllVFTs.push_back(LLVMVFTable(getVirtualFunctions(Names, *StructType)));
   }
+
   // construct the edges between a type and its subtypes
-  for (auto *StructType : StructTypes) {
+  std::vector<std::pair<type_id_t, type_id_t>> Edges;
+  for (const auto *StructType : AllTypes) {
     // use type information to check if it is really a subtype
-    auto SubTypes = getSubTypes(M, *StructType);
-    for (const auto *SubType : SubTypes) {
-      boost::add_edge(TypeVertexMap[SubType], TypeVertexMap[StructType],
-                      TypeGraph);
+    for (const auto *SuperType : getSubTypes(Names, *StructType)) {
+      if (auto It = Indices.find(SuperType); It != Indices.end()) {
+        Edges.emplace_back(It->second, Indices.lookup(StructType));
+      }
+    }
+  }
+
+  freeze(AllTypes, std::move(AllVFTs), Edges);
+}
+
+void LLVMTypeHierarchy::freeze(
+    llvm::ArrayRef<const llvm::StructType *> AllTypes,
+    std::vector<LLVMVFTable> AllVFTs,
+    llvm::ArrayRef<std::pair<type_id_t, type_id_t>> Edges) {
+  assert(AllTypes.size() == AllVFTs.size());
+
+  // The types with subtype relations come first, such that the closure only
+  // needs to cover them; otherwise, keep the order of AllTypes
+  llvm::BitVector InHierarchy(AllTypes.size());
+  for (auto [Type, SubType] : Edges) {
+    InHierarchy.set(Type);
+    InHierarchy.set(SubType);
+  }
+
+  std::vector<type_id_t> IdOf(AllTypes.size());
+  Types.clear();
+  Types.reserve(AllTypes.size());
+  for (bool Hierarchy : {true, false}) {
+    for (size_t Idx = 0, End = AllTypes.size(); Idx != End; ++Idx) {
+      if (InHierarchy.test(Idx) == Hierarchy) {
+        IdOf[Idx] = Types.size();
+        Types.push_back(AllTypes[Idx]);
+      }
+    }
+  }
+  NumHierarchyTypes = InHierarchy.count();
+
+  TypeIds.clear();
+  TypeIds.reserve(Types.size());
+  VFTs.assign(Types.size(), LLVMVFTable());
+  for (size_t Idx = 0, End = AllTypes.size(); Idx != End; ++Idx) {
+    TypeIds[AllTypes[Idx]] = IdOf[Idx];
+    VFTs[IdOf[Idx]] = std::move(AllVFTs[Idx]);
+  }
+
+  // Counting sort of the edges by their source
+  SubTypeOffsets.assign(Types.size() + 1, 0);
+  for (auto [Type, SubType] : Edges) {
+    ++SubTypeOffsets[IdOf[Type] + 1];
+  }
+  for (size_t Id = 0, End = Types.size(); Id != End; ++Id) {
+    SubTypeOffsets[Id + 1] += SubTypeOffsets[Id];
+  }
+  DirectSubTypes.resize(Edges.size());
+  auto Pos = SubTypeOffsets;
+  for (auto [Type, SubType] : Edges) {
+    DirectSubTypes[Pos[IdOf[Type]]++] = IdOf[SubType];
+  }
+
+  // Remove duplicate edges
+  size_t NumEdges = 0;
+  for (size_t Id = 0, End = Types.size(); Id != End; ++Id) {
+    auto *Begin = DirectSubTypes.data() + SubTypeOffsets[Id];
+    auto *RowEnd = DirectSubTypes.data() + SubTypeOffsets[Id + 1];
+    std::sort(Begin, RowEnd);
+    SubTypeOffsets[Id] = NumEdges;
+    for (auto *It = Begin; It != RowEnd; ++It) {
+      if (It == Begin || *It != It[-1]) {
+        DirectSubTypes[NumEdges++] = *It;
+      }
+    }
+  }
+  SubTypeOffsets.back() = NumEdges;
+  DirectSubTypes.resize(NumEdges);
+  DirectSubTypes.shrink_to_fit();
+
+  computeClosure();
+}
+
+void LLVMTypeHierarchy::computeClosure() {
+  WordsPerRow = (NumHierarchyTypes + 63) / 64;
+  Closure.assign(NumHierarchyTypes * WordsPerRow, 0);
+  for (size_t Id = 0; Id != NumHierarchyTypes; ++Id) {
+    Closure[Id * WordsPerRow + Id / 64] |= uint64_t(1) << (Id % 64);
+  }
+
+  // Merge the rows of the subtypes into their supertypes in post-order. Class
+  // hierarchies are acyclic, so a single pass suffices; should there be a
+  // cycle nevertheless, repeat until nothing changes anymore
+  enum class State : uint8_t { Unvisited, OnStack, Done };
+  std::vector<State> States(NumHierarchyTypes, State::Unvisited);
+  llvm::SmallVector<std::pair<type_id_t, size_t>> Stack;
+  llvm::SmallVector<type_id_t, 0> PostOrder;
+  PostOrder.reserve(NumHierarchyTypes);
+  bool HasCycle = false;
+
+  for (type_id_t Root = 0; Root != NumHierarchyTypes; ++Root) {
+    if (States[Root] != State::Unvisited) {
+      continue;
+    }
+    States[Root] = State::OnStack;
+    Stack.emplace_back(Root, 0);
+    while (!Stack.empty()) {
+      auto &[Id, NextSucc] = Stack.back();
+      auto Succs = getDirectSubTypeIds(Id);
+      if (NextSucc == Succs.size()) {
+        States[Id] = State::Done;
+        PostOrder.push_back(Id);
+        Stack.pop_back();
+        continue;
+      }
+      auto Succ = Succs[NextSucc++];
+      if (States[Succ] == State::Unvisited) {
+        States[Succ] = State::OnStack;
+        Stack.emplace_back(Succ, 0);
+      } else if (States[Succ] == State::OnStack) {
+        HasCycle = true;
+      }
     }
   }
+
+  bool Changed;
+  do {
+    Changed = false;
+    for (auto Id : PostOrder) {
+      auto *Row = &Closure[Id * WordsPerRow];
+      for (auto Succ : getDirectSubTypeIds(Id)) {
+        const auto *SuccRow = getClosureRow(Succ);
+        for (size_t Word = 0; Word != WordsPerRow; ++Word) {
+          auto Merged = Row[Word] | SuccRow[Word];
+          Changed |= Merged != Row[Word];
+          Row[Word] = Merged;
+        }
+      }
+    }
+  } while (HasCycle && Changed);
 }
 
 std::set<const llvm::StructType *>
 LLVMTypeHierarchy::getSubTypes(const llvm::StructType *Type) {
-  if (TypeVertexMap.count(Type)) {
-    return TypeGraph[TypeVertexMap[Type]].ReachableTypes;
-  }
-  return {};
+  std::set<const llvm::StructType *> ReachableTypes;
+  forEachSubType(Type, [&ReachableTypes](const llvm::StructType *SubType) {
+    ReachableTypes.insert(SubType);
+  });
+  return ReachableTypes;
 }
 
 std::set<const llvm::StructType *>
@@ -267,20 +395,16 @@ LLVMTypeHierarchy::getSuperTypes(const llvm::StructType * /*Type*/) {
 }
 
 const llvm::StructType *LLVMTypeHierarchy::getType(std::string TypeName) const {
-  for (auto V : boost::make_iterator_range(boost::vertices(TypeGraph))) {
-    if (TypeGraph[V].Type->getName() == TypeName) {
-      return TypeGraph[V].Type;
+  for (const auto *Type : Types) {
+    if (Type->getName() == TypeName) {
+      return Type;
     }
   }
   return nullptr;
 }
 
 std::set<const llvm::StructType *> LLVMTypeHierarchy::getAllTypes() const {
-  std::set<const llvm::StructType *> Types;
-  for (auto V : boost::make_iterator_range(boost::vertices(TypeGraph))) {
-    Types.insert(TypeGraph[V].Type);
-  }
-  return Types;
+  return {Types.begin(), Types.end()};
 }
 
 std::string LLVMTypeHierarchy::getTypeName(const llvm::StructType *Type) const {
@@ -288,40 +412,33 @@ std::string LLVMTypeHierarchy::getTypeName(const llvm::StructType *Type) const {
 }
 
 bool LLVMTypeHierarchy::hasVFTable(const llvm::StructType *Type) const {
-  if (TypeVFTMap.count(Type)) {
-    return !TypeVFTMap.at(Type).empty();
+  if (auto Id = getTypeId(Type)) {
+    return !VFTs[*Id].empty();
   }
   return false;
 }
 
 const LLVMVFTable *
 LLVMTypeHierarchy::getVFTable(const llvm::StructType *Type) const {
-  if (TypeVFTMap.count(Type)) {
-    return &TypeVFTMap.at(Type);
+  if (auto Id = getTypeId(Type)) {
+    return &VFTs[*Id];
   }
   return nullptr;
 }
 
 void LLVMTypeHierarchy::print(llvm::raw_ostream &OS) const {
   OS << "Type Hierarchy:\n";
-  vertex_iterator UI;
-
-  vertex_iterator UIEnd;
-  for (boost::tie(UI, UIEnd) = boost::vertices(TypeGraph); UI != UIEnd; ++UI) {
-    OS << TypeGraph[*UI].getTypeName() << " --> ";
-    out_edge_iterator EI;
-
-    out_edge_iterator EIEnd;
-    for (boost::tie(EI, EIEnd) = boost::out_edges(*UI, TypeGraph); EI != EIEnd;
-         ++EI) {
-      OS << TypeGraph[target(*EI, TypeGraph)].getTypeName() << " ";
+  for (type_id_t Id = 0, End = Types.size(); Id != End; ++Id) {
+    OS << getTypeName(Types[Id]) << " --> ";
+    for (auto SubId : getDirectSubTypeIds(Id)) {
+      OS << getTypeName(Types[SubId]) << " ";
     }
     OS << '\n';
   }
   OS << "VFTables:\n";
-  for (const auto &[Ty, VFT] : TypeVFTMap) {
-    OS << "Virtual function table for: " << Ty->getName() << '\n';
-    for (const auto *F : VFT) {
+  for (type_id_t Id = 0, End = Types.size(); Id != End; ++Id) {
+    OS << "Virtual function table for: " << Types[Id]->getName() << '\n';
+    for (const auto *F : VFTs[Id]) {
       OS << "\t-" << F->getName() << '\n';
     }
   }
@@ -329,22 +446,13 @@ void LLVMTypeHierarchy::print(llvm::raw_ostream &OS) const {
 
 nlohmann::json LLVMTypeHierarchy::getAsJson() const {
   nlohmann::json J;
-  vertex_iterator VIv;
-
-  vertex_iterator VIvEnd;
-  out_edge_iterator EI;
-
-  out_edge_iterator EIEnd;
-  // iterate all graph vertices
-  for (boost::tie(VIv, VIvEnd) = boost::vertices(TypeGraph); VIv != VIvEnd;
-       ++VIv) {
-    J[PhasarConfig::JsonTypeHierarchyID().str()][TypeGraph[*VIv].getTypeName()];
-    // iterate all out edges of vertex vi_v
-    for (boost::tie(EI, EIEnd) = boost::out_edges(*VIv, TypeGraph); EI != EIEnd;
-         ++EI) {
-      J[PhasarConfig::JsonTypeHierarchyID().str()]
-       [TypeGraph[*VIv].getTypeName()] +=
-          TypeGraph[boost::target(*EI, TypeGraph)].getTypeName();
+  auto &JTypes = J[PhasarConfig::JsonTypeHierarchyID().str()];
+  // iterate all types
+  for (type_id_t Id = 0, End = Types.size(); Id != End; ++Id) {
+    auto &JSubTypes = JTypes[getTypeName(Types[Id])];
+    // iterate all direct subtypes
+    for (auto SubId : getDirectSubTypeIds(Id)) {
+      JSubTypes += getTypeName(Types[SubId]);
     }
   }
   return J;
@@ -397,15 +505,130 @@ nlohmann::json LLVMTypeHierarchy::getAsJson() const {
 // }
 
 void LLVMTypeHierarchy::printAsDot(llvm::raw_ostream &OS) const {
-  std::stringstream S;
-  boost::write_graphviz(S, TypeGraph, TypeHierarchyVertexWriter(TypeGraph));
-  OS << S.str();
+  OS << "digraph G {\n";
+  for (type_id_t Id = 0, End = Types.size(); Id != End; ++Id) {
+    OS << Id << "[label=\"" << getTypeName(Types[Id]) << "\"];\n";
+  }
+  for (type_id_t Id = 0, End = Types.size(); Id != End; ++Id) {
+    for (auto SubId : getDirectSubTypeIds(Id)) {
+      OS << Id << "->" << SubId << " ;\n";
+    }
+  }
+  OS << "}\n";
 }
 
 void LLVMTypeHierarchy::printAsJson(llvm::raw_ostream &OS) const {
   OS << getAsJson();
 }
 
+void LLVMTypeHierarchy::writeBinary(const LLVMProjectIRDB &IRDB,
+                                    llvm::raw_ostream &OS) const {
+  LLVMValueIds Ids(IRDB);
+  BinaryHelperAnalysisWriter Writer(BinaryHelperAnalysisKind::TypeHierarchy,
+                                    Ids);
+
+  // The transitive closure is not persisted; it is cheaper to recompute it
+  // from the direct subtypes than to read it
+  Writer.writeU32(Types.size());
+  for (const auto *Type : Types) {
+    Writer.writeString(Type->getName());
+  }
+
+  Writer.writeU32Array(DirectSubTypes);
+  Writer.writeU32Array(SubTypeOffsets);
+
+  std::vector<uint32_t> VFTFunctions;
+  std::vector<uint32_t> VFTOffsets = {0};
+  VFTOffsets.reserve(VFTs.size() + 1);
+  for (const auto &VFT : VFTs) {
+    for (const auto *F : VFT) {
+      VFTFunctions.push_back(F ? Ids.getFunctionId(F)
+                               : LLVMValueIds::InvalidId);
+    }
+    VFTOffsets.push_back(VFTFunctions.size());
+  }
+  Writer.writeU32Array(VFTFunctions);
+  Writer.writeU32Array(VFTOffsets);
+
+  Writer.emit(OS);
+}
+
+std::unique_ptr<LLVMTypeHierarchy>
+LLVMTypeHierarchy::loadBinary(const LLVMProjectIRDB &IRDB,
+                              llvm::MemoryBufferRef Buf) {
+  PHASAR_LOG_LEVEL_CAT(INFO, "LLVMTypeHierarchy",
+                       "Load type hierarchy from binary");
+  const auto *M = IRDB.getModule();
+  LLVMValueIds Ids(IRDB);
+  BinaryHelperAnalysisReader Reader(
+      Buf, BinaryHelperAnalysisKind::TypeHierarchy, Ids);
+
+  auto NumTypes = Reader.readU32();
+  std::vector<const llvm::StructType *> Types;
+  Types.reserve(std::min<size_t>(NumTypes, Buf.getBufferSize()));
+  for (size_t Idx = 0; Reader && Idx != NumTypes; ++Idx) {
+    auto Name = Reader.readString();
+    const auto *Type = llvm::StructType::getTypeByName(M->getContext(), Name);
+    if (!Type) {
+      Reader.fail("Unknown struct type '" + Name + "'");
+      return nullptr;
+    }
+    Types.push_back(Type);
+  }
+
+  auto ReadAdjacency = [&Reader, NumTypes](auto AddSuccessor) {
+    auto Succs = Reader.readU32Array();
+    auto Offsets = Reader.readOffsets(NumTypes, Succs.size());
+    for (size_t V = 0; Reader && V != NumTypes; ++V) {
+      for (uint32_t Succ :
+           Succs.slice(Offsets[V], Offsets[V + 1] - Offsets[V])) {
+        if (!AddSuccessor(V, Succ)) {
+          Reader.fail("Invalid successor " + llvm::Twine(Succ));
+          return;
+        }
+      }
+    }
+  };
+
+  std::vector<std::pair<type_id_t, type_id_t>> Edges;
+  ReadAdjacency([&](type_id_t V, uint32_t Succ) {
+    if (Succ >= NumTypes) {
+      return false;
+    }
+    Edges.emplace_back(V, Succ);
+    return true;
+  });
+  std::vector<std::vector<const llvm::Function *>> VFTs(Types.size());
+  ReadAdjacency([&](type_id_t V, uint32_t FunId) {
+    const auto *F = Ids.getFunction(FunId);
+    if (!F && FunId != LLVMValueIds::InvalidId) {
+      return false;
+    }
+    VFTs[V].push_back(F);
+    return true;
+  });
+
+  if (!Reader) {
+    return nullptr;
+  }
+  if (!Reader.atEnd()) {
+    Reader.fail("Unexpected trailing data");
+    return nullptr;
+  }
+
+  std::vector<LLVMVFTable> AllVFTs;
+  AllVFTs.reserve(VFTs.size());
+  for (auto &VFT : VFTs) {
+    AllVFTs.push_back(LLVMVFTable(std::move(VFT)));
+  }
+
+  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory) -- protected ctor
+  std::unique_ptr<LLVMTypeHierarchy> Ret(new LLVMTypeHierarchy());
+  Ret->freeze(Types, std::move(AllVFTs), Edges);
+  Ret->VisitedModules.push_back(M);
+  return Ret;
+}
+
 // void LLVMTypeHierarchy::printGraphAsDot(ostream &out) {
 //   boost::dynamic_properties dp;
 //   dp.property("node_id", get(&LLVMTypeHierarchy::VertexProperties::name,
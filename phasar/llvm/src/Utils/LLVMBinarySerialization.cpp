@@ -0,0 +1,257 @@
+/******************************************************************************
+ * Copyright (c) 2023 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#include "phasar/PhasarLLVM/Utils/LLVMBinarySerialization.h"
+
+#include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
+#include "phasar/Utils/Logger.h"
+
+#include "llvm/IR/Argument.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace psr {
+
+static constexpr char Magic[8] = {'P', 'S', 'R', 'H', 'E', 'L', 'P', '\0'};
+static constexpr size_t HeaderSize = 32;
+
+template <typename T> static void appendInt(std::string &Out, T Value) {
+  char Buf[sizeof(T)];
+  llvm::support::endian::write<T, llvm::support::little,
+                               llvm::support::unaligned>(Buf, Value);
+  Out.append(Buf, sizeof(T));
+}
+
+template <typename T>
+[[nodiscard]] static T readInt(const char *Data, size_t Offset) {
+  return llvm::support::endian::read<T, llvm::support::little,
+                                     llvm::support::unaligned>(Data + Offset);
+}
+
+LLVMValueIds::LLVMValueIds(const LLVMProjectIRDB &IRDB) : IRDB(&IRDB) {
+  const auto *Mod = IRDB.getModule();
+  assert(Mod != nullptr);
+
+  // The fingerprint covers the shape of the module that the ids depend on
+  std::string Shape;
+  appendInt<uint64_t>(Shape, IRDB.getNumValueIds());
+  appendInt<uint64_t>(Shape, IRDB.getNumGlobals());
+
+  FunBase = IRDB.getNumValueIds();
+  Functions.reserve(Mod->size());
+  FunIds.reserve(Mod->size());
+  ArgBegin.reserve(Mod->size() + 1);
+
+  uint32_t NumArgs = 0;
+  for (const auto &F : *Mod) {
+    FunIds.try_emplace(&F, Functions.size());
+    Functions.push_back(&F);
+    ArgBegin.push_back(NumArgs);
+    NumArgs += F.arg_size();
+
+    Shape += F.getName();
+    Shape.push_back('\0');
+    appendInt<uint32_t>(Shape, F.arg_size());
+  }
+  ArgBegin.push_back(NumArgs);
+  ArgBase = FunBase + Functions.size();
+
+  for (const auto &G : Mod->globals()) {
+    Shape += G.getName();
+    Shape.push_back('\0');
+  }
+
+  Fingerprint = llvm::xxHash64(Shape);
+}
+
+uint32_t LLVMValueIds::getId(const llvm::Value *V) const {
+  if (const auto *F = llvm::dyn_cast<llvm::Function>(V)) {
+    auto FunId = getFunctionId(F);
+    return FunId == InvalidId ? InvalidId : FunBase + FunId;
+  }
+  if (const auto *Arg = llvm::dyn_cast<llvm::Argument>(V)) {
+    auto FunId = getFunctionId(Arg->getParent());
+    return FunId == InvalidId ? InvalidId
+                              : ArgBase + ArgBegin[FunId] + Arg->getArgNo();
+  }
+  if (auto Id = IRDB->getValueId(V)) {
+    return *Id;
+  }
+  return InvalidId;
+}
+
+const llvm::Value *LLVMValueIds::getValue(uint32_t Id) const noexcept {
+  if (Id < FunBase) {
+    return IRDB->getValueFromId(Id);
+  }
+  if (Id < ArgBase) {
+    return Functions[Id - FunBase];
+  }
+
+  auto ArgIdx = Id - ArgBase;
+  if (ArgIdx >= ArgBegin.back()) {
+    return nullptr;
+  }
+  // The function whose arguments start at or before ArgIdx; functions without
+  // arguments share their start with the next function, so take the last one
+  auto It = std::upper_bound(ArgBegin.begin(), ArgBegin.end(), ArgIdx);
+  auto FunId = std::distance(ArgBegin.begin(), It) - 1;
+  return Functions[FunId]->getArg(ArgIdx - *std::prev(It));
+}
+
+uint32_t LLVMValueIds::getFunctionId(const llvm::Function *F) const {
+  if (auto It = FunIds.find(F); It != FunIds.end()) {
+    return It->second;
+  }
+  return InvalidId;
+}
+
+void BinaryHelperAnalysisWriter::writeU32(uint32_t Value) {
+  appendInt<uint32_t>(Payload, Value);
+}
+
+void BinaryHelperAnalysisWriter::writeU32Array(
+    llvm::ArrayRef<uint32_t> Values) {
+  Payload.reserve(Payload.size() + (Values.size() + 1) * sizeof(uint32_t));
+  writeU32(Values.size());
+  for (auto Value : Values) {
+    writeU32(Value);
+  }
+}
+
+void BinaryHelperAnalysisWriter::writeString(llvm::StringRef Str) {
+  writeU32(Str.size());
+  Payload += Str;
+  Payload.resize((Payload.size() + 3) & ~size_t(3));
+}
+
+void BinaryHelperAnalysisWriter::emit(llvm::raw_ostream &OS) const {
+  std::string Header(Magic, sizeof(Magic));
+  appendInt<uint32_t>(Header, Version);
+  appendInt<uint32_t>(Header, uint32_t(Kind));
+  appendInt<uint64_t>(Header, Fingerprint);
+  appendInt<uint64_t>(Header, Payload.size());
+  assert(Header.size() == HeaderSize);
+
+  OS << Header << Payload;
+}
+
+BinaryHelperAnalysisReader::BinaryHelperAnalysisReader(
+    llvm::MemoryBufferRef Buf, BinaryHelperAnalysisKind Kind,
+    const LLVMValueIds &Ids)
+    : BufferId(Buf.getBufferIdentifier()) {
+  const char *Start = Buf.getBufferStart();
+  size_t BufSize = Buf.getBufferSize();
+
+  if (BufSize < HeaderSize || std::memcmp(Start, Magic, sizeof(Magic)) != 0) {
+    fail("Not a binary helper-analysis file");
+    return;
+  }
+  if (readInt<uint32_t>(Start, 8) != BinaryHelperAnalysisWriter::Version) {
+    fail("Unsupported version " + llvm::Twine(readInt<uint32_t>(Start, 8)));
+    return;
+  }
+  if (readInt<uint32_t>(Start, 12) != uint32_t(Kind)) {
+    fail("The file contains a different helper analysis");
+    return;
+  }
+  if (readInt<uint64_t>(Start, 16) != Ids.getModuleFingerprint()) {
+    fail("The file has been computed on a different module");
+    return;
+  }
+  if (readInt<uint64_t>(Start, 24) != BufSize - HeaderSize) {
+    fail("The file is truncated");
+    return;
+  }
+
+  Data = Start + HeaderSize;
+  Size = BufSize - HeaderSize;
+  Valid = true;
+}
+
+const char *BinaryHelperAnalysisReader::consume(size_t NumBytes) {
+  if (!Valid) {
+    return nullptr;
+  }
+  if (Size - Pos < NumBytes) {
+    fail("Unexpected end of file");
+    return nullptr;
+  }
+  const auto *Ret = Data + Pos;
+  Pos += NumBytes;
+  return Ret;
+}
+
+uint32_t BinaryHelperAnalysisReader::readU32() {
+  if (const auto *Ptr = consume(sizeof(uint32_t))) {
+    return readInt<uint32_t>(Ptr, 0);
+  }
+  return 0;
+}
+
+auto BinaryHelperAnalysisReader::readU32Array() -> u32_array_t {
+  size_t Len = readU32();
+  if (Len > (Size - Pos) / sizeof(uint32_t)) {
+    fail("Array exceeds the end of file");
+    return {};
+  }
+  if (const auto *Ptr = consume(Len * sizeof(uint32_t))) {
+    return {reinterpret_cast<const llvm::support::ulittle32_t *>(Ptr), Len};
+  }
+  return {};
+}
+
+llvm::StringRef BinaryHelperAnalysisReader::readString() {
+  size_t Len = readU32();
+  if (Len > Size - Pos) {
+    fail("String exceeds the end of file");
+    return {};
+  }
+  if (const auto *Ptr = consume((Len + 3) & ~size_t(3))) {
+    return {Ptr, Len};
+  }
+  return {};
+}
+
+auto BinaryHelperAnalysisReader::readOffsets(size_t N, size_t NumElements)
+    -> u32_array_t {
+  auto Offsets = readU32Array();
+  if (!Valid) {
+    return {};
+  }
+  if (Offsets.size() != N + 1 || Offsets.front() != 0 ||
+      Offsets.back() != NumElements) {
+    fail("Inconsistent offsets");
+    return {};
+  }
+  for (size_t I = 1; I < Offsets.size(); ++I) {
+    if (Offsets[I - 1] > Offsets[I]) {
+      fail("Offsets are not monotonic");
+      return {};
+    }
+  }
+  return Offsets;
+}
+
+void BinaryHelperAnalysisReader::fail(const llvm::Twine &Reason) {
+  if (Valid || Data == nullptr) {
+    PHASAR_LOG_LEVEL_CAT(WARNING, "BinaryHelperAnalysisReader",
+                         "Invalid binary helper-analysis file '"
+                             << BufferId << "': " << Reason.str());
+  }
+  Valid = false;
+}
+
+} // namespace psr
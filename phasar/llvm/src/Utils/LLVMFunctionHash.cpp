@@ -0,0 +1,132 @@
+/******************************************************************************
+ * Copyright (c) 2023 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#include "phasar/PhasarLLVM/Utils/LLVMFunctionHash.h"
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/IR/Constant.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalValue.h"
+#include "llvm/IR/InlineAsm.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/Metadata.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+
+#include <string>
+
+namespace psr {
+
+namespace {
+
+/// Writes a canonical textual representation of a function into a string.
+/// Local values are referred to by their position in the function.
+class FunctionHasher {
+public:
+  explicit FunctionHasher(const llvm::Function &F) {
+    for (const auto &Arg : F.args()) {
+      Ids.try_emplace(&Arg, Ids.size());
+    }
+    for (const auto &BB : F) {
+      Ids.try_emplace(&BB, Ids.size());
+    }
+    for (const auto &Inst : llvm::instructions(F)) {
+      Ids.try_emplace(&Inst, Ids.size());
+    }
+  }
+
+  uint64_t hash(const llvm::Function &F) {
+    OS << F.getName() << ' ' << F.getCallingConv() << ' ';
+    F.getFunctionType()->print(OS);
+    for (const auto &BB : F) {
+      OS << "\nbb" << Ids.lookup(&BB) << ':';
+      for (const auto &Inst : BB) {
+        writeInstruction(Inst);
+      }
+    }
+    return llvm::xxHash64(OS.str());
+  }
+
+private:
+  void writeValue(const llvm::Value *V) {
+    if (Ids.count(V)) {
+      OS << '%' << Ids.lookup(V);
+    } else if (const auto *Glob = llvm::dyn_cast<llvm::GlobalValue>(V)) {
+      OS << '@' << Glob->getName();
+    } else if (llvm::isa<llvm::MetadataAsValue>(V)) {
+      // Debug information does not influence the semantics
+      OS << "metadata";
+    } else if (llvm::isa<llvm::Constant>(V) || llvm::isa<llvm::InlineAsm>(V)) {
+      V->print(OS);
+    } else {
+      OS << '?';
+    }
+  }
+
+  void writeInstruction(const llvm::Instruction &Inst) {
+    OS << "\n  " << Inst.getOpcodeName() << ' ';
+    Inst.getType()->print(OS);
+    OS << " [" << Inst.getRawSubclassOptionalData() << ']';
+
+    if (const auto *Cmp = llvm::dyn_cast<llvm::CmpInst>(&Inst)) {
+      OS << ' ' << Cmp->getPredicate();
+    } else if (const auto *Alloca = llvm::dyn_cast<llvm::AllocaInst>(&Inst)) {
+      OS << ' ';
+      Alloca->getAllocatedType()->print(OS);
+    } else if (const auto *Gep =
+                   llvm::dyn_cast<llvm::GetElementPtrInst>(&Inst)) {
+      OS << ' ';
+      Gep->getSourceElementType()->print(OS);
+    } else if (const auto *Load = llvm::dyn_cast<llvm::LoadInst>(&Inst)) {
+      OS << ' ' << Load->isVolatile() << int(Load->getOrdering());
+    } else if (const auto *Store = llvm::dyn_cast<llvm::StoreInst>(&Inst)) {
+      OS << ' ' << Store->isVolatile() << int(Store->getOrdering());
+    } else if (const auto *Call = llvm::dyn_cast<llvm::CallBase>(&Inst)) {
+      OS << ' ' << Call->getCallingConv() << ' ';
+      Call->getFunctionType()->print(OS);
+    } else if (const auto *Phi = llvm::dyn_cast<llvm::PHINode>(&Inst)) {
+      for (const auto *Incoming : Phi->blocks()) {
+        OS << " bb" << Ids.lookup(Incoming);
+      }
+    } else if (const auto *Extract =
+                   llvm::dyn_cast<llvm::ExtractValueInst>(&Inst)) {
+      for (auto Idx : Extract->getIndices()) {
+        OS << ' ' << Idx;
+      }
+    } else if (const auto *Insert =
+                   llvm::dyn_cast<llvm::InsertValueInst>(&Inst)) {
+      for (auto Idx : Insert->getIndices()) {
+        OS << ' ' << Idx;
+      }
+    } else if (const auto *Shuffle =
+                   llvm::dyn_cast<llvm::ShuffleVectorInst>(&Inst)) {
+      for (auto Idx : Shuffle->getShuffleMask()) {
+        OS << ' ' << Idx;
+      }
+    }
+
+    for (const auto &Op : Inst.operands()) {
+      OS << ", ";
+      writeValue(Op.get());
+    }
+  }
+
+  llvm::DenseMap<const llvm::Value *, size_t> Ids;
+  std::string Buffer;
+  llvm::raw_string_ostream OS{Buffer};
+};
+
+} // namespace
+
+uint64_t computeFunctionHash(const llvm::Function &F) {
+  return FunctionHasher(F).hash(F);
+}
+
+} // namespace psr
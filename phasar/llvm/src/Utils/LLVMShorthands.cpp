@@ -164,6 +164,10 @@ llvm::ModuleSlotTracker &getModuleSlotTrackerFor(const llvm::Value *V) {
   return ModulesToSlotTracker::getSlotTrackerForModule(M);
 }
 
+// The cached ModuleSlotTrackers are modified while printing, so they must not
+// be used by multiple threads at the same time
+static std::mutex PrintMx;
+
 std::string llvmIRToString(const llvm::Value *V) {
   if (!V) {
     return "<null>";
@@ -171,7 +175,10 @@ std::string llvmIRToString(const llvm::Value *V) {
 
   std::string IRBuffer;
   llvm::raw_string_ostream RSO(IRBuffer);
-  V->print(RSO, getModuleSlotTrackerFor(V));
+  {
+    std::lock_guard Lck(PrintMx);
+    V->print(RSO, getModuleSlotTrackerFor(V));
+  }
   RSO << " | ID: " << getMetaDataID(V);
   RSO.flush();
   return llvm::StringRef(IRBuffer).ltrim().str();
@@ -183,7 +190,10 @@ std::string llvmIRToStableString(const llvm::Value *V) {
   }
   std::string IRBuffer;
   llvm::raw_string_ostream RSO(IRBuffer);
-  V->print(RSO, getModuleSlotTrackerFor(V));
+  {
+    std::lock_guard Lck(PrintMx);
+    V->print(RSO, getModuleSlotTrackerFor(V));
+  }
   RSO.flush();
 
   auto IRBufferRef = llvm::StringRef(IRBuffer).ltrim();
@@ -210,6 +220,7 @@ std::string llvmIRToShortString(const llvm::Value *V) {
   }
   std::string IRBuffer;
   llvm::raw_string_ostream RSO(IRBuffer);
+  std::unique_lock Lck(PrintMx);
   if (const auto *I = llvm::dyn_cast<llvm::Instruction>(V);
       I && !I->getType()->isVoidTy()) {
     V->printAsOperand(RSO, true, getModuleSlotTrackerFor(V));
@@ -218,6 +229,7 @@ std::string llvmIRToShortString(const llvm::Value *V) {
   } else {
     V->print(RSO, getModuleSlotTrackerFor(V));
   }
+  Lck.unlock();
   RSO << " | ID: " << getMetaDataID(V);
   RSO.flush();
   return llvm::StringRef(IRBuffer).ltrim().str();
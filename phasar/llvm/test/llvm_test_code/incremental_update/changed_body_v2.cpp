@@ -0,0 +1,11 @@
+int increment(int a) { return a + 2; }
+
+int compute(int a) { return increment(a) * 2; }
+
+int constant() { return 42; }
+
+int main() {
+  int i = constant();
+  int j = compute(i);
+  return 0;
+}
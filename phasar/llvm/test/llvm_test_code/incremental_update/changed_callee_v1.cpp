@@ -0,0 +1,12 @@
+int add_one(int a) { return a + 1; }
+
+int add_two(int a) { return a + 2; }
+
+int (*Op)(int) = add_one;
+
+int apply(int a) { return Op(a); }
+
+int main() {
+  int i = apply(40);
+  return 0;
+}
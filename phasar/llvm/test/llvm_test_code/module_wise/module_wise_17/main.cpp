@@ -0,0 +1,8 @@
+#include "src1.h"
+
+int twice(int i) { return 2 * i; }
+
+int main() {
+  int i = apply(20);
+  return 0;
+}
@@ -0,0 +1,4 @@
+#include "src1.h"
+
+// calls back into the module of main()
+int apply(int i) { return twice(i) + 2; }
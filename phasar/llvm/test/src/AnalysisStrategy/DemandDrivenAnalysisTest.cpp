@@ -0,0 +1,179 @@
+#include "phasar/AnalysisStrategy/DemandDrivenAnalysis.h"
+
+#include "phasar/DataFlow/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/HelperAnalyses.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMAliasSet.h"
+#include "phasar/PhasarLLVM/SimpleAnalysisConstructor.h"
+#include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+
+#include "TestConfig.h"
+#include "gtest/gtest.h"
+
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace psr;
+
+namespace {
+
+using n_t = IDELinearConstantAnalysis::n_t;
+using d_t = IDELinearConstantAnalysis::d_t;
+using l_t = IDELinearConstantAnalysis::l_t;
+
+/* ============== TEST FIXTURE ============== */
+
+class DemandDrivenAnalysisTest : public ::testing::Test {
+protected:
+  static constexpr auto PathToLlFiles =
+      PHASAR_BUILD_SUBFOLDER("linear_constant/");
+  const std::vector<std::string> EntryPoints = {"main"};
+
+  std::optional<HelperAnalyses> HA;
+
+  void initialize(const llvm::Twine &IRFile) {
+    ValueAnnotationPass::resetValueID();
+    HA.emplace(PathToLlFiles + IRFile, EntryPoints);
+  }
+
+  [[nodiscard]] const llvm::Function *getFunction(llvm::StringRef Name) {
+    return HA->getProjectIRDB().getFunctionDefinition(Name);
+  }
+
+  [[nodiscard]] const llvm::Instruction *
+  getFirstCallTo(const llvm::Function *Fun, llvm::StringRef CalleeName) {
+    for (const auto &Inst : llvm::instructions(Fun)) {
+      const auto *Call = llvm::dyn_cast<llvm::CallBase>(&Inst);
+      if (Call && Call->getCalledFunction() &&
+          Call->getCalledFunction()->getName() == CalleeName) {
+        return Call;
+      }
+    }
+    return nullptr;
+  }
+
+  /// Compares the results at all memoized statements with the results of a
+  /// whole-program solve.
+  void compareWithPlainSolve(
+      DemandDrivenAnalysis<IDELinearConstantAnalysisDomain> &DDA,
+      SolverResults<n_t, d_t, l_t> Plain) {
+    for (const auto *Fun : HA->getProjectIRDB().getAllFunctions()) {
+      for (const auto &Inst : llvm::instructions(Fun)) {
+        if (!DDA.isMemoized(&Inst)) {
+          continue;
+        }
+        const auto &Expected = Plain.resultsAt(&Inst);
+        EXPECT_EQ(Expected, DDA.resultsAt(&Inst))
+            << "At " << llvmIRToString(&Inst);
+        for (const auto &[Fact, Value] : Expected) {
+          EXPECT_TRUE(DDA.holdsAt(&Inst, Fact));
+          EXPECT_EQ(Value, DDA.resultAt(&Inst, Fact));
+        }
+      }
+    }
+  }
+}; // Test Fixture
+
+TEST_F(DemandDrivenAnalysisTest, MatchesWholeProgramSolve) {
+  initialize("call_11.dbg.ll");
+  auto Problem =
+      createAnalysisProblem<IDELinearConstantAnalysis>(*HA, EntryPoints);
+  DemandDrivenAnalysis DDA(Problem, &HA->getICFG());
+  auto PlainProblem =
+      createAnalysisProblem<IDELinearConstantAnalysis>(*HA, EntryPoints);
+  IDESolver Plain(PlainProblem, &HA->getICFG());
+  Plain.solve();
+
+  const auto *Main = getFunction("main");
+  ASSERT_NE(nullptr, Main);
+  const auto *Ret = getNthTermInstruction(Main, 1);
+  ASSERT_NE(nullptr, Ret);
+
+  EXPECT_EQ(Plain.resultsAt(Ret), DDA.resultsAt(Ret));
+  EXPECT_EQ(1U, DDA.getNumSolverRuns());
+  EXPECT_TRUE(DDA.isMemoized(Ret));
+
+  // bar() is only part of the slice, because its results flow into main();
+  // its results are not exact, as they are not analyzed for all callers
+  const auto *Bar = getFunction("_Z3bari");
+  ASSERT_NE(nullptr, Bar);
+  EXPECT_FALSE(DDA.isMemoized(&Bar->front().front()));
+
+  compareWithPlainSolve(DDA, Plain.getSolverResults());
+}
+
+TEST_F(DemandDrivenAnalysisTest, QueriesInsideASliceAreMemoized) {
+  initialize("call_07.dbg.ll");
+  auto Problem =
+      createAnalysisProblem<IDELinearConstantAnalysis>(*HA, EntryPoints);
+  DemandDrivenAnalysis DDA(Problem, &HA->getICFG());
+  auto PlainProblem =
+      createAnalysisProblem<IDELinearConstantAnalysis>(*HA, EntryPoints);
+  IDESolver Plain(PlainProblem, &HA->getICFG());
+  Plain.solve();
+
+  const auto *Main = getFunction("main");
+  ASSERT_NE(nullptr, Main);
+  const auto *Ret = getNthTermInstruction(Main, 1);
+  ASSERT_NE(nullptr, Ret);
+
+  std::ignore = DDA.resultsAt(Ret);
+  ASSERT_EQ(1U, DDA.getNumSolverRuns());
+  auto NumMemoized = DDA.getNumMemoizedStatements();
+
+  // All statements of main() precede the return
+  for (const auto &Inst : llvm::instructions(Main)) {
+    EXPECT_TRUE(DDA.isMemoized(&Inst));
+    EXPECT_EQ(Plain.resultsAt(&Inst), DDA.resultsAt(&Inst))
+        << "At " << llvmIRToString(&Inst);
+  }
+  EXPECT_EQ(1U, DDA.getNumSolverRuns());
+  EXPECT_EQ(NumMemoized, DDA.getNumMemoizedStatements());
+}
+
+TEST_F(DemandDrivenAnalysisTest, CompleteFunctionsAreReused) {
+  initialize("call_07.dbg.ll");
+  auto Problem =
+      createAnalysisProblem<IDELinearConstantAnalysis>(*HA, EntryPoints);
+  DemandDrivenAnalysis DDA(Problem, &HA->getICFG());
+  auto PlainProblem =
+      createAnalysisProblem<IDELinearConstantAnalysis>(*HA, EntryPoints);
+  IDESolver Plain(PlainProblem, &HA->getICFG());
+  Plain.solve();
+
+  const auto *Main = getFunction("main");
+  ASSERT_NE(nullptr, Main);
+  const auto *FirstCall = getFirstCallTo(Main, "_Z9incrementi");
+  ASSERT_NE(nullptr, FirstCall);
+  const auto *AfterFirstCall = FirstCall->getNextNode();
+  ASSERT_NE(nullptr, AfterFirstCall);
+
+  // The slice ends before the second call and does not contain the rest of
+  // main(), but it contains all of increment()
+  std::ignore = DDA.resultsAt(AfterFirstCall);
+  ASSERT_EQ(1U, DDA.getNumSolverRuns());
+  EXPECT_LT(DDA.getSliceSizes()[0], DDA.getProgramSize());
+  EXPECT_EQ(0U, DDA.getNumReusedSummaries());
+
+  const auto *Ret = getNthTermInstruction(Main, 1);
+  ASSERT_NE(nullptr, Ret);
+  ASSERT_FALSE(DDA.isMemoized(Ret));
+  EXPECT_EQ(Plain.resultsAt(Ret), DDA.resultsAt(Ret));
+  EXPECT_EQ(2U, DDA.getNumSolverRuns());
+
+  // Both calls enter increment() with the facts of the first solver run
+  EXPECT_NE(0U, DDA.getNumReusedSummaries());
+
+  compareWithPlainSolve(DDA, Plain.getSolverResults());
+}
+
+} // namespace
@@ -0,0 +1,195 @@
+#include "phasar/AnalysisStrategy/IncrementalUpdateAnalysis.h"
+
+#include "phasar/DataFlow/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/HelperAnalyses.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMAliasSet.h"
+#include "phasar/PhasarLLVM/SimpleAnalysisConstructor.h"
+#include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
+
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+
+#include "TestConfig.h"
+#include "gtest/gtest.h"
+
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace psr;
+
+namespace {
+
+using n_t = IDELinearConstantAnalysis::n_t;
+using d_t = IDELinearConstantAnalysis::d_t;
+using l_t = IDELinearConstantAnalysis::l_t;
+
+/* ============== TEST FIXTURE ============== */
+
+class IncrementalUpdateAnalysisTest : public ::testing::Test {
+protected:
+  static constexpr auto PathToLlFiles =
+      PHASAR_BUILD_SUBFOLDER("incremental_update/");
+  const std::vector<std::string> EntryPoints = {"main"};
+
+  std::optional<HelperAnalyses> PrevHA;
+  std::optional<HelperAnalyses> HA;
+
+  /// Loads the previous (_v1) and the new (_v2) version of the program Name
+  void initialize(const llvm::Twine &Name) {
+    ValueAnnotationPass::resetValueID();
+    PrevHA.emplace((PathToLlFiles + Name + "_v1.ll").str(), EntryPoints);
+    ValueAnnotationPass::resetValueID();
+    HA.emplace((PathToLlFiles + Name + "_v2.ll").str(), EntryPoints);
+  }
+
+  [[nodiscard]] static std::set<std::string>
+  getNames(const llvm::DenseSet<const llvm::Function *> &Funs) {
+    std::set<std::string> Ret;
+    for (const auto *Fun : Funs) {
+      Ret.insert(Fun->getName().str());
+    }
+    return Ret;
+  }
+
+  /// The value of the local variable VarName of main() at its return
+  [[nodiscard]] std::optional<l_t>
+  getResultAtMainExit(const SolverResults<n_t, d_t, l_t> &Results,
+                      llvm::StringRef VarName) {
+    const auto *Main = HA->getProjectIRDB().getFunctionDefinition("main");
+    const auto *Ret = getNthTermInstruction(Main, 1);
+    for (const auto &[Fact, Value] : Results.resultsAt(Ret)) {
+      if (llvm::isa<llvm::AllocaInst>(Fact) && Fact->getName() == VarName) {
+        return Value;
+      }
+    }
+    return std::nullopt;
+  }
+
+  /// Compares the results at all statements of the new program version with
+  /// the results of a from-scratch solve.
+  void compareWithPlainSolve(const SolverResults<n_t, d_t, l_t> &Results) {
+    auto PlainProblem =
+        createAnalysisProblem<IDELinearConstantAnalysis>(*HA, EntryPoints);
+    IDESolver Plain(PlainProblem, &HA->getICFG());
+    Plain.solve();
+
+    for (const auto *Fun : HA->getProjectIRDB().getAllFunctions()) {
+      for (const auto &Inst : llvm::instructions(Fun)) {
+        std::unordered_map<d_t, l_t> Expected = Plain.resultsAt(&Inst);
+        std::unordered_map<d_t, l_t> Actual = Results.resultsAt(&Inst);
+        IDELinearConstantAnalysis::stripBottomResults(Expected);
+        IDELinearConstantAnalysis::stripBottomResults(Actual);
+        EXPECT_EQ(Expected, Actual) << "At " << llvmIRToString(&Inst);
+      }
+    }
+  }
+}; // Test Fixture
+
+TEST_F(IncrementalUpdateAnalysisTest, ChangedBodyInvalidatesCallers) {
+  initialize("changed_body");
+  auto PrevProblem =
+      createAnalysisProblem<IDELinearConstantAnalysis>(*PrevHA, EntryPoints);
+  IDESolver PrevSolver(PrevProblem, &PrevHA->getICFG());
+  PrevSolver.solve();
+
+  auto Problem =
+      createAnalysisProblem<IDELinearConstantAnalysis>(*HA, EntryPoints);
+  IncrementalUpdateAnalysis IUA(PrevSolver, PrevHA->getICFG(), Problem,
+                                HA->getICFG());
+
+  // Only the body of increment() differs between the versions
+  std::set<std::string> ExpectedChanged = {"_Z9incrementi"};
+  EXPECT_EQ(ExpectedChanged, getNames(IUA.getChangedFunctions()));
+
+  // compute() and main() transitively call increment()
+  auto Invalidated = getNames(IUA.getInvalidatedFunctions());
+  EXPECT_TRUE(Invalidated.count("_Z9incrementi"));
+  EXPECT_TRUE(Invalidated.count("_Z7computei"));
+  EXPECT_TRUE(Invalidated.count("main"));
+  EXPECT_FALSE(Invalidated.count("_Z8constantv"));
+
+  auto Results = IUA.solve();
+  // The summary of constant() is translated from the previous version
+  EXPECT_NE(0U, IUA.getNumReusedSummaries());
+  // j = (42 + 2) * 2
+  EXPECT_EQ(std::optional<l_t>(88), getResultAtMainExit(Results, "j"));
+
+  compareWithPlainSolve(Results);
+}
+
+TEST_F(IncrementalUpdateAnalysisTest, ChangedCalleeInvalidatesCallers) {
+  initialize("changed_callee");
+  auto PrevProblem =
+      createAnalysisProblem<IDELinearConstantAnalysis>(*PrevHA, EntryPoints);
+  IDESolver PrevSolver(PrevProblem, &PrevHA->getICFG());
+  PrevSolver.solve();
+
+  auto Problem =
+      createAnalysisProblem<IDELinearConstantAnalysis>(*HA, EntryPoints);
+  IncrementalUpdateAnalysis IUA(PrevSolver, PrevHA->getICFG(), Problem,
+                                HA->getICFG());
+
+  // The body of apply() is the same in both versions, but the indirect call
+  // through Op resolves to add_two() instead of add_one()
+  std::set<std::string> ExpectedChanged = {"_Z5applyi"};
+  EXPECT_EQ(ExpectedChanged, getNames(IUA.getChangedFunctions()));
+
+  auto Invalidated = getNames(IUA.getInvalidatedFunctions());
+  EXPECT_TRUE(Invalidated.count("_Z5applyi"));
+  EXPECT_TRUE(Invalidated.count("main"));
+  EXPECT_FALSE(Invalidated.count("_Z7add_onei"));
+  EXPECT_FALSE(Invalidated.count("_Z7add_twoi"));
+
+  auto Results = IUA.solve();
+  // i = 40 + 2
+  EXPECT_EQ(std::optional<l_t>(42), getResultAtMainExit(Results, "i"));
+
+  compareWithPlainSolve(Results);
+}
+
+TEST_F(IncrementalUpdateAnalysisTest, ExplicitInvalidationReachesCallers) {
+  ValueAnnotationPass::resetValueID();
+  PrevHA.emplace((PathToLlFiles + "changed_body_v1.ll").str(), EntryPoints);
+  ValueAnnotationPass::resetValueID();
+  HA.emplace((PathToLlFiles + "changed_body_v1.ll").str(), EntryPoints);
+
+  auto PrevProblem =
+      createAnalysisProblem<IDELinearConstantAnalysis>(*PrevHA, EntryPoints);
+  IDESolver PrevSolver(PrevProblem, &PrevHA->getICFG());
+  PrevSolver.solve();
+
+  auto Problem =
+      createAnalysisProblem<IDELinearConstantAnalysis>(*HA, EntryPoints);
+  IncrementalUpdateAnalysis IUA(PrevSolver, PrevHA->getICFG(), Problem,
+                                HA->getICFG());
+  EXPECT_TRUE(IUA.getChangedFunctions().empty());
+  EXPECT_TRUE(IUA.getInvalidatedFunctions().empty());
+
+  // Invalidating increment() explicitly still invalidates its callers
+  const auto *Increment =
+      HA->getProjectIRDB().getFunctionDefinition("_Z9incrementi");
+  ASSERT_NE(nullptr, Increment);
+  IUA.invalidate(Increment);
+  auto Invalidated = getNames(IUA.getInvalidatedFunctions());
+  EXPECT_TRUE(Invalidated.count("_Z7computei"));
+  EXPECT_TRUE(Invalidated.count("main"));
+  EXPECT_FALSE(Invalidated.count("_Z8constantv"));
+
+  auto Results = IUA.solve();
+  EXPECT_NE(0U, IUA.getNumReusedSummaries());
+  // j = (42 + 1) * 2
+  EXPECT_EQ(std::optional<l_t>(86), getResultAtMainExit(Results, "j"));
+
+  compareWithPlainSolve(Results);
+}
+
+} // namespace
@@ -0,0 +1,196 @@
+#include "phasar/AnalysisStrategy/ModuleWiseAnalysis.h"
+
+#include "phasar/DataFlow/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/HelperAnalyses.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMAliasSet.h"
+#include "phasar/PhasarLLVM/SimpleAnalysisConstructor.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/Linker/Linker.h"
+
+#include "TestConfig.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <initializer_list>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace psr;
+
+namespace {
+
+using n_t = IDELinearConstantAnalysis::n_t;
+using d_t = IDELinearConstantAnalysis::d_t;
+using l_t = IDELinearConstantAnalysis::l_t;
+
+/// The values of the local variables of main() before each of its
+/// instructions, identified by their names
+using MainResults = std::vector<std::map<std::string, l_t>>;
+using LCAModuleWiseAnalysis = ModuleWiseAnalysis_P<IDELinearConstantAnalysis>;
+
+/* ============== TEST FIXTURE ============== */
+
+class ModuleWiseAnalysisTest : public ::testing::Test {
+protected:
+  static constexpr auto PathToLlFiles = PHASAR_BUILD_SUBFOLDER("module_wise/");
+  const std::vector<std::string> EntryPoints = {"main"};
+
+  [[nodiscard]] static std::vector<std::string>
+  getModules(llvm::StringRef Dir,
+             std::initializer_list<llvm::StringRef> ModuleNames) {
+    std::vector<std::string> Ret;
+    for (const auto &ModuleName : ModuleNames) {
+      Ret.push_back(
+          (llvm::Twine(PathToLlFiles) + Dir + "/" + ModuleName + ".ll").str());
+    }
+    return Ret;
+  }
+
+  /// The schedule with the modules of each level sorted, as the order of
+  /// the modules within a level is unspecified
+  [[nodiscard]] static std::vector<std::vector<size_t>>
+  getSortedSchedule(const LCAModuleWiseAnalysis &MWA) {
+    auto Schedule = MWA.getSchedule();
+    for (auto &Level : Schedule) {
+      std::sort(Level.begin(), Level.end());
+    }
+    return Schedule;
+  }
+
+  [[nodiscard]] static MainResults
+  collectMainResults(const llvm::Function *Main,
+                     const SolverResults<n_t, d_t, l_t> &Results) {
+    MainResults Ret;
+    for (const auto &Inst : llvm::instructions(Main)) {
+      std::unordered_map<d_t, l_t> Res = Results.resultsAt(&Inst);
+      IDELinearConstantAnalysis::stripBottomResults(Res);
+      auto &Vars = Ret.emplace_back();
+      for (const auto &[Fact, Value] : Res) {
+        if (llvm::isa<llvm::AllocaInst>(Fact)) {
+          Vars[Fact->getName().str()] = Value;
+        }
+      }
+    }
+    return Ret;
+  }
+
+  /// Analyzes the IRFiles module-wise and collects the results in main()
+  static void solveModuleWise(LCAModuleWiseAnalysis &MWA,
+                              MainResults &Results) {
+    MWA.run(
+        [](HelperAnalyses &HA, std::vector<std::string> EntryPoints) {
+          return createAnalysisProblem<IDELinearConstantAnalysis>(
+              HA, std::move(EntryPoints));
+        },
+        [&Results](HelperAnalyses &HA, IDELinearConstantAnalysis & /*Problem*/,
+                   const auto &SR) {
+          if (const auto *Main =
+                  HA.getProjectIRDB().getFunctionDefinition("main")) {
+            Results = collectMainResults(Main, SR);
+          }
+        });
+  }
+
+  /// Links the IRFiles into one module and collects the results of a
+  /// whole-program analysis in main()
+  void solveLinked(const std::vector<std::string> &IRFiles,
+                   MainResults &Results) {
+    ValueAnnotationPass::resetValueID();
+    llvm::LLVMContext Ctx;
+    auto Linked = LLVMProjectIRDB::getParsedIRModuleOrNull(IRFiles[0], Ctx);
+    ASSERT_NE(nullptr, Linked);
+    for (const auto &IRFile : llvm::drop_begin(IRFiles)) {
+      auto Mod = LLVMProjectIRDB::getParsedIRModuleOrNull(IRFile, Ctx);
+      ASSERT_NE(nullptr, Mod);
+      ASSERT_FALSE(llvm::Linker::linkModules(*Linked, std::move(Mod)));
+    }
+
+    LLVMProjectIRDB IRDB(std::move(Linked), /*DoPreprocessing*/ true);
+    LLVMTypeHierarchy TH(IRDB);
+    LLVMAliasSet PT(&IRDB);
+    LLVMBasedICFG ICFG(&IRDB, CallGraphAnalysisType::OTF, EntryPoints, &TH,
+                       &PT, Soundness::Soundy, /*IncludeGlobals*/ true);
+    IDELinearConstantAnalysis Problem(&IRDB, &ICFG, EntryPoints);
+    IDESolver Solver(Problem, &ICFG);
+    Solver.solve();
+
+    const auto *Main = IRDB.getFunctionDefinition("main");
+    ASSERT_NE(nullptr, Main);
+    Results = collectMainResults(Main, Solver.getSolverResults());
+  }
+}; // Test Fixture
+
+TEST_F(ModuleWiseAnalysisTest, ScheduleFollowsDependencies) {
+  // main calls foo() from src2 and id() from src1; foo() calls id()
+  LCAModuleWiseAnalysis MWA(
+      getModules("module_wise_12", {"main", "src1", "src2"}), EntryPoints);
+  std::vector<std::vector<size_t>> Expected = {{1}, {2}, {0}};
+  EXPECT_EQ(Expected, getSortedSchedule(MWA));
+}
+
+TEST_F(ModuleWiseAnalysisTest, IndependentModulesShareALevel) {
+  LCAModuleWiseAnalysis MWA(
+      getModules("module_wise_1", {"main", "src1", "src2"}), EntryPoints);
+  std::vector<std::vector<size_t>> Expected = {{1, 2}, {0}};
+  EXPECT_EQ(Expected, getSortedSchedule(MWA));
+}
+
+TEST_F(ModuleWiseAnalysisTest, CyclicModulesShareALevel) {
+  // apply() from src1 calls back into twice() from main
+  LCAModuleWiseAnalysis MWA(
+      getModules("module_wise_17", {"main", "src1"}), EntryPoints);
+  std::vector<std::vector<size_t>> Expected = {{0, 1}};
+  EXPECT_EQ(Expected, getSortedSchedule(MWA));
+}
+
+TEST_F(ModuleWiseAnalysisTest, AppliesSummariesAcrossModules) {
+  LCAModuleWiseAnalysis MWA(
+      getModules("module_wise_12", {"main", "src1", "src2"}), EntryPoints);
+  MainResults Results;
+  solveModuleWise(MWA, Results);
+
+  EXPECT_TRUE(MWA.getSummaries().hasSummary("_Z2idi"));
+  EXPECT_TRUE(MWA.getSummaries().hasSummary("_Z3fooi"));
+  // The calls to id() and foo() in main and the call to id() in foo()
+  EXPECT_EQ(3U, MWA.getNumAppliedSummaries());
+}
+
+TEST_F(ModuleWiseAnalysisTest, MatchesLinkedWholeProgram) {
+  auto IRFiles = getModules("module_wise_16", {"main", "src1"});
+  LCAModuleWiseAnalysis MWA(IRFiles, EntryPoints);
+  MainResults Results;
+  solveModuleWise(MWA, Results);
+  EXPECT_EQ(1U, MWA.getNumAppliedSummaries());
+
+  MainResults Expected;
+  solveLinked(IRFiles, Expected);
+  ASSERT_FALSE(Expected.empty());
+  // The value of b flows through id() from the other module
+  EXPECT_TRUE(Expected.back().count("b"));
+  EXPECT_EQ(Expected, Results);
+}
+
+TEST_F(ModuleWiseAnalysisTest, MatchesLinkedWholeProgramAcrossLevels) {
+  auto IRFiles = getModules("module_wise_12", {"main", "src1", "src2"});
+  LCAModuleWiseAnalysis MWA(IRFiles, EntryPoints);
+  MainResults Results;
+  solveModuleWise(MWA, Results);
+
+  MainResults Expected;
+  solveLinked(IRFiles, Expected);
+  EXPECT_EQ(Expected, Results);
+}
+
+} // namespace
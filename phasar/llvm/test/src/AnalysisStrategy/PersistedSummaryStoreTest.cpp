@@ -0,0 +1,157 @@
+#include "phasar/AnalysisStrategy/PersistedSummaryStore.h"
+
+#include "phasar/AnalysisStrategy/FunctionSummaries.h"
+#include "phasar/DataFlow/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/HelperAnalyses.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMAliasSet.h"
+#include "phasar/PhasarLLVM/SimpleAnalysisConstructor.h"
+#include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FileUtilities.h"
+#include "llvm/Support/TypeName.h"
+
+#include "TestConfig.h"
+#include "gtest/gtest.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace psr;
+
+namespace {
+
+using l_t = IDELinearConstantAnalysis::l_t;
+
+/* ============== TEST FIXTURE ============== */
+
+class PersistedSummaryStoreTest : public ::testing::Test {
+protected:
+  static constexpr auto PathToLlFiles =
+      PHASAR_BUILD_SUBFOLDER("linear_constant/");
+  const std::vector<std::string> EntryPoints = {"main"};
+  const llvm::StringRef AnalysisId =
+      llvm::getTypeName<IDELinearConstantAnalysis>();
+
+  std::optional<HelperAnalyses> HA;
+  llvm::SmallString<128> StoreFile;
+  std::optional<llvm::FileRemover> RemoveStoreFile;
+
+  void initialize(const llvm::Twine &IRFile) {
+    ValueAnnotationPass::resetValueID();
+    HA.emplace(PathToLlFiles + IRFile, EntryPoints);
+
+    ASSERT_FALSE(llvm::sys::fs::createTemporaryFile("psr-summaries", "bin",
+                                                    StoreFile));
+    RemoveStoreFile.emplace(StoreFile);
+  }
+
+  [[nodiscard]] size_t getNumDefinitions() {
+    return llvm::count_if(HA->getICFG().getAllFunctions(), [](const auto *Fun) {
+      return !Fun->isDeclaration();
+    });
+  }
+
+  /// Summarizes all functions of the current IR file with a fresh problem and
+  /// writes them to the StoreFile
+  void writeStore() {
+    PersistedSummaryStore<l_t> Store(AnalysisId);
+    FunctionSummaryKeys Keys(HA->getICFG());
+    auto Problem =
+        createAnalysisProblem<IDELinearConstantAnalysis>(*HA, EntryPoints);
+    EXPECT_EQ(getNumDefinitions(),
+              computePersistedSummaries(Problem, HA->getICFG(), Store, Keys));
+    ASSERT_TRUE(Store.write(StoreFile));
+  }
+
+  /// Solves the linear constant analysis with the summaries of Store and
+  /// compares the results inside the entry points with a plain solve.
+  void compareWithPlainSolve(PersistedSummaryStore<l_t> &Store,
+                             bool ExpectAppliedSummaries) {
+    FunctionSummaryKeys Keys(HA->getICFG());
+    auto Problem =
+        createAnalysisProblem<IDELinearConstantAnalysis>(*HA, EntryPoints);
+    detail::SummaryImportingProblem<IDELinearConstantAnalysisDomain,
+                                    IDELinearConstantAnalysis::container_type>
+        Importing(Problem, makePersistedSummaryLookup(Store, Keys));
+    IDESolver Solver(Importing, &HA->getICFG());
+    Solver.solve();
+    EXPECT_EQ(ExpectAppliedSummaries, Importing.getNumAppliedSummaries() != 0);
+
+    auto PlainProblem =
+        createAnalysisProblem<IDELinearConstantAnalysis>(*HA, EntryPoints);
+    IDESolver Plain(PlainProblem, &HA->getICFG());
+    Plain.solve();
+
+    // Summarized callees have no results of their own
+    const auto *Main = HA->getProjectIRDB().getFunctionDefinition("main");
+    ASSERT_NE(nullptr, Main);
+    for (const auto &Inst : llvm::instructions(Main)) {
+      EXPECT_EQ(Plain.resultsAt(&Inst), Solver.resultsAt(&Inst))
+          << "At " << llvmIRToString(&Inst);
+    }
+  }
+}; // Test Fixture
+
+TEST_F(PersistedSummaryStoreTest, RoundTrip) {
+  initialize("call_03.dbg.ll");
+  writeStore();
+
+  PersistedSummaryStore<l_t> Store(AnalysisId);
+  ASSERT_TRUE(Store.load(StoreFile));
+  EXPECT_EQ(getNumDefinitions(), Store.size());
+
+  // foo() only returns a constant, so its summary is persistable
+  FunctionSummaryKeys Keys(HA->getICFG());
+  const auto *Foo = HA->getProjectIRDB().getFunctionDefinition("_Z3foov");
+  ASSERT_NE(nullptr, Foo);
+  const auto *Summary = Store.getSummaryByKey(Keys.getKey(Foo));
+  ASSERT_NE(nullptr, Summary);
+  EXPECT_TRUE(PersistedSummaryStore<l_t>::isPersistable(*Summary));
+
+  compareWithPlainSolve(Store, /*ExpectAppliedSummaries*/ true);
+}
+
+TEST_F(PersistedSummaryStoreTest, UnpersistableSummariesAreNotRecomputed) {
+  initialize("call_06.dbg.ll");
+  writeStore();
+
+  PersistedSummaryStore<l_t> Store(AnalysisId);
+  ASSERT_TRUE(Store.load(StoreFile));
+
+  // increment() adds one to its argument, which is no generic edge function
+  FunctionSummaryKeys Keys(HA->getICFG());
+  const auto *Increment =
+      HA->getProjectIRDB().getFunctionDefinition("_Z9incrementi");
+  ASSERT_NE(nullptr, Increment);
+  EXPECT_TRUE(Store.containsKey(Keys.getKey(Increment)));
+  EXPECT_EQ(nullptr, Store.getSummaryByKey(Keys.getKey(Increment)));
+
+  auto Problem =
+      createAnalysisProblem<IDELinearConstantAnalysis>(*HA, EntryPoints);
+  EXPECT_EQ(0U,
+            computePersistedSummaries(Problem, HA->getICFG(), Store, Keys));
+
+  compareWithPlainSolve(Store, /*ExpectAppliedSummaries*/ false);
+}
+
+TEST_F(PersistedSummaryStoreTest, OtherConfigurationIsIgnored) {
+  initialize("call_03.dbg.ll");
+  writeStore();
+
+  // E.g., an analysis config has changed, see
+  // AnalysisController::getPersistedSummaryId()
+  PersistedSummaryStore<l_t> Store(AnalysisId.str() + "\nconfig");
+  EXPECT_FALSE(Store.load(StoreFile));
+  EXPECT_EQ(0U, Store.size());
+}
+
+} // namespace
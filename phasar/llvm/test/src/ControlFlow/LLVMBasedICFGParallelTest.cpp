@@ -0,0 +1,99 @@
+#include "phasar/ControlFlow/CallGraphAnalysisType.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMAliasSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "phasar/Utils/Logger.h"
+#include "phasar/Utils/Soundness.h"
+
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/Support/MemoryBufferRef.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+
+using namespace psr;
+
+namespace {
+
+constexpr unsigned NumFunctions = 96;
+
+/// A module with many functions that are called through function pointers,
+/// such that the batches are large enough to be processed concurrently
+std::string generateProgram() {
+  std::string IR;
+  for (unsigned I = 0; I != NumFunctions; ++I) {
+    auto Callee = std::to_string((2 * I + 1) % NumFunctions);
+    IR += "define void @f" + std::to_string(I) + "(i32 %x) {\n";
+    IR += "entry:\n";
+    IR += "  %fp = alloca void (i32)*\n";
+    IR += "  store void (i32)* @f" + Callee + ", void (i32)** %fp\n";
+    IR += "  %l = load void (i32)*, void (i32)** %fp\n";
+    IR += "  call void %l(i32 %x)\n";
+    IR += "  ret void\n}\n\n";
+  }
+
+  IR += "define i32 @main() {\nentry:\n";
+  for (unsigned I = 0; I != NumFunctions; ++I) {
+    auto Idx = std::to_string(I);
+    IR += "  %fp" + Idx + " = alloca void (i32)*\n";
+    IR += "  store void (i32)* @f" + Idx + ", void (i32)** %fp" + Idx + "\n";
+    IR += "  %l" + Idx + " = load void (i32)*, void (i32)** %fp" + Idx + "\n";
+    IR += "  call void %l" + Idx + "(i32 0)\n";
+  }
+  IR += "  ret i32 0\n}\n";
+  return IR;
+}
+
+void compareCallGraphs(const LLVMBasedICFG &Seq, const LLVMBasedICFG &Par) {
+  EXPECT_EQ(Seq.getNumVertexFunctions(), Par.getNumVertexFunctions());
+  for (const auto *Fun : Seq.getAllVertexFunctions()) {
+    for (const auto *CS : Seq.getCallsFromWithin(Fun)) {
+      const auto &SeqCallees = Seq.getCalleesOfCallAt(CS);
+      const auto &ParCallees = Par.getCalleesOfCallAt(CS);
+      llvm::DenseSet<const llvm::Function *> ParCalleeSet(ParCallees.begin(),
+                                                          ParCallees.end());
+      EXPECT_EQ(SeqCallees.size(), ParCalleeSet.size())
+          << "At " << Fun->getName().str();
+      for (const auto *Callee : SeqCallees) {
+        EXPECT_TRUE(ParCalleeSet.contains(Callee))
+            << "Missing callee " << Callee->getName().str() << " in "
+            << Fun->getName().str();
+      }
+    }
+  }
+}
+
+class LLVMBasedICFGParallelTest : public ::testing::Test {
+protected:
+  void SetUp() override { Logger::disable(); }
+
+  void compareWithSequential(CallGraphAnalysisType CGTy) {
+    LLVMAliasSet SeqPT(&IRDB, false);
+    LLVMBasedICFG Seq(&IRDB, CGTy, {"main"}, &TH, &SeqPT, Soundness::Soundy,
+                      /*IncludeGlobals*/ false);
+    // All functions are reachable through the function pointers
+    EXPECT_EQ(NumFunctions + 1, Seq.getNumVertexFunctions());
+
+    LLVMAliasSet ParPT(&IRDB, false);
+    LLVMBasedICFG Par(&IRDB, CGTy, {"main"}, &TH, &ParPT, Soundness::Soundy,
+                      /*IncludeGlobals*/ false, /*NumThreads*/ 4);
+
+    compareCallGraphs(Seq, Par);
+  }
+
+  std::string Program = generateProgram();
+  LLVMProjectIRDB IRDB{llvm::MemoryBufferRef(Program, "program")};
+  LLVMTypeHierarchy TH{IRDB};
+};
+
+} // namespace
+
+TEST_F(LLVMBasedICFGParallelTest, CHA) {
+  compareWithSequential(CallGraphAnalysisType::CHA);
+}
+
+TEST_F(LLVMBasedICFGParallelTest, OTF) {
+  compareWithSequential(CallGraphAnalysisType::OTF);
+}
@@ -4,6 +4,8 @@
 #include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
 #include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
 
+#include "llvm/Support/raw_ostream.h"
+
 #include "TestConfig.h"
 #include "gtest/gtest.h"
 
@@ -22,6 +24,15 @@ protected:
     psr::LLVMBasedICFG Deser(&IRDB, Ser);
 
     compareResults(ICF, Deser);
+
+    std::string Buf;
+    llvm::raw_string_ostream OS(Buf);
+    ICF.writeBinary(OS);
+    auto BinDeser = psr::LLVMBasedICFG::loadBinary(
+        &IRDB, llvm::MemoryBufferRef(OS.str(), "cg"));
+    ASSERT_NE(nullptr, BinDeser);
+
+    compareResults(ICF, *BinDeser);
   }
 
   void compareResults(const psr::LLVMBasedICFG &Orig,
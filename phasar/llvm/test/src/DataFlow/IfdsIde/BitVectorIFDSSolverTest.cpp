@@ -0,0 +1,146 @@
+#include "phasar/DataFlow/IfdsIde/Solver/BitVectorIFDSSolver.h"
+
+#include "phasar/DataFlow/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/IFDSTaintAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/IFDSUninitializedVariables.h"
+#include "phasar/PhasarLLVM/HelperAnalyses.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMAliasSet.h"
+#include "phasar/PhasarLLVM/SimpleAnalysisConstructor.h"
+#include "phasar/PhasarLLVM/TaintConfig/LLVMTaintConfig.h"
+#include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
+
+#include "llvm/IR/InstIterator.h"
+
+#include "TestConfig.h"
+#include "gtest/gtest.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+
+class BitVectorIFDSSolverTest : public ::testing::Test {
+protected:
+  static constexpr auto PathToUninitFiles =
+      PHASAR_BUILD_SUBFOLDER("uninitialized_variables/");
+  static constexpr auto PathToTaintFiles =
+      PHASAR_BUILD_SUBFOLDER("taint_analysis/dummy_source_sink/");
+  const std::vector<std::string> EntryPoints = {"main"};
+
+  std::optional<HelperAnalyses> HA;
+  std::optional<LLVMTaintConfig> TSF;
+
+  void initialize(const llvm::Twine &IRFile) {
+    HA.emplace(IRFile, EntryPoints);
+  }
+
+  LLVMTaintConfig &getTaintConfig() {
+    LLVMTaintConfig::TaintDescriptionCallBackTy SourceCB =
+        [](const llvm::Instruction *Inst) {
+          std::set<const llvm::Value *> Ret;
+          if (const auto *Call = llvm::dyn_cast<llvm::CallBase>(Inst);
+              Call && Call->getCalledFunction() &&
+              Call->getCalledFunction()->getName() == "_Z6sourcev") {
+            Ret.insert(Call);
+          }
+          return Ret;
+        };
+    LLVMTaintConfig::TaintDescriptionCallBackTy SinkCB =
+        [](const llvm::Instruction *Inst) {
+          std::set<const llvm::Value *> Ret;
+          if (const auto *Call = llvm::dyn_cast<llvm::CallBase>(Inst);
+              Call && Call->getCalledFunction() &&
+              Call->getCalledFunction()->getName() == "_Z4sinki") {
+            assert(Call->arg_size() > 0);
+            Ret.insert(Call->getArgOperand(0));
+          }
+          return Ret;
+        };
+    return TSF.emplace(std::move(SourceCB), std::move(SinkCB));
+  }
+
+  void SetUp() override { ValueAnnotationPass::resetValueID(); }
+
+  /// Solves Expected with the IFDSSolver and Actual with the
+  /// BitVectorIFDSSolver and checks that both compute the same facts at every
+  /// instruction.
+  template <typename ProblemTy>
+  void compareSolvers(ProblemTy &Expected, ProblemTy &Actual) {
+    IFDSSolver Reference(Expected, &HA->getICFG());
+    Reference.solve();
+    BitVectorIFDSSolver Solver(Actual, &HA->getICFG());
+    Solver.solve();
+
+    auto Results = Solver.getSolverResults();
+    for (const auto *F : HA->getProjectIRDB().getAllFunctions()) {
+      for (const auto &Inst : llvm::instructions(F)) {
+        auto ActualFacts = Solver.ifdsResultsAt(&Inst);
+        EXPECT_EQ(ActualFacts, Results.ifdsResultsAt(&Inst))
+            << "At " << llvmIRToString(&Inst);
+        EXPECT_EQ(Reference.ifdsResultsAt(&Inst), ActualFacts)
+            << "At " << llvmIRToString(&Inst);
+      }
+    }
+  }
+
+  void compareUninit(const llvm::Twine &IRFile,
+                     bool FollowReturnsPastSeeds = false) {
+    initialize(IRFile);
+    auto Expected =
+        createAnalysisProblem<IFDSUninitializedVariables>(*HA, EntryPoints);
+    auto Actual =
+        createAnalysisProblem<IFDSUninitializedVariables>(*HA, EntryPoints);
+    Expected.getIFDSIDESolverConfig().setFollowReturnsPastSeeds(
+        FollowReturnsPastSeeds);
+    Actual.getIFDSIDESolverConfig().setFollowReturnsPastSeeds(
+        FollowReturnsPastSeeds);
+    compareSolvers(Expected, Actual);
+    EXPECT_EQ(Expected.getAllUndefUses(), Actual.getAllUndefUses());
+  }
+
+  void compareTaint(const llvm::Twine &IRFile) {
+    initialize(IRFile);
+    auto &Config = getTaintConfig();
+    auto Expected =
+        createAnalysisProblem<IFDSTaintAnalysis>(*HA, &Config, EntryPoints);
+    auto Actual =
+        createAnalysisProblem<IFDSTaintAnalysis>(*HA, &Config, EntryPoints);
+    compareSolvers(Expected, Actual);
+    EXPECT_EQ(Expected.Leaks, Actual.Leaks);
+  }
+}; // Test Fixture
+
+TEST_F(BitVectorIFDSSolverTest, UninitializedVariables) {
+  for (const auto *File :
+       {"all_uninit.dbg.ll", "binop_uninit.dbg.ll", "callnoret.dbg.ll",
+        "ctor_default.dbg.ll", "global_variable.dbg.ll",
+        "growing_example.dbg.ll", "recursion.dbg.ll", "return_uninit.dbg.ll",
+        "struct_member_uninit.dbg.ll", "virtual_call.dbg.ll"}) {
+    SCOPED_TRACE(File);
+    compareUninit(PathToUninitFiles + File);
+  }
+}
+
+TEST_F(BitVectorIFDSSolverTest, UninitializedVariablesFollowReturns) {
+  for (const auto *File : {"callnoret.dbg.ll", "recursion.dbg.ll"}) {
+    SCOPED_TRACE(File);
+    compareUninit(PathToUninitFiles + File, /*FollowReturnsPastSeeds*/ true);
+  }
+}
+
+TEST_F(BitVectorIFDSSolverTest, TaintAnalysis) {
+  for (const auto *File :
+       {"taint_01.dbg.ll", "taint_02.dbg.ll", "taint_03.dbg.ll",
+        "taint_04.dbg.ll", "taint_05.dbg.ll", "taint_06.m2r.dbg.ll",
+        "taint_exception_01.dbg.ll", "taint_exception_05.dbg.ll",
+        "taint_exception_10.dbg.ll"}) {
+    SCOPED_TRACE(File);
+    compareTaint(PathToTaintFiles + File);
+  }
+}
@@ -0,0 +1,157 @@
+#include "phasar/DataFlow/IfdsIde/EdgeFunctionMemoCache.h"
+
+#include "phasar/DataFlow/IfdsIde/EdgeFunction.h"
+#include "phasar/DataFlow/IfdsIde/EdgeFunctionUtils.h"
+
+#include "llvm/Support/raw_ostream.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace psr;
+
+namespace {
+
+/// An edge function that adds a constant. It is larger than a pointer, so
+/// each instance lives on the heap and has its own identity.
+struct AddEF {
+  using l_t = int;
+  int Summand;
+  int Padding[3]{};
+
+  [[nodiscard]] int computeTarget(int Source) const {
+    return Source + Summand;
+  }
+
+  static EdgeFunction<int> compose(EdgeFunctionRef<AddEF> This,
+                                   const EdgeFunction<int> &SecondFunction) {
+    ++NumComposed;
+    if (auto Default = defaultComposeOrNull(This, SecondFunction)) {
+      return Default;
+    }
+    const auto *Add = SecondFunction.dyn_cast<AddEF>();
+    assert(Add && "AddEF can only be composed with AddEF");
+    return AddEF{This->Summand + Add->Summand};
+  }
+
+  static EdgeFunction<int> join(EdgeFunctionRef<AddEF> This,
+                                const EdgeFunction<int> &OtherFunction) {
+    ++NumJoined;
+    if (OtherFunction.isa<AllTop<int>>()) {
+      return This;
+    }
+    if (const auto *Add = OtherFunction.dyn_cast<AddEF>();
+        Add && Add->Summand == This->Summand) {
+      return This;
+    }
+    return AllBottom<int>{};
+  }
+
+  bool operator==(const AddEF &Other) const noexcept {
+    return Summand == Other.Summand;
+  }
+
+  friend llvm::raw_ostream &operator<<(llvm::raw_ostream &OS,
+                                       const AddEF &EF) {
+    return OS << "AddEF[" << EF.Summand << ']';
+  }
+
+  static inline std::atomic<size_t> NumComposed = 0;
+  static inline std::atomic<size_t> NumJoined = 0;
+};
+
+} // namespace
+
+TEST(EdgeFunctionMemoCacheTest, ComposeAndJoinHits) {
+  EdgeFunctionMemoCache<int> Memo(128);
+  EdgeFunction<int> EF1 = AddEF{1};
+  EdgeFunction<int> EF2 = AddEF{2};
+  AddEF::NumComposed = 0;
+  AddEF::NumJoined = 0;
+
+  auto Composed = Memo.compose(EF1, EF2);
+  EXPECT_EQ(EF1.composeWith(EF2), Composed);
+  EXPECT_EQ(3, Composed.computeTarget(0));
+  auto ComposedAgain = Memo.compose(EF1, EF2);
+  EXPECT_TRUE(Composed.referenceEquals(ComposedAgain));
+  // One call through the memo cache, one for the comparison above
+  EXPECT_EQ(2, AddEF::NumComposed);
+
+  auto Joined = Memo.join(EF1, EF2);
+  EXPECT_TRUE(llvm::isa<AllBottom<int>>(Joined));
+  EXPECT_TRUE(Memo.join(EF1, EF2).referenceEquals(Joined));
+  EXPECT_EQ(1, AddEF::NumJoined);
+
+  // A structurally equal, but distinct edge function is not found
+  EdgeFunction<int> OtherEF1 = AddEF{1};
+  EXPECT_EQ(Composed, Memo.compose(OtherEF1, EF2));
+  // Nor is the same pair of operands with the other operation
+  EXPECT_TRUE(llvm::isa<AllBottom<int>>(Memo.join(EF2, EF1)));
+
+  auto Stats = Memo.getStats();
+  EXPECT_EQ(1, Stats.ComposeHits);
+  EXPECT_EQ(2, Stats.ComposeMisses);
+  EXPECT_EQ(1, Stats.JoinHits);
+  EXPECT_EQ(2, Stats.JoinMisses);
+  EXPECT_DOUBLE_EQ(0.5, Stats.hitRate(2, 2));
+
+  Memo.clear();
+  EXPECT_FALSE(Memo.compose(EF1, EF2).referenceEquals(Composed));
+  EXPECT_EQ(3, Memo.getStats().ComposeMisses);
+  EXPECT_EQ(1, Memo.getStats().ComposeHits);
+}
+
+TEST(EdgeFunctionMemoCacheTest, BoundedCapacity) {
+  EdgeFunctionMemoCache<int> Memo(100);
+  EXPECT_EQ(128, Memo.capacity());
+
+  std::vector<EdgeFunction<int>> EFs;
+  for (int I = 0; I != 64; ++I) {
+    EFs.emplace_back(AddEF{I});
+  }
+  // 64 * 64 compositions do not fit into the cache; evicted results must not
+  // change the outcome
+  for (size_t Round = 0; Round != 2; ++Round) {
+    for (const auto &First : EFs) {
+      for (const auto &Second : EFs) {
+        ASSERT_EQ(First.composeWith(Second), Memo.compose(First, Second));
+      }
+    }
+  }
+  auto Stats = Memo.getStats();
+  EXPECT_EQ(2 * 64 * 64, Stats.ComposeHits + Stats.ComposeMisses);
+  EXPECT_LT(Stats.ComposeHits, 2 * 128);
+}
+
+TEST(EdgeFunctionMemoCacheTest, Synchronized) {
+  EdgeFunctionMemoCache<int> Memo(256, /*Synchronized*/ true);
+  std::vector<EdgeFunction<int>> EFs;
+  for (int I = 0; I != 8; ++I) {
+    EFs.emplace_back(AddEF{I});
+  }
+
+  std::vector<std::thread> Threads;
+  for (int T = 0; T != 4; ++T) {
+    Threads.emplace_back([&Memo, &EFs] {
+      for (size_t Round = 0; Round != 100; ++Round) {
+        for (const auto &First : EFs) {
+          for (const auto &Second : EFs) {
+            auto Composed = Memo.compose(First, Second);
+            EXPECT_EQ(First.computeTarget(Second.computeTarget(0)),
+                      Composed.computeTarget(0));
+          }
+        }
+      }
+    });
+  }
+  for (auto &Thread : Threads) {
+    Thread.join();
+  }
+
+  auto Stats = Memo.getStats();
+  EXPECT_EQ(4 * 100 * 8 * 8, Stats.ComposeHits + Stats.ComposeMisses);
+  EXPECT_GT(Stats.composeHitRate(), 0.5);
+}
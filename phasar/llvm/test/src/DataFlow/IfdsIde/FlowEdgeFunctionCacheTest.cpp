@@ -0,0 +1,95 @@
+#include "phasar/DataFlow/IfdsIde/Solver/FlowEdgeFunctionCache.h"
+
+#include "phasar/DataFlow/IfdsIde/EdgeFunction.h"
+#include "phasar/DataFlow/IfdsIde/EdgeFunctionUtils.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+
+#include "RecordingTaintAnalysis.h"
+#include "TestConfig.h"
+#include "gtest/gtest.h"
+
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace psr;
+using namespace psr::unittest;
+
+namespace {
+
+using l_t = RecordingTaintAnalysis::l_t;
+
+class FlowEdgeFunctionCacheTest : public ::testing::Test {
+protected:
+  static constexpr auto PathToLlFiles =
+      PHASAR_BUILD_SUBFOLDER("taint_analysis/");
+  const std::vector<std::string> EntryPoints = {"main"};
+
+  std::optional<RecordedTaintSolve> Solve;
+  RecordingTaintAnalysis *TaintProblem{};
+
+  void SetUp() override { ValueAnnotationPass::resetValueID(); }
+
+  /// Solves the taint analysis on IRFile, which records all cache keys.
+  void initialize(const llvm::Twine &IRFile) {
+    Solve.emplace(IRFile, EntryPoints);
+    TaintProblem = &Solve->TaintProblem;
+  }
+};
+
+} // namespace
+
+TEST_F(FlowEdgeFunctionCacheTest, HitsDoNotConstructAgain) {
+  initialize({PathToLlFiles + "dummy_source_sink/taint_exception_04.dbg.ll"});
+  const auto Queries = TaintProblem->Queries;
+  ASSERT_FALSE(Queries.CallFF.empty());
+  ASSERT_FALSE(Queries.CallEF.empty());
+
+  FlowEdgeFunctionCache<RecordingTaintAnalysis::ProblemAnalysisDomain> Cache(
+      *TaintProblem);
+  std::vector<RecordingTaintAnalysis::FlowFunctionPtrType> CallFFs;
+  for (const auto &[CallSite, DestFun] : Queries.CallFF) {
+    CallFFs.push_back(Cache.getCallFlowFunction(CallSite, DestFun));
+  }
+  for (const auto &[CallSite, RetSite, Callees] : Queries.CallToRetFF) {
+    Cache.getCallToRetFlowFunction(CallSite, RetSite, Callees);
+  }
+  for (const auto &[CallSite, Src, DestFun, Dest] : Queries.CallEF) {
+    Cache.getCallEdgeFunction(CallSite, Src, DestFun, Dest);
+  }
+
+  auto NumConstructed = TaintProblem->NumConstructed;
+  auto CallFFIt = CallFFs.begin();
+  for (const auto &[CallSite, DestFun] : Queries.CallFF) {
+    EXPECT_EQ(*CallFFIt++, Cache.getCallFlowFunction(CallSite, DestFun));
+  }
+  for (const auto &[CallSite, RetSite, Callees] : Queries.CallToRetFF) {
+    Cache.getCallToRetFlowFunction(CallSite, RetSite, Callees);
+  }
+  for (const auto &[CallSite, Src, DestFun, Dest] : Queries.CallEF) {
+    EXPECT_EQ(EdgeFunction<l_t>(EdgeIdentity<l_t>{}),
+              Cache.getCallEdgeFunction(CallSite, Src, DestFun, Dest));
+  }
+  EXPECT_EQ(NumConstructed, TaintProblem->NumConstructed);
+}
+
+TEST(FlowEdgeFunctionCacheMapTest, IntegralKeysIncludingDenseMapSentinels) {
+  using KeyT = std::tuple<const int *, unsigned>;
+  static_assert(detail::IsDenseMapCacheKey<std::tuple<const int *>>::value);
+  static_assert(!detail::IsDenseMapCacheKey<KeyT>::value);
+
+  // These are the empty and tombstone keys of llvm::DenseMapInfo
+  const unsigned Facts[] = {~0U, ~0U - 1, 0, 42};
+  const int Stmt = 0;
+  detail::FlowEdgeFunctionCacheMap<KeyT, unsigned> Map;
+  for (unsigned I = 0; I != 4; ++I) {
+    EXPECT_TRUE(Map.try_emplace(KeyT{&Stmt, Facts[I]}, I).second);
+  }
+  ASSERT_EQ(4U, Map.size());
+  for (unsigned I = 0; I != 4; ++I) {
+    auto It = Map.find(KeyT{&Stmt, Facts[I]});
+    ASSERT_NE(Map.end(), It);
+    EXPECT_EQ(I, It->second);
+  }
+}
@@ -0,0 +1,58 @@
+#include "phasar/DataFlow/IfdsIde/FlowFunctions.h"
+
+#include "llvm/ADT/SmallVector.h"
+
+#include "gtest/gtest.h"
+
+#include <iterator>
+#include <set>
+
+using namespace psr;
+
+namespace {
+
+/// Checks that computeTargetsInto() appends exactly the facts that
+/// computeTargets() returns, without duplicates and without touching the
+/// facts that are already in the buffer
+void checkSink(FlowFunction<int> &FF, int Source) {
+  auto Expected = FF.computeTargets(Source);
+
+  llvm::SmallVector<int, 4> Targets = {-1};
+  FF.computeTargetsInto(Source, Targets);
+  ASSERT_FALSE(Targets.empty());
+  EXPECT_EQ(-1, Targets.front());
+
+  std::set<int> Actual(std::next(Targets.begin()), Targets.end());
+  EXPECT_EQ(Targets.size() - 1, Actual.size()) << "Duplicate target facts";
+  EXPECT_EQ(Expected, Actual) << "For source fact " << Source;
+}
+
+void checkSink(const FlowFunctionPtrType<int> &FF) {
+  for (int Source = 0; Source != 6; ++Source) {
+    checkSink(*FF, Source);
+  }
+}
+
+} // namespace
+
+TEST(FlowFunctionsTest, SinkMatchesComputeTargets) {
+  checkSink(identityFlow<int>());
+  checkSink(generateFlow<int>(1, 2));
+  checkSink(generateFlow<int>(2, 2));
+  checkSink(generateFlowIf<int>(4, [](int X) { return X % 2 == 0; }));
+  checkSink(generateManyFlows<int>({1, 3, 5}, 3));
+  checkSink(killFlow<int>(2));
+  checkSink(killFlowIf<int>([](int X) { return X > 3; }));
+  checkSink(killManyFlows<int>({0, 4}));
+  checkSink(generateFlowAndKillAllOthers<int>(1, 3));
+  checkSink(generateManyFlowsAndKillAllOthers<int>({1, 3, 5}, 3));
+  checkSink(transferFlow<int>(1, 3));
+  checkSink(unionFlows(generateFlow<int>(1, 2), transferFlow<int>(3, 2)));
+  checkSink(lambdaFlow<int>([](int X) { return std::set<int>{X, X + 1}; }));
+}
+
+TEST(FlowFunctionsTest, ZeroedSinkKeepsZero) {
+  checkSink(std::make_shared<ZeroedFlowFunction<int>>(killFlow<int>(0), 0));
+  checkSink(
+      std::make_shared<ZeroedFlowFunction<int>>(identityFlow<int>(), 0));
+}
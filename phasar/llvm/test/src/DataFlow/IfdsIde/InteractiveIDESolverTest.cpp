@@ -1,16 +1,22 @@
 #include "phasar/DataFlow/IfdsIde/Solver/IDESolver.h"
+#include "phasar/DataFlow/IfdsIde/Solver/SummaryProvider.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
 #include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
 #include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/IDELinearConstantAnalysis.h"
 #include "phasar/PhasarLLVM/HelperAnalyses.h"
-#include "phasar/PhasarLLVM/SimpleAnalysisConstructor.h"
 #include "phasar/Utils/TypeTraits.h"
 
+#include "llvm/IR/InstIterator.h"
+
 #include "TestConfig.h"
 #include "gtest/gtest.h"
 
+#include <atomic>
 #include <memory>
+#include <optional>
+#include <string>
 #include <tuple>
+#include <utility>
 
 using namespace psr;
 
@@ -21,21 +27,32 @@ protected:
       PHASAR_BUILD_SUBFOLDER("linear_constant/");
   const std::vector<std::string> EntryPoints = {"main"};
 
-}; // Test Fixture
+  std::optional<HelperAnalyses> HA;
+  std::optional<IDELinearConstantAnalysis> Problem;
 
-TEST_P(LinearConstant, ResultsEquivalentSolveUntil) {
-  HelperAnalyses HA(PathToLlFiles + GetParam(), EntryPoints);
+  /// Loads the parameterized IR file and creates the linear-constant problem
+  /// on it, rooted at the global-ctor model if the module has one.
+  std::pair<IDELinearConstantAnalysis &, const LLVMBasedICFG &> initialize() {
+    HA.emplace(PathToLlFiles + GetParam(), EntryPoints);
 
-  // Compute the ICFG to possibly create the runtime model
-  auto &ICFG = HA.getICFG();
+    // Compute the ICFG to possibly create the runtime model
+    auto &ICFG = HA->getICFG();
 
-  auto HasGlobalCtor = HA.getProjectIRDB().getFunctionDefinition(
-                           LLVMBasedICFG::GlobalCRuntimeModelName) != nullptr;
+    auto HasGlobalCtor = HA->getProjectIRDB().getFunctionDefinition(
+                             LLVMBasedICFG::GlobalCRuntimeModelName) != nullptr;
 
-  auto LCAProblem = createAnalysisProblem<IDELinearConstantAnalysis>(
-      HA,
-      std::vector{HasGlobalCtor ? LLVMBasedICFG::GlobalCRuntimeModelName.str()
-                                : "main"});
+    Problem.emplace(
+        &HA->getProjectIRDB(), &ICFG,
+        std::vector{HasGlobalCtor ? LLVMBasedICFG::GlobalCRuntimeModelName.str()
+                                  : "main"});
+    return {*Problem, ICFG};
+  }
+}; // Test Fixture
+
+TEST_P(LinearConstant, ResultsEquivalentSolveUntil) {
+  auto Setup = initialize();
+  auto &LCAProblem = Setup.first;
+  const auto &ICFG = Setup.second;
 
   auto AtomicResults = IDESolver(LCAProblem, &ICFG).solve();
   {
@@ -67,18 +84,9 @@ TEST_P(LinearConstant, ResultsEquivalentSolveUntil) {
 }
 
 TEST_P(LinearConstant, ResultsEquivalentSolveUntilAsync) {
-  HelperAnalyses HA(PathToLlFiles + GetParam(), EntryPoints);
-
-  // Compute the ICFG to possibly create the runtime model
-  auto &ICFG = HA.getICFG();
-
-  auto HasGlobalCtor = HA.getProjectIRDB().getFunctionDefinition(
-                           LLVMBasedICFG::GlobalCRuntimeModelName) != nullptr;
-
-  auto LCAProblem = createAnalysisProblem<IDELinearConstantAnalysis>(
-      HA,
-      std::vector{HasGlobalCtor ? LLVMBasedICFG::GlobalCRuntimeModelName.str()
-                                : "main"});
+  auto Setup = initialize();
+  auto &LCAProblem = Setup.first;
+  const auto &ICFG = Setup.second;
 
   auto AtomicResults = IDESolver(LCAProblem, &ICFG).solve();
 
@@ -113,6 +121,170 @@ TEST_P(LinearConstant, ResultsEquivalentSolveUntilAsync) {
   }
 }
 
+TEST_P(LinearConstant, ResultsEquivalentParallel) {
+  auto Setup = initialize();
+  auto &LCAProblem = Setup.first;
+  const auto &ICFG = Setup.second;
+
+  auto AtomicResults = IDESolver(LCAProblem, &ICFG).solve();
+
+  for (unsigned NumThreads : {2, 4}) {
+    LCAProblem.getIFDSIDESolverConfig().setNumThreads(NumThreads);
+    auto ParallelResults = IDESolver(LCAProblem, &ICFG).solve();
+
+    EXPECT_EQ(AtomicResults.getAllResultEntries().size(),
+              ParallelResults.getAllResultEntries().size());
+    for (auto &&Cell : AtomicResults.getAllResultEntries()) {
+      auto ParallelRes =
+          ParallelResults.resultAt(Cell.getRowKey(), Cell.getColumnKey());
+      EXPECT_EQ(ParallelRes, Cell.getValue());
+    }
+  }
+}
+
+TEST_P(LinearConstant, ResultsEquivalentParallelInterrupted) {
+  auto Setup = initialize();
+  auto &LCAProblem = Setup.first;
+  const auto &ICFG = Setup.second;
+
+  auto AtomicResults = IDESolver(LCAProblem, &ICFG).solve();
+
+  LCAProblem.getIFDSIDESolverConfig().setNumThreads(4);
+  auto InterruptedResults = [&] {
+    IDESolver Solver(LCAProblem, &ICFG);
+    // The workers stop before processing any item; the rest of the work is
+    // done sequentially
+    std::atomic_bool IsCancelled = true;
+    auto Result = Solver.solveWithAsyncCancellation(IsCancelled);
+    EXPECT_EQ(std::nullopt, Result);
+    if (!Result) {
+      IsCancelled = false;
+      return std::move(Solver)
+          .continueWithAsyncCancellation(IsCancelled)
+          .value();
+    }
+    return Solver.consumeSolverResults();
+  }();
+
+  EXPECT_EQ(AtomicResults.getAllResultEntries().size(),
+            InterruptedResults.getAllResultEntries().size());
+  for (auto &&Cell : AtomicResults.getAllResultEntries()) {
+    auto InterruptedRes =
+        InterruptedResults.resultAt(Cell.getRowKey(), Cell.getColumnKey());
+    EXPECT_EQ(InterruptedRes, Cell.getValue());
+  }
+}
+
+TEST_P(LinearConstant, ResultsEquivalentWorkListPolicies) {
+  auto Setup = initialize();
+  auto &LCAProblem = Setup.first;
+  const auto &ICFG = Setup.second;
+
+  auto AtomicResults = IDESolver(LCAProblem, &ICFG).solve();
+
+  for (auto Policy :
+       {WorkListPolicy::BreadthFirst, WorkListPolicy::ReversePostOrder,
+        WorkListPolicy::CallGraphSCC}) {
+    LCAProblem.getIFDSIDESolverConfig().setWorkListPolicy(Policy);
+    auto PolicyResults = IDESolver(LCAProblem, &ICFG).solve();
+
+    EXPECT_EQ(AtomicResults.getAllResultEntries().size(),
+              PolicyResults.getAllResultEntries().size())
+        << "with the " << toString(Policy) << " worklist policy";
+    for (auto &&Cell : AtomicResults.getAllResultEntries()) {
+      EXPECT_EQ(Cell.getValue(),
+                PolicyResults.resultAt(Cell.getRowKey(), Cell.getColumnKey()))
+          << "with the " << toString(Policy) << " worklist policy";
+    }
+  }
+}
+
+TEST_P(LinearConstant, FrozenResultsEquivalent) {
+  auto Setup = initialize();
+  auto &LCAProblem = Setup.first;
+  const auto &ICFG = Setup.second;
+
+  auto AtomicResults = IDESolver(LCAProblem, &ICFG).solve();
+
+  IDESolver Solver(LCAProblem, &ICFG);
+  Solver.solve();
+  auto FrozenResults = Solver.freezeSolverResults();
+
+  auto AllEntries = AtomicResults.getAllResultEntries();
+  EXPECT_EQ(AllEntries.size(), FrozenResults.size());
+  EXPECT_EQ(AllEntries.size(), FrozenResults.getAllResultEntries().size());
+  for (auto &&Cell : AllEntries) {
+    EXPECT_EQ(Cell.getValue(),
+              FrozenResults.resultAt(Cell.getRowKey(), Cell.getColumnKey()));
+  }
+  for (const auto *Stmt : HA->getProjectIRDB().getAllInstructions()) {
+    auto Facts = FrozenResults.factsAt(Stmt);
+    auto Values = FrozenResults.valuesAt(Stmt);
+    ASSERT_EQ(Facts.size(), Values.size());
+    EXPECT_EQ(AtomicResults.resultsAt(Stmt).size(), Facts.size());
+    for (size_t I = 0; I != Facts.size(); ++I) {
+      EXPECT_EQ(AtomicResults.resultAt(Stmt, Facts[I]), Values[I]);
+    }
+  }
+}
+
+/// Replays the jump functions that a previous solver has computed on the same
+/// program for all functions but main.
+class ReplayingSummaryProvider
+    : public SummaryProvider<IDELinearConstantAnalysisDomain> {
+public:
+  explicit ReplayingSummaryProvider(
+      const IDESolver_P<IDELinearConstantAnalysis> &PrevSolver)
+      : PrevSolver(PrevSolver) {}
+
+  bool provideJumpFunctions(const llvm::Instruction *StartPoint,
+                            const llvm::Value *SourceVal,
+                            JumpFunctionHandler Handler) override {
+    const auto *Fun = StartPoint->getFunction();
+    if (Fun->getName() == "main") {
+      return false;
+    }
+    ++NumProvided;
+    for (const auto &Inst : llvm::instructions(Fun)) {
+      PrevSolver.getJumpFunctions().forwardLookup(
+          SourceVal, &Inst,
+          [&](const llvm::Value *TargetVal,
+              EdgeFunction<IDELinearConstantAnalysisDomain::l_t> EF) {
+            Handler(&Inst, TargetVal, EF);
+          });
+    }
+    return true;
+  }
+
+  const IDESolver_P<IDELinearConstantAnalysis> &PrevSolver;
+  size_t NumProvided = 0;
+};
+
+TEST_P(LinearConstant, ResultsEquivalentProvidedSummaries) {
+  auto Setup = initialize();
+  auto &LCAProblem = Setup.first;
+  const auto &ICFG = Setup.second;
+
+  IDESolver PrevSolver(LCAProblem, &ICFG);
+  auto AtomicResults = PrevSolver.solve();
+
+  ReplayingSummaryProvider Provider(PrevSolver);
+  IDESolver Solver(LCAProblem, &ICFG);
+  Solver.setSummaryProvider(&Provider);
+  auto ReplayedResults = Solver.solve();
+
+  if (llvm::StringRef(GetParam()).startswith("call_")) {
+    EXPECT_NE(0, Provider.NumProvided);
+  }
+  EXPECT_EQ(AtomicResults.getAllResultEntries().size(),
+            ReplayedResults.getAllResultEntries().size());
+  for (auto &&Cell : AtomicResults.getAllResultEntries()) {
+    auto ReplayedRes =
+        ReplayedResults.resultAt(Cell.getRowKey(), Cell.getColumnKey());
+    EXPECT_EQ(ReplayedRes, Cell.getValue());
+  }
+}
+
 static constexpr std::string_view LCATestFiles[] = {
     "basic_01.dbg.ll",
     "basic_02.dbg.ll",
@@ -0,0 +1,196 @@
+#include "phasar/DataFlow/IfdsIde/Solver/JumpFunctions.h"
+
+#include "phasar/DataFlow/IfdsIde/EdgeFunction.h"
+#include "phasar/DataFlow/IfdsIde/EdgeFunctionUtils.h"
+#include "phasar/DataFlow/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/HelperAnalyses.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMAliasSet.h"
+#include "phasar/PhasarLLVM/SimpleAnalysisConstructor.h"
+
+#include "llvm/IR/InstIterator.h"
+
+#include "TestConfig.h"
+#include "gtest/gtest.h"
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace psr;
+
+namespace {
+
+using domain_t = IDELinearConstantAnalysisDomain;
+using l_t = domain_t::l_t;
+using d_t = domain_t::d_t;
+using n_t = domain_t::n_t;
+using JumpFunctions_t = JumpFunctions<domain_t, std::set<d_t>>;
+
+class JumpFunctionsTest : public ::testing::Test {
+protected:
+  static constexpr auto PathToLlFiles =
+      PHASAR_BUILD_SUBFOLDER("linear_constant/");
+  const std::vector<std::string> EntryPoints = {"main"};
+
+  void SetUp() override { ValueAnnotationPass::resetValueID(); }
+
+  static std::vector<n_t> getInstructions(const llvm::Function *F) {
+    std::vector<n_t> Ret;
+    for (const auto &Inst : llvm::instructions(F)) {
+      Ret.push_back(&Inst);
+    }
+    return Ret;
+  }
+};
+
+} // namespace
+
+TEST_F(JumpFunctionsTest, AddLookupAndRemove) {
+  HelperAnalyses HA(PathToLlFiles + "basic_01.dbg.ll", EntryPoints);
+  auto Problem = createAnalysisProblem<IDELinearConstantAnalysis>(HA,
+                                                                  EntryPoints);
+  const auto *Main = HA.getProjectIRDB().getFunctionDefinition("main");
+  ASSERT_NE(nullptr, Main);
+  auto Insts = getInstructions(Main);
+  ASSERT_GE(Insts.size(), 3);
+
+  const d_t Zero = Problem.getZeroValue();
+  const d_t A = Insts[0];
+  const d_t B = Insts[1];
+  const n_t Target = Insts[2];
+  const n_t OtherTarget = Insts[1];
+  const EdgeFunction<l_t> Top = AllTop<l_t>{};
+  const EdgeFunction<l_t> Id = EdgeIdentity<l_t>{};
+  const EdgeFunction<l_t> Const42 = ConstantEdgeFunction<l_t>{42};
+
+  JumpFunctions_t JumpFn(Problem);
+  EXPECT_EQ(0, JumpFn.size());
+  EXPECT_EQ(Top, JumpFn.lookup(Zero, Target, A, Top));
+
+  // The default function is not stored
+  JumpFn.addFunction(Zero, Target, A, Top);
+  EXPECT_EQ(0, JumpFn.size());
+
+  JumpFn.addFunction(Zero, Target, A, Const42);
+  JumpFn.addFunction(A, Target, A, Id);
+  JumpFn.addFunction(A, Target, B, Id);
+  JumpFn.addFunction(Zero, OtherTarget, Zero, Id);
+  EXPECT_EQ(4, JumpFn.size());
+  EXPECT_EQ(Const42, JumpFn.lookup(Zero, Target, A, Top));
+  EXPECT_EQ(Id, JumpFn.lookup(A, Target, B, Top));
+  EXPECT_EQ(Top, JumpFn.lookup(B, Target, A, Top));
+  EXPECT_EQ(Top, JumpFn.lookup(Zero, OtherTarget, A, Top));
+
+  // Existing jump functions are overwritten
+  const EdgeFunction<l_t> Const13 = ConstantEdgeFunction<l_t>{13};
+  JumpFn.addFunction(Zero, Target, A, Const13);
+  EXPECT_EQ(4, JumpFn.size());
+  EXPECT_EQ(Const13, JumpFn.lookup(Zero, Target, A, Top));
+
+  std::map<d_t, EdgeFunction<l_t>> Reverse;
+  JumpFn.reverseLookup(Target, A,
+                       [&Reverse](d_t Source, EdgeFunction<l_t> EF) {
+                         Reverse.emplace(Source, std::move(EF));
+                       });
+  EXPECT_EQ(2, Reverse.size());
+  EXPECT_EQ(Const13, Reverse[Zero]);
+  EXPECT_EQ(Id, Reverse[A]);
+
+  std::map<d_t, EdgeFunction<l_t>> Forward;
+  JumpFn.forwardLookup(A, Target,
+                       [&Forward](d_t TargetVal, EdgeFunction<l_t> EF) {
+                         Forward.emplace(TargetVal, std::move(EF));
+                       });
+  EXPECT_EQ(2, Forward.size());
+  EXPECT_EQ(Id, Forward[A]);
+  EXPECT_EQ(Id, Forward[B]);
+
+  size_t NumAtTarget = 0;
+  JumpFn.lookupByTarget(Target, [&](d_t Source, d_t TargetVal,
+                                    const EdgeFunction<l_t> &EF) {
+    ++NumAtTarget;
+    EXPECT_EQ(EF, JumpFn.lookup(Source, Target, TargetVal, Top));
+  });
+  EXPECT_EQ(3, NumAtTarget);
+
+  // Removing an entry that is not the last one moves the last one into its
+  // place; all indices must still be valid afterwards
+  EXPECT_TRUE(JumpFn.removeFunction(Zero, Target, A));
+  EXPECT_FALSE(JumpFn.removeFunction(Zero, Target, A));
+  EXPECT_FALSE(JumpFn.removeFunction(B, OtherTarget, Zero));
+  EXPECT_EQ(3, JumpFn.size());
+  EXPECT_EQ(Top, JumpFn.lookup(Zero, Target, A, Top));
+  EXPECT_EQ(Id, JumpFn.lookup(A, Target, A, Top));
+  EXPECT_EQ(Id, JumpFn.lookup(A, Target, B, Top));
+
+  size_t NumReverse = 0;
+  JumpFn.reverseLookup(Target, B, [&](d_t Source, EdgeFunction<l_t> EF) {
+    ++NumReverse;
+    EXPECT_EQ(A, Source);
+    EXPECT_EQ(Id, EF);
+  });
+  EXPECT_EQ(1, NumReverse);
+
+  EXPECT_TRUE(JumpFn.removeFunction(A, Target, B));
+  EXPECT_TRUE(JumpFn.removeFunction(A, Target, A));
+  NumAtTarget = 0;
+  JumpFn.lookupByTarget(Target, [&NumAtTarget](d_t, d_t,
+                                               const EdgeFunction<l_t> &) {
+    ++NumAtTarget;
+  });
+  EXPECT_EQ(0, NumAtTarget);
+  EXPECT_EQ(1, JumpFn.size());
+
+  JumpFn.clear();
+  EXPECT_EQ(0, JumpFn.size());
+  EXPECT_EQ(Top, JumpFn.lookup(Zero, OtherTarget, Zero, Top));
+}
+
+TEST_F(JumpFunctionsTest, ConsistentAfterSolving) {
+  HelperAnalyses HA(PathToLlFiles + "call_06.dbg.ll", EntryPoints);
+  auto Problem = createAnalysisProblem<IDELinearConstantAnalysis>(HA,
+                                                                  EntryPoints);
+  IDESolver Solver(Problem, &HA.getICFG());
+  Solver.solve();
+
+  const auto &JumpFn = Solver.getJumpFunctions();
+  const EdgeFunction<l_t> Top = AllTop<l_t>{};
+  size_t NumJumpFunctions = 0;
+  for (const auto *F : HA.getProjectIRDB().getAllFunctions()) {
+    for (const auto *Inst : getInstructions(F)) {
+      JumpFn.lookupByTarget(Inst, [&](d_t Source, d_t TargetVal,
+                                      const EdgeFunction<l_t> &EF) {
+        ++NumJumpFunctions;
+        EXPECT_FALSE(llvm::isa<AllTop<l_t>>(EF));
+        EXPECT_EQ(EF, JumpFn.lookup(Source, Inst, TargetVal, Top));
+
+        size_t NumReverse = 0;
+        JumpFn.reverseLookup(Inst, TargetVal,
+                             [&](d_t RevSource, EdgeFunction<l_t> RevEF) {
+                               if (RevSource == Source) {
+                                 ++NumReverse;
+                                 EXPECT_EQ(EF, RevEF);
+                               }
+                             });
+        EXPECT_EQ(1, NumReverse);
+
+        size_t NumForward = 0;
+        JumpFn.forwardLookup(Source, Inst,
+                             [&](d_t FwdTarget, EdgeFunction<l_t> FwdEF) {
+                               if (FwdTarget == TargetVal) {
+                                 ++NumForward;
+                                 EXPECT_EQ(EF, FwdEF);
+                               }
+                             });
+        EXPECT_EQ(1, NumForward);
+      });
+    }
+  }
+  EXPECT_GT(NumJumpFunctions, 0);
+  EXPECT_EQ(NumJumpFunctions, JumpFn.size());
+}
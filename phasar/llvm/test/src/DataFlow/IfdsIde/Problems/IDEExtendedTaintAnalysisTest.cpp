@@ -328,6 +328,49 @@ TEST_F(IDETaintAnalysisTest, XTaint20) {
   doAnalysis({PathToLLFiles + "xtaint20.ll"}, Gt, std::monostate{});
 }
 
+TEST_F(IDETaintAnalysisTest, XTaint20_LeakCallbackWithStrongUpdates) {
+  HelperAnalyses HA({PathToLLFiles + "xtaint20.ll"}, EntryPoints);
+  LLVMTaintConfig TC(HA.getProjectIRDB());
+  auto TaintProblem =
+      createAnalysisProblem<IDEExtendedTaintAnalysis<>>(HA, TC, EntryPoints);
+
+  XTaint::LeakMap_t StreamedLeaks;
+  TaintProblem.setLeakCallback(
+      [&StreamedLeaks](const llvm::Instruction *Sink, const llvm::Value *Leak) {
+        EXPECT_TRUE(StreamedLeaks[Sink].insert(Leak).second);
+      });
+
+  IDESolver Solver(TaintProblem, &HA.getICFG());
+  Solver.solve();
+  // The leaks of the IFDS part may still be sanitized
+  EXPECT_TRUE(StreamedLeaks.empty());
+
+  const auto &Leaks = TaintProblem.getAllLeaks(Solver.getSolverResults());
+  EXPECT_FALSE(Leaks.empty());
+  EXPECT_EQ(Leaks, StreamedLeaks);
+}
+
+TEST_F(IDETaintAnalysisTest, XTaint20_LeakCallbackWithoutStrongUpdates) {
+  HelperAnalyses HA({PathToLLFiles + "xtaint20.ll"}, EntryPoints);
+  LLVMTaintConfig TC(HA.getProjectIRDB());
+  auto TaintProblem =
+      createAnalysisProblem<IDEExtendedTaintAnalysis<3, false>>(HA, TC,
+                                                                 EntryPoints);
+
+  XTaint::LeakMap_t StreamedLeaks;
+  TaintProblem.setLeakCallback(
+      [&StreamedLeaks](const llvm::Instruction *Sink, const llvm::Value *Leak) {
+        EXPECT_TRUE(StreamedLeaks[Sink].insert(Leak).second);
+      });
+
+  IDESolver Solver(TaintProblem, &HA.getICFG());
+  Solver.solve();
+  // Without strong updates, all leaks are final as soon as they are found
+  EXPECT_FALSE(StreamedLeaks.empty());
+  EXPECT_EQ(TaintProblem.getAllLeaks(Solver.getSolverResults()),
+            StreamedLeaks);
+}
+
 TEST_F(IDETaintAnalysisTest, XTaint21) {
   map<int, set<string>> Gt;
 
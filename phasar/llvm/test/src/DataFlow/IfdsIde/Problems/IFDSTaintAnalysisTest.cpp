@@ -3,6 +3,7 @@
 #include "phasar/DataFlow/IfdsIde/Solver/IFDSSolver.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
 #include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/TaintLeakReporting.h"
 #include "phasar/PhasarLLVM/HelperAnalyses.h"
 #include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMAliasSet.h"
@@ -14,6 +15,7 @@
 #include "gtest/gtest.h"
 
 #include <memory>
+#include <tuple>
 #include <vector>
 
 using namespace std;
@@ -247,3 +249,54 @@ TEST_F(IFDSTaintAnalysisTest, TaintTest_ExceptionHandling_10) {
   GroundTruth[62] = set<string>{"61"};
   compareResults(GroundTruth);
 }
+
+TEST_F(IFDSTaintAnalysisTest, TaintTest_04_LeakCallback) {
+  initialize({PathToLlFiles + "dummy_source_sink/taint_04.dbg.ll"});
+  map<int, set<string>> StreamedLeaks;
+  TaintProblem->setLeakCallback([&StreamedLeaks](
+                                    const llvm::Instruction *Sink,
+                                    const llvm::Value *Leak) {
+    auto Inserted = StreamedLeaks[stoi(getMetaDataID(Sink))]
+                        .insert(getMetaDataID(Leak))
+                        .second;
+    EXPECT_TRUE(Inserted) << "Leak reported twice";
+  });
+  IFDSSolver TaintSolver(*TaintProblem, &HA->getICFG());
+  TaintSolver.solve();
+  map<int, set<string>> GroundTruth;
+  GroundTruth[19] = set<string>{"18"};
+  GroundTruth[24] = set<string>{"23"};
+  EXPECT_EQ(GroundTruth, StreamedLeaks);
+  compareResults(GroundTruth);
+}
+
+TEST_F(IFDSTaintAnalysisTest, TaintTest_04_StopAfterFirstLeak) {
+  initialize({PathToLlFiles + "dummy_source_sink/taint_04.dbg.ll"});
+  TaintLeakStopCondition Stop(/*MaxLeaks*/ 1);
+  TaintProblem->setLeakCallback(Stop.makeCallback());
+  IFDSSolver TaintSolver(*TaintProblem, &HA->getICFG());
+  auto Results =
+      TaintSolver.solveWithAsyncCancellation(Stop.getCancellationFlag());
+  EXPECT_FALSE(Results.has_value());
+  EXPECT_TRUE(Stop.isStopRequested());
+  EXPECT_EQ(1U, Stop.getNumLeaks());
+  ASSERT_EQ(1U, TaintProblem->Leaks.size());
+  // The first sink is reached first
+  EXPECT_EQ("19", getMetaDataID(TaintProblem->Leaks.begin()->first));
+}
+
+TEST_F(IFDSTaintAnalysisTest, TaintTest_04_StopAtAllSinks) {
+  initialize({PathToLlFiles + "dummy_source_sink/taint_04.dbg.ll"});
+  auto Sinks = collectSinkCallSites(HA->getICFG(), *TSF);
+  EXPECT_EQ(2U, Sinks.size());
+  TaintLeakStopCondition Stop(std::move(Sinks));
+  TaintProblem->setLeakCallback(Stop.makeCallback());
+  IFDSSolver TaintSolver(*TaintProblem, &HA->getICFG());
+  std::ignore =
+      TaintSolver.solveWithAsyncCancellation(Stop.getCancellationFlag());
+  EXPECT_TRUE(Stop.isStopRequested());
+  map<int, set<string>> GroundTruth;
+  GroundTruth[19] = set<string>{"18"};
+  GroundTruth[24] = set<string>{"23"};
+  compareResults(GroundTruth);
+}
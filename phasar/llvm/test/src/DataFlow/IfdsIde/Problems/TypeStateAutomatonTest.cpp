@@ -0,0 +1,180 @@
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/TypeStateDescriptions/TypeStateAutomaton.h"
+
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/TypeStateDescriptions/CSTDFILEIOTypeStateDescription.h"
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/TypeStateDescriptions/OpenSSLEVPKDFDescription.h"
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/TypeStateDescriptions/OpenSSLSecureMemoryDescription.h"
+
+#include "gtest/gtest.h"
+#include "nlohmann/json.hpp"
+
+#include <initializer_list>
+#include <set>
+#include <string>
+#include <utility>
+
+using namespace psr;
+
+namespace {
+
+enum IOSTATE {
+  TOP = 42,
+  UNINIT = 0,
+  OPENED = 1,
+  CLOSED = 2,
+  ERROR = 3,
+  BOT = 4
+};
+
+// The former hand-written transition table of the
+// CSTDFILEIOTypeStateDescription: Delta[Token][State] = next State with
+// Token: FOPEN = 0, FCLOSE = 1, STAR = 2
+const int FileIODelta[3][5] = {
+    /* FOPEN */ {OPENED, OPENED, OPENED, ERROR, OPENED},
+    /* FCLOSE */ {ERROR, CLOSED, ERROR, ERROR, BOT},
+    /* STAR */ {ERROR, OPENED, ERROR, ERROR, BOT},
+};
+
+const nlohmann::json FileIOJson = R"({
+  "type": "struct._IO_FILE",
+  "states": {"TOP": 42, "UNINIT": 0, "OPENED": 1, "CLOSED": 2, "ERROR": 3,
+             "BOT": 4},
+  "top": "TOP", "bottom": "BOT", "uninit": "UNINIT", "start": "OPENED",
+  "error": "ERROR",
+  "tokens": {
+    "FOPEN": {"fopen": [-1], "fdopen": [-1]},
+    "FCLOSE": {"fclose": [0]},
+    "STAR": {"fread": [3], "fgets": [2], "fputc": [1], "fprintf": [0]}
+  },
+  "transitions": {
+    "FOPEN": {"UNINIT": "OPENED", "OPENED": "OPENED", "CLOSED": "OPENED",
+              "BOT": "OPENED"},
+    "FCLOSE": {"OPENED": "CLOSED", "BOT": "BOT"},
+    "STAR": {"OPENED": "OPENED", "BOT": "BOT"}
+  }
+})"_json;
+
+void checkFileIOTransitions(const TypeStateDescription &Desc) {
+  const std::pair<std::string, int> Functions[] = {
+      {"fopen", 0}, {"fdopen", 0}, {"fclose", 1}, {"fread", 2},
+      {"fgets", 2}, {"fputc", 2},  {"fprintf", 2}};
+  for (const auto &[F, Token] : Functions) {
+    SCOPED_TRACE(F);
+    ASSERT_TRUE(Desc.isAPIFunction(F));
+    auto Tok = Desc.getTokenId(F);
+    ASSERT_TRUE(Tok.has_value());
+    for (int S = UNINIT; S <= BOT; ++S) {
+      EXPECT_EQ(FileIODelta[Token][S], Desc.getNextState(F, S));
+      EXPECT_EQ(FileIODelta[Token][S],
+                Desc.getNextStateById(*Tok, S, nullptr));
+    }
+  }
+  EXPECT_FALSE(Desc.isAPIFunction("main"));
+  EXPECT_FALSE(Desc.getTokenId("main").has_value());
+  EXPECT_EQ(BOT, Desc.getNextState("main", OPENED));
+
+  EXPECT_TRUE(Desc.isFactoryFunction("fopen"));
+  EXPECT_FALSE(Desc.isConsumingFunction("fopen"));
+  EXPECT_EQ(std::set<int>{-1}, Desc.getFactoryParamIdx("fopen"));
+  EXPECT_TRUE(Desc.isConsumingFunction("fread"));
+  EXPECT_FALSE(Desc.isFactoryFunction("fread"));
+  EXPECT_EQ(std::set<int>{3}, Desc.getConsumerParamIdx("fread"));
+  EXPECT_TRUE(Desc.getConsumerParamIdx("fopen").empty());
+
+  EXPECT_EQ("struct._IO_FILE", Desc.getTypeNameOfInterest());
+  EXPECT_EQ(TOP, Desc.top());
+  EXPECT_EQ(BOT, Desc.bottom());
+  EXPECT_EQ(UNINIT, Desc.uninit());
+  EXPECT_EQ(OPENED, Desc.start());
+  EXPECT_EQ(ERROR, Desc.error());
+  EXPECT_EQ("CLOSED", Desc.stateToString(CLOSED));
+}
+
+/// Compares Desc with a former hand-written transition table Delta with one
+/// row per token and one column per state value in [0, NumStates)
+template <size_t NumTokens, size_t NumStates>
+void checkTransitions(
+    const TypeStateDescription &Desc, const int (&Delta)[NumTokens][NumStates],
+    std::initializer_list<std::pair<std::string, int>> Functions) {
+  for (const auto &[F, Token] : Functions) {
+    SCOPED_TRACE(F);
+    ASSERT_TRUE(Desc.isAPIFunction(F));
+    auto Tok = Desc.getTokenId(F);
+    ASSERT_TRUE(Tok.has_value());
+    for (int S = 0; S != int(NumStates); ++S) {
+      EXPECT_EQ(Delta[Token][S], Desc.getNextState(F, S));
+      EXPECT_EQ(Delta[Token][S], Desc.getNextStateById(*Tok, S, nullptr));
+    }
+  }
+}
+
+} // namespace
+
+TEST(TypeStateAutomatonTest, CSTDFILEIOTransitions) {
+  CSTDFILEIOTypeStateDescription Desc;
+  checkFileIOTransitions(Desc);
+  EXPECT_EQ(6, Desc.getNumStates());
+  EXPECT_EQ(3, Desc.getNumTokens());
+  EXPECT_EQ("FCLOSE", Desc.tokenToString(*Desc.getTokenId("fclose")));
+}
+
+TEST(TypeStateAutomatonTest, FromJson) {
+  auto Automaton = TypeStateAutomaton::fromJson(FileIOJson);
+  ASSERT_TRUE(Automaton.has_value());
+  checkFileIOTransitions(*Automaton);
+}
+
+TEST(TypeStateAutomatonTest, InvalidJson) {
+  auto UnknownState = FileIOJson;
+  UnknownState["transitions"]["FCLOSE"]["OPENED"] = "FREED";
+  EXPECT_FALSE(TypeStateAutomaton::fromJson(UnknownState).has_value());
+
+  auto UnknownToken = FileIOJson;
+  UnknownToken["transitions"]["FFLUSH"] = nlohmann::json::object();
+  EXPECT_FALSE(TypeStateAutomaton::fromJson(UnknownToken).has_value());
+
+  auto MissingRole = FileIOJson;
+  MissingRole.erase("error");
+  EXPECT_FALSE(TypeStateAutomaton::fromJson(MissingRole).has_value());
+
+  auto DuplicateFunction = FileIOJson;
+  DuplicateFunction["tokens"]["STAR"]["fclose"] = {0};
+  EXPECT_FALSE(TypeStateAutomaton::fromJson(DuplicateFunction).has_value());
+}
+
+TEST(TypeStateAutomatonTest, OpenSSLEVPKDFTransitions) {
+  // States: UNINIT = 0, KDF_FETCHED = 1, ERROR = 2, BOT = 3
+  const int Delta[2][4] = {
+      /* EVP_KDF_FETCH */ {1, 2, 2, 1},
+      /* EVP_KDF_FREE */ {2, 0, 2, 3},
+  };
+  OpenSSLEVPKDFDescription Desc;
+  checkTransitions(Desc, Delta, {{"EVP_KDF_fetch", 0}, {"EVP_KDF_free", 1}});
+  EXPECT_TRUE(Desc.isFactoryFunction("EVP_KDF_fetch"));
+  EXPECT_EQ(std::set<int>{0}, Desc.getConsumerParamIdx("EVP_KDF_free"));
+  EXPECT_EQ("struct.evp_kdf_st", Desc.getTypeNameOfInterest());
+  EXPECT_EQ(OpenSSLEVPKDFDescription::KDF_FETCHED, Desc.start());
+  EXPECT_EQ("KDF_FETCHED",
+            Desc.stateToString(OpenSSLEVPKDFDescription::KDF_FETCHED));
+}
+
+TEST(TypeStateAutomatonTest, OpenSSLSecureMemoryTransitions) {
+  // States: BOT = 0, ZEROED = 1, FREED = 2, ERROR = 3, ALLOCATED = 4
+  const int Delta[4][5] = {
+      /* CRYPTO_MALLOC */ {4, 4, 4, 3, 4},
+      /* CRYPTO_ZALLOC */ {1, 1, 1, 3, 1},
+      /* CRYPTO_FREE */ {3, 2, 3, 3, 3},
+      /* OPENSSL_CLEANSE */ {0, 1, 3, 3, 1},
+  };
+  OpenSSLSecureMemoryDescription Desc;
+  checkTransitions(Desc, Delta,
+                   {{"CRYPTO_malloc", 0},
+                    {"CRYPTO_zalloc", 1},
+                    {"CRYPTO_free", 2},
+                    {"OPENSSL_cleanse", 3}});
+  EXPECT_TRUE(Desc.isFactoryFunction("CRYPTO_zalloc"));
+  EXPECT_TRUE(Desc.isConsumingFunction("OPENSSL_cleanse"));
+  EXPECT_FALSE(Desc.isAPIFunction("malloc"));
+  EXPECT_EQ(0, Desc.uninit());
+  EXPECT_EQ(4, Desc.start());
+  EXPECT_EQ("ZEROED", Desc.stateToString(1));
+}
@@ -0,0 +1,73 @@
+#include "phasar/DataFlow/Mono/Contexts/CallStringContextTree.h"
+
+#include "phasar/DataFlow/Mono/Contexts/CallStringCTX.h"
+
+#include "gtest/gtest.h"
+
+#include <random>
+#include <vector>
+
+using namespace psr;
+
+namespace {
+
+template <unsigned K> void compareWithCallStringCTX() {
+  std::vector<int> CallSites(8);
+  CallStringContextTree<const int *, K> Tree;
+
+  std::mt19937 Rng(42); // NOLINT
+  std::uniform_int_distribution<size_t> Dist(0, CallSites.size() - 1);
+  std::bernoulli_distribution DoPush(0.6);
+
+  CallStringCTX<const int *, K> Expected;
+  auto Ctx = Tree.EmptyContext;
+  for (size_t I = 0; I < 1000; ++I) {
+    if (DoPush(Rng)) {
+      const auto *CallSite = &CallSites[Dist(Rng)];
+      Expected.push_back(CallSite);
+      Ctx = Tree.push(Ctx, CallSite);
+    } else {
+      auto ExpectedCallSite = Expected.pop_back();
+      auto [Caller, CallSite] = Tree.pop(Ctx);
+      EXPECT_EQ(ExpectedCallSite, CallSite);
+      Ctx = Caller;
+    }
+    ASSERT_EQ(Expected.size(), Tree.length(Ctx));
+    EXPECT_EQ(Expected.empty(), Tree.empty(Ctx));
+    EXPECT_EQ(Expected, Tree.getCallStringCTX(Ctx));
+  }
+}
+
+} // namespace
+
+TEST(CallStringContextTreeTest, PushAndPop) {
+  std::vector<int> CallSites(3);
+  CallStringContextTree<const int *, 2> Tree;
+
+  auto A = Tree.push(Tree.EmptyContext, &CallSites[0]);
+  auto AB = Tree.push(A, &CallSites[1]);
+  EXPECT_NE(A, AB);
+  // Interning yields the same id for the same call string
+  EXPECT_EQ(A, Tree.push(Tree.EmptyContext, &CallSites[0]));
+  EXPECT_EQ(AB, Tree.push(A, &CallSites[1]));
+
+  // K is reached, so the oldest call site is dropped
+  auto BC = Tree.push(AB, &CallSites[2]);
+  EXPECT_EQ(2U, Tree.length(BC));
+  auto B = Tree.push(Tree.EmptyContext, &CallSites[1]);
+  EXPECT_EQ(BC, Tree.push(B, &CallSites[2]));
+
+  auto [Caller, CallSite] = Tree.pop(BC);
+  EXPECT_EQ(B, Caller);
+  EXPECT_EQ(&CallSites[2], CallSite);
+
+  auto [EmptyCaller, NoCallSite] = Tree.pop(Tree.EmptyContext);
+  EXPECT_EQ(Tree.EmptyContext, EmptyCaller);
+  EXPECT_EQ(nullptr, NoCallSite);
+}
+
+TEST(CallStringContextTreeTest, BehavesLikeCallStringCTX) {
+  compareWithCallStringCTX<1>();
+  compareWithCallStringCTX<3>();
+  compareWithCallStringCTX<5>();
+}
@@ -89,6 +89,14 @@ static void analyze(llvm::StringRef File, const GroundTruthTy &Gt,
 
   LLVMAliasSet Deser(&IRDB, Ser);
   checkDeser(*IRDB.getModule(), PTS, Deser);
+
+  std::string Buf;
+  llvm::raw_string_ostream OS(Buf);
+  PTS.writeBinary(OS);
+  auto BinDeser =
+      LLVMAliasSet::loadBinary(&IRDB, llvm::MemoryBufferRef(OS.str(), File));
+  ASSERT_NE(nullptr, BinDeser);
+  checkDeser(*IRDB.getModule(), PTS, *BinDeser);
 }
 
 TEST(LLVMAliasSetSerializationTest, Ser_Intra01) {
@@ -6,10 +6,14 @@
 #include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToUtils.h"
 #include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "phasar/PhasarLLVM/Utils/LLVMShorthands.h"
 
 #include "TestConfig.h"
 #include "gtest/gtest.h"
 
+#include <thread>
+#include <vector>
+
 using namespace psr;
 
 TEST(LLVMAliasSet, Intra_01) {
@@ -61,3 +65,61 @@ TEST(LLVMAliasSet, Global_01) {
   PTS.print(llvm::outs());
   llvm::outs() << '\n';
 }
+
+TEST(LLVMAliasSet, ConcurrentQueriesAfterCompletion) {
+  ValueAnnotationPass::resetValueID();
+  LLVMProjectIRDB IRDB({"llvm_test_code/pointers/global_01.ll"});
+  LLVMAliasSet Eager(&IRDB, false);
+  LLVMAliasSet Lazy(&IRDB, true);
+  EXPECT_TRUE(Eager.isComplete());
+  EXPECT_FALSE(Lazy.isComplete());
+  Lazy.computeAllAliasSets();
+  EXPECT_TRUE(Lazy.isComplete());
+
+  std::vector<const llvm::Value *> Pointers;
+  for (const auto &G : IRDB.getModule()->globals()) {
+    Pointers.push_back(&G);
+  }
+  for (const auto *Inst : IRDB.getAllInstructions()) {
+    if (isInterestingPointer(Inst)) {
+      Pointers.push_back(Inst);
+    }
+  }
+
+  std::vector<std::thread> Threads;
+  for (unsigned I = 0; I < 4; ++I) {
+    Threads.emplace_back([&Lazy, &Pointers] {
+      for (const auto *V : Pointers) {
+        for (const auto *Alias : *Lazy.getAliasSet(V)) {
+          EXPECT_NE(AliasResult::NoAlias, Lazy.alias(V, Alias));
+        }
+      }
+    });
+  }
+  for (auto &Thread : Threads) {
+    Thread.join();
+  }
+
+  for (const auto *V : Pointers) {
+    EXPECT_EQ(*Eager.getAliasSet(V), *Lazy.getAliasSet(V));
+  }
+}
+
+TEST(LLVMAliasSet, ParallelEagerComputation) {
+  ValueAnnotationPass::resetValueID();
+  LLVMProjectIRDB IRDB({"llvm_test_code/pointers/call_01.ll"});
+  LLVMAliasSet Sequential(&IRDB, false);
+  LLVMAliasSet Parallel(&IRDB, false, AliasAnalysisType::CFLAnders, 4);
+  EXPECT_TRUE(Parallel.isComplete());
+
+  for (const auto *Inst : IRDB.getAllInstructions()) {
+    if (!isInterestingPointer(Inst)) {
+      continue;
+    }
+    EXPECT_EQ(*Sequential.getAliasSet(Inst), *Parallel.getAliasSet(Inst))
+        << "For " << llvmIRToString(Inst);
+  }
+  for (const auto &G : IRDB.getModule()->globals()) {
+    EXPECT_EQ(*Sequential.getAliasSet(&G), *Parallel.getAliasSet(&G));
+  }
+}
@@ -0,0 +1,120 @@
+#include "phasar/Pointer/UnionFindAliasSets.h"
+
+#include "phasar/Pointer/AliasSetOwner.h"
+
+#include "llvm/ADT/DenseSet.h"
+
+#include "gtest/gtest.h"
+
+#include <random>
+#include <vector>
+
+using namespace psr;
+
+namespace {
+
+using SetTy = llvm::DenseSet<const int *>;
+
+class UnionFindAliasSetsTest : public ::testing::Test {
+protected:
+  AliasSetOwner<SetTy>::memory_resource_type MRes;
+  AliasSetOwner<SetTy> Owner{&MRes};
+  UnionFindAliasSets<SetTy> AliasSets{Owner};
+  std::vector<int> Values = std::vector<int>(16);
+
+  [[nodiscard]] SetTy expectedSet(std::initializer_list<size_t> Indices) {
+    SetTy Ret;
+    for (auto Idx : Indices) {
+      Ret.insert(&Values[Idx]);
+    }
+    return Ret;
+  }
+
+  [[nodiscard]] BoxedPtr<SetTy> getAliasSet(size_t Idx) {
+    auto Id = *AliasSets.lookup(&Values[Idx]);
+    return AliasSets.getAliasSet(AliasSets.find(Id));
+  }
+};
+
+} // namespace
+
+TEST_F(UnionFindAliasSetsTest, MergeWithoutMaterialization) {
+  for (const auto &V : Values) {
+    AliasSets.insert(&V);
+  }
+  EXPECT_EQ(Values.size(), AliasSets.getNumClasses());
+
+  AliasSets.merge(&Values[0], &Values[1]);
+  AliasSets.merge(&Values[2], &Values[3]);
+  AliasSets.merge(&Values[1], &Values[3]);
+  AliasSets.merge(&Values[0], &Values[3]);
+
+  EXPECT_EQ(Values.size() - 3, AliasSets.getNumClasses());
+  auto Root = AliasSets.find(*AliasSets.lookup(&Values[2]));
+  EXPECT_EQ(4, AliasSets.getClassSize(Root));
+  EXPECT_FALSE(AliasSets.getMaterializedAliasSet(Root));
+
+  EXPECT_EQ(expectedSet({0, 1, 2, 3}), *getAliasSet(0));
+  EXPECT_EQ(expectedSet({4}), *getAliasSet(4));
+}
+
+TEST_F(UnionFindAliasSetsTest, MaterializedSetsFollowMerges) {
+  for (const auto &V : Values) {
+    AliasSets.insert(&V);
+  }
+
+  auto Lhs = getAliasSet(0);
+  AliasSets.merge(&Values[0], &Values[1]);
+  EXPECT_EQ(expectedSet({0, 1}), *Lhs);
+
+  auto Rhs = getAliasSet(2);
+  AliasSets.merge(&Values[2], &Values[3]);
+  AliasSets.merge(&Values[2], &Values[4]);
+  EXPECT_EQ(expectedSet({2, 3, 4}), *Rhs);
+
+  // Both materialized; the boxes of the smaller set must be forwarded
+  AliasSets.merge(&Values[1], &Values[4]);
+  EXPECT_EQ(Lhs.get(), Rhs.get());
+  EXPECT_EQ(expectedSet({0, 1, 2, 3, 4}), *Lhs);
+
+  // Forwarded boxes must follow subsequent merges as well
+  auto Other = getAliasSet(5);
+  AliasSets.merge(&Values[5], &Values[6]);
+  AliasSets.merge(&Values[5], &Values[7]);
+  AliasSets.merge(&Values[5], &Values[8]);
+  AliasSets.merge(&Values[5], &Values[9]);
+  AliasSets.merge(&Values[5], &Values[10]);
+  AliasSets.merge(&Values[0], &Values[10]);
+  EXPECT_EQ(Lhs.get(), Rhs.get());
+  EXPECT_EQ(Lhs.get(), Other.get());
+  EXPECT_EQ(expectedSet({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10}), *Rhs);
+}
+
+TEST_F(UnionFindAliasSetsTest, MaterializeAll) {
+  std::mt19937 Rng(42); // NOLINT
+  std::uniform_int_distribution<size_t> Dist(0, Values.size() - 1);
+
+  for (const auto &V : Values) {
+    AliasSets.insert(&V);
+  }
+  for (size_t I = 0; I < 8; ++I) {
+    AliasSets.merge(&Values[Dist(Rng)], &Values[Dist(Rng)]);
+  }
+  AliasSets.materializeAll();
+
+  size_t NumMaterialized = 0;
+  AliasSets.forEachClass([&](auto Root) {
+    auto PTS = AliasSets.getMaterializedAliasSet(Root);
+    ASSERT_TRUE(PTS);
+    EXPECT_EQ(AliasSets.getClassSize(Root), PTS->size());
+    AliasSets.forEachMember(
+        Root, [&PTS](const int *V) { EXPECT_TRUE(PTS->count(V)); });
+    ++NumMaterialized;
+  });
+  EXPECT_EQ(AliasSets.getNumClasses(), NumMaterialized);
+
+  for (const auto &V : Values) {
+    auto Id = *AliasSets.lookup(&V);
+    EXPECT_EQ(AliasSets.findRoot(Id), AliasSets.find(Id));
+  }
+}
@@ -15,6 +15,9 @@
 #include "boost/graph/isomorphism.hpp"
 #include "gtest/gtest.h"
 
+#include <string>
+#include <vector>
+
 using namespace std;
 using namespace psr;
 
@@ -519,6 +522,35 @@ TEST(LTHTest, VTableConstruction) {
   ASSERT_TRUE(TH6.getVFTable(TH6.getType("class.Base"))->size() == 3U);
 }
 
+TEST(LTHTest, BinaryRoundTrip) {
+  for (const auto *File : {"type_hierarchy_7.ll", "type_hierarchy_11.ll",
+                           "type_hierarchy_12.ll"}) {
+    LLVMProjectIRDB IRDB(
+        {"llvm_test_code/type_hierarchies/" + std::string(File)});
+    LLVMTypeHierarchy TH(IRDB);
+
+    std::string Buf;
+    llvm::raw_string_ostream OS(Buf);
+    TH.writeBinary(IRDB, OS);
+    auto Deser = LLVMTypeHierarchy::loadBinary(
+        IRDB, llvm::MemoryBufferRef(OS.str(), File));
+    ASSERT_NE(nullptr, Deser) << File;
+
+    EXPECT_EQ(TH.getAllTypes(), Deser->getAllTypes()) << File;
+    for (const auto *Type : TH.getAllTypes()) {
+      EXPECT_EQ(TH.getSubTypes(Type), Deser->getSubTypes(Type));
+      EXPECT_EQ(TH.getSuperTypes(Type), Deser->getSuperTypes(Type));
+      EXPECT_EQ(TH.hasVFTable(Type), Deser->hasVFTable(Type));
+      if (TH.hasVFTable(Type)) {
+        EXPECT_EQ(TH.getVFTable(Type)->getAllFunctions(),
+                  Deser->getVFTable(Type)->getAllFunctions());
+      }
+      auto Name = TH.getTypeName(Type);
+      EXPECT_EQ(TH.getType(Name), Deser->getType(Name));
+    }
+  }
+}
+
 TEST(LTHTest, TransitivelyReachableTypes) {
   LLVMProjectIRDB IRDB1(
       {"llvm_test_code/type_hierarchies/type_hierarchy_1.ll"});
@@ -756,4 +788,31 @@ PHASAR_SKIP_TEST(TEST(LTHTest, HandleSTLString) {
                              TH.getType("class.std::allocator")));
 })
 
+TEST(LTHTest, SubTypeQueriesAreConsistent) {
+  for (const char *File :
+       {"llvm_test_code/type_hierarchies/type_hierarchy_7.ll",
+        "llvm_test_code/type_hierarchies/type_hierarchy_11.ll",
+        "llvm_test_code/type_hierarchies/type_hierarchy_13.ll"}) {
+    LLVMProjectIRDB IRDB(File);
+    LLVMTypeHierarchy TH(IRDB);
+    EXPECT_EQ(TH.getAllTypes().size(), TH.size()) << File;
+    for (const auto *Type : TH.getAllTypes()) {
+      auto SubTypes = TH.getSubTypes(Type);
+      EXPECT_TRUE(SubTypes.count(Type)) << File;
+
+      size_t NumSubTypes = 0;
+      TH.forEachSubType(Type, [&](const llvm::StructType *SubType) {
+        EXPECT_TRUE(SubTypes.count(SubType)) << File;
+        ++NumSubTypes;
+      });
+      EXPECT_EQ(SubTypes.size(), NumSubTypes) << File;
+
+      for (const auto *Other : TH.getAllTypes()) {
+        EXPECT_EQ(SubTypes.count(Other) != 0, TH.isSubType(Type, Other))
+            << File;
+      }
+    }
+  }
+}
+
 } // namespace psr
@@ -0,0 +1,139 @@
+#include "phasar/PhasarLLVM/Utils/LLVMBinarySerialization.h"
+
+#include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMAliasSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "phasar/Utils/Logger.h"
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+
+using namespace psr;
+
+namespace {
+
+constexpr const char *Program = R"(
+@g = global i32 0
+
+define void @setInt(i32* %p) {
+entry:
+  store i32 42, i32* %p
+  ret void
+}
+
+define i32 @main() {
+entry:
+  %x = alloca i32
+  %px = alloca i32*
+  store i32* %x, i32** %px
+  %l = load i32*, i32** %px
+  call void @setInt(i32* %l)
+  call void @setInt(i32* @g)
+  ret i32 0
+}
+)";
+
+// Same program with an additional global variable
+constexpr const char *OtherProgram = R"(
+@g = global i32 0
+@h = global i32 0
+
+define void @setInt(i32* %p) {
+entry:
+  store i32 42, i32* %p
+  ret void
+}
+
+define i32 @main() {
+entry:
+  %x = alloca i32
+  %px = alloca i32*
+  store i32* %x, i32** %px
+  %l = load i32*, i32** %px
+  call void @setInt(i32* %l)
+  call void @setInt(i32* @g)
+  ret i32 0
+}
+)";
+
+std::string writeAliasSets(LLVMAliasSet &PTS) {
+  std::string Buf;
+  llvm::raw_string_ostream OS(Buf);
+  PTS.writeBinary(OS);
+  return OS.str();
+}
+
+class LLVMBinarySerializationTest : public ::testing::Test {
+protected:
+  void SetUp() override { Logger::disable(); }
+
+  LLVMProjectIRDB IRDB{llvm::MemoryBufferRef(Program, "program")};
+  LLVMAliasSet PTS{&IRDB, false};
+};
+
+} // namespace
+
+TEST_F(LLVMBinarySerializationTest, ValueIdsRoundTrip) {
+  LLVMValueIds Ids(IRDB);
+  size_t NumValues = 0;
+  auto Check = [&](const llvm::Value *V) {
+    auto Id = Ids.getId(V);
+    ASSERT_NE(LLVMValueIds::InvalidId, Id);
+    EXPECT_EQ(V, Ids.getValue(Id));
+    ++NumValues;
+  };
+
+  for (const auto &Glob : IRDB.getModule()->globals()) {
+    Check(&Glob);
+  }
+  for (const auto &Fun : *IRDB.getModule()) {
+    Check(&Fun);
+    for (const auto &Arg : Fun.args()) {
+      Check(&Arg);
+    }
+    for (const auto &Inst : llvm::instructions(Fun)) {
+      Check(&Inst);
+    }
+  }
+  EXPECT_EQ(NumValues, Ids.size());
+  EXPECT_EQ(nullptr, Ids.getValue(Ids.size()));
+}
+
+TEST_F(LLVMBinarySerializationTest, RejectWrongKind) {
+  auto Buf = writeAliasSets(PTS);
+  EXPECT_EQ(nullptr, LLVMTypeHierarchy::loadBinary(
+                         IRDB, llvm::MemoryBufferRef(Buf, "pta")));
+}
+
+TEST_F(LLVMBinarySerializationTest, RejectTruncated) {
+  auto Buf = writeAliasSets(PTS);
+  EXPECT_EQ(nullptr,
+            LLVMAliasSet::loadBinary(
+                &IRDB, llvm::MemoryBufferRef(
+                           llvm::StringRef(Buf).drop_back(4), "pta")));
+  EXPECT_EQ(nullptr,
+            LLVMAliasSet::loadBinary(
+                &IRDB, llvm::MemoryBufferRef(
+                           llvm::StringRef(Buf).take_front(16), "pta")));
+}
+
+TEST_F(LLVMBinarySerializationTest, RejectDifferentModule) {
+  auto Buf = writeAliasSets(PTS);
+  LLVMProjectIRDB OtherIRDB(llvm::MemoryBufferRef(OtherProgram, "other"));
+  EXPECT_EQ(nullptr, LLVMAliasSet::loadBinary(
+                         &OtherIRDB, llvm::MemoryBufferRef(Buf, "pta")));
+}
+
+TEST_F(LLVMBinarySerializationTest, RejectInvalidIds) {
+  auto Buf = writeAliasSets(PTS);
+  // The last word is the id of an analyzed function
+  Buf.back() = '\x7f';
+  EXPECT_EQ(nullptr,
+            LLVMAliasSet::loadBinary(&IRDB, llvm::MemoryBufferRef(Buf, "pta")));
+}
@@ -0,0 +1,121 @@
+#include "phasar/PhasarLLVM/Utils/LLVMFunctionHash.h"
+
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/SourceMgr.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+using namespace psr;
+
+namespace {
+
+constexpr const char *Original = R"(
+@g = global i32 0
+
+define i32 @callee(i32 %x) {
+entry:
+  %add = add nsw i32 %x, 1
+  ret i32 %add
+}
+
+define i32 @caller(i32 %n) {
+entry:
+  %c = icmp sgt i32 %n, 0
+  br i1 %c, label %then, label %exit
+then:
+  %r = call i32 @callee(i32 %n)
+  store i32 %r, i32* @g
+  br label %exit
+exit:
+  %p = phi i32 [ 0, %entry ], [ %r, %then ]
+  ret i32 %p
+}
+)";
+
+// Same code, but with renamed locals, debug info and a changed callee
+constexpr const char *Modified = R"(
+@g = global i32 0
+
+define i32 @callee(i32 %x) {
+entry:
+  %add = add nsw i32 %x, 2
+  ret i32 %add
+}
+
+define i32 @caller(i32 %num) !dbg !5 {
+entry:
+  %cmp = icmp sgt i32 %num, 0, !dbg !8
+  br i1 %cmp, label %if.then, label %if.end
+if.then:
+  %call = call i32 @callee(i32 %num), !dbg !8
+  store i32 %call, i32* @g
+  br label %if.end
+if.end:
+  %res = phi i32 [ 0, %entry ], [ %call, %if.then ]
+  ret i32 %res
+}
+
+!llvm.dbg.cu = !{!0}
+!llvm.module.flags = !{!3}
+!0 = distinct !DICompileUnit(language: DW_LANG_C99, file: !1, emissionKind: FullDebug)
+!1 = !DIFile(filename: "test.c", directory: "/")
+!3 = !{i32 2, !"Debug Info Version", i32 3}
+!5 = distinct !DISubprogram(name: "caller", scope: !1, file: !1, line: 1, type: !6, unit: !0)
+!6 = !DISubroutineType(types: !7)
+!7 = !{}
+!8 = !DILocation(line: 2, scope: !5)
+)";
+
+std::unique_ptr<llvm::Module> parse(llvm::StringRef IR, llvm::LLVMContext &Ctx) {
+  llvm::SMDiagnostic Diag;
+  auto Mod = llvm::parseAssemblyString(IR, Diag, Ctx);
+  if (!Mod) {
+    Diag.print("LLVMFunctionHashTest", llvm::errs());
+  }
+  return Mod;
+}
+
+} // namespace
+
+TEST(LLVMFunctionHashTest, StableAcrossContexts) {
+  llvm::LLVMContext Ctx1;
+  llvm::LLVMContext Ctx2;
+  auto Mod1 = parse(Original, Ctx1);
+  auto Mod2 = parse(Original, Ctx2);
+  ASSERT_TRUE(Mod1);
+  ASSERT_TRUE(Mod2);
+
+  for (const auto &Fun : *Mod1) {
+    const auto *Other = Mod2->getFunction(Fun.getName());
+    ASSERT_NE(nullptr, Other);
+    EXPECT_EQ(computeFunctionHash(Fun), computeFunctionHash(*Other));
+  }
+  EXPECT_NE(computeFunctionHash(*Mod1->getFunction("callee")),
+            computeFunctionHash(*Mod1->getFunction("caller")));
+}
+
+TEST(LLVMFunctionHashTest, IgnoresNamesAndDebugInfo) {
+  llvm::LLVMContext Ctx;
+  auto Mod1 = parse(Original, Ctx);
+  auto Mod2 = parse(Modified, Ctx);
+  ASSERT_TRUE(Mod1);
+  ASSERT_TRUE(Mod2);
+
+  EXPECT_EQ(computeFunctionHash(*Mod1->getFunction("caller")),
+            computeFunctionHash(*Mod2->getFunction("caller")));
+}
+
+TEST(LLVMFunctionHashTest, DetectsChangedInstructions) {
+  llvm::LLVMContext Ctx;
+  auto Mod1 = parse(Original, Ctx);
+  auto Mod2 = parse(Modified, Ctx);
+  ASSERT_TRUE(Mod1);
+  ASSERT_TRUE(Mod2);
+
+  EXPECT_NE(computeFunctionHash(*Mod1->getFunction("callee")),
+            computeFunctionHash(*Mod2->getFunction("callee")));
+}
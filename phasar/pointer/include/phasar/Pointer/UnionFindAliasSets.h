@@ -0,0 +1,275 @@
+/******************************************************************************
+ * Copyright (c) 2023 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_POINTER_UNIONFINDALIASSETS_H
+#define PHASAR_POINTER_UNIONFINDALIASSETS_H
+
+#include "phasar/Pointer/AliasInfoTraits.h"
+#include "phasar/Pointer/AliasSetOwner.h"
+#include "phasar/Utils/BoxedPointer.h"
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace llvm {
+class Value;
+class Instruction;
+} // namespace llvm
+
+namespace psr {
+
+/// Partitions values into alias classes using a union-find with path
+/// compression and union by size, such that merging two classes is
+/// near-constant time, independent of the size of the classes.
+///
+/// The alias set of a class is only materialized into a set of the
+/// AliasSetOwner when it is requested via getAliasSet(). Once materialized,
+/// the set is kept in sync on subsequent merges and all BoxedPtrs that have
+/// been handed out for the merged classes point to the merged set.
+template <typename AliasSetTy> class UnionFindAliasSets {
+public:
+  using v_t = typename AliasSetTy::value_type;
+  using id_t = uint32_t;
+
+  explicit UnionFindAliasSets(AliasSetOwner<AliasSetTy> &Owner) noexcept
+      : Owner(&Owner) {}
+
+  void reserve(size_t Capacity) {
+    Ids.reserve(Capacity);
+    Values.reserve(Capacity);
+    Parent.reserve(Capacity);
+    Size.reserve(Capacity);
+    Next.reserve(Capacity);
+    Sets.reserve(Capacity);
+  }
+
+  /// The number of values in all classes
+  [[nodiscard]] size_t size() const noexcept { return Values.size(); }
+  [[nodiscard]] bool empty() const noexcept { return Values.empty(); }
+  [[nodiscard]] size_t getNumClasses() const noexcept { return NumClasses; }
+
+  /// All values, indexed by their ids
+  [[nodiscard]] llvm::ArrayRef<v_t> values() const noexcept { return Values; }
+
+  [[nodiscard]] std::optional<id_t> lookup(v_t V) const {
+    if (auto It = Ids.find(V); It != Ids.end()) {
+      return It->second;
+    }
+    return std::nullopt;
+  }
+
+  /// Adds V as singleton class, if it is not contained yet
+  id_t insert(v_t V) {
+    auto [It, Inserted] = Ids.try_emplace(V, id_t(Values.size()));
+    if (Inserted) {
+      Values.push_back(V);
+      Parent.push_back(It->second);
+      Size.push_back(1);
+      Next.push_back(It->second);
+      Sets.emplace_back();
+      ++NumClasses;
+    }
+    return It->second;
+  }
+
+  /// Merges the classes of V1 and V2, inserting them first if necessary
+  void merge(v_t V1, v_t V2) { merge(insert(V1), insert(V2)); }
+
+  void merge(id_t Id1, id_t Id2) {
+    auto Root = find(Id1);
+    auto Child = find(Id2);
+    if (Root == Child) {
+      return;
+    }
+    if (Size[Root] < Size[Child]) {
+      std::swap(Root, Child);
+    }
+
+    Parent[Child] = Root;
+    Size[Root] += Size[Child];
+    // Splice the member lists: Root -> Child's members -> Root's members
+    std::swap(Next[Root], Next[Child]);
+    --NumClasses;
+
+    auto RootSet = Sets[Root];
+    auto ChildSet = std::exchange(Sets[Child], nullptr);
+    if (!RootSet && !ChildSet) {
+      return;
+    }
+
+    if (!ChildSet) {
+      // Child's former members now start right after Root and end at Child
+      RootSet->reserve(Size[Root]);
+      for (id_t Mem = Next[Root];; Mem = Next[Mem]) {
+        RootSet->insert(Values[Mem]);
+        if (Mem == Child) {
+          break;
+        }
+      }
+      return;
+    }
+
+    if (!RootSet) {
+      // Root's former members now start right after Child and end at Root
+      Sets[Root] = ChildSet;
+      if (auto Boxes = takeForwardedBoxes(Child); !Boxes.empty()) {
+        ForwardedBoxes[Root] = std::move(Boxes);
+      }
+      ChildSet->reserve(Size[Root]);
+      for (id_t Mem = Next[Child];; Mem = Next[Mem]) {
+        ChildSet->insert(Values[Mem]);
+        if (Mem == Root) {
+          break;
+        }
+      }
+      return;
+    }
+
+    // Both sets are materialized: Keep the larger one and let all boxes of
+    // the smaller one point to it
+    auto RootBoxes = takeForwardedBoxes(Root);
+    auto ChildBoxes = takeForwardedBoxes(Child);
+    if (RootSet->size() < ChildSet->size()) {
+      std::swap(RootSet, ChildSet);
+      std::swap(RootBoxes, ChildBoxes);
+    }
+    RootSet->insert(ChildSet->begin(), ChildSet->end());
+
+    auto *ToRelease = ChildSet.get();
+    ChildBoxes.push_back(ChildSet);
+    for (auto Box : ChildBoxes) {
+      *Box.value() = RootSet.get();
+    }
+    RootBoxes.append(ChildBoxes.begin(), ChildBoxes.end());
+
+    Sets[Root] = RootSet;
+    ForwardedBoxes[Root] = std::move(RootBoxes);
+    Owner->release(ToRelease);
+  }
+
+  /// The representative of Id's class. Compresses the path to it.
+  [[nodiscard]] id_t find(id_t Id) noexcept {
+    while (Parent[Id] != Id) {
+      Parent[Id] = Parent[Parent[Id]];
+      Id = Parent[Id];
+    }
+    return Id;
+  }
+
+  /// The representative of Id's class. Does not modify the union-find, so it
+  /// may be called concurrently.
+  [[nodiscard]] id_t findRoot(id_t Id) const noexcept {
+    while (Parent[Id] != Id) {
+      Id = Parent[Id];
+    }
+    return Id;
+  }
+
+  /// The number of values in the class represented by Root
+  [[nodiscard]] size_t getClassSize(id_t Root) const noexcept {
+    assert(Parent[Root] == Root);
+    return Size[Root];
+  }
+
+  /// Calls Handler with each value of the class represented by Root
+  template <typename HandlerFn>
+  void forEachMember(id_t Root, HandlerFn Handler) const {
+    assert(Parent[Root] == Root);
+    id_t Mem = Root;
+    do {
+      Handler(Values[Mem]);
+      Mem = Next[Mem];
+    } while (Mem != Root);
+  }
+
+  /// Calls Handler with the representative of each class
+  template <typename HandlerFn> void forEachClass(HandlerFn Handler) const {
+    for (id_t Id = 0, End = Values.size(); Id != End; ++Id) {
+      if (Parent[Id] == Id) {
+        Handler(Id);
+      }
+    }
+  }
+
+  /// The alias set of the class represented by Root. Materializes it, if
+  /// necessary.
+  [[nodiscard]] BoxedPtr<AliasSetTy> getAliasSet(id_t Root) {
+    assert(Parent[Root] == Root);
+    auto &Set = Sets[Root];
+    if (!Set) {
+      Set = Owner->acquire();
+      Set->reserve(Size[Root]);
+      forEachMember(Root, [&Set](v_t V) { Set->insert(V); });
+    }
+    return Set;
+  }
+
+  /// The alias set of the class represented by Root, or null if it has not
+  /// been materialized, yet
+  [[nodiscard]] BoxedPtr<AliasSetTy>
+  getMaterializedAliasSet(id_t Root) const noexcept {
+    assert(Parent[Root] == Root);
+    return Sets[Root];
+  }
+
+  /// Compresses all paths and materializes the alias sets of all classes.
+  /// Afterwards, findRoot() and getMaterializedAliasSet() answer all queries
+  /// with constant overhead.
+  void materializeAll() {
+    for (id_t Id = 0, End = Values.size(); Id != End; ++Id) {
+      auto Root = findRoot(Id);
+      Parent[Id] = Root;
+      if (Root == Id) {
+        (void)getAliasSet(Root);
+      }
+    }
+  }
+
+private:
+  using BoxListTy = llvm::SmallVector<BoxedPtr<AliasSetTy>, 0>;
+
+  [[nodiscard]] BoxListTy takeForwardedBoxes(id_t Root) {
+    auto It = ForwardedBoxes.find(Root);
+    if (It == ForwardedBoxes.end()) {
+      return {};
+    }
+    auto Ret = std::move(It->second);
+    ForwardedBoxes.erase(It);
+    return Ret;
+  }
+
+  AliasSetOwner<AliasSetTy> *Owner{};
+  llvm::DenseMap<v_t, id_t> Ids;
+  std::vector<v_t> Values;
+  std::vector<id_t> Parent;
+  /// Only valid for representatives
+  std::vector<id_t> Size;
+  /// Each class' members form a circular list
+  std::vector<id_t> Next;
+  /// The materialized sets; only valid for representatives
+  std::vector<BoxedPtr<AliasSetTy>> Sets;
+  /// The boxes of materialized sets that have been merged into the set of
+  /// the representative; they must point to the representative's set
+  llvm::DenseMap<id_t, BoxListTy> ForwardedBoxes;
+  size_t NumClasses = 0;
+};
+
+extern template class UnionFindAliasSets<DefaultAATraits<
+    const llvm::Value *, const llvm::Instruction *>::AliasSetTy>;
+
+} // namespace psr
+
+#endif // PHASAR_POINTER_UNIONFINDALIASSETS_H
@@ -0,0 +1,159 @@
+#ifndef UNITTEST_TESTUTILS_RECORDINGTAINTANALYSIS_H_
+#define UNITTEST_TESTUTILS_RECORDINGTAINTANALYSIS_H_
+
+#include "phasar/DataFlow/IfdsIde/FlowFunctions.h"
+#include "phasar/DataFlow/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DB/LLVMProjectIRDB.h"
+#include "phasar/PhasarLLVM/DataFlow/IfdsIde/Problems/IFDSTaintAnalysis.h"
+#include "phasar/PhasarLLVM/HelperAnalyses.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMAliasSet.h"
+#include "phasar/PhasarLLVM/TaintConfig/LLVMTaintConfig.h"
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/IR/InstrTypes.h"
+
+#include <cassert>
+#include <memory>
+#include <set>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace psr::unittest {
+
+/// The keys of the inter-procedural flow- and edge-function caches that the
+/// solver has queried.
+struct RecordedTaintQueries {
+  using n_t = IFDSTaintAnalysis::n_t;
+  using d_t = IFDSTaintAnalysis::d_t;
+  using f_t = IFDSTaintAnalysis::f_t;
+
+  std::set<std::tuple<n_t, f_t>> CallFF;
+  std::set<std::tuple<n_t, f_t, n_t, n_t>> RetFF;
+  std::set<std::tuple<n_t, n_t, std::vector<f_t>>> CallToRetFF;
+  std::set<std::tuple<n_t, d_t, f_t, d_t>> CallEF;
+  std::set<std::tuple<n_t, f_t, n_t, d_t, n_t, d_t>> RetEF;
+};
+
+/// Records the keys under which the FlowEdgeFunctionCache stores the flow and
+/// edge functions at calls. As the edge functions of IFDS problems cannot be
+/// overridden, their keys are derived from the edges that the corresponding
+/// flow functions draw.
+class RecordingTaintAnalysis : public IFDSTaintAnalysis {
+public:
+  using IFDSTaintAnalysis::IFDSTaintAnalysis;
+
+  FlowFunctionPtrType getCallFlowFunction(n_t CallSite, f_t DestFun) override {
+    ++NumConstructed;
+    Queries.CallFF.emplace(CallSite, DestFun);
+    return recordEdges(
+        IFDSTaintAnalysis::getCallFlowFunction(CallSite, DestFun),
+        [this, CallSite, DestFun](d_t Source, d_t Target) {
+          Queries.CallEF.emplace(CallSite, Source, DestFun, Target);
+        });
+  }
+
+  FlowFunctionPtrType getRetFlowFunction(n_t CallSite, f_t CalleeFun,
+                                         n_t ExitStmt, n_t RetSite) override {
+    ++NumConstructed;
+    Queries.RetFF.emplace(CallSite, CalleeFun, ExitStmt, RetSite);
+    return recordEdges(
+        IFDSTaintAnalysis::getRetFlowFunction(CallSite, CalleeFun, ExitStmt,
+                                              RetSite),
+        [this, CallSite, CalleeFun, ExitStmt, RetSite](d_t Source, d_t Target) {
+          Queries.RetEF.emplace(CallSite, CalleeFun, ExitStmt, Source, RetSite,
+                                Target);
+        });
+  }
+
+  FlowFunctionPtrType
+  getCallToRetFlowFunction(n_t CallSite, n_t RetSite,
+                           llvm::ArrayRef<f_t> Callees) override {
+    ++NumConstructed;
+    Queries.CallToRetFF.emplace(CallSite, RetSite, Callees.vec());
+    return IFDSTaintAnalysis::getCallToRetFlowFunction(CallSite, RetSite,
+                                                       Callees);
+  }
+
+  RecordedTaintQueries Queries;
+  size_t NumConstructed = 0;
+
+private:
+  /// Forwards to an inner flow function and reports each edge that it draws.
+  template <typename HandlerFn>
+  class RecordingFlowFunction : public FlowFunction<d_t> {
+  public:
+    RecordingFlowFunction(FlowFunctionPtrType Inner, HandlerFn Handler)
+        : Inner(std::move(Inner)), Handler(std::move(Handler)) {}
+
+    container_type computeTargets(d_t Source) override {
+      auto Targets = Inner->computeTargets(Source);
+      for (d_t Target : Targets) {
+        Handler(Source, Target);
+      }
+      return Targets;
+    }
+
+  private:
+    FlowFunctionPtrType Inner;
+    HandlerFn Handler;
+  };
+
+  template <typename HandlerFn>
+  static FlowFunctionPtrType recordEdges(FlowFunctionPtrType Inner,
+                                         HandlerFn Handler) {
+    return std::make_shared<RecordingFlowFunction<HandlerFn>>(
+        std::move(Inner), std::move(Handler));
+  }
+};
+
+/// Solves the RecordingTaintAnalysis on an IR file of the dummy_source_sink
+/// taint tests, i.e., with the return value of source() as source and the
+/// argument of sink(int) as sink.
+struct RecordedTaintSolve {
+  HelperAnalyses HA;
+  LLVMTaintConfig TSF;
+  RecordingTaintAnalysis TaintProblem;
+
+  RecordedTaintSolve(const llvm::Twine &IRFile,
+                     const std::vector<std::string> &EntryPoints)
+      : HA(IRFile, EntryPoints), TSF(getSourceCallBack(), getSinkCallBack()),
+        TaintProblem(&HA.getProjectIRDB(), &HA.getAliasInfo(), &TSF,
+                     EntryPoints) {
+    IFDSSolver Solver(TaintProblem, &HA.getICFG());
+    Solver.solve();
+  }
+
+private:
+  static LLVMTaintConfig::TaintDescriptionCallBackTy getSourceCallBack() {
+    return [](const llvm::Instruction *Inst) {
+      std::set<const llvm::Value *> Ret;
+      if (const auto *Call = llvm::dyn_cast<llvm::CallBase>(Inst);
+          Call && Call->getCalledFunction() &&
+          Call->getCalledFunction()->getName() == "_Z6sourcev") {
+        Ret.insert(Call);
+      }
+      return Ret;
+    };
+  }
+
+  static LLVMTaintConfig::TaintDescriptionCallBackTy getSinkCallBack() {
+    return [](const llvm::Instruction *Inst) {
+      std::set<const llvm::Value *> Ret;
+      if (const auto *Call = llvm::dyn_cast<llvm::CallBase>(Inst);
+          Call && Call->getCalledFunction() &&
+          Call->getCalledFunction()->getName() == "_Z4sinki") {
+        assert(Call->arg_size() > 0);
+        Ret.insert(Call->getArgOperand(0));
+      }
+      return Ret;
+    };
+  }
+};
+
+} // namespace psr::unittest
+
+#endif // UNITTEST_TESTUTILS_RECORDINGTAINTANALYSIS_H_
@@ -12,15 +12,24 @@
 
 #include "llvm/ADT/BitVector.h"
 #include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/Compiler.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/raw_ostream.h"
 
-#include "boost/bimap.hpp"
-#include "boost/bimap/unordered_set_of.hpp"
-
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <cstdint>
 #include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
 
 namespace psr {
 namespace internal {
@@ -50,123 +59,239 @@ inline bool isLess(const llvm::BitVector &Lhs, const llvm::BitVector &Rhs) {
 } // namespace internal
 
 /**
- * BitVectorSet implements a set that requires minimal space. Elements are
- * kept in a static map and the set itself only stores a vector of bits which
- * indicate whether elements are contained in the set.
+ * Assigns dense indices to the elements of BitVectorSets.
  *
- * @brief Implements a set that requires minimal space.
+ * All sets that should be combined with each other must share the same
+ * domain. By default, all BitVectorSet<T> use the process-wide domain
+ * returned by getDefault().
+ *
+ * Thread-safety is a policy of the domain that is chosen on construction. In a
+ * synchronized domain, like the default one, looking up an element takes a
+ * shared lock and inserting a new element takes an exclusive lock. An
+ * unsynchronized domain skips the locking and must only be used from one
+ * thread at a time. Mapping an index back to its element never locks, since
+ * the elements are stored in blocks that are never moved.
  */
-template <typename T> class BitVectorSet {
-private:
-  // Using boost::hash<T> causes ambiguity for hash_value():
-  //  -<llvm/ADT/Hashing.h>
-  //  -<boost/functional/hash/extensions.hpp>
-  //  -<boost/graph/adjacency_list.hpp>
-  using bimap_t = boost::bimap<boost::bimaps::unordered_set_of<T, std::hash<T>>,
-                               boost::bimaps::unordered_set_of<size_t>>;
-  inline static bimap_t Position; // NOLINT
-  llvm::BitVector Bits;
+template <typename T> class BitVectorSetDomain {
+public:
+  using index_t = uint32_t;
+
+  explicit BitVectorSetDomain(bool Synchronized = false) noexcept
+      : Synchronized(Synchronized) {}
+
+  BitVectorSetDomain(const BitVectorSetDomain &) = delete;
+  BitVectorSetDomain &operator=(const BitVectorSetDomain &) = delete;
+  BitVectorSetDomain(BitVectorSetDomain &&) = delete;
+  BitVectorSetDomain &operator=(BitVectorSetDomain &&) = delete;
+
+  ~BitVectorSetDomain() {
+    std::allocator<T> Alloc;
+    size_t NumValues = size();
+    for (unsigned Blck = 0; Blck != NumBlocks; ++Blck) {
+      auto *Block = Blocks[Blck].load(std::memory_order_relaxed);
+      if (!Block) {
+        break;
+      }
+      auto Cap = getBlockCapacity(Blck);
+      std::destroy_n(Block, std::min(Cap, NumValues));
+      NumValues -= std::min(Cap, NumValues);
+      Alloc.deallocate(Block, Cap);
+    }
+  }
 
-  template <typename D> class BitVectorSetIterator {
-    llvm::BitVector Bits;
+  /// The domain that BitVectorSet<T> uses if no other domain is specified.
+  /// It is synchronized, since independent analyses may run concurrently and
+  /// still share it.
+  [[nodiscard]] static BitVectorSetDomain &getDefault() {
+    static BitVectorSetDomain Domain(/*Synchronized*/ true);
+    return Domain;
+  }
 
-  public:
-    using iterator_category = std::forward_iterator_tag;
-    using value_type = D;
-    using difference_type = std::ptrdiff_t;
-    using pointer = D *;
-    using reference = D &;
-    BitVectorSetIterator(D Ptr = nullptr) : PosPtr(Ptr) {}
+  [[nodiscard]] bool isSynchronized() const noexcept { return Synchronized; }
 
-    BitVectorSetIterator<D> &operator=(D *Ptr) {
-      PosPtr = Ptr;
-      return *this;
+  /// The index of Value; assigns a new index if Value is not yet known
+  [[nodiscard]] index_t getOrInsert(const T &Value) {
+    if (!Synchronized) {
+      return getOrInsertImpl(Value);
+    }
+    if (auto Idx = findImpl(Value, std::shared_lock(Mtx))) {
+      return *Idx;
     }
+    std::lock_guard Lock(Mtx);
+    return getOrInsertImpl(Value);
+  }
+
+  /// The index of Value, or std::nullopt if Value is not yet known
+  [[nodiscard]] std::optional<index_t> find(const T &Value) const {
+    if (!Synchronized) {
+      return findImpl(Value, std::shared_lock<std::shared_mutex>());
+    }
+    return findImpl(Value, std::shared_lock(Mtx));
+  }
+
+  /// The element with index Idx. The index must have been obtained from this
+  /// domain
+  [[nodiscard]] const T &operator[](index_t Idx) const noexcept {
+    assert(Idx < size() && "Index out of range");
+    auto Blck = getBlockIndex(Idx);
+    const auto *Block = Blocks[Blck].load(std::memory_order_acquire);
+    return Block[Idx - getBlockStart(Blck)];
+  }
 
-    void setBits(const llvm::BitVector &OtherBits) { Bits = OtherBits; }
+  /// The number of indexed elements
+  [[nodiscard]] size_t size() const noexcept {
+    return Size.load(std::memory_order_acquire);
+  }
 
-    bool operator==(const BitVectorSetIterator<D> &OtherIterator) const {
-      return PosPtr == OtherIterator.getPtr();
+private:
+  static constexpr unsigned FirstBlockBits = 6;
+  /// Enough blocks to cover all values of index_t
+  static constexpr unsigned NumBlocks =
+      8 * sizeof(index_t) - FirstBlockBits + 1;
+
+  [[nodiscard]] static unsigned getBlockIndex(index_t Idx) noexcept {
+    return llvm::Log2_64((uint64_t(Idx) >> FirstBlockBits) + 1);
+  }
+  [[nodiscard]] static size_t getBlockStart(unsigned Blck) noexcept {
+    return ((uint64_t(1) << Blck) - 1) << FirstBlockBits;
+  }
+  [[nodiscard]] static size_t getBlockCapacity(unsigned Blck) noexcept {
+    return uint64_t(1) << (Blck + FirstBlockBits);
+  }
+
+  // Requires the exclusive lock, if synchronized
+  index_t getOrInsertImpl(const T &Value) {
+    auto [It, Inserted] = Indices.try_emplace(Value, 0);
+    if (Inserted) {
+      It->second = emplaceValue(Value);
     }
+    return It->second;
+  }
 
-    bool operator!=(const BitVectorSetIterator<D> &OtherIterator) const {
-      return !(*this == OtherIterator);
+  // Lock is the shared lock, if synchronized
+  [[nodiscard]] std::optional<index_t>
+  findImpl(const T &Value,
+           std::shared_lock<std::shared_mutex> /*Lock*/) const {
+    if (auto It = Indices.find(Value); It != Indices.end()) {
+      return It->second;
     }
+    return std::nullopt;
+  }
 
-    BitVectorSetIterator<D> &operator+=(const difference_type &Movement) {
-      for (difference_type I = 0; I < Movement; I++) {
-        PosPtr++;
-      }
-      return *this;
+  // Requires the exclusive lock, if synchronized
+  index_t emplaceValue(const T &Value) {
+    auto Idx = index_t(Size.load(std::memory_order_relaxed));
+    auto Blck = getBlockIndex(Idx);
+    auto *Block = Blocks[Blck].load(std::memory_order_relaxed);
+    if (!Block) {
+      Block = std::allocator<T>().allocate(getBlockCapacity(Blck));
+      Blocks[Blck].store(Block, std::memory_order_release);
     }
+    new (&Block[Idx - getBlockStart(Blck)]) T(Value);
+    Size.store(Idx + 1, std::memory_order_release);
+    return Idx;
+  }
 
-    BitVectorSetIterator<D> &operator++() {
-      do {
-        int NextIdx = Bits.find_next(PosPtr->first);
+  mutable std::shared_mutex Mtx;
+  bool Synchronized{};
+  // Using boost::hash<T> causes ambiguity for hash_value():
+  //  -<llvm/ADT/Hashing.h>
+  //  -<boost/functional/hash/extensions.hpp>
+  //  -<boost/graph/adjacency_list.hpp>
+  std::unordered_map<T, index_t, std::hash<T>> Indices;
+  std::array<std::atomic<T *>, NumBlocks> Blocks{};
+  std::atomic<size_t> Size{0};
+};
 
-        if (NextIdx <= static_cast<int>(PosPtr->first)) {
-          PosPtr = Position.right.find(Bits.size());
-          break;
-        }
+/**
+ * BitVectorSet implements a set that requires minimal space. Elements are
+ * indexed by a BitVectorSetDomain and the set itself only stores which
+ * indices it contains.
+ *
+ * Small sets store the sorted indices of their elements inline; once a set
+ * outgrows that, it switches to a bit-vector. Operations on two bit-vectors
+ * work on whole words, such that the compiler can vectorize them. Iterating
+ * a set neither copies it nor looks up the elements in a hash map.
+ *
+ * @brief Implements a set that requires minimal space.
+ */
+template <typename T> class BitVectorSet {
+public:
+  using domain_type = BitVectorSetDomain<T>;
+  using index_t = typename domain_type::index_t;
+  using value_type = T;
 
-        PosPtr = Position.right.find(NextIdx);
+  /// The number of elements that are stored without a bit-vector
+  static constexpr size_t SmallSize = 4;
 
-        assert(PosPtr->first < Bits.size() &&
-               "pos_ptr->first index into BitVector out of range");
-      } while (!Bits[PosPtr->first]);
+  class const_iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T *;
+    using reference = const T &;
 
-      return *this;
+    const_iterator() noexcept = default;
+
+    [[nodiscard]] reference operator*() const noexcept {
+      return (*Set->Domain)[getIndex()];
     }
+    [[nodiscard]] pointer operator->() const noexcept { return &**this; }
 
-    BitVectorSetIterator<D> operator++(int) {
-      auto Temp(*this);
+    const_iterator &operator++() noexcept {
+      Pos = Set->Dense ? Set->findNextDense(Pos + 1) : Pos + 1;
+      return *this;
+    }
+    const_iterator operator++(int) noexcept {
+      auto Temp = *this;
       ++*this;
       return Temp;
     }
 
-    BitVectorSetIterator<D> operator+(const difference_type &Movement) {
-      auto OldPtr = PosPtr;
-      for (difference_type I = 0; I < Movement; I++) {
-        PosPtr++;
+    const_iterator &operator+=(difference_type Movement) noexcept {
+      for (difference_type I = 0; I < Movement; ++I) {
+        ++*this;
       }
-      auto Temp(*this);
-      PosPtr = OldPtr;
-      return Temp;
+      return *this;
     }
-
-    difference_type operator-(const BitVectorSetIterator<D> &OtherIterator) {
-      return std::distance(OtherIterator.getPtr(), this->getPtr());
+    [[nodiscard]] const_iterator operator+(difference_type Movement) const {
+      auto Temp = *this;
+      return Temp += Movement;
     }
 
-    // T& operator*(){return pos_ptr->second;}
-
-    const T &operator*() const { return PosPtr->second; }
-
-    D *operator->() { return PosPtr; }
-
-    [[nodiscard]] D getPtr() const { return PosPtr; }
-
-    // const D* getConstPtr()const{return pos_ptr;}
+    /// The index of the current element within the domain of the set
+    [[nodiscard]] index_t getIndex() const noexcept {
+      return Set->Dense ? index_t(Pos) : Set->Sparse[Pos];
+    }
 
-    // T getPos() {return pos_ptr->first;}
+    friend bool operator==(const const_iterator &Lhs,
+                           const const_iterator &Rhs) noexcept {
+      return Lhs.Pos == Rhs.Pos && Lhs.Set == Rhs.Set;
+    }
+    friend bool operator!=(const const_iterator &Lhs,
+                           const const_iterator &Rhs) noexcept {
+      return !(Lhs == Rhs);
+    }
 
-    // T getVal() {return pos_ptr->second;}
+  private:
+    friend class BitVectorSet;
 
-    [[nodiscard]] llvm::BitVector getBits() const { return Bits; }
+    const_iterator(const BitVectorSet *Set, size_t Pos) noexcept
+        : Set(Set), Pos(Pos) {}
 
-  private:
-    D PosPtr;
+    const BitVectorSet *Set{};
+    /// The position within Sparse, or the bit-index if the set is dense
+    size_t Pos{};
   };
 
-public:
-  using iterator = BitVectorSetIterator<typename bimap_t::right_iterator>;
-  using const_iterator =
-      BitVectorSetIterator<typename bimap_t::right_const_iterator>;
-  using value_type = T;
+  using iterator = const_iterator;
+
+  BitVectorSet() noexcept = default;
 
-  BitVectorSet() = default;
+  explicit BitVectorSet(domain_type &Domain) noexcept : Domain(&Domain) {}
 
-  explicit BitVectorSet(size_t Count) : Bits(Count, false) {}
+  explicit BitVectorSet(size_t Count) { reserve(Count); }
 
   BitVectorSet(std::initializer_list<T> IList) {
     insert(IList.begin(), IList.end());
@@ -176,53 +301,115 @@ public:
     insert(First, Last);
   }
 
+  template <typename InputIt>
+  BitVectorSet(InputIt First, InputIt Last, domain_type &Domain)
+      : Domain(&Domain) {
+    insert(First, Last);
+  }
+
+  [[nodiscard]] domain_type &getDomain() const noexcept { return *Domain; }
+
   [[nodiscard]] BitVectorSet<T> setUnion(const BitVectorSet<T> &Other) const {
-    size_t MaxSize = std::max(Bits.size(), Other.Bits.size());
-    BitVectorSet<T> Res;
-    Res.Bits.reserve(MaxSize);
-    Res.Bits = Bits;
-    Res.Bits |= Other.Bits;
+    BitVectorSet<T> Res = *this;
+    Res.setUnionWith(Other);
     return Res;
   }
 
   [[nodiscard]] BitVectorSet<T>
   setIntersect(const BitVectorSet<T> &Other) const {
-    BitVectorSet Res = Bits.size() > Other.Bits.size() ? Other : *this;
-    const BitVectorSet &Larger =
-        Bits.size() > Other.Bits.size() ? *this : Other;
-
-    Res.Bits &= Larger.Bits;
+    BitVectorSet<T> Res = *this;
+    Res.setIntersectWith(Other);
     return Res;
   }
 
-  void setIntersectWith(const BitVectorSet<T> &Other) { Bits &= Other.Bits; }
+  void setIntersectWith(const BitVectorSet<T> &Other) {
+    assert(Domain == Other.Domain && "Sets of different domains");
+    if (!Dense) {
+      Sparse.erase(llvm::remove_if(Sparse,
+                                   [&Other](index_t Idx) {
+                                     return !Other.containsIndex(Idx);
+                                   }),
+                   Sparse.end());
+      return;
+    }
+    if (!Other.Dense) {
+      // The result is at most as large as Other
+      llvm::SmallVector<index_t, SmallSize> Res;
+      for (auto Idx : Other.Sparse) {
+        if (containsIndex(Idx)) {
+          Res.push_back(Idx);
+        }
+      }
+      clear();
+      Sparse = std::move(Res);
+      return;
+    }
 
-  void setUnionWith(const BitVectorSet<T> &Other) { Bits |= Other.Bits; }
+    auto NumWords = std::min(Words.size(), Other.Words.size());
+    Words.resize(NumWords);
+    auto *Dest = Words.data();
+    const auto *Src = Other.Words.data();
+    for (size_t I = 0; I != NumWords; ++I) {
+      Dest[I] &= Src[I];
+    }
+  }
 
-  [[nodiscard]] bool includes(const BitVectorSet<T> &Other) const {
-    return !Other.Bits.test(Bits);
+  void setUnionWith(const BitVectorSet<T> &Other) {
+    assert(Domain == Other.Domain && "Sets of different domains");
+    if (!Other.Dense) {
+      for (auto Idx : Other.Sparse) {
+        insertIndex(Idx);
+      }
+      return;
+    }
+    if (!Dense) {
+      makeDense(Other.Words.size());
+    }
+
+    if (Words.size() < Other.Words.size()) {
+      Words.resize(Other.Words.size());
+    }
+    auto *Dest = Words.data();
+    const auto *Src = Other.Words.data();
+    for (size_t I = 0, End = Other.Words.size(); I != End; ++I) {
+      Dest[I] |= Src[I];
+    }
   }
 
-  void insert(const T &Data) {
-    auto Search = Position.left.find(Data);
-    // Data already known
-    if (Search != Position.left.end()) {
-      if (Bits.size() <= Search->second) {
-        Bits.resize(Search->second + 1);
+  [[nodiscard]] bool includes(const BitVectorSet<T> &Other) const {
+    assert(Domain == Other.Domain && "Sets of different domains");
+    if (!Other.Dense) {
+      return llvm::all_of(Other.Sparse,
+                          [this](index_t Idx) { return containsIndex(Idx); });
+    }
+    if (!Dense) {
+      if (Other.size() > Sparse.size()) {
+        return false;
       }
-      Bits.set(Search->second);
-    } else {
-      // Data unknown
-      size_t Idx = Position.left.size();
-      Position.left.insert(std::make_pair(Data, Position.left.size()));
-      if (Bits.size() <= Position.left.size()) {
-        Bits.resize(Position.left.size());
+      for (auto It = Other.begin(), End = Other.end(); It != End; ++It) {
+        if (!containsIndex(It.getIndex())) {
+          return false;
+        }
       }
-      Bits.set(Idx);
+      return true;
+    }
+
+    const auto *Lhs = Words.data();
+    const auto *Rhs = Other.Words.data();
+    auto NumWords = std::min(Words.size(), Other.Words.size());
+    uint64_t Missing = 0;
+    for (size_t I = 0; I != NumWords; ++I) {
+      Missing |= Rhs[I] & ~Lhs[I];
     }
+    for (size_t I = NumWords, End = Other.Words.size(); I < End; ++I) {
+      Missing |= Rhs[I];
+    }
+    return Missing == 0;
   }
 
-  void insert(const BitVectorSet<T> &Other) { Bits |= Other.Bits; }
+  void insert(const T &Data) { insertIndex(Domain->getOrInsert(Data)); }
+
+  void insert(const BitVectorSet<T> &Other) { setUnionWith(Other); }
 
   template <typename InputIt> void insert(InputIt First, InputIt Last) {
     while (First != Last) {
@@ -231,139 +418,250 @@ public:
     }
   }
 
-  void erase(const T &Data) noexcept {
-    auto Search = Position.left.find(Data);
-    if (Search != Position.left.end()) {
-      if (Bits.size() > Search->second) {
-        Bits.reset(Search->second);
-      }
+  void erase(const T &Data) {
+    if (auto Idx = Domain->find(Data)) {
+      eraseIndex(*Idx);
     }
   }
 
   void erase(const BitVectorSet<T> &Other) {
+    assert(Domain == Other.Domain && "Sets of different domains");
     if (this == &Other) {
       clear();
-    } else {
-      Bits.reset(Other.Bits);
+      return;
+    }
+    if (!Dense) {
+      Sparse.erase(llvm::remove_if(Sparse,
+                                   [&Other](index_t Idx) {
+                                     return Other.containsIndex(Idx);
+                                   }),
+                   Sparse.end());
+      return;
+    }
+    if (!Other.Dense) {
+      for (auto Idx : Other.Sparse) {
+        eraseIndex(Idx);
+      }
+      return;
+    }
+
+    auto *Dest = Words.data();
+    const auto *Src = Other.Words.data();
+    for (size_t I = 0, End = std::min(Words.size(), Other.Words.size());
+         I != End; ++I) {
+      Dest[I] &= ~Src[I];
     }
   }
 
   void clear() noexcept {
-    Bits.clear();
-    Bits.resize(0);
+    Sparse.clear();
+    Words.clear();
+    Dense = false;
   }
 
-  [[nodiscard]] bool empty() const noexcept { return Bits.none(); }
+  [[nodiscard]] bool empty() const noexcept {
+    if (!Dense) {
+      return Sparse.empty();
+    }
+    return llvm::all_of(Words, [](uint64_t Word) { return Word == 0; });
+  }
+
+  /// Reserves space for elements with indices up to NewCap
+  void reserve(size_t NewCap) {
+    if (Dense) {
+      Words.reserve(getNumWords(NewCap));
+    } else {
+      Sparse.reserve(std::min(NewCap, SmallSize));
+    }
+  }
 
-  void reserve(size_t NewCap) { Bits.reserve(NewCap); }
+  [[nodiscard]] bool find(const T &Data) const { return count(Data); }
 
-  [[nodiscard]] bool find(const T &Data) const noexcept { return count(Data); }
+  [[nodiscard]] size_t count(const T &Data) const {
+    auto Idx = Domain->find(Data);
+    return Idx && containsIndex(*Idx);
+  }
 
-  [[nodiscard]] size_t count(const T &Data) const noexcept {
-    auto Search = Position.left.find(Data);
-    if (Search != Position.left.end()) {
-      if (Bits.size() > Search->second) {
-        return Bits[Search->second];
-      }
+  [[nodiscard]] size_t size() const noexcept {
+    if (!Dense) {
+      return Sparse.size();
     }
-    return 0;
+    size_t Ret = 0;
+    for (auto Word : Words) {
+      Ret += llvm::countPopulation(Word);
+    }
+    return Ret;
   }
 
-  [[nodiscard]] size_t size() const noexcept { return Bits.count(); }
+  /// Whether the element with index Idx in the domain of this set is
+  /// contained
+  [[nodiscard]] bool containsIndex(index_t Idx) const noexcept {
+    if (!Dense) {
+      return std::binary_search(Sparse.begin(), Sparse.end(), Idx);
+    }
+    return Idx / 64 < Words.size() && (Words[Idx / 64] >> (Idx % 64)) & 1;
+  }
 
   friend bool operator==(const BitVectorSet &Lhs, const BitVectorSet &Rhs) {
-    bool LeftEmpty = Lhs.empty();
-    bool RightEmpty = Rhs.empty();
-    if (LeftEmpty || RightEmpty) {
-      return LeftEmpty == RightEmpty;
+    if (!Lhs.Dense && !Rhs.Dense) {
+      return Lhs.Sparse == Rhs.Sparse;
     }
-    // Check, whether Lhs and Rhs actually have the same bits set and not
+    // Check, whether Lhs and Rhs actually have the same elements and not
     // whether their internal representation is exactly identitcal
-    auto LhsWords = Lhs.Bits.getData();
-    auto RhsWords = Rhs.Bits.getData();
-    if (LhsWords.size() == RhsWords.size()) {
-      return LhsWords == RhsWords;
-    }
-    auto MinSize = std::min(LhsWords.size(), RhsWords.size());
-    if (LhsWords.slice(0, MinSize) != RhsWords.slice(0, MinSize)) {
-      return false;
+    for (size_t I = 0, End = std::max(Lhs.getNumWords(), Rhs.getNumWords());
+         I != End; ++I) {
+      if (Lhs.getWord(I) != Rhs.getWord(I)) {
+        return false;
+      }
     }
-    auto Rest = (LhsWords.size() > RhsWords.size() ? LhsWords : RhsWords)
-                    .slice(MinSize);
-    return std::all_of(Rest.begin(), Rest.end(),
-                       [](auto Word) { return Word == 0; });
+    return true;
   }
 
   friend bool operator!=(const BitVectorSet &Lhs, const BitVectorSet &Rhs) {
     return !(Lhs == Rhs);
   }
 
+  /// Compares the bit-vectors of Lhs and Rhs, like internal::isLess() does
   friend bool operator<(const BitVectorSet &Lhs, const BitVectorSet &Rhs) {
-    return internal::isLess(Lhs.Bits, Rhs.Bits);
+    for (size_t I = std::max(Lhs.getNumWords(), Rhs.getNumWords()); I; --I) {
+      auto LhsWord = Lhs.getWord(I - 1);
+      auto RhsWord = Rhs.getWord(I - 1);
+      if (LhsWord != RhsWord) {
+        auto HighestDiff = 63 - llvm::countLeadingZeros(LhsWord ^ RhsWord);
+        return (RhsWord >> HighestDiff) & 1;
+      }
+    }
+    return false;
   }
 
   // NOLINTNEXTLINE(readability-identifier-naming) -- needed for ADL
   friend llvm::hash_code hash_value(const BitVectorSet &BV) noexcept {
-    if (BV.Bits.empty()) {
-      return {};
+    size_t NumWords = BV.getNumWords();
+    while (NumWords && BV.getWord(NumWords - 1) == 0) {
+      --NumWords;
     }
-    auto Words = BV.Bits.getData();
-    size_t Idx = Words.size();
-    while (Idx && Words[Idx - 1] == 0) {
-      --Idx;
+    llvm::SmallVector<uint64_t, 4> Words;
+    Words.reserve(NumWords);
+    for (size_t I = 0; I != NumWords; ++I) {
+      Words.push_back(BV.getWord(I));
     }
-    return llvm::hash_combine_range(Words.begin(),
-                                    std::next(Words.begin(), Idx));
+    return llvm::hash_combine_range(Words.begin(), Words.end());
   }
 
   friend llvm::raw_ostream &operator<<(llvm::raw_ostream &OS,
                                        const BitVectorSet &B) {
     OS << '<';
-    size_t Idx = 0;
-    for (auto &Position : B.Position.left) {
-      if (Position.second < B.Bits.size() && B.Bits[Position.second]) {
-        ++Idx;
-        OS << Position.first;
-        if (Idx < B.size()) {
-          OS << ", ";
-        }
+    bool First = true;
+    for (const auto &Elem : B) {
+      if (!First) {
+        OS << ", ";
       }
+      First = false;
+      OS << Elem;
     }
     OS << '>';
     return OS;
   }
 
-  [[nodiscard]] iterator begin() {
-    int Index = Bits.find_first();
-    if (Index == -1) {
-      Index = Bits.size();
+  [[nodiscard]] const_iterator begin() const noexcept {
+    return {this, Dense ? findNextDense(0) : 0};
+  }
+
+  [[nodiscard]] const_iterator end() const noexcept {
+    return {this, Dense ? Words.size() * 64 : Sparse.size()};
+  }
+
+private:
+  [[nodiscard]] static size_t getNumWords(size_t NumBits) noexcept {
+    return (NumBits + 63) / 64;
+  }
+
+  [[nodiscard]] size_t getNumWords() const noexcept {
+    if (!Dense) {
+      return Sparse.empty() ? 0 : Sparse.back() / 64 + 1;
     }
-    iterator BeginIter(Position.right.find(Index));
-    BeginIter.setBits(Bits);
-    return BeginIter;
+    return Words.size();
   }
 
-  [[nodiscard]] iterator end() {
-    iterator EndIter(Position.right.find(Bits.size()));
-    EndIter.setBits(Bits);
-    return EndIter;
+  [[nodiscard]] uint64_t getWord(size_t I) const noexcept {
+    if (!Dense) {
+      uint64_t Word = 0;
+      for (auto Idx : Sparse) {
+        if (Idx / 64 == I) {
+          Word |= uint64_t(1) << (Idx % 64);
+        }
+      }
+      return Word;
+    }
+    return I < Words.size() ? Words[I] : 0;
   }
 
-  [[nodiscard]] const_iterator begin() const {
-    int Index = Bits.find_first();
-    if (Index == -1) {
-      Index = Bits.size();
+  [[nodiscard]] size_t findNextDense(size_t From) const noexcept {
+    auto NumWords = Words.size();
+    auto WordIdx = From / 64;
+    if (WordIdx >= NumWords) {
+      return NumWords * 64;
+    }
+    // Mask out the bits before From
+    auto Word = Words[WordIdx] & (~uint64_t(0) << (From % 64));
+    while (!Word) {
+      if (++WordIdx == NumWords) {
+        return NumWords * 64;
+      }
+      Word = Words[WordIdx];
     }
-    const_iterator BeginIter(Position.right.find(Index));
-    BeginIter.setBits(Bits);
-    return BeginIter;
+    return WordIdx * 64 + llvm::countTrailingZeros(Word);
   }
 
-  [[nodiscard]] const_iterator end() const {
-    const_iterator EndIter(Position.right.find(Bits.size()));
-    EndIter.setBits(Bits);
-    return EndIter;
+  void makeDense(size_t MinWords) {
+    assert(!Dense);
+    size_t NumWords = std::max(MinWords, getNumWords());
+    Words.assign(NumWords, 0);
+    for (auto Idx : Sparse) {
+      Words[Idx / 64] |= uint64_t(1) << (Idx % 64);
+    }
+    Sparse.clear();
+    Dense = true;
   }
+
+  void insertIndex(index_t Idx) {
+    if (!Dense) {
+      auto It = std::lower_bound(Sparse.begin(), Sparse.end(), Idx);
+      if (It != Sparse.end() && *It == Idx) {
+        return;
+      }
+      if (Sparse.size() < SmallSize) {
+        Sparse.insert(It, Idx);
+        return;
+      }
+      makeDense(Idx / 64 + 1);
+    }
+
+    if (Words.size() <= Idx / 64) {
+      Words.resize(Idx / 64 + 1);
+    }
+    Words[Idx / 64] |= uint64_t(1) << (Idx % 64);
+  }
+
+  void eraseIndex(index_t Idx) {
+    if (!Dense) {
+      auto It = std::lower_bound(Sparse.begin(), Sparse.end(), Idx);
+      if (It != Sparse.end() && *It == Idx) {
+        Sparse.erase(It);
+      }
+      return;
+    }
+    if (Idx / 64 < Words.size()) {
+      Words[Idx / 64] &= ~(uint64_t(1) << (Idx % 64));
+    }
+  }
+
+  domain_type *Domain = &domain_type::getDefault();
+  /// The sorted indices of the elements, as long as the set is not dense
+  llvm::SmallVector<index_t, SmallSize> Sparse;
+  /// The words of the bit-vector, once the set is dense
+  llvm::SmallVector<uint64_t, 0> Words;
+  bool Dense = false;
 };
 
 } // namespace psr
@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Copyright (c) 2023 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_COMPRESSOR_H
+#define PHASAR_UTILS_COMPRESSOR_H
+
+#include "phasar/Utils/ByRef.h"
+
+#include "llvm/ADT/DenseMap.h"
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace psr {
+
+/// Assigns each distinct value of type T a dense integer ID, starting at 0, in
+/// order of insertion. Values can be looked up by their ID in O(1).
+///
+/// Pointers are mapped through an llvm::DenseMap; all other types require
+/// std::hash and use a std::unordered_map. Integers deliberately do not use
+/// the DenseMap, since its reserved empty and tombstone keys (e.g., ~0U) are
+/// valid values of generic data-flow domains.
+template <typename T> class Compressor {
+public:
+  using value_type = T;
+  using id_type = uint32_t;
+  using const_iterator = typename std::vector<T>::const_iterator;
+
+  /// Returns the ID of Elem, assigning a fresh one if Elem is not yet known.
+  id_type getOrInsert(ByConstRef<T> Elem) {
+    auto [It, Inserted] = ToInt.try_emplace(Elem, id_type(FromInt.size()));
+    if (Inserted) {
+      assert(FromInt.size() < std::numeric_limits<id_type>::max() &&
+             "Too many elements for 32 bit IDs");
+      FromInt.push_back(Elem);
+    }
+    return It->second;
+  }
+
+  /// Returns the ID of Elem or std::nullopt if Elem has never been inserted.
+  [[nodiscard]] std::optional<id_type>
+  getOrNull(ByConstRef<T> Elem) const noexcept {
+    if (auto It = ToInt.find(Elem); It != ToInt.end()) {
+      return It->second;
+    }
+    return std::nullopt;
+  }
+
+  [[nodiscard]] ByConstRef<T> operator[](id_type Id) const noexcept {
+    assert(Id < FromInt.size());
+    return FromInt[Id];
+  }
+
+  [[nodiscard]] size_t size() const noexcept { return FromInt.size(); }
+  [[nodiscard]] bool empty() const noexcept { return FromInt.empty(); }
+
+  void reserve(size_t Capacity) {
+    ToInt.reserve(Capacity);
+    FromInt.reserve(Capacity);
+  }
+
+  void clear() noexcept {
+    ToInt.clear();
+    FromInt.clear();
+  }
+
+  [[nodiscard]] const_iterator begin() const noexcept {
+    return FromInt.begin();
+  }
+  [[nodiscard]] const_iterator end() const noexcept { return FromInt.end(); }
+
+private:
+  using MapType =
+      std::conditional_t<std::is_pointer_v<T>, llvm::DenseMap<T, id_type>,
+                         std::unordered_map<T, id_type>>;
+
+  MapType ToInt;
+  std::vector<T> FromInt;
+};
+
+} // namespace psr
+
+#endif // PHASAR_UTILS_COMPRESSOR_H
@@ -17,7 +17,12 @@
 #ifndef PHASAR_UTILS_PAMM_H_
 #define PHASAR_UTILS_PAMM_H_
 
+#include <array>
+#include <atomic>
 #include <chrono> // high_resolution_clock::time_point, milliseconds
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <set>           // set
 #include <string>        // string
@@ -36,6 +41,12 @@ namespace psr {
 /// completely when no performance evaluation is needed. Macros are defined
 /// in @see PAMMMacros.h
 ///
+/// PAMM may be used from multiple threads. Counters are the only metric that
+/// is updated on hot paths; every thread counts into its own slots, which are
+/// summed up when a counter is read. When a thread exits, its counts are folded
+/// into a per-counter total and its slots are freed. Timers and histograms are
+/// guarded by a mutex.
+///
 /// Currently, PAMM can be run with all metrics (severity level 2 = Full) or
 /// only core metrics (severity level 1 = Core) enabled. The severity level can
 /// be changed when building PhASAR. The CMake option is
@@ -51,22 +62,94 @@ namespace psr {
 /// PAMM_GET_INSTANCE macro to retrieve an instance of PAMM before you use any
 /// other macro from this class.
 class PAMM {
+public:
+  /// Identifies a counter; see getCounterHandle()
+  using CounterHandle = uint32_t;
+
 private:
   PAMM() = default;
   ~PAMM() = default;
   using TimePoint_t = std::chrono::high_resolution_clock::time_point;
   using Duration_t = std::chrono::milliseconds;
+
+  static constexpr size_t CountersPerBlock = 64;
+  static constexpr size_t MaxCounterBlocks = 64;
+
+  /// The values of CountersPerBlock counters as seen by a single thread. The
+  /// block is aligned to a cache line, such that no two threads ever write to
+  /// the same cache line.
+  struct alignas(64) CounterBlock {
+    std::array<std::atomic<int64_t>, CountersPerBlock> Values{};
+  };
+  /// The counter blocks of a single thread; allocated on first use
+  struct ThreadCounters {
+    std::array<std::atomic<CounterBlock *>, MaxCounterBlocks> Blocks{};
+
+    ~ThreadCounters() {
+      for (auto &Block : Blocks) {
+        delete Block.load(std::memory_order_relaxed);
+      }
+    }
+  };
+  /// Retires the ThreadCounters of the current thread when the thread exits
+  struct ThreadCountersGuard {
+    // Zero-initialized, as the guard is a thread_local
+    bool Registered;
+
+    ~ThreadCountersGuard();
+  };
+
+  std::mutex TimerMtx;
   std::unordered_map<std::string, TimePoint_t> RunningTimer;
   std::unordered_map<std::string, std::pair<TimePoint_t, TimePoint_t>>
       StoppedTimer;
   std::unordered_map<std::string,
                      std::vector<std::pair<TimePoint_t, TimePoint_t>>>
       RepeatingTimer;
-  std::unordered_map<std::string, unsigned> Counter;
+
+  /// Guards the counter names, the retired counts and the list of all
+  /// ThreadCounters. The counter values themselves are only ever written by
+  /// their own thread.
+  std::mutex CounterMtx;
+  std::unordered_map<std::string, CounterHandle> CounterHandles;
+  std::vector<std::string> CounterNames;
+  std::vector<bool> CounterRegistered;
+  /// The summed up counts of all threads that have exited, per counter
+  std::vector<int64_t> Retired;
+  /// The counters of all threads that are still alive
+  std::vector<std::unique_ptr<ThreadCounters>> AllThreadCounters;
+  static inline thread_local ThreadCounters *LocalCounters = nullptr;
+  static inline thread_local ThreadCountersGuard LocalCountersGuard;
+
+  std::mutex HistogramMtx;
   std::unordered_map<std::string,
                      std::unordered_map<std::string, unsigned long>>
       Histogram;
 
+  ThreadCounters &registerThread();
+  void retireThread(ThreadCounters &TC);
+  CounterBlock &allocateCounterBlock(ThreadCounters &TC, size_t BlockIdx);
+
+  /// The slot of the current thread for the counter Id
+  std::atomic<int64_t> &getLocalCounter(CounterHandle Id) {
+    auto *TC = LocalCounters;
+    if (!TC) {
+      TC = &registerThread();
+    }
+    auto BlockIdx = Id / CountersPerBlock;
+    auto *Block = TC->Blocks[BlockIdx].load(std::memory_order_relaxed);
+    if (!Block) {
+      Block = &allocateCounterBlock(*TC, BlockIdx);
+    }
+    return Block->Values[Id % CountersPerBlock];
+  }
+
+  int64_t sumCounter(CounterHandle Id);
+  void stopTimerImpl(const std::string &TimerId, bool PauseTimer = false);
+  unsigned long elapsedTimeImpl(const std::string &TimerId);
+  std::unordered_map<std::string, std::vector<unsigned long>>
+  elapsedTimeOfRepeatingTimerImpl();
+
 public:
   // PAMM is used as singleton.
   PAMM(const PAMM &PM) = delete;
@@ -131,10 +214,18 @@ public:
   /// \param timerId Unique timer id.
   static std::string getPrintableDuration(unsigned long Duration);
 
+  /// Returns the handle of the counter with the given name, creating it if
+  /// necessary. The handle stays valid across reset(), so call sites may look
+  /// it up once and cache it, which is what the INC_COUNTER and DEC_COUNTER
+  /// macros do.
+  /// \param CounterId Unique counter id.
+  CounterHandle getCounterHandle(const std::string &CounterId);
+
   /// \brief Registers a new counter under the given counter id - associated
   /// macro: REG_COUNTER(COUNTER_ID, INIT_VALUE, SEV_LVL).
   /// \param CounterId Unique counter id.
-  void regCounter(const std::string &CounterId, unsigned IntialValue = 0);
+  CounterHandle regCounter(const std::string &CounterId,
+                           unsigned IntialValue = 0);
 
   /// \brief Increases the count for the given counter - associated macro:
   /// INC_COUNTER(COUNTER_ID, VALUE, SEV_LVL).
@@ -142,13 +233,31 @@ public:
   /// \param CValue to be added to the current counter.
   void incCounter(const std::string &CounterId, unsigned CValue = 1);
 
+  /// Increases the count for the given counter without any synchronization
+  /// or lookup. Safe to call from multiple threads concurrently.
+  void incCounter(CounterHandle Id, unsigned CValue = 1) {
+    auto &Slot = getLocalCounter(Id);
+    // Only the current thread writes to Slot, so there is no need for an
+    // atomic read-modify-write
+    Slot.store(Slot.load(std::memory_order_relaxed) + CValue,
+               std::memory_order_relaxed);
+  }
+
   /// \brief Decreases the count for the given counter - associated macro:
   /// DEC_COUNTER(COUNTER_ID, VALUE, SEV_LVL).
   /// \param CounterId Unique counter id.
   /// \param CValue to be subtracted from the current counter.
   void decCounter(const std::string &CounterId, unsigned CValue = 1);
 
+  /// Decreases the count for the given counter; see incCounter(CounterHandle)
+  void decCounter(CounterHandle Id, unsigned CValue = 1) {
+    auto &Slot = getLocalCounter(Id);
+    Slot.store(Slot.load(std::memory_order_relaxed) - CValue,
+               std::memory_order_relaxed);
+  }
+
   /// The associated macro does not check PAMM's severity level explicitly.
+  /// The count is the sum over all threads that have changed the counter.
   /// \brief Returns the current count for the given counter - associated macro:
   /// GET_COUNTER(COUNTER_ID).
   /// \param CounterId Unique counter id.
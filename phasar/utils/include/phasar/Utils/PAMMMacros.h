@@ -61,13 +61,17 @@ static constexpr unsigned PAMM_CURR_SEV_LEVEL = 0; // NOLINT
   if constexpr (PAMM_CURR_SEV_LEVEL >= SEV_LVL) {                              \
     pamm.regCounter(COUNTER_ID, INIT_VALUE);                                   \
   }
+// The counter handle is looked up once per call site, so COUNTER_ID must not
+// change between executions of the same INC_COUNTER or DEC_COUNTER
 #define INC_COUNTER(COUNTER_ID, VALUE, SEV_LVL)                                \
   if constexpr (PAMM_CURR_SEV_LEVEL >= SEV_LVL) {                              \
-    pamm.incCounter(COUNTER_ID, VALUE);                                        \
+    static const auto PammCounter = pamm.getCounterHandle(COUNTER_ID);         \
+    pamm.incCounter(PammCounter, VALUE);                                       \
   }
 #define DEC_COUNTER(COUNTER_ID, VALUE, SEV_LVL)                                \
   if constexpr (PAMM_CURR_SEV_LEVEL >= SEV_LVL) {                              \
-    pamm.decCounter(COUNTER_ID, VALUE);                                        \
+    static const auto PammCounter = pamm.getCounterHandle(COUNTER_ID);         \
+    pamm.decCounter(PammCounter, VALUE);                                       \
   }
 #define GET_COUNTER(COUNTER_ID) pamm.getCounter(COUNTER_ID)
 #define GET_SUM_COUNT(...) pamm.getSumCount(__VA_ARGS__)
@@ -84,6 +84,8 @@ public:
 
   [[nodiscard]] size_t size() const noexcept { return Tab.size(); }
 
+  void reserve(size_t NumRows) { Tab.reserve(NumRows); }
+
   [[nodiscard]] std::set<Cell> cellSet() const {
     // Returns a set of all row key / column key / value triplets.
     std::set<Cell> Result;
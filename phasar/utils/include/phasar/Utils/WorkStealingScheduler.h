@@ -0,0 +1,230 @@
+/******************************************************************************
+ * Copyright (c) 2023 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Fabian Schiebel and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_WORKSTEALINGSCHEDULER_H
+#define PHASAR_UTILS_WORKSTEALINGSCHEDULER_H
+
+#include "llvm/ADT/SmallVector.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace psr {
+
+/// A fixed-size pool of worker threads that drains a dynamically growing set of
+/// work items.
+///
+/// Each worker owns a double-ended queue. Items that are pushed from within a
+/// worker are appended to that worker's queue and are popped again in LIFO
+/// order, which preserves the depth-first locality of the sequential solvers.
+/// Workers whose queue runs dry steal the oldest items from the front of the
+/// other workers' queues.
+///
+/// The scheduler terminates once all items, including the ones being
+/// transitively pushed while processing, have been handled.
+template <typename T> class WorkStealingScheduler {
+public:
+  explicit WorkStealingScheduler(unsigned NumWorkers)
+      : NumWorkers(NumWorkers ? NumWorkers : 1) {
+    Queues.reserve(this->NumWorkers);
+    for (unsigned I = 0; I != this->NumWorkers; ++I) {
+      Queues.push_back(std::make_unique<WorkerQueue>());
+    }
+  }
+
+  WorkStealingScheduler(const WorkStealingScheduler &) = delete;
+  WorkStealingScheduler &operator=(const WorkStealingScheduler &) = delete;
+  WorkStealingScheduler(WorkStealingScheduler &&) = delete;
+  WorkStealingScheduler &operator=(WorkStealingScheduler &&) = delete;
+  ~WorkStealingScheduler() = default;
+
+  [[nodiscard]] unsigned getNumWorkers() const noexcept { return NumWorkers; }
+
+  /// The index of the worker that is executing the calling thread, or
+  /// std::nullopt if the calling thread is not a worker of any scheduler.
+  [[nodiscard]] static std::optional<unsigned> currentWorker() noexcept {
+    if (currentWorkerSlot() == NoWorker) {
+      return std::nullopt;
+    }
+    return currentWorkerSlot();
+  }
+
+  /// Schedules Item for processing. When called from one of the workers, the
+  /// item is pushed to the worker's own queue; otherwise the items are
+  /// distributed round-robin over all queues.
+  void push(T Item) {
+    Pending.fetch_add(1, std::memory_order_relaxed);
+
+    unsigned Worker = currentWorkerSlot();
+    if (Worker == NoWorker || Worker >= NumWorkers) {
+      Worker = NextQueue++ % NumWorkers;
+    }
+
+    auto &Q = *Queues[Worker];
+    std::lock_guard Lock(Q.Mtx);
+    Q.Items.push_back(std::move(Item));
+  }
+
+  /// Processes all pushed items on NumWorkers threads by invoking Handler on
+  /// each of them. Handler may push new items to this scheduler.
+  ///
+  /// Blocks until all items are processed. If a handler throws, the remaining
+  /// items are discarded and the first exception is rethrown to the caller.
+  template <typename HandlerFn> void run(HandlerFn Handler) {
+    runUntil(std::move(Handler), [] { return false; });
+  }
+
+  /// Like run(), but the workers stop taking new items as soon as
+  /// ShouldStop() returns true. ShouldStop is called by all workers before
+  /// each item, so it must be thread-safe and cheap.
+  ///
+  /// The items that have not been processed stay in the scheduler; they can
+  /// be processed by calling run() again, or be taken out using drain().
+  ///
+  /// \returns True, iff all items have been processed.
+  template <typename HandlerFn, typename StopFn>
+  bool runUntil(HandlerFn Handler, StopFn ShouldStop) {
+    static_assert(std::is_invocable_v<HandlerFn &, T>,
+                  "The Handler must be callable with a work item");
+    static_assert(std::is_invocable_r_v<bool, StopFn &>,
+                  "ShouldStop must be callable without arguments");
+    std::exception_ptr FirstError;
+    std::mutex ErrorMtx;
+
+    auto Work = [&](unsigned WorkerId) {
+      currentWorkerSlot() = WorkerId;
+      while (Pending.load(std::memory_order_acquire) != 0) {
+        if (std::invoke(ShouldStop)) {
+          break;
+        }
+        auto Item = pop(WorkerId);
+        if (!Item) {
+          if (Aborted.load(std::memory_order_relaxed)) {
+            break;
+          }
+          std::this_thread::yield();
+          continue;
+        }
+
+        if (!Aborted.load(std::memory_order_relaxed)) {
+          try {
+            std::invoke(Handler, std::move(*Item));
+          } catch (...) {
+            std::lock_guard Lock(ErrorMtx);
+            if (!FirstError) {
+              FirstError = std::current_exception();
+            }
+            Aborted.store(true, std::memory_order_relaxed);
+          }
+        }
+        Pending.fetch_sub(1, std::memory_order_acq_rel);
+      }
+      currentWorkerSlot() = NoWorker;
+    };
+
+    llvm::SmallVector<std::thread, 0> Threads;
+    Threads.reserve(NumWorkers - 1);
+    for (unsigned I = 1; I < NumWorkers; ++I) {
+      Threads.emplace_back(Work, I);
+    }
+    // The calling thread acts as worker 0
+    auto PrevSlot = std::exchange(currentWorkerSlot(), NoWorker);
+    Work(0);
+    currentWorkerSlot() = PrevSlot;
+
+    for (auto &Thread : Threads) {
+      Thread.join();
+    }
+
+    if (FirstError) {
+      for (auto &Q : Queues) {
+        Q->Items.clear();
+      }
+      Pending.store(0, std::memory_order_relaxed);
+      Aborted.store(false, std::memory_order_relaxed);
+      std::rethrow_exception(FirstError);
+    }
+    return Pending.load(std::memory_order_relaxed) == 0;
+  }
+
+  /// Removes all items that have not been processed and invokes Handler on
+  /// each of them. Must not be called while run() or runUntil() is active.
+  template <typename HandlerFn> void drain(HandlerFn Handler) {
+    for (auto &Q : Queues) {
+      for (auto &Item : Q->Items) {
+        std::invoke(Handler, std::move(Item));
+      }
+      Q->Items.clear();
+    }
+    Pending.store(0, std::memory_order_relaxed);
+  }
+
+  /// The number of items that have been pushed but not yet processed.
+  [[nodiscard]] size_t getNumPendingItems() const noexcept {
+    return Pending.load(std::memory_order_relaxed);
+  }
+
+private:
+  static constexpr unsigned NoWorker = ~0U;
+
+  struct WorkerQueue {
+    std::mutex Mtx;
+    std::deque<T> Items;
+  };
+
+  [[nodiscard]] static unsigned &currentWorkerSlot() noexcept {
+    static thread_local unsigned Slot = NoWorker;
+    return Slot;
+  }
+
+  [[nodiscard]] std::optional<T> pop(unsigned WorkerId) {
+    {
+      auto &Own = *Queues[WorkerId];
+      std::lock_guard Lock(Own.Mtx);
+      if (!Own.Items.empty()) {
+        std::optional<T> Ret(std::move(Own.Items.back()));
+        Own.Items.pop_back();
+        return Ret;
+      }
+    }
+
+    for (unsigned I = 1; I < NumWorkers; ++I) {
+      auto &Victim = *Queues[(WorkerId + I) % NumWorkers];
+      std::unique_lock Lock(Victim.Mtx, std::try_to_lock);
+      if (!Lock.owns_lock() || Victim.Items.empty()) {
+        continue;
+      }
+      std::optional<T> Ret(std::move(Victim.Items.front()));
+      Victim.Items.pop_front();
+      return Ret;
+    }
+    return std::nullopt;
+  }
+
+  unsigned NumWorkers;
+  std::vector<std::unique_ptr<WorkerQueue>> Queues;
+  std::atomic_size_t Pending{0};
+  std::atomic_bool Aborted{false};
+  std::atomic_uint NextQueue{0};
+};
+
+} // namespace psr
+
+#endif // PHASAR_UTILS_WORKSTEALINGSCHEDULER_H
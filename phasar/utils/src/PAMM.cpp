@@ -16,6 +16,8 @@
 
 #include "phasar/Utils/PAMM.h"
 
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include "nlohmann/json.hpp"
@@ -37,6 +39,7 @@ PAMM &PAMM::getInstance() {
 }
 
 void PAMM::startTimer(const std::string &TimerId) {
+  std::lock_guard Lock(TimerMtx);
   bool ValidTimerId =
       !RunningTimer.count(TimerId) && !StoppedTimer.count(TimerId);
   assert(ValidTimerId && "startTimer failed due to an invalid timer id");
@@ -47,6 +50,7 @@ void PAMM::startTimer(const std::string &TimerId) {
 }
 
 void PAMM::resetTimer(const std::string &TimerId) {
+  std::lock_guard Lock(TimerMtx);
   assert((RunningTimer.count(TimerId) && !StoppedTimer.count(TimerId)) ||
          (!RunningTimer.count(TimerId) && StoppedTimer.count(TimerId)) &&
              "resetTimer failed due to an invalid timer id");
@@ -58,6 +62,11 @@ void PAMM::resetTimer(const std::string &TimerId) {
 }
 
 void PAMM::stopTimer(const std::string &TimerId, bool PauseTimer) {
+  std::lock_guard Lock(TimerMtx);
+  stopTimerImpl(TimerId, PauseTimer);
+}
+
+void PAMM::stopTimerImpl(const std::string &TimerId, bool PauseTimer) {
   bool TimerRunning = RunningTimer.count(TimerId);
   bool ValidTimerId = TimerRunning || StoppedTimer.count(TimerId);
   assert(ValidTimerId && "stopTimer failed due to an invalid timer id or timer "
@@ -78,6 +87,11 @@ void PAMM::stopTimer(const std::string &TimerId, bool PauseTimer) {
 }
 
 unsigned long PAMM::elapsedTime(const std::string &TimerId) {
+  std::lock_guard Lock(TimerMtx);
+  return elapsedTimeImpl(TimerId);
+}
+
+unsigned long PAMM::elapsedTimeImpl(const std::string &TimerId) {
   assert((RunningTimer.count(TimerId) || StoppedTimer.count(TimerId)) &&
          "elapsedTime failed due to an invalid timer id");
   if (RunningTimer.count(TimerId)) {
@@ -96,6 +110,12 @@ unsigned long PAMM::elapsedTime(const std::string &TimerId) {
 
 std::unordered_map<std::string, std::vector<unsigned long>>
 PAMM::elapsedTimeOfRepeatingTimer() {
+  std::lock_guard Lock(TimerMtx);
+  return elapsedTimeOfRepeatingTimerImpl();
+}
+
+std::unordered_map<std::string, std::vector<unsigned long>>
+PAMM::elapsedTimeOfRepeatingTimerImpl() {
   std::unordered_map<std::string, std::vector<unsigned long>> AccTimes;
   for (const auto &Timer : RepeatingTimer) {
     std::vector<unsigned long> AccTimeVec;
@@ -134,35 +154,127 @@ std::string PAMM::getPrintableDuration(unsigned long Duration) {
   return Oss.str();
 }
 
-void PAMM::regCounter(const std::string &CounterId, unsigned IntialValue) {
-  bool ValidCounterId = !Counter.count(CounterId);
-  assert(ValidCounterId && "regCounter failed due to an invalid counter id");
-  if (ValidCounterId) {
-    Counter[CounterId] = IntialValue;
+PAMM::ThreadCounters &PAMM::registerThread() {
+  std::lock_guard Lock(CounterMtx);
+  auto &TC = AllThreadCounters.emplace_back(std::make_unique<ThreadCounters>());
+  LocalCounters = TC.get();
+  // Constructs the guard of this thread, such that its destructor runs
+  LocalCountersGuard.Registered = true;
+  return *TC;
+}
+
+void PAMM::retireThread(ThreadCounters &TC) {
+  std::lock_guard Lock(CounterMtx);
+  for (size_t BlockIdx = 0; BlockIdx < MaxCounterBlocks; ++BlockIdx) {
+    const auto *Block = TC.Blocks[BlockIdx].load(std::memory_order_relaxed);
+    if (!Block) {
+      continue;
+    }
+    for (size_t Slot = 0; Slot < CountersPerBlock; ++Slot) {
+      auto Id = BlockIdx * CountersPerBlock + Slot;
+      if (Id >= Retired.size()) {
+        break;
+      }
+      Retired[Id] += Block->Values[Slot].load(std::memory_order_relaxed);
+    }
   }
+
+  auto It = llvm::find_if(AllThreadCounters, [&TC](const auto &Other) {
+    return Other.get() == &TC;
+  });
+  assert(It != AllThreadCounters.end());
+  std::swap(*It, AllThreadCounters.back());
+  AllThreadCounters.pop_back();
 }
 
-void PAMM::incCounter(const std::string &CounterId, unsigned CValue) {
-  bool ValidCounterId = Counter.count(CounterId);
-  assert(ValidCounterId && "incCounter failed due to an invalid counter id");
-  if (ValidCounterId) {
-    Counter[CounterId] += CValue;
+PAMM::ThreadCountersGuard::~ThreadCountersGuard() {
+  if (auto *TC = LocalCounters) {
+    // Thread-local objects are destroyed before the PAMM instance, even for
+    // the main thread
+    PAMM::getInstance().retireThread(*TC);
+    LocalCounters = nullptr;
   }
 }
 
-void PAMM::decCounter(const std::string &CounterId, unsigned CValue) {
-  bool ValidCounterId = Counter.count(CounterId);
-  assert(ValidCounterId && "decCounter failed due to an invalid counter id");
-  if (ValidCounterId) {
-    Counter[CounterId] -= CValue;
+PAMM::CounterBlock &PAMM::allocateCounterBlock(ThreadCounters &TC,
+                                               size_t BlockIdx) {
+  auto *Block = new CounterBlock();
+  // Publish the zero-initialized block to concurrent readers
+  TC.Blocks[BlockIdx].store(Block, std::memory_order_release);
+  return *Block;
+}
+
+int64_t PAMM::sumCounter(CounterHandle Id) {
+  // Requires the CounterMtx
+  int64_t Sum = Retired[Id];
+  for (const auto &TC : AllThreadCounters) {
+    const auto *Block =
+        TC->Blocks[Id / CountersPerBlock].load(std::memory_order_acquire);
+    if (Block) {
+      Sum += Block->Values[Id % CountersPerBlock].load(
+          std::memory_order_relaxed);
+    }
+  }
+  return Sum;
+}
+
+PAMM::CounterHandle PAMM::getCounterHandle(const std::string &CounterId) {
+  std::lock_guard Lock(CounterMtx);
+  auto [It, Inserted] =
+      CounterHandles.try_emplace(CounterId, CounterHandle(CounterNames.size()));
+  if (Inserted) {
+    if (CounterNames.size() == CountersPerBlock * MaxCounterBlocks) {
+      llvm::report_fatal_error("PAMM: too many counters");
+    }
+    CounterNames.push_back(CounterId);
+    CounterRegistered.push_back(false);
+    Retired.push_back(0);
+  }
+  return It->second;
+}
+
+PAMM::CounterHandle PAMM::regCounter(const std::string &CounterId,
+                                     unsigned IntialValue) {
+  auto Id = getCounterHandle(CounterId);
+  {
+    std::lock_guard Lock(CounterMtx);
+    bool ValidCounterId = !CounterRegistered[Id];
+    assert(ValidCounterId && "regCounter failed due to an invalid counter id");
+    if (!ValidCounterId) {
+      return Id;
+    }
+    CounterRegistered[Id] = true;
   }
+  incCounter(Id, IntialValue);
+  return Id;
+}
+
+void PAMM::incCounter(const std::string &CounterId, unsigned CValue) {
+  auto Id = getCounterHandle(CounterId);
+  assert([&] {
+    std::lock_guard Lock(CounterMtx);
+    return bool(CounterRegistered[Id]);
+  }() && "incCounter failed due to an invalid counter id");
+  incCounter(Id, CValue);
+}
+
+void PAMM::decCounter(const std::string &CounterId, unsigned CValue) {
+  auto Id = getCounterHandle(CounterId);
+  assert([&] {
+    std::lock_guard Lock(CounterMtx);
+    return bool(CounterRegistered[Id]);
+  }() && "decCounter failed due to an invalid counter id");
+  decCounter(Id, CValue);
 }
 
 int PAMM::getCounter(const std::string &CounterId) {
-  bool ValidCounterId = Counter.count(CounterId);
+  std::lock_guard Lock(CounterMtx);
+  auto It = CounterHandles.find(CounterId);
+  bool ValidCounterId =
+      It != CounterHandles.end() && CounterRegistered[It->second];
   assert(ValidCounterId && "getCounter failed due to an invalid counter id");
   if (ValidCounterId) {
-    return Counter[CounterId];
+    return int(sumCounter(It->second));
   }
   return -1;
 }
@@ -182,6 +294,7 @@ int PAMM::getSumCount(const std::set<std::string> &CounterIds) {
 }
 
 void PAMM::regHistogram(const std::string &HistogramId) {
+  std::lock_guard Lock(HistogramMtx);
   bool ValidHid = !Histogram.count(HistogramId);
   assert(ValidHid && "failed to register new histogram due to an invalid id");
   if (ValidHid) {
@@ -193,6 +306,7 @@ void PAMM::regHistogram(const std::string &HistogramId) {
 void PAMM::addToHistogram(const std::string &HistogramId,
                           const std::string &DataPointId,
                           unsigned long DataPointValue) {
+  std::lock_guard Lock(HistogramMtx);
   assert(Histogram.count(HistogramId) &&
          "adding data point to histogram failed due to invalid id");
   if (Histogram[HistogramId].count(DataPointId)) {
@@ -203,14 +317,15 @@ void PAMM::addToHistogram(const std::string &HistogramId,
 }
 
 void PAMM::printTimers(llvm::raw_ostream &Os) {
+  std::lock_guard Lock(TimerMtx);
   // stop all running timer
   while (!RunningTimer.empty()) {
-    stopTimer(RunningTimer.begin()->first);
+    stopTimerImpl(RunningTimer.begin()->first);
   }
   Os << "Single Timer\n";
   Os << "------------\n";
   for (const auto &Timer : StoppedTimer) {
-    unsigned long Time = elapsedTime(Timer.first);
+    unsigned long Time = elapsedTimeImpl(Timer.first);
     Os << Timer.first << " : " << getPrintableDuration(Time) << '\n';
   }
   if (StoppedTimer.empty()) {
@@ -220,7 +335,7 @@ void PAMM::printTimers(llvm::raw_ostream &Os) {
   }
   Os << "Repeating Timer\n";
   Os << "---------------\n";
-  for (const auto &Timer : elapsedTimeOfRepeatingTimer()) {
+  for (const auto &Timer : elapsedTimeOfRepeatingTimerImpl()) {
     unsigned long Sum = 0;
     Os << Timer.first << " Timer:\n";
     for (auto Duration : Timer.second) {
@@ -237,12 +352,17 @@ void PAMM::printTimers(llvm::raw_ostream &Os) {
 }
 
 void PAMM::printCounters(llvm::raw_ostream &Os) {
+  std::lock_guard Lock(CounterMtx);
   Os << "\nCounter\n";
   Os << "-------\n";
-  for (const auto &Counter : Counter) {
-    Os << Counter.first << " : " << Counter.second << '\n';
+  bool Empty = true;
+  for (CounterHandle Id = 0, End = CounterNames.size(); Id != End; ++Id) {
+    if (CounterRegistered[Id]) {
+      Os << CounterNames[Id] << " : " << sumCounter(Id) << '\n';
+      Empty = false;
+    }
   }
-  if (Counter.empty()) {
+  if (Empty) {
     Os << "No Counter registered!\n";
   } else {
     Os << "\n";
@@ -250,6 +370,7 @@ void PAMM::printCounters(llvm::raw_ostream &Os) {
 }
 
 void PAMM::printHistograms(llvm::raw_ostream &Os) {
+  std::lock_guard Lock(HistogramMtx);
   Os << "\nHistograms\n";
   Os << "--------------\n";
   for (const auto &H : Histogram) {
@@ -281,35 +402,46 @@ void PAMM::exportMeasuredData(
   json JsonData;
 
   // add timer data
-  while (!RunningTimer.empty()) {
-    stopTimer(std::string(RunningTimer.begin()->first));
-  }
   json JTimer;
-  for (const auto &Timer : StoppedTimer) {
-    unsigned long Time = elapsedTime(Timer.first);
-    JTimer[Timer.first] = Time;
-  }
-  for (const auto &Timer : elapsedTimeOfRepeatingTimer()) {
-    JTimer[Timer.first] = Timer.second;
+  {
+    std::lock_guard Lock(TimerMtx);
+    while (!RunningTimer.empty()) {
+      stopTimerImpl(std::string(RunningTimer.begin()->first));
+    }
+    for (const auto &Timer : StoppedTimer) {
+      unsigned long Time = elapsedTimeImpl(Timer.first);
+      JTimer[Timer.first] = Time;
+    }
+    for (const auto &Timer : elapsedTimeOfRepeatingTimerImpl()) {
+      JTimer[Timer.first] = Timer.second;
+    }
   }
   JsonData["Timer"] = JTimer;
 
   // add histogram data if available
   json JHistogram;
-  for (const auto &H : Histogram) {
-    json JSetH;
-    for (const auto &Entry : H.second) {
-      JSetH[Entry.first] = Entry.second;
+  {
+    std::lock_guard Lock(HistogramMtx);
+    for (const auto &H : Histogram) {
+      json JSetH;
+      for (const auto &Entry : H.second) {
+        JSetH[Entry.first] = Entry.second;
+      }
+      JHistogram[H.first] = JSetH;
     }
-    JHistogram[H.first] = JSetH;
   }
   if (!JHistogram.is_null()) {
     JsonData["Histogram"] = JHistogram;
   }
   // add counter data
   json JCounter;
-  for (const auto &Counter : Counter) {
-    JCounter[Counter.first] = Counter.second;
+  {
+    std::lock_guard Lock(CounterMtx);
+    for (CounterHandle Id = 0, End = CounterNames.size(); Id != End; ++Id) {
+      if (CounterRegistered[Id]) {
+        JCounter[CounterNames[Id]] = sumCounter(Id);
+      }
+    }
   }
   JsonData["Counter"] = JCounter;
 
@@ -343,10 +475,28 @@ void PAMM::exportMeasuredData(
 }
 
 void PAMM::reset() {
-  RunningTimer.clear();
-  StoppedTimer.clear();
-  RepeatingTimer.clear();
-  Counter.clear();
+  {
+    std::lock_guard Lock(TimerMtx);
+    RunningTimer.clear();
+    StoppedTimer.clear();
+    RepeatingTimer.clear();
+  }
+  {
+    // Keep the counter handles valid, as call sites may have cached them
+    std::lock_guard Lock(CounterMtx);
+    CounterRegistered.assign(CounterRegistered.size(), false);
+    Retired.assign(Retired.size(), 0);
+    for (const auto &TC : AllThreadCounters) {
+      for (const auto &BlockPtr : TC->Blocks) {
+        if (auto *Block = BlockPtr.load(std::memory_order_acquire)) {
+          for (auto &Value : Block->Values) {
+            Value.store(0, std::memory_order_relaxed);
+          }
+        }
+      }
+    }
+  }
+  std::lock_guard Lock(HistogramMtx);
   Histogram.clear();
 }
 } // namespace psr
@@ -7,9 +7,13 @@
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <optional>
 #include <set>
+#include <thread>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 using namespace psr;
 using namespace std;
@@ -420,6 +424,127 @@ TEST(BitVectorSet, hash) {
       << "{1, 3, 5} not there in " << PrettyPrinter{Set};
 }
 
+TEST(BitVectorSet, sparseAndDense) {
+  // Few elements are stored sparsely, many densely; the set operations must
+  // not depend on the representation
+  BitVectorSet<int> Small({1, 2, 3});
+  BitVectorSet<int> Large;
+  for (int I = 0; I < 100; ++I) {
+    Large.insert(I);
+  }
+  Large.erase(50);
+  for (int I = 4; I < 100; ++I) {
+    Large.erase(I);
+  }
+
+  EXPECT_NE(Small, Large);
+  EXPECT_EQ(4U, Large.size());
+  EXPECT_EQ(3U, Small.size());
+  EXPECT_TRUE(Large.includes(Small));
+  EXPECT_FALSE(Small.includes(Large));
+
+  Small.insert(0);
+  EXPECT_EQ(Small, Large);
+  EXPECT_EQ(Large, Small);
+  EXPECT_EQ(hash_value(Small), hash_value(Large));
+  EXPECT_FALSE(Small < Large);
+  EXPECT_FALSE(Large < Small);
+  Small.insert(200);
+  EXPECT_NE(Small, Large);
+  EXPECT_TRUE(Large < Small);
+
+  auto Union = Large.setUnion(Small);
+  EXPECT_EQ(Union, Small);
+  auto Intersection = Union.setIntersect(BitVectorSet<int>({2, 200, 300}));
+  EXPECT_EQ(Intersection, BitVectorSet<int>({2, 200}));
+
+  Union.erase(BitVectorSet<int>({0, 1, 2}));
+  EXPECT_EQ(Union, BitVectorSet<int>({3, 200}));
+
+  std::set<int> Elems(Union.begin(), Union.end());
+  EXPECT_EQ(Elems, std::set<int>({3, 200}));
+}
+
+TEST(BitVectorSet, explicitDomain) {
+  BitVectorSetDomain<int> Domain;
+  std::set<int> Elems = {7, 3, 5};
+  BitVectorSet<int> A(Elems.begin(), Elems.end(), Domain);
+  BitVectorSet<int> B(Domain);
+  B.insert(5);
+
+  EXPECT_EQ(&Domain, &A.getDomain());
+  EXPECT_FALSE(Domain.isSynchronized());
+  EXPECT_TRUE(BitVectorSetDomain<int>::getDefault().isSynchronized());
+  EXPECT_EQ(3U, Domain.size());
+  EXPECT_TRUE(A.includes(B));
+  // The indices are assigned in insertion order
+  EXPECT_EQ(3, Domain[0]);
+  EXPECT_EQ(5, Domain[1]);
+  EXPECT_EQ(7, Domain[2]);
+  EXPECT_EQ(std::optional<uint32_t>(1), Domain.find(5));
+  EXPECT_EQ(std::nullopt, Domain.find(42));
+}
+
+TEST(BitVectorSet, concurrentDomain) {
+  constexpr int NumThreads = 4;
+  constexpr int NumValues = 10000;
+  BitVectorSetDomain<int> Domain(/*Synchronized*/ true);
+  ASSERT_TRUE(Domain.isSynchronized());
+
+  std::vector<BitVectorSet<int>> Sets(NumThreads, BitVectorSet<int>(Domain));
+  std::vector<std::thread> Threads;
+  for (int T = 0; T < NumThreads; ++T) {
+    Threads.emplace_back([&Sets, T] {
+      for (int I = 0; I < NumValues; ++I) {
+        Sets[T].insert((I * (T + 1)) % NumValues);
+      }
+    });
+  }
+  for (auto &Thread : Threads) {
+    Thread.join();
+  }
+
+  EXPECT_EQ(size_t(NumValues), Domain.size());
+  for (int I = 0; I < NumValues; ++I) {
+    auto Idx = Domain.find(I);
+    ASSERT_TRUE(Idx.has_value());
+    EXPECT_EQ(I, Domain[*Idx]);
+  }
+  for (const auto &Set : Sets) {
+    for (auto It = Set.begin(), End = Set.end(); It != End; ++It) {
+      EXPECT_EQ(*It, Domain[It.getIndex()]);
+    }
+  }
+}
+
+TEST(BitVectorSet, concurrentDefaultDomain) {
+  constexpr int NumThreads = 4;
+  constexpr int NumValues = 10000;
+  // Sets of independent analyses that run concurrently share the default
+  // domain
+  std::vector<BitVectorSet<long>> Sets(NumThreads);
+  std::vector<std::thread> Threads;
+  for (int T = 0; T < NumThreads; ++T) {
+    Threads.emplace_back([&Sets, T] {
+      for (long I = 0; I < NumValues; ++I) {
+        Sets[T].insert((I * (T + 1)) % NumValues);
+      }
+    });
+  }
+  for (auto &Thread : Threads) {
+    Thread.join();
+  }
+
+  const auto &Domain = BitVectorSetDomain<long>::getDefault();
+  EXPECT_EQ(size_t(NumValues), Domain.size());
+  for (const auto &Set : Sets) {
+    EXPECT_EQ(&Domain, &Set.getDomain());
+    for (auto It = Set.begin(), End = Set.end(); It != End; ++It) {
+      EXPECT_EQ(*It, Domain[It.getIndex()]);
+    }
+  }
+}
+
 //===----------------------------------------------------------------------===//
 // llvm::BitVector
 
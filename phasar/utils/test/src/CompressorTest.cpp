@@ -0,0 +1,64 @@
+#include "phasar/Utils/Compressor.h"
+
+#include "gtest/gtest.h"
+
+#include <limits>
+#include <string>
+
+using namespace psr;
+
+TEST(CompressorTest, AssignsDenseIdsInInsertionOrder) {
+  int Vals[3] = {};
+  Compressor<const int *> C;
+  EXPECT_TRUE(C.empty());
+
+  EXPECT_EQ(0U, C.getOrInsert(&Vals[2]));
+  EXPECT_EQ(1U, C.getOrInsert(&Vals[0]));
+  EXPECT_EQ(0U, C.getOrInsert(&Vals[2]));
+  EXPECT_EQ(2U, C.getOrInsert(&Vals[1]));
+
+  EXPECT_EQ(3U, C.size());
+  EXPECT_EQ(&Vals[2], C[0]);
+  EXPECT_EQ(&Vals[0], C[1]);
+  EXPECT_EQ(&Vals[1], C[2]);
+}
+
+TEST(CompressorTest, GetOrNullDoesNotInsert) {
+  Compressor<std::string> C;
+  EXPECT_EQ(std::nullopt, C.getOrNull("foo"));
+  EXPECT_TRUE(C.empty());
+
+  C.getOrInsert("bar");
+  C.getOrInsert("foo");
+  EXPECT_EQ(1U, C.getOrNull("foo"));
+  EXPECT_EQ("foo", C[1]);
+  EXPECT_EQ(2U, C.size());
+
+  C.clear();
+  EXPECT_EQ(std::nullopt, C.getOrNull("foo"));
+  EXPECT_EQ(0U, C.getOrInsert("foo"));
+}
+
+TEST(CompressorTest, IntegralValuesIncludingDenseMapSentinels) {
+  // These are the empty and tombstone keys of llvm::DenseMapInfo
+  const unsigned UnsignedVals[] = {~0U, ~0U - 1, 0, 42};
+  Compressor<unsigned> UC;
+  for (unsigned I = 0; I != 4; ++I) {
+    EXPECT_EQ(I, UC.getOrInsert(UnsignedVals[I]));
+  }
+  for (unsigned I = 0; I != 4; ++I) {
+    EXPECT_EQ(I, UC.getOrNull(UnsignedVals[I]));
+    EXPECT_EQ(UnsignedVals[I], UC[I]);
+  }
+
+  const int IntVals[] = {std::numeric_limits<int>::max(),
+                         std::numeric_limits<int>::min(), -1, 0};
+  Compressor<int> IC;
+  for (unsigned I = 0; I != 4; ++I) {
+    EXPECT_EQ(I, IC.getOrInsert(IntVals[I]));
+  }
+  EXPECT_EQ(4U, IC.size());
+  EXPECT_EQ(1U, IC.getOrInsert(std::numeric_limits<int>::min()));
+  EXPECT_EQ(std::numeric_limits<int>::max(), IC[0]);
+  EXPECT_EQ(std::nullopt, IC.getOrNull(1));
+}
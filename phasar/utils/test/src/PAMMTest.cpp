@@ -7,6 +7,7 @@
 #include "gtest/gtest.h"
 
 #include <thread>
+#include <vector>
 
 using namespace psr;
 
@@ -49,6 +50,35 @@ TEST_F(PAMMTest, HandleCounter) {
   EXPECT_EQ(Pamm.getCounter("third"), 0);
 }
 
+TEST_F(PAMMTest, HandleCounterConcurrently) {
+  PAMM &Pamm = PAMM::getInstance();
+  auto Handle = Pamm.regCounter("concurrent", 5);
+  EXPECT_EQ(Handle, Pamm.getCounterHandle("concurrent"));
+
+  constexpr unsigned NumThreads = 4;
+  constexpr unsigned NumIncrements = 100000;
+  std::vector<std::thread> Threads;
+  for (unsigned I = 0; I < NumThreads; ++I) {
+    Threads.emplace_back([&Pamm, Handle] {
+      for (unsigned J = 0; J < NumIncrements; ++J) {
+        Pamm.incCounter(Handle, 2);
+        Pamm.decCounter(Handle);
+      }
+    });
+  }
+  for (auto &Thread : Threads) {
+    Thread.join();
+  }
+  // The counts of finished threads must not get lost
+  EXPECT_EQ(Pamm.getCounter("concurrent"), 5 + NumThreads * NumIncrements);
+
+  // Handles stay valid across a reset
+  Pamm.reset();
+  EXPECT_EQ(Handle, Pamm.regCounter("concurrent"));
+  Pamm.incCounter(Handle);
+  EXPECT_EQ(Pamm.getCounter("concurrent"), 1);
+}
+
 TEST_F(PAMMTest, HandleJSONOutput) {
   PAMM &Pamm = PAMM::getInstance();
   Pamm.regCounter("timerCount");
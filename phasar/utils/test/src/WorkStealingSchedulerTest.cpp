@@ -0,0 +1,118 @@
+#include "phasar/Utils/WorkStealingScheduler.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+using namespace psr;
+
+TEST(WorkStealingSchedulerTest, ProcessesAllInitialItems) {
+  WorkStealingScheduler<int> Sched(4);
+  for (int I = 0; I < 1000; ++I) {
+    Sched.push(I);
+  }
+
+  std::mutex Mtx;
+  std::multiset<int> Seen;
+  Sched.run([&](int Item) {
+    std::lock_guard Lock(Mtx);
+    Seen.insert(Item);
+  });
+
+  EXPECT_EQ(1000, Seen.size());
+  for (int I = 0; I < 1000; ++I) {
+    EXPECT_EQ(1, Seen.count(I));
+  }
+  EXPECT_EQ(0, Sched.getNumPendingItems());
+}
+
+TEST(WorkStealingSchedulerTest, ProcessesTransitivelyPushedItems) {
+  // Each item N spawns the items 2N+1 and 2N+2 (a complete binary tree)
+  constexpr int NumItems = 1 << 14;
+  WorkStealingScheduler<int> Sched(4);
+  Sched.push(0);
+
+  std::atomic_int Count = 0;
+  Sched.run([&](int Item) {
+    ++Count;
+    EXPECT_TRUE(WorkStealingScheduler<int>::currentWorker().has_value());
+    for (int Child : {2 * Item + 1, 2 * Item + 2}) {
+      if (Child < NumItems - 1) {
+        Sched.push(Child);
+      }
+    }
+  });
+
+  EXPECT_EQ(NumItems - 1, Count);
+  EXPECT_FALSE(WorkStealingScheduler<int>::currentWorker().has_value());
+}
+
+TEST(WorkStealingSchedulerTest, SingleWorkerRunsOnCallingThread) {
+  WorkStealingScheduler<int> Sched(1);
+  Sched.push(1);
+  Sched.push(2);
+
+  auto Caller = std::this_thread::get_id();
+  int Sum = 0;
+  Sched.run([&](int Item) {
+    EXPECT_EQ(Caller, std::this_thread::get_id());
+    Sum += Item;
+  });
+  EXPECT_EQ(3, Sum);
+}
+
+TEST(WorkStealingSchedulerTest, RethrowsFirstException) {
+  WorkStealingScheduler<int> Sched(3);
+  for (int I = 0; I < 100; ++I) {
+    Sched.push(I);
+  }
+
+  EXPECT_THROW(Sched.run([](int Item) {
+    if (Item == 42) {
+      throw std::runtime_error("42");
+    }
+  }),
+               std::runtime_error);
+  EXPECT_EQ(0, Sched.getNumPendingItems());
+
+  // The scheduler can be reused after a failure
+  int Count = 0;
+  Sched.push(1);
+  Sched.run([&](int /*Item*/) { ++Count; });
+  EXPECT_EQ(1, Count);
+}
+
+TEST(WorkStealingSchedulerTest, StopsAndDrainsRemainingItems) {
+  WorkStealingScheduler<int> Sched(4);
+  for (int I = 0; I < 1000; ++I) {
+    Sched.push(I);
+  }
+
+  std::atomic_bool Stop = false;
+  std::atomic_int NumProcessed = 0;
+  bool Done = Sched.runUntil(
+      [&](int /*Item*/) {
+        if (++NumProcessed == 100) {
+          Stop = true;
+        }
+      },
+      [&] { return Stop.load(); });
+  EXPECT_FALSE(Done);
+  EXPECT_GE(NumProcessed, 100);
+  EXPECT_EQ(1000 - NumProcessed, int(Sched.getNumPendingItems()));
+
+  int NumDrained = 0;
+  Sched.drain([&](int /*Item*/) { ++NumDrained; });
+  EXPECT_EQ(1000, NumProcessed + NumDrained);
+  EXPECT_EQ(0, Sched.getNumPendingItems());
+
+  // Without a stop request, runUntil processes everything
+  Sched.push(1);
+  Sched.push(2);
+  EXPECT_TRUE(Sched.runUntil([](int /*Item*/) {}, [] { return false; }));
+  EXPECT_EQ(0, Sched.getNumPendingItems());
+}